@@ -22,6 +22,10 @@
 #define OS_MAX_COUNT_SEMAPHORES     20
 #define OS_MAX_BIN_SEMAPHORES       20
 #define OS_MAX_MUTEXES              20
+#define OS_MAX_CONDVARS             20
+#define OS_MAX_BARRIERS             10
+#define OS_MAX_WORKPOOLS            4
+#define OS_MAX_FIBERS               16
 
 /*
 ** Maximum length for an absolute path name
@@ -133,4 +137,20 @@
 */
 #define OS_MAX_TIMERS         5
 
+/*
+ * If OS_MUTEX_DIAGNOSTICS is defined, OS_MutSemTake() and OS_MutSemGive() will track
+ * the owner and hold time of each mutex, and count takes that were blocked behind a
+ * lower priority owner for longer than OS_MUTEX_HOLD_WARN_USEC.  The statistics are
+ * reported through OS_MutSemGetInfo().  This adds a clock read to every take and give.
+ */
+#undef OS_MUTEX_DIAGNOSTICS
+#define OS_MUTEX_HOLD_WARN_USEC  1000
+
+/*
+ * If OS_MUTEX_LOCKDEP is defined, OSAL will record the order in which each task takes
+ * mutexes and print a warning the first time two mutexes are taken in an order that
+ * could deadlock against an order seen earlier.  Intended for test and soak builds.
+ */
+#undef OS_MUTEX_LOCKDEP
+
 #endif
@@ -22,6 +22,10 @@
 #define OS_MAX_COUNT_SEMAPHORES     20
 #define OS_MAX_BIN_SEMAPHORES       20
 #define OS_MAX_MUTEXES              20
+#define OS_MAX_CONDVARS             20
+#define OS_MAX_BARRIERS             10
+#define OS_MAX_WORKPOOLS            4
+#define OS_MAX_FIBERS               16
 
 /*
 ** Maximum length for an absolute path name
@@ -84,6 +88,33 @@
 #define OS_UTILITYTASK_PRIORITY   245
 #define OS_UTILITYTASK_STACK_SIZE 2048
 
+/*
+ * The console utility task and the timebase helper threads may be
+ * pinned to specific CPUs to keep them away from time-critical tasks.
+ * Bit N selects CPU N; a value of 0 lets them run on any CPU.
+ */
+#define OS_CONSOLE_CPU_MASK       0
+#define OS_TIMEBASE_CPU_MASK      0
+
+/*
+ * Real-time options applied by OS_API_Init(), as a combination of the
+ * OS_RT_* flags (memory locking, stack prefaulting, heap allocation
+ * checks after OS_HeapLockdown()).  See OS_API_InitRealtime().
+ */
+#define OS_REALTIME_OPTIONS       0
+
+/*
+ * The OS_RT_COUNT_ALLOCATIONS and OS_RT_TRAP_ALLOCATIONS checks are done by
+ * replacing malloc(), calloc(), realloc(), reallocarray() and the aligned
+ * allocators (memalign(), aligned_alloc(), posix_memalign(), valloc() and
+ * pvalloc()) for the whole process with wrappers around the glibc allocator.
+ * This conflicts with other malloc replacements and memory checkers, so it
+ * is only built if OSAL_POSIX_HEAP_CHECK is defined; otherwise
+ * OS_HeapLockdown() returns OS_ERR_NOT_IMPLEMENTED.  Memory mapped directly
+ * with mmap() is never counted.
+ */
+/* #define OSAL_POSIX_HEAP_CHECK */
+
 
 /* 
 ** the size of a command that can be passed to the underlying OS 
@@ -196,4 +227,22 @@
  */
 #define OSAL_DEBUG_PERMISSIVE_MODE
 
+/*
+ * If OS_MUTEX_DIAGNOSTICS is defined, OS_MutSemTake() and OS_MutSemGive() will track
+ * the owner and hold time of each mutex, and count takes that were blocked behind a
+ * lower priority owner for longer than OS_MUTEX_HOLD_WARN_USEC.  The statistics are
+ * reported through OS_MutSemGetInfo().  This adds a clock read to every take and give,
+ * so it is intended for debug builds and left disabled by default.
+ */
+/* #define OS_MUTEX_DIAGNOSTICS */
+#define OS_MUTEX_HOLD_WARN_USEC  1000
+
+/*
+ * If OS_MUTEX_LOCKDEP is defined, OSAL will record the order in which each task takes
+ * mutexes and print a warning the first time two mutexes are taken in an order that
+ * could deadlock against an order seen earlier.  Intended for test and soak builds,
+ * so it is left disabled by default.
+ */
+/* #define OS_MUTEX_LOCKDEP */
+
 #endif
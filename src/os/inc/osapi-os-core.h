@@ -38,6 +38,9 @@
 #define OS_OBJECT_TYPE_OS_MODULE    0x0A
 #define OS_OBJECT_TYPE_OS_FILESYS   0x0B
 #define OS_OBJECT_TYPE_OS_CONSOLE   0x0C
+#define OS_OBJECT_TYPE_OS_CONDVAR   0x0D
+#define OS_OBJECT_TYPE_OS_BARRIER   0x0E
+#define OS_OBJECT_TYPE_OS_WORKPOOL  0x0F
 #define OS_OBJECT_TYPE_USER         0x10
 
 /* Upper limit for OSAL task priorities */
@@ -50,6 +53,12 @@
 /* #define for enabling floating point operations on a task*/
 #define OS_FP_ENABLED 1
 
+/* options for OS_API_InitRealtime() */
+#define OS_RT_LOCK_MEMORY          0x01  /**< Lock all process memory into RAM */
+#define OS_RT_PREFAULT_STACKS      0x02  /**< Fault in task stacks before the task runs */
+#define OS_RT_COUNT_ALLOCATIONS    0x04  /**< Count heap allocations after OS_HeapLockdown() */
+#define OS_RT_TRAP_ALLOCATIONS     0x08  /**< Abort on heap allocations after OS_HeapLockdown() */
+
 /*  tables for the properties of objects */
 
 /*tasks */
@@ -60,6 +69,15 @@ typedef struct
     uint32 stack_size;
     uint32 priority;
     uint32 OStask_id;
+    uint32 os_thread_id;        /**< Thread ID used by OS tools (e.g. the Linux TID shown by ps and perf), 0 if unknown */
+    uint32 cpu_mask;            /**< CPUs the task may run on (bit N = CPU N), 0 if unrestricted */
+    uint32 period_usec;         /**< Release period set via OS_TaskSetPeriod(), 0 if not periodic */
+    uint32 period_cycles;       /**< Number of completed OS_TaskWaitPeriod() calls */
+    uint32 period_overruns;     /**< Total release points missed due to overruns */
+    uint32 deadline_runtime_usec; /**< Runtime budget set via OS_TaskSetDeadline(), 0 if not deadline scheduled */
+    uint32 deadline_usec;       /**< Relative deadline set via OS_TaskSetDeadline() */
+    uint32 deadline_period_usec; /**< Reservation period set via OS_TaskSetDeadline() */
+    uint32 budget_overruns;     /**< Number of times the task exceeded its runtime budget */
 }OS_task_prop_t;
     
 /* queues */
@@ -90,8 +108,80 @@ typedef struct
 {
     char name [OS_MAX_API_NAME];
     uint32 creator;
+
+    /*
+     * Lock diagnostics - only filled in when OSAL is built with
+     * OS_MUTEX_DIAGNOSTICS, otherwise these are all zero.
+     */
+    uint32 owner;               /**< Task currently holding the mutex, 0 if free */
+    uint32 current_hold_usec;   /**< How long the current owner has held it */
+    uint32 take_count;          /**< Number of successful (outermost) takes */
+    uint32 contention_count;    /**< Takes that found the mutex already held */
+    uint32 inversion_count;     /**< Takes blocked behind a lower priority owner for longer than the threshold */
+    uint32 long_hold_count;     /**< Holds that exceeded the threshold */
+    uint32 last_hold_usec;      /**< Duration of the most recent completed hold */
+    uint32 max_hold_usec;       /**< Longest completed hold */
+    uint32 max_wait_usec;       /**< Longest time any task waited to take it */
+
+    /*
+     * Lock order validation - only filled in when OSAL is built with
+     * OS_MUTEX_LOCKDEP, otherwise zero.
+     */
+    uint32 lock_order_violations;  /**< Distinct inverted orders seen when taking this mutex */
 }OS_mut_sem_prop_t;
 
+/* Condition variables */
+typedef struct
+{
+    char name [OS_MAX_API_NAME];
+    uint32 creator;
+}OS_condvar_prop_t;
+
+/* Barriers */
+typedef struct
+{
+    char name [OS_MAX_API_NAME];
+    uint32 creator;
+    uint32 count;       /**< Number of tasks that must call OS_BarrierWait() to release the barrier */
+    uint32 waiting;     /**< Number of tasks currently blocked in OS_BarrierWait() */
+}OS_barrier_prop_t;
+
+/* Worker pools */
+typedef struct
+{
+    char name [OS_MAX_API_NAME];
+    uint32 creator;
+    uint32 num_workers;     /**< Number of worker tasks servicing the pool */
+    uint32 jobs_submitted;  /**< Total jobs accepted by OS_WorkSubmit() */
+    uint32 jobs_completed;  /**< Total jobs that have finished executing */
+    uint32 jobs_stolen;     /**< Jobs executed by a worker other than the one they were queued to */
+    uint32 jobs_pending;    /**< Jobs queued but not yet started */
+}OS_workpool_prop_t;
+
+/**
+ * @brief Function signature for jobs submitted to a worker pool
+ *
+ * @param arg The opaque argument passed to OS_WorkSubmit()
+ */
+typedef void (*OS_WorkFunc_t)(void *arg);
+
+/* Fibers */
+typedef struct
+{
+    char name [OS_MAX_API_NAME];
+    uint32 creator;
+    uint32 host_task_id;    /**< ID of the task that runs the fiber */
+    uint32 stack_size;
+    uint32 switches;        /**< Number of times the fiber has been switched in */
+}OS_fiber_prop_t;
+
+/**
+ * @brief Function signature for the entry point of a fiber
+ *
+ * @param arg The opaque argument passed to OS_FiberCreate()
+ */
+typedef void (*OS_FiberFunc_t)(void *arg);
+
 
 /* struct for OS_GetLocalTime() */
 
@@ -101,6 +191,28 @@ typedef struct
     uint32 microsecs;
 }OS_time_t; 
 
+/* task runtime statistics */
+typedef struct
+{
+    uint32    task_id;                  /**< Task the statistics belong to */
+    char      name [OS_MAX_API_NAME];
+    OS_time_t cpu_time;                 /**< Total CPU time consumed by the task */
+    uint32    voluntary_switches;       /**< Times the task blocked or yielded the CPU */
+    uint32    involuntary_switches;     /**< Times the task was preempted */
+    uint32    last_cpu;                 /**< CPU the task most recently ran on */
+}OS_task_stats_t;
+
+/* task stack pool statistics */
+typedef struct
+{
+    uint32 hits;                        /**< Tasks created on a recycled stack */
+    uint32 misses;                      /**< Tasks created on a newly allocated pool stack */
+    uint32 bypassed;                    /**< Tasks created outside the pool (pool full or stack too large) */
+    uint32 stacks_in_use;               /**< Pool stacks held by tasks that are running or still exiting */
+    uint32 stacks_free;                 /**< Pool stacks ready for reuse */
+    uint32 pool_bytes;                  /**< Total size of all pool stacks */
+}OS_stack_pool_stats_t;
+
 /* heap info */
 typedef struct
 {
@@ -109,6 +221,15 @@ typedef struct
     uint32 largest_free_block;
 }OS_heap_prop_t;
 
+/* real-time operation state, from OS_API_GetRealtimeInfo() */
+typedef struct
+{
+    uint32 options;                     /**< OS_RT_* options given at initialization */
+    bool   memory_locked;               /**< Process memory was locked into RAM */
+    bool   heap_locked_down;            /**< OS_HeapLockdown() has been called */
+    uint32 late_allocations;            /**< Heap allocations made since OS_HeapLockdown() */
+}OS_realtime_prop_t;
+
 
 /* This typedef is for the OS_GetErrorName function, to ensure
  * everyone is making an array of the same length.
@@ -135,6 +256,13 @@ typedef osal_task ((*osal_task_entry)(void));
 */
 typedef void (*OS_ArgCallback_t)(uint32 object_id, void *arg);
 
+/**
+ * @brief Function called to release a task-local value when its task ends
+ *
+ * @param value The non-NULL value the task had stored under the key
+ */
+typedef void (*OS_TaskKeyDestructor_t)(void *value);
+
 
 /*
 **  External Declarations
@@ -158,10 +286,48 @@ void OS_Application_Startup(void);
  * Initialize the tables that the OS API uses to keep track of information
  * about objects
  *
+ * This applies the real-time options configured by OS_REALTIME_OPTIONS,
+ * which are none by default.  See OS_API_InitRealtime().
+ *
  * @returns OS_SUCCESS on success, or appropriate error code
  */
 int32 OS_API_Init (void);
 
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Initialization of API for deterministic real-time operation
+ *
+ * Same as OS_API_Init(), but also applies the given combination of
+ * OS_RT_* options:
+ *
+ * OS_RT_LOCK_MEMORY locks all current and future memory of the process
+ * into RAM, which also faults in the OSAL object tables.  If the memory
+ * cannot be locked (e.g. lack of privilege) initialization continues and
+ * the failure is reported by OS_API_GetRealtimeInfo().
+ *
+ * OS_RT_PREFAULT_STACKS touches every page of a new task's stack before
+ * the task entry point runs.
+ *
+ * OS_RT_COUNT_ALLOCATIONS and OS_RT_TRAP_ALLOCATIONS take effect once the
+ * application calls OS_HeapLockdown() and respectively count, or abort
+ * the process on, every heap allocation made from then on.
+ *
+ * @param[in] rt_options Combination of OS_RT_* option flags
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ */
+int32 OS_API_InitRealtime (uint32 rt_options);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Get the state of the real-time options
+ *
+ * @param[out] rt_prop Storage buffer for real-time state
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ */
+int32 OS_API_GetRealtimeInfo (OS_realtime_prop_t *rt_prop);
+
 /*-------------------------------------------------------------------------------------*/
 /**
  * @brief Background thread implementation - waits forever for events to occur.
@@ -273,6 +439,37 @@ int32 OS_TaskCreate            (uint32 *task_id, const char *task_name,
                                 uint32 stack_size,
                                 uint32 priority, uint32 flags);
 
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Creates a task restricted to a set of CPUs and starts running it.
+ *
+ * Same as OS_TaskCreate() but the task is only allowed to run on the
+ * CPUs selected in cpu_mask, where bit N selects CPU N.  Pinning a
+ * high-rate task keeps it from being migrated between cores by the
+ * OS scheduler.  A cpu_mask of 0 places no restriction on the task,
+ * which is equivalent to OS_TaskCreate().
+ *
+ * @param[out]  task_id will be set to the ID of the newly-created resource
+ * @param[in]   task_name the name of the new resource to create
+ * @param[in]   function_pointer the entry point of the new task
+ * @param[in]   stack_pointer pointer to the stack for the task, or NULL
+ *              to allocate a stack from the system memory heap
+ * @param[in]   stack_size the size of the stack, or 0 to use a default stack size.
+ * @param[in]   priority initial priority of the new task
+ * @param[in]   flags initial options for the new task
+ * @param[in]   cpu_mask CPUs the task may run on, or 0 for any CPU
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * (same as OS_TaskCreate(), plus)
+ * OS_ERR_NOT_IMPLEMENTED if the OS does not support CPU affinity
+ */
+int32 OS_TaskCreateAffinity    (uint32 *task_id, const char *task_name,
+                                osal_task_entry function_pointer,
+                                uint32 *stack_pointer,
+                                uint32 stack_size,
+                                uint32 priority, uint32 flags,
+                                uint32 cpu_mask);
+
 /*-------------------------------------------------------------------------------------*/
 /**
  * @brief Deletes the specified Task
@@ -318,6 +515,64 @@ int32 OS_TaskInstallDeleteHandler(osal_task_entry function_pointer);
  */
 int32 OS_TaskDelay             (uint32 millisecond);
 
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Delay a task for specified amount of microseconds
+ *
+ * Same as OS_TaskDelay() but with microsecond resolution, for short delays
+ * in control loops.  The achieved resolution depends on the underlying OS;
+ * on tick-based kernels the delay is rounded up to whole ticks.
+ *
+ * @param[in]   microsecond    Amount of time to delay
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ */
+int32 OS_TaskDelayMicros       (uint32 microsecond);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Make the calling task periodic
+ *
+ * Establishes a fixed release period for the calling task.  The first
+ * release point is one period from now; each call to OS_TaskWaitPeriod()
+ * then sleeps until the next release point on the monotonic clock.
+ * Because release points are absolute, execution time within a cycle
+ * does not accumulate as drift.
+ *
+ * Calling this again restarts the schedule from the current time and
+ * clears the cycle and overrun counters.  A period of zero makes the
+ * task non-periodic.
+ *
+ * @param[in]   period_usec    Period in microseconds, or 0 to disable
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the caller is not an OSAL task
+ */
+int32 OS_TaskSetPeriod          (uint32 period_usec);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Wait for the next release point of a periodic task
+ *
+ * Blocks the calling task until its next release point, as established
+ * by OS_TaskSetPeriod(), then advances the release point by one period.
+ *
+ * If the release point has already passed when this is called, the task
+ * has overrun its period.  In that case this returns immediately without
+ * sleeping, and the schedule skips forward to the first release point
+ * that is still in the future so the task stays phase aligned.  The
+ * number of release points that were missed is reported via overruns
+ * (zero when the task was on time) and accumulated in the task
+ * properties returned by OS_TaskGetInfo().
+ *
+ * @param[out]  overruns    Number of missed release points (may be NULL)
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the caller is not an OSAL task
+ * OS_ERR_INCORRECT_OBJ_STATE if no period has been set for the caller
+ */
+int32 OS_TaskWaitPeriod         (uint32 *overruns);
+
 /*-------------------------------------------------------------------------------------*/
 /**
  * @brief Sets the given task to a new priority
@@ -331,6 +586,60 @@ int32 OS_TaskDelay             (uint32 millisecond);
  */
 int32 OS_TaskSetPriority       (uint32 task_id, uint32 new_priority);
 
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Changes the set of CPUs the given task may run on
+ *
+ * Bit N of cpu_mask selects CPU N.  A cpu_mask of 0 removes any
+ * restriction so the task may run on any CPU.
+ *
+ * @param[in] task_id The object ID to operate on
+ * @param[in] cpu_mask CPUs the task may run on, or 0 for any CPU
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the ID passed to it is invalid
+ * OS_ERR_NOT_IMPLEMENTED if the OS does not support CPU affinity
+ * OS_ERROR if the OS rejects the mask (e.g. it selects no available CPU)
+ */
+int32 OS_TaskSetAffinity       (uint32 task_id, uint32 cpu_mask);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Places the given task under deadline (reservation based) scheduling
+ *
+ * The task is guaranteed runtime_usec of CPU time within deadline_usec of
+ * the start of every period_usec, and is throttled by the OS if it tries
+ * to use more.  This is intended for periodic tasks, where it isolates
+ * the rest of the system from a task that overruns its budget.  A
+ * deadline of 0 means the deadline equals the period, and vice versa.
+ *
+ * If the task has not started running yet, the attributes are applied
+ * by the task itself as it starts, so this may be called right after
+ * OS_TaskCreate().  In that case a later rejection by the OS leaves the
+ * task at its fixed priority with zero deadline attributes reported
+ * by OS_TaskGetInfo().
+ *
+ * When the OS cannot provide deadline scheduling the task keeps running
+ * at its fixed priority, so the caller may treat the error as advisory.
+ * Each time the task exceeds its budget the budget_overruns count in
+ * the task properties is incremented, where the OS reports this.
+ *
+ * A runtime_usec of 0 returns the task to fixed priority scheduling.
+ *
+ * @param[in] task_id The object ID to operate on
+ * @param[in] runtime_usec CPU time budget per period in microseconds, or 0 to disable
+ * @param[in] deadline_usec Deadline relative to the start of each period in microseconds
+ * @param[in] period_usec Reservation period in microseconds
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the ID passed to it is invalid
+ * OS_ERR_NOT_IMPLEMENTED if the OS does not support deadline scheduling,
+ *                        or the caller lacks the privilege to use it
+ * OS_ERROR if the times are inconsistent (runtime > deadline > period) or
+ *          the OS could not admit the reservation
+ */
+int32 OS_TaskSetDeadline       (uint32 task_id, uint32 runtime_usec, uint32 deadline_usec, uint32 period_usec);
+
 /*-------------------------------------------------------------------------------------*/
 /**
  * @brief Registration to be called by new tasks after creation
@@ -385,6 +694,117 @@ int32 OS_TaskGetIdByName       (uint32 *task_id, const char *task_name);
  */
 int32 OS_TaskGetInfo           (uint32 task_id, OS_task_prop_t *task_prop);          
 
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Obtain runtime statistics for a task
+ *
+ * Fills in the CPU time consumed by the task, the number of voluntary
+ * and involuntary context switches, and the CPU it last ran on.  Values
+ * the OS cannot provide are left as zero.
+ *
+ * @param[in]   task_id The object ID to operate on
+ * @param[out]  task_stats The statistics buffer to fill
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the ID passed to it is invalid
+ * OS_INVALID_POINTER if the task_stats pointer is NULL
+ * OS_ERR_NOT_IMPLEMENTED if the OS does not support task statistics
+ */
+int32 OS_TaskGetStats          (uint32 task_id, OS_task_stats_t *task_stats);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Obtain runtime statistics for all tasks in one pass
+ *
+ * Fills one entry per existing task, in the same form as OS_TaskGetStats().
+ * All entries are gathered while holding the task table lock, so the set
+ * of tasks is consistent.  This is intended for a monitoring task that
+ * samples periodically and computes per-task CPU utilization from the
+ * difference in cpu_time between two snapshots.
+ *
+ * If more tasks exist than max_entries, only the first max_entries are
+ * returned.
+ *
+ * @param[out]  task_stats  Array of at least max_entries entries to fill
+ * @param[in]   max_entries Number of entries in task_stats
+ * @param[out]  num_entries Set to the number of entries filled in
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER if task_stats or num_entries is NULL
+ * OS_ERR_NOT_IMPLEMENTED if the OS does not support task statistics
+ */
+int32 OS_TaskStatsSnapshot     (OS_task_stats_t *task_stats, uint32 max_entries, uint32 *num_entries);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Get statistics of the task stack pool
+ *
+ * Where supported, the stack of a task created with an explicit stack size
+ * is taken from a pool and returned to it when the task ends, so that a
+ * later task of the same size class reuses it rather than having a new
+ * stack allocated.  This reports how well the pool is doing.
+ *
+ * @param[out]  stats  Storage buffer for the pool statistics
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER if stats is NULL
+ * OS_ERR_NOT_IMPLEMENTED if the OS does not pool task stacks
+ */
+int32 OS_TaskGetStackPoolStats (OS_stack_pool_stats_t *stats);
+
+/*
+** Task-local storage API
+*/
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Create a key for task-local values
+ *
+ * Every OSAL task has its own value for each key, initially NULL.  Values
+ * are stored in a fixed array within the task record, so access is
+ * constant time and does not involve an ID lookup.  At most
+ * OS_MAX_TASK_KEYS keys may be created, and keys are never freed.
+ *
+ * When a task ends via OS_TaskExit() or OS_TaskDelete(), the destructor
+ * (if not NULL) is called for each non-NULL value the task had stored.
+ * By then the task has already been removed from the task table, so the
+ * destructor must not depend on the task's identity.  For OS_TaskDelete()
+ * it runs in the context of the deleting task.
+ *
+ * @param[out]  key         Set to the new key
+ * @param[in]   destructor  Function to release values when a task ends (may be NULL)
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER if key is NULL
+ * OS_ERR_NO_FREE_IDS if all keys are in use
+ */
+int32 OS_TaskKeyCreate         (uint32 *key, OS_TaskKeyDestructor_t destructor);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Set the calling task's value for a task-local key
+ *
+ * @param[in]   key     A key returned by OS_TaskKeyCreate()
+ * @param[in]   value   The value to store
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the key is invalid or the caller is not an OSAL task
+ */
+int32 OS_TaskKeySet            (uint32 key, void *value);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Get the calling task's value for a task-local key
+ *
+ * @param[in]   key     A key returned by OS_TaskKeyCreate()
+ * @param[out]  value   Set to the stored value, or NULL if none was set
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER if value is NULL
+ * OS_ERR_INVALID_ID if the key is invalid or the caller is not an OSAL task
+ */
+int32 OS_TaskKeyGet            (uint32 key, void **value);
+
 /*
 ** Message Queue API
 */
@@ -446,6 +866,25 @@ int32 OS_QueueDelete           (uint32 queue_id);
 int32 OS_QueueGet              (uint32 queue_id, void *data, uint32 size, 
                                 uint32 *size_copied, int32 timeout);
 
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Receive a message on a message queue, with a timeout in microseconds
+ *
+ * Same as OS_QueueGet(), except that a timeout other than OS_PEND or OS_CHECK
+ * is given in microseconds.
+ *
+ * @param[in]   queue_id The object ID to operate on
+ * @param[out]  data The buffer to store the received message
+ * @param[in]   size The size of the data buffer
+ * @param[out]  size_copied Set to the actual size of the message
+ * @param[in]   timeout_usec The maximum amount of time to block in microseconds,
+ *                           OS_PEND to wait forever, or OS_CHECK to poll
+ *
+ * @returns Same as OS_QueueGet()
+ */
+int32 OS_QueueGetMicros        (uint32 queue_id, void *data, uint32 size,
+                                uint32 *size_copied, int32 timeout_usec);
+
 /*-------------------------------------------------------------------------------------*/
 /**
  * @brief Put a message on a message queue.
@@ -597,6 +1036,19 @@ int32 OS_BinSemTake            (uint32 sem_id);
  */
 int32 OS_BinSemTimedWait       (uint32 sem_id, uint32 msecs);
 
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Decrement the semaphore value with a timeout in microseconds
+ *
+ * Same as OS_BinSemTimedWait() but with microsecond resolution.
+ *
+ * @param[in] sem_id The object ID to operate on
+ * @param[in] usecs  The maximum amount of time to block, in microseconds
+ *
+ * @returns Same as OS_BinSemTimedWait()
+ */
+int32 OS_BinSemTimedWaitMicros (uint32 sem_id, uint32 usecs);
+
 /*-------------------------------------------------------------------------------------*/
 /**
  * @brief Deletes the specified Binary Semaphore
@@ -725,6 +1177,19 @@ int32 OS_CountSemTake            (uint32 sem_id);
  */
 int32 OS_CountSemTimedWait       (uint32 sem_id, uint32 msecs);
 
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Decrement the semaphore value with a timeout in microseconds
+ *
+ * Same as OS_CountSemTimedWait() but with microsecond resolution.
+ *
+ * @param[in] sem_id The object ID to operate on
+ * @param[in] usecs  The maximum amount of time to block, in microseconds
+ *
+ * @returns Same as OS_CountSemTimedWait()
+ */
+int32 OS_CountSemTimedWaitMicros (uint32 sem_id, uint32 usecs);
+
 /*-------------------------------------------------------------------------------------*/
 /**
  * @brief Deletes the specified counting Semaphore.
@@ -866,6 +1331,17 @@ int32 OS_MutSemGetIdByName      (uint32 *sem_id, const char *sem_name);
  * all of the relevant info( name and creator) about the specified mutex
  * semaphore.
  *
+ * When OSAL is built with OS_MUTEX_DIAGNOSTICS, the structure also reports
+ * the current owner and hold time along with contention and priority
+ * inversion statistics.  A take is counted as an inversion when a task
+ * was blocked for longer than OS_MUTEX_HOLD_WARN_USEC by a task of lower
+ * priority.
+ *
+ * When OSAL is built with OS_MUTEX_LOCKDEP, the order in which each task
+ * takes mutexes is recorded, and taking a mutex while holding another in
+ * the opposite order to one already seen is reported on the console and
+ * counted in lock_order_violations.  Each inverted pair is reported once.
+ *
  * @param[in] sem_id The object ID to operate on
  * @param[out]  mut_prop The property object buffer to fill
  *
@@ -876,68 +1352,658 @@ int32 OS_MutSemGetIdByName      (uint32 *sem_id, const char *sem_name);
 int32 OS_MutSemGetInfo          (uint32 sem_id, OS_mut_sem_prop_t *mut_prop);
 
 /*
-** OS Time/Tick related API
+** Condition Variable API
 */
 
 /*-------------------------------------------------------------------------------------*/
 /**
- * @brief Convert time units from milliseconds to system ticks
+ * @brief Creates a condition variable
  *
- * This function accepts a time interval in milliseconds and
- * returns the tick equivalent.  If the result is not an exact
- * number of system ticks, the result will be rounded up to
- * the nearest tick.
+ * A condition variable is created together with its own underlying mutex,
+ * which protects the application-defined predicate associated with the
+ * condition.  The mutex is acquired and released with OS_CondVarLock()
+ * and OS_CondVarUnlock().
  *
- * @param[in]   milli_seconds the number of milliseconds
+ * @param[out]  var_id will be set to the ID of the newly-created resource
+ * @param[in]   var_name the name of the new resource to create
+ * @param[in]   options reserved for future use.  Should be passed as 0.
  *
- * @returns the number of ticks
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER if var_id or var_name are NULL
+ * OS_ERR_NAME_TOO_LONG if the var_name is too long to be stored
+ * OS_ERR_NO_FREE_IDS if there are no more free condition variable Ids
+ * OS_ERR_NAME_TAKEN if there is already a condition variable with the same name
+ * OS_SEM_FAILURE if the OS call failed
  */
-int32 OS_Milli2Ticks           (uint32 milli_seconds);
+int32 OS_CondVarCreate          (uint32 *var_id, const char *var_name, uint32 options);
 
 /*-------------------------------------------------------------------------------------*/
 /**
- * @brief Get the system tick size, in microseconds
+ * @brief Acquire the mutex associated with the condition variable
  *
- * This function returns the duration of a system tick in micro seconds
+ * The mutex must be held by the caller when evaluating or modifying the
+ * predicate, and when calling OS_CondVarWait() or OS_CondVarTimedWait().
  *
- * @note care is taken to ensure this does not return "0" since it is often used
- *  as the divisor in mathematical operations
+ * @param[in] var_id The object ID to operate on
  *
- * @returns duration of a system tick in microseconds
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid condition variable
+ * OS_SEM_FAILURE if an unspecified error occurs
  */
+int32 OS_CondVarLock            (uint32 var_id);
 
-int32 OS_Tick2Micros           (void);
-
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Release the mutex associated with the condition variable
+ *
+ * @param[in] var_id The object ID to operate on
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid condition variable
+ * OS_SEM_FAILURE if an unspecified error occurs
+ */
+int32 OS_CondVarUnlock          (uint32 var_id);
 
 /*-------------------------------------------------------------------------------------*/
 /**
- * @brief Get the local time
+ * @brief Wake up one task waiting on the condition variable
  *
- * This function gets the local time of the machine its on
+ * If no tasks are waiting, this has no effect.
  *
- * @param[out]  time_struct An OS_time_t that will be set to the current time
+ * @param[in] var_id The object ID to operate on
  *
  * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid condition variable
+ * OS_SEM_FAILURE if an unspecified error occurs
  */
-int32  OS_GetLocalTime         (OS_time_t *time_struct);
-
+int32 OS_CondVarSignal          (uint32 var_id);
 
 /*-------------------------------------------------------------------------------------*/
 /**
- * @brief Set the local time
+ * @brief Wake up all tasks waiting on the condition variable
  *
- * This function sets the local time of the machine its on
+ * All waiters are released with a single operation.  Each waiter will
+ * reacquire the associated mutex before returning from its wait call.
  *
- * @param[in]  time_struct An OS_time_t containing the current time
+ * @param[in] var_id The object ID to operate on
  *
  * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid condition variable
+ * OS_SEM_FAILURE if an unspecified error occurs
  */
-int32  OS_SetLocalTime         (OS_time_t *time_struct);  
-
-/*
-** Exception API
-** NOTE: Not implemented in current OSAL version
-*/
+int32 OS_CondVarBroadcast       (uint32 var_id);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Wait on the condition variable
+ *
+ * The caller must hold the associated mutex (see OS_CondVarLock()).  The
+ * mutex is atomically released while waiting and reacquired before this
+ * function returns.  As spurious wakeups are possible, the caller should
+ * always re-check its predicate after this returns.
+ *
+ * @param[in] var_id The object ID to operate on
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid condition variable
+ * OS_SEM_FAILURE if an unspecified error occurs
+ */
+int32 OS_CondVarWait            (uint32 var_id);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Wait on the condition variable with a timeout
+ *
+ * Same as OS_CondVarWait() but will return OS_SEM_TIMEOUT if the
+ * condition is not signaled within the given time.  The associated
+ * mutex is reacquired before returning in either case.
+ *
+ * @param[in] var_id The object ID to operate on
+ * @param[in] msecs  The maximum amount of time to wait, in milliseconds
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_SEM_TIMEOUT if the condition was not signaled in the specified time
+ * OS_ERR_INVALID_ID if the id passed in is not a valid condition variable
+ * OS_SEM_FAILURE if an unspecified error occurs
+ */
+int32 OS_CondVarTimedWait       (uint32 var_id, uint32 msecs);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Deletes the specified condition variable.
+ *
+ * @param[in] var_id The object ID to delete
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_OBJECT_IN_USE if tasks are currently waiting on the condition, or a task holds its mutex
+ * OS_ERR_OBJECT_IN_USE if tasks are currently waiting on the condition
+ * OS_SEM_FAILURE if the OS call failed
+ */
+int32 OS_CondVarDelete          (uint32 var_id);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Find an existing condition variable ID by name
+ *
+ * @param[out] var_id will be set to the ID of the existing resource
+ * @param[in]  var_name the name of the existing resource to find
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER is var_id or var_name are NULL pointers
+ * OS_ERR_NAME_TOO_LONG if the name given is to long to have been stored
+ * OS_ERR_NAME_NOT_FOUND if the name was not found in the table
+ */
+int32 OS_CondVarGetIdByName     (uint32 *var_id, const char *var_name);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Fill a property object buffer with details regarding the resource
+ *
+ * @param[in]  var_id The object ID to operate on
+ * @param[out] condvar_prop The property object buffer to fill
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid condition variable
+ * OS_INVALID_POINTER if the condvar_prop pointer is null
+ */
+int32 OS_CondVarGetInfo         (uint32 var_id, OS_condvar_prop_t *condvar_prop);
+
+/*
+** Barrier API
+*/
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Creates a barrier
+ *
+ * A barrier blocks each calling task in OS_BarrierWait() until the
+ * specified number of tasks have arrived, at which point all of them
+ * are released together.  The barrier then resets automatically for
+ * the next cycle.
+ *
+ * @param[out]  barrier_id will be set to the ID of the newly-created resource
+ * @param[in]   barrier_name the name of the new resource to create
+ * @param[in]   count the number of tasks that must arrive to release the barrier
+ * @param[in]   options reserved for future use.  Should be passed as 0.
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER if barrier_id or barrier_name are NULL
+ * OS_INVALID_SEM_VALUE if count is zero
+ * OS_ERR_NAME_TOO_LONG if the barrier_name is too long to be stored
+ * OS_ERR_NO_FREE_IDS if there are no more free barrier Ids
+ * OS_ERR_NAME_TAKEN if there is already a barrier with the same name
+ * OS_SEM_FAILURE if the OS call failed
+ */
+int32 OS_BarrierCreate          (uint32 *barrier_id, const char *barrier_name, uint32 count, uint32 options);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Wait at the barrier until all participants have arrived
+ *
+ * The task that completes the set releases all waiting tasks with a
+ * single broadcast operation and does not block itself.
+ *
+ * @param[in] barrier_id The object ID to operate on
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid barrier
+ * OS_SEM_FAILURE if an unspecified error occurs
+ */
+int32 OS_BarrierWait            (uint32 barrier_id);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Deletes the specified barrier.
+ *
+ * @param[in] barrier_id The object ID to delete
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid barrier
+ * OS_ERR_OBJECT_IN_USE if tasks are currently waiting at the barrier
+ * OS_SEM_FAILURE if the OS call failed
+ */
+int32 OS_BarrierDelete          (uint32 barrier_id);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Find an existing barrier ID by name
+ *
+ * @param[out] barrier_id will be set to the ID of the existing resource
+ * @param[in]  barrier_name the name of the existing resource to find
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER is barrier_id or barrier_name are NULL pointers
+ * OS_ERR_NAME_TOO_LONG if the name given is to long to have been stored
+ * OS_ERR_NAME_NOT_FOUND if the name was not found in the table
+ */
+int32 OS_BarrierGetIdByName     (uint32 *barrier_id, const char *barrier_name);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Fill a property object buffer with details regarding the resource
+ *
+ * This function will pass back the name, creator, participant count and
+ * the number of tasks currently waiting at the barrier.
+ *
+ * @param[in]  barrier_id The object ID to operate on
+ * @param[out] barrier_prop The property object buffer to fill
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid barrier
+ * OS_INVALID_POINTER if the barrier_prop pointer is null
+ */
+int32 OS_BarrierGetInfo         (uint32 barrier_id, OS_barrier_prop_t *barrier_prop);
+
+/*
+** Worker Pool API
+*/
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Creates a pool of worker tasks for executing short jobs
+ *
+ * The pool starts the requested number of worker tasks, each of which is
+ * a normal OSAL task and may use the entire OSAL API.  Every worker owns a
+ * queue of pending jobs; a worker services its own queue newest-first and,
+ * when that is empty, steals the oldest job from another worker's queue.
+ *
+ * Jobs submitted by a worker of the same pool are queued to that worker,
+ * jobs submitted by any other task are distributed round-robin.
+ *
+ * The workers are named after the pool with a ".N" suffix, so the pool
+ * name may be at most OS_MAX_API_NAME - 4 characters long.
+ *
+ * @param[out]  pool_id will be set to the ID of the newly-created resource
+ * @param[in]   pool_name the name of the new resource to create
+ * @param[in]   num_workers the number of worker tasks to start
+ * @param[in]   stack_size the stack size of each worker task
+ * @param[in]   priority the priority of each worker task
+ * @param[in]   flags reserved for future use.  Should be passed as 0.
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER if pool_id or pool_name are NULL
+ * OS_QUEUE_INVALID_SIZE if num_workers is zero or exceeds the supported maximum
+ * OS_ERR_NAME_TOO_LONG if the pool_name is too long to name the workers after
+ * OS_ERR_NO_FREE_IDS if there are no more free pool Ids, or not enough free task Ids
+ * OS_ERR_NAME_TAKEN if there is already a pool with the same name
+ * OS_ERR_INVALID_PRIORITY if the priority is bad
+ * OS_ERROR if the OS call failed
+ */
+int32 OS_WorkPoolCreate         (uint32 *pool_id, const char *pool_name, uint32 num_workers,
+                                 uint32 stack_size, uint32 priority, uint32 flags);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Queues a job for execution by a worker pool
+ *
+ * The job function is called exactly once from one of the pool's worker
+ * tasks.  This call does not block.
+ *
+ * @param[in] pool_id The object ID to operate on
+ * @param[in] func The job function to execute
+ * @param[in] arg Opaque argument passed to the job function
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER if func is NULL
+ * OS_ERR_INVALID_ID if the id passed in is not a valid pool
+ * OS_QUEUE_FULL if all of the worker queues are full
+ * OS_ERR_INCORRECT_OBJ_STATE if the pool is being deleted
+ */
+int32 OS_WorkSubmit             (uint32 pool_id, OS_WorkFunc_t func, void *arg);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Waits until every submitted job has finished executing
+ *
+ * This must not be called from one of the pool's own worker tasks.
+ *
+ * @param[in] pool_id The object ID to operate on
+ * @param[in] msecs The maximum time to wait, or OS_PEND to wait forever
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid pool
+ * OS_ERROR_TIMEOUT if jobs were still outstanding when the timeout expired
+ * OS_ERR_INCORRECT_OBJ_STATE if called from a worker of the same pool
+ */
+int32 OS_WorkPoolWaitIdle       (uint32 pool_id, int32 msecs);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Deletes the specified worker pool.
+ *
+ * Each worker finishes the job it is currently executing and then exits.
+ * Jobs that have not yet started are discarded; use OS_WorkPoolWaitIdle()
+ * beforehand to run them to completion.
+ *
+ * @param[in] pool_id The object ID to delete
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid pool
+ * OS_ERR_INCORRECT_OBJ_STATE if called from a worker of the same pool
+ * OS_ERROR if the OS call failed
+ */
+int32 OS_WorkPoolDelete         (uint32 pool_id);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Find an existing worker pool ID by name
+ *
+ * @param[out] pool_id will be set to the ID of the existing resource
+ * @param[in]  pool_name the name of the existing resource to find
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER is pool_id or pool_name are NULL pointers
+ * OS_ERR_NAME_TOO_LONG if the name given is to long to have been stored
+ * OS_ERR_NAME_NOT_FOUND if the name was not found in the table
+ */
+int32 OS_WorkPoolGetIdByName    (uint32 *pool_id, const char *pool_name);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Fill a property object buffer with details regarding the resource
+ *
+ * This function will pass back the name, creator, worker count and the
+ * job counters of the pool.
+ *
+ * @param[in]  pool_id The object ID to operate on
+ * @param[out] pool_prop The property object buffer to fill
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid pool
+ * OS_INVALID_POINTER if the pool_prop pointer is null
+ */
+int32 OS_WorkPoolGetInfo        (uint32 pool_id, OS_workpool_prop_t *pool_prop);
+
+/*
+** Fiber API
+*/
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Creates a fiber on the calling task
+ *
+ * A fiber is a lightweight cooperative thread of execution with its own
+ * stack.  Fibers are run by the task that created them, in user space and
+ * without involving the OS scheduler, once that task calls OS_FiberRun().
+ * A fiber runs until it returns from its entry point, calls OS_FiberYield(),
+ * or waits in one of the following calls, which then switch to another
+ * fiber of the same task instead of blocking the task:
+ *
+ * OS_TaskDelay(), OS_TaskDelayMicros(), OS_QueueGet(), OS_QueueGetMicros(),
+ * the take and timed wait calls of binary and counting semaphores,
+ * OS_TimedRead(), OS_TimedWrite(), OS_read(), OS_write(),
+ * OS_SocketAccept() and OS_SocketRecvFrom().
+ *
+ * Waits on streams are serviced with a single select over all waiting
+ * fibers.  Semaphore and queue waits are retried whenever another fiber of
+ * the same task has run, and whenever a semaphore is given or a message
+ * is queued by another task.  Other blocking OSAL calls block the whole
+ * task.
+ *
+ * Mutexes are owned by tasks, not fibers: OS_MutSemTake() from a fiber
+ * blocks the whole task while another task holds the mutex, and succeeds
+ * immediately if another fiber of the same task holds it, as the mutex is
+ * recursive.  Fibers must therefore not switch out while holding a mutex
+ * that other fibers of the same task also take.
+ *
+ * A fiber may be created from another fiber, in which case it is run by
+ * the same task.  The fiber is released when its entry point returns.
+ *
+ * Fiber IDs are not OSAL object IDs: they have no object type, so
+ * OS_IdentifyObject() reports them as OS_OBJECT_TYPE_UNDEFINED, and they
+ * are only valid in the fiber API.
+ *
+ * @param[out]  fiber_id will be set to the ID of the newly-created resource
+ * @param[in]   fiber_name the name of the new resource to create
+ * @param[in]   entry the entry point of the fiber
+ * @param[in]   arg opaque argument passed to the entry point
+ * @param[in]   stack_size the size of the fiber stack, or 0 for the default
+ * @param[in]   flags reserved for future use.  Should be passed as 0.
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER if any of the pointers passed in are NULL
+ * OS_ERR_NAME_TOO_LONG if the fiber_name is too long to be stored
+ * OS_ERR_NO_FREE_IDS if there are no more free fiber Ids
+ * OS_ERR_NAME_TAKEN if there is already a fiber with the same name
+ * OS_ERR_INCORRECT_OBJ_STATE if not called from an OSAL task
+ * OS_ERROR if the stack could not be allocated
+ */
+int32 OS_FiberCreate            (uint32 *fiber_id, const char *fiber_name, OS_FiberFunc_t entry,
+                                 void *arg, uint32 stack_size, uint32 flags);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Runs the fibers of the calling task
+ *
+ * Switches between the fibers created by the calling task until all of
+ * them have returned.  Ready fibers are run in FIFO order.  When none is
+ * ready the task sleeps until the next fiber timeout or stream event.
+ *
+ * @returns OS_SUCCESS once all fibers have returned, or appropriate error code
+ * OS_ERR_INCORRECT_OBJ_STATE if not called from an OSAL task, or called from a fiber
+ */
+int32 OS_FiberRun               (void);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Lets the other ready fibers of the task run before continuing
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INCORRECT_OBJ_STATE if not called from a fiber
+ */
+int32 OS_FiberYield             (void);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Obtain the fiber id of the calling fiber
+ *
+ * @returns Fiber id of the calling fiber, or 0 if not called from a fiber
+ */
+uint32 OS_FiberGetId            (void);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Deletes the specified fiber.
+ *
+ * Fibers are deleted automatically when they return.  This call is for
+ * discarding fibers that will never run to completion, and can only be
+ * used from the task that created the fiber while that task is not inside
+ * OS_FiberRun(), or after that task has been deleted.
+ *
+ * @param[in] fiber_id The object ID to delete
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid fiber
+ * OS_ERR_INCORRECT_OBJ_STATE if the fiber's task may still run it
+ */
+int32 OS_FiberDelete            (uint32 fiber_id);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Find an existing fiber ID by name
+ *
+ * @param[out] fiber_id will be set to the ID of the existing resource
+ * @param[in]  fiber_name the name of the existing resource to find
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER is fiber_id or fiber_name are NULL pointers
+ * OS_ERR_NAME_TOO_LONG if the name given is to long to have been stored
+ * OS_ERR_NAME_NOT_FOUND if the name was not found in the table
+ */
+int32 OS_FiberGetIdByName       (uint32 *fiber_id, const char *fiber_name);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Fill a property object buffer with details regarding the resource
+ *
+ * This function will pass back the name, creator, host task, stack size
+ * and switch count of the fiber.
+ *
+ * @param[in]  fiber_id The object ID to operate on
+ * @param[out] fiber_prop The property object buffer to fill
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid fiber
+ * OS_INVALID_POINTER if the fiber_prop pointer is null
+ */
+int32 OS_FiberGetInfo           (uint32 fiber_id, OS_fiber_prop_t *fiber_prop);
+
+/*
+** OS Time/Tick related API
+*/
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Convert time units from milliseconds to system ticks
+ *
+ * This function accepts a time interval in milliseconds and
+ * returns the tick equivalent.  If the result is not an exact
+ * number of system ticks, the result will be rounded up to
+ * the nearest tick.
+ *
+ * @param[in]   milli_seconds the number of milliseconds
+ *
+ * @returns the number of ticks
+ */
+int32 OS_Milli2Ticks           (uint32 milli_seconds);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Get the system tick size, in microseconds
+ *
+ * This function returns the duration of a system tick in micro seconds
+ *
+ * @note care is taken to ensure this does not return "0" since it is often used
+ *  as the divisor in mathematical operations
+ *
+ * @returns duration of a system tick in microseconds
+ */
+
+int32 OS_Tick2Micros           (void);
+
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Get the local time
+ *
+ * This function gets the local time of the machine its on
+ *
+ * @param[out]  time_struct An OS_time_t that will be set to the current time
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ */
+int32  OS_GetLocalTime         (OS_time_t *time_struct);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Get the monotonic time
+ *
+ * This function gets the time from a clock that only ever moves forward at
+ * a steady rate.  Unlike the local time it does not jump when the local time
+ * is set or adjusted, so it is the one to use for measuring intervals.  The
+ * starting point of the clock is unspecified.
+ *
+ * @param[out]  time_struct An OS_time_t that will be set to the current time
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ */
+int32  OS_GetMonotonicTime     (OS_time_t *time_struct);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Get the high resolution tick counter
+ *
+ * This function reads the fastest monotonic counter available, for
+ * timestamping code paths where even the cost of converting to an
+ * OS_time_t matters.  The counter moves forward at a steady rate that
+ * depends on the platform; use OS_HighResTicksToNs() to convert the
+ * difference between two readings into nanoseconds.
+ *
+ * @param[out]  ticks   The current value of the counter
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ */
+int32  OS_GetHighResTicks      (uint64 *ticks);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Convert high resolution ticks to nanoseconds
+ *
+ * @param[in]   ticks   A number of ticks, see OS_GetHighResTicks()
+ * @param[out]  ns      The same interval in nanoseconds, rounded down
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * @retval OS_TIMER_ERR_INVALID_ARGS if the interval is too large
+ */
+int32  OS_HighResTicksToNs     (uint64 ticks, uint64 *ns);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Convert nanoseconds to high resolution ticks
+ *
+ * @param[in]   ns      An interval in nanoseconds
+ * @param[out]  ticks   The same interval in ticks, rounded down
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * @retval OS_TIMER_ERR_INVALID_ARGS if the interval is too large
+ */
+int32  OS_NsToHighResTicks     (uint64 ns, uint64 *ticks);
+
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Set the local time
+ *
+ * This function sets the local time of the machine its on
+ *
+ * @param[in]  time_struct An OS_time_t containing the current time
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ */
+int32  OS_SetLocalTime         (OS_time_t *time_struct);  
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Advance the virtual clock
+ *
+ * When OSAL is built in virtual time mode, all OSAL time follows a virtual
+ * clock instead of the host clocks: task delays, timed semaphore and queue
+ * waits, the local time and the simulated time bases.
+ *
+ * This function moves the virtual clock forward by the given interval.
+ * Every delay, timeout and timer that falls due in that interval is
+ * processed in order, as if the time had passed, and the function returns
+ * once the clock has reached the end of the interval.  The time taken
+ * depends only on the work done by the tasks, not on the interval.
+ *
+ * @param[in]  nsecs    The interval to advance the clock by, in nanoseconds
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * @retval OS_TIMER_ERR_INVALID_ARGS if the interval is too large
+ * @retval OS_ERR_NOT_IMPLEMENTED if OSAL is not built in virtual time mode
+ */
+int32  OS_VirtualTimeAdvance   (uint64 nsecs);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Set whether the virtual clock advances automatically
+ *
+ * By default the virtual clock advances by itself: as soon as every task
+ * is waiting, it jumps to the earliest time that any of them waits for.
+ * With automatic advance turned off the clock only moves through
+ * OS_VirtualTimeAdvance(), so that a test harness can step it.
+ *
+ * @param[in]  auto_advance  true to advance the clock automatically
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * @retval OS_ERR_NOT_IMPLEMENTED if OSAL is not built in virtual time mode
+ */
+int32  OS_VirtualTimeSetAuto   (bool auto_advance);
+
+/*
+** Exception API
+** NOTE: Not implemented in current OSAL version
+*/
 
 /*-------------------------------------------------------------------------------------*/
 /* placeholder; not currently implemented */
@@ -1158,6 +2224,24 @@ int32 OS_ShMemGetIdByName   (uint32 *ShMemId, const char *SegName );
  */
 int32 OS_HeapGetInfo       (OS_heap_prop_t *heap_prop);
 
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Mark the end of application initialization
+ *
+ * From this point on, heap allocations are counted or trapped according
+ * to the OS_RT_COUNT_ALLOCATIONS and OS_RT_TRAP_ALLOCATIONS options given
+ * to OS_API_InitRealtime().  The count is reported by
+ * OS_API_GetRealtimeInfo().  This covers all allocations made by the
+ * process, not just those made through OSAL.
+ *
+ * On POSIX this requires glibc and a build with OSAL_POSIX_HEAP_CHECK
+ * defined, as the C library allocator is replaced for the whole process.
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_NOT_IMPLEMENTED if allocations cannot be tracked on this OS or build
+ */
+int32 OS_HeapLockdown      (void);
+
 /*
 ** API for useful debugging function
 */
@@ -25,6 +25,33 @@
 typedef void (*OS_TimerCallback_t)(uint32 timer_id);
 typedef uint32 (*OS_TimerSync_t)(uint32 timer_id);
 
+/**
+ * @brief Number of buckets in the lateness histogram of a timer or time base
+ *
+ * Bucket 0 counts the callbacks that were less than 4 microseconds late, and
+ * each following bucket covers four times the lateness of the one before it,
+ * i.e. bucket n counts a lateness of at least 4^n and less than 4^(n+1)
+ * microseconds.  The last bucket also counts anything later than that.
+ */
+#define OS_TIMER_LATENCY_BUCKETS    10
+
+/**
+ * @brief Lateness of the callbacks of a timer or of all timers on a time base
+ *
+ * The lateness of a callback is the time from the nominal expiry of the timer
+ * to the entry of the callback, as read from the monotonic clock.  On a time
+ * base driven by an external sync function the nominal time of a tick is not
+ * known, so the lateness is measured from the return of the sync function.
+ */
+typedef struct
+{
+    uint32              count;          /**< Number of callbacks measured */
+    uint32              min_usec;       /**< Smallest lateness in microseconds */
+    uint32              max_usec;       /**< Largest lateness in microseconds */
+    uint32              mean_usec;      /**< Mean lateness in microseconds */
+    uint32              histogram[OS_TIMER_LATENCY_BUCKETS];  /**< Callbacks per lateness bucket */
+} OS_timer_latency_t;
+
 typedef struct 
 {
    char                name[OS_MAX_API_NAME];
@@ -32,6 +59,9 @@ typedef struct
    uint32              start_time;
    uint32              interval_time;
    uint32              accuracy;
+   uint32              overruns;       /**< Expirations dropped while the dispatched callback was still pending */
+   OS_timer_latency_t  latency;        /**< Lateness of the callbacks of the timer */
+   uint64              interval_ns;    /**< Time between expirations in nanoseconds */
 
 } OS_timer_prop_t;
 
@@ -42,8 +72,22 @@ typedef struct
     uint32              nominal_interval_time;
     uint32              freerun_time;
     uint32              accuracy;
+    uint32              overruns;       /**< Ticks of a simulated time base missed while servicing an earlier tick */
+    OS_timer_latency_t  latency;        /**< Lateness of the callbacks of all timers on the time base */
+    uint64              nominal_interval_ns;    /**< Time between ticks in nanoseconds */
+    uint64              freerun_ns;     /**< Free run counter in nanoseconds, see OS_TimeBaseGetFreeRunNs() */
 } OS_timebase_prop_t;
 
+/**
+ * @brief Start and interval of one timer in a batch, see OS_TimerSetBatchNs()
+ */
+typedef struct
+{
+    uint32              timer_id;       /**< Timer to set */
+    uint64              start_time;     /**< Time to the first expiration in nanoseconds */
+    uint64              interval_time;  /**< Time between subsequent expirations in nanoseconds */
+} OS_timer_batch_t;
+
 
 /*-------------------------------------------------------------------------------------*/
 /**
@@ -99,6 +143,46 @@ int32 OS_TimeBaseCreate         (uint32 *timebase_id, const char *timebase_name,
  */
 int32 OS_TimeBaseSet            (uint32 timebase_id, uint32 start_time, uint32 interval_time);
 
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Sets the tick period for simulated time base objects, in nanoseconds
+ *
+ * Same as OS_TimeBaseSet(), but with 64-bit times in nanoseconds.  Time
+ * bases keep all times in nanoseconds internally, so an interval that is
+ * not a whole number of microseconds does not drift.  The OS timer may
+ * still round the interval to its own resolution.
+ *
+ * @param[in]   timebase_id     The timebase resource to configure
+ * @param[in]   start_time      The amount of delay for the first tick, in nanoseconds.
+ * @param[in]   interval_time   The amount of delay between ticks, in nanoseconds.
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_TIMER_ERR_INVALID_ARGS if a time is 2^62 nanoseconds or more
+ */
+int32 OS_TimeBaseSetNs          (uint32 timebase_id, uint64 start_time, uint64 interval_time);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Enables or disables tickless operation of a time base
+ *
+ * A tickless time base does not wake up on every interval. Instead the
+ * underlying OS timer is programmed for the next interval at which one
+ * of the timers on the time base is due, and the intervals in between
+ * are skipped.  Timer callbacks still occur on the interval grid set by
+ * OS_TimeBaseSet(), and the free running counter still accounts for the
+ * skipped intervals.  When no timer is armed the time base sleeps.
+ *
+ * Only simulated time bases (those without an external sync function)
+ * support tickless operation.
+ *
+ * @param[in]   timebase_id     The timebase resource to configure
+ * @param[in]   tickless        true to skip idle intervals, false to tick on every interval
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_NOT_IMPLEMENTED if the time base or the OS does not support tickless operation
+ */
+int32 OS_TimeBaseSetTickless    (uint32 timebase_id, bool tickless);
+
 /*-------------------------------------------------------------------------------------*/
 /**
  * @brief Deletes a time base object
@@ -138,6 +222,9 @@ int32 OS_TimeBaseGetIdByName    (uint32 *timebase_id, const char *timebase_name)
  * This function will pass back a pointer to structure that contains
  *             all of the relevant info( name and creator) about the specified timebase.
  *
+ * The latency member summarizes how late the callbacks of all timers on the
+ * time base were, since the time base was created.
+ *
  * @param[in]   timebase_id     The timebase resource ID
  * @param[out]  timebase_prop   Buffer to store timebase properties
  *
@@ -178,6 +265,23 @@ int32 OS_TimeBaseGetInfo        (uint32 timebase_id, OS_timebase_prop_t *timebas
  */
 int32 OS_TimeBaseGetFreeRun     (uint32 timebase_id, uint32 *freerun_val);
 
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief  Read the 64-bit value of the timebase free run counter
+ *
+ * Same as OS_TimeBaseGetFreeRun(), but the counter is in nanoseconds and
+ * does not roll over in practice.  For a time base with an external sync
+ * function, the units of the sync function are counted as microseconds.
+ *
+ * @param[in]   timebase_id The timebase to operate on
+ * @param[out]  freerun_val Buffer to store the free run counter
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the id passed in is not a valid timebase
+ * OS_INVALID_POINTER if the freerun_val pointer is null
+ */
+int32 OS_TimeBaseGetFreeRunNs   (uint32 timebase_id, uint64 *freerun_val);
+
 /*-------------------------------------------------------------------------------------*/
 /**
  * @brief Create a timer object
@@ -253,6 +357,84 @@ int32 OS_TimerAdd               (uint32 *timer_id, const char *timer_name, uint3
  */
 int32 OS_TimerSet               (uint32 timer_id, uint32 start_time, uint32 interval_time);
 
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Configures the expiration time of the timer object, in nanoseconds
+ *
+ * Same as OS_TimerSet(), but with 64-bit times in nanoseconds.  For a
+ * time base with an external sync function, the units of the sync function
+ * are taken as microseconds, as they are by OS_TimerSet().
+ *
+ * @param[in] timer_id      The timer ID to operate on
+ * @param[in] start_time    Time to the first expiration, in nanoseconds
+ * @param[in] interval_time Time between subsequent intervals, in nanoseconds
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_TIMER_ERR_INVALID_ARGS if a time is 2^62 nanoseconds or more
+ */
+int32 OS_TimerSetNs             (uint32 timer_id, uint64 start_time, uint64 interval_time);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Configures the expiration times of many timers at once, in nanoseconds
+ *
+ * Same as calling OS_TimerSetNs() for each entry of the batch, but each time
+ * base is locked only once for a run of consecutive entries on it, rather than
+ * once per timer, so list the timers of the same time base together.  Either
+ * every timer is set, or, if any ID is not valid, none is.
+ *
+ * The start times of all the timers on a time base are taken from the same
+ * instant, and entry n of the batch is delayed by a further n * phase_step.
+ * A phase_step of zero keeps the start times as given, so timers with the
+ * same start and interval expire on the same tick of the time base.  A
+ * non-zero phase_step spreads the expirations of otherwise identical timers
+ * evenly, e.g. the interval divided by the number of timers.
+ *
+ * Timers created with OS_TimerCreate() each have their own time base, which
+ * is set after the batch, one at a time, so their phases are only as close
+ * as the time that takes.
+ *
+ * @param[in] batch         The timers to set, with their start and interval times
+ * @param[in] count         The number of entries in the batch
+ * @param[in] phase_step    Additional delay of the start of each entry over the
+ *                          previous one, in nanoseconds
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_INVALID_POINTER if the batch is NULL
+ * OS_TIMER_ERR_INVALID_ARGS if the batch is empty, or a time including the
+ * phase offset is 2^62 nanoseconds or more
+ * OS_ERR_INVALID_ID if any timer ID is not valid
+ */
+int32 OS_TimerSetBatchNs        (const OS_timer_batch_t *batch, uint32 count, uint64 phase_step);
+
+/*-------------------------------------------------------------------------------------*/
+/**
+ * @brief Runs the callback of a timer on a worker pool
+ *
+ * By default the callback of a timer is called directly from the time base
+ * task, while the time base is locked.  A slow callback then delays every
+ * other timer on the same time base, as well as any task setting a timer.
+ *
+ * Once a worker pool is configured, each expiration of the timer instead
+ * submits a job to the pool, which calls the callback from one of its
+ * worker tasks without holding the time base.  The callback may then use
+ * the entire OSAL API, including the timer API.  If the previous callback
+ * is still queued or running when the timer expires again, the expiration
+ * is dropped and counted in the overruns reported by OS_TimerGetInfo().
+ *
+ * OS_TimerDelete() skips a callback that is still queued, and waits for
+ * one that is running to return, so the callback never runs after the
+ * timer is deleted.  A callback may still delete its own timer.
+ *
+ * @param[in] timer_id      The timer ID to operate on
+ * @param[in] pool_id       The worker pool to run the callback on, or 0 to
+ *                          call it from the time base task again
+ *
+ * @returns OS_SUCCESS on success, or appropriate error code
+ * OS_ERR_INVALID_ID if the timer or the pool is not valid
+ */
+int32 OS_TimerSetDispatch       (uint32 timer_id, uint32 pool_id);
+
 /*-------------------------------------------------------------------------------------*/
 /**
  * @brief Deletes a timer resource
@@ -260,6 +442,9 @@ int32 OS_TimerSet               (uint32 timer_id, uint32 start_time, uint32 inte
  * The application callback associated with the timer will be stopped,
  * and the resources freed for future use.
  *
+ * If the callback is dispatched to a worker pool and currently running,
+ * this waits for it to return, see OS_TimerSetDispatch().
+ *
  * @param[in] timer_id      The timer ID to operate on
  *
  * @returns OS_SUCCESS on success, or appropriate error code
@@ -290,6 +475,10 @@ int32 OS_TimerGetIdByName       (uint32 *timer_id, const char *timer_name);
  * This function will populate structure with
  * the relevant info (name and creator) about the specified timer.
  *
+ * The latency member summarizes how late the callbacks of the timer were,
+ * since the timer was created.  For a dispatched callback this includes
+ * the time the job spent queued on the worker pool.
+ *
  * @param[in]  timer_id      The timer ID to operate on
  * @param[out] timer_prop    Buffer containing timer properties
  *
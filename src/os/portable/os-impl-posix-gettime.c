@@ -13,7 +13,8 @@
  * \author joseph.p.hickey@nasa.gov
  *
  * Purpose: This file contains implementation for OS_GetTime() and OS_SetTime()
- *      that map to the C library clock_gettime() and clock_settime() calls.
+ *      and the high resolution ticks that map to the C library clock_gettime()
+ *      and clock_settime() calls.
  *      This should be usable on any OS that supports those standard calls.
  *      The OS-specific code must #include the correct headers that define the
  *      prototypes for these functions before including this implementation file.
@@ -67,6 +68,81 @@ int32 OS_GetLocalTime_Impl(OS_time_t *time_struct)
 } /* end OS_GetLocalTime_Impl */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_GetMonotonicTime_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_GetMonotonicTime_Impl(OS_time_t *time_struct)
+{
+    int             Status;
+    int32           ReturnCode;
+    struct timespec time;
+
+    Status = clock_gettime(CLOCK_MONOTONIC, &time);
+
+    if (Status == 0)
+    {
+        time_struct -> seconds = time.tv_sec;
+        time_struct -> microsecs = time.tv_nsec / 1000;
+        ReturnCode = OS_SUCCESS;
+    }
+    else
+    {
+        ReturnCode = OS_ERROR;
+    }
+
+    return ReturnCode;
+} /* end OS_GetMonotonicTime_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_GetHighResTicks_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *           The ticks are nanoseconds of CLOCK_MONOTONIC.  Where the C
+ *           library reads that clock without a system call (e.g. through
+ *           the Linux vDSO, which uses the TSC whenever the kernel found it
+ *           stable) this costs a few tens of nanoseconds.
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_GetHighResTicks_Impl(uint64 *ticks)
+{
+    struct timespec time;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &time) != 0)
+    {
+        return OS_ERROR;
+    }
+
+    *ticks = ((uint64)time.tv_sec * 1000000000) + (uint64)time.tv_nsec;
+
+    return OS_SUCCESS;
+} /* end OS_GetHighResTicks_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_GetHighResTickRate_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_GetHighResTickRate_Impl(uint64 *ticks_per_sec)
+{
+    *ticks_per_sec = 1000000000;
+
+    return OS_SUCCESS;
+} /* end OS_GetHighResTickRate_Impl */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_SetLocalTime_Impl
@@ -45,6 +45,14 @@
                                      DEFINES
  ***************************************************************************************/
 
+/*
+ * Define OSAL_POSIX_VIRTUAL_TIME to make all OSAL time follow a virtual clock
+ * that advances as soon as every task is waiting (see osvirtualtime.c)
+ */
+#if defined(OSAL_POSIX_VIRTUAL_TIME)
+#define OS_POSIX_VIRTUAL_TIME
+#endif
+
 /****************************************************************************************
                                     TYPEDEFS
  ***************************************************************************************/
@@ -101,13 +109,45 @@ int32 OS_Posix_QueueAPI_Impl_Init(void);
 int32 OS_Posix_BinSemAPI_Impl_Init(void);
 int32 OS_Posix_CountSemAPI_Impl_Init(void);
 int32 OS_Posix_MutexAPI_Impl_Init(void);
+int32 OS_Posix_CondVarAPI_Impl_Init(void);
+int32 OS_Posix_BarrierAPI_Impl_Init(void);
+int32 OS_Posix_WorkPoolAPI_Impl_Init(void);
 int32 OS_Posix_ModuleAPI_Impl_Init(void);
 int32 OS_Posix_TimeBaseAPI_Impl_Init(void);
 int32 OS_Posix_StreamAPI_Impl_Init(void);
 int32 OS_Posix_DirAPI_Impl_Init(void);
 int32 OS_Posix_FileSysAPI_Impl_Init(void);
 
-int32 OS_Posix_InternalTaskCreate_Impl (pthread_t *thr, uint32 priority, size_t stacksz, PthreadFuncPtr_t Entry, void *entry_arg);
+int32 OS_Posix_InternalTaskCreate_Impl (pthread_t *thr, uint32 priority, size_t stacksz, uint32 cpu_mask, PthreadFuncPtr_t Entry, void *entry_arg);
+void  OS_Posix_SetThreadName(pthread_t thr, const char *name);
+void  OS_Posix_PrefaultStack(void);
+int32 OS_Posix_StackPoolThreadCreate(pthread_t *pthr, pthread_attr_t *attr, size_t stacksz, PthreadFuncPtr_t entry, void *entry_arg);
+void  OS_Posix_StackPoolRelease(pthread_t thr);
+int32 OS_Posix_TaskDeadlineSet(uint32 local_id, uint32 runtime_usec, uint32 deadline_usec, uint32 period_usec, int fixed_priority);
+void  OS_Posix_TaskDeadlineAttach(uint32 local_id, pid_t kernel_tid);
+void  OS_Posix_TaskDeadlineDetach(uint32 local_id, pid_t kernel_tid);
+void  OS_Posix_TaskDeadlineSync(uint32 local_id);
+void  OS_Posix_TaskDeadlineGetInfo(uint32 local_id, OS_task_prop_t *task_prop);
+int32 OS_Posix_SelectMultipleFd(OS_FdSet *ReadSet, OS_FdSet *WriteSet, int extra_fd, bool *extra_ready, int64 timeout_usec);
+
+#ifdef OS_POSIX_VIRTUAL_TIME
+typedef struct OS_impl_virtual_thread OS_impl_virtual_thread_t;
+
+int32  OS_Posix_VirtualTimeAPI_Impl_Init(void);
+uint64 OS_Posix_VirtualTimeNow(void);
+uint32 OS_Posix_VirtualTimeEvent(void);
+void   OS_Posix_VirtualTimeNotify(void);
+int32  OS_Posix_VirtualTimeWait(uint32 event, uint64 deadline);
+int32  OS_Posix_VirtualTimeSleep(uint64 deadline);
+bool   OS_Posix_VirtualTimeBlock(pthread_mutex_t *mut);
+void   OS_Posix_VirtualTimeUnblock(void);
+void   OS_Posix_VirtualTimeRelease(pthread_mutex_t *mut);
+void   OS_Posix_VirtualTimeRegister(void);
+OS_impl_virtual_thread_t *OS_Posix_VirtualTimeAddThread(void *start_arg);
+void  *OS_Posix_VirtualTimeStartThread(OS_impl_virtual_thread_t *thread);
+void   OS_Posix_VirtualTimeCancel(pthread_t thread);
+void   OS_Posix_VirtualTimeRemoveThread(OS_impl_virtual_thread_t *thread);
+#endif
 
 
 
@@ -24,8 +24,19 @@
                                     INCLUDE FILES
  ***************************************************************************************/
 
+/*
+ * The CPU affinity calls (pthread_setaffinity_np and friends) are GNU
+ * extensions, so they must be requested before any system header is
+ * included.  Where they are unavailable, affinity requests return
+ * OS_ERR_NOT_IMPLEMENTED.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "os-posix.h"
 #include <sched.h>
+#include <sys/syscall.h>
 
 /*
  * Defines
@@ -56,6 +67,26 @@
 #define OS_CONSOLE_ASYNC                true
 #define OS_CONSOLE_TASK_PRIORITY        OS_UTILITYTASK_PRIORITY
 
+/*
+ * Size of a thread name buffer, including the terminator.  Linux limits
+ * the name of a thread to 15 characters.
+ */
+#define OS_POSIX_THREAD_NAME_LEN        16
+
+/*
+ * The calling task's identity is kept in compiler thread-local storage
+ * where available, which is much cheaper to read than pthread_getspecific().
+ * Define OSAL_POSIX_NO_TLS to use only the pthread key, e.g. for toolchains
+ * or C libraries without working TLS support.
+ */
+#if !defined(OSAL_POSIX_NO_TLS)
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define OS_POSIX_THREAD_LOCAL           _Thread_local
+#elif defined(__GNUC__)
+#define OS_POSIX_THREAD_LOCAL           __thread
+#endif
+#endif
+
 /*
  * Global data for the API
  */
@@ -68,6 +99,7 @@
 typedef struct
 {
     pthread_t id;
+    pid_t     kernel_tid;   /* set by the task itself once it is running, 0 until then */
 } OS_impl_task_internal_record_t;
 
 /* queues */
@@ -96,6 +128,31 @@ typedef struct
     pthread_mutex_t id;
 }OS_impl_mut_sem_internal_record_t;
 
+/* Condition variables */
+typedef struct
+{
+    pthread_mutex_t mut;
+    pthread_cond_t  cv;
+    uint32          waiting;
+}OS_impl_condvar_internal_record_t;
+
+/* Barriers */
+typedef struct
+{
+    pthread_mutex_t mut;
+    pthread_cond_t  cv;
+    uint32          waiting;
+    uint32          cycle;
+}OS_impl_barrier_internal_record_t;
+
+/* Worker pools */
+typedef struct
+{
+    pthread_mutex_t lock[OS_WORKPOOL_MAX_WORKERS + 1];
+    sem_t           work_sem;
+    pthread_cond_t  idle_cond;
+}OS_impl_workpool_internal_record_t;
+
 /* Console device */
 typedef struct
 {
@@ -111,6 +168,9 @@ OS_impl_queue_internal_record_t     OS_impl_queue_table         [OS_MAX_QUEUES];
 OS_impl_binsem_internal_record_t    OS_impl_bin_sem_table       [OS_MAX_BIN_SEMAPHORES];
 OS_impl_countsem_internal_record_t  OS_impl_count_sem_table     [OS_MAX_COUNT_SEMAPHORES];
 OS_impl_mut_sem_internal_record_t   OS_impl_mut_sem_table       [OS_MAX_MUTEXES];
+OS_impl_condvar_internal_record_t   OS_impl_condvar_table       [OS_MAX_CONDVARS];
+OS_impl_barrier_internal_record_t   OS_impl_barrier_table       [OS_MAX_BARRIERS];
+OS_impl_workpool_internal_record_t  OS_impl_workpool_table      [OS_MAX_WORKPOOLS];
 OS_impl_console_internal_record_t   OS_impl_console_table       [OS_MAX_CONSOLES];
 
 typedef struct
@@ -130,6 +190,9 @@ static POSIX_GlobalLock_t OS_timebase_table_mut;
 static POSIX_GlobalLock_t OS_module_table_mut;
 static POSIX_GlobalLock_t OS_filesys_table_mut;
 static POSIX_GlobalLock_t OS_console_mut;
+static POSIX_GlobalLock_t OS_condvar_table_mut;
+static POSIX_GlobalLock_t OS_barrier_table_mut;
+static POSIX_GlobalLock_t OS_workpool_table_mut;
 
 static POSIX_GlobalLock_t * const MUTEX_TABLE[] =
       {
@@ -145,11 +208,20 @@ static POSIX_GlobalLock_t * const MUTEX_TABLE[] =
             [OS_OBJECT_TYPE_OS_MODULE] = &OS_module_table_mut,
             [OS_OBJECT_TYPE_OS_FILESYS] = &OS_filesys_table_mut,
             [OS_OBJECT_TYPE_OS_CONSOLE] = &OS_console_mut,
+            [OS_OBJECT_TYPE_OS_CONDVAR] = &OS_condvar_table_mut,
+            [OS_OBJECT_TYPE_OS_BARRIER] = &OS_barrier_table_mut,
+            [OS_OBJECT_TYPE_OS_WORKPOOL] = &OS_workpool_table_mut,
       };
 
 
 POSIX_GlobalVars_t   POSIX_GlobalVars = { 0 };
 
+#ifdef OS_POSIX_THREAD_LOCAL
+/* OSAL ID the calling thread registered with, and its task table index */
+static OS_POSIX_THREAD_LOCAL uint32 OS_Posix_SelfTaskId;
+static OS_POSIX_THREAD_LOCAL uint32 OS_Posix_SelfLocalId;
+#endif
+
 enum
 {
    MUTEX_TABLE_SIZE = (sizeof(MUTEX_TABLE) / sizeof(MUTEX_TABLE[0]))
@@ -161,6 +233,7 @@ const OS_ErrorTable_Entry_t OS_IMPL_ERROR_NAME_TABLE[] = { { 0, NULL } };
  * Local Function Prototypes
  */
 static void  OS_CompAbsDelayTime( uint32 milli_second , struct timespec * tm);
+static void  OS_CompAbsDelayTimeMicros( uint32 micro_second , struct timespec * tm);
 static int   OS_PriorityRemap(uint32 InputPri);
 
 
@@ -176,6 +249,238 @@ static void  OS_NoopSigHandler (int signal)
 {
 } /* end OS_NoopSigHandler */
 
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_MutexUnlock
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Unlock a mutex locked through OS_Posix_MutexLock().  In
+ *           virtual time mode the tasks blocked on it count as running
+ *           again from here.
+ *
+ *-----------------------------------------------------------------*/
+static int OS_Posix_MutexUnlock(pthread_mutex_t *mut)
+{
+   int ret;
+
+   ret = pthread_mutex_unlock(mut);
+#ifdef OS_POSIX_VIRTUAL_TIME
+   OS_Posix_VirtualTimeRelease(mut);
+#endif
+
+   return ret;
+} /* end OS_Posix_MutexUnlock */
+
+#ifdef OS_POSIX_VIRTUAL_TIME
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualDeadline
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Convert an absolute timeout from OS_CompAbsDelayTime()
+ *           to a deadline on the virtual clock, zero if none.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_Posix_VirtualDeadline(const struct timespec *abstime)
+{
+   if (abstime == NULL)
+   {
+      return 0;
+   }
+
+   return ((uint64)abstime->tv_sec * 1000000000) + abstime->tv_nsec;
+} /* end OS_Posix_VirtualDeadline */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_CondWaitCancel
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Relock the mutex of a condition wait that is cancelled,
+ *           as pthread_cond_wait() would.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_Posix_CondWaitCancel(void *arg)
+{
+   pthread_mutex_lock(arg);
+} /* end OS_Posix_CondWaitCancel */
+#endif
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_CondWait
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Wait on a condition variable until it is woken through
+ *           OS_Posix_CondWake() or the absolute timeout passes, or
+ *           forever if the timeout is NULL.  Returns as the
+ *           pthread_cond_timedwait() call does.
+ *
+ *-----------------------------------------------------------------*/
+static int OS_Posix_CondWait(pthread_cond_t *cv, pthread_mutex_t *mut, const struct timespec *abstime)
+{
+#ifdef OS_POSIX_VIRTUAL_TIME
+   uint32 event;
+   int32 status;
+
+   /*
+    * The mutex is held since the condition was checked, so any change to
+    * the condition is notified after the event count is taken here.
+    */
+   event = OS_Posix_VirtualTimeEvent();
+   OS_Posix_MutexUnlock(mut);
+   pthread_cleanup_push(OS_Posix_CondWaitCancel, mut);
+   status = OS_Posix_VirtualTimeWait(event, OS_Posix_VirtualDeadline(abstime));
+   pthread_cleanup_pop(0);
+   pthread_mutex_lock(mut);
+
+   if (status == OS_ERROR_TIMEOUT)
+   {
+      return ETIMEDOUT;
+   }
+   if (status != OS_SUCCESS)
+   {
+      return ENOMEM;
+   }
+   return 0;
+#else
+   if (abstime == NULL)
+   {
+      return pthread_cond_wait(cv, mut);
+   }
+   return pthread_cond_timedwait(cv, mut, abstime);
+#endif
+} /* end OS_Posix_CondWait */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_CondWake
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Wake one or all of the tasks in OS_Posix_CondWait().
+ *
+ *-----------------------------------------------------------------*/
+static int OS_Posix_CondWake(pthread_cond_t *cv, bool all)
+{
+   int ret;
+
+   if (all)
+   {
+      ret = pthread_cond_broadcast(cv);
+   }
+   else
+   {
+      ret = pthread_cond_signal(cv);
+   }
+
+#ifdef OS_POSIX_VIRTUAL_TIME
+   /* tasks waiting on the virtual clock cannot tell one condition from another */
+   OS_Posix_VirtualTimeNotify();
+#endif
+
+   return ret;
+} /* end OS_Posix_CondWake */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_SemWait
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Wait on a POSIX semaphore until it is posted through
+ *           OS_Posix_SemPost() or the absolute timeout passes, or
+ *           forever if the timeout is NULL.  Returns and sets errno
+ *           as the sem_timedwait() call does.
+ *
+ *-----------------------------------------------------------------*/
+static int OS_Posix_SemWait(sem_t *sem, const struct timespec *abstime)
+{
+#ifdef OS_POSIX_VIRTUAL_TIME
+   uint32 event;
+   int32 status;
+
+   while (1)
+   {
+      event = OS_Posix_VirtualTimeEvent();
+      if (sem_trywait(sem) == 0)
+      {
+         return 0;
+      }
+      if (errno != EAGAIN)
+      {
+         return -1;
+      }
+
+      status = OS_Posix_VirtualTimeWait(event, OS_Posix_VirtualDeadline(abstime));
+      if (status != OS_SUCCESS)
+      {
+         errno = (status == OS_ERROR_TIMEOUT) ? ETIMEDOUT : ENOMEM;
+         return -1;
+      }
+   }
+#else
+   if (abstime == NULL)
+   {
+      return sem_wait(sem);
+   }
+   return sem_timedwait(sem, abstime);
+#endif
+} /* end OS_Posix_SemWait */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_SemPost
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Post a POSIX semaphore, waking a task in OS_Posix_SemWait().
+ *
+ *-----------------------------------------------------------------*/
+static int OS_Posix_SemPost(sem_t *sem)
+{
+   int ret;
+
+   ret = sem_post(sem);
+
+#ifdef OS_POSIX_VIRTUAL_TIME
+   OS_Posix_VirtualTimeNotify();
+#endif
+
+   return ret;
+} /* end OS_Posix_SemPost */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_MutexLock
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Lock a mutex that may be held across a wait, such as an
+ *           OSAL mutex or the mutex of a condition variable.  In
+ *           virtual time mode a task blocked here does not keep the
+ *           clock from advancing to the wait of the holder.
+ *
+ *-----------------------------------------------------------------*/
+static int OS_Posix_MutexLock(pthread_mutex_t *mut)
+{
+#ifdef OS_POSIX_VIRTUAL_TIME
+   int ret;
+
+   if (pthread_mutex_trylock(mut) == 0)
+   {
+      return 0;
+   }
+
+   if (!OS_Posix_VirtualTimeBlock(mut))
+   {
+      return 0;
+   }
+   ret = pthread_mutex_lock(mut);
+   OS_Posix_VirtualTimeUnblock();
+
+   return ret;
+#else
+   return pthread_mutex_lock(mut);
+#endif
+} /* end OS_Posix_MutexLock */
+
 
                         
 /*----------------------------------------------------------------
@@ -342,6 +647,15 @@ int32 OS_API_Impl_Init(uint32 idtype)
       case OS_OBJECT_TYPE_OS_MUTEX:
          return_code = OS_Posix_MutexAPI_Impl_Init();
          break;
+      case OS_OBJECT_TYPE_OS_CONDVAR:
+         return_code = OS_Posix_CondVarAPI_Impl_Init();
+         break;
+      case OS_OBJECT_TYPE_OS_BARRIER:
+         return_code = OS_Posix_BarrierAPI_Impl_Init();
+         break;
+      case OS_OBJECT_TYPE_OS_WORKPOOL:
+         return_code = OS_Posix_WorkPoolAPI_Impl_Init();
+         break;
       case OS_OBJECT_TYPE_OS_MODULE:
          return_code = OS_Posix_ModuleAPI_Impl_Init();
          break;
@@ -386,7 +700,13 @@ void OS_IdleLoop_Impl()
     * to keep them masked here (this is different than the original POSIX impl).  The
     * timebase objects have a dedicated thread that will be doing "sigwait" on those.
     */
+#ifdef OS_POSIX_VIRTUAL_TIME
+   OS_Posix_VirtualTimeBlock(NULL);
+#endif
    sigsuspend(&POSIX_GlobalVars.NormalSigMask);
+#ifdef OS_POSIX_VIRTUAL_TIME
+   OS_Posix_VirtualTimeUnblock();
+#endif
 } /* end OS_IdleLoop_Impl */
 
                         
@@ -422,7 +742,18 @@ static void *OS_PthreadTaskEntry(void *arg)
 {
    OS_U32ValueWrapper_t local_arg;
 
+#ifdef OS_POSIX_VIRTUAL_TIME
+   /* the creator made the task known to the clock, see OS_TaskCreate_Impl() */
+   arg = OS_Posix_VirtualTimeStartThread(arg);
+#endif
+
    local_arg.opaque_arg = arg;
+
+   if ((OS_SharedGlobalVars.RealtimeOptions & OS_RT_PREFAULT_STACKS) != 0)
+   {
+      OS_Posix_PrefaultStack();
+   }
+
    OS_TaskEntryPoint(local_arg.value); /* Never returns */
 
    return NULL;
@@ -723,10 +1054,40 @@ int32 OS_Posix_TaskAPI_Impl_Init(void)
    }
 #endif
 
+#ifdef OS_POSIX_VIRTUAL_TIME
+   return OS_Posix_VirtualTimeAPI_Impl_Init();
+#else
    return OS_SUCCESS;
+#endif
 } /* end OS_Posix_TaskAPI_Impl_Init */
 
                         
+#ifdef CPU_SETSIZE
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_CpuMaskToSet
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Converts an OSAL CPU mask (bit N = CPU N) to a cpu_set_t.
+ *           A mask of 0 selects every CPU.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_Posix_CpuMaskToSet(uint32 cpu_mask, cpu_set_t *cpuset)
+{
+    uint32 cpu;
+
+    CPU_ZERO(cpuset);
+    for (cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        if (cpu_mask == 0 || (cpu < 32 && (cpu_mask & (1U << cpu)) != 0))
+        {
+            CPU_SET(cpu, cpuset);
+        }
+    }
+} /* end OS_Posix_CpuMaskToSet */
+#endif
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_Posix_InternalTaskCreate_Impl
@@ -734,9 +1095,11 @@ int32 OS_Posix_TaskAPI_Impl_Init(void)
  *  Purpose: Local helper routine, not part of OSAL API.
  *
  *-----------------------------------------------------------------*/
-int32 OS_Posix_InternalTaskCreate_Impl(pthread_t *pthr, uint32 priority, size_t stacksz, PthreadFuncPtr_t entry, void *entry_arg)
+int32 OS_Posix_InternalTaskCreate_Impl(pthread_t *pthr, uint32 priority, size_t stacksz, uint32 cpu_mask, PthreadFuncPtr_t entry, void *entry_arg)
 {
     int                return_code = 0;
+    int32              pool_status;
+    bool               set_stack_size = false;
     pthread_attr_t     custom_attr;
     struct sched_param priority_holder;
 
@@ -787,6 +1150,8 @@ int32 OS_Posix_InternalTaskCreate_Impl(pthread_t *pthr, uint32 priority, size_t
               OS_DEBUG("pthread_attr_setstacksize error in OS_TaskCreate: %s\n",strerror(return_code));
               return(OS_ERROR);
            }
+
+           set_stack_size = true;
        }
 
        /*
@@ -821,25 +1186,66 @@ int32 OS_Posix_InternalTaskCreate_Impl(pthread_t *pthr, uint32 priority, size_t
      } /* End if user is root */
 
     /*
-     ** Create thread
+     ** Set CPU affinity
+     ** Unlike the priority this does not need elevated privileges
      */
-    return_code = pthread_create(pthr, &custom_attr, entry, entry_arg);
-    if (return_code != 0)
+    if (cpu_mask != 0)
     {
-       OS_DEBUG("pthread_create error in OS_TaskCreate: %s\n",strerror(return_code));
-       return(OS_ERROR);
+#ifdef CPU_SETSIZE
+       cpu_set_t cpuset;
+
+       OS_Posix_CpuMaskToSet(cpu_mask, &cpuset);
+       return_code = pthread_attr_setaffinity_np(&custom_attr, sizeof(cpuset), &cpuset);
+       if (return_code != 0)
+       {
+          OS_DEBUG("pthread_attr_setaffinity_np error in OS_TaskCreate: %s\n",strerror(return_code));
+          return(OS_ERROR);
+       }
+#else
+       return(OS_ERR_NOT_IMPLEMENTED);
+#endif
     }
 
     /*
-     ** Free the resources that are no longer needed
-     ** Since the task is now running - pthread_create() was successful -
-     ** Do not treat anything bad that happens after this point as fatal.
-     ** The task is running, after all - better to leave well enough alone.
+     ** Create thread
+     ** Threads that were given a stack size above are placed on a stack
+     ** from the pool where possible, otherwise the C library allocates the
+     ** stack.  Without task priorities the stack size is not applied, and
+     ** the C library default is used as before.
      */
-    return_code = pthread_detach(*pthr);
-    if (return_code != 0)
+    pool_status = OS_ERR_NOT_IMPLEMENTED;
+    if (set_stack_size)
+    {
+       pool_status = OS_Posix_StackPoolThreadCreate(pthr, &custom_attr, stacksz, entry, entry_arg);
+       if (pool_status == OS_ERROR)
+       {
+          return(OS_ERROR);
+       }
+    }
+
+    if (pool_status != OS_SUCCESS)
     {
-       OS_DEBUG("pthread_detach error in OS_TaskCreate: %s\n",strerror(return_code));
+       return_code = pthread_create(pthr, &custom_attr, entry, entry_arg);
+       if (return_code != 0)
+       {
+          OS_DEBUG("pthread_create error in OS_TaskCreate: %s\n",strerror(return_code));
+          return(OS_ERROR);
+       }
+
+       /*
+        ** Free the resources that are no longer needed
+        ** Since the task is now running - pthread_create() was successful -
+        ** Do not treat anything bad that happens after this point as fatal.
+        ** The task is running, after all - better to leave well enough alone.
+        **
+        ** Threads on pool stacks stay joinable, so that the pool can tell
+        ** when the stack is free again.
+        */
+       return_code = pthread_detach(*pthr);
+       if (return_code != 0)
+       {
+          OS_DEBUG("pthread_detach error in OS_TaskCreate: %s\n",strerror(return_code));
+       }
     }
 
     return_code = pthread_attr_destroy(&custom_attr);
@@ -851,6 +1257,35 @@ int32 OS_Posix_InternalTaskCreate_Impl(pthread_t *pthr, uint32 priority, size_t
     return OS_SUCCESS;
 } /* end OS_Posix_InternalTaskCreate_Impl */
 
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_SetThreadName
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Gives a thread its OSAL name at the OS level, so that tools
+ *           such as top and perf show which task is which.  The kernel
+ *           limits thread names to 15 characters, so longer names are
+ *           truncated.  Failure only affects those tools, so it is not
+ *           reported to the caller.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_SetThreadName(pthread_t thr, const char *name)
+{
+#ifdef __GLIBC__
+    char thread_name[OS_POSIX_THREAD_NAME_LEN];
+    int ret;
+
+    strncpy(thread_name, name, sizeof(thread_name) - 1);
+    thread_name[sizeof(thread_name) - 1] = 0;
+
+    ret = pthread_setname_np(thr, thread_name);
+    if (ret != 0)
+    {
+        OS_DEBUG("pthread_setname_np: %s\n",strerror(ret));
+    }
+#endif
+} /* end OS_Posix_SetThreadName */
+
                         
 /*----------------------------------------------------------------
  *
@@ -863,17 +1298,54 @@ int32 OS_Posix_InternalTaskCreate_Impl(pthread_t *pthr, uint32 priority, size_t
 int32 OS_TaskCreate_Impl (uint32 task_id, uint32 flags)
 {
     OS_U32ValueWrapper_t arg;
+    void *entry_arg;
     int32 return_code;
+#ifdef OS_POSIX_VIRTUAL_TIME
+    OS_impl_virtual_thread_t *vthread;
+#endif
 
     arg.opaque_arg = NULL;
     arg.value = OS_global_task_table[task_id].active_id;
+    entry_arg = arg.opaque_arg;
+    OS_impl_task_table[task_id].kernel_tid = 0;
+    OS_Posix_TaskDeadlineAttach(task_id, 0);
+
+#ifdef OS_POSIX_VIRTUAL_TIME
+    /*
+     * The task counts as running from here, so the clock cannot advance
+     * between the creation of the thread and its start.
+     */
+    vthread = OS_Posix_VirtualTimeAddThread(entry_arg);
+    if (vthread == NULL)
+    {
+       return OS_ERROR;
+    }
+    entry_arg = vthread;
+#endif
 
     return_code = OS_Posix_InternalTaskCreate_Impl(
            &OS_impl_task_table[task_id].id,
            OS_task_table[task_id].priority,
            OS_task_table[task_id].stack_size,
+           OS_task_table[task_id].cpu_mask,
            OS_PthreadTaskEntry,
-           arg.opaque_arg);
+           entry_arg);
+
+#ifdef OS_POSIX_VIRTUAL_TIME
+    if (return_code != OS_SUCCESS)
+    {
+       OS_Posix_VirtualTimeRemoveThread(vthread);
+    }
+#endif
+
+    /*
+     * The new task cannot run past OS_TaskPrepare() until the caller
+     * releases the task table lock, so its thread is still valid here.
+     */
+    if (return_code == OS_SUCCESS)
+    {
+       OS_Posix_SetThreadName(OS_impl_task_table[task_id].id, OS_task_table[task_id].task_name);
+    }
 
    return return_code;
 } /* end OS_TaskCreate_Impl */
@@ -915,6 +1387,12 @@ int32 OS_TaskDelete_Impl (uint32 task_id)
     ** and if that is true there is nothing wrong - everything is OK to continue normally.
     */
     pthread_cancel(OS_impl_task_table[task_id].id);
+#ifdef OS_POSIX_VIRTUAL_TIME
+    OS_Posix_VirtualTimeCancel(OS_impl_task_table[task_id].id);
+#endif
+    OS_Posix_StackPoolRelease(OS_impl_task_table[task_id].id);
+    OS_Posix_TaskDeadlineDetach(task_id, 0);
+    OS_impl_task_table[task_id].kernel_tid = 0;
     return OS_SUCCESS;
 
 } /* end OS_TaskDelete_Impl */
@@ -930,6 +1408,18 @@ int32 OS_TaskDelete_Impl (uint32 task_id)
  *-----------------------------------------------------------------*/
 void OS_TaskExit_Impl()
 {
+    uint32 local_id;
+
+    /*
+     * The task table entry has already been released, so only the
+     * deadline record is detached here, and only if it is still ours.
+     */
+    if (OS_TaskGetSelf_Impl(&local_id) != 0)
+    {
+       OS_Posix_TaskDeadlineDetach(local_id, syscall(SYS_gettid));
+    }
+
+    OS_Posix_StackPoolRelease(pthread_self());
     pthread_exit(NULL);
 
 } /* end OS_TaskExit_Impl */
@@ -937,30 +1427,32 @@ void OS_TaskExit_Impl()
                         
 /*----------------------------------------------------------------
  *
- * Function: OS_TaskDelay_Impl
+ * Function: OS_Posix_TaskDelayUntil
  *
- *  Purpose: Implemented per internal OSAL API
- *           See prototype in os-impl.h for argument/return detail
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Sleep until the given absolute time on the monotonic clock,
+ *           resuming the sleep if it is interrupted by a signal.
  *
  *-----------------------------------------------------------------*/
-int32 OS_TaskDelay_Impl(uint32 millisecond)
+static int32 OS_Posix_TaskDelayUntil(const struct timespec *sleep_end)
 {
-   struct timespec sleep_end;
+#ifndef OS_POSIX_VIRTUAL_TIME
    int status;
+#endif
+   uint32 local_id;
 
-   clock_gettime(CLOCK_MONOTONIC, &sleep_end);
-   sleep_end.tv_sec += millisecond / 1000;
-   sleep_end.tv_nsec += 1000000 * (millisecond % 1000);
-
-   if (sleep_end.tv_nsec >= 1000000000)
+   if (OS_TaskGetSelf_Impl(&local_id) != 0)
    {
-      sleep_end.tv_nsec -= 1000000000;
-      ++sleep_end.tv_sec;
+      OS_Posix_TaskDeadlineSync(local_id);
    }
 
+#ifdef OS_POSIX_VIRTUAL_TIME
+   return OS_Posix_VirtualTimeSleep(OS_Posix_VirtualDeadline(sleep_end));
+#else
+
    do
    {
-      status = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &sleep_end, NULL);
+      status = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, sleep_end, NULL);
    }
    while (status == EINTR);
 
@@ -972,21 +1464,104 @@ int32 OS_TaskDelay_Impl(uint32 millisecond)
    {
      return OS_SUCCESS;
    }
-} /* end OS_TaskDelay_Impl */
+#endif
+} /* end OS_Posix_TaskDelayUntil */
 
                         
 /*----------------------------------------------------------------
  *
- * Function: OS_TaskSetPriority_Impl
+ * Function: OS_Posix_TaskDelay
  *
- *  Purpose: Implemented per internal OSAL API
- *           See prototype in os-impl.h for argument/return detail
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Sleep for the given interval on the monotonic clock, using an
+ *           absolute wake time so that signals do not extend the delay.
  *
  *-----------------------------------------------------------------*/
-int32 OS_TaskSetPriority_Impl (uint32 task_id, uint32 new_priority)
+static int32 OS_Posix_TaskDelay(uint32 seconds, uint32 nanoseconds)
 {
-    int                os_priority;
-    int                ret;
+   struct timespec sleep_end;
+
+#ifdef OS_POSIX_VIRTUAL_TIME
+   uint64 now;
+
+   now = OS_Posix_VirtualTimeNow();
+   sleep_end.tv_sec = now / 1000000000;
+   sleep_end.tv_nsec = now % 1000000000;
+#else
+   clock_gettime(CLOCK_MONOTONIC, &sleep_end);
+#endif
+   sleep_end.tv_sec += seconds;
+   sleep_end.tv_nsec += nanoseconds;
+
+   if (sleep_end.tv_nsec >= 1000000000)
+   {
+      sleep_end.tv_nsec -= 1000000000;
+      ++sleep_end.tv_sec;
+   }
+
+   return OS_Posix_TaskDelayUntil(&sleep_end);
+} /* end OS_Posix_TaskDelay */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskDelay_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskDelay_Impl(uint32 millisecond)
+{
+   return OS_Posix_TaskDelay(millisecond / 1000, 1000000 * (millisecond % 1000));
+} /* end OS_TaskDelay_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskDelayMicros_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskDelayMicros_Impl(uint32 microsecond)
+{
+   return OS_Posix_TaskDelay(microsecond / 1000000, 1000 * (microsecond % 1000000));
+} /* end OS_TaskDelayMicros_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskDelayUntil_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskDelayUntil_Impl(const OS_time_t *wake_time)
+{
+   struct timespec sleep_end;
+
+   sleep_end.tv_sec = wake_time->seconds;
+   sleep_end.tv_nsec = wake_time->microsecs * 1000;
+
+   return OS_Posix_TaskDelayUntil(&sleep_end);
+} /* end OS_TaskDelayUntil_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskSetPriority_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskSetPriority_Impl (uint32 task_id, uint32 new_priority)
+{
+    int                os_priority;
+    int                ret;
 
     if (POSIX_GlobalVars.EnableTaskPriorities)
     {
@@ -1009,6 +1584,61 @@ int32 OS_TaskSetPriority_Impl (uint32 task_id, uint32 new_priority)
 } /* end OS_TaskSetPriority_Impl */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskSetAffinity_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskSetAffinity_Impl (uint32 task_id, uint32 cpu_mask)
+{
+#ifdef CPU_SETSIZE
+    cpu_set_t cpuset;
+    int       ret;
+
+    OS_Posix_CpuMaskToSet(cpu_mask, &cpuset);
+    ret = pthread_setaffinity_np(OS_impl_task_table[task_id].id, sizeof(cpuset), &cpuset);
+    if (ret != 0)
+    {
+       OS_DEBUG("pthread_setaffinity_np: %s\n",strerror(ret));
+       return(OS_ERROR);
+    }
+
+    return OS_SUCCESS;
+#else
+    return OS_ERR_NOT_IMPLEMENTED;
+#endif
+} /* end OS_TaskSetAffinity_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskSetDeadline_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskSetDeadline_Impl (uint32 task_id, uint32 runtime_usec, uint32 deadline_usec, uint32 period_usec)
+{
+    int fixed_priority;
+
+    /* The priority the task returns to if deadline scheduling is turned off */
+    if (POSIX_GlobalVars.EnableTaskPriorities)
+    {
+       fixed_priority = OS_PriorityRemap(OS_task_table[task_id].priority);
+    }
+    else
+    {
+       fixed_priority = 0;
+    }
+
+    return OS_Posix_TaskDeadlineSet(task_id, runtime_usec, deadline_usec, period_usec, fixed_priority);
+} /* end OS_TaskSetDeadline_Impl */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_TaskRegister_Impl
@@ -1020,11 +1650,36 @@ int32 OS_TaskSetPriority_Impl (uint32 task_id, uint32 new_priority)
 int32 OS_TaskRegister_Impl(uint32 global_task_id)
 {
    int32 return_code;
+   uint32 local_id;
    OS_U32ValueWrapper_t arg;
 
    arg.opaque_arg = 0;
    arg.value = global_task_id;
 
+   /*
+    * Record the kernel thread ID, which is needed to look up
+    * statistics that the OS only reports per thread ID.
+    *
+    * Note the timebase helper threads also register here, using
+    * their timebase ID, so the ID is not necessarily a task.
+    */
+   if (OS_ObjectIdToArrayIndex(OS_OBJECT_TYPE_OS_TASK, global_task_id, &local_id) == OS_SUCCESS)
+   {
+#ifdef SYS_gettid
+      OS_impl_task_table[local_id].kernel_tid = syscall(SYS_gettid);
+#endif
+      OS_Posix_TaskDeadlineAttach(local_id, OS_impl_task_table[local_id].kernel_tid);
+   }
+   else
+   {
+      local_id = 0;
+   }
+
+#ifdef OS_POSIX_THREAD_LOCAL
+   OS_Posix_SelfTaskId = global_task_id;
+   OS_Posix_SelfLocalId = local_id;
+#endif
+
    return_code = pthread_setspecific(POSIX_GlobalVars.ThreadKey, arg.opaque_arg);
    if (return_code == 0)
    {
@@ -1050,14 +1705,45 @@ int32 OS_TaskRegister_Impl(uint32 global_task_id)
  *-----------------------------------------------------------------*/
 uint32 OS_TaskGetId_Impl (void)
 {
+#ifdef OS_POSIX_THREAD_LOCAL
+   return OS_Posix_SelfTaskId;
+#else
    OS_U32ValueWrapper_t self_record;
 
    self_record.opaque_arg = pthread_getspecific(POSIX_GlobalVars.ThreadKey);
 
    return(self_record.value);
+#endif
 } /* end OS_TaskGetId_Impl */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskGetSelf_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 OS_TaskGetSelf_Impl (uint32 *local_id)
+{
+#ifdef OS_POSIX_THREAD_LOCAL
+   *local_id = OS_Posix_SelfLocalId;
+   return OS_Posix_SelfTaskId;
+#else
+   uint32 task_id;
+
+   task_id = OS_TaskGetId_Impl();
+   if (task_id != 0 && OS_ObjectIdToArrayIndex(OS_OBJECT_TYPE_OS_TASK, task_id, local_id) != OS_SUCCESS)
+   {
+      task_id = 0;
+   }
+
+   return task_id;
+#endif
+} /* end OS_TaskGetSelf_Impl */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_TaskGetInfo_Impl
@@ -1090,10 +1776,162 @@ int32 OS_TaskGetInfo_Impl (uint32 task_id, OS_task_prop_t *task_prop)
    }
 
    memcpy(&task_prop->OStask_id, &OS_impl_task_table[task_id].id, copy_sz);
+   task_prop->os_thread_id = OS_impl_task_table[task_id].kernel_tid;
+
+   OS_Posix_TaskDeadlineGetInfo(task_id, task_prop);
 
    return OS_SUCCESS;
 } /* end OS_TaskGetInfo_Impl */
 
+/*---------------------------------------------------------------------------------------
+   Name: OS_Posix_ParseTaskStatusLine
+
+   Purpose: Picks the context switch counts out of one line of a
+            /proc task status file.
+
+   returns: none
+
+    NOTES: Only used locally by OS_TaskGetThreadStats_Impl
+---------------------------------------------------------------------------------------*/
+static void OS_Posix_ParseTaskStatusLine(const char *line, OS_task_stats_t *task_stats)
+{
+   if (strncmp(line, "voluntary_ctxt_switches:", 24) == 0)
+   {
+      task_stats->voluntary_switches = strtoul(&line[24], NULL, 10);
+   }
+   else if (strncmp(line, "nonvoluntary_ctxt_switches:", 27) == 0)
+   {
+      task_stats->involuntary_switches = strtoul(&line[27], NULL, 10);
+   }
+} /* end OS_Posix_ParseTaskStatusLine */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskGetStats_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskGetStats_Impl (uint32 task_id, OS_task_stats_t *task_stats, uint32 *os_thread_id)
+{
+   clockid_t       cpu_clock;
+   struct timespec cpu_time;
+   int             ret;
+
+   ret = pthread_getcpuclockid(OS_impl_task_table[task_id].id, &cpu_clock);
+   if (ret == 0)
+   {
+      ret = clock_gettime(cpu_clock, &cpu_time);
+   }
+
+   if (ret != 0)
+   {
+      OS_DEBUG("Unable to read task CPU time\n");
+      return OS_ERROR;
+   }
+
+   task_stats->cpu_time.seconds = cpu_time.tv_sec;
+   task_stats->cpu_time.microsecs = cpu_time.tv_nsec / 1000;
+
+   /* The thread ID is not known until the task has started running */
+   *os_thread_id = OS_impl_task_table[task_id].kernel_tid;
+
+   return OS_SUCCESS;
+} /* end OS_TaskGetStats_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskGetThreadStats_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *  The /proc files are read with plain open() and read() into local
+ *  buffers, so that taking a snapshot never allocates memory.
+ *
+ *-----------------------------------------------------------------*/
+void OS_TaskGetThreadStats_Impl (uint32 os_thread_id, OS_task_stats_t *task_stats)
+{
+   char     path[64];
+   char     buf[1024];
+   char     *line;
+   char     *end;
+   char     *p;
+   size_t   len;
+   ssize_t  rdsz;
+   int      fd;
+   int      field;
+
+   /*
+    * The status file is longer than the buffer, so it is scanned a
+    * line at a time, keeping any partial line for the next read.
+    */
+   snprintf(path, sizeof(path), "/proc/self/task/%lu/status", (unsigned long)os_thread_id);
+   fd = open(path, O_RDONLY);
+   if (fd >= 0)
+   {
+      len = 0;
+      while ((rdsz = read(fd, &buf[len], sizeof(buf) - 1 - len)) > 0)
+      {
+         len += rdsz;
+         buf[len] = 0;
+
+         line = buf;
+         while ((end = strchr(line, '\n')) != NULL)
+         {
+            *end = 0;
+            OS_Posix_ParseTaskStatusLine(line, task_stats);
+            line = end + 1;
+         }
+
+         len -= line - buf;
+         if (len >= sizeof(buf) - 1)
+         {
+            /* no line is this long, so just drop it */
+            len = 0;
+         }
+         memmove(buf, line, len);
+      }
+      close(fd);
+   }
+
+   /*
+    * The last CPU is field 39 of the stat file.  Field 2 is the thread
+    * name in parentheses, which may itself contain spaces, so counting
+    * starts after the last closing parenthesis.
+    */
+   snprintf(path, sizeof(path), "/proc/self/task/%lu/stat", (unsigned long)os_thread_id);
+   fd = open(path, O_RDONLY);
+   if (fd >= 0)
+   {
+      len = 0;
+      while (len < sizeof(buf) - 1 && (rdsz = read(fd, &buf[len], sizeof(buf) - 1 - len)) > 0)
+      {
+         len += rdsz;
+      }
+      close(fd);
+      buf[len] = 0;
+
+      p = strrchr(buf, ')');
+      field = 2;
+      while (p != NULL && *p != 0 && field < 39)
+      {
+         if (*p == ' ')
+         {
+            ++field;
+         }
+         ++p;
+      }
+      if (p != NULL && field == 39)
+      {
+         task_stats->last_cpu = strtoul(p, NULL, 10);
+      }
+   }
+} /* end OS_TaskGetThreadStats_Impl */
+
 /****************************************************************************************
                                 MESSAGE QUEUE API
  ***************************************************************************************/
@@ -1261,22 +2099,51 @@ int32 OS_QueueDelete_Impl (uint32 queue_id)
                         
 /*----------------------------------------------------------------
  *
- * Function: OS_QueueGet_Impl
+ * Function: OS_Posix_QueueGet
  *
- *  Purpose: Implemented per internal OSAL API
- *           See prototype in os-impl.h for argument/return detail
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Receive from a queue.  The timeout may be OS_PEND or OS_CHECK,
+ *           otherwise the wait ends at the absolute CLOCK_REALTIME "abstime".
  *
  *-----------------------------------------------------------------*/
-int32 OS_QueueGet_Impl (uint32 queue_id, void *data, uint32 size, uint32 *size_copied, int32 timeout)
+static int32 OS_Posix_QueueGet (uint32 queue_id, void *data, uint32 size, uint32 *size_copied,
+      int32 timeout, const struct timespec *abstime)
 {
    int32 return_code;
    ssize_t sizeCopied;
    struct timespec ts;
+#ifdef OS_POSIX_VIRTUAL_TIME
+   uint32 event;
+   int32 status;
+#endif
 
    /*
     ** Read the message queue for data
     */
    sizeCopied = -1;
+#ifdef OS_POSIX_VIRTUAL_TIME
+   /*
+    * The timeout is on the virtual clock, so poll the queue with a zero
+    * timeout and wait on the virtual clock for a put in between.
+    */
+   memset(&ts, 0, sizeof(ts));
+   while (1)
+   {
+      event = OS_Posix_VirtualTimeEvent();
+      sizeCopied = mq_timedreceive(OS_impl_queue_table[queue_id].id, data, size, NULL, &ts);
+      if (sizeCopied >= 0 || timeout == OS_CHECK || (errno != ETIMEDOUT && errno != EINTR))
+      {
+         break;
+      }
+
+      status = OS_Posix_VirtualTimeWait(event, (timeout == OS_PEND) ? 0 : OS_Posix_VirtualDeadline(abstime));
+      if (status != OS_SUCCESS)
+      {
+         errno = (status == OS_ERROR_TIMEOUT) ? ETIMEDOUT : ENOMEM;
+         break;
+      }
+   }
+#else
    if (timeout == OS_PEND)
    {
       /*
@@ -1307,7 +2174,7 @@ int32 OS_QueueGet_Impl (uint32 queue_id, void *data, uint32 size, uint32 *size_c
       }
       else
       {
-         OS_CompAbsDelayTime( timeout, &ts);
+         ts = *abstime;
       }
 
       /*
@@ -1321,6 +2188,7 @@ int32 OS_QueueGet_Impl (uint32 queue_id, void *data, uint32 size, uint32 *size_c
       while ( timeout != OS_CHECK && sizeCopied < 0 && errno == EINTR );
 
    } /* END timeout */
+#endif
 
    /* Figure out the return code */
    if(sizeCopied == -1)
@@ -1356,9 +2224,51 @@ int32 OS_QueueGet_Impl (uint32 queue_id, void *data, uint32 size, uint32 *size_c
    }
 
    return return_code;
+} /* end OS_Posix_QueueGet */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_QueueGet_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_QueueGet_Impl (uint32 queue_id, void *data, uint32 size, uint32 *size_copied, int32 timeout)
+{
+   struct timespec ts;
+
+   if (timeout != OS_PEND && timeout != OS_CHECK)
+   {
+      OS_CompAbsDelayTime(timeout, &ts);
+   }
+
+   return OS_Posix_QueueGet(queue_id, data, size, size_copied, timeout, &ts);
 } /* end OS_QueueGet_Impl */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_QueueGetMicros_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_QueueGetMicros_Impl (uint32 queue_id, void *data, uint32 size, uint32 *size_copied, int32 timeout_usec)
+{
+   struct timespec ts;
+
+   if (timeout_usec != OS_PEND && timeout_usec != OS_CHECK)
+   {
+      OS_CompAbsDelayTimeMicros(timeout_usec, &ts);
+   }
+
+   return OS_Posix_QueueGet(queue_id, data, size, size_copied, timeout_usec, &ts);
+} /* end OS_QueueGetMicros_Impl */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_QueuePut_Impl
@@ -1390,6 +2300,9 @@ int32 OS_QueuePut_Impl (uint32 queue_id, const void *data, uint32 size, uint32 f
 
    if(result == 0)
    {
+#ifdef OS_POSIX_VIRTUAL_TIME
+      OS_Posix_VirtualTimeNotify();
+#endif
       return_code = OS_SUCCESS;
    }
    else if (errno == ETIMEDOUT)
@@ -1632,7 +2545,7 @@ int32 OS_BinSemGive_Impl ( uint32 sem_id )
     sem->current_value = 1;
 
     /* unblock one thread that is waiting on this sem */
-    pthread_cond_signal(&(sem->cv));
+    OS_Posix_CondWake(&(sem->cv), false);
 
     pthread_mutex_unlock(&(sem->id));
 
@@ -1667,7 +2580,7 @@ int32 OS_BinSemFlush_Impl (uint32 sem_id)
     ++sem->flush_request;
 
     /* unblock all threads that are be waiting on this sem */
-    pthread_cond_broadcast(&(sem->cv));
+    OS_Posix_CondWake(&(sem->cv), true);
 
     pthread_mutex_unlock(&(sem->id));
 
@@ -1719,13 +2632,8 @@ static int32 OS_GenericBinSemTake_Impl (OS_impl_binsem_internal_record_t *sem, c
     */
    while ( sem->current_value == 0 && sem->flush_request == flush_count )
    {
-      /* Must pend until something changes */
-      if (timeout == NULL)
-      {
-         /* wait forever */
-         pthread_cond_wait(&(sem->cv),&(sem->id));
-      }
-      else if (pthread_cond_timedwait(&(sem->cv),&(sem->id),timeout) == ETIMEDOUT)
+      /* Must pend until something changes, forever if there is no timeout */
+      if (OS_Posix_CondWait(&(sem->cv),&(sem->id),timeout) == ETIMEDOUT)
       {
          return_code = OS_SEM_TIMEOUT;
          break;
@@ -1781,18 +2689,36 @@ int32 OS_BinSemTimedWait_Impl ( uint32 sem_id, uint32 msecs )
                         
 /*----------------------------------------------------------------
  *
- * Function: OS_BinSemGetInfo_Impl
+ * Function: OS_BinSemTimedWaitMicros_Impl
  *
  *  Purpose: Implemented per internal OSAL API
  *           See prototype in os-impl.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-int32 OS_BinSemGetInfo_Impl (uint32 sem_id, OS_bin_sem_prop_t *sem_prop)
+int32 OS_BinSemTimedWaitMicros_Impl ( uint32 sem_id, uint32 usecs )
 {
-    /* put the info into the stucture */
-    sem_prop -> value = OS_impl_bin_sem_table[sem_id].current_value;
-    return OS_SUCCESS;
-} /* end OS_BinSemGetInfo_Impl */
+   struct timespec ts;
+
+   OS_CompAbsDelayTimeMicros(usecs, &ts);
+
+   return (OS_GenericBinSemTake_Impl (&OS_impl_bin_sem_table[sem_id], &ts));
+} /* end OS_BinSemTimedWaitMicros_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BinSemGetInfo_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BinSemGetInfo_Impl (uint32 sem_id, OS_bin_sem_prop_t *sem_prop)
+{
+    /* put the info into the stucture */
+    sem_prop -> value = OS_impl_bin_sem_table[sem_id].current_value;
+    return OS_SUCCESS;
+} /* end OS_BinSemGetInfo_Impl */
 
 
 /****************************************************************************************
@@ -1836,299 +2762,1045 @@ int32 OS_CountSemCreate_Impl (uint32 sem_id, uint32 sem_initial_value, uint32 op
 
     if (sem_init(&OS_impl_count_sem_table[sem_id].id, 0, sem_initial_value) < 0)
     {
-        return OS_SEM_FAILURE;
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+
+} /* end OS_CountSemCreate_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CountSemDelete_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CountSemDelete_Impl (uint32 sem_id)
+{
+    if (sem_destroy(&OS_impl_count_sem_table[sem_id].id) < 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+
+} /* end OS_CountSemDelete_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CountSemGive_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CountSemGive_Impl ( uint32 sem_id )
+{
+    if (OS_Posix_SemPost(&OS_impl_count_sem_table[sem_id].id) < 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+
+} /* end OS_CountSemGive_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CountSemTake_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CountSemTake_Impl ( uint32 sem_id )
+{
+    if (OS_Posix_SemWait(&OS_impl_count_sem_table[sem_id].id, NULL) < 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+} /* end OS_CountSemTake_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_CountSemTimedWait
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Wait on a counting semaphore until an absolute time from OS_CompAbsDelayTime()
+ *
+ *-----------------------------------------------------------------*/
+static int32 OS_Posix_CountSemTimedWait ( uint32 sem_id, const struct timespec *abstime )
+{
+   int result;
+
+   if (OS_Posix_SemWait(&OS_impl_count_sem_table[sem_id].id, abstime) == 0)
+   {
+       result = OS_SUCCESS;
+   }
+   else if (errno == ETIMEDOUT)
+   {
+       result = OS_SEM_TIMEOUT;
+   }
+   else
+   {
+       /* unspecified failure */
+       result = OS_SEM_FAILURE;
+   }
+
+   return result;
+} /* end OS_Posix_CountSemTimedWait */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CountSemTimedWait_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CountSemTimedWait_Impl ( uint32 sem_id, uint32 msecs )
+{
+   struct timespec ts;
+
+   /*
+    ** Compute an absolute time for the delay
+    */
+   OS_CompAbsDelayTime(msecs, &ts);
+
+   return OS_Posix_CountSemTimedWait(sem_id, &ts);
+} /* end OS_CountSemTimedWait_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CountSemTimedWaitMicros_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CountSemTimedWaitMicros_Impl ( uint32 sem_id, uint32 usecs )
+{
+   struct timespec ts;
+
+   OS_CompAbsDelayTimeMicros(usecs, &ts);
+
+   return OS_Posix_CountSemTimedWait(sem_id, &ts);
+} /* end OS_CountSemTimedWaitMicros_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CountSemGetInfo_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CountSemGetInfo_Impl (uint32 sem_id, OS_count_sem_prop_t *count_prop)
+{
+    int sval;
+
+    if (sem_getvalue(&OS_impl_count_sem_table[sem_id].id, &sval) < 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    /* put the info into the stucture */
+    count_prop -> value = sval;
+    return OS_SUCCESS;
+} /* end OS_CountSemGetInfo_Impl */
+
+/****************************************************************************************
+                                  MUTEX API
+ ***************************************************************************************/
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_MutexAPI_Impl_Init
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_Posix_MutexAPI_Impl_Init(void)
+{
+   memset(OS_impl_mut_sem_table, 0, sizeof(OS_impl_mut_sem_table));
+   return OS_SUCCESS;
+} /* end OS_Posix_MutexAPI_Impl_Init */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemCreate_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_MutSemCreate_Impl (uint32 sem_id, uint32 options)
+{
+    int                 return_code;
+    pthread_mutexattr_t mutex_attr;
+
+    /*
+    ** initialize the attribute with default values
+    */
+    return_code = pthread_mutexattr_init(&mutex_attr);
+    if ( return_code != 0 )
+    {
+       OS_DEBUG("Error: Mutex could not be created. pthread_mutexattr_init failed ID = %u: %s\n",
+             (unsigned int)sem_id,strerror(return_code));
+       return OS_SEM_FAILURE;
+    }
+
+    /*
+    ** Allow the mutex to use priority inheritance
+    */
+    return_code = pthread_mutexattr_setprotocol(&mutex_attr,PTHREAD_PRIO_INHERIT);
+    if ( return_code != 0 )
+    {
+       OS_DEBUG("Error: Mutex could not be created. pthread_mutexattr_setprotocol failed ID = %u: %s\n",
+             (unsigned int)sem_id,strerror(return_code));
+       return OS_SEM_FAILURE;
+    }
+
+    /*
+    **  Set the mutex type to RECURSIVE so a thread can do nested locks
+    */
+    return_code = pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_RECURSIVE);
+    if ( return_code != 0 )
+    {
+       OS_DEBUG("Error: Mutex could not be created. pthread_mutexattr_settype failed ID = %u: %s\n",
+             (unsigned int)sem_id,strerror(return_code));
+       return OS_SEM_FAILURE;
+    }
+
+    /*
+    ** create the mutex
+    ** upon successful initialization, the state of the mutex becomes initialized and unlocked
+    */
+    return_code = pthread_mutex_init(&OS_impl_mut_sem_table[sem_id].id,&mutex_attr);
+    if ( return_code != 0 )
+    {
+       OS_DEBUG("Error: Mutex could not be created. ID = %u: %s\n",
+             (unsigned int)sem_id,strerror(return_code));
+       return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+} /* end OS_MutSemCreate_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemDelete_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_MutSemDelete_Impl (uint32 sem_id)
+{
+    int status;
+
+    status = pthread_mutex_destroy( &(OS_impl_mut_sem_table[sem_id].id)); /* 0 = success */
+
+    if (status != 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+
+} /* end OS_MutSemDelete_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemGive_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_MutSemGive_Impl ( uint32 sem_id )
+{
+   int status;
+
+   /*
+    ** Unlock the mutex
+    */
+   status = OS_Posix_MutexUnlock(&(OS_impl_mut_sem_table[sem_id].id));
+   if(status != 0)
+   {
+      return OS_SEM_FAILURE;
+   }
+
+   return OS_SUCCESS;
+} /* end OS_MutSemGive_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemTake_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_MutSemTake_Impl ( uint32 sem_id )
+{
+    int status;
+
+    /*
+    ** Lock the mutex
+    */
+    status = OS_Posix_MutexLock(&(OS_impl_mut_sem_table[sem_id].id));
+    if( status != 0 )
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+} /* end OS_MutSemTake_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemGetInfo_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_MutSemGetInfo_Impl (uint32 sem_id, OS_mut_sem_prop_t *mut_prop)
+{
+    return OS_SUCCESS;
+
+} /* end OS_MutSemGetInfo_Impl */
+
+
+/****************************************************************************************
+                               CONDITION VARIABLE API
+ ***************************************************************************************/
+
+/*
+ * Each OSAL condition variable maps directly to a pthread condition variable
+ * plus the pthread mutex that protects the application predicate.
+ */
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_Posix_InitPairedMutex
+
+   Purpose: Local helper routine, not part of OSAL API.
+            Initialize a priority-inheriting mutex and a condition variable that
+            are used together.  If either fails then neither is left initialized.
+
+ ----------------------------------------------------------------------------------------*/
+static int32 OS_Posix_InitPairedMutex(pthread_mutex_t *mut, pthread_cond_t *cv)
+{
+    int ret;
+    int32 return_code;
+    pthread_mutexattr_t mutex_attr;
+
+    ret = pthread_mutexattr_init(&mutex_attr);
+    if (ret != 0)
+    {
+        OS_DEBUG("Error: pthread_mutexattr_init failed: %s\n",strerror(ret));
+        return OS_SEM_FAILURE;
+    }
+
+    return_code = OS_SEM_FAILURE;
+    do
+    {
+        /*
+         ** Use priority inheritance
+         */
+        ret = pthread_mutexattr_setprotocol(&mutex_attr,PTHREAD_PRIO_INHERIT);
+        if (ret != 0)
+        {
+            OS_DEBUG("Error: pthread_mutexattr_setprotocol failed: %s\n",strerror(ret));
+            break;
+        }
+
+        ret = pthread_mutex_init(mut, &mutex_attr);
+        if (ret != 0)
+        {
+            OS_DEBUG("Error: pthread_mutex_init failed: %s\n",strerror(ret));
+            break;
+        }
+
+        ret = pthread_cond_init(cv, NULL);
+        if (ret != 0)
+        {
+            OS_DEBUG("Error: pthread_cond_init failed: %s\n",strerror(ret));
+            pthread_mutex_destroy(mut);
+            break;
+        }
+
+        return_code = OS_SUCCESS;
+    }
+    while (0);
+
+    pthread_mutexattr_destroy(&mutex_attr);
+
+    return return_code;
+} /* end OS_Posix_InitPairedMutex */
+
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_Posix_DestroyPairedMutex
+
+   Purpose: Local helper routine, not part of OSAL API.
+            Destroy a mutex and condition variable initialized by
+            OS_Posix_InitPairedMutex(), unless a task holds the mutex or is counted
+            as waiting.  The waiting count is protected by the mutex.
+
+            This is called with the global table locked, while a task holding the
+            mutex may be waiting for the table lock, so the mutex is only tried.
+
+ ----------------------------------------------------------------------------------------*/
+static int32 OS_Posix_DestroyPairedMutex(pthread_mutex_t *mut, pthread_cond_t *cv, const uint32 *waiting)
+{
+    uint32 in_use;
+
+    if (pthread_mutex_trylock(mut) != 0)
+    {
+        return OS_ERR_OBJECT_IN_USE;
+    }
+
+    in_use = *waiting;
+    OS_Posix_MutexUnlock(mut);
+
+    if (in_use != 0)
+    {
+        return OS_ERR_OBJECT_IN_USE;
+    }
+
+    if (pthread_mutex_destroy(mut) != 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    pthread_cond_destroy(cv);
+
+    return OS_SUCCESS;
+} /* end OS_Posix_DestroyPairedMutex */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_CondVarAPI_Impl_Init
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_Posix_CondVarAPI_Impl_Init(void)
+{
+   memset(OS_impl_condvar_table, 0, sizeof(OS_impl_condvar_table));
+   return OS_SUCCESS;
+} /* end OS_Posix_CondVarAPI_Impl_Init */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarCreate_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarCreate_Impl (uint32 var_id, uint32 options)
+{
+    OS_impl_condvar_internal_record_t *impl;
+
+    impl = &OS_impl_condvar_table[var_id];
+    impl->waiting = 0;
+
+    return OS_Posix_InitPairedMutex(&impl->mut, &impl->cv);
+} /* end OS_CondVarCreate_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarDelete_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarDelete_Impl (uint32 var_id)
+{
+    OS_impl_condvar_internal_record_t *impl;
+
+    impl = &OS_impl_condvar_table[var_id];
+
+    /*
+     * pthread_cond_destroy() is not required to detect waiters (and glibc
+     * does not), so the waiters are counted under the mutex instead.
+     */
+    return OS_Posix_DestroyPairedMutex(&impl->mut, &impl->cv, &impl->waiting);
+} /* end OS_CondVarDelete_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarLock_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarLock_Impl (uint32 var_id)
+{
+    if (OS_Posix_MutexLock(&OS_impl_condvar_table[var_id].mut) != 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+} /* end OS_CondVarLock_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarUnlock_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarUnlock_Impl (uint32 var_id)
+{
+    if (OS_Posix_MutexUnlock(&OS_impl_condvar_table[var_id].mut) != 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+} /* end OS_CondVarUnlock_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarSignal_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarSignal_Impl (uint32 var_id)
+{
+    if (OS_Posix_CondWake(&OS_impl_condvar_table[var_id].cv, false) != 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+} /* end OS_CondVarSignal_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarBroadcast_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarBroadcast_Impl (uint32 var_id)
+{
+    if (OS_Posix_CondWake(&OS_impl_condvar_table[var_id].cv, true) != 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+} /* end OS_CondVarBroadcast_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarWait_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarWait_Impl (uint32 var_id)
+{
+    OS_impl_condvar_internal_record_t *impl;
+
+    int ret;
+
+    impl = &OS_impl_condvar_table[var_id];
+
+    /* the caller holds the mutex, so the count is protected by it */
+    ++impl->waiting;
+    ret = OS_Posix_CondWait(&impl->cv, &impl->mut, NULL);
+    --impl->waiting;
+
+    if (ret != 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+} /* end OS_CondVarWait_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarTimedWait_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarTimedWait_Impl (uint32 var_id, uint32 msecs)
+{
+    OS_impl_condvar_internal_record_t *impl;
+    struct timespec ts;
+    int ret;
+
+    impl = &OS_impl_condvar_table[var_id];
+
+    /*
+     ** Compute an absolute time for the delay
+     */
+    OS_CompAbsDelayTime(msecs, &ts);
+
+    ++impl->waiting;
+    ret = OS_Posix_CondWait(&impl->cv, &impl->mut, &ts);
+    --impl->waiting;
+
+    if (ret == ETIMEDOUT)
+    {
+        return OS_SEM_TIMEOUT;
+    }
+    if (ret != 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+} /* end OS_CondVarTimedWait_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarGetInfo_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarGetInfo_Impl (uint32 var_id, OS_condvar_prop_t *condvar_prop)
+{
+    return OS_SUCCESS;
+} /* end OS_CondVarGetInfo_Impl */
+
+
+/****************************************************************************************
+                                     BARRIER API
+ ***************************************************************************************/
+
+/*
+ * Barriers are built on a mutex and condition variable rather than pthread_barrier_t,
+ * which is an optional part of POSIX and cannot report the number of waiting tasks.
+ *
+ * The "cycle" counter distinguishes successive uses of the same barrier: a waiter
+ * is released when the cycle number changes, which is done by the last arriving task
+ * just before it broadcasts.  This makes spurious wakeups harmless and allows
+ * released tasks to immediately re-enter the barrier for the next cycle.
+ */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_BarrierAPI_Impl_Init
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_Posix_BarrierAPI_Impl_Init(void)
+{
+   memset(OS_impl_barrier_table, 0, sizeof(OS_impl_barrier_table));
+   return OS_SUCCESS;
+} /* end OS_Posix_BarrierAPI_Impl_Init */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierCreate_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierCreate_Impl (uint32 barrier_id, uint32 options)
+{
+    OS_impl_barrier_internal_record_t *impl;
+
+    impl = &OS_impl_barrier_table[barrier_id];
+    impl->waiting = 0;
+    impl->cycle = 0;
+
+    return OS_Posix_InitPairedMutex(&impl->mut, &impl->cv);
+} /* end OS_BarrierCreate_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierDelete_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierDelete_Impl (uint32 barrier_id)
+{
+    OS_impl_barrier_internal_record_t *impl;
+
+    impl = &OS_impl_barrier_table[barrier_id];
+
+    /*
+     * The shared layer holds the barrier exclusively here, so no new task
+     * can enter it; a task that is just leaving still holds the mutex.
+     */
+    return OS_Posix_DestroyPairedMutex(&impl->mut, &impl->cv, &impl->waiting);
+} /* end OS_BarrierDelete_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierWait_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierWait_Impl (uint32 barrier_id)
+{
+    OS_impl_barrier_internal_record_t *impl;
+    uint32 cycle;
+
+    impl = &OS_impl_barrier_table[barrier_id];
+
+    if (pthread_mutex_lock(&impl->mut) != 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    cycle = impl->cycle;
+    ++impl->waiting;
+
+    if (impl->waiting >= OS_barrier_table[barrier_id].count)
+    {
+        /* last one in -- reset for the next cycle and release everyone at once */
+        impl->waiting = 0;
+        ++impl->cycle;
+        OS_Posix_CondWake(&impl->cv, true);
+    }
+    else
+    {
+        while (impl->cycle == cycle)
+        {
+            OS_Posix_CondWait(&impl->cv, &impl->mut, NULL);
+        }
     }
 
+    pthread_mutex_unlock(&impl->mut);
+
     return OS_SUCCESS;
+} /* end OS_BarrierWait_Impl */
 
-} /* end OS_CountSemCreate_Impl */
 
-                        
 /*----------------------------------------------------------------
  *
- * Function: OS_CountSemDelete_Impl
+ * Function: OS_BarrierGetInfo_Impl
  *
  *  Purpose: Implemented per internal OSAL API
  *           See prototype in os-impl.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-int32 OS_CountSemDelete_Impl (uint32 sem_id)
+int32 OS_BarrierGetInfo_Impl (uint32 barrier_id, OS_barrier_prop_t *barrier_prop)
 {
-    if (sem_destroy(&OS_impl_count_sem_table[sem_id].id) < 0)
+    OS_impl_barrier_internal_record_t *impl;
+
+    impl = &OS_impl_barrier_table[barrier_id];
+
+    if (pthread_mutex_lock(&impl->mut) != 0)
     {
         return OS_SEM_FAILURE;
     }
+    barrier_prop->waiting = impl->waiting;
+    pthread_mutex_unlock(&impl->mut);
 
     return OS_SUCCESS;
+} /* end OS_BarrierGetInfo_Impl */
 
-} /* end OS_CountSemDelete_Impl */
 
-                        
+/****************************************************************************************
+                                    WORKER POOL API
+ ***************************************************************************************/
+
+/*
+ * The queue locks are only ever held for a few instructions and all workers
+ * of a pool run at the same priority, so these are plain mutexes.  The pool
+ * lock is paired with the idle condition and uses priority inheritance like
+ * the other OSAL mutexes.
+ */
+
 /*----------------------------------------------------------------
  *
- * Function: OS_CountSemGive_Impl
+ * Function: OS_Posix_WorkPoolAPI_Impl_Init
  *
- *  Purpose: Implemented per internal OSAL API
- *           See prototype in os-impl.h for argument/return detail
+ *  Purpose: Local helper routine, not part of OSAL API.
  *
  *-----------------------------------------------------------------*/
-int32 OS_CountSemGive_Impl ( uint32 sem_id )
+int32 OS_Posix_WorkPoolAPI_Impl_Init(void)
 {
-    if (sem_post(&OS_impl_count_sem_table[sem_id].id) < 0)
-    {
-        return OS_SEM_FAILURE;
-    }
-
-    return OS_SUCCESS;
+   memset(OS_impl_workpool_table, 0, sizeof(OS_impl_workpool_table));
+   return OS_SUCCESS;
+} /* end OS_Posix_WorkPoolAPI_Impl_Init */
 
-} /* end OS_CountSemGive_Impl */
 
-                        
 /*----------------------------------------------------------------
  *
- * Function: OS_CountSemTake_Impl
+ * Function: OS_WorkPoolCreate_Impl
  *
  *  Purpose: Implemented per internal OSAL API
  *           See prototype in os-impl.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-int32 OS_CountSemTake_Impl ( uint32 sem_id )
+int32 OS_WorkPoolCreate_Impl (uint32 pool_id)
 {
-    if (sem_wait(&OS_impl_count_sem_table[sem_id].id) < 0)
+    OS_impl_workpool_internal_record_t *impl;
+    uint32 num_workers;
+    uint32 i;
+    int32 return_code;
+
+    impl = &OS_impl_workpool_table[pool_id];
+    num_workers = OS_workpool_table[pool_id].num_workers;
+
+    if (sem_init(&impl->work_sem, 0, 0) < 0)
+    {
+        OS_DEBUG("Error: sem_init failed: %s\n",strerror(errno));
+        return OS_ERROR;
+    }
+
+    return_code = OS_Posix_InitPairedMutex(&impl->lock[OS_WORKPOOL_POOL_LOCK], &impl->idle_cond);
+    if (return_code != OS_SUCCESS)
+    {
+        sem_destroy(&impl->work_sem);
+        return return_code;
+    }
+
+    for (i = 0; i < num_workers; ++i)
+    {
+        if (pthread_mutex_init(&impl->lock[i], NULL) != 0)
+        {
+            break;
+        }
+    }
+
+    if (i < num_workers)
     {
+        OS_DEBUG("Error: pthread_mutex_init failed\n");
+        while (i > 0)
+        {
+            --i;
+            pthread_mutex_destroy(&impl->lock[i]);
+        }
+        pthread_cond_destroy(&impl->idle_cond);
+        pthread_mutex_destroy(&impl->lock[OS_WORKPOOL_POOL_LOCK]);
+        sem_destroy(&impl->work_sem);
         return OS_SEM_FAILURE;
     }
 
     return OS_SUCCESS;
-} /* end OS_CountSemTake_Impl */
+} /* end OS_WorkPoolCreate_Impl */
+
 
-                        
 /*----------------------------------------------------------------
  *
- * Function: OS_CountSemTimedWait_Impl
+ * Function: OS_WorkPoolDelete_Impl
  *
  *  Purpose: Implemented per internal OSAL API
  *           See prototype in os-impl.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-int32 OS_CountSemTimedWait_Impl ( uint32 sem_id, uint32 msecs )
+int32 OS_WorkPoolDelete_Impl (uint32 pool_id)
 {
-   struct timespec ts;
-   int result;
+    OS_impl_workpool_internal_record_t *impl;
+    uint32 num_workers;
+    uint32 i;
 
-   /*
-    ** Compute an absolute time for the delay
-    */
-   OS_CompAbsDelayTime(msecs, &ts);
+    impl = &OS_impl_workpool_table[pool_id];
+    num_workers = OS_workpool_table[pool_id].num_workers;
 
-   if (sem_timedwait(&OS_impl_count_sem_table[sem_id].id, &ts) == 0)
-   {
-       result = OS_SUCCESS;
-   }
-   else if (errno == ETIMEDOUT)
-   {
-       result = OS_SEM_TIMEOUT;
-   }
-   else
-   {
-       /* unspecified failure */
-       result = OS_SEM_FAILURE;
-   }
+    for (i = 0; i < num_workers; ++i)
+    {
+        pthread_mutex_destroy(&impl->lock[i]);
+    }
+    pthread_cond_destroy(&impl->idle_cond);
+    pthread_mutex_destroy(&impl->lock[OS_WORKPOOL_POOL_LOCK]);
+    sem_destroy(&impl->work_sem);
+
+    return OS_SUCCESS;
+} /* end OS_WorkPoolDelete_Impl */
 
-   return result;
-} /* end OS_CountSemTimedWait_Impl */
 
-                        
 /*----------------------------------------------------------------
  *
- * Function: OS_CountSemGetInfo_Impl
+ * Function: OS_WorkPoolLock_Impl
  *
  *  Purpose: Implemented per internal OSAL API
  *           See prototype in os-impl.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-int32 OS_CountSemGetInfo_Impl (uint32 sem_id, OS_count_sem_prop_t *count_prop)
+int32 OS_WorkPoolLock_Impl (uint32 pool_id, uint32 lock_idx)
 {
-    int sval;
-
-    if (sem_getvalue(&OS_impl_count_sem_table[sem_id].id, &sval) < 0)
+    if (OS_Posix_MutexLock(&OS_impl_workpool_table[pool_id].lock[lock_idx]) != 0)
     {
         return OS_SEM_FAILURE;
     }
 
-    /* put the info into the stucture */
-    count_prop -> value = sval;
     return OS_SUCCESS;
-} /* end OS_CountSemGetInfo_Impl */
-
-/****************************************************************************************
-                                  MUTEX API
- ***************************************************************************************/
+} /* end OS_WorkPoolLock_Impl */
 
-                        
-/*----------------------------------------------------------------
- *
- * Function: OS_Posix_MutexAPI_Impl_Init
- *
- *  Purpose: Local helper routine, not part of OSAL API.
- *
- *-----------------------------------------------------------------*/
-int32 OS_Posix_MutexAPI_Impl_Init(void)
-{
-   memset(OS_impl_mut_sem_table, 0, sizeof(OS_impl_mut_sem_table));
-   return OS_SUCCESS;
-} /* end OS_Posix_MutexAPI_Impl_Init */
 
-                        
 /*----------------------------------------------------------------
  *
- * Function: OS_MutSemCreate_Impl
+ * Function: OS_WorkPoolUnlock_Impl
  *
  *  Purpose: Implemented per internal OSAL API
  *           See prototype in os-impl.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-int32 OS_MutSemCreate_Impl (uint32 sem_id, uint32 options)
+int32 OS_WorkPoolUnlock_Impl (uint32 pool_id, uint32 lock_idx)
 {
-    int                 return_code;
-    pthread_mutexattr_t mutex_attr;
-
-    /*
-    ** initialize the attribute with default values
-    */
-    return_code = pthread_mutexattr_init(&mutex_attr);
-    if ( return_code != 0 )
-    {
-       OS_DEBUG("Error: Mutex could not be created. pthread_mutexattr_init failed ID = %u: %s\n",
-             (unsigned int)sem_id,strerror(return_code));
-       return OS_SEM_FAILURE;
-    }
-
-    /*
-    ** Allow the mutex to use priority inheritance
-    */
-    return_code = pthread_mutexattr_setprotocol(&mutex_attr,PTHREAD_PRIO_INHERIT);
-    if ( return_code != 0 )
-    {
-       OS_DEBUG("Error: Mutex could not be created. pthread_mutexattr_setprotocol failed ID = %u: %s\n",
-             (unsigned int)sem_id,strerror(return_code));
-       return OS_SEM_FAILURE;
-    }
-
-    /*
-    **  Set the mutex type to RECURSIVE so a thread can do nested locks
-    */
-    return_code = pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_RECURSIVE);
-    if ( return_code != 0 )
-    {
-       OS_DEBUG("Error: Mutex could not be created. pthread_mutexattr_settype failed ID = %u: %s\n",
-             (unsigned int)sem_id,strerror(return_code));
-       return OS_SEM_FAILURE;
-    }
-
-    /*
-    ** create the mutex
-    ** upon successful initialization, the state of the mutex becomes initialized and unlocked
-    */
-    return_code = pthread_mutex_init(&OS_impl_mut_sem_table[sem_id].id,&mutex_attr);
-    if ( return_code != 0 )
+    if (OS_Posix_MutexUnlock(&OS_impl_workpool_table[pool_id].lock[lock_idx]) != 0)
     {
-       OS_DEBUG("Error: Mutex could not be created. ID = %u: %s\n",
-             (unsigned int)sem_id,strerror(return_code));
-       return OS_SEM_FAILURE;
+        return OS_SEM_FAILURE;
     }
 
     return OS_SUCCESS;
-} /* end OS_MutSemCreate_Impl */
+} /* end OS_WorkPoolUnlock_Impl */
+
 
-                        
 /*----------------------------------------------------------------
  *
- * Function: OS_MutSemDelete_Impl
+ * Function: OS_WorkPoolPost_Impl
  *
  *  Purpose: Implemented per internal OSAL API
  *           See prototype in os-impl.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-int32 OS_MutSemDelete_Impl (uint32 sem_id)
+int32 OS_WorkPoolPost_Impl (uint32 pool_id)
 {
-    int status;
-
-    status = pthread_mutex_destroy( &(OS_impl_mut_sem_table[sem_id].id)); /* 0 = success */
-
-    if (status != 0)
+    if (OS_Posix_SemPost(&OS_impl_workpool_table[pool_id].work_sem) != 0)
     {
         return OS_SEM_FAILURE;
     }
 
     return OS_SUCCESS;
+} /* end OS_WorkPoolPost_Impl */
 
-} /* end OS_MutSemDelete_Impl */
 
-                        
 /*----------------------------------------------------------------
  *
- * Function: OS_MutSemGive_Impl
+ * Function: OS_WorkPoolPend_Impl
  *
  *  Purpose: Implemented per internal OSAL API
  *           See prototype in os-impl.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-int32 OS_MutSemGive_Impl ( uint32 sem_id )
+int32 OS_WorkPoolPend_Impl (uint32 pool_id)
 {
-   int status;
+    int ret;
 
-   /*
-    ** Unlock the mutex
-    */
-   status = pthread_mutex_unlock(&(OS_impl_mut_sem_table[sem_id].id));
-   if(status != 0)
-   {
-      return OS_SEM_FAILURE;
-   }
+    do
+    {
+        ret = OS_Posix_SemWait(&OS_impl_workpool_table[pool_id].work_sem, NULL);
+    }
+    while (ret < 0 && errno == EINTR);
+
+    if (ret < 0)
+    {
+        return OS_SEM_FAILURE;
+    }
+
+    return OS_SUCCESS;
+} /* end OS_WorkPoolPend_Impl */
 
-   return OS_SUCCESS;
-} /* end OS_MutSemGive_Impl */
 
-                        
 /*----------------------------------------------------------------
  *
- * Function: OS_MutSemTake_Impl
+ * Function: OS_WorkPoolIdleWait_Impl
  *
  *  Purpose: Implemented per internal OSAL API
  *           See prototype in os-impl.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-int32 OS_MutSemTake_Impl ( uint32 sem_id )
+int32 OS_WorkPoolIdleWait_Impl (uint32 pool_id, int32 msecs)
 {
-    int status;
+    OS_impl_workpool_internal_record_t *impl;
+    struct timespec ts;
+    int ret;
 
-    /*
-    ** Lock the mutex
-    */
-    status = pthread_mutex_lock(&(OS_impl_mut_sem_table[sem_id].id));
-    if( status != 0 )
+    impl = &OS_impl_workpool_table[pool_id];
+
+    if (msecs < 0)
+    {
+        ret = OS_Posix_CondWait(&impl->idle_cond, &impl->lock[OS_WORKPOOL_POOL_LOCK], NULL);
+    }
+    else
+    {
+        OS_CompAbsDelayTime(msecs, &ts);
+        ret = OS_Posix_CondWait(&impl->idle_cond, &impl->lock[OS_WORKPOOL_POOL_LOCK], &ts);
+    }
+
+    if (ret == ETIMEDOUT)
+    {
+        return OS_ERROR_TIMEOUT;
+    }
+    if (ret != 0)
     {
         return OS_SEM_FAILURE;
     }
 
     return OS_SUCCESS;
-} /* end OS_MutSemTake_Impl */
+} /* end OS_WorkPoolIdleWait_Impl */
+
 
-                        
 /*----------------------------------------------------------------
  *
- * Function: OS_MutSemGetInfo_Impl
+ * Function: OS_WorkPoolIdleNotify_Impl
  *
  *  Purpose: Implemented per internal OSAL API
  *           See prototype in os-impl.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-int32 OS_MutSemGetInfo_Impl (uint32 sem_id, OS_mut_sem_prop_t *mut_prop)
+int32 OS_WorkPoolIdleNotify_Impl (uint32 pool_id)
 {
-    return OS_SUCCESS;
+    if (OS_Posix_CondWake(&OS_impl_workpool_table[pool_id].idle_cond, true) != 0)
+    {
+        return OS_SEM_FAILURE;
+    }
 
-} /* end OS_MutSemGetInfo_Impl */
+    return OS_SUCCESS;
+} /* end OS_WorkPoolIdleNotify_Impl */
 
 
 /****************************************************************************************
@@ -2250,6 +3922,29 @@ int32 OS_IntGetMask_Impl ( uint32 * MaskSettingPtr )
     return(OS_ERR_NOT_IMPLEMENTED);
 } /* end OS_IntGetMask_Impl */
 
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_WaitClockGetTime
+ *
+ * Purpose:  Local helper function
+ *
+ * Get the current time of the clock that timed waits use, which is
+ * CLOCK_REALTIME or, in virtual time mode, the virtual clock.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_Posix_WaitClockGetTime(struct timespec *tm)
+{
+#ifdef OS_POSIX_VIRTUAL_TIME
+    uint64 now;
+
+    now = OS_Posix_VirtualTimeNow();
+    tm->tv_sec = now / 1000000000;
+    tm->tv_nsec = now % 1000000000;
+#else
+    clock_gettime( CLOCK_REALTIME,  tm );
+#endif
+} /* end OS_Posix_WaitClockGetTime */
+
 /*----------------------------------------------------------------
  *
  * Function: OS_CompAbsDelayTime
@@ -2263,7 +3958,7 @@ int32 OS_IntGetMask_Impl ( uint32 * MaskSettingPtr )
  *-----------------------------------------------------------------*/
 void  OS_CompAbsDelayTime( uint32 msecs, struct timespec * tm)
 {
-    clock_gettime( CLOCK_REALTIME,  tm );
+    OS_Posix_WaitClockGetTime(tm);
 
     /* add the delay to the current time */
     tm->tv_sec  += (time_t) (msecs / 1000) ;
@@ -2277,6 +3972,31 @@ void  OS_CompAbsDelayTime( uint32 msecs, struct timespec * tm)
     }
 } /* end OS_CompAbsDelayTime */
 
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CompAbsDelayTimeMicros
+ *
+ * Purpose:  Local helper function
+ *
+ * Same as OS_CompAbsDelayTime() but the interval is in microseconds.
+ *
+ *-----------------------------------------------------------------*/
+void  OS_CompAbsDelayTimeMicros( uint32 usecs, struct timespec * tm)
+{
+    OS_Posix_WaitClockGetTime(tm);
+
+    /* add the delay to the current time */
+    tm->tv_sec  += (time_t) (usecs / 1000000) ;
+    /* convert residue ( usecs )  to nanoseconds */
+    tm->tv_nsec +=  (usecs % 1000000) * 1000L ;
+
+    if(tm->tv_nsec  >= 1000000000L )
+    {
+        tm->tv_nsec -= 1000000000L ;
+        tm->tv_sec ++ ;
+    }
+} /* end OS_CompAbsDelayTimeMicros */
+
 /*----------------------------------------------------------------------------
  * Name: OS_PriorityRemap
  *
@@ -2488,12 +4208,21 @@ int32 OS_ConsoleCreate_Impl(uint32 local_id)
             {
                 local_arg.value = local_id;
                 return_code = OS_Posix_InternalTaskCreate_Impl(&consoletask, OS_CONSOLE_TASK_PRIORITY, 0,
-                    OS_ConsoleTask_Entry, local_arg.opaque_arg);
+                    OS_CONSOLE_CPU_MASK, OS_ConsoleTask_Entry, local_arg.opaque_arg);
 
                 if (return_code != OS_SUCCESS)
                 {
                     sem_destroy(&OS_impl_console_table[local_id].data_sem);
                 }
+                else if (OS_console_table[local_id].device_name[0] != 0)
+                {
+                    OS_Posix_SetThreadName(consoletask, OS_console_table[local_id].device_name);
+                }
+                else
+                {
+                    /* the default console has no name of its own */
+                    OS_Posix_SetThreadName(consoletask, "console");
+                }
             }
         }
     }
@@ -0,0 +1,445 @@
+/*
+ *      Copyright (c) 2018, United States government as represented by the
+ *      administrator of the National Aeronautics Space Administration.
+ *      All rights reserved. This software was created at NASA Glenn
+ *      Research Center pursuant to government contracts.
+ *
+ *      This is governed by the NASA Open Source Agreement and may be used,
+ *      distributed and modified only according to the terms of that agreement.
+ */
+
+/**
+ * \file   osdeadline.c
+ *
+ * Purpose: This file contains the deadline (SCHED_DEADLINE) scheduling
+ *          support for POSIX tasks on Linux: applying a runtime/deadline/
+ *          period reservation to a task thread, and counting the budget
+ *          overruns the kernel reports for it.
+ *
+ */
+
+/****************************************************************************************
+                                    INCLUDE FILES
+ ***************************************************************************************/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "os-posix.h"
+#include <sched.h>
+#include <sys/syscall.h>
+
+/*
+ * SCHED_DEADLINE is set through the sched_setattr() system call, which
+ * the C library does not necessarily wrap, and it needs the kernel thread
+ * ID of the task.  Without both the reservation requests are rejected
+ * with OS_ERR_NOT_IMPLEMENTED.
+ */
+#if defined(SYS_sched_setattr) && defined(SYS_gettid)
+#define OS_POSIX_SCHED_DEADLINE
+#endif
+
+/*
+ * Values from the kernel's uapi headers, which are not always
+ * provided by the C library headers
+ */
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE              6
+#endif
+#ifndef SCHED_FLAG_RESET_ON_FORK
+#define SCHED_FLAG_RESET_ON_FORK    0x01
+#endif
+#ifndef SCHED_FLAG_DL_OVERRUN
+#define SCHED_FLAG_DL_OVERRUN       0x04
+#endif
+
+/*
+ * Layout of the sched_setattr() argument (SCHED_ATTR_SIZE_VER0)
+ */
+typedef struct
+{
+    uint32 size;
+    uint32 sched_policy;
+    uint64 sched_flags;
+    int32  sched_nice;
+    uint32 sched_priority;
+    uint64 sched_runtime;
+    uint64 sched_deadline;
+    uint64 sched_period;
+} OS_Posix_SchedAttr_t;
+
+/*
+ * Deadline state of each task
+ *
+ * kernel_tid and pending are shared between OS_TaskSetDeadline() and
+ * the task itself as it starts, which happens without the task table
+ * lock, and overruns is updated from the signal handler.
+ *
+ * SIGXCPU is blocked in every thread but those of deadline tasks, so the
+ * overrun signal only ever reaches a task with a reservation.  A thread
+ * can only change its own signal mask, so sigxcpu_unblocked is only
+ * changed by the task itself, as it starts and when it next sleeps
+ * after its reservation has been set or cleared by another task.
+ */
+typedef struct
+{
+    pid_t         kernel_tid;     /**< Kernel thread ID, 0 until the task is running or once it has ended */
+    int           pending;        /**< Reservation waiting for the task to start */
+    volatile sig_atomic_t active; /**< Task is currently under SCHED_DEADLINE */
+    bool          sigxcpu_unblocked; /**< Task thread has SIGXCPU unblocked */
+    bool          rejected;       /**< Pending reservation was refused as the task started */
+    uint64        runtime_ns;
+    uint64        deadline_ns;
+    uint64        period_ns;
+    uint32        overruns;       /**< Budget overruns reported by the kernel */
+} OS_Posix_DeadlineRecord_t;
+
+static OS_Posix_DeadlineRecord_t OS_Posix_DeadlineTable[OS_MAX_TASKS];
+
+#ifdef OS_POSIX_SCHED_DEADLINE
+
+static pthread_once_t OS_Posix_DeadlineHandlerOnce = PTHREAD_ONCE_INIT;
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_Posix_DeadlineOverrunHandler
+
+   Purpose: SIGXCPU handler counting budget overruns of deadline tasks
+
+   returns: None
+
+    NOTES: With SCHED_FLAG_DL_OVERRUN the kernel raises SIGXCPU while the
+           overrunning thread is running, so it is delivered to that
+           thread, which has SIGXCPU unblocked as a deadline task.  Only
+           deadline task threads ever run this handler.  A signal that
+           arrives just after the reservation of the task was cleared is
+           ignored.
+---------------------------------------------------------------------------------------*/
+static void OS_Posix_DeadlineOverrunHandler(int signo)
+{
+    OS_Posix_DeadlineRecord_t *rec;
+    pid_t tid;
+    uint32 i;
+    int saved_errno;
+
+    saved_errno = errno;
+    tid = syscall(SYS_gettid);
+
+    for (i = 0; i < OS_MAX_TASKS; ++i)
+    {
+        rec = &OS_Posix_DeadlineTable[i];
+        if (rec->active && __atomic_load_n(&rec->kernel_tid, __ATOMIC_RELAXED) == tid)
+        {
+            __atomic_add_fetch(&rec->overruns, 1, __ATOMIC_RELAXED);
+            break;
+        }
+    }
+
+    errno = saved_errno;
+}
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_Posix_DeadlineInstallHandler
+
+   Purpose: Install the overrun handler, once, before the first reservation
+
+   returns: None
+---------------------------------------------------------------------------------------*/
+static void OS_Posix_DeadlineInstallHandler(void)
+{
+    struct sigaction act;
+
+    memset(&act, 0, sizeof(act));
+    act.sa_handler = OS_Posix_DeadlineOverrunHandler;
+    act.sa_flags = SA_RESTART;
+    sigemptyset(&act.sa_mask);
+    if (sigaction(SIGXCPU, &act, NULL) != 0)
+    {
+        OS_DEBUG("sigaction(SIGXCPU): %s\n", strerror(errno));
+    }
+}
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_Posix_DeadlineApply
+
+   Purpose: Place the thread under SCHED_DEADLINE with the recorded reservation
+
+   returns: OS_SUCCESS, OS_ERROR if the kernel's admission control refused
+            the reservation, or OS_ERR_NOT_IMPLEMENTED if SCHED_DEADLINE
+            is unavailable to this process
+
+    NOTES: On failure the thread's scheduling is left unchanged, so the
+           task keeps running at its fixed priority.
+---------------------------------------------------------------------------------------*/
+static int32 OS_Posix_DeadlineApply(OS_Posix_DeadlineRecord_t *rec, pid_t tid)
+{
+    OS_Posix_SchedAttr_t attr;
+    long ret;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.sched_policy = SCHED_DEADLINE;
+    attr.sched_runtime = rec->runtime_ns;
+    attr.sched_deadline = rec->deadline_ns;
+    attr.sched_period = rec->period_ns;
+
+    /*
+     * A deadline thread may only create threads if its children are
+     * reset to the default policy; OSAL then sets their own policy.
+     */
+    attr.sched_flags = SCHED_FLAG_RESET_ON_FORK | SCHED_FLAG_DL_OVERRUN;
+
+    ret = syscall(SYS_sched_setattr, tid, &attr, 0);
+    if (ret != 0 && errno == EINVAL)
+    {
+        /* Kernels before 4.16 lack the overrun flag - enforce the budget without counting overruns */
+        attr.sched_flags &= ~(uint64)SCHED_FLAG_DL_OVERRUN;
+        ret = syscall(SYS_sched_setattr, tid, &attr, 0);
+    }
+
+    if (ret != 0)
+    {
+        OS_DEBUG("sched_setattr(SCHED_DEADLINE): %s\n", strerror(errno));
+        if (errno == EBUSY)
+        {
+            return OS_ERROR;
+        }
+        return OS_ERR_NOT_IMPLEMENTED;
+    }
+
+    rec->active = 1;
+    return OS_SUCCESS;
+} /* end OS_Posix_DeadlineApply */
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_Posix_DeadlineSetSignalMask
+
+   Purpose: Unblock SIGXCPU in the calling task if it is under SCHED_DEADLINE,
+            and block it otherwise
+
+   returns: None
+
+    NOTES: Must be called by the task that owns the record, without the
+           task table lock, which restores the previous mask on release.
+---------------------------------------------------------------------------------------*/
+static void OS_Posix_DeadlineSetSignalMask(OS_Posix_DeadlineRecord_t *rec)
+{
+    sigset_t set;
+    bool unblock;
+
+    unblock = (rec->active != 0);
+
+    sigemptyset(&set);
+    sigaddset(&set, SIGXCPU);
+    if (pthread_sigmask(unblock ? SIG_UNBLOCK : SIG_BLOCK, &set, NULL) == 0)
+    {
+        rec->sigxcpu_unblocked = unblock;
+    }
+} /* end OS_Posix_DeadlineSetSignalMask */
+
+#endif /* OS_POSIX_SCHED_DEADLINE */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_TaskDeadlineSet
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Apply or clear the deadline reservation of a task, on behalf
+ *           of OS_TaskSetDeadline_Impl().  When clearing, the task
+ *           returns to the selected fixed priority scheduler at
+ *           fixed_priority.
+ *
+ *           This is called with the task table locked, so the signal
+ *           mask of a running task is updated by OS_Posix_TaskDeadlineSync()
+ *           the next time the task sleeps.
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_Posix_TaskDeadlineSet(uint32 local_id, uint32 runtime_usec, uint32 deadline_usec,
+        uint32 period_usec, int fixed_priority)
+{
+#ifdef OS_POSIX_SCHED_DEADLINE
+    OS_Posix_DeadlineRecord_t *rec;
+    OS_Posix_SchedAttr_t attr;
+    pid_t tid;
+
+    rec = &OS_Posix_DeadlineTable[local_id];
+
+    if (runtime_usec == 0)
+    {
+        __atomic_store_n(&rec->pending, 0, __ATOMIC_SEQ_CST);
+        rec->rejected = false;
+        if (!rec->active)
+        {
+            return OS_SUCCESS;
+        }
+
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.sched_policy = POSIX_GlobalVars.SelectedRtScheduler;
+        attr.sched_priority = fixed_priority;
+        if (syscall(SYS_sched_setattr, rec->kernel_tid, &attr, 0) != 0)
+        {
+            OS_DEBUG("sched_setattr(): %s\n", strerror(errno));
+            return OS_ERROR;
+        }
+
+        rec->active = 0;
+        return OS_SUCCESS;
+    }
+
+    pthread_once(&OS_Posix_DeadlineHandlerOnce, OS_Posix_DeadlineInstallHandler);
+
+    rec->runtime_ns = (uint64)runtime_usec * 1000;
+    rec->deadline_ns = (uint64)deadline_usec * 1000;
+    rec->period_ns = (uint64)period_usec * 1000;
+    rec->rejected = false;
+
+    tid = __atomic_load_n(&rec->kernel_tid, __ATOMIC_SEQ_CST);
+    if (tid == 0)
+    {
+        /*
+         * The task has not started yet.  Leave the reservation for the
+         * task to apply as it starts, unless it started in the meantime
+         * and this claims the reservation back first.
+         */
+        __atomic_store_n(&rec->pending, 1, __ATOMIC_SEQ_CST);
+        tid = __atomic_load_n(&rec->kernel_tid, __ATOMIC_SEQ_CST);
+        if (tid == 0 || !__atomic_exchange_n(&rec->pending, 0, __ATOMIC_SEQ_CST))
+        {
+            return OS_SUCCESS;
+        }
+    }
+
+    return OS_Posix_DeadlineApply(rec, tid);
+#else
+    if (runtime_usec == 0)
+    {
+        return OS_SUCCESS;
+    }
+
+    /* SCHED_DEADLINE is not supported in this implementation */
+    return OS_ERR_NOT_IMPLEMENTED;
+#endif
+} /* end OS_Posix_TaskDeadlineSet */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_TaskDeadlineAttach
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Called with a kernel_tid of 0 when a task is created, to
+ *           reset its deadline state, and by the task itself with its
+ *           kernel thread ID as it starts, to apply any reservation
+ *           requested before it was running.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_TaskDeadlineAttach(uint32 local_id, pid_t kernel_tid)
+{
+    OS_Posix_DeadlineRecord_t *rec;
+
+    rec = &OS_Posix_DeadlineTable[local_id];
+
+    if (kernel_tid == 0)
+    {
+        memset(rec, 0, sizeof(*rec));
+        return;
+    }
+
+    __atomic_store_n(&rec->kernel_tid, kernel_tid, __ATOMIC_SEQ_CST);
+
+#ifdef OS_POSIX_SCHED_DEADLINE
+    if (__atomic_exchange_n(&rec->pending, 0, __ATOMIC_SEQ_CST))
+    {
+        if (OS_Posix_DeadlineApply(rec, kernel_tid) != OS_SUCCESS)
+        {
+            rec->rejected = true;
+        }
+    }
+
+    /* the mask is inherited from the creating thread, so always set it here */
+    OS_Posix_DeadlineSetSignalMask(rec);
+#endif
+} /* end OS_Posix_TaskDeadlineAttach */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_TaskDeadlineDetach
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Called when a task is deleted or exits, to stop tracking its
+ *           thread.  A kernel_tid of 0 detaches unconditionally, as done
+ *           on delete with the task table locked.  An exiting task passes
+ *           its own thread ID, and is only detached if the record is still
+ *           its own, as the table entry has already been released and may
+ *           have been given to a new task.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_TaskDeadlineDetach(uint32 local_id, pid_t kernel_tid)
+{
+    OS_Posix_DeadlineRecord_t *rec;
+
+    rec = &OS_Posix_DeadlineTable[local_id];
+
+    if (kernel_tid != 0 &&
+            !__atomic_compare_exchange_n(&rec->kernel_tid, &kernel_tid, 0, false,
+                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+    {
+        return;
+    }
+
+    rec->active = 0;
+    __atomic_store_n(&rec->pending, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&rec->kernel_tid, 0, __ATOMIC_SEQ_CST);
+} /* end OS_Posix_TaskDeadlineDetach */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_TaskDeadlineSync
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Called by a task as it sleeps, to bring its SIGXCPU mask in
+ *           line with a reservation set or cleared by another task while
+ *           it was running.  The thread ID is only checked when the mask
+ *           needs changing, so this is cheap in the usual case.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_TaskDeadlineSync(uint32 local_id)
+{
+#ifdef OS_POSIX_SCHED_DEADLINE
+    OS_Posix_DeadlineRecord_t *rec;
+
+    rec = &OS_Posix_DeadlineTable[local_id];
+
+    if ((rec->active != 0) != rec->sigxcpu_unblocked &&
+            __atomic_load_n(&rec->kernel_tid, __ATOMIC_SEQ_CST) == syscall(SYS_gettid))
+    {
+        OS_Posix_DeadlineSetSignalMask(rec);
+    }
+#endif
+} /* end OS_Posix_TaskDeadlineSync */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_TaskDeadlineGetInfo
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Fill in the budget overrun count of a task, and clear the
+ *           reservation reported by the shared layer if it was refused
+ *           when the task started.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_TaskDeadlineGetInfo(uint32 local_id, OS_task_prop_t *task_prop)
+{
+    OS_Posix_DeadlineRecord_t *rec;
+
+    rec = &OS_Posix_DeadlineTable[local_id];
+
+    if (rec->rejected)
+    {
+        task_prop->deadline_runtime_usec = 0;
+        task_prop->deadline_usec = 0;
+        task_prop->deadline_period_usec = 0;
+    }
+
+    task_prop->budget_overruns = __atomic_load_n(&rec->overruns, __ATOMIC_RELAXED);
+} /* end OS_Posix_TaskDeadlineGetInfo */
@@ -0,0 +1,381 @@
+/*
+ *      Copyright (c) 2018, United States government as represented by the
+ *      administrator of the National Aeronautics Space Administration.
+ *      All rights reserved. This software was created at NASA Glenn
+ *      Research Center pursuant to government contracts.
+ *
+ *      This is governed by the NASA Open Source Agreement and may be used,
+ *      distributed and modified only according to the terms of that agreement.
+ */
+
+/**
+ * \file   osfiber.c
+ *
+ * Purpose: This file contains the fiber stacks and context switching for
+ *          POSIX, using the ucontext functions.  Each fiber keeps the
+ *          context of the task that switched it in, so that it can switch
+ *          back to that task.
+ *
+ *          A task that hosts fibers is notified through a pipe, which it
+ *          selects on together with the streams its fibers wait on.  The
+ *          pipe is created the first time a task in the slot creates a
+ *          fiber, and kept for the next tasks in the same slot.
+ *
+ */
+
+/****************************************************************************************
+                                    INCLUDE FILES
+ ***************************************************************************************/
+
+#include "os-posix.h"
+#include <ucontext.h>
+
+/****************************************************************************************
+                                     DEFINES
+ ***************************************************************************************/
+
+#ifndef PTHREAD_STACK_MIN
+#define PTHREAD_STACK_MIN 8092
+#endif
+
+/****************************************************************************************
+                                   LOCAL TYPEDEFS
+ ***************************************************************************************/
+
+typedef struct
+{
+   ucontext_t context;
+   ucontext_t host_context;
+   void       *stack;
+} OS_impl_fiber_internal_record_t;
+
+typedef struct
+{
+   int        notify_fd[2];  /* pipe, read end first */
+   bool       notify_open;
+   bool       notify_enabled;
+   bool       notified;      /* a byte is in the pipe, or about to be */
+} OS_impl_fiber_task_record_t;
+
+/****************************************************************************************
+                                   GLOBAL DATA
+ ***************************************************************************************/
+
+static OS_impl_fiber_internal_record_t OS_impl_fiber_table[OS_MAX_FIBERS];
+
+static OS_impl_fiber_task_record_t OS_impl_fiber_task_table[OS_MAX_TASKS];
+
+/* Number of tasks with notification enabled */
+static uint32 OS_impl_fiber_notify_count;
+
+/****************************************************************************************
+                                     FIBER API
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_FiberStart
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           First function run on the stack of a fiber
+ *
+ *-----------------------------------------------------------------*/
+static void OS_Posix_FiberStart(int fiber_id)
+{
+   OS_FiberEntryPoint((uint32)fiber_id);
+} /* end OS_Posix_FiberStart */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberCreate_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberCreate_Impl (uint32 fiber_id, uint32 flags)
+{
+   OS_impl_fiber_internal_record_t *impl;
+   size_t stacksz;
+
+   impl = &OS_impl_fiber_table[fiber_id];
+
+   stacksz = OS_fiber_table[fiber_id].stack_size;
+   if (stacksz < PTHREAD_STACK_MIN)
+   {
+      stacksz = PTHREAD_STACK_MIN;
+   }
+
+   impl->stack = malloc(stacksz);
+   if (impl->stack == NULL)
+   {
+      OS_DEBUG("malloc failed for fiber stack of %lu bytes\n", (unsigned long)stacksz);
+      return OS_ERROR;
+   }
+
+   if (getcontext(&impl->context) != 0)
+   {
+      OS_DEBUG("getcontext: %s\n", strerror(errno));
+      free(impl->stack);
+      impl->stack = NULL;
+      return OS_ERROR;
+   }
+
+   impl->context.uc_stack.ss_sp = impl->stack;
+   impl->context.uc_stack.ss_size = stacksz;
+   impl->context.uc_link = NULL;
+   makecontext(&impl->context, (void (*)(void))OS_Posix_FiberStart, 1, (int)fiber_id);
+
+   return OS_SUCCESS;
+} /* end OS_FiberCreate_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberDelete_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberDelete_Impl (uint32 fiber_id)
+{
+   free(OS_impl_fiber_table[fiber_id].stack);
+   OS_impl_fiber_table[fiber_id].stack = NULL;
+
+   return OS_SUCCESS;
+} /* end OS_FiberDelete_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberSwitchIn_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberSwitchIn_Impl (uint32 fiber_id)
+{
+   OS_impl_fiber_internal_record_t *impl;
+
+   impl = &OS_impl_fiber_table[fiber_id];
+   if (swapcontext(&impl->host_context, &impl->context) != 0)
+   {
+      return OS_ERROR;
+   }
+
+   return OS_SUCCESS;
+} /* end OS_FiberSwitchIn_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberSwitchOut_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberSwitchOut_Impl (uint32 fiber_id)
+{
+   OS_impl_fiber_internal_record_t *impl;
+
+   impl = &OS_impl_fiber_table[fiber_id];
+   if (swapcontext(&impl->context, &impl->host_context) != 0)
+   {
+      return OS_ERROR;
+   }
+
+   return OS_SUCCESS;
+} /* end OS_FiberSwitchOut_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberTaskInit_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberTaskInit_Impl (uint32 task_id)
+{
+   OS_impl_fiber_task_record_t *impl;
+
+   impl = &OS_impl_fiber_task_table[task_id];
+   if (impl->notify_open)
+   {
+      return OS_SUCCESS;
+   }
+
+   if (pipe(impl->notify_fd) != 0)
+   {
+      OS_DEBUG("pipe: %s\n", strerror(errno));
+      return OS_ERROR;
+   }
+
+   fcntl(impl->notify_fd[0], F_SETFL, fcntl(impl->notify_fd[0], F_GETFL) | O_NONBLOCK);
+   fcntl(impl->notify_fd[1], F_SETFL, fcntl(impl->notify_fd[1], F_GETFL) | O_NONBLOCK);
+   impl->notify_open = true;
+
+   return OS_SUCCESS;
+} /* end OS_FiberTaskInit_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberNotifyEnable_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_FiberNotifyEnable_Impl (uint32 task_id, bool enable)
+{
+   OS_impl_fiber_task_record_t *impl;
+
+   impl = &OS_impl_fiber_task_table[task_id];
+   if (impl->notify_enabled == enable)
+   {
+      return;
+   }
+
+   /*
+    * Ordered against the check of the count in OS_FiberNotify_Impl(),
+    * as the fibers retry their polls after notification is enabled.
+    */
+   __atomic_store_n(&impl->notify_enabled, enable, __ATOMIC_SEQ_CST);
+   if (enable)
+   {
+      __atomic_add_fetch(&OS_impl_fiber_notify_count, 1, __ATOMIC_SEQ_CST);
+   }
+   else
+   {
+      __atomic_sub_fetch(&OS_impl_fiber_notify_count, 1, __ATOMIC_SEQ_CST);
+   }
+} /* end OS_FiberNotifyEnable_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberNotify_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_FiberNotify_Impl (void)
+{
+   OS_impl_fiber_task_record_t *impl;
+   uint32 i;
+   char ch;
+
+   /* Ordered after the give or put that this notifies */
+   __atomic_thread_fence(__ATOMIC_SEQ_CST);
+   if (__atomic_load_n(&OS_impl_fiber_notify_count, __ATOMIC_SEQ_CST) == 0)
+   {
+      return;
+   }
+
+   ch = 0;
+   for (i = 0; i < OS_MAX_TASKS; ++i)
+   {
+      impl = &OS_impl_fiber_task_table[i];
+      if (__atomic_load_n(&impl->notify_enabled, __ATOMIC_SEQ_CST) &&
+            !__atomic_exchange_n(&impl->notified, true, __ATOMIC_SEQ_CST))
+      {
+         /* the pipe can only be full if the task has not read an earlier notification */
+         if (write(impl->notify_fd[1], &ch, 1) < 0)
+         {
+            /* nothing to do */
+         }
+      }
+   }
+
+#ifdef OS_POSIX_VIRTUAL_TIME
+   OS_Posix_VirtualTimeNotify();
+#endif
+} /* end OS_FiberNotify_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_FiberNotified
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Consume the notifications of a task.  This is done before
+ *           the task retries the polls of its fibers, so a notification
+ *           that arrives after this is seen by the next idle wait.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_Posix_FiberNotified(OS_impl_fiber_task_record_t *impl)
+{
+   char buf[16];
+
+   __atomic_store_n(&impl->notified, false, __ATOMIC_SEQ_CST);
+   while (read(impl->notify_fd[0], buf, sizeof(buf)) > 0)
+   {
+      /* drain */
+   }
+} /* end OS_Posix_FiberNotified */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberIdle_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberIdle_Impl (uint32 task_id, OS_FdSet *ReadSet, OS_FdSet *WriteSet, int64 timeout_usec)
+{
+   OS_impl_fiber_task_record_t *impl;
+   int32 return_code;
+   bool notified;
+#ifdef OS_POSIX_VIRTUAL_TIME
+   uint64 deadline;
+   uint32 event;
+   uint32 i;
+#endif
+
+   impl = &OS_impl_fiber_task_table[task_id];
+
+#ifdef OS_POSIX_VIRTUAL_TIME
+   /*
+    * Without streams to wait on, wait on the virtual clock so that it can
+    * advance to the next fiber timeout.  Notifications bump its event count.
+    */
+   for (i = 0; i < sizeof(ReadSet->object_ids); ++i)
+   {
+      if (ReadSet->object_ids[i] != 0 || WriteSet->object_ids[i] != 0)
+      {
+         break;
+      }
+   }
+   if (i == sizeof(ReadSet->object_ids))
+   {
+      deadline = 0;
+      if (timeout_usec >= 0)
+      {
+         deadline = OS_Posix_VirtualTimeNow() + ((uint64)timeout_usec * 1000);
+      }
+
+      do
+      {
+         event = OS_Posix_VirtualTimeEvent();
+         if (__atomic_load_n(&impl->notified, __ATOMIC_SEQ_CST))
+         {
+            OS_Posix_FiberNotified(impl);
+            return OS_SUCCESS;
+         }
+         return_code = OS_Posix_VirtualTimeWait(event, deadline);
+      }
+      while (return_code == OS_SUCCESS);
+
+      return return_code;
+   }
+#endif
+
+   return_code = OS_Posix_SelectMultipleFd(ReadSet, WriteSet,
+         impl->notify_open ? impl->notify_fd[0] : -1, &notified, timeout_usec);
+   if (notified)
+   {
+      OS_Posix_FiberNotified(impl);
+   }
+
+   return return_code;
+} /* end OS_FiberIdle_Impl */
@@ -0,0 +1,691 @@
+/*
+ *      Copyright (c) 2018, United States government as represented by the
+ *      administrator of the National Aeronautics Space Administration.
+ *      All rights reserved. This software was created at NASA Glenn
+ *      Research Center pursuant to government contracts.
+ *
+ *      This is governed by the NASA Open Source Agreement and may be used,
+ *      distributed and modified only according to the terms of that agreement.
+ */
+
+/**
+ * \file   osmemory.c
+ *
+ * Purpose: This file contains the memory handling needed for real-time
+ *          operation on POSIX: locking the process into RAM, prefaulting
+ *          task stacks, accounting for heap allocations made after
+ *          the application has finished initializing, and the pool of
+ *          reusable task stacks.
+ *
+ */
+
+/****************************************************************************************
+                                    INCLUDE FILES
+ ***************************************************************************************/
+
+/*
+ * pthread_getattr_np() and pthread_tryjoin_np() are GNU extensions, needed
+ * to locate the stack of the calling thread and to find out whether the
+ * thread on a pooled stack has terminated.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "os-posix.h"
+#include <sys/mman.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+/*
+ * Heap allocation accounting works by replacing the C library allocation
+ * functions with thin wrappers around the glibc allocator, so it is only
+ * available with glibc.  As this replaces the allocator for the whole
+ * process, it is only built when OSAL_POSIX_HEAP_CHECK is defined; see
+ * the pc-linux osconfig.h.
+ */
+#if defined(__GLIBC__) && defined(OSAL_POSIX_HEAP_CHECK)
+#define OS_POSIX_HEAP_CHECK
+#endif
+
+/*
+ * Stack space left untouched below the caller when prefaulting the
+ * stack of a new task.  This must cover the prefault routine itself
+ * and any signal frame that might be delivered while it runs.
+ */
+#define OS_POSIX_STACK_PREFAULT_MARGIN      16384
+
+/*
+ * The stack pool relies on pthread_tryjoin_np() to reclaim a stack
+ * without blocking, so it is also only available with glibc.
+ */
+#if defined(__GLIBC__) && (OS_STACK_POOL_SIZE > 0)
+#define OS_POSIX_STACK_POOL
+#endif
+
+#ifndef PTHREAD_STACK_MIN
+#define PTHREAD_STACK_MIN 8092
+#endif
+
+/*
+ * States of an entry in the stack pool
+ */
+enum
+{
+    OS_POSIX_STACK_EMPTY = 0,   /**< No stack allocated */
+    OS_POSIX_STACK_FREE,        /**< Stack available for reuse */
+    OS_POSIX_STACK_RESERVED,    /**< Stack being prepared for a new task */
+    OS_POSIX_STACK_IN_USE,      /**< Stack owned by a running task */
+    OS_POSIX_STACK_RELEASED     /**< Task ended, thread may still be running on it */
+};
+
+typedef struct
+{
+    uint8    *base;             /**< Start of the mapping, including the guard page */
+    size_t   size;              /**< Usable size, i.e. the size class */
+    uint32   state;
+    pthread_t owner;
+} OS_Posix_StackEntry_t;
+
+/****************************************************************************************
+                                   GLOBAL DATA
+ ***************************************************************************************/
+
+#ifdef OS_POSIX_HEAP_CHECK
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+extern void *__libc_valloc(size_t size);
+extern void *__libc_pvalloc(size_t size);
+
+/*
+ * Set by OS_HeapLockdown_Impl() to the OS_RT_COUNT_ALLOCATIONS and
+ * OS_RT_TRAP_ALLOCATIONS options in effect; zero until then, so the
+ * wrappers cost a single load during normal operation.
+ */
+static volatile uint32 OS_Posix_HeapCheckMode = 0;
+static uint32 OS_Posix_LateAllocCount = 0;
+
+#endif
+
+#ifdef OS_POSIX_STACK_POOL
+
+static OS_Posix_StackEntry_t OS_Posix_StackPool[OS_STACK_POOL_SIZE];
+static pthread_mutex_t OS_Posix_StackPoolMutex = PTHREAD_MUTEX_INITIALIZER;
+static uint32 OS_Posix_StackPoolHits = 0;
+static uint32 OS_Posix_StackPoolMisses = 0;
+static uint32 OS_Posix_StackPoolBypassed = 0;
+
+#endif
+
+/****************************************************************************************
+                              HEAP ALLOCATION ACCOUNTING
+ ***************************************************************************************/
+
+#ifdef OS_POSIX_HEAP_CHECK
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_Posix_HeapCheck
+
+   Purpose: Account for a heap allocation made after lockdown
+
+   returns: None
+
+    NOTES: Called from the allocation wrappers below, so it must not allocate.
+           In trap mode the process is aborted at the offending call, where a
+           debugger or core dump shows the allocation site.
+---------------------------------------------------------------------------------------*/
+static inline void OS_Posix_HeapCheck(void)
+{
+    uint32 mode = OS_Posix_HeapCheckMode;
+
+    if (mode != 0)
+    {
+        if ((mode & OS_RT_TRAP_ALLOCATIONS) != 0)
+        {
+            abort();
+        }
+        __atomic_fetch_add(&OS_Posix_LateAllocCount, 1, __ATOMIC_RELAXED);
+    }
+}
+
+void *malloc(size_t size)
+{
+    OS_Posix_HeapCheck();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+    OS_Posix_HeapCheck();
+    return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    OS_Posix_HeapCheck();
+    return __libc_realloc(ptr, size);
+}
+
+void *reallocarray(void *ptr, size_t nmemb, size_t size)
+{
+    size_t total;
+
+    OS_Posix_HeapCheck();
+    if (__builtin_mul_overflow(nmemb, size, &total))
+    {
+        errno = ENOMEM;
+        return NULL;
+    }
+    return __libc_realloc(ptr, total);
+}
+
+/*
+ * The aligned allocators are all served by __libc_memalign(), which
+ * accepts any alignment, so the stricter checks of the standard
+ * interfaces are made here.
+ */
+void *memalign(size_t alignment, size_t size)
+{
+    OS_Posix_HeapCheck();
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+    OS_Posix_HeapCheck();
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        errno = EINVAL;
+        return NULL;
+    }
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **memptr, size_t alignment, size_t size)
+{
+    void *mem;
+
+    OS_Posix_HeapCheck();
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 || (alignment % sizeof(void *)) != 0)
+    {
+        return EINVAL;
+    }
+
+    mem = __libc_memalign(alignment, size);
+    if (mem == NULL)
+    {
+        return ENOMEM;
+    }
+
+    *memptr = mem;
+    return 0;
+}
+
+void *valloc(size_t size)
+{
+    OS_Posix_HeapCheck();
+    return __libc_valloc(size);
+}
+
+void *pvalloc(size_t size)
+{
+    OS_Posix_HeapCheck();
+    return __libc_pvalloc(size);
+}
+
+#endif
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_HeapLockdown_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_HeapLockdown_Impl(uint32 options)
+{
+#ifdef OS_POSIX_HEAP_CHECK
+    __atomic_store_n(&OS_Posix_LateAllocCount, 0, __ATOMIC_RELAXED);
+    OS_Posix_HeapCheckMode = options & (OS_RT_COUNT_ALLOCATIONS | OS_RT_TRAP_ALLOCATIONS);
+    return OS_SUCCESS;
+#else
+    return OS_ERR_NOT_IMPLEMENTED;
+#endif
+} /* end OS_HeapLockdown_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_HeapGetLateAllocs_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_HeapGetLateAllocs_Impl(uint32 *count)
+{
+#ifdef OS_POSIX_HEAP_CHECK
+    *count = __atomic_load_n(&OS_Posix_LateAllocCount, __ATOMIC_RELAXED);
+    return OS_SUCCESS;
+#else
+    return OS_ERR_NOT_IMPLEMENTED;
+#endif
+} /* end OS_HeapGetLateAllocs_Impl */
+
+/****************************************************************************************
+                                    MEMORY LOCKING
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_API_LockMemory_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_API_LockMemory_Impl(void)
+{
+    /*
+     * Locking the current mappings faults in every page already mapped,
+     * including the OSAL object tables, and MCL_FUTURE does the same for
+     * every later mapping such as the stacks of new tasks.
+     */
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0)
+    {
+        OS_DEBUG("mlockall() failed: %s\n", strerror(errno));
+        return OS_ERROR;
+    }
+
+#ifdef __GLIBC__
+    /*
+     * Keep freed heap memory in the (locked) arena rather than returning
+     * it to the system, and serve large requests from the arena too, so
+     * that a later allocation does not have to map and fault in new pages.
+     */
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+
+    return OS_SUCCESS;
+} /* end OS_API_LockMemory_Impl */
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_Posix_TouchStack
+
+   Purpose: Write to each page of a stack region of the given depth
+
+   returns: None
+
+    NOTES: The region is a local array, so the pages touched are below the
+           caller's frame and are properly allocated while being written.
+---------------------------------------------------------------------------------------*/
+static void __attribute__((noinline)) OS_Posix_TouchStack(size_t depth, size_t page_size)
+{
+    uint8 region[depth];
+    volatile uint8 *page;
+    size_t offset;
+
+    for (offset = 0; offset < depth; offset += page_size)
+    {
+        page = &region[offset];
+        *page = 0;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_PrefaultStack
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Fault in the unused part of the calling thread's stack so
+ *           that the task does not take page faults on its first deep
+ *           call chain.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_PrefaultStack(void)
+{
+    pthread_attr_t attr;
+    void *stack_addr;
+    size_t stack_size;
+    size_t depth;
+    long page_size;
+    uint8 here;
+
+    page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0 || pthread_getattr_np(pthread_self(), &attr) != 0)
+    {
+        return;
+    }
+
+    if (pthread_attr_getstack(&attr, &stack_addr, &stack_size) == 0)
+    {
+        /* The stack grows down, from the top of the region towards stack_addr */
+        depth = (cpuaddr)&here - (cpuaddr)stack_addr;
+        if (depth > OS_POSIX_STACK_PREFAULT_MARGIN)
+        {
+            OS_Posix_TouchStack(depth - OS_POSIX_STACK_PREFAULT_MARGIN, page_size);
+        }
+    }
+
+    pthread_attr_destroy(&attr);
+} /* end OS_Posix_PrefaultStack */
+
+/****************************************************************************************
+                                    TASK STACK POOL
+ ***************************************************************************************/
+
+#ifdef OS_POSIX_STACK_POOL
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_Posix_StackPoolReap
+
+   Purpose: Return the stacks of terminated threads to the free state
+
+   returns: None
+
+    NOTES: Must be called with the pool mutex held.  A released stack
+           cannot be reused until its thread has fully terminated, as the
+           thread (and the C library's record of it) still lives on the
+           stack while it finishes exiting.
+---------------------------------------------------------------------------------------*/
+static void OS_Posix_StackPoolReap(void)
+{
+    uint32 i;
+    int ret;
+
+    for (i = 0; i < OS_STACK_POOL_SIZE; ++i)
+    {
+        if (OS_Posix_StackPool[i].state == OS_POSIX_STACK_RELEASED)
+        {
+            ret = pthread_tryjoin_np(OS_Posix_StackPool[i].owner, NULL);
+            if (ret == 0 || ret == ESRCH)
+            {
+                OS_Posix_StackPool[i].state = OS_POSIX_STACK_FREE;
+            }
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_Posix_StackPoolGet
+
+   Purpose: Find or allocate a pool stack of the given size class
+
+   returns: Pool index of the stack, or OS_STACK_POOL_SIZE if none
+
+    NOTES: Must be called with the pool mutex held.  A free stack of
+           another size class is unmapped to make room if needed.
+---------------------------------------------------------------------------------------*/
+static uint32 OS_Posix_StackPoolGet(size_t class_size)
+{
+    uint32 i;
+    uint32 empty;
+    uint32 spare;
+    long page_size;
+    void *base;
+
+    empty = OS_STACK_POOL_SIZE;
+    spare = OS_STACK_POOL_SIZE;
+    for (i = 0; i < OS_STACK_POOL_SIZE; ++i)
+    {
+        if (OS_Posix_StackPool[i].state == OS_POSIX_STACK_FREE)
+        {
+            if (OS_Posix_StackPool[i].size == class_size)
+            {
+                ++OS_Posix_StackPoolHits;
+                return i;
+            }
+            spare = i;
+        }
+        else if (OS_Posix_StackPool[i].state == OS_POSIX_STACK_EMPTY)
+        {
+            empty = i;
+        }
+    }
+
+    page_size = sysconf(_SC_PAGESIZE);
+    if (empty == OS_STACK_POOL_SIZE && spare != OS_STACK_POOL_SIZE)
+    {
+        munmap(OS_Posix_StackPool[spare].base, OS_Posix_StackPool[spare].size + page_size);
+        OS_Posix_StackPool[spare].state = OS_POSIX_STACK_EMPTY;
+        empty = spare;
+    }
+
+    if (empty == OS_STACK_POOL_SIZE || page_size <= 0)
+    {
+        return OS_STACK_POOL_SIZE;
+    }
+
+    /* The lowest page is left inaccessible as a guard against overflow */
+    base = mmap(NULL, class_size + page_size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (base == MAP_FAILED)
+    {
+        OS_DEBUG("mmap() of task stack failed: %s\n", strerror(errno));
+        return OS_STACK_POOL_SIZE;
+    }
+    mprotect(base, page_size, PROT_NONE);
+
+    OS_Posix_StackPool[empty].base = base;
+    OS_Posix_StackPool[empty].size = class_size;
+    ++OS_Posix_StackPoolMisses;
+
+    return empty;
+}
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_Posix_StackClear
+
+   Purpose: Zero the part of a recycled stack that its last user touched
+
+   returns: None
+
+    NOTES: Stacks grow down and start out zeroed, so everything below the
+           lowest nonzero word is still clear.  Only the region above it
+           needs to be written, which is usually a small part of the stack.
+---------------------------------------------------------------------------------------*/
+static void OS_Posix_StackClear(uint8 *stack, size_t size)
+{
+    const unsigned long *word;
+    const unsigned long *end;
+
+    word = (const unsigned long *)stack;
+    end = (const unsigned long *)(stack + size);
+    while (word < end && *word == 0)
+    {
+        ++word;
+    }
+
+    memset((void *)word, 0, (const uint8 *)end - (const uint8 *)word);
+}
+
+#endif
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_StackPoolThreadCreate
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Create a thread on a stack from the pool, if one can be had.
+ *           The thread is left joinable so the stack can be reclaimed
+ *           once it terminates; see OS_Posix_StackPoolRelease().
+ *
+ *  Returns: OS_SUCCESS if the thread was created on a pool stack,
+ *           OS_ERR_NOT_IMPLEMENTED if the pool cannot serve the request
+ *           and the thread should be created normally,
+ *           OS_ERROR if the thread could not be created.
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_Posix_StackPoolThreadCreate(pthread_t *pthr, pthread_attr_t *attr, size_t stacksz,
+        PthreadFuncPtr_t entry, void *entry_arg)
+{
+#ifdef OS_POSIX_STACK_POOL
+    OS_Posix_StackEntry_t *stack;
+    size_t class_size;
+    uint32 index;
+    long page_size;
+    int ret;
+
+    class_size = PTHREAD_STACK_MIN;
+    while (class_size < stacksz)
+    {
+        class_size <<= 1;
+    }
+
+    page_size = sysconf(_SC_PAGESIZE);
+
+    pthread_mutex_lock(&OS_Posix_StackPoolMutex);
+
+    OS_Posix_StackPoolReap();
+    if (class_size > OS_STACK_POOL_MAX_STACK)
+    {
+        index = OS_STACK_POOL_SIZE;
+    }
+    else
+    {
+        index = OS_Posix_StackPoolGet(class_size);
+    }
+
+    if (index == OS_STACK_POOL_SIZE)
+    {
+        ++OS_Posix_StackPoolBypassed;
+        pthread_mutex_unlock(&OS_Posix_StackPoolMutex);
+        return OS_ERR_NOT_IMPLEMENTED;
+    }
+
+    /*
+     * A recycled stack may take a while to clear, so it is reserved and
+     * cleared without holding the mutex.  A new stack is already clear.
+     */
+    stack = &OS_Posix_StackPool[index];
+    if (stack->state == OS_POSIX_STACK_FREE)
+    {
+        stack->state = OS_POSIX_STACK_RESERVED;
+        pthread_mutex_unlock(&OS_Posix_StackPoolMutex);
+
+        OS_Posix_StackClear(stack->base + page_size, stack->size);
+
+        pthread_mutex_lock(&OS_Posix_StackPoolMutex);
+    }
+
+    /*
+     * The mutex is held until the new thread has been recorded as the
+     * owner, so that it cannot release the stack before that happens.
+     */
+    ret = pthread_attr_setstack(attr, stack->base + page_size, stack->size);
+    if (ret == 0)
+    {
+        ret = pthread_create(pthr, attr, entry, entry_arg);
+    }
+
+    if (ret == 0)
+    {
+        stack->owner = *pthr;
+        stack->state = OS_POSIX_STACK_IN_USE;
+    }
+    else
+    {
+        OS_DEBUG("pthread_create error on pooled stack: %s\n", strerror(ret));
+        stack->state = OS_POSIX_STACK_FREE;
+    }
+
+    pthread_mutex_unlock(&OS_Posix_StackPoolMutex);
+
+    if (ret != 0)
+    {
+        return OS_ERROR;
+    }
+
+    return OS_SUCCESS;
+#else
+    return OS_ERR_NOT_IMPLEMENTED;
+#endif
+} /* end OS_Posix_StackPoolThreadCreate */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_StackPoolRelease
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Mark the stack of a task that is ending as reclaimable.  It
+ *           is reused by a later task once the thread has terminated.
+ *           Does nothing for a thread not running on a pool stack.
+ *
+ *           The stacks of earlier tasks whose threads have terminated
+ *           by now are reclaimed at the same time, so that their threads
+ *           do not linger as unjoined until the next task is created.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_StackPoolRelease(pthread_t thr)
+{
+#ifdef OS_POSIX_STACK_POOL
+    uint32 i;
+
+    pthread_mutex_lock(&OS_Posix_StackPoolMutex);
+
+    OS_Posix_StackPoolReap();
+
+    for (i = 0; i < OS_STACK_POOL_SIZE; ++i)
+    {
+        if (OS_Posix_StackPool[i].state == OS_POSIX_STACK_IN_USE &&
+                pthread_equal(OS_Posix_StackPool[i].owner, thr))
+        {
+            OS_Posix_StackPool[i].state = OS_POSIX_STACK_RELEASED;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&OS_Posix_StackPoolMutex);
+#endif
+} /* end OS_Posix_StackPoolRelease */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskGetStackPoolStats_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskGetStackPoolStats_Impl(OS_stack_pool_stats_t *stats)
+{
+#ifdef OS_POSIX_STACK_POOL
+    uint32 i;
+
+    pthread_mutex_lock(&OS_Posix_StackPoolMutex);
+
+    OS_Posix_StackPoolReap();
+
+    stats->hits = OS_Posix_StackPoolHits;
+    stats->misses = OS_Posix_StackPoolMisses;
+    stats->bypassed = OS_Posix_StackPoolBypassed;
+    for (i = 0; i < OS_STACK_POOL_SIZE; ++i)
+    {
+        if (OS_Posix_StackPool[i].state == OS_POSIX_STACK_FREE)
+        {
+            ++stats->stacks_free;
+        }
+        else if (OS_Posix_StackPool[i].state != OS_POSIX_STACK_EMPTY)
+        {
+            ++stats->stacks_in_use;
+        }
+
+        if (OS_Posix_StackPool[i].state != OS_POSIX_STACK_EMPTY)
+        {
+            stats->pool_bytes += OS_Posix_StackPool[i].size;
+        }
+    }
+
+    pthread_mutex_unlock(&OS_Posix_StackPoolMutex);
+
+    return OS_SUCCESS;
+#else
+    return OS_ERR_NOT_IMPLEMENTED;
+#endif
+} /* end OS_TaskGetStackPoolStats_Impl */
+
@@ -34,3 +34,95 @@
 /* Leverage the portable UNIX-style Select API for POSIX */
 #include "../portable/os-impl-bsd-select.c"
 
+
+/****************************************************************************************
+                                POSIX SELECT HELPERS
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_SelectMultipleFd
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           As OS_SelectMultiple_Impl(), but also waits for extra_fd,
+ *           which is not an OSAL stream, to be readable, and takes the
+ *           timeout in microseconds, negative to wait forever.
+ *           *extra_ready is set if extra_fd is readable.
+ *
+ *  returns: OS_SUCCESS if a stream or extra_fd is ready,
+ *           OS_ERROR_TIMEOUT if the timeout expired, or OS_ERROR
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_Posix_SelectMultipleFd(OS_FdSet *ReadSet, OS_FdSet *WriteSet, int extra_fd, bool *extra_ready, int64 timeout_usec)
+{
+   fd_set wr_set;
+   fd_set rd_set;
+   fd_set rd_in;
+   fd_set wr_in;
+   struct timeval tv;
+   struct timeval *tvptr;
+   struct timespec ts_now;
+   int64 end_usec;
+   int64 remaining;
+   int osfd;
+   int maxfd;
+   int os_status;
+
+   FD_ZERO(&rd_in);
+   FD_ZERO(&wr_in);
+   maxfd = OS_FdSet_ConvertIn_Impl(&rd_in, ReadSet);
+   osfd = OS_FdSet_ConvertIn_Impl(&wr_in, WriteSet);
+   if (osfd > maxfd)
+   {
+      maxfd = osfd;
+   }
+   if (extra_fd >= 0)
+   {
+      FD_SET(extra_fd, &rd_in);
+      if (extra_fd > maxfd)
+      {
+         maxfd = extra_fd;
+      }
+   }
+
+   clock_gettime(CLOCK_MONOTONIC, &ts_now);
+   end_usec = ((int64)ts_now.tv_sec * 1000000) + (ts_now.tv_nsec / 1000) + timeout_usec;
+
+   tvptr = NULL;
+   do
+   {
+      if (timeout_usec >= 0)
+      {
+         clock_gettime(CLOCK_MONOTONIC, &ts_now);
+         remaining = end_usec - (((int64)ts_now.tv_sec * 1000000) + (ts_now.tv_nsec / 1000));
+         if (remaining < 0)
+         {
+            remaining = 0;
+         }
+         tv.tv_sec = remaining / 1000000;
+         tv.tv_usec = remaining % 1000000;
+         tvptr = &tv;
+      }
+
+      rd_set = rd_in;
+      wr_set = wr_in;
+      os_status = select(maxfd + 1, &rd_set, &wr_set, NULL, tvptr);
+   }
+   while (os_status < 0 && errno == EINTR);
+
+   *extra_ready = false;
+   if (os_status < 0)
+   {
+      return OS_ERROR;
+   }
+   if (os_status == 0)
+   {
+      return OS_ERROR_TIMEOUT;
+   }
+
+   OS_FdSet_ConvertOut_Impl(&rd_set, ReadSet);
+   OS_FdSet_ConvertOut_Impl(&wr_set, WriteSet);
+   *extra_ready = (extra_fd >= 0 && FD_ISSET(extra_fd, &rd_set));
+
+   return OS_SUCCESS;
+} /* end OS_Posix_SelectMultipleFd */
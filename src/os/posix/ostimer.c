@@ -17,6 +17,12 @@
  *          This implementation depends on the POSIX Timer API which may not be available
  *          in older versions of the Linux kernel. It was developed and tested on
  *          RHEL 5 ./ CentOS 5 with Linux kernel 2.6.18
+ *
+ *          On Linux the simulated time base tick is taken from a timerfd instead,
+ *          which the time base thread reads directly.
+ *
+ *          Alternatively all simulated time bases can be served by one timer service
+ *          thread, which sleeps until the earliest expiry of any of them.
  */
 
 /****************************************************************************************
@@ -25,6 +31,30 @@
 
 #include "os-posix.h"
 
+/*
+ * Define OSAL_POSIX_TIMER_SERVICE to serve all simulated time bases from a
+ * single thread instead of a thread per time base.  The service thread keeps
+ * the time bases in a heap ordered by their next expiry, so time bases that
+ * expire together are served in order and with a single wakeup.
+ *
+ * Otherwise each time base has its own thread.  A timerfd needs no signal, so
+ * the number of simulated time bases is not limited by the number of RT
+ * signals, and the expiration count it returns gives the exact number of
+ * ticks that elapsed.  Define OSAL_POSIX_NO_TIMERFD to use a POSIX timer with
+ * an RT signal per time base instead.
+ *
+ * In virtual time mode the time bases always use the service thread, which
+ * waits for the next expiry on the virtual clock.
+ */
+#if defined(OSAL_POSIX_TIMER_SERVICE) || defined(OS_POSIX_VIRTUAL_TIME)
+#define OS_POSIX_TIMER_SERVICE
+#elif defined(__linux__) && !defined(OSAL_POSIX_NO_TIMERFD)
+#define OS_POSIX_TIMERFD
+#include <sys/timerfd.h>
+#else
+#define OS_POSIX_TIMER_SIGNAL
+#endif
+
 /****************************************************************************************
                                 EXTERNAL FUNCTION PROTOTYPES
  ***************************************************************************************/
@@ -33,7 +63,7 @@
                                 INTERNAL FUNCTION PROTOTYPES
  ***************************************************************************************/
 
-static void  OS_UsecToTimespec(uint32 usecs, struct timespec *time_spec);
+static void  OS_NsecToTimespec(uint64 nsecs, struct timespec *time_spec);
 
 /****************************************************************************************
                                      DEFINES
@@ -59,20 +89,52 @@ typedef struct
 {
     pthread_t           handler_thread;
     pthread_mutex_t     handler_mutex;
+#if defined(OS_POSIX_TIMER_SERVICE)
+    uint32              heap_pos;           /* position in the service heap + 1, 0 if not armed */
+    uint64              next_expiry;        /* nanoseconds on OS_PREFERRED_CLOCK */
+    uint64              interval_nsec;
+#elif defined(OS_POSIX_TIMERFD)
+    int                 timer_fd;
+#else
     timer_t             host_timerid;
     int                 assigned_signal;
     sigset_t            sigset;
+#endif
+    uint64              start_time;         /* in ns */
+    uint64              interval_time;      /* in ns */
     uint32              reset_flag;
+    uint32              overrun_count;
+    uint64              pending_time;       /* reported by the wait but not yet processed, in ns */
+    bool                tickless;
+    uint64              last_tick;          /* time of the last tick boundary reported, in ns */
+    uint64              next_tick;          /* time the tickless tick is programmed for, 0 if none */
     struct timespec     softsleep;
 
 } OS_impl_timebase_internal_record_t;
 
+#ifdef OS_POSIX_TIMER_SERVICE
+typedef struct
+{
+    pthread_t           thread;
+    pthread_mutex_t     mutex;
+    pthread_cond_t      cond;
+    bool                started;
+    uint32              heap_count;
+    uint32              heap[OS_MAX_TIMEBASES];
+
+} OS_impl_timer_service_t;
+#endif
+
 /****************************************************************************************
                                    GLOBAL DATA
  ***************************************************************************************/
 
 OS_impl_timebase_internal_record_t OS_impl_timebase_table[OS_MAX_TIMEBASES];
 
+#ifdef OS_POSIX_TIMER_SERVICE
+static OS_impl_timer_service_t OS_impl_timer_service;
+#endif
+
 /****************************************************************************************
                                 INTERNAL FUNCTIONS
  ***************************************************************************************/
@@ -80,26 +142,17 @@ OS_impl_timebase_internal_record_t OS_impl_timebase_table[OS_MAX_TIMEBASES];
 
 /*----------------------------------------------------------------
  *
- * Function: OS_UsecToTimespec
+ * Function: OS_NsecToTimespec
  *
  *  Purpose: Local helper routine, not part of OSAL API.
- *           Convert Microseconds to a POSIX timespec structure.
+ *           Convert Nanoseconds to a POSIX timespec structure.
  *
  *-----------------------------------------------------------------*/
-static void OS_UsecToTimespec(uint32 usecs, struct timespec *time_spec)
+static void OS_NsecToTimespec(uint64 nsecs, struct timespec *time_spec)
 {
-
-   if ( usecs < 1000000 )
-   {
-      time_spec->tv_nsec = (usecs * 1000);
-      time_spec->tv_sec = 0;
-   }
-   else
-   {
-      time_spec->tv_sec = usecs / 1000000;
-      time_spec->tv_nsec = (usecs % 1000000) * 1000;
-   }
-} /* end OS_UsecToTimespec */
+   time_spec->tv_sec = nsecs / 1000000000;
+   time_spec->tv_nsec = nsecs % 1000000000;
+} /* end OS_NsecToTimespec */
                         
 /*----------------------------------------------------------------
  *
@@ -116,65 +169,667 @@ void OS_TimeBaseLock_Impl(uint32 local_id)
                         
 /*----------------------------------------------------------------
  *
- * Function: OS_TimeBaseUnlock_Impl
+ * Function: OS_TimeBaseUnlock_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_TimeBaseUnlock_Impl(uint32 local_id)
+{
+    pthread_mutex_unlock(&OS_impl_timebase_table[local_id].handler_mutex);
+} /* end OS_TimeBaseUnlock_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBase_Now
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Read the timer clock in nanoseconds.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_TimeBase_Now(void)
+{
+#ifdef OS_POSIX_VIRTUAL_TIME
+    return OS_Posix_VirtualTimeNow();
+#else
+    struct timespec now;
+
+    clock_gettime(OS_PREFERRED_CLOCK, &now);
+    return ((uint64)now.tv_sec * 1000000000) + (uint64)now.tv_nsec;
+#endif
+} /* end OS_TimeBase_Now */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBase_IsTickless
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Check if a simulated time base is running tickless.
+ *           A time base that is stopped or that only ticks once
+ *           is always programmed as set.
+ *
+ *-----------------------------------------------------------------*/
+static bool OS_TimeBase_IsTickless(OS_impl_timebase_internal_record_t *local)
+{
+    return (local->tickless && local->start_time != 0 && local->interval_time != 0);
+} /* end OS_TimeBase_IsTickless */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBase_GridTime
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Get the elapsed time in nanoseconds for the given number
+ *           of tick boundaries after the last one reported.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_TimeBase_GridTime(OS_impl_timebase_internal_record_t *local, uint64 boundaries)
+{
+    uint64 elapsed;
+
+    if (boundaries == 0)
+    {
+        elapsed = 0;
+    }
+    else if (local->reset_flag == 0)
+    {
+        /*
+         * Normal steady-state behavior.
+         * interval_time reflects the configured interval time.
+         */
+        elapsed = local->interval_time * boundaries;
+    }
+    else
+    {
+        /*
+         * Reset/First interval behavior.
+         * timer_set() was invoked since the previous interval occurred (if any).
+         * interval_time reflects the configured start time, plus any
+         * intervals that followed it.
+         */
+        elapsed = local->interval_time * (boundaries - 1);
+        elapsed += local->start_time;
+    }
+
+    return elapsed;
+} /* end OS_TimeBase_GridTime */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBase_Boundaries
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Count the tick boundaries that have passed since the
+ *           last one reported, according to the clock.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_TimeBase_Boundaries(OS_impl_timebase_internal_record_t *local, uint64 now)
+{
+    uint64 first;
+
+    if (local->reset_flag == 0)
+    {
+        first = local->last_tick + local->interval_time;
+    }
+    else
+    {
+        first = local->last_tick + local->start_time;
+    }
+
+    if (now < first)
+    {
+        return 0;
+    }
+
+    return 1 + ((now - first) / local->interval_time);
+} /* end OS_TimeBase_Boundaries */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBase_Report
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Report the given number of tick boundaries after the
+ *           last one reported, and convert them into the elapsed
+ *           time in nanoseconds.
+ *           The caller must hold the lock of the time base state.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_TimeBase_Report(OS_impl_timebase_internal_record_t *local, uint64 boundaries)
+{
+    uint64 interval_time;
+
+    if (boundaries == 0)
+    {
+        return 0;
+    }
+
+    interval_time = OS_TimeBase_GridTime(local, boundaries);
+
+    local->last_tick += interval_time;
+    local->reset_flag = 0;
+    local->pending_time += interval_time;
+
+    return interval_time;
+} /* end OS_TimeBase_Report */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBase_ElapsedTime
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Convert a number of expirations of the simulated tick
+ *           into the elapsed time in nanoseconds.
+ *
+ *           A tickless time base is programmed for a single tick
+ *           at a time, so the elapsed time is taken from the clock
+ *           instead.
+ *
+ *           The caller must hold the lock of the time base state.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_TimeBase_ElapsedTime(uint32 timer_id, uint64 expirations)
+{
+    OS_impl_timebase_internal_record_t *local;
+    uint64 tick_time;
+
+    local = &OS_impl_timebase_table[timer_id];
+
+    if (expirations == 0)
+    {
+        /*
+         * the wait failed or was interrupted.
+         * returning 0 will cause the process to repeat.
+         */
+        return 0;
+    }
+
+    if (!OS_TimeBase_IsTickless(local))
+    {
+        local->overrun_count += (uint32)(expirations - 1);
+        return OS_TimeBase_Report(local, expirations);
+    }
+
+    tick_time = OS_TimeBase_Report(local, OS_TimeBase_Boundaries(local, OS_TimeBase_Now()));
+
+    /* the tick is a one-shot, so count the intervals it was late for */
+    if (local->next_tick != 0 && local->last_tick > local->next_tick)
+    {
+        local->overrun_count += (uint32)((local->last_tick - local->next_tick) / local->interval_time);
+    }
+    local->next_tick = 0;
+
+    return tick_time;
+} /* end OS_TimeBase_ElapsedTime */
+
+#if defined(OS_POSIX_TIMERFD)
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBase_FdWaitImpl
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Pend on the timerfd of a simulated time base.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_TimeBase_FdWaitImpl(uint32 timer_id)
+{
+    uint64 expirations;
+    uint64 tick_time;
+
+    if (read(OS_impl_timebase_table[timer_id].timer_fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+    {
+        expirations = 0;
+    }
+
+    OS_TimeBaseLock_Impl(timer_id);
+    tick_time = OS_TimeBase_ElapsedTime(timer_id, expirations);
+    OS_TimeBaseUnlock_Impl(timer_id);
+
+    return tick_time;
+} /* end OS_TimeBase_FdWaitImpl */
+
+#elif defined(OS_POSIX_TIMER_SIGNAL)
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBase_SigWaitImpl
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Pend on the RT signal of a simulated time base.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_TimeBase_SigWaitImpl(uint32 timer_id)
+{
+    OS_impl_timebase_internal_record_t *local;
+    uint64 expirations;
+    uint64 tick_time;
+    int overruns;
+    int sig;
+
+    local = &OS_impl_timebase_table[timer_id];
+
+    if (sigwait(&local->sigset, &sig) != 0)
+    {
+        expirations = 0;
+    }
+    else
+    {
+        /* expirations after the one that queued the signal */
+        overruns = timer_getoverrun(local->host_timerid);
+        if (overruns < 0)
+        {
+            overruns = 0;
+        }
+        expirations = 1 + (uint64)overruns;
+    }
+
+    OS_TimeBaseLock_Impl(timer_id);
+    tick_time = OS_TimeBase_ElapsedTime(timer_id, expirations);
+    OS_TimeBaseUnlock_Impl(timer_id);
+
+    return tick_time;
+} /* end OS_TimeBase_SigWaitImpl */
+
+#endif
+
+#ifdef OS_POSIX_TIMER_SERVICE
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerService_Place
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Put a time base at the given position of the heap.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_TimerService_Place(uint32 pos, uint32 local_id)
+{
+    OS_impl_timer_service.heap[pos] = local_id;
+    OS_impl_timebase_table[local_id].heap_pos = pos + 1;
+} /* end OS_TimerService_Place */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerService_SiftUp
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Move a time base towards the top of the heap until its
+ *           parent does not expire later.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_TimerService_SiftUp(uint32 pos)
+{
+    uint32 local_id;
+    uint32 parent;
+
+    local_id = OS_impl_timer_service.heap[pos];
+    while (pos > 0)
+    {
+        parent = (pos - 1) / 2;
+        if (OS_impl_timebase_table[OS_impl_timer_service.heap[parent]].next_expiry <=
+                OS_impl_timebase_table[local_id].next_expiry)
+        {
+            break;
+        }
+        OS_TimerService_Place(pos, OS_impl_timer_service.heap[parent]);
+        pos = parent;
+    }
+    OS_TimerService_Place(pos, local_id);
+} /* end OS_TimerService_SiftUp */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerService_SiftDown
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Move a time base towards the bottom of the heap until
+ *           neither child expires earlier.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_TimerService_SiftDown(uint32 pos)
+{
+    uint32 local_id;
+    uint32 child;
+
+    local_id = OS_impl_timer_service.heap[pos];
+    while (1)
+    {
+        child = (2 * pos) + 1;
+        if (child >= OS_impl_timer_service.heap_count)
+        {
+            break;
+        }
+        if ((child + 1) < OS_impl_timer_service.heap_count &&
+                OS_impl_timebase_table[OS_impl_timer_service.heap[child + 1]].next_expiry <
+                OS_impl_timebase_table[OS_impl_timer_service.heap[child]].next_expiry)
+        {
+            ++child;
+        }
+        if (OS_impl_timebase_table[local_id].next_expiry <=
+                OS_impl_timebase_table[OS_impl_timer_service.heap[child]].next_expiry)
+        {
+            break;
+        }
+        OS_TimerService_Place(pos, OS_impl_timer_service.heap[child]);
+        pos = child;
+    }
+    OS_TimerService_Place(pos, local_id);
+} /* end OS_TimerService_SiftDown */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerService_Remove
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Take a time base off the heap, if it is on it.
+ *           The service mutex must be held.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_TimerService_Remove(uint32 local_id)
+{
+    uint32 pos;
+    uint32 last_id;
+
+    if (OS_impl_timebase_table[local_id].heap_pos == 0)
+    {
+        return;
+    }
+
+    pos = OS_impl_timebase_table[local_id].heap_pos - 1;
+    OS_impl_timebase_table[local_id].heap_pos = 0;
+
+    --OS_impl_timer_service.heap_count;
+    if (pos < OS_impl_timer_service.heap_count)
+    {
+        last_id = OS_impl_timer_service.heap[OS_impl_timer_service.heap_count];
+        OS_TimerService_Place(pos, last_id);
+        OS_TimerService_SiftUp(pos);
+        OS_TimerService_SiftDown(OS_impl_timebase_table[last_id].heap_pos - 1);
+    }
+} /* end OS_TimerService_Remove */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerService_Arm
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Program the next expiry of a time base, or disarm it
+ *           if the expiry is zero, and wake the service thread
+ *           in case this is now the earliest expiry.
+ *           The service mutex must be held.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_TimerService_Arm(uint32 local_id, uint64 expiry, uint64 interval_nsec)
+{
+    OS_impl_timebase_internal_record_t *local;
+
+    local = &OS_impl_timebase_table[local_id];
+
+    if (expiry == 0)
+    {
+        OS_TimerService_Remove(local_id);
+        return;
+    }
+
+    local->next_expiry = expiry;
+    local->interval_nsec = interval_nsec;
+
+    if (local->heap_pos == 0)
+    {
+        OS_TimerService_Place(OS_impl_timer_service.heap_count, local_id);
+        ++OS_impl_timer_service.heap_count;
+    }
+    OS_TimerService_SiftUp(local->heap_pos - 1);
+    OS_TimerService_SiftDown(local->heap_pos - 1);
+
+    pthread_cond_signal(&OS_impl_timer_service.cond);
+#ifdef OS_POSIX_VIRTUAL_TIME
+    OS_Posix_VirtualTimeNotify();
+#endif
+} /* end OS_TimerService_Arm */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerService_Set
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Program the first expiry and the interval of a time base,
+ *           or disarm it if the start time is zero.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_TimerService_Set(uint32 local_id, uint64 start_time, uint64 interval_time)
+{
+    OS_impl_timebase_internal_record_t *local;
+
+    local = &OS_impl_timebase_table[local_id];
+
+    pthread_mutex_lock(&OS_impl_timer_service.mutex);
+
+    local->start_time = start_time;
+    local->interval_time = interval_time;
+    local->reset_flag = 1;
+    local->pending_time = 0;
+    local->last_tick = OS_TimeBase_Now();
+    local->next_tick = 0;
+
+    if (start_time == 0)
+    {
+        OS_TimerService_Arm(local_id, 0, 0);
+    }
+    else
+    {
+        OS_TimerService_Arm(local_id, local->last_tick + start_time, interval_time);
+    }
+
+    pthread_mutex_unlock(&OS_impl_timer_service.mutex);
+} /* end OS_TimerService_Set */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerService_Wait
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Wait until the heap changes or the given expiry time,
+ *           or only until the heap changes if the time is zero.
+ *           The caller must hold the service mutex.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_TimerService_Wait(uint64 expiry)
+{
+#ifdef OS_POSIX_VIRTUAL_TIME
+    uint32 event;
+
+    /* every change to the heap is notified after this, see OS_TimerService_Arm() */
+    event = OS_Posix_VirtualTimeEvent();
+    pthread_mutex_unlock(&OS_impl_timer_service.mutex);
+    OS_Posix_VirtualTimeWait(event, expiry);
+    pthread_mutex_lock(&OS_impl_timer_service.mutex);
+#else
+    struct timespec wakeup;
+
+    if (expiry == 0)
+    {
+        pthread_cond_wait(&OS_impl_timer_service.cond, &OS_impl_timer_service.mutex);
+    }
+    else
+    {
+        wakeup.tv_sec = expiry / 1000000000;
+        wakeup.tv_nsec = expiry % 1000000000;
+        pthread_cond_timedwait(&OS_impl_timer_service.cond, &OS_impl_timer_service.mutex, &wakeup);
+    }
+#endif
+} /* end OS_TimerService_Wait */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerService_Entry
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           The timer service thread.  Sleeps until the earliest
+ *           expiry of all armed time bases, then processes the tick
+ *           of that time base in the same way as the helper thread
+ *           of a time base would.
+ *
+ *-----------------------------------------------------------------*/
+static void *OS_TimerService_Entry(void *arg)
+{
+    OS_impl_timebase_internal_record_t *local;
+    uint64 now;
+    uint64 expirations;
+    uint32 local_id;
+    uint32 timebase_id;
+    uint64 tick_time;
+
+    pthread_mutex_lock(&OS_impl_timer_service.mutex);
+
+    while (1)
+    {
+        if (OS_impl_timer_service.heap_count == 0)
+        {
+            OS_TimerService_Wait(0);
+            continue;
+        }
+
+        local_id = OS_impl_timer_service.heap[0];
+        local = &OS_impl_timebase_table[local_id];
+
+        now = OS_TimeBase_Now();
+        if (now < local->next_expiry)
+        {
+            /* sleep until the expiry, or until the heap changes */
+            OS_TimerService_Wait(local->next_expiry);
+            continue;
+        }
+
+        /* count every interval that has expired, as a timerfd would */
+        expirations = 1;
+        if (OS_TimeBase_IsTickless(local))
+        {
+            /* a tickless time base is armed for one tick at a time */
+            OS_TimerService_Remove(local_id);
+        }
+        else if (local->interval_nsec > 0)
+        {
+            expirations += (now - local->next_expiry) / local->interval_nsec;
+            local->next_expiry += expirations * local->interval_nsec;
+            OS_TimerService_SiftDown(0);
+        }
+        else
+        {
+            OS_TimerService_Remove(local_id);
+        }
+
+        tick_time = OS_TimeBase_ElapsedTime(local_id, expirations);
+        timebase_id = OS_global_timebase_table[local_id].active_id;
+
+        pthread_mutex_unlock(&OS_impl_timer_service.mutex);
+
+        /*
+         * Identify as the time base being served, so the timer API
+         * rejects calls from its callbacks like it would from its own thread.
+         */
+        OS_TaskRegister_Impl(timebase_id);
+        OS_TimeBase_ProcessTick(timebase_id, local_id, tick_time);
+
+        pthread_mutex_lock(&OS_impl_timer_service.mutex);
+    }
+
+    return NULL;
+} /* end OS_TimerService_Entry */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerService_Start
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Start the timer service thread, if not already running.
+ *           This is called with the global time base table locked.
+ *
+ *-----------------------------------------------------------------*/
+static int32 OS_TimerService_Start(void)
+{
+    int32 return_code;
+
+    if (OS_impl_timer_service.started)
+    {
+        return OS_SUCCESS;
+    }
+
+    return_code = OS_Posix_InternalTaskCreate_Impl(&OS_impl_timer_service.thread, 0, 0, OS_TIMEBASE_CPU_MASK,
+          OS_TimerService_Entry, NULL);
+    if (return_code == OS_SUCCESS)
+    {
+        OS_Posix_SetThreadName(OS_impl_timer_service.thread, "timer-service");
+        OS_impl_timer_service.started = true;
+    }
+
+    return return_code;
+} /* end OS_TimerService_Start */
+
+#endif
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBase_IsSimulated
  *
- *  Purpose: Implemented per internal OSAL API
- *           See prototype in os-impl.h for argument/return detail
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Check if a time base generates a simulated tick, as
+ *           opposed to using an external sync function.
  *
  *-----------------------------------------------------------------*/
-void OS_TimeBaseUnlock_Impl(uint32 local_id)
+static bool OS_TimeBase_IsSimulated(uint32 timer_id)
 {
-    pthread_mutex_unlock(&OS_impl_timebase_table[local_id].handler_mutex);
-} /* end OS_TimeBaseUnlock_Impl */
+#if defined(OS_POSIX_TIMER_SERVICE)
+    return (OS_timebase_table[timer_id].external_sync == NULL);
+#elif defined(OS_POSIX_TIMERFD)
+    return (OS_impl_timebase_table[timer_id].timer_fd >= 0);
+#else
+    return (OS_impl_timebase_table[timer_id].assigned_signal != 0);
+#endif
+} /* end OS_TimeBase_IsSimulated */
 
-                        
 /*----------------------------------------------------------------
  *
- * Function: OS_TimeBase_SoftWaitImpl
+ * Function: OS_TimeBase_Program
  *
  *  Purpose: Local helper routine, not part of OSAL API.
+ *           Program the simulated tick of a time base to first expire
+ *           at the given time on the clock, in nanoseconds, and then
+ *           on every interval after it, or disarm it if the first
+ *           time is zero.
+ *           The caller must hold the lock of the time base state.
  *
  *-----------------------------------------------------------------*/
-static uint32 OS_TimeBase_SigWaitImpl(uint32 timer_id)
+static int32 OS_TimeBase_Program(uint32 timer_id, uint64 first, uint64 interval_nsec)
 {
-    int ret;
-    OS_impl_timebase_internal_record_t *local;
-    uint32 interval_time;
-    int sig;
-
-    local = &OS_impl_timebase_table[timer_id];
+#if defined(OS_POSIX_TIMER_SERVICE)
+    OS_TimerService_Arm(timer_id, first, interval_nsec);
+#else
+    struct itimerspec timeout;
+    int status;
 
-    ret = sigwait(&local->sigset, &sig);
+    timeout.it_value.tv_sec = first / 1000000000;
+    timeout.it_value.tv_nsec = first % 1000000000;
+    timeout.it_interval.tv_sec = interval_nsec / 1000000000;
+    timeout.it_interval.tv_nsec = interval_nsec % 1000000000;
 
-    if (ret != 0)
-    {
-        /*
-         * the sigwait call failed.
-         * returning 0 will cause the process to repeat.
-         */
-        interval_time = 0;
-    }
-    else if (local->reset_flag == 0)
-    {
-        /*
-         * Normal steady-state behavior.
-         * interval_time reflects the configured interval time.
-         */
-        interval_time = OS_timebase_table[timer_id].nominal_interval_time;
-    }
-    else
+#if defined(OS_POSIX_TIMERFD)
+    status = timerfd_settime(OS_impl_timebase_table[timer_id].timer_fd, TFD_TIMER_ABSTIME, &timeout, NULL);
+#else
+    status = timer_settime(OS_impl_timebase_table[timer_id].host_timerid, TIMER_ABSTIME, &timeout, NULL);
+#endif
+    if (status < 0)
     {
-        /*
-         * Reset/First interval behavior.
-         * timer_set() was invoked since the previous interval occurred (if any).
-         * interval_time reflects the configured start time.
-         */
-        interval_time = OS_timebase_table[timer_id].nominal_start_time;
-        local->reset_flag = 0;
+        OS_DEBUG("Error in timer_settime: %s\n",strerror(errno));
+        return OS_TIMER_ERR_INTERNAL;
     }
+#endif
 
-    return interval_time;
-} /* end OS_TimeBase_SoftWaitImpl */
+    return OS_SUCCESS;
+} /* end OS_TimeBase_Program */
 
 
 /****************************************************************************************
@@ -195,6 +850,9 @@ int32 OS_Posix_TimeBaseAPI_Impl_Init(void)
    int    status;
    int    i;
    pthread_mutexattr_t mutex_attr;
+#ifdef OS_POSIX_TIMER_SERVICE
+   pthread_condattr_t cond_attr;
+#endif
    struct timespec clock_resolution;
    int32  return_code;
 
@@ -270,7 +928,44 @@ int32 OS_Posix_TimeBaseAPI_Impl_Init(void)
               return_code = OS_ERROR;
               break;
            }
+
+#ifdef OS_POSIX_TIMERFD
+           OS_impl_timebase_table[i].timer_fd = -1;
+#endif
+       }
+
+#ifdef OS_POSIX_TIMER_SERVICE
+       /*
+       ** create the timer service lock, and the condition it sleeps on
+       ** The condition must use the same clock as the time bases.
+       */
+       memset(&OS_impl_timer_service, 0, sizeof(OS_impl_timer_service));
+
+       status = pthread_mutex_init(&OS_impl_timer_service.mutex, &mutex_attr);
+       if ( status != 0 )
+       {
+          OS_DEBUG("Error: Mutex could not be created: %s\n",strerror(status));
+          return_code = OS_ERROR;
+          break;
+       }
+
+       status = pthread_condattr_init(&cond_attr);
+       if ( status == 0 )
+       {
+          status = pthread_condattr_setclock(&cond_attr, OS_PREFERRED_CLOCK);
+          if ( status == 0 )
+          {
+             status = pthread_cond_init(&OS_impl_timer_service.cond, &cond_attr);
+          }
+          pthread_condattr_destroy(&cond_attr);
+       }
+       if ( status != 0 )
+       {
+          OS_DEBUG("Error: Condition could not be created: %s\n",strerror(status));
+          return_code = OS_ERROR;
+          break;
        }
+#endif
 
        /*
         * Pre-calculate the clock tick to microsecond conversion factor.
@@ -322,9 +1017,11 @@ static void *OS_TimeBasePthreadEntry(void *arg)
 int32 OS_TimeBaseCreate_Impl(uint32 timer_id)
 {
     int32  return_code;
+#ifdef OS_POSIX_TIMER_SIGNAL
     int    status;
     int    i;
     struct sigevent   evp;
+#endif
     OS_impl_timebase_internal_record_t *local;
     OS_common_record_t *global;
     OS_U32ValueWrapper_t arg;
@@ -333,6 +1030,27 @@ int32 OS_TimeBaseCreate_Impl(uint32 timer_id)
     local = &OS_impl_timebase_table[timer_id];
     global = &OS_global_timebase_table[timer_id];
 
+    local->start_time = 0;
+    local->interval_time = 0;
+    local->reset_flag = 0;
+    local->overrun_count = 0;
+    local->pending_time = 0;
+    local->tickless = false;
+    local->last_tick = 0;
+    local->next_tick = 0;
+
+#ifdef OS_POSIX_TIMER_SERVICE
+    /*
+     * A simulated time base is served by the timer service thread, so
+     * only a time base with an external sync function needs its own thread
+     */
+    if (OS_timebase_table[timer_id].external_sync == NULL)
+    {
+        local->heap_pos = 0;
+        return OS_TimerService_Start();
+    }
+#endif
+
     /*
      * Spawn a dedicated time base handler thread
      *
@@ -345,13 +1063,15 @@ int32 OS_TimeBaseCreate_Impl(uint32 timer_id)
      */
     arg.opaque_arg = NULL;
     arg.value = global->active_id;
-    return_code = OS_Posix_InternalTaskCreate_Impl(&local->handler_thread, 0, 0, OS_TimeBasePthreadEntry, arg.opaque_arg);
+    return_code = OS_Posix_InternalTaskCreate_Impl(&local->handler_thread, 0, 0, OS_TIMEBASE_CPU_MASK,
+          OS_TimeBasePthreadEntry, arg.opaque_arg);
     if (return_code != OS_SUCCESS)
     {
         return return_code;
     }
 
-    local->assigned_signal = 0;
+    OS_Posix_SetThreadName(local->handler_thread, OS_timebase_table[timer_id].timebase_name);
+
     clock_gettime(OS_PREFERRED_CLOCK, &local->softsleep);
 
     /*
@@ -360,11 +1080,29 @@ int32 OS_TimeBaseCreate_Impl(uint32 timer_id)
      * If an external sync function is used then there is nothing to do here -
      * we simply call that function and it should synchronize to the time source.
      *
-     * If no external sync function is provided then this will set up a POSIX
-     * timer to locally simulate the timer tick using the CPU clock.
+     * If no external sync function is provided then this will set up a timerfd,
+     * or a POSIX timer, to locally simulate the timer tick using the CPU clock.
      */
+#ifndef OS_POSIX_TIMER_SERVICE
     if (OS_timebase_table[timer_id].external_sync == NULL)
     {
+#ifdef OS_POSIX_TIMERFD
+        /*
+         * Note using the "MONOTONIC" clock here as this will still produce consistent intervals
+         * even if the system clock is stepped (e.g. clock_settime).
+         */
+        local->timer_fd = timerfd_create(OS_PREFERRED_CLOCK, TFD_CLOEXEC);
+        if (local->timer_fd < 0)
+        {
+            OS_DEBUG("Error in timerfd_create: %s\n",strerror(errno));
+            return_code = OS_TIMER_ERR_UNAVAILABLE;
+        }
+        else
+        {
+            OS_timebase_table[timer_id].simulated_wait = OS_TimeBase_FdWaitImpl;
+        }
+#else
+        local->assigned_signal = 0;
         sigemptyset(&local->sigset);
 
         /*
@@ -430,11 +1168,12 @@ int32 OS_TimeBaseCreate_Impl(uint32 timer_id)
                 break;
             }
 
-            OS_timebase_table[timer_id].external_sync = OS_TimeBase_SigWaitImpl;
+            OS_timebase_table[timer_id].simulated_wait = OS_TimeBase_SigWaitImpl;
         }
         while (0);
-
+#endif
     }
+#endif
 
     if (return_code != OS_SUCCESS)
     {
@@ -445,7 +1184,9 @@ int32 OS_TimeBaseCreate_Impl(uint32 timer_id)
          * if this function returns non-success (the ID in the global will be set zero)
          */
         pthread_cancel(local->handler_thread);
+#ifdef OS_POSIX_TIMER_SIGNAL
         local->assigned_signal = 0;
+#endif
     }
 
     return return_code;
@@ -459,33 +1200,53 @@ int32 OS_TimeBaseCreate_Impl(uint32 timer_id)
  *           See prototype in os-impl.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-int32 OS_TimeBaseSet_Impl(uint32 timer_id, int32 start_time, int32 interval_time)
+int32 OS_TimeBaseSet_Impl(uint32 timer_id, uint64 start_time, uint64 interval_time)
 {
+#ifndef OS_POSIX_TIMER_SERVICE
     OS_impl_timebase_internal_record_t *local;
+#endif
     struct itimerspec timeout;
     int32 return_code;
     int status;
 
+#ifndef OS_POSIX_TIMER_SERVICE
     local = &OS_impl_timebase_table[timer_id];
+#endif
     return_code = OS_SUCCESS;
 
     /* There is only something to do here if we are generating a simulated tick */
-    if (local->assigned_signal != 0)
+    if (OS_TimeBase_IsSimulated(timer_id))
     {
         /*
-        ** Convert from Microseconds to timespec structures
+        ** Convert from Nanoseconds to timespec structures
         */
         memset(&timeout, 0, sizeof(timeout));
-        OS_UsecToTimespec(start_time, &timeout.it_value);
-        OS_UsecToTimespec(interval_time, &timeout.it_interval);
+        OS_NsecToTimespec(start_time, &timeout.it_value);
+        OS_NsecToTimespec(interval_time, &timeout.it_interval);
 
         /*
         ** Program the real timer
+        ** This also discards any expirations of the previous setting.
         */
+#if defined(OS_POSIX_TIMER_SERVICE)
+        OS_TimerService_Set(timer_id, start_time, interval_time);
+        status = 0;
+#else
+        local->start_time = start_time;
+        local->interval_time = interval_time;
+        local->pending_time = 0;
+        local->last_tick = OS_TimeBase_Now();
+        local->next_tick = 0;
+#if defined(OS_POSIX_TIMERFD)
+        status = timerfd_settime(local->timer_fd, 0, &timeout, NULL);
+#else
         status = timer_settime(local->host_timerid,
                 0,              /* Flags field can be zero */
                 &timeout,       /* struct itimerspec */
                 NULL);         /* Oldvalue */
+#endif
+        local->reset_flag = (status == 0);
+#endif
 
         if (status < 0)
         {
@@ -502,7 +1263,6 @@ int32 OS_TimeBaseSet_Impl(uint32 timer_id, int32 start_time, int32 interval_time
         }
     }
 
-    local->reset_flag = (return_code == OS_SUCCESS);
     return return_code;
 } /* end OS_TimeBaseSet_Impl */
 
@@ -519,15 +1279,42 @@ int32 OS_TimeBaseSet_Impl(uint32 timer_id, int32 start_time, int32 interval_time
 int32 OS_TimeBaseDelete_Impl(uint32 timer_id)
 {
     OS_impl_timebase_internal_record_t *local;
+#ifndef OS_POSIX_TIMER_SERVICE
     int status;
+#endif
 
     local = &OS_impl_timebase_table[timer_id];
 
+#ifdef OS_POSIX_TIMER_SERVICE
+    if (OS_timebase_table[timer_id].external_sync == NULL)
+    {
+        pthread_mutex_lock(&OS_impl_timer_service.mutex);
+        OS_TimerService_Remove(timer_id);
+        pthread_mutex_unlock(&OS_impl_timer_service.mutex);
+        return OS_SUCCESS;
+    }
+#endif
+
     pthread_cancel(local->handler_thread);
+#ifdef OS_POSIX_VIRTUAL_TIME
+    OS_Posix_VirtualTimeCancel(local->handler_thread);
+#endif
 
     /*
     ** Delete the timer
     */
+#if defined(OS_POSIX_TIMERFD)
+    if (local->timer_fd >= 0)
+    {
+        status = close(local->timer_fd);
+        local->timer_fd = -1;
+        if (status < 0)
+        {
+            OS_DEBUG("Error closing timerfd: %s\n",strerror(errno));
+            return ( OS_TIMER_ERR_INTERNAL);
+        }
+    }
+#elif defined(OS_POSIX_TIMER_SIGNAL)
     if (local->assigned_signal != 0)
     {
         status = timer_delete(OS_impl_timebase_table[timer_id].host_timerid);
@@ -539,6 +1326,7 @@ int32 OS_TimeBaseDelete_Impl(uint32 timer_id)
 
         local->assigned_signal = 0;
     }
+#endif
 
     return OS_SUCCESS;
 } /* end OS_TimeBaseDelete_Impl */
@@ -554,14 +1342,252 @@ int32 OS_TimeBaseDelete_Impl(uint32 timer_id)
  *-----------------------------------------------------------------*/
 int32 OS_TimeBaseGetInfo_Impl (uint32 timer_id, OS_timebase_prop_t *timer_prop)
 {
+    timer_prop->overruns = OS_impl_timebase_table[timer_id].overrun_count;
+
     return OS_SUCCESS;
 
 } /* end OS_TimeBaseGetInfo_Impl */
 
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBaseSetTickless_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TimeBaseSetTickless_Impl (uint32 timer_id, bool tickless)
+{
+    OS_impl_timebase_internal_record_t *local;
+    uint64 first;
+    int32 return_code;
+
+    if (!OS_TimeBase_IsSimulated(timer_id))
+    {
+        return OS_ERR_NOT_IMPLEMENTED;
+    }
+
+    local = &OS_impl_timebase_table[timer_id];
+    return_code = OS_SUCCESS;
+
+#ifdef OS_POSIX_TIMER_SERVICE
+    pthread_mutex_lock(&OS_impl_timer_service.mutex);
+#endif
+
+    if (OS_TimeBase_IsTickless(local) && !tickless)
+    {
+        /* go back to ticking on every interval, from the next one on */
+        first = local->last_tick;
+        if (local->reset_flag == 0)
+        {
+            first += local->interval_time;
+        }
+        else
+        {
+            first += local->start_time;
+        }
+        return_code = OS_TimeBase_Program(timer_id, first, local->interval_time);
+    }
+
+    if (return_code == OS_SUCCESS)
+    {
+        local->tickless = tickless;
+        local->next_tick = 0;
+    }
+
+#ifdef OS_POSIX_TIMER_SERVICE
+    pthread_mutex_unlock(&OS_impl_timer_service.mutex);
+#endif
+
+    return return_code;
+
+} /* end OS_TimeBaseSetTickless_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBaseNextDue_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_TimeBaseNextDue_Impl (uint32 timer_id, uint64 tick_time, uint64 wait_time)
+{
+    OS_impl_timebase_internal_record_t *local;
+    uint64 first;
+    uint64 target;
+    uint64 deadline;
+
+    local = &OS_impl_timebase_table[timer_id];
+
+#ifdef OS_POSIX_TIMER_SERVICE
+    pthread_mutex_lock(&OS_impl_timer_service.mutex);
+#endif
+
+    if (tick_time < local->pending_time)
+    {
+        local->pending_time -= tick_time;
+    }
+    else
+    {
+        local->pending_time = 0;
+    }
+
+    /*
+     * If the wheel is due within the time that is already reported but
+     * not yet processed, the tick that processes it will come back here.
+     */
+    if (OS_TimeBase_IsTickless(local) &&
+            (local->pending_time == 0 || wait_time > local->pending_time))
+    {
+        if (wait_time == OS_TIMER_WHEEL_IDLE)
+        {
+            deadline = 0;
+        }
+        else
+        {
+            /* tick on the first boundary at or after the time the wheel is due */
+            first = local->last_tick;
+            if (local->reset_flag == 0)
+            {
+                first += local->interval_time;
+            }
+            else
+            {
+                first += local->start_time;
+            }
+
+            target = local->last_tick;
+            if (wait_time > local->pending_time)
+            {
+                target += wait_time - local->pending_time;
+            }
+
+            deadline = first;
+            if (target > first)
+            {
+                deadline += ((target - first + local->interval_time - 1) / local->interval_time) *
+                        local->interval_time;
+            }
+        }
+
+        if (deadline == 0 || local->next_tick == 0 || deadline < local->next_tick)
+        {
+            if (OS_TimeBase_Program(timer_id, deadline, 0) == OS_SUCCESS)
+            {
+                local->next_tick = deadline;
+            }
+        }
+    }
+
+#ifdef OS_POSIX_TIMER_SERVICE
+    pthread_mutex_unlock(&OS_impl_timer_service.mutex);
+#endif
+
+} /* end OS_TimeBaseNextDue_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBaseTickLateness_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TimeBaseTickLateness_Impl (uint32 timer_id, uint64 tick_time, uint32 *lateness_usec)
+{
+    OS_impl_timebase_internal_record_t *local;
+    uint64 boundary;
+    uint64 now;
+
+    local = &OS_impl_timebase_table[timer_id];
+
+    if (!OS_TimeBase_IsSimulated(timer_id))
+    {
+        return OS_ERR_NOT_IMPLEMENTED;
+    }
+
+#ifdef OS_POSIX_TIMER_SERVICE
+    pthread_mutex_lock(&OS_impl_timer_service.mutex);
+#endif
+
+    /*
+     * The last boundary reported ends the tick, unless later ticks
+     * were reported since, which are still pending as well.
+     */
+    boundary = local->last_tick;
+    if (boundary != 0 && local->pending_time > tick_time)
+    {
+        boundary -= local->pending_time - tick_time;
+    }
+
+#ifdef OS_POSIX_TIMER_SERVICE
+    pthread_mutex_unlock(&OS_impl_timer_service.mutex);
+#endif
+
+    /* not set yet */
+    if (boundary == 0)
+    {
+        return OS_ERR_NOT_IMPLEMENTED;
+    }
+
+    now = OS_TimeBase_Now();
+    if (now <= boundary)
+    {
+        *lateness_usec = 0;
+    }
+    else if (((now - boundary) / 1000) > 0xFFFFFFFF)
+    {
+        *lateness_usec = 0xFFFFFFFF;
+    }
+    else
+    {
+        *lateness_usec = (uint32)((now - boundary) / 1000);
+    }
+
+    return OS_SUCCESS;
+} /* end OS_TimeBaseTickLateness_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBaseSkippedTime_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint64 OS_TimeBaseSkippedTime_Impl (uint32 timer_id)
+{
+    OS_impl_timebase_internal_record_t *local;
+    uint64 skipped_time;
+
+    local = &OS_impl_timebase_table[timer_id];
+
+#ifdef OS_POSIX_TIMER_SERVICE
+    pthread_mutex_lock(&OS_impl_timer_service.mutex);
+#endif
+
+    skipped_time = local->pending_time;
+    if (OS_TimeBase_IsTickless(local))
+    {
+        skipped_time += OS_TimeBase_GridTime(local,
+                OS_TimeBase_Boundaries(local, OS_TimeBase_Now()));
+    }
+
+#ifdef OS_POSIX_TIMER_SERVICE
+    pthread_mutex_unlock(&OS_impl_timer_service.mutex);
+#endif
+
+    return skipped_time;
+
+} /* end OS_TimeBaseSkippedTime_Impl */
+
 /****************************************************************************************
                   Other Time-Related API Implementation
  ***************************************************************************************/
 
 /* POSIX implements clock_gettime and clock_settime that can be used */
+#ifndef OS_POSIX_VIRTUAL_TIME
 #include "../portable/os-impl-posix-gettime.c"
+#endif
 
@@ -0,0 +1,1126 @@
+/*
+ *      Copyright (c) 2018, United States government as represented by the
+ *      administrator of the National Aeronautics Space Administration.
+ *      All rights reserved. This software was created at NASA Glenn
+ *      Research Center pursuant to government contracts.
+ *
+ *      This is governed by the NASA Open Source Agreement and may be used,
+ *      distributed and modified only according to the terms of that agreement.
+ */
+
+/**
+ * \file   osvirtualtime.c
+ *
+ * Purpose: This file contains the virtual clock for POSIX.
+ *
+ *          Define OSAL_POSIX_VIRTUAL_TIME to make all OSAL time follow a
+ *          virtual clock instead of the host clocks: task delays, timed
+ *          semaphore, queue and condition variable waits, the local and
+ *          monotonic time, and the simulated time bases.
+ *
+ *          Every task that waits through OSAL is known to the clock.  While
+ *          any of them is running the clock follows the real time, but once
+ *          all of them are waiting it jumps straight to the earliest deadline
+ *          any of them is waiting for, so that simulated time runs as fast as
+ *          the tasks can process it.  A test harness can turn this off and
+ *          move the clock with OS_VirtualTimeAdvance() instead.
+ *
+ *          A task counts as running from the moment anything makes it able
+ *          to run, not from when it gets to: a new task from before its
+ *          thread is created, a waiting task from when it is woken, and a
+ *          task blocked on a mutex from when the mutex is released.  It
+ *          also counts as running until its thread has terminated, as other
+ *          tasks may wait for that in real time, e.g. to reuse its stack.
+ */
+
+/****************************************************************************************
+                                    INCLUDE FILES
+ ***************************************************************************************/
+
+/*
+ * The kernel thread ID, which tells when an exiting thread is gone, is
+ * only available through syscall(), a GNU extension.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "os-posix.h"
+#include <sys/syscall.h>
+
+#ifdef OS_POSIX_VIRTUAL_TIME
+
+/****************************************************************************************
+                                     DEFINES
+ ***************************************************************************************/
+
+/*
+ * While some task is running, the clock follows the real time so that a task
+ * that polls the time sees it pass.  This is how often the clock is brought
+ * up to date if no task reads it, so that a task waiting for a deadline on
+ * it still wakes up in time.
+ */
+#define OS_VIRTUAL_TIME_QUANTUM_NSEC    1000000
+
+/*
+ * Goal of the clock if nothing limits how far it may advance
+ */
+#define OS_VIRTUAL_TIME_NO_GOAL         0xFFFFFFFFFFFFFFFFULL
+
+/*
+ * States of a task known to the virtual clock
+ */
+#define OS_VIRTUAL_TIME_RUNNING         0
+#define OS_VIRTUAL_TIME_WAITING         1   /* until an event or a deadline */
+#define OS_VIRTUAL_TIME_SLEEPING        2   /* until a deadline only */
+#define OS_VIRTUAL_TIME_BLOCKED         3   /* outside of the clock, e.g. on a mutex */
+
+/****************************************************************************************
+                                   LOCAL TYPEDEFS
+ ***************************************************************************************/
+
+struct OS_impl_virtual_thread
+{
+    struct OS_impl_virtual_thread *next;    /* next waiting, blocked or exiting task */
+    uint32                         state;
+    uint64                         deadline; /* zero if waiting for an event only */
+    const pthread_mutex_t         *mutex;   /* mutex a blocked task waits for, if any */
+    void                          *start_arg; /* entry argument of a task that has not started */
+    pthread_t                      thread;  /* thread of a task that has started */
+    pid_t                          tid;     /* kernel thread ID of an exiting task */
+};
+
+typedef struct
+{
+    pthread_mutex_t           mutex;
+    pthread_cond_t            cond;         /* broadcast when waiting tasks are woken */
+    pthread_cond_t            advance_cond; /* signalled when the clock may be able to advance */
+    pthread_key_t             thread_key;
+    pthread_t                 advance_thread;
+    uint64                    now;          /* virtual monotonic time in ns */
+    int64                     realtime_offset;
+    uint64                    target;       /* time requested by OS_VirtualTimeAdvance */
+    uint64                    real_ref;     /* host monotonic time the clock was last brought up to date */
+    uint32                    event;        /* changed by every notification */
+    uint32                    threads;      /* tasks known to the clock */
+    uint32                    idle;         /* of those, the tasks that are waiting or blocked */
+    bool                      auto_advance;
+    OS_impl_virtual_thread_t  *waiters;
+    OS_impl_virtual_thread_t  *blocked;     /* tasks in OS_Posix_VirtualTimeBlock() */
+    OS_impl_virtual_thread_t  *exiting;     /* tasks whose threads have not terminated yet */
+} OS_impl_virtual_time_t;
+
+/****************************************************************************************
+                                   GLOBAL DATA
+ ***************************************************************************************/
+
+static OS_impl_virtual_time_t OS_impl_virtual_time;
+
+/****************************************************************************************
+                                 LOCAL FUNCTIONS
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTime_RealNow
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Read the host monotonic clock in nanoseconds.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_VirtualTime_RealNow(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64)now.tv_sec * 1000000000) + now.tv_nsec;
+} /* end OS_VirtualTime_RealNow */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTime_Goal
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Get the time the clock may advance to next, which is the
+ *           earliest deadline of any waiting task, but no further than
+ *           the time requested through OS_VirtualTimeAdvance() unless
+ *           the clock advances automatically.  If there is no limit
+ *           the result is the largest possible time.
+ *           The caller must hold the clock mutex.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_VirtualTime_Goal(void)
+{
+    OS_impl_virtual_thread_t *waiter;
+    uint64 goal;
+
+    if (OS_impl_virtual_time.auto_advance)
+    {
+        goal = OS_VIRTUAL_TIME_NO_GOAL;
+    }
+    else
+    {
+        goal = OS_impl_virtual_time.target;
+    }
+
+    for (waiter = OS_impl_virtual_time.waiters; waiter != NULL; waiter = waiter->next)
+    {
+        if (waiter->deadline != 0 && waiter->deadline < goal)
+        {
+            goal = waiter->deadline;
+        }
+    }
+
+    return goal;
+} /* end OS_VirtualTime_Goal */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTime_Wake
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Wake every waiting task whose deadline has been reached,
+ *           and if "notify" is set every task waiting for an event.
+ *           The caller must hold the clock mutex.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_VirtualTime_Wake(bool notify)
+{
+    OS_impl_virtual_thread_t **link;
+    OS_impl_virtual_thread_t *waiter;
+    bool woken;
+
+    woken = false;
+    link = &OS_impl_virtual_time.waiters;
+    while (*link != NULL)
+    {
+        waiter = *link;
+        if ((notify && waiter->state == OS_VIRTUAL_TIME_WAITING) ||
+                (waiter->deadline != 0 && waiter->deadline <= OS_impl_virtual_time.now))
+        {
+            /* the task counts as running from here, not from when it gets to run */
+            *link = waiter->next;
+            waiter->state = OS_VIRTUAL_TIME_RUNNING;
+            --OS_impl_virtual_time.idle;
+            woken = true;
+        }
+        else
+        {
+            link = &waiter->next;
+        }
+    }
+
+    if (woken)
+    {
+        pthread_cond_broadcast(&OS_impl_virtual_time.cond);
+    }
+} /* end OS_VirtualTime_Wake */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTime_Reap
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Forget the exiting tasks whose threads have terminated.
+ *           The caller must hold the clock mutex.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_VirtualTime_Reap(void)
+{
+    OS_impl_virtual_thread_t **link;
+    OS_impl_virtual_thread_t *thread;
+    int saved_errno;
+
+    saved_errno = errno;
+    link = &OS_impl_virtual_time.exiting;
+    while (*link != NULL)
+    {
+        thread = *link;
+        if (syscall(SYS_tgkill, getpid(), thread->tid, 0) != 0 && errno == ESRCH)
+        {
+            *link = thread->next;
+            --OS_impl_virtual_time.threads;
+            pthread_cond_signal(&OS_impl_virtual_time.advance_cond);
+            free(thread);
+        }
+        else
+        {
+            link = &thread->next;
+        }
+    }
+    errno = saved_errno;
+} /* end OS_VirtualTime_Reap */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTime_Follow
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Bring the clock up to date with the real time that passed
+ *           since the last call, if some task was running all that
+ *           time.  This must be called before reading the clock and
+ *           before any task starts or stops waiting, so every task
+ *           that polls the clock sees it pass without depending on
+ *           the advance thread getting to run.
+ *           The caller must hold the clock mutex.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_VirtualTime_Follow(void)
+{
+    uint64 real_now;
+    uint64 elapsed;
+    uint64 goal;
+
+    real_now = OS_VirtualTime_RealNow();
+    elapsed = real_now - OS_impl_virtual_time.real_ref;
+    OS_impl_virtual_time.real_ref = real_now;
+
+    if (OS_impl_virtual_time.exiting != NULL)
+    {
+        OS_VirtualTime_Reap();
+    }
+
+    if (OS_impl_virtual_time.idle >= OS_impl_virtual_time.threads)
+    {
+        return;
+    }
+
+    goal = OS_VirtualTime_Goal();
+    if (goal <= OS_impl_virtual_time.now)
+    {
+        return;
+    }
+
+    if (goal - OS_impl_virtual_time.now <= elapsed)
+    {
+        OS_impl_virtual_time.now = goal;
+        OS_VirtualTime_Wake(false);
+    }
+    else
+    {
+        OS_impl_virtual_time.now += elapsed;
+    }
+} /* end OS_VirtualTime_Follow */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTime_NewThread
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Allocate the record of a task and make the task known to
+ *           the clock, as running.
+ *           The caller must hold the clock mutex.
+ *
+ *-----------------------------------------------------------------*/
+static OS_impl_virtual_thread_t *OS_VirtualTime_NewThread(void)
+{
+    OS_impl_virtual_thread_t *thread;
+
+    thread = calloc(1, sizeof(*thread));
+    if (thread == NULL)
+    {
+        OS_DEBUG("Unable to allocate virtual time record\n");
+        return NULL;
+    }
+
+    OS_VirtualTime_Follow();
+    ++OS_impl_virtual_time.threads;
+
+    return thread;
+} /* end OS_VirtualTime_NewThread */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTime_Self
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Get the record of the calling task, making the task
+ *           known to the clock if it is not yet.
+ *           The caller must hold the clock mutex.
+ *
+ *-----------------------------------------------------------------*/
+static OS_impl_virtual_thread_t *OS_VirtualTime_Self(void)
+{
+    OS_impl_virtual_thread_t *self;
+
+    self = pthread_getspecific(OS_impl_virtual_time.thread_key);
+    if (self == NULL)
+    {
+        self = OS_VirtualTime_NewThread();
+        if (self != NULL)
+        {
+            self->thread = pthread_self();
+            pthread_setspecific(OS_impl_virtual_time.thread_key, self);
+        }
+    }
+
+    return self;
+} /* end OS_VirtualTime_Self */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTime_Unlink
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Remove a task from a list of waiting or blocked tasks,
+ *           and count it as running.
+ *           The caller must hold the clock mutex.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_VirtualTime_Unlink(OS_impl_virtual_thread_t **link, OS_impl_virtual_thread_t *self)
+{
+    while (*link != self)
+    {
+        link = &(*link)->next;
+    }
+    *link = self->next;
+    self->state = OS_VIRTUAL_TIME_RUNNING;
+    --OS_impl_virtual_time.idle;
+} /* end OS_VirtualTime_Unlink */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTime_ThreadExit
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Destructor of the thread key, for a task that exits.  The
+ *           task is forgotten by OS_VirtualTime_Reap() once its thread
+ *           has terminated.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_VirtualTime_ThreadExit(void *arg)
+{
+    OS_impl_virtual_thread_t *self = arg;
+
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    OS_VirtualTime_Follow();
+    if (self->state == OS_VIRTUAL_TIME_BLOCKED)
+    {
+        OS_VirtualTime_Unlink(&OS_impl_virtual_time.blocked, self);
+    }
+    self->tid = syscall(SYS_gettid);
+    self->next = OS_impl_virtual_time.exiting;
+    OS_impl_virtual_time.exiting = self;
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+} /* end OS_VirtualTime_ThreadExit */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTime_CancelWait
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Cleanup handler for a task that is deleted while waiting.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_VirtualTime_CancelWait(void *arg)
+{
+    OS_impl_virtual_thread_t *self = arg;
+
+    /* this may wake the task itself */
+    OS_VirtualTime_Follow();
+    if (self->state != OS_VIRTUAL_TIME_RUNNING)
+    {
+        OS_VirtualTime_Unlink(&OS_impl_virtual_time.waiters, self);
+    }
+
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+} /* end OS_VirtualTime_CancelWait */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTime_Suspend
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Wait in the given state until woken by OS_VirtualTime_Wake().
+ *           The caller must hold the clock mutex and have brought the
+ *           clock up to date.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_VirtualTime_Suspend(OS_impl_virtual_thread_t *self, uint32 state, uint64 deadline)
+{
+    pthread_cleanup_push(OS_VirtualTime_CancelWait, self);
+
+    /* a task that is being deleted does not count as waiting */
+    pthread_testcancel();
+
+    self->state = state;
+    self->deadline = deadline;
+    self->next = OS_impl_virtual_time.waiters;
+    OS_impl_virtual_time.waiters = self;
+    ++OS_impl_virtual_time.idle;
+    pthread_cond_signal(&OS_impl_virtual_time.advance_cond);
+
+    while (self->state != OS_VIRTUAL_TIME_RUNNING)
+    {
+        pthread_cond_wait(&OS_impl_virtual_time.cond, &OS_impl_virtual_time.mutex);
+    }
+    pthread_cleanup_pop(0);
+} /* end OS_VirtualTime_Suspend */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTime_AdvanceEntry
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           The thread that advances the clock.  While some task is
+ *           running it keeps the clock up to date with the real time,
+ *           and once every task is waiting it jumps the clock to the
+ *           next deadline.
+ *
+ *-----------------------------------------------------------------*/
+static void *OS_VirtualTime_AdvanceEntry(void *arg)
+{
+    struct timespec wakeup;
+    uint64 goal;
+    uint64 real_wakeup;
+
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+
+    while (1)
+    {
+        OS_VirtualTime_Follow();
+
+        goal = OS_VirtualTime_Goal();
+        if (goal <= OS_impl_virtual_time.now || goal == OS_VIRTUAL_TIME_NO_GOAL)
+        {
+            /* no task waits for a deadline the clock may advance to */
+            pthread_cond_wait(&OS_impl_virtual_time.advance_cond, &OS_impl_virtual_time.mutex);
+            continue;
+        }
+
+        if (OS_impl_virtual_time.idle >= OS_impl_virtual_time.threads)
+        {
+            /* nothing can happen before the next deadline */
+            OS_impl_virtual_time.now = goal;
+            OS_VirtualTime_Wake(false);
+            continue;
+        }
+
+        real_wakeup = OS_impl_virtual_time.real_ref + OS_VIRTUAL_TIME_QUANTUM_NSEC;
+        wakeup.tv_sec = real_wakeup / 1000000000;
+        wakeup.tv_nsec = real_wakeup % 1000000000;
+        pthread_cond_timedwait(&OS_impl_virtual_time.advance_cond, &OS_impl_virtual_time.mutex, &wakeup);
+    }
+
+    return NULL;
+} /* end OS_VirtualTime_AdvanceEntry */
+
+/****************************************************************************************
+                           POSIX IMPLEMENTATION FUNCTIONS
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeAPI_Impl_Init
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Start the virtual clock at the current host time.
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_Posix_VirtualTimeAPI_Impl_Init(void)
+{
+    pthread_condattr_t cond_attr;
+    struct timespec realtime;
+    int32 return_code;
+
+    memset(&OS_impl_virtual_time, 0, sizeof(OS_impl_virtual_time));
+
+    if (pthread_mutex_init(&OS_impl_virtual_time.mutex, NULL) != 0 ||
+            pthread_cond_init(&OS_impl_virtual_time.cond, NULL) != 0 ||
+            pthread_condattr_init(&cond_attr) != 0)
+    {
+        OS_DEBUG("Error initializing the virtual clock: %s\n", strerror(errno));
+        return OS_ERROR;
+    }
+
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    if (pthread_cond_init(&OS_impl_virtual_time.advance_cond, &cond_attr) != 0)
+    {
+        pthread_condattr_destroy(&cond_attr);
+        return OS_ERROR;
+    }
+    pthread_condattr_destroy(&cond_attr);
+
+    if (pthread_key_create(&OS_impl_virtual_time.thread_key, OS_VirtualTime_ThreadExit) != 0)
+    {
+        return OS_ERROR;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &realtime);
+    OS_impl_virtual_time.now = OS_VirtualTime_RealNow();
+    OS_impl_virtual_time.real_ref = OS_impl_virtual_time.now;
+    OS_impl_virtual_time.realtime_offset = (((int64)realtime.tv_sec * 1000000000) + realtime.tv_nsec) -
+            (int64)OS_impl_virtual_time.now;
+    OS_impl_virtual_time.auto_advance = true;
+
+    /* the calling thread is the root task */
+    OS_Posix_VirtualTimeRegister();
+
+    return_code = OS_Posix_InternalTaskCreate_Impl(&OS_impl_virtual_time.advance_thread, 0, 0, 0,
+            OS_VirtualTime_AdvanceEntry, NULL);
+    if (return_code == OS_SUCCESS)
+    {
+        OS_Posix_SetThreadName(OS_impl_virtual_time.advance_thread, "virtual-time");
+    }
+
+    return return_code;
+} /* end OS_Posix_VirtualTimeAPI_Impl_Init */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeNow
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Get the virtual monotonic time in nanoseconds.
+ *
+ *-----------------------------------------------------------------*/
+uint64 OS_Posix_VirtualTimeNow(void)
+{
+    uint64 now;
+
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    OS_VirtualTime_Follow();
+    now = OS_impl_virtual_time.now;
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+
+    return now;
+} /* end OS_Posix_VirtualTimeNow */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeEvent
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Get the current event count, to pass to
+ *           OS_Posix_VirtualTimeWait() after checking the condition
+ *           that is waited for.
+ *
+ *-----------------------------------------------------------------*/
+uint32 OS_Posix_VirtualTimeEvent(void)
+{
+    uint32 event;
+
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    event = OS_impl_virtual_time.event;
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+
+    return event;
+} /* end OS_Posix_VirtualTimeEvent */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeNotify
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Wake every task in OS_Posix_VirtualTimeWait(), after
+ *           changing a condition that may be waited for.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_VirtualTimeNotify(void)
+{
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    OS_VirtualTime_Follow();
+    ++OS_impl_virtual_time.event;
+    OS_VirtualTime_Wake(true);
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+} /* end OS_Posix_VirtualTimeNotify */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeWait
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Wait until the event count differs from the given one or
+ *           the virtual clock reaches the deadline, unless the deadline
+ *           is zero.  Returns OS_ERROR_TIMEOUT if the deadline was reached.
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_Posix_VirtualTimeWait(uint32 event, uint64 deadline)
+{
+    OS_impl_virtual_thread_t *self;
+    int32 return_code;
+
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+
+    self = OS_VirtualTime_Self();
+    if (self == NULL)
+    {
+        return_code = OS_ERROR;
+    }
+    else
+    {
+        OS_VirtualTime_Follow();
+        if (event == OS_impl_virtual_time.event &&
+                (deadline == 0 || deadline > OS_impl_virtual_time.now))
+        {
+            OS_VirtualTime_Suspend(self, OS_VIRTUAL_TIME_WAITING, deadline);
+        }
+
+        if (deadline != 0 && deadline <= OS_impl_virtual_time.now)
+        {
+            return_code = OS_ERROR_TIMEOUT;
+        }
+        else
+        {
+            return_code = OS_SUCCESS;
+        }
+    }
+
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+
+    return return_code;
+} /* end OS_Posix_VirtualTimeWait */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeSleep
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Wait until the virtual clock reaches the deadline.
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_Posix_VirtualTimeSleep(uint64 deadline)
+{
+    OS_impl_virtual_thread_t *self;
+    int32 return_code;
+
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+
+    self = OS_VirtualTime_Self();
+    if (self == NULL)
+    {
+        return_code = OS_ERROR;
+    }
+    else
+    {
+        OS_VirtualTime_Follow();
+        while (deadline > OS_impl_virtual_time.now)
+        {
+            OS_VirtualTime_Suspend(self, OS_VIRTUAL_TIME_SLEEPING, deadline);
+        }
+        return_code = OS_SUCCESS;
+    }
+
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+
+    return return_code;
+} /* end OS_Posix_VirtualTimeSleep */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeBlock
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Count the calling task as waiting while it blocks in a
+ *           call that the clock does not know about, until it calls
+ *           OS_Posix_VirtualTimeUnblock().
+ *
+ *           If a mutex is given, the task is about to block on it.  The
+ *           mutex is tried once more under the clock mutex, and the task
+ *           only counts as waiting if that fails, so the holder must
+ *           still call OS_Posix_VirtualTimeRelease() after unlocking it.
+ *           Returns false if the mutex was taken here instead.
+ *
+ *-----------------------------------------------------------------*/
+bool OS_Posix_VirtualTimeBlock(pthread_mutex_t *mut)
+{
+    OS_impl_virtual_thread_t *self;
+    bool blocked;
+
+    blocked = true;
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+
+    if (mut != NULL && pthread_mutex_trylock(mut) == 0)
+    {
+        blocked = false;
+    }
+    else
+    {
+        self = OS_VirtualTime_Self();
+        if (self != NULL && self->state == OS_VIRTUAL_TIME_RUNNING)
+        {
+            OS_VirtualTime_Follow();
+            self->state = OS_VIRTUAL_TIME_BLOCKED;
+            self->mutex = mut;
+            self->next = OS_impl_virtual_time.blocked;
+            OS_impl_virtual_time.blocked = self;
+            ++OS_impl_virtual_time.idle;
+            pthread_cond_signal(&OS_impl_virtual_time.advance_cond);
+        }
+    }
+
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+
+    return blocked;
+} /* end OS_Posix_VirtualTimeBlock */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeUnblock
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Count the calling task as running again.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_VirtualTimeUnblock(void)
+{
+    OS_impl_virtual_thread_t *self;
+
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+
+    self = pthread_getspecific(OS_impl_virtual_time.thread_key);
+    if (self != NULL && self->state == OS_VIRTUAL_TIME_BLOCKED)
+    {
+        OS_VirtualTime_Follow();
+        OS_VirtualTime_Unlink(&OS_impl_virtual_time.blocked, self);
+    }
+
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+} /* end OS_Posix_VirtualTimeUnblock */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeRelease
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Count the tasks blocked on a mutex as running, after the
+ *           mutex was unlocked.  Those that do not get the mutex keep
+ *           the clock following the real time until they do.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_VirtualTimeRelease(pthread_mutex_t *mut)
+{
+    OS_impl_virtual_thread_t **link;
+    OS_impl_virtual_thread_t *blocked;
+
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+
+    if (OS_impl_virtual_time.blocked != NULL)
+    {
+        OS_VirtualTime_Follow();
+        link = &OS_impl_virtual_time.blocked;
+        while (*link != NULL)
+        {
+            blocked = *link;
+            if (blocked->mutex == mut)
+            {
+                *link = blocked->next;
+                blocked->state = OS_VIRTUAL_TIME_RUNNING;
+                --OS_impl_virtual_time.idle;
+            }
+            else
+            {
+                link = &blocked->next;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+} /* end OS_Posix_VirtualTimeRelease */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeRegister
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Make the calling task known to the clock.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_VirtualTimeRegister(void)
+{
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    OS_VirtualTime_Self();
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+} /* end OS_Posix_VirtualTimeRegister */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeAddThread
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Make a task known to the clock before its thread is
+ *           created, so the clock does not advance before it starts.
+ *           The record is passed to the thread as its entry argument,
+ *           which calls OS_Posix_VirtualTimeStartThread() to get the
+ *           real one back.  Returns NULL if out of memory.
+ *
+ *-----------------------------------------------------------------*/
+OS_impl_virtual_thread_t *OS_Posix_VirtualTimeAddThread(void *start_arg)
+{
+    OS_impl_virtual_thread_t *thread;
+
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    thread = OS_VirtualTime_NewThread();
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+
+    if (thread != NULL)
+    {
+        thread->start_arg = start_arg;
+    }
+
+    return thread;
+} /* end OS_Posix_VirtualTimeAddThread */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeStartThread
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Attach the record made by OS_Posix_VirtualTimeAddThread()
+ *           to the calling thread, and return its entry argument.
+ *           This must be called before any cancellation point.
+ *
+ *-----------------------------------------------------------------*/
+void *OS_Posix_VirtualTimeStartThread(OS_impl_virtual_thread_t *thread)
+{
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    thread->thread = pthread_self();
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+
+    pthread_setspecific(OS_impl_virtual_time.thread_key, thread);
+    return thread->start_arg;
+} /* end OS_Posix_VirtualTimeStartThread */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeCancel
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Count a task as running once its thread has been cancelled,
+ *           as it has to run to act on the cancellation.  This must be
+ *           called right after pthread_cancel(), while the caller still
+ *           keeps the clock from advancing.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_VirtualTimeCancel(pthread_t thread)
+{
+    OS_impl_virtual_thread_t *waiter;
+
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    OS_VirtualTime_Follow();
+
+    for (waiter = OS_impl_virtual_time.waiters; waiter != NULL; waiter = waiter->next)
+    {
+        if (pthread_equal(waiter->thread, thread))
+        {
+            OS_VirtualTime_Unlink(&OS_impl_virtual_time.waiters, waiter);
+            break;
+        }
+    }
+
+    for (waiter = OS_impl_virtual_time.blocked; waiter != NULL; waiter = waiter->next)
+    {
+        if (pthread_equal(waiter->thread, thread))
+        {
+            OS_VirtualTime_Unlink(&OS_impl_virtual_time.blocked, waiter);
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+} /* end OS_Posix_VirtualTimeCancel */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Posix_VirtualTimeRemoveThread
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Forget a task added by OS_Posix_VirtualTimeAddThread()
+ *           whose thread could not be created.
+ *
+ *-----------------------------------------------------------------*/
+void OS_Posix_VirtualTimeRemoveThread(OS_impl_virtual_thread_t *thread)
+{
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    OS_VirtualTime_Follow();
+    --OS_impl_virtual_time.threads;
+    pthread_cond_signal(&OS_impl_virtual_time.advance_cond);
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+
+    free(thread);
+} /* end OS_Posix_VirtualTimeRemoveThread */
+
+/****************************************************************************************
+                                  VIRTUAL TIME API
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTimeAdvance_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_VirtualTimeAdvance_Impl(uint64 nsecs)
+{
+    uint64 target;
+
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    OS_VirtualTime_Follow();
+    target = OS_impl_virtual_time.now + nsecs;
+    if (target > OS_impl_virtual_time.target)
+    {
+        OS_impl_virtual_time.target = target;
+    }
+    pthread_cond_signal(&OS_impl_virtual_time.advance_cond);
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+
+    /* every deadline up to the target is reached in turn while this waits */
+    return OS_Posix_VirtualTimeSleep(target);
+} /* end OS_VirtualTimeAdvance_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTimeSetAuto_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_VirtualTimeSetAuto_Impl(bool auto_advance)
+{
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    OS_VirtualTime_Follow();
+    OS_impl_virtual_time.auto_advance = auto_advance;
+    pthread_cond_signal(&OS_impl_virtual_time.advance_cond);
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+
+    return OS_SUCCESS;
+} /* end OS_VirtualTimeSetAuto_Impl */
+
+/****************************************************************************************
+                                   CLOCK API
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_GetLocalTime_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_GetLocalTime_Impl(OS_time_t *time_struct)
+{
+    uint64 now;
+
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    OS_VirtualTime_Follow();
+    now = OS_impl_virtual_time.now + OS_impl_virtual_time.realtime_offset;
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+
+    time_struct->seconds = now / 1000000000;
+    time_struct->microsecs = (now % 1000000000) / 1000;
+
+    return OS_SUCCESS;
+} /* end OS_GetLocalTime_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_GetMonotonicTime_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_GetMonotonicTime_Impl(OS_time_t *time_struct)
+{
+    uint64 now;
+
+    now = OS_Posix_VirtualTimeNow();
+
+    time_struct->seconds = now / 1000000000;
+    time_struct->microsecs = (now % 1000000000) / 1000;
+
+    return OS_SUCCESS;
+} /* end OS_GetMonotonicTime_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_GetHighResTicks_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_GetHighResTicks_Impl(uint64 *ticks)
+{
+    *ticks = OS_Posix_VirtualTimeNow();
+
+    return OS_SUCCESS;
+} /* end OS_GetHighResTicks_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_GetHighResTickRate_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_GetHighResTickRate_Impl(uint64 *ticks_per_sec)
+{
+    *ticks_per_sec = 1000000000;
+
+    return OS_SUCCESS;
+} /* end OS_GetHighResTickRate_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_SetLocalTime_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_SetLocalTime_Impl(const OS_time_t *time_struct)
+{
+    int64 local_time;
+
+    local_time = ((int64)time_struct->seconds * 1000000000) + ((int64)time_struct->microsecs * 1000);
+
+    /* only the local time moves, the monotonic time and all deadlines stay */
+    pthread_mutex_lock(&OS_impl_virtual_time.mutex);
+    OS_VirtualTime_Follow();
+    OS_impl_virtual_time.realtime_offset = local_time - (int64)OS_impl_virtual_time.now;
+    pthread_mutex_unlock(&OS_impl_virtual_time.mutex);
+
+    return OS_SUCCESS;
+} /* end OS_SetLocalTime_Impl */
+
+#else
+
+/****************************************************************************************
+                                  VIRTUAL TIME API
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTimeAdvance_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_VirtualTimeAdvance_Impl(uint64 nsecs)
+{
+    /* time follows the host clocks */
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_VirtualTimeAdvance_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTimeSetAuto_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_VirtualTimeSetAuto_Impl(bool auto_advance)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_VirtualTimeSetAuto_Impl */
+
+#endif
+
@@ -66,6 +66,133 @@
 #define OS_MAX_CONSOLES             1
 #endif
 
+/*
+ * Condition variable and barrier table sizes
+ *
+ * These object types were added after the original set, so
+ * provide reasonable defaults if osconfig.h does not specify them.
+ */
+#ifndef OS_MAX_CONDVARS
+#define OS_MAX_CONDVARS             OS_MAX_MUTEXES
+#endif
+
+#ifndef OS_MAX_BARRIERS
+#define OS_MAX_BARRIERS             OS_MAX_MUTEXES
+#endif
+
+/*
+ * Number of task-local storage keys (see OS_TaskKeyCreate).
+ * Every task record holds one value slot per key.
+ */
+#ifndef OS_MAX_TASK_KEYS
+#define OS_MAX_TASK_KEYS            8
+#endif
+
+/*
+ * Worker pool limits
+ *
+ * Each pool runs up to OS_WORKPOOL_MAX_WORKERS tasks, and each worker
+ * can hold up to OS_WORKPOOL_QUEUE_DEPTH queued jobs.  The queue depth
+ * must be a power of two.
+ */
+#ifndef OS_MAX_WORKPOOLS
+#define OS_MAX_WORKPOOLS            4
+#endif
+
+#ifndef OS_WORKPOOL_MAX_WORKERS
+#define OS_WORKPOOL_MAX_WORKERS     8
+#endif
+
+#ifndef OS_WORKPOOL_QUEUE_DEPTH
+#define OS_WORKPOOL_QUEUE_DEPTH     64
+#endif
+
+#if (OS_WORKPOOL_QUEUE_DEPTH & (OS_WORKPOOL_QUEUE_DEPTH - 1)) != 0
+#error "OS_WORKPOOL_QUEUE_DEPTH must be a power of two"
+#endif
+
+/*
+ * Lock index of the pool-wide lock passed to OS_WorkPoolLock_Impl().
+ * Indices below this select the queue lock of the corresponding worker.
+ */
+#define OS_WORKPOOL_POOL_LOCK       OS_WORKPOOL_MAX_WORKERS
+
+/*
+ * Fiber limits
+ */
+#ifndef OS_MAX_FIBERS
+#define OS_MAX_FIBERS               16
+#endif
+
+#ifndef OS_FIBER_DEFAULT_STACK_SIZE
+#define OS_FIBER_DEFAULT_STACK_SIZE 16384
+#endif
+
+/*
+ * Mutex diagnostics threshold
+ *
+ * When OS_MUTEX_DIAGNOSTICS is enabled, a mutex held for longer than this
+ * many microseconds is counted as a long hold, and a higher priority task
+ * blocked for longer than this behind a lower priority owner is reported.
+ */
+#ifndef OS_MUTEX_HOLD_WARN_USEC
+#define OS_MUTEX_HOLD_WARN_USEC     1000
+#endif
+
+/*
+ * Lock order validation
+ *
+ * When OS_MUTEX_LOCKDEP is enabled, this is the number of mutexes
+ * per task whose ordering is tracked.  Deeper nesting is still counted
+ * but not validated.
+ */
+#ifndef OS_MUTEX_LOCKDEP_MAX_HELD
+#define OS_MUTEX_LOCKDEP_MAX_HELD   8
+#endif
+
+/*
+ * CPU affinity of OSAL internal threads
+ *
+ * Bit N selects CPU N for the console output thread and the timebase
+ * helper threads, respectively.  The default of 0 leaves them free to
+ * run on any CPU.  Only applies where the OS supports CPU affinity.
+ */
+#ifndef OS_CONSOLE_CPU_MASK
+#define OS_CONSOLE_CPU_MASK         0
+#endif
+
+#ifndef OS_TIMEBASE_CPU_MASK
+#define OS_TIMEBASE_CPU_MASK        0
+#endif
+
+/*
+ * Task stack pool
+ *
+ * Where supported, the stacks of tasks created with an explicit stack
+ * size are kept when the task ends and reused by a later task of the
+ * same size class (the stack size rounded up to a power of two).
+ * OS_STACK_POOL_SIZE is the most stacks held, in use or free, and 0
+ * disables the pool.  Larger stacks than OS_STACK_POOL_MAX_STACK
+ * bytes are never pooled.
+ */
+#ifndef OS_STACK_POOL_SIZE
+#define OS_STACK_POOL_SIZE          OS_MAX_TASKS
+#endif
+
+#ifndef OS_STACK_POOL_MAX_STACK
+#define OS_STACK_POOL_MAX_STACK     (1024 * 1024)
+#endif
+
+/*
+ * Real-time options applied by OS_API_Init()
+ *
+ * A combination of the OS_RT_* flags, as for OS_API_InitRealtime().
+ * None are enabled by default.
+ */
+#ifndef OS_REALTIME_OPTIONS
+#define OS_REALTIME_OPTIONS         0
+#endif
+
 
 /*
  * Types shared between the implementations and shared code
@@ -123,6 +250,15 @@ typedef struct
    osal_task_entry delete_hook_pointer;
    void      *entry_arg;
    uint32    *stack_pointer;
+   uint32    cpu_mask;
+   uint32    period_usec;
+   OS_time_t next_release;
+   uint32    period_cycles;
+   uint32    period_overruns;
+   uint32    deadline_runtime_usec;
+   uint32    deadline_usec;
+   uint32    deadline_period_usec;
+   void      *local_values[OS_MAX_TASK_KEYS];
 }OS_task_internal_record_t;
 
 /* other objects that have only an API name and no other data */
@@ -139,6 +275,95 @@ typedef struct
    char      obj_name[OS_MAX_API_NAME];
 } OS_apiname_internal_record_t;
 
+/* mutex objects */
+typedef struct
+{
+   char      obj_name[OS_MAX_API_NAME];
+#ifdef OS_MUTEX_DIAGNOSTICS
+   uint32    owner;
+   uint32    nest_depth;
+   OS_time_t acquire_time;
+   uint32    take_count;
+   uint32    contention_count;
+   uint32    inversion_count;
+   uint32    long_hold_count;
+   uint32    last_hold_usec;
+   uint32    max_hold_usec;
+   uint32    max_wait_usec;
+#endif
+#ifdef OS_MUTEX_LOCKDEP
+   uint32    lock_order_violations;
+#endif
+} OS_mutex_internal_record_t;
+
+/* barrier objects */
+typedef struct
+{
+   char      obj_name[OS_MAX_API_NAME];
+   uint32    count;
+} OS_barrier_internal_record_t;
+
+/* worker pool objects */
+typedef struct
+{
+   OS_WorkFunc_t func;
+   void          *arg;
+} OS_workpool_job_t;
+
+typedef struct
+{
+   uint32            task_id;
+   uint32            head;          /* next job to steal (oldest) */
+   uint32            tail;          /* next free slot; owner pops from tail - 1 */
+   uint32            submitted;
+   uint32            completed;     /* jobs taken from this queue that have finished */
+   uint32            stolen;        /* jobs taken from this queue by another worker */
+   bool              exited;
+   OS_workpool_job_t job[OS_WORKPOOL_QUEUE_DEPTH];
+} OS_workpool_worker_t;
+
+typedef struct
+{
+   char                 obj_name[OS_MAX_API_NAME];
+   uint32               num_workers;
+   uint32               next_worker;
+   uint32               idle_waiters;
+   bool                 shutdown;
+   OS_workpool_worker_t worker[OS_WORKPOOL_MAX_WORKERS];
+} OS_workpool_internal_record_t;
+
+/*
+ * fiber objects
+ *
+ * Fibers are not in the common object table, as they belong to the task
+ * that runs them.  active_id and creator take the place of the common record.
+ */
+typedef struct
+{
+   uint32         active_id;     /* fiber ID, 0 if the entry is free */
+   uint32         creator;
+   char           obj_name[OS_MAX_API_NAME];
+   OS_FiberFunc_t entry;
+   void           *entry_arg;
+   uint32         stack_size;
+   uint32         host_task_id;
+   uint32         state;
+   uint32         next;          /* local id + 1 of the next fiber in the same list, 0 at the end */
+   uint64         wake_usec;     /* monotonic time to resume a waiting fiber, 0 for no limit */
+   uint32         wait_stream;   /* stream local id, while waiting on a stream */
+   uint32         wait_events;   /* OS_STREAM_STATE_READABLE and/or OS_STREAM_STATE_WRITABLE */
+   bool           retry;         /* resumed only to retry a poll */
+   bool           polling;       /* counted in the poll waiters of the task */
+   uint32         switches;
+} OS_fiber_internal_record_t;
+
+/* a blocking call made from a fiber, see OS_FiberWaitStart() */
+typedef struct
+{
+   uint32         fiber_id;
+   uint64         deadline_usec; /* 0 for no timeout */
+} OS_fiber_wait_t;
+
 /* directory objects */
 typedef struct
 {
@@ -156,28 +381,74 @@ typedef struct
    uint16    stream_state;
 } OS_stream_internal_record_t;
 
+/*
+ * The armed timers of a timebase are kept on a hierarchical timing wheel,
+ * keyed by their expiry time in nanoseconds.  A timer is on the level
+ * of the highest bit group in which its expiry differs from the time of
+ * the wheel, in the slot given by the expiry bits of that group, so a tick
+ * only visits the slots it passes and the timers in them.  The bucket of a
+ * timer is its level times OS_TIMER_WHEEL_SLOTS plus its slot, or one of
+ * the overflow and expired buckets.
+ */
+#define OS_TIMER_WHEEL_BITS         6
+#define OS_TIMER_WHEEL_SLOTS        (1 << OS_TIMER_WHEEL_BITS)
+#define OS_TIMER_WHEEL_LEVELS       6
+#define OS_TIMER_WHEEL_OVERFLOW     (OS_TIMER_WHEEL_LEVELS * OS_TIMER_WHEEL_SLOTS)  /* beyond the top level */
+#define OS_TIMER_WHEEL_EXPIRED      (OS_TIMER_WHEEL_OVERFLOW + 1)                   /* due on the next tick */
+#define OS_TIMER_WHEEL_BUCKETS      (OS_TIMER_WHEEL_EXPIRED + 1)
+#define OS_TIMER_WHEEL_IDLE         0xFFFFFFFFFFFFFFFFULL                           /* no timer armed */
+
+/*
+ * All times on a timebase are kept in nanoseconds.  The units of an external
+ * sync function are taken as microseconds, like those of the 32-bit timer API.
+ * Times are limited so that sums of them cannot overflow a signed 64-bit value.
+ */
+#define OS_TIMEBASE_NS_LIMIT        0x4000000000000000ULL
+
+/*
+ * The wait function of a timebase that the implementation simulates.
+ * Returns the elapsed time in nanoseconds, like the sync function does
+ * in the units of the timebase.
+ */
+typedef uint64 (*OS_TimeBaseWait_t)(uint32 timer_id);
+
 typedef struct
 {
     char                timebase_name[OS_MAX_API_NAME];
     OS_TimerSync_t      external_sync;
+    OS_TimeBaseWait_t   simulated_wait;                             /* used instead of external_sync if set */
     uint32              accuracy_usec;
-    uint32              first_cb;
-    uint32              freerun_time;
-    uint32              nominal_start_time;
-    uint32              nominal_interval_time;
+    uint64              freerun_time;
+    uint64              nominal_start_time;
+    uint64              nominal_interval_time;
+    bool                tickless;                                   /* only tick when a timer is due */
+    OS_timer_latency_t  latency;                                    /* of the callbacks of all timers */
+    uint64              latency_total;                              /* sum of the lateness, in usec */
+    uint64              wheel_time;                                 /* time of the last tick */
+    uint64              wheel_occupied[OS_TIMER_WHEEL_LEVELS];      /* bit set for each non-empty slot */
+    uint32              wheel_bucket[OS_TIMER_WHEEL_BUCKETS];       /* local id + 1 of the first timer */
 } OS_timebase_internal_record_t;
 
 #define TIMECB_FLAG_DEDICATED_TIMEBASE      0x1
+#define TIMECB_FLAG_DISPATCH                0x2
 typedef struct
 {
     char                timer_name[OS_MAX_API_NAME];
     uint32              flags;
     uint32              timebase_ref;
-    uint32              prev_ref;
-    uint32              next_ref;
+    uint32              wheel_bucket;       /* bucket + 1, or 0 if the timer is not armed */
+    uint32              wheel_prev;         /* local id + 1 of the neighbours in the bucket */
+    uint32              wheel_next;
     uint32              backlog_resets;
-    int32               wait_time;
-    int32               interval_time;
+    uint32              dispatch_pool;      /* worker pool that runs the callback */
+    bool                dispatch_busy;      /* callback submitted and not yet finished */
+    uint32              dispatch_task;      /* worker task calling the callback, or 0 */
+    uint32              overruns;           /* expirations dropped while dispatch_busy */
+    uint64              dispatch_nominal;   /* nominal expiry of the pending callback, in usec */
+    OS_timer_latency_t  latency;
+    uint64              latency_total;      /* sum of the lateness, in usec */
+    uint64              expiry_time;        /* in the units of the wheel_time of the timebase */
+    int64               interval_time;
     OS_ArgCallback_t    callback_ptr;
     void                *callback_arg;
 } OS_timecb_internal_record_t;
@@ -306,6 +577,14 @@ typedef struct
    int32             MicroSecPerTick;
    int32             TicksPerSecond;
 
+   /*
+    * Real-time options given at initialization, and whether
+    * the process memory was actually locked
+    */
+   uint32            RealtimeOptions;
+   bool              MemoryLocked;
+   bool              HeapLockedDown;
+
 #ifdef OS_DEBUG_PRINTF
    uint8             DebugLevel;
 #endif
@@ -333,6 +612,9 @@ extern OS_common_record_t * const OS_global_timecb_table;
 extern OS_common_record_t * const OS_global_module_table;
 extern OS_common_record_t * const OS_global_filesys_table;
 extern OS_common_record_t * const OS_global_console_table;
+extern OS_common_record_t * const OS_global_condvar_table;
+extern OS_common_record_t * const OS_global_barrier_table;
+extern OS_common_record_t * const OS_global_workpool_table;
 
 /*
  * These record types have extra information with each entry.  These tables are used
@@ -342,7 +624,11 @@ extern OS_task_internal_record_t           OS_task_table[OS_MAX_TASKS];
 extern OS_queue_internal_record_t          OS_queue_table[OS_MAX_QUEUES];
 extern OS_apiname_internal_record_t        OS_bin_sem_table[OS_MAX_BIN_SEMAPHORES];
 extern OS_apiname_internal_record_t        OS_count_sem_table[OS_MAX_COUNT_SEMAPHORES];
-extern OS_apiname_internal_record_t        OS_mutex_table[OS_MAX_MUTEXES];
+extern OS_mutex_internal_record_t          OS_mutex_table[OS_MAX_MUTEXES];
+extern OS_apiname_internal_record_t        OS_condvar_table[OS_MAX_CONDVARS];
+extern OS_barrier_internal_record_t        OS_barrier_table[OS_MAX_BARRIERS];
+extern OS_workpool_internal_record_t       OS_workpool_table[OS_MAX_WORKPOOLS];
+extern OS_fiber_internal_record_t          OS_fiber_table[OS_MAX_FIBERS];
 extern OS_stream_internal_record_t         OS_stream_table[OS_MAX_NUM_OPEN_FILES];
 extern OS_dir_internal_record_t            OS_dir_table[OS_MAX_NUM_OPEN_DIRS];
 extern OS_timebase_internal_record_t       OS_timebase_table[OS_MAX_TIMEBASES];
@@ -481,6 +767,52 @@ int32 OS_CountSemAPI_Init            (void);
 ---------------------------------------------------------------------------------------*/
 int32 OS_MutexAPI_Init               (void);
 
+/*---------------------------------------------------------------------------------------
+   Name: OS_CondVarAPI_Init
+
+   Purpose: Initialize the OS-independent layer for condition variable objects
+
+   returns: OS_SUCCESS on success, or relevant error code
+---------------------------------------------------------------------------------------*/
+int32 OS_CondVarAPI_Init             (void);
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_BarrierAPI_Init
+
+   Purpose: Initialize the OS-independent layer for barrier objects
+
+   returns: OS_SUCCESS on success, or relevant error code
+---------------------------------------------------------------------------------------*/
+int32 OS_BarrierAPI_Init             (void);
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_WorkPoolAPI_Init
+
+   Purpose: Initialize the OS-independent layer for worker pool objects
+
+   returns: OS_SUCCESS on success, or relevant error code
+---------------------------------------------------------------------------------------*/
+int32 OS_WorkPoolAPI_Init            (void);
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_FiberAPI_Init
+
+   Purpose: Initialize the OS-independent layer for fiber objects
+
+   returns: OS_SUCCESS on success, or relevant error code
+---------------------------------------------------------------------------------------*/
+int32 OS_FiberAPI_Init               (void);
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_FiberDeleteAll
+
+   Purpose: Delete the fibers whose task has been deleted, as part of
+            OS_DeleteAllObjects().  Fibers are not in the common object table.
+
+   returns: None
+---------------------------------------------------------------------------------------*/
+void  OS_FiberDeleteAll              (void);
+
 /*---------------------------------------------------------------------------------------
    Name: OS_ModuleAPI_Init
 
@@ -606,6 +938,19 @@ void  OS_IdleLoop_Impl               (void);
  ------------------------------------------------------------------*/
 void  OS_ApplicationShutdown_Impl    (void);
 
+/*----------------------------------------------------------------
+
+   Function: OS_API_LockMemory_Impl
+
+    Purpose: Lock all current and future memory of the process into RAM
+
+   Called during OS_API_InitRealtime() when OS_RT_LOCK_MEMORY is
+   requested, after all object tables have been initialized.
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_API_LockMemory_Impl         (void);
+
 
 
 /****************************************************************************************
@@ -830,6 +1175,26 @@ void   OS_TaskExit_Impl              (void);
  ------------------------------------------------------------------*/
 int32  OS_TaskDelay_Impl             (uint32 millisecond);
 
+/*----------------------------------------------------------------
+   Function: OS_TaskDelayMicros_Impl
+
+    Purpose: Blocks the calling task for the specified number of microseconds
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32  OS_TaskDelayMicros_Impl       (uint32 microsecond);
+
+/*----------------------------------------------------------------
+   Function: OS_TaskDelayUntil_Impl
+
+    Purpose: Blocks the calling task until the given absolute time
+             on the clock used by OS_GetMonotonicTime_Impl.  Returns
+             immediately if that time has already passed.
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32  OS_TaskDelayUntil_Impl        (const OS_time_t *wake_time);
+
 /*----------------------------------------------------------------
    Function: OS_TaskSetPriority_Impl
   
@@ -839,6 +1204,28 @@ int32  OS_TaskDelay_Impl             (uint32 millisecond);
  ------------------------------------------------------------------*/
 int32  OS_TaskSetPriority_Impl       (uint32 task_id, uint32 new_priority);
 
+/*----------------------------------------------------------------
+   Function: OS_TaskSetAffinity_Impl
+
+    Purpose: Restricts the task to the CPUs selected in cpu_mask
+             (bit N = CPU N).  A mask of 0 allows any CPU.
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32  OS_TaskSetAffinity_Impl       (uint32 task_id, uint32 cpu_mask);
+
+/*----------------------------------------------------------------
+   Function: OS_TaskSetDeadline_Impl
+
+    Purpose: Places the task under deadline scheduling with the given
+             runtime budget, deadline and period (all nonzero and
+             consistent), or returns it to fixed priority scheduling
+             if runtime_usec is 0.
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32  OS_TaskSetDeadline_Impl       (uint32 task_id, uint32 runtime_usec, uint32 deadline_usec, uint32 period_usec);
+
 /*----------------------------------------------------------------
    Function: OS_TaskGetId_Impl
   
@@ -848,6 +1235,18 @@ int32  OS_TaskSetPriority_Impl       (uint32 task_id, uint32 new_priority);
  ------------------------------------------------------------------*/
 uint32 OS_TaskGetId_Impl             (void);
 
+/*----------------------------------------------------------------
+   Function: OS_TaskGetSelf_Impl
+  
+    Purpose: Obtain the OSAL task ID of the caller together with its
+             index in the task table, so the caller can check the
+             table entry directly without an ID lookup.  The index is
+             only valid when the returned ID is nonzero.
+  
+    Returns: The OSAL ID of the calling task, or zero if not registered
+ ------------------------------------------------------------------*/
+uint32 OS_TaskGetSelf_Impl           (uint32 *local_id);
+
 /*----------------------------------------------------------------
    Function: OS_TaskGetInfo_Impl
   
@@ -857,6 +1256,38 @@ uint32 OS_TaskGetId_Impl             (void);
  ------------------------------------------------------------------*/
 int32  OS_TaskGetInfo_Impl           (uint32 task_id, OS_task_prop_t *task_prop);
 
+/*----------------------------------------------------------------
+   Function: OS_TaskGetStats_Impl
+  
+    Purpose: Obtain the CPU time of a task, and the OS thread ID to pass
+             to OS_TaskGetThreadStats_Impl() for the remaining statistics
+             (0 if there is none).  The name and task_id fields are filled
+             in by the caller, which holds the task table lock.
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32  OS_TaskGetStats_Impl          (uint32 task_id, OS_task_stats_t *task_stats, uint32 *os_thread_id);
+
+/*----------------------------------------------------------------
+   Function: OS_TaskGetThreadStats_Impl
+  
+    Purpose: Fill the context switch counts and last CPU of a task from
+             the OS thread ID obtained by OS_TaskGetStats_Impl().  This
+             may be slow, so it is called without the task table lock.
+             Fields that cannot be read are left unchanged.
+ ------------------------------------------------------------------*/
+void   OS_TaskGetThreadStats_Impl    (uint32 os_thread_id, OS_task_stats_t *task_stats);
+
+/*----------------------------------------------------------------
+   Function: OS_TaskGetStackPoolStats_Impl
+
+    Purpose: Obtain statistics of the task stack pool.  The
+             structure is zeroed by the caller.
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32  OS_TaskGetStackPoolStats_Impl (OS_stack_pool_stats_t *stats);
+
 /*----------------------------------------------------------------
   
    Function: OS_TaskRegister_Impl
@@ -908,6 +1339,16 @@ int32 OS_QueueDelete_Impl           (uint32 queue_id);
  ------------------------------------------------------------------*/
 int32 OS_QueueGet_Impl              (uint32 queue_id, void *data, uint32 size, uint32 *size_copied, int32 timeout);
 
+/*----------------------------------------------------------------
+   Function: OS_QueueGetMicros_Impl
+
+    Purpose: Same as OS_QueueGet_Impl() but a timeout other than
+             OS_PEND or OS_CHECK is in microseconds
+
+    Returns: Same as OS_QueueGet_Impl()
+ ------------------------------------------------------------------*/
+int32 OS_QueueGetMicros_Impl        (uint32 queue_id, void *data, uint32 size, uint32 *size_copied, int32 timeout_usec);
+
 /*----------------------------------------------------------------
    Function: OS_QueuePut_Impl
   
@@ -985,6 +1426,16 @@ int32 OS_BinSemTake_Impl            (uint32 sem_id);
  ------------------------------------------------------------------*/
 int32 OS_BinSemTimedWait_Impl       (uint32 sem_id, uint32 msecs);
 
+/*----------------------------------------------------------------
+   Function: OS_BinSemTimedWaitMicros_Impl
+
+    Purpose: Acquire the semaphore, with a time limit in microseconds
+
+    Returns: OS_SUCCESS on success, or relevant error code
+             OS_SEM_TIMEOUT must be returned if the time limit was reached
+ ------------------------------------------------------------------*/
+int32 OS_BinSemTimedWaitMicros_Impl (uint32 sem_id, uint32 usecs);
+
 /*----------------------------------------------------------------
    Function: OS_BinSemDelete_Impl
   
@@ -1044,6 +1495,16 @@ int32 OS_CountSemTake_Impl            (uint32 sem_id);
              OS_SEM_TIMEOUT must be returned if the time limit was reached
  ------------------------------------------------------------------*/
 int32 OS_CountSemTimedWait_Impl       (uint32 sem_id, uint32 msecs);
+
+/*----------------------------------------------------------------
+   Function: OS_CountSemTimedWaitMicros_Impl
+
+    Purpose: Decrement the semaphore value, with a time limit in microseconds
+
+    Returns: OS_SUCCESS on success, or relevant error code
+             OS_SEM_TIMEOUT must be returned if the time limit was reached
+ ------------------------------------------------------------------*/
+int32 OS_CountSemTimedWaitMicros_Impl (uint32 sem_id, uint32 usecs);
                         
 /*----------------------------------------------------------------
    Function: OS_CountSemDelete_Impl
@@ -1112,6 +1573,384 @@ int32 OS_MutSemDelete_Impl           (uint32 sem_id);
  ------------------------------------------------------------------*/
 int32 OS_MutSemGetInfo_Impl          (uint32 sem_id, OS_mut_sem_prop_t *mut_prop);
 
+/*
+ * Condition variables
+ */
+
+/*----------------------------------------------------------------
+   Function: OS_CondVarCreate_Impl
+  
+    Purpose: Prepare/allocate OS resources for a condition variable
+             and its associated mutex
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_CondVarCreate_Impl          (uint32 var_id, uint32 options);
+
+/*----------------------------------------------------------------
+   Function: OS_CondVarLock_Impl
+  
+    Purpose: Acquire the mutex associated with the condition variable
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_CondVarLock_Impl            (uint32 var_id);
+
+/*----------------------------------------------------------------
+   Function: OS_CondVarUnlock_Impl
+  
+    Purpose: Release the mutex associated with the condition variable
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_CondVarUnlock_Impl          (uint32 var_id);
+
+/*----------------------------------------------------------------
+   Function: OS_CondVarSignal_Impl
+  
+    Purpose: Wake up one waiter on the condition variable
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_CondVarSignal_Impl          (uint32 var_id);
+
+/*----------------------------------------------------------------
+   Function: OS_CondVarBroadcast_Impl
+  
+    Purpose: Wake up all waiters on the condition variable
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_CondVarBroadcast_Impl       (uint32 var_id);
+
+/*----------------------------------------------------------------
+   Function: OS_CondVarWait_Impl
+  
+    Purpose: Wait on the condition variable, with the associated mutex held
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_CondVarWait_Impl            (uint32 var_id);
+
+/*----------------------------------------------------------------
+   Function: OS_CondVarTimedWait_Impl
+  
+    Purpose: Wait on the condition variable, with the associated mutex held,
+             for at most the given number of milliseconds
+  
+    Returns: OS_SUCCESS on success, OS_SEM_TIMEOUT on timeout,
+             or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_CondVarTimedWait_Impl       (uint32 var_id, uint32 msecs);
+
+/*----------------------------------------------------------------
+   Function: OS_CondVarDelete_Impl
+  
+    Purpose: Free the OS resources associated with a condition variable
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_CondVarDelete_Impl          (uint32 var_id);
+
+/*----------------------------------------------------------------
+   Function: OS_CondVarGetInfo_Impl
+  
+    Purpose: Obtain OS-specific information about the condition variable
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_CondVarGetInfo_Impl         (uint32 var_id, OS_condvar_prop_t *condvar_prop);
+
+/*
+ * Barriers
+ */
+
+/*----------------------------------------------------------------
+   Function: OS_BarrierCreate_Impl
+  
+    Purpose: Prepare/allocate OS resources for a barrier object
+             The participant count is read from OS_barrier_table
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_BarrierCreate_Impl          (uint32 barrier_id, uint32 options);
+
+/*----------------------------------------------------------------
+   Function: OS_BarrierWait_Impl
+  
+    Purpose: Block until the required number of tasks have arrived
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_BarrierWait_Impl            (uint32 barrier_id);
+
+/*----------------------------------------------------------------
+   Function: OS_BarrierDelete_Impl
+  
+    Purpose: Free the OS resources associated with a barrier object
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_BarrierDelete_Impl          (uint32 barrier_id);
+
+/*----------------------------------------------------------------
+   Function: OS_BarrierGetInfo_Impl
+  
+    Purpose: Obtain OS-specific information about the barrier object
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_BarrierGetInfo_Impl         (uint32 barrier_id, OS_barrier_prop_t *barrier_prop);
+
+/*
+ * Worker pools
+ *
+ * The job queues and scheduling are handled in the shared layer; the
+ * implementation only provides the locks and the wakeup primitives.
+ */
+
+/*----------------------------------------------------------------
+   Function: OS_WorkPoolCreate_Impl
+  
+    Purpose: Prepare/allocate OS resources for a worker pool: one lock per
+             worker queue plus the pool lock, the work token semaphore
+             and the idle notification used with the pool lock
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_WorkPoolCreate_Impl         (uint32 pool_id);
+
+/*----------------------------------------------------------------
+   Function: OS_WorkPoolDelete_Impl
+  
+    Purpose: Free the OS resources associated with a worker pool
+             All of the workers must have exited before this is called
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_WorkPoolDelete_Impl         (uint32 pool_id);
+
+/*----------------------------------------------------------------
+   Function: OS_WorkPoolLock_Impl
+  
+    Purpose: Acquire a pool lock.  lock_idx selects the queue lock of a
+             worker, or OS_WORKPOOL_POOL_LOCK for the pool lock.
+             The pool lock is always taken before any queue lock.
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_WorkPoolLock_Impl           (uint32 pool_id, uint32 lock_idx);
+
+/*----------------------------------------------------------------
+   Function: OS_WorkPoolUnlock_Impl
+  
+    Purpose: Release a lock acquired by OS_WorkPoolLock_Impl()
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_WorkPoolUnlock_Impl         (uint32 pool_id, uint32 lock_idx);
+
+/*----------------------------------------------------------------
+   Function: OS_WorkPoolPost_Impl
+  
+    Purpose: Make one work token available, waking one idle worker
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_WorkPoolPost_Impl           (uint32 pool_id);
+
+/*----------------------------------------------------------------
+   Function: OS_WorkPoolPend_Impl
+  
+    Purpose: Block until a work token is available and consume it
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_WorkPoolPend_Impl           (uint32 pool_id);
+
+/*----------------------------------------------------------------
+   Function: OS_WorkPoolIdleWait_Impl
+  
+    Purpose: Wait for an idle notification.  Must be called with the
+             pool lock held; the lock is released while waiting and
+             re-acquired before returning.  msecs may be OS_PEND.
+  
+    Returns: OS_SUCCESS on notification, OS_ERROR_TIMEOUT on timeout,
+             or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_WorkPoolIdleWait_Impl       (uint32 pool_id, int32 msecs);
+
+/*----------------------------------------------------------------
+   Function: OS_WorkPoolIdleNotify_Impl
+  
+    Purpose: Wake all tasks waiting in OS_WorkPoolIdleWait_Impl()
+             Must be called with the pool lock held
+  
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_WorkPoolIdleNotify_Impl     (uint32 pool_id);
+
+/*
+ * Fibers
+ *
+ * Scheduling is handled in the shared layer; the implementation only
+ * provides the fiber stacks and the switch between a task and its fibers.
+ */
+
+/*----------------------------------------------------------------
+   Function: OS_FiberEntryPoint
+
+    Purpose: Entry point for all fibers
+
+   Implemented in the shared layer.  The implementation calls this on
+   the fiber stack the first time the fiber is switched in.  It calls
+   the user entry point and then switches out for the last time, so it
+   never returns.
+ ------------------------------------------------------------------*/
+void  OS_FiberEntryPoint              (uint32 fiber_id);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberCreate_Impl
+
+    Purpose: Allocate the stack of a fiber and prepare its context so
+             that it starts in OS_FiberEntryPoint() when switched in
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_FiberCreate_Impl             (uint32 fiber_id, uint32 flags);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberDelete_Impl
+
+    Purpose: Free the stack of a fiber.  The fiber is not running.
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_FiberDelete_Impl             (uint32 fiber_id);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberSwitchIn_Impl
+
+    Purpose: Switch from the calling task to the fiber, returning when
+             the fiber calls OS_FiberSwitchOut_Impl()
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_FiberSwitchIn_Impl           (uint32 fiber_id);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberSwitchOut_Impl
+
+    Purpose: Switch from the calling fiber back to the task that switched
+             it in, returning when the fiber is next switched in
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_FiberSwitchOut_Impl          (uint32 fiber_id);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberTaskInit_Impl
+
+    Purpose: Prepare a task to run fibers, before it creates its first
+             fiber.  task_id is the local id of the task.
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_FiberTaskInit_Impl           (uint32 task_id);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberNotifyEnable_Impl
+
+    Purpose: Enable or disable notification of the task whenever
+             OS_FiberNotify_Impl() is called.  It is enabled while the
+             task has fibers waiting on a semaphore or queue.
+
+    Returns: None
+ ------------------------------------------------------------------*/
+void  OS_FiberNotifyEnable_Impl       (uint32 task_id, bool enable);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberNotify_Impl
+
+    Purpose: Wake each task that has notification enabled from
+             OS_FiberIdle_Impl(), or make its next call return at once
+
+    Returns: None
+ ------------------------------------------------------------------*/
+void  OS_FiberNotify_Impl             (void);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberIdle_Impl
+
+    Purpose: Block a task whose fibers are all waiting, until one of the
+             streams in the sets is ready, the task is notified, or the
+             timeout expires.  timeout_usec may be negative to wait
+             without a timeout.  On OS_SUCCESS the sets are updated as
+             for OS_SelectMultiple_Impl().
+
+    Returns: OS_SUCCESS if a stream is ready or the task was notified,
+             OS_ERROR_TIMEOUT if the timeout expired, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_FiberIdle_Impl               (uint32 task_id, OS_FdSet *ReadSet, OS_FdSet *WriteSet, int64 timeout_usec);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberNotify
+
+    Purpose: Called after a semaphore is given or a message is queued, to
+             wake the tasks whose fibers wait on a semaphore or queue so
+             that they retry.  Implemented in the shared layer.
+
+    Returns: None
+ ------------------------------------------------------------------*/
+void  OS_FiberNotify                  (void);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberWaitStart
+
+    Purpose: Called by a blocking OSAL call before it blocks.  If the
+             caller is a fiber it must not block the task; instead it
+             tries the non-blocking form of the operation and calls
+             OS_FiberWaitRetry() each time that would have blocked.
+             timeout_usec limits the wait, negative waits forever.
+
+    Returns: true if the caller is a fiber, false otherwise
+ ------------------------------------------------------------------*/
+bool  OS_FiberWaitStart               (OS_fiber_wait_t *wait, int64 timeout_usec);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberWaitRetry
+
+    Purpose: Let the other fibers run before the next attempt of a wait
+             started by OS_FiberWaitStart().  The fiber is resumed once
+             another fiber of the task has run or OS_FiberNotify() has
+             been called, or when the timeout expires.
+
+    Returns: true to try again, false if the timeout has expired
+ ------------------------------------------------------------------*/
+bool  OS_FiberWaitRetry               (OS_fiber_wait_t *wait);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberSleep
+
+    Purpose: If the caller is a fiber, let the other fibers run for at
+             least the given time
+
+    Returns: true if the caller is a fiber, false otherwise
+ ------------------------------------------------------------------*/
+bool  OS_FiberSleep                   (uint64 usec);
+
+/*----------------------------------------------------------------
+   Function: OS_FiberWaitStream
+
+    Purpose: If the caller is a fiber, let the other fibers run until the
+             stream has one of the OS_STREAM_STATE_READABLE/WRITABLE events
+             or the timeout expires.  msecs may be OS_PEND.  The caller
+             then completes the operation with a zero timeout.
+
+    Returns: true if the caller is a fiber, false otherwise
+ ------------------------------------------------------------------*/
+bool  OS_FiberWaitStream              (uint32 stream_id, uint32 events, int32 msecs);
+
 
 /****************************************************************************************
                  CLOCK / TIME API LOW-LEVEL IMPLEMENTATION FUNCTIONS
@@ -1136,10 +1975,11 @@ int32 OS_TimeBaseCreate_Impl        (uint32 timebase_id);
    Function: OS_TimeBaseSet_Impl
   
     Purpose: Configure the OS resources to provide a timer tick
+             The start and interval times are in nanoseconds.
   
     Returns: OS_SUCCESS on success, or relevant error code
  ------------------------------------------------------------------*/
-int32 OS_TimeBaseSet_Impl           (uint32 timebase_id, int32 start_time, int32 interval_time);
+int32 OS_TimeBaseSet_Impl           (uint32 timebase_id, uint64 start_time, uint64 interval_time);
 
 /*----------------------------------------------------------------
    Function: OS_TimeBaseDelete_Impl
@@ -1182,6 +2022,54 @@ void  OS_TimeBaseUnlock_Impl        (uint32 timebase_id);
  ------------------------------------------------------------------*/
 int32 OS_TimeBaseGetInfo_Impl       (uint32 timer_id, OS_timebase_prop_t *timer_prop);
 
+/*----------------------------------------------------------------
+   Function: OS_TimeBaseSetTickless_Impl
+
+    Purpose: Switch a simulated time base between ticking on every interval
+             and ticking only on the intervals where a timer is due.
+             Called with the time base lock held.
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_TimeBaseSetTickless_Impl   (uint32 timer_id, bool tickless);
+
+/*----------------------------------------------------------------
+   Function: OS_TimeBaseNextDue_Impl
+
+    Purpose: Update the time base after its wheel was advanced by tick_time,
+             which is zero if the wheel was not advanced.  Then program a
+             tickless time base to tick next on the first interval at or after
+             wait_time from the time of its wheel, unless it is already
+             programmed to tick earlier.  OS_TIMER_WHEEL_IDLE means that no
+             tick is needed.
+             Called with the time base lock held.
+ ------------------------------------------------------------------*/
+void  OS_TimeBaseNextDue_Impl       (uint32 timer_id, uint64 tick_time, uint64 wait_time);
+
+/*----------------------------------------------------------------
+   Function: OS_TimeBaseTickLateness_Impl
+
+    Purpose: Get how long ago the end of the given tick of a time base was
+             nominally due, for a tick that is being processed.  This is
+             only known for a time base that the implementation simulates.
+             Called with the time base lock held.
+
+    Returns: OS_SUCCESS, or OS_ERR_NOT_IMPLEMENTED if the time is not known
+ ------------------------------------------------------------------*/
+int32 OS_TimeBaseTickLateness_Impl  (uint32 timer_id, uint64 tick_time, uint32 *lateness_usec);
+
+/*----------------------------------------------------------------
+   Function: OS_TimeBaseSkippedTime_Impl
+
+    Purpose: Get the time of the whole intervals that a tickless time base
+             has skipped since the last tick that advanced its wheel, which
+             the next tick will report.
+             Called with the time base lock held.
+
+    Returns: The skipped time in nanoseconds
+ ------------------------------------------------------------------*/
+uint64 OS_TimeBaseSkippedTime_Impl  (uint32 timer_id);
+
 /*----------------------------------------------------------------
    Function: OS_TimeBase_CallbackThread
 
@@ -1190,10 +2078,86 @@ int32 OS_TimeBaseGetInfo_Impl       (uint32 timer_id, OS_timebase_prop_t *timer_
  ------------------------------------------------------------------*/
 void  OS_TimeBase_CallbackThread    (uint32 timebase_id);
 
+/*----------------------------------------------------------------
+   Function: OS_TimeBase_ProcessTick
+
+    Purpose: Account for the given elapsed time on a time base and make
+             the application callbacks for any timers that became due.
+             Called by the time base helper thread after each tick, or by
+             an implementation that services several time bases from one thread.
+
+    Returns: OS_SUCCESS, or OS_ERR_INVALID_ID if the time base was deleted
+ ------------------------------------------------------------------*/
+int32 OS_TimeBase_ProcessTick       (uint32 timebase_id, uint32 local_id, uint64 tick_time);
+
+/*----------------------------------------------------------------
+   Function: OS_TimerWheelArm
+
+    Purpose: Put a timer on the timing wheel of its timebase, to expire
+             at its expiry_time.  A timer that is already armed is moved.
+             Must be called with the timebase lock held.
+ ------------------------------------------------------------------*/
+void  OS_TimerWheelArm              (uint32 timebase_id, uint32 timer_id);
+
+/*----------------------------------------------------------------
+   Function: OS_TimerWheelDisarm
+
+    Purpose: Take a timer off the timing wheel of its timebase, if it is on it.
+             Must be called with the timebase lock held.
+ ------------------------------------------------------------------*/
+void  OS_TimerWheelDisarm           (uint32 timebase_id, uint32 timer_id);
+
+/*----------------------------------------------------------------
+   Function: OS_TimerWheelNextDue
+
+    Purpose: Get the time from the last tick of the timebase until its wheel
+             next has to be advanced, which is no later than the expiry of
+             the earliest timer on it.
+             Must be called with the timebase lock held.
+
+    Returns: The time in nanoseconds, or OS_TIMER_WHEEL_IDLE if no timer is armed
+ ------------------------------------------------------------------*/
+uint64 OS_TimerWheelNextDue         (uint32 timebase_id);
+
+/*----------------------------------------------------------------
+   Function: OS_TimerDispatch
+
+    Purpose: Submit the callback of an expired timer to its worker pool,
+             or count an overrun if the previous one has not finished.
+             The nominal expiry is in usec of the monotonic clock.
+             Must be called with the timebase lock held.
+ ------------------------------------------------------------------*/
+void  OS_TimerDispatch              (uint32 timer_id, uint64 nominal_usec);
+
+/*----------------------------------------------------------------
+   Function: OS_TimerLatencyNow
+
+    Purpose: Read the monotonic clock used for the lateness of timer callbacks
+
+    Returns: The time in microseconds
+ ------------------------------------------------------------------*/
+uint64 OS_TimerLatencyNow           (void);
+
+/*----------------------------------------------------------------
+   Function: OS_TimerLatencyRecord
+
+    Purpose: Account the lateness of a timer callback that was entered at
+             entry_usec for an expiry nominally due at nominal_usec, both
+             from OS_TimerLatencyNow(), on the timer and on its timebase.
+             Must be called with the timebase lock held.
+ ------------------------------------------------------------------*/
+void  OS_TimerLatencyRecord         (uint32 timebase_id, uint32 timer_id, uint64 nominal_usec, uint64 entry_usec);
+
 /*
  * Clock API low-level handlers
  * These simply get/set the kernel RTC (if it has one)
  */
+
+/*
+ * Highest high resolution tick rate, in ticks per second, for which the
+ * conversions to and from nanoseconds cannot overflow a 64-bit value
+ */
+#define OS_HIGHRES_RATE_LIMIT       10000000000ULL
                         
 /*----------------------------------------------------------------
    Function: OS_GetLocalTime_Impl
@@ -1204,6 +2168,36 @@ void  OS_TimeBase_CallbackThread    (uint32 timebase_id);
  ------------------------------------------------------------------*/
 int32 OS_GetLocalTime_Impl(OS_time_t *time_struct);
 
+/*----------------------------------------------------------------
+   Function: OS_GetMonotonicTime_Impl
+
+    Purpose: Get the time from a clock that is not affected by
+             changes to the RTC, for measuring intervals
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_GetMonotonicTime_Impl(OS_time_t *time_struct);
+
+/*----------------------------------------------------------------
+   Function: OS_GetHighResTicks_Impl
+
+    Purpose: Read the high resolution tick counter, which counts at
+             the rate given by OS_GetHighResTickRate_Impl
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_GetHighResTicks_Impl(uint64 *ticks);
+
+/*----------------------------------------------------------------
+   Function: OS_GetHighResTickRate_Impl
+
+    Purpose: Get the number of high resolution ticks per second.
+             This must not be more than OS_HIGHRES_RATE_LIMIT.
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_GetHighResTickRate_Impl(uint64 *ticks_per_sec);
+
 /*----------------------------------------------------------------
    Function: OS_SetLocalTime_Impl
   
@@ -1213,6 +2207,28 @@ int32 OS_GetLocalTime_Impl(OS_time_t *time_struct);
  ------------------------------------------------------------------*/
 int32 OS_SetLocalTime_Impl(const OS_time_t *time_struct);
 
+/*----------------------------------------------------------------
+   Function: OS_VirtualTimeAdvance_Impl
+
+    Purpose: Advance the virtual clock by the given interval in
+             nanoseconds, returning once it has been reached
+
+    Returns: OS_SUCCESS on success, or relevant error code
+             OS_ERR_NOT_IMPLEMENTED if there is no virtual clock
+ ------------------------------------------------------------------*/
+int32 OS_VirtualTimeAdvance_Impl(uint64 nsecs);
+
+/*----------------------------------------------------------------
+   Function: OS_VirtualTimeSetAuto_Impl
+
+    Purpose: Set whether the virtual clock advances by itself once
+             all tasks are waiting
+
+    Returns: OS_SUCCESS on success, or relevant error code
+             OS_ERR_NOT_IMPLEMENTED if there is no virtual clock
+ ------------------------------------------------------------------*/
+int32 OS_VirtualTimeSetAuto_Impl(bool auto_advance);
+
 
 
 
@@ -1916,6 +2932,25 @@ int32 OS_FPUExcGetMask_Impl(uint32 *mask);
  ------------------------------------------------------------------*/
 int32 OS_HeapGetInfo_Impl(OS_heap_prop_t *heap_prop);
 
+/*----------------------------------------------------------------
+   Function: OS_HeapLockdown_Impl
+
+    Purpose: Start counting or trapping heap allocations, according to
+             the OS_RT_COUNT_ALLOCATIONS/OS_RT_TRAP_ALLOCATIONS options
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_HeapLockdown_Impl(uint32 options);
+
+/*----------------------------------------------------------------
+   Function: OS_HeapGetLateAllocs_Impl
+
+    Purpose: Get the number of heap allocations made since lockdown
+
+    Returns: OS_SUCCESS on success, or relevant error code
+ ------------------------------------------------------------------*/
+int32 OS_HeapGetLateAllocs_Impl(uint32 *count);
+
 
 
 /*********************
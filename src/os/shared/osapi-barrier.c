@@ -0,0 +1,252 @@
+/*
+ *      Copyright (c) 2018, United States government as represented by the
+ *      administrator of the National Aeronautics Space Administration.
+ *      All rights reserved. This software was created at NASA Glenn
+ *      Research Center pursuant to government contracts.
+ *
+ *      This is governed by the NASA Open Source Agreement and may be used,
+ *      distributed and modified only according to the terms of that agreement.
+ */
+
+/**
+ * \file   osapi-barrier.c
+ *
+ * Purpose:
+ *         This file  contains some of the OS APIs abstraction layer code
+ *         that is shared/common across all OS-specific implementations.
+ *
+ *         A barrier releases a fixed number of tasks together once all of
+ *         them have arrived, then resets itself for the next cycle.
+ *
+ */
+
+/****************************************************************************************
+                                    INCLUDE FILES
+ ***************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * User defined include files
+ */
+#include "common_types.h"
+#include "os-impl.h"
+
+
+/*
+ * Sanity checks on the user-supplied configuration
+ * The relevent OS_MAX limit should be defined and greater than zero
+ */
+#if !defined(OS_MAX_BARRIERS) || (OS_MAX_BARRIERS <= 0)
+#error "osconfig.h must define OS_MAX_BARRIERS to a valid value"
+#endif
+
+/*
+ * Global data for the API
+ */
+enum
+{
+   LOCAL_NUM_OBJECTS = OS_MAX_BARRIERS,
+   LOCAL_OBJID_TYPE = OS_OBJECT_TYPE_OS_BARRIER
+};
+
+OS_barrier_internal_record_t    OS_barrier_table        [LOCAL_NUM_OBJECTS];
+
+
+/****************************************************************************************
+                                     BARRIER API
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierAPI_Init
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Init function for OS-independent layer
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierAPI_Init(void)
+{
+   memset(OS_barrier_table, 0, sizeof(OS_barrier_table));
+   return OS_SUCCESS;
+} /* end OS_BarrierAPI_Init */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierCreate
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierCreate (uint32 *barrier_id, const char *barrier_name, uint32 count, uint32 options)
+{
+   OS_common_record_t *record;
+   int32             return_code;
+   uint32            local_id;
+
+   /* Check for NULL pointers */
+   if (barrier_id == NULL || barrier_name == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   /* A barrier with no participants could never be released */
+   if (count == 0)
+   {
+      return OS_INVALID_SEM_VALUE;
+   }
+
+   if ( strlen (barrier_name) >= OS_MAX_API_NAME )
+   {
+      return OS_ERR_NAME_TOO_LONG;
+   }
+
+   /* Note - the common ObjectIdAllocate routine will lock the object type and leave it locked. */
+   return_code = OS_ObjectIdAllocateNew(LOCAL_OBJID_TYPE, barrier_name, &local_id, &record);
+   if(return_code == OS_SUCCESS)
+   {
+      /* Save all the data to our own internal table */
+      strcpy(OS_barrier_table[local_id].obj_name, barrier_name);
+      OS_barrier_table[local_id].count = count;
+      record->name_entry = OS_barrier_table[local_id].obj_name;
+
+      /* Now call the OS-specific implementation.  This reads info from the table. */
+      return_code = OS_BarrierCreate_Impl(local_id, options);
+
+      /* Check result, finalize record, and unlock global table. */
+      return_code = OS_ObjectIdFinalizeNew(return_code, record, barrier_id);
+   }
+
+   return return_code;
+
+} /* end OS_BarrierCreate */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierDelete
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierDelete (uint32 barrier_id)
+{
+   OS_common_record_t *record;
+   uint32 local_id;
+   int32 return_code;
+
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_EXCLUSIVE, LOCAL_OBJID_TYPE, barrier_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_BarrierDelete_Impl(local_id);
+
+      /* Free the entry in the master table now while still locked */
+      if (return_code == OS_SUCCESS)
+      {
+         /* Only need to clear the ID as zero is the "unused" flag */
+         record->active_id = 0;
+      }
+
+      OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+   }
+
+   return return_code;
+
+} /* end OS_BarrierDelete */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierWait
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierWait ( uint32 barrier_id )
+{
+   OS_common_record_t *record;
+   uint32 local_id;
+   int32 return_code;
+
+   /*
+    * Hold a reference while waiting, so OS_BarrierDelete() cannot
+    * tear the barrier down underneath a task that is using it.
+    */
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_REFCOUNT, LOCAL_OBJID_TYPE, barrier_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_BarrierWait_Impl (local_id);
+      OS_ObjectIdRefcountDecr(record);
+   }
+
+   return return_code;
+
+} /* end OS_BarrierWait */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierGetIdByName
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierGetIdByName (uint32 *barrier_id, const char *barrier_name)
+{
+   int32 return_code;
+
+   if (barrier_id == NULL || barrier_name == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   return_code = OS_ObjectIdFindByName(LOCAL_OBJID_TYPE, barrier_name, barrier_id);
+
+   return return_code;
+
+} /* end OS_BarrierGetIdByName */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierGetInfo
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierGetInfo (uint32 barrier_id, OS_barrier_prop_t *barrier_prop)
+{
+   OS_common_record_t *record;
+   int32             return_code;
+   uint32            local_id;
+
+   /* Check parameters */
+   if (barrier_prop == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   memset(barrier_prop,0,sizeof(OS_barrier_prop_t));
+
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL,LOCAL_OBJID_TYPE, barrier_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      strncpy(barrier_prop->name, record->name_entry, OS_MAX_API_NAME - 1);
+      barrier_prop->creator =    record->creator;
+      barrier_prop->count =      OS_barrier_table[local_id].count;
+
+      return_code = OS_BarrierGetInfo_Impl(local_id, barrier_prop);
+
+      OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+   }
+
+   return return_code;
+
+} /* end OS_BarrierGetInfo */
@@ -54,6 +54,35 @@ enum
 OS_apiname_internal_record_t    OS_bin_sem_table          [LOCAL_NUM_OBJECTS];
 
 
+/****************************************************************************************
+                                  SEMAPHORE HELPERS
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BinSemFiberTake
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Take the semaphore from a fiber, letting the other fibers
+ *           of the task run while it is not available
+ *
+ *  returns: OS_SEM_TIMEOUT if the wait timed out
+ *
+ *-----------------------------------------------------------------*/
+static int32 OS_BinSemFiberTake(uint32 local_id, OS_fiber_wait_t *wait)
+{
+   int32 return_code;
+
+   do
+   {
+      return_code = OS_BinSemTimedWaitMicros_Impl(local_id, 0);
+   }
+   while (return_code == OS_SEM_TIMEOUT && OS_FiberWaitRetry(wait));
+
+   return return_code;
+} /* end OS_BinSemFiberTake */
+
+
 /****************************************************************************************
                                   SEMAPHORE API
  ***************************************************************************************/
@@ -183,6 +212,12 @@ int32 OS_BinSemGive ( uint32 sem_id )
     if (return_code == OS_SUCCESS)
     {
        return_code = OS_BinSemGive_Impl (local_id);
+
+       /* wake any fibers waiting for a semaphore */
+       if (return_code == OS_SUCCESS)
+       {
+          OS_FiberNotify();
+       }
     }
 
     return return_code;
@@ -228,12 +263,20 @@ int32 OS_BinSemTake ( uint32 sem_id )
    OS_common_record_t *record;
    uint32 local_id;
    int32 return_code;
+   OS_fiber_wait_t wait;
 
    /* Check Parameters */
    return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, sem_id, &local_id, &record);
    if (return_code == OS_SUCCESS)
    {
-      return_code = OS_BinSemTake_Impl (local_id);
+      if (OS_FiberWaitStart(&wait, -1))
+      {
+         return_code = OS_BinSemFiberTake(local_id, &wait);
+      }
+      else
+      {
+         return_code = OS_BinSemTake_Impl (local_id);
+      }
    }
 
    return return_code;
@@ -253,16 +296,57 @@ int32 OS_BinSemTimedWait ( uint32 sem_id, uint32 msecs )
    OS_common_record_t *record;
    uint32 local_id;
    int32 return_code;
+   OS_fiber_wait_t wait;
 
    /* Check Parameters */
    return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, sem_id, &local_id, &record);
    if (return_code == OS_SUCCESS)
    {
-      return_code = OS_BinSemTimedWait_Impl (local_id, msecs);
+      if (OS_FiberWaitStart(&wait, (int64)msecs * 1000))
+      {
+         return_code = OS_BinSemFiberTake(local_id, &wait);
+      }
+      else
+      {
+         return_code = OS_BinSemTimedWait_Impl (local_id, msecs);
+      }
    }
 
    return return_code;
 } /* end OS_BinSemTimedWait */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BinSemTimedWaitMicros
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BinSemTimedWaitMicros ( uint32 sem_id, uint32 usecs )
+{
+   OS_common_record_t *record;
+   uint32 local_id;
+   int32 return_code;
+   OS_fiber_wait_t wait;
+
+   /* Check Parameters */
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, sem_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      if (OS_FiberWaitStart(&wait, usecs))
+      {
+         return_code = OS_BinSemFiberTake(local_id, &wait);
+      }
+      else
+      {
+         return_code = OS_BinSemTimedWaitMicros_Impl (local_id, usecs);
+      }
+   }
+
+   return return_code;
+} /* end OS_BinSemTimedWaitMicros */
                         
 /*----------------------------------------------------------------
  *
@@ -53,6 +53,129 @@ int32 OS_GetLocalTime(OS_time_t *time_struct)
 } /* end OS_GetLocalTime */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_GetMonotonicTime
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_GetMonotonicTime(OS_time_t *time_struct)
+{
+    if (time_struct == NULL)
+    {
+       return OS_INVALID_POINTER;
+    }
+
+    return OS_GetMonotonicTime_Impl(time_struct);
+
+} /* end OS_GetMonotonicTime */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_GetHighResTicks
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_GetHighResTicks(uint64 *ticks)
+{
+    if (ticks == NULL)
+    {
+       return OS_INVALID_POINTER;
+    }
+
+    return OS_GetHighResTicks_Impl(ticks);
+
+} /* end OS_GetHighResTicks */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_HighResTicksToNs
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_HighResTicksToNs(uint64 ticks, uint64 *ns)
+{
+    uint64 rate;
+    int32  return_code;
+
+    if (ns == NULL)
+    {
+       return OS_INVALID_POINTER;
+    }
+
+    return_code = OS_GetHighResTickRate_Impl(&rate);
+    if (return_code != OS_SUCCESS)
+    {
+       return return_code;
+    }
+
+    if (rate == 0 || rate > OS_HIGHRES_RATE_LIMIT)
+    {
+       return OS_ERROR;
+    }
+    if (ticks / rate >= OS_TIMEBASE_NS_LIMIT / 1000000000)
+    {
+       return OS_TIMER_ERR_INVALID_ARGS;
+    }
+
+    /*
+     * Whole seconds and the remainder are scaled separately, so that
+     * neither product can overflow for any rate up to the limit
+     */
+    *ns = ((ticks / rate) * 1000000000) + (((ticks % rate) * 1000000000) / rate);
+
+    return OS_SUCCESS;
+
+} /* end OS_HighResTicksToNs */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_NsToHighResTicks
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_NsToHighResTicks(uint64 ns, uint64 *ticks)
+{
+    uint64 rate;
+    int32  return_code;
+
+    if (ticks == NULL)
+    {
+       return OS_INVALID_POINTER;
+    }
+
+    return_code = OS_GetHighResTickRate_Impl(&rate);
+    if (return_code != OS_SUCCESS)
+    {
+       return return_code;
+    }
+    if (rate == 0 || rate > OS_HIGHRES_RATE_LIMIT)
+    {
+       return OS_ERROR;
+    }
+    if (ns / 1000000000 >= OS_TIMEBASE_NS_LIMIT / rate)
+    {
+       return OS_TIMER_ERR_INVALID_ARGS;
+    }
+
+    *ticks = ((ns / 1000000000) * rate) + (((ns % 1000000000) * rate) / 1000000000);
+
+    return OS_SUCCESS;
+
+} /* end OS_NsToHighResTicks */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_SetLocalTime
@@ -71,3 +194,38 @@ int32 OS_SetLocalTime(OS_time_t *time_struct)
     return OS_SetLocalTime_Impl(time_struct);
 
 } /* end OS_SetLocalTime */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTimeAdvance
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_VirtualTimeAdvance(uint64 nsecs)
+{
+    if (nsecs >= OS_TIMEBASE_NS_LIMIT)
+    {
+       return OS_TIMER_ERR_INVALID_ARGS;
+    }
+
+    return OS_VirtualTimeAdvance_Impl(nsecs);
+
+} /* end OS_VirtualTimeAdvance */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTimeSetAuto
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_VirtualTimeSetAuto(bool auto_advance)
+{
+    return OS_VirtualTimeSetAuto_Impl(auto_advance);
+
+} /* end OS_VirtualTimeSetAuto */
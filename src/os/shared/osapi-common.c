@@ -61,6 +61,20 @@ OS_SharedGlobalVars_t OS_SharedGlobalVars =
  *
  *-----------------------------------------------------------------*/
 int32 OS_API_Init(void)
+{
+   return OS_API_InitRealtime(OS_REALTIME_OPTIONS);
+} /* end OS_API_Init */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_API_InitRealtime
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_API_InitRealtime(uint32 rt_options)
 {
    int32  return_code = OS_SUCCESS;
    uint32 idtype;
@@ -72,6 +86,9 @@ int32 OS_API_Init(void)
    }
 
    OS_SharedGlobalVars.Initialized = true;
+   OS_SharedGlobalVars.RealtimeOptions = rt_options;
+   OS_SharedGlobalVars.MemoryLocked = false;
+   OS_SharedGlobalVars.HeapLockedDown = false;
 
    /* Initialize the common table that everything shares */
    return_code = OS_ObjectIdInit();
@@ -128,6 +145,15 @@ int32 OS_API_Init(void)
        case OS_OBJECT_TYPE_OS_CONSOLE:
            return_code = OS_ConsoleAPI_Init();
            break;
+       case OS_OBJECT_TYPE_OS_CONDVAR:
+           return_code = OS_CondVarAPI_Init();
+           break;
+       case OS_OBJECT_TYPE_OS_BARRIER:
+           return_code = OS_BarrierAPI_Init();
+           break;
+       case OS_OBJECT_TYPE_OS_WORKPOOL:
+           return_code = OS_WorkPoolAPI_Init();
+           break;
        default:
            break;
        }
@@ -149,6 +175,11 @@ int32 OS_API_Init(void)
        return_code = OS_SocketAPI_Init();
    }
 
+   if (return_code == OS_SUCCESS)
+   {
+       return_code = OS_FiberAPI_Init();
+   }
+
    /*
     * Confirm that somewhere during initialization,
     * the time variables got set to something valid
@@ -161,8 +192,55 @@ int32 OS_API_Init(void)
       return_code = OS_ERROR;
    }
 
+   /*
+    * Lock memory last, once all the tables have been initialized.
+    * Failure here is not fatal - the application can still run, just
+    * without the latency guarantee, and can check OS_API_GetRealtimeInfo().
+    */
+   if (return_code == OS_SUCCESS && (rt_options & OS_RT_LOCK_MEMORY) != 0)
+   {
+      if (OS_API_LockMemory_Impl() == OS_SUCCESS)
+      {
+         OS_SharedGlobalVars.MemoryLocked = true;
+      }
+      else
+      {
+         OS_DEBUG("WARNING: Unable to lock memory, continuing without\n");
+      }
+   }
+
    return(return_code);
-} /* end OS_API_Init */
+} /* end OS_API_InitRealtime */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_API_GetRealtimeInfo
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_API_GetRealtimeInfo(OS_realtime_prop_t *rt_prop)
+{
+   if (rt_prop == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   memset(rt_prop, 0, sizeof(*rt_prop));
+   rt_prop->options = OS_SharedGlobalVars.RealtimeOptions;
+   rt_prop->memory_locked = OS_SharedGlobalVars.MemoryLocked;
+   rt_prop->heap_locked_down = OS_SharedGlobalVars.HeapLockedDown;
+
+   if (rt_prop->heap_locked_down &&
+         OS_HeapGetLateAllocs_Impl(&rt_prop->late_allocations) != OS_SUCCESS)
+   {
+      rt_prop->late_allocations = 0;
+   }
+
+   return OS_SUCCESS;
+} /* end OS_API_GetRealtimeInfo */
 
                         
 /*----------------------------------------------------------------
@@ -225,6 +303,15 @@ void OS_CleanUpObject(uint32 object_id, void *arg)
     case OS_OBJECT_TYPE_OS_MUTEX:
         OS_MutSemDelete(object_id);
         break;
+    case OS_OBJECT_TYPE_OS_CONDVAR:
+        OS_CondVarDelete(object_id);
+        break;
+    case OS_OBJECT_TYPE_OS_BARRIER:
+        OS_BarrierDelete(object_id);
+        break;
+    case OS_OBJECT_TYPE_OS_WORKPOOL:
+        OS_WorkPoolDelete(object_id);
+        break;
     case OS_OBJECT_TYPE_OS_MODULE:
         OS_ModuleUnload(object_id);
         break;
@@ -276,6 +363,9 @@ void OS_DeleteAllObjects(void)
         OS_TaskDelay(5);
     }
     while (ObjectCount > 0 && TryCount < 5);
+
+    /* Fibers are not in the object table; free those left by the deleted tasks */
+    OS_FiberDeleteAll();
 } /* end OS_DeleteAllObjects */
 
                         
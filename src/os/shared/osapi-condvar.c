@@ -0,0 +1,370 @@
+/*
+ *      Copyright (c) 2018, United States government as represented by the
+ *      administrator of the National Aeronautics Space Administration.
+ *      All rights reserved. This software was created at NASA Glenn
+ *      Research Center pursuant to government contracts.
+ *
+ *      This is governed by the NASA Open Source Agreement and may be used,
+ *      distributed and modified only according to the terms of that agreement.
+ */
+
+/**
+ * \file   osapi-condvar.c
+ *
+ * Purpose:
+ *         This file  contains some of the OS APIs abstraction layer code
+ *         that is shared/common across all OS-specific implementations.
+ *
+ *         A condition variable is paired with its own mutex, which the
+ *         application uses to protect the associated predicate.
+ *
+ */
+
+/****************************************************************************************
+                                    INCLUDE FILES
+ ***************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * User defined include files
+ */
+#include "common_types.h"
+#include "os-impl.h"
+
+
+/*
+ * Sanity checks on the user-supplied configuration
+ * The relevent OS_MAX limit should be defined and greater than zero
+ */
+#if !defined(OS_MAX_CONDVARS) || (OS_MAX_CONDVARS <= 0)
+#error "osconfig.h must define OS_MAX_CONDVARS to a valid value"
+#endif
+
+/*
+ * Global data for the API
+ */
+enum
+{
+   LOCAL_NUM_OBJECTS = OS_MAX_CONDVARS,
+   LOCAL_OBJID_TYPE = OS_OBJECT_TYPE_OS_CONDVAR
+};
+
+OS_apiname_internal_record_t    OS_condvar_table        [LOCAL_NUM_OBJECTS];
+
+
+/****************************************************************************************
+                                CONDITION VARIABLE API
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarAPI_Init
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Init function for OS-independent layer
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarAPI_Init(void)
+{
+   memset(OS_condvar_table, 0, sizeof(OS_condvar_table));
+   return OS_SUCCESS;
+} /* end OS_CondVarAPI_Init */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarCreate
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarCreate (uint32 *var_id, const char *var_name, uint32 options)
+{
+   OS_common_record_t *record;
+   int32             return_code;
+   uint32            local_id;
+
+   /* Check for NULL pointers */
+   if (var_id == NULL || var_name == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   if ( strlen (var_name) >= OS_MAX_API_NAME )
+   {
+      return OS_ERR_NAME_TOO_LONG;
+   }
+
+   /* Note - the common ObjectIdAllocate routine will lock the object type and leave it locked. */
+   return_code = OS_ObjectIdAllocateNew(LOCAL_OBJID_TYPE, var_name, &local_id, &record);
+   if(return_code == OS_SUCCESS)
+   {
+      /* Save all the data to our own internal table */
+      strcpy(OS_condvar_table[local_id].obj_name, var_name);
+      record->name_entry = OS_condvar_table[local_id].obj_name;
+
+      /* Now call the OS-specific implementation.  This reads info from the table. */
+      return_code = OS_CondVarCreate_Impl(local_id, options);
+
+      /* Check result, finalize record, and unlock global table. */
+      return_code = OS_ObjectIdFinalizeNew(return_code, record, var_id);
+   }
+
+   return return_code;
+
+} /* end OS_CondVarCreate */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarDelete
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarDelete (uint32 var_id)
+{
+   OS_common_record_t *record;
+   uint32 local_id;
+   int32 return_code;
+
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_EXCLUSIVE, LOCAL_OBJID_TYPE, var_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_CondVarDelete_Impl(local_id);
+
+      /* Free the entry in the master table now while still locked */
+      if (return_code == OS_SUCCESS)
+      {
+         /* Only need to clear the ID as zero is the "unused" flag */
+         record->active_id = 0;
+      }
+
+      OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+   }
+
+   return return_code;
+
+} /* end OS_CondVarDelete */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarLock
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarLock ( uint32 var_id )
+{
+   OS_common_record_t *record;
+   uint32 local_id;
+   int32 return_code;
+
+   /* Check Parameters */
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, var_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_CondVarLock_Impl (local_id);
+   }
+
+   return return_code;
+
+} /* end OS_CondVarLock */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarUnlock
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarUnlock ( uint32 var_id )
+{
+   OS_common_record_t *record;
+   uint32 local_id;
+   int32 return_code;
+
+   /* Check Parameters */
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, var_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_CondVarUnlock_Impl (local_id);
+   }
+
+   return return_code;
+
+} /* end OS_CondVarUnlock */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarSignal
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarSignal ( uint32 var_id )
+{
+   OS_common_record_t *record;
+   uint32 local_id;
+   int32 return_code;
+
+   /* Check Parameters */
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, var_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_CondVarSignal_Impl (local_id);
+   }
+
+   return return_code;
+
+} /* end OS_CondVarSignal */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarBroadcast
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarBroadcast ( uint32 var_id )
+{
+   OS_common_record_t *record;
+   uint32 local_id;
+   int32 return_code;
+
+   /* Check Parameters */
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, var_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_CondVarBroadcast_Impl (local_id);
+   }
+
+   return return_code;
+
+} /* end OS_CondVarBroadcast */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarWait
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarWait ( uint32 var_id )
+{
+   OS_common_record_t *record;
+   uint32 local_id;
+   int32 return_code;
+
+   /* Check Parameters */
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, var_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_CondVarWait_Impl (local_id);
+   }
+
+   return return_code;
+
+} /* end OS_CondVarWait */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarTimedWait
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarTimedWait ( uint32 var_id, uint32 msecs )
+{
+   OS_common_record_t *record;
+   uint32 local_id;
+   int32 return_code;
+
+   /* Check Parameters */
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, var_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_CondVarTimedWait_Impl (local_id, msecs);
+   }
+
+   return return_code;
+
+} /* end OS_CondVarTimedWait */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarGetIdByName
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarGetIdByName (uint32 *var_id, const char *var_name)
+{
+   int32 return_code;
+
+   if (var_id == NULL || var_name == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   return_code = OS_ObjectIdFindByName(LOCAL_OBJID_TYPE, var_name, var_id);
+
+   return return_code;
+
+} /* end OS_CondVarGetIdByName */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarGetInfo
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarGetInfo (uint32 var_id, OS_condvar_prop_t *condvar_prop)
+{
+   OS_common_record_t *record;
+   int32             return_code;
+   uint32            local_id;
+
+   /* Check parameters */
+   if (condvar_prop == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   memset(condvar_prop,0,sizeof(OS_condvar_prop_t));
+
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL,LOCAL_OBJID_TYPE, var_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      strncpy(condvar_prop->name, record->name_entry, OS_MAX_API_NAME - 1);
+      condvar_prop->creator =    record->creator;
+
+      return_code = OS_CondVarGetInfo_Impl(local_id, condvar_prop);
+
+      OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+   }
+
+   return return_code;
+
+} /* end OS_CondVarGetInfo */
@@ -55,6 +55,35 @@ enum
 OS_apiname_internal_record_t    OS_count_sem_table          [LOCAL_NUM_OBJECTS];
 
 
+/****************************************************************************************
+                                  SEMAPHORE HELPERS
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CountSemFiberTake
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Take the semaphore from a fiber, letting the other fibers
+ *           of the task run while it is not available
+ *
+ *  returns: OS_SEM_TIMEOUT if the wait timed out
+ *
+ *-----------------------------------------------------------------*/
+static int32 OS_CountSemFiberTake(uint32 local_id, OS_fiber_wait_t *wait)
+{
+   int32 return_code;
+
+   do
+   {
+      return_code = OS_CountSemTimedWaitMicros_Impl(local_id, 0);
+   }
+   while (return_code == OS_SEM_TIMEOUT && OS_FiberWaitRetry(wait));
+
+   return return_code;
+} /* end OS_CountSemFiberTake */
+
+
 /****************************************************************************************
                                   SEMAPHORE API
  ***************************************************************************************/
@@ -176,6 +205,12 @@ int32 OS_CountSemGive ( uint32 sem_id )
     if (return_code == OS_SUCCESS)
     {
        return_code = OS_CountSemGive_Impl (local_id);
+
+       /* wake any fibers waiting for a semaphore */
+       if (return_code == OS_SUCCESS)
+       {
+          OS_FiberNotify();
+       }
     }
 
     return return_code;
@@ -196,12 +231,20 @@ int32 OS_CountSemTake ( uint32 sem_id )
    OS_common_record_t *record;
    uint32 local_id;
    int32 return_code;
+   OS_fiber_wait_t wait;
 
    /* Check Parameters */
    return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, sem_id, &local_id, &record);
    if (return_code == OS_SUCCESS)
    {
-      return_code = OS_CountSemTake_Impl (local_id);
+      if (OS_FiberWaitStart(&wait, -1))
+      {
+         return_code = OS_CountSemFiberTake(local_id, &wait);
+      }
+      else
+      {
+         return_code = OS_CountSemTake_Impl (local_id);
+      }
    }
 
    return return_code;
@@ -221,18 +264,59 @@ int32 OS_CountSemTimedWait ( uint32 sem_id, uint32 msecs )
    OS_common_record_t *record;
    uint32 local_id;
    int32 return_code;
+   OS_fiber_wait_t wait;
 
    /* Check Parameters */
    return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, sem_id, &local_id, &record);
    if (return_code == OS_SUCCESS)
    {
-      return_code = OS_CountSemTimedWait_Impl (local_id, msecs);
+      if (OS_FiberWaitStart(&wait, (int64)msecs * 1000))
+      {
+         return_code = OS_CountSemFiberTake(local_id, &wait);
+      }
+      else
+      {
+         return_code = OS_CountSemTimedWait_Impl (local_id, msecs);
+      }
    }
 
    return return_code;
 } /* end OS_CountSemTimedWait */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CountSemTimedWaitMicros
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CountSemTimedWaitMicros ( uint32 sem_id, uint32 usecs )
+{
+   OS_common_record_t *record;
+   uint32 local_id;
+   int32 return_code;
+   OS_fiber_wait_t wait;
+
+   /* Check Parameters */
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, sem_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      if (OS_FiberWaitStart(&wait, usecs))
+      {
+         return_code = OS_CountSemFiberTake(local_id, &wait);
+      }
+      else
+      {
+         return_code = OS_CountSemTimedWaitMicros_Impl (local_id, usecs);
+      }
+   }
+
+   return return_code;
+} /* end OS_CountSemTimedWaitMicros */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_CountSemGetIdByName
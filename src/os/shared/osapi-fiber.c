@@ -0,0 +1,1169 @@
+/*
+ *      Copyright (c) 2018, United States government as represented by the
+ *      administrator of the National Aeronautics Space Administration.
+ *      All rights reserved. This software was created at NASA Glenn
+ *      Research Center pursuant to government contracts.
+ *
+ *      This is governed by the NASA Open Source Agreement and may be used,
+ *      distributed and modified only according to the terms of that agreement.
+ */
+
+/**
+ * \file   osapi-fiber.c
+ *
+ * Purpose:
+ *         This file  contains some of the OS APIs abstraction layer code
+ *         that is shared/common across all OS-specific implementations.
+ *
+ *         Fibers are cooperative threads of execution that are run by the
+ *         OSAL task which created them.  Each task has its own scheduler
+ *         state, which is only ever touched from that task, so switching
+ *         between fibers needs no locking.
+ *
+ *         Fibers are not in the common object table: they belong to their
+ *         task, and their IDs are issued here without an object type.  The
+ *         fiber table is protected by the task table lock.
+ *
+ *         A fiber is always on exactly one of the lists of its task while
+ *         it is not running: the ready list (FIFO), or the wait list of
+ *         fibers that sleep, retry a semaphore or queue poll, or wait on
+ *         a stream.  Streams are checked with one select over all of the
+ *         waiting fibers.  While any fiber of a task retries a poll, the
+ *         task is notified of every semaphore give and queue put, and
+ *         retries the polls each time it is.
+ *
+ */
+
+/****************************************************************************************
+                                    INCLUDE FILES
+ ***************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * User defined include files
+ */
+#include "common_types.h"
+#include "os-impl.h"
+
+
+/*
+ * Sanity checks on the user-supplied configuration
+ * The relevent OS_MAX limit should be defined and greater than zero
+ */
+#if !defined(OS_MAX_FIBERS) || (OS_MAX_FIBERS <= 0)
+#error "osconfig.h must define OS_MAX_FIBERS to a valid value"
+#endif
+
+/*
+ * Fiber states
+ */
+enum
+{
+   OS_FIBER_STATE_READY = 0,
+   OS_FIBER_STATE_RUNNING,
+   OS_FIBER_STATE_SLEEP,       /* until wake_usec */
+   OS_FIBER_STATE_POLL,        /* retrying a semaphore or queue, at the latest at wake_usec */
+   OS_FIBER_STATE_STREAM,      /* until wait_stream has wait_events, or wake_usec */
+   OS_FIBER_STATE_ENDED
+};
+
+/*
+ * Scheduler state of a task, indexed by the task local id
+ */
+typedef struct
+{
+   uint32 task_id;             /* task the entry belongs to, the entry is reset when this changes */
+   uint32 num_fibers;          /* fibers of the task that have not ended */
+   uint32 current;             /* local id + 1 of the running fiber, 0 if none */
+   bool   running;             /* inside OS_FiberRun() */
+   uint32 ready_head;
+   uint32 ready_tail;
+   uint32 ready_count;
+   uint32 wait_head;
+   uint32 stream_waiters;      /* fibers on the wait list in OS_FIBER_STATE_STREAM */
+   uint32 poll_waiters;        /* fibers retrying a semaphore or queue poll */
+} OS_fiber_sched_t;
+
+/*
+ * Global data for the API
+ */
+enum
+{
+   LOCAL_NUM_OBJECTS = OS_MAX_FIBERS,
+   LOCAL_LOCK_TYPE = OS_OBJECT_TYPE_OS_TASK
+};
+
+OS_fiber_internal_record_t      OS_fiber_table          [LOCAL_NUM_OBJECTS];
+
+static OS_fiber_sched_t         OS_fiber_sched_table    [OS_MAX_TASKS];
+
+/* Serial number of the last fiber ID issued */
+static uint32                   OS_fiber_last_id;
+
+/*
+ * Number of fibers in existence.  This is only changed with the task
+ * table lock held, but is read without it to skip the fiber checks in
+ * the blocking calls of tasks that have no fibers: a task can only be
+ * running a fiber after it has created one itself.
+ */
+static uint32                   OS_fiber_count;
+
+
+/****************************************************************************************
+                                  FIBER HELPERS
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberNow
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Returns the monotonic time in microseconds
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_FiberNow(void)
+{
+   OS_time_t now;
+
+   if (OS_GetMonotonicTime_Impl(&now) != OS_SUCCESS)
+   {
+      return 0;
+   }
+
+   return ((uint64)now.seconds * 1000000) + now.microsecs;
+} /* end OS_FiberNow */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberIdAllocate
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Find a free entry in the fiber table and the ID to give it.
+ *           The entry is only marked in use once the caller sets its
+ *           active_id.  Must be called with the task table locked.
+ *
+ *  returns: OS_ERR_NAME_TAKEN or OS_ERR_NO_FREE_IDS on failure
+ *
+ *-----------------------------------------------------------------*/
+static int32 OS_FiberIdAllocate(const char *fiber_name, uint32 *local_id, uint32 *fiber_id)
+{
+   uint32 serial;
+   uint32 i;
+
+   for (i = 0; i < LOCAL_NUM_OBJECTS; ++i)
+   {
+      if (OS_fiber_table[i].active_id != 0 &&
+            strcmp(OS_fiber_table[i].obj_name, fiber_name) == 0)
+      {
+         return OS_ERR_NAME_TAKEN;
+      }
+   }
+
+   serial = OS_fiber_last_id;
+   for (i = 0; i < LOCAL_NUM_OBJECTS; ++i)
+   {
+      ++serial;
+      if (serial > OS_OBJECT_INDEX_MASK)
+      {
+         /* reset to beginning of ID space, which starts at 1 as 0 is never valid */
+         serial = 1;
+      }
+      if (OS_fiber_table[serial % LOCAL_NUM_OBJECTS].active_id == 0)
+      {
+         OS_fiber_last_id = serial;
+         *local_id = serial % LOCAL_NUM_OBJECTS;
+         *fiber_id = serial;
+         return OS_SUCCESS;
+      }
+   }
+
+   return OS_ERR_NO_FREE_IDS;
+} /* end OS_FiberIdAllocate */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberIdLock
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Lock the task table and find the fiber table entry of an ID.
+ *           The table is left locked only on success.
+ *
+ *  returns: OS_ERR_INVALID_ID if the ID is not that of an existing fiber
+ *
+ *-----------------------------------------------------------------*/
+static int32 OS_FiberIdLock(uint32 fiber_id, uint32 *local_id)
+{
+   if (fiber_id == 0 || fiber_id > OS_OBJECT_INDEX_MASK)
+   {
+      return OS_ERR_INVALID_ID;
+   }
+
+   *local_id = fiber_id % LOCAL_NUM_OBJECTS;
+
+   OS_Lock_Global_Impl(LOCAL_LOCK_TYPE);
+   if (OS_fiber_table[*local_id].active_id != fiber_id)
+   {
+      OS_Unlock_Global_Impl(LOCAL_LOCK_TYPE);
+      return OS_ERR_INVALID_ID;
+   }
+
+   return OS_SUCCESS;
+} /* end OS_FiberIdLock */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberSchedSelf
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Get the scheduler state of the calling task
+ *
+ *  returns: NULL if the caller is not an OSAL task
+ *
+ *-----------------------------------------------------------------*/
+static OS_fiber_sched_t *OS_FiberSchedSelf(void)
+{
+   OS_fiber_sched_t *sched;
+   uint32 task_id;
+   uint32 local_id;
+
+   task_id = OS_TaskGetId_Impl();
+   if (OS_ObjectIdToArrayIndex(OS_OBJECT_TYPE_OS_TASK, task_id, &local_id) != OS_SUCCESS)
+   {
+      return NULL;
+   }
+
+   sched = &OS_fiber_sched_table[local_id];
+   if (sched->task_id != task_id)
+   {
+      /* first use by this task; fibers of a previous task in the slot are orphaned */
+      if (sched->poll_waiters > 0)
+      {
+         OS_FiberNotifyEnable_Impl(local_id, false);
+      }
+      memset(sched, 0, sizeof(*sched));
+      sched->task_id = task_id;
+   }
+
+   return sched;
+} /* end OS_FiberSchedSelf */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberSelf
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Determine if the caller is a fiber, and if so output
+ *           its local id
+ *
+ *-----------------------------------------------------------------*/
+static bool OS_FiberSelf(uint32 *local_id)
+{
+   OS_fiber_sched_t *sched;
+
+   if (OS_fiber_count == 0)
+   {
+      return false;
+   }
+
+   sched = OS_FiberSchedSelf();
+   if (sched == NULL || sched->current == 0)
+   {
+      return false;
+   }
+
+   *local_id = sched->current - 1;
+   return true;
+} /* end OS_FiberSelf */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberEnqueue
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Append a fiber to the ready list
+ *
+ *-----------------------------------------------------------------*/
+static void OS_FiberEnqueue(OS_fiber_sched_t *sched, uint32 local_id)
+{
+   OS_fiber_table[local_id].state = OS_FIBER_STATE_READY;
+   OS_fiber_table[local_id].next = 0;
+   if (sched->ready_tail == 0)
+   {
+      sched->ready_head = local_id + 1;
+   }
+   else
+   {
+      OS_fiber_table[sched->ready_tail - 1].next = local_id + 1;
+   }
+   sched->ready_tail = local_id + 1;
+   ++sched->ready_count;
+} /* end OS_FiberEnqueue */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberDequeue
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Remove the first fiber of the ready list, which must not
+ *           be empty, and return its local id
+ *
+ *-----------------------------------------------------------------*/
+static uint32 OS_FiberDequeue(OS_fiber_sched_t *sched)
+{
+   uint32 local_id;
+
+   local_id = sched->ready_head - 1;
+   sched->ready_head = OS_fiber_table[local_id].next;
+   if (sched->ready_head == 0)
+   {
+      sched->ready_tail = 0;
+   }
+   --sched->ready_count;
+
+   return local_id;
+} /* end OS_FiberDequeue */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberUnlink
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Remove a fiber from whichever list of the task it is on
+ *
+ *-----------------------------------------------------------------*/
+static void OS_FiberUnlink(OS_fiber_sched_t *sched, uint32 local_id)
+{
+   uint32 *link;
+   uint32 prev;
+
+   prev = 0;
+   link = &sched->ready_head;
+   while (*link != 0)
+   {
+      if (*link == local_id + 1)
+      {
+         *link = OS_fiber_table[local_id].next;
+         if (sched->ready_tail == local_id + 1)
+         {
+            sched->ready_tail = prev;
+         }
+         --sched->ready_count;
+         return;
+      }
+      prev = *link;
+      link = &OS_fiber_table[*link - 1].next;
+   }
+
+   link = &sched->wait_head;
+   while (*link != 0)
+   {
+      if (*link == local_id + 1)
+      {
+         *link = OS_fiber_table[local_id].next;
+         if (OS_fiber_table[local_id].state == OS_FIBER_STATE_STREAM)
+         {
+            --sched->stream_waiters;
+         }
+         return;
+      }
+      link = &OS_fiber_table[*link - 1].next;
+   }
+} /* end OS_FiberUnlink */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberStreamSets
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Fill in the sets of streams that fibers are waiting on
+ *
+ *-----------------------------------------------------------------*/
+static void OS_FiberStreamSets(OS_fiber_sched_t *sched, OS_FdSet *read_set, OS_FdSet *write_set)
+{
+   OS_fiber_internal_record_t *fiber;
+   uint32 link;
+   uint32 stream_id;
+   uint8 mask;
+
+   memset(read_set, 0, sizeof(*read_set));
+   memset(write_set, 0, sizeof(*write_set));
+   for (link = sched->wait_head; link != 0; link = fiber->next)
+   {
+      fiber = &OS_fiber_table[link - 1];
+      if (fiber->state == OS_FIBER_STATE_STREAM)
+      {
+         stream_id = fiber->wait_stream;
+         mask = 1 << (stream_id & 0x7);
+         if (fiber->wait_events & OS_STREAM_STATE_READABLE)
+         {
+            read_set->object_ids[stream_id >> 3] |= mask;
+         }
+         if (fiber->wait_events & OS_STREAM_STATE_WRITABLE)
+         {
+            write_set->object_ids[stream_id >> 3] |= mask;
+         }
+      }
+   }
+} /* end OS_FiberStreamSets */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberStreamsReady
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Mark the fibers whose stream is in the sets returned by a
+ *           select.  They are moved to the ready list by OS_FiberWake().
+ *
+ *-----------------------------------------------------------------*/
+static void OS_FiberStreamsReady(OS_fiber_sched_t *sched, OS_FdSet *read_set, OS_FdSet *write_set)
+{
+   OS_fiber_internal_record_t *fiber;
+   uint32 link;
+   uint32 stream_id;
+   uint8 mask;
+
+   for (link = sched->wait_head; link != 0; link = fiber->next)
+   {
+      fiber = &OS_fiber_table[link - 1];
+      if (fiber->state == OS_FIBER_STATE_STREAM)
+      {
+         stream_id = fiber->wait_stream;
+         mask = 1 << (stream_id & 0x7);
+         if ((read_set->object_ids[stream_id >> 3] & mask) != 0 ||
+               (write_set->object_ids[stream_id >> 3] & mask) != 0)
+         {
+            fiber->state = OS_FIBER_STATE_READY;
+            --sched->stream_waiters;
+         }
+      }
+   }
+} /* end OS_FiberStreamsReady */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberSetPolling
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Count or stop counting a fiber as retrying a semaphore or
+ *           queue poll.  The task is notified of gives and puts while
+ *           it has any such fiber.  Notification is enabled before the
+ *           poll is retried, so a give that the retry misses notifies.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_FiberSetPolling(OS_fiber_sched_t *sched, uint32 local_id, bool polling)
+{
+   OS_fiber_internal_record_t *fiber;
+
+   fiber = &OS_fiber_table[local_id];
+   if (fiber->polling == polling)
+   {
+      return;
+   }
+
+   fiber->polling = polling;
+   if (polling)
+   {
+      ++sched->poll_waiters;
+      if (sched->poll_waiters == 1)
+      {
+         OS_FiberNotifyEnable_Impl(sched - OS_fiber_sched_table, true);
+      }
+   }
+   else
+   {
+      --sched->poll_waiters;
+      if (sched->poll_waiters == 0)
+      {
+         OS_FiberNotifyEnable_Impl(sched - OS_fiber_sched_table, false);
+      }
+   }
+} /* end OS_FiberSetPolling */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberWake
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Move the waiting fibers that can continue to the ready list.
+ *           If retry is set, some fiber has made progress since the
+ *           polling fibers last ran, so they are all retried.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_FiberWake(OS_fiber_sched_t *sched, bool retry)
+{
+   OS_fiber_internal_record_t *fiber;
+   OS_FdSet read_set;
+   OS_FdSet write_set;
+   uint32 *link;
+   uint32 local_id;
+   uint64 now;
+
+   if (sched->wait_head == 0)
+   {
+      return;
+   }
+
+   /* Do not let the ready fibers hold off the ones waiting on streams */
+   if (sched->stream_waiters > 0 && sched->ready_count > 0)
+   {
+      OS_FiberStreamSets(sched, &read_set, &write_set);
+      if (OS_SelectMultiple_Impl(&read_set, &write_set, OS_CHECK) == OS_SUCCESS)
+      {
+         OS_FiberStreamsReady(sched, &read_set, &write_set);
+      }
+   }
+
+   now = OS_FiberNow();
+   link = &sched->wait_head;
+   while (*link != 0)
+   {
+      local_id = *link - 1;
+      fiber = &OS_fiber_table[local_id];
+      if (fiber->state == OS_FIBER_STATE_READY ||
+            (retry && fiber->state == OS_FIBER_STATE_POLL) ||
+            (fiber->wake_usec != 0 && now >= fiber->wake_usec))
+      {
+         *link = fiber->next;
+         if (fiber->state == OS_FIBER_STATE_STREAM)
+         {
+            --sched->stream_waiters;
+         }
+         fiber->retry = (fiber->state == OS_FIBER_STATE_POLL);
+         OS_FiberEnqueue(sched, local_id);
+      }
+      else
+      {
+         link = &fiber->next;
+      }
+   }
+} /* end OS_FiberWake */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberIdle
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Block the task until the earliest fiber timeout, until a
+ *           stream that a fiber waits on is ready, or until the task is
+ *           notified of a semaphore give or queue put
+ *
+ *-----------------------------------------------------------------*/
+static void OS_FiberIdle(OS_fiber_sched_t *sched)
+{
+   OS_fiber_internal_record_t *fiber;
+   OS_FdSet read_set;
+   OS_FdSet write_set;
+   uint32 link;
+   uint64 wake;
+   int64 timeout;
+   uint64 now;
+
+   wake = 0;
+   for (link = sched->wait_head; link != 0; link = fiber->next)
+   {
+      fiber = &OS_fiber_table[link - 1];
+      if (fiber->wake_usec != 0 && (wake == 0 || fiber->wake_usec < wake))
+      {
+         wake = fiber->wake_usec;
+      }
+   }
+
+   timeout = -1;
+   if (wake != 0)
+   {
+      now = OS_FiberNow();
+      timeout = 0;
+      if (wake > now)
+      {
+         timeout = wake - now;
+      }
+   }
+
+   OS_FiberStreamSets(sched, &read_set, &write_set);
+   if (OS_FiberIdle_Impl(sched - OS_fiber_sched_table, &read_set, &write_set, timeout) == OS_SUCCESS &&
+         sched->stream_waiters > 0)
+   {
+      OS_FiberStreamsReady(sched, &read_set, &write_set);
+   }
+} /* end OS_FiberIdle */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberSuspend
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Switch from the calling fiber back to its task, to be
+ *           resumed according to the given state
+ *
+ *-----------------------------------------------------------------*/
+static void OS_FiberSuspend(uint32 local_id, uint32 state, uint64 wake_usec)
+{
+   OS_fiber_table[local_id].state = state;
+   OS_fiber_table[local_id].wake_usec = wake_usec;
+   OS_FiberSwitchOut_Impl(local_id);
+} /* end OS_FiberSuspend */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberRelease
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Free a fiber that has returned from its entry point
+ *
+ *-----------------------------------------------------------------*/
+static void OS_FiberRelease(OS_fiber_sched_t *sched, uint32 local_id)
+{
+   --sched->num_fibers;
+
+   OS_Lock_Global_Impl(LOCAL_LOCK_TYPE);
+   OS_FiberDelete_Impl(local_id);
+   OS_fiber_table[local_id].active_id = 0;
+   --OS_fiber_count;
+   OS_Unlock_Global_Impl(LOCAL_LOCK_TYPE);
+} /* end OS_FiberRelease */
+
+
+/****************************************************************************************
+                                  FIBER WAIT HOOKS
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberEntryPoint
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_FiberEntryPoint(uint32 fiber_id)
+{
+   OS_fiber_internal_record_t *fiber;
+
+   fiber = &OS_fiber_table[fiber_id];
+   fiber->entry(fiber->entry_arg);
+
+   fiber->state = OS_FIBER_STATE_ENDED;
+   OS_FiberSwitchOut_Impl(fiber_id);
+} /* end OS_FiberEntryPoint */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberWaitStart
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool OS_FiberWaitStart(OS_fiber_wait_t *wait, int64 timeout_usec)
+{
+   if (!OS_FiberSelf(&wait->fiber_id))
+   {
+      return false;
+   }
+
+   wait->deadline_usec = 0;
+   if (timeout_usec >= 0)
+   {
+      wait->deadline_usec = OS_FiberNow() + timeout_usec;
+   }
+
+   return true;
+} /* end OS_FiberWaitStart */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberWaitRetry
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool OS_FiberWaitRetry(OS_fiber_wait_t *wait)
+{
+   if (wait->deadline_usec != 0 && OS_FiberNow() >= wait->deadline_usec)
+   {
+      return false;
+   }
+
+   OS_FiberSuspend(wait->fiber_id, OS_FIBER_STATE_POLL, wait->deadline_usec);
+
+   return true;
+} /* end OS_FiberWaitRetry */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberNotify
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_FiberNotify(void)
+{
+   if (OS_fiber_count != 0)
+   {
+      OS_FiberNotify_Impl();
+   }
+} /* end OS_FiberNotify */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberSleep
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool OS_FiberSleep(uint64 usec)
+{
+   uint32 local_id;
+
+   if (!OS_FiberSelf(&local_id))
+   {
+      return false;
+   }
+
+   if (usec == 0)
+   {
+      OS_FiberSuspend(local_id, OS_FIBER_STATE_READY, 0);
+   }
+   else
+   {
+      OS_FiberSuspend(local_id, OS_FIBER_STATE_SLEEP, OS_FiberNow() + usec);
+   }
+
+   return true;
+} /* end OS_FiberSleep */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberWaitStream
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool OS_FiberWaitStream(uint32 stream_id, uint32 events, int32 msecs)
+{
+   uint32 local_id;
+   uint64 wake;
+
+   if (!OS_FiberSelf(&local_id))
+   {
+      return false;
+   }
+
+   wake = 0;
+   if (msecs >= 0)
+   {
+      wake = OS_FiberNow() + ((uint64)msecs * 1000);
+   }
+
+   OS_fiber_table[local_id].wait_stream = stream_id;
+   OS_fiber_table[local_id].wait_events = events;
+   OS_FiberSuspend(local_id, OS_FIBER_STATE_STREAM, wake);
+
+   return true;
+} /* end OS_FiberWaitStream */
+
+
+/****************************************************************************************
+                                  FIBER API
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberAPI_Init
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Init function for OS-independent layer
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberAPI_Init(void)
+{
+   memset(OS_fiber_table, 0, sizeof(OS_fiber_table));
+   memset(OS_fiber_sched_table, 0, sizeof(OS_fiber_sched_table));
+   OS_fiber_last_id = 0;
+   OS_fiber_count = 0;
+   return OS_SUCCESS;
+} /* end OS_FiberAPI_Init */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberDeleteAll
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See description in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_FiberDeleteAll(void)
+{
+   uint32 fiber_id;
+   uint32 i;
+
+   for (i = 0; i < LOCAL_NUM_OBJECTS; ++i)
+   {
+      OS_Lock_Global_Impl(LOCAL_LOCK_TYPE);
+      fiber_id = OS_fiber_table[i].active_id;
+      OS_Unlock_Global_Impl(LOCAL_LOCK_TYPE);
+
+      if (fiber_id != 0)
+      {
+         OS_FiberDelete(fiber_id);
+      }
+   }
+} /* end OS_FiberDeleteAll */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberCreate
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberCreate (uint32 *fiber_id, const char *fiber_name, OS_FiberFunc_t entry,
+                      void *arg, uint32 stack_size, uint32 flags)
+{
+   OS_fiber_internal_record_t *fiber;
+   OS_fiber_sched_t *sched;
+   int32             return_code;
+   uint32            local_id;
+   uint32            new_id;
+
+   /* Check for NULL pointers */
+   if (fiber_id == NULL || fiber_name == NULL || entry == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   if ( strlen (fiber_name) >= OS_MAX_API_NAME )
+   {
+      return OS_ERR_NAME_TOO_LONG;
+   }
+
+   sched = OS_FiberSchedSelf();
+   if (sched == NULL)
+   {
+      return OS_ERR_INCORRECT_OBJ_STATE;
+   }
+
+   if (stack_size == 0)
+   {
+      stack_size = OS_FIBER_DEFAULT_STACK_SIZE;
+   }
+
+   return_code = OS_FiberTaskInit_Impl(sched - OS_fiber_sched_table);
+   if (return_code != OS_SUCCESS)
+   {
+      return return_code;
+   }
+
+   OS_Lock_Global_Impl(LOCAL_LOCK_TYPE);
+
+   return_code = OS_FiberIdAllocate(fiber_name, &local_id, &new_id);
+   if(return_code == OS_SUCCESS)
+   {
+      /* Save all the data to our own internal table */
+      fiber = &OS_fiber_table[local_id];
+      memset(fiber, 0, sizeof(*fiber));
+      strcpy(fiber->obj_name, fiber_name);
+      fiber->creator = sched->task_id;
+      fiber->entry = entry;
+      fiber->entry_arg = arg;
+      fiber->stack_size = stack_size;
+      fiber->host_task_id = sched->task_id;
+
+      /* Now call the OS-specific implementation.  This reads info from the table. */
+      return_code = OS_FiberCreate_Impl(local_id, flags);
+      if (return_code == OS_SUCCESS)
+      {
+         fiber->active_id = new_id;
+         ++OS_fiber_count;
+      }
+   }
+
+   OS_Unlock_Global_Impl(LOCAL_LOCK_TYPE);
+
+   if (return_code == OS_SUCCESS)
+   {
+      *fiber_id = new_id;
+      ++sched->num_fibers;
+      OS_FiberEnqueue(sched, local_id);
+   }
+   else
+   {
+      *fiber_id = 0;
+   }
+
+   return return_code;
+
+} /* end OS_FiberCreate */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberRun
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberRun (void)
+{
+   OS_fiber_internal_record_t *fiber;
+   OS_fiber_sched_t *sched;
+   uint32 local_id;
+   uint32 count;
+   bool progress;
+
+   sched = OS_FiberSchedSelf();
+   if (sched == NULL || sched->running)
+   {
+      return OS_ERR_INCORRECT_OBJ_STATE;
+   }
+
+   sched->running = true;
+   progress = true;
+   while (sched->num_fibers > 0)
+   {
+      OS_FiberWake(sched, progress);
+      progress = false;
+
+      if (sched->ready_count == 0)
+      {
+         /* pollers are retried after any wakeup, which may be a notification */
+         OS_FiberIdle(sched);
+         progress = true;
+         continue;
+      }
+
+      /*
+       * Run each fiber that is ready now once.  Fibers that become ready
+       * during the pass, including those that yield, run in the next pass.
+       */
+      count = sched->ready_count;
+      while (count > 0)
+      {
+         --count;
+         local_id = OS_FiberDequeue(sched);
+         fiber = &OS_fiber_table[local_id];
+
+         fiber->state = OS_FIBER_STATE_RUNNING;
+         ++fiber->switches;
+         sched->current = local_id + 1;
+         OS_FiberSwitchIn_Impl(local_id);
+         sched->current = 0;
+
+         /* A poll that was retried and failed again does not wake the other pollers */
+         if (!fiber->retry || fiber->state != OS_FIBER_STATE_POLL)
+         {
+            progress = true;
+         }
+         fiber->retry = false;
+         OS_FiberSetPolling(sched, local_id, fiber->state == OS_FIBER_STATE_POLL);
+
+         if (fiber->state == OS_FIBER_STATE_ENDED)
+         {
+            OS_FiberRelease(sched, local_id);
+         }
+         else if (fiber->state == OS_FIBER_STATE_READY)
+         {
+            OS_FiberEnqueue(sched, local_id);
+         }
+         else
+         {
+            if (fiber->state == OS_FIBER_STATE_STREAM)
+            {
+               ++sched->stream_waiters;
+            }
+            fiber->next = sched->wait_head;
+            sched->wait_head = local_id + 1;
+         }
+      }
+   }
+   sched->running = false;
+
+   return OS_SUCCESS;
+
+} /* end OS_FiberRun */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberYield
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberYield (void)
+{
+   uint32 local_id;
+
+   if (!OS_FiberSelf(&local_id))
+   {
+      return OS_ERR_INCORRECT_OBJ_STATE;
+   }
+
+   OS_FiberSuspend(local_id, OS_FIBER_STATE_READY, 0);
+
+   return OS_SUCCESS;
+
+} /* end OS_FiberYield */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberGetId
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 OS_FiberGetId (void)
+{
+   uint32 local_id;
+
+   if (!OS_FiberSelf(&local_id))
+   {
+      return 0;
+   }
+
+   return OS_fiber_table[local_id].active_id;
+
+} /* end OS_FiberGetId */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberDelete
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberDelete (uint32 fiber_id)
+{
+   OS_fiber_sched_t *sched;
+   uint32 local_id;
+   uint32 task_idx;
+   uint32 host_task_id;
+   int32 return_code;
+
+   return_code = OS_FiberIdLock(fiber_id, &local_id);
+   if (return_code == OS_SUCCESS)
+   {
+      /*
+       * While the task that created the fiber exists, only that task
+       * may delete it, and only while it is not switching between fibers.
+       */
+      host_task_id = OS_fiber_table[local_id].host_task_id;
+      if (OS_ObjectIdToArrayIndex(OS_OBJECT_TYPE_OS_TASK, host_task_id, &task_idx) == OS_SUCCESS &&
+            OS_global_task_table[task_idx].active_id == host_task_id)
+      {
+         sched = &OS_fiber_sched_table[task_idx];
+         if (OS_TaskGetId_Impl() != host_task_id || sched->running)
+         {
+            return_code = OS_ERR_INCORRECT_OBJ_STATE;
+         }
+         else if (sched->task_id == host_task_id)
+         {
+            OS_FiberUnlink(sched, local_id);
+            OS_FiberSetPolling(sched, local_id, false);
+            --sched->num_fibers;
+         }
+      }
+
+      if (return_code == OS_SUCCESS)
+      {
+         return_code = OS_FiberDelete_Impl(local_id);
+      }
+
+      /* Free the entry now while still locked */
+      if (return_code == OS_SUCCESS)
+      {
+         /* Only need to clear the ID as zero is the "unused" flag */
+         OS_fiber_table[local_id].active_id = 0;
+         --OS_fiber_count;
+      }
+
+      OS_Unlock_Global_Impl(LOCAL_LOCK_TYPE);
+   }
+
+   return return_code;
+
+} /* end OS_FiberDelete */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberGetIdByName
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberGetIdByName (uint32 *fiber_id, const char *fiber_name)
+{
+   int32 return_code;
+   uint32 i;
+
+   if (fiber_id == NULL || fiber_name == NULL)
+   {
+       return OS_INVALID_POINTER;
+   }
+
+   return_code = OS_ERR_NAME_NOT_FOUND;
+
+   OS_Lock_Global_Impl(LOCAL_LOCK_TYPE);
+   for (i = 0; i < LOCAL_NUM_OBJECTS; ++i)
+   {
+      if (OS_fiber_table[i].active_id != 0 &&
+            strcmp(OS_fiber_table[i].obj_name, fiber_name) == 0)
+      {
+         *fiber_id = OS_fiber_table[i].active_id;
+         return_code = OS_SUCCESS;
+         break;
+      }
+   }
+   OS_Unlock_Global_Impl(LOCAL_LOCK_TYPE);
+
+   return return_code;
+
+} /* end OS_FiberGetIdByName */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberGetInfo
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberGetInfo (uint32 fiber_id, OS_fiber_prop_t *fiber_prop)
+{
+   int32             return_code;
+   uint32            local_id;
+
+   /* Check parameters */
+   if (fiber_prop == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   memset(fiber_prop,0,sizeof(OS_fiber_prop_t));
+
+   return_code = OS_FiberIdLock(fiber_id, &local_id);
+   if (return_code == OS_SUCCESS)
+   {
+      strncpy(fiber_prop->name, OS_fiber_table[local_id].obj_name, OS_MAX_API_NAME - 1);
+      fiber_prop->creator =      OS_fiber_table[local_id].creator;
+      fiber_prop->host_task_id = OS_fiber_table[local_id].host_task_id;
+      fiber_prop->stack_size =   OS_fiber_table[local_id].stack_size;
+      fiber_prop->switches =     OS_fiber_table[local_id].switches;
+
+      OS_Unlock_Global_Impl(LOCAL_LOCK_TYPE);
+   }
+
+   return return_code;
+
+} /* end OS_FiberGetInfo */
@@ -294,6 +294,12 @@ int32 OS_TimedRead(uint32  filedes, void *buffer, uint32 nbytes, int32 timeout)
    return_code = OS_ObjectIdGetById(OS_LOCK_MODE_REFCOUNT, LOCAL_OBJID_TYPE, filedes, &local_id, &record);
    if (return_code == OS_SUCCESS)
    {
+      /* a fiber waits for the stream while the other fibers of its task run */
+      if (timeout != OS_CHECK && OS_FiberWaitStream(local_id, OS_STREAM_STATE_READABLE, timeout))
+      {
+         timeout = OS_CHECK;
+      }
+
       return_code = OS_GenericRead_Impl (local_id, buffer, nbytes, timeout);
       OS_ObjectIdRefcountDecr(record);
    }
@@ -325,6 +331,12 @@ int32 OS_TimedWrite(uint32  filedes, const void *buffer, uint32 nbytes, int32 ti
    return_code = OS_ObjectIdGetById(OS_LOCK_MODE_REFCOUNT, LOCAL_OBJID_TYPE, filedes, &local_id, &record);
    if (return_code == OS_SUCCESS)
    {
+      /* a fiber waits for the stream while the other fibers of its task run */
+      if (timeout != OS_CHECK && OS_FiberWaitStream(local_id, OS_STREAM_STATE_WRITABLE, timeout))
+      {
+         timeout = OS_CHECK;
+      }
+
       return_code = OS_GenericWrite_Impl (local_id, buffer, nbytes, timeout);
       OS_ObjectIdRefcountDecr(record);
    }
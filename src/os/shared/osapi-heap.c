@@ -52,3 +52,25 @@ int32 OS_HeapGetInfo       (OS_heap_prop_t *heap_prop)
     return OS_HeapGetInfo_Impl(heap_prop);
 } /* end OS_HeapGetInfo */
 
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_HeapLockdown
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_HeapLockdown      (void)
+{
+    int32 return_code;
+
+    return_code = OS_HeapLockdown_Impl(OS_SharedGlobalVars.RealtimeOptions);
+    if (return_code == OS_SUCCESS)
+    {
+        OS_SharedGlobalVars.HeapLockedDown = true;
+    }
+
+    return return_code;
+} /* end OS_HeapLockdown */
+
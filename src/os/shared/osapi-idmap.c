@@ -59,7 +59,10 @@ typedef enum
    OS_MODULE_BASE = OS_TIMECB_BASE + OS_MAX_TIMERS,
    OS_FILESYS_BASE = OS_MODULE_BASE + OS_MAX_MODULES,
    OS_CONSOLE_BASE = OS_FILESYS_BASE + OS_MAX_FILE_SYSTEMS,
-   OS_MAX_TOTAL_RECORDS = OS_CONSOLE_BASE + OS_MAX_CONSOLES
+   OS_CONDVAR_BASE = OS_CONSOLE_BASE + OS_MAX_CONSOLES,
+   OS_BARRIER_BASE = OS_CONDVAR_BASE + OS_MAX_CONDVARS,
+   OS_WORKPOOL_BASE = OS_BARRIER_BASE + OS_MAX_BARRIERS,
+   OS_MAX_TOTAL_RECORDS = OS_WORKPOOL_BASE + OS_MAX_WORKPOOLS
 } OS_ObjectIndex_t;
 
 
@@ -86,6 +89,9 @@ OS_common_record_t * const OS_global_timecb_table     = &OS_common_table[OS_TIME
 OS_common_record_t * const OS_global_module_table     = &OS_common_table[OS_MODULE_BASE];
 OS_common_record_t * const OS_global_filesys_table    = &OS_common_table[OS_FILESYS_BASE];
 OS_common_record_t * const OS_global_console_table    = &OS_common_table[OS_CONSOLE_BASE];
+OS_common_record_t * const OS_global_condvar_table    = &OS_common_table[OS_CONDVAR_BASE];
+OS_common_record_t * const OS_global_barrier_table    = &OS_common_table[OS_BARRIER_BASE];
+OS_common_record_t * const OS_global_workpool_table   = &OS_common_table[OS_WORKPOOL_BASE];
 
 /*
  *********************************************************************************
@@ -172,6 +178,9 @@ uint32 OS_GetMaxForObjectType(uint32 idtype)
    case OS_OBJECT_TYPE_OS_MODULE:   return OS_MAX_MODULES;
    case OS_OBJECT_TYPE_OS_FILESYS:  return OS_MAX_FILE_SYSTEMS;
    case OS_OBJECT_TYPE_OS_CONSOLE:  return OS_MAX_CONSOLES;
+   case OS_OBJECT_TYPE_OS_CONDVAR:  return OS_MAX_CONDVARS;
+   case OS_OBJECT_TYPE_OS_BARRIER:  return OS_MAX_BARRIERS;
+   case OS_OBJECT_TYPE_OS_WORKPOOL: return OS_MAX_WORKPOOLS;
    default:                         return 0;
    }
 } /* end OS_GetMaxForObjectType */
@@ -200,6 +209,9 @@ uint32 OS_GetBaseForObjectType(uint32 idtype)
    case OS_OBJECT_TYPE_OS_MODULE:   return OS_MODULE_BASE;
    case OS_OBJECT_TYPE_OS_FILESYS:  return OS_FILESYS_BASE;
    case OS_OBJECT_TYPE_OS_CONSOLE:  return OS_CONSOLE_BASE;
+   case OS_OBJECT_TYPE_OS_CONDVAR:  return OS_CONDVAR_BASE;
+   case OS_OBJECT_TYPE_OS_BARRIER:  return OS_BARRIER_BASE;
+   case OS_OBJECT_TYPE_OS_WORKPOOL: return OS_WORKPOOL_BASE;
    default:                         return 0;
    }
 } /* end OS_GetBaseForObjectType */
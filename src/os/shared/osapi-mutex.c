@@ -52,13 +52,504 @@ enum
    LOCAL_OBJID_TYPE = OS_OBJECT_TYPE_OS_MUTEX
 };
 
-OS_apiname_internal_record_t    OS_mutex_table          [LOCAL_NUM_OBJECTS];
+OS_mutex_internal_record_t      OS_mutex_table          [LOCAL_NUM_OBJECTS];
 
 
 /****************************************************************************************
                                   MUTEX API
  ***************************************************************************************/
 
+
+#ifdef OS_MUTEX_DIAGNOSTICS
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemDiagElapsed
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Returns the microseconds from start_time to end_time,
+ *           saturating at the uint32 limit (about 71 minutes).
+ *
+ *-----------------------------------------------------------------*/
+static uint32 OS_MutSemDiagElapsed(const OS_time_t *start_time, const OS_time_t *end_time)
+{
+   uint32 seconds;
+   uint32 usecs;
+
+   if (end_time->seconds < start_time->seconds)
+   {
+      return 0;
+   }
+
+   seconds = end_time->seconds - start_time->seconds;
+   if (seconds >= 4294)
+   {
+      return 0xFFFFFFFF;
+   }
+
+   usecs = (seconds * 1000000) + end_time->microsecs;
+   if (usecs < start_time->microsecs)
+   {
+      return 0;
+   }
+
+   return usecs - start_time->microsecs;
+} /* end OS_MutSemDiagElapsed */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemDiagGetPriority
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Look up the OSAL priority of a task.  Returns false if the
+ *           ID does not refer to an OSAL task (e.g. the main thread).
+ *           Only called on the slow path after a long wait.
+ *
+ *-----------------------------------------------------------------*/
+static bool OS_MutSemDiagGetPriority(uint32 task_id, uint32 *priority)
+{
+   OS_task_prop_t task_prop;
+
+   if (task_id == 0 || OS_TaskGetInfo(task_id, &task_prop) != OS_SUCCESS)
+   {
+      return false;
+   }
+
+   *priority = task_prop.priority;
+   return true;
+} /* end OS_MutSemDiagGetPriority */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemDiagTaken
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Update the diagnostic state after the calling task has
+ *           acquired the mutex.  The record is only modified while the
+ *           mutex is held, so no additional locking is needed.
+ *
+ *           "contended", "prev_owner" and "start_time" were sampled before
+ *           the take, contended is set if the mutex was held by another task.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_MutSemDiagTaken(uint32 local_id, uint32 self_id, bool contended, uint32 prev_owner, const OS_time_t *start_time)
+{
+   OS_mutex_internal_record_t *mut = &OS_mutex_table[local_id];
+   OS_time_t now;
+   uint32 wait_usec;
+   uint32 self_priority;
+   uint32 owner_priority;
+
+   /* Nested take of a recursive mutex, hold time runs from the outermost take */
+   if (mut->nest_depth != 0)
+   {
+      ++mut->nest_depth;
+      return;
+   }
+
+   if (OS_GetMonotonicTime_Impl(&now) != OS_SUCCESS)
+   {
+      now = *start_time;
+   }
+
+   ++mut->take_count;
+   if (contended)
+   {
+      ++mut->contention_count;
+      wait_usec = OS_MutSemDiagElapsed(start_time, &now);
+      if (wait_usec > mut->max_wait_usec)
+      {
+         mut->max_wait_usec = wait_usec;
+      }
+
+      /* Numerically lower OSAL priority values are more important */
+      if (wait_usec > OS_MUTEX_HOLD_WARN_USEC &&
+            OS_MutSemDiagGetPriority(self_id, &self_priority) &&
+            OS_MutSemDiagGetPriority(prev_owner, &owner_priority) &&
+            self_priority < owner_priority)
+      {
+         ++mut->inversion_count;
+         OS_DEBUG("WARNING: task 0x%lx (pri %lu) blocked %lu usec on mutex %s held by task 0x%lx (pri %lu)\n",
+               (unsigned long)self_id, (unsigned long)self_priority, (unsigned long)wait_usec,
+               mut->obj_name, (unsigned long)prev_owner, (unsigned long)owner_priority);
+      }
+   }
+
+   mut->owner = self_id;
+   mut->nest_depth = 1;
+   mut->acquire_time = now;
+} /* end OS_MutSemDiagTaken */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemDiagGiving
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Update the diagnostic state before the calling task
+ *           releases the mutex.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_MutSemDiagGiving(uint32 local_id, uint32 self_id)
+{
+   OS_mutex_internal_record_t *mut = &OS_mutex_table[local_id];
+   OS_time_t now;
+   uint32 hold_usec;
+
+   /* Ignore a give from a task that does not own it, the impl will reject it */
+   if (mut->nest_depth == 0 || mut->owner != self_id)
+   {
+      return;
+   }
+
+   --mut->nest_depth;
+   if (mut->nest_depth != 0)
+   {
+      return;
+   }
+
+   if (OS_GetMonotonicTime_Impl(&now) == OS_SUCCESS)
+   {
+      hold_usec = OS_MutSemDiagElapsed(&mut->acquire_time, &now);
+      mut->last_hold_usec = hold_usec;
+      if (hold_usec > mut->max_hold_usec)
+      {
+         mut->max_hold_usec = hold_usec;
+      }
+      if (hold_usec > OS_MUTEX_HOLD_WARN_USEC)
+      {
+         ++mut->long_hold_count;
+         OS_DEBUG("WARNING: mutex %s held %lu usec by task 0x%lx\n",
+               mut->obj_name, (unsigned long)hold_usec, (unsigned long)self_id);
+      }
+   }
+
+   mut->owner = 0;
+} /* end OS_MutSemDiagGiving */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemDiagGetInfo
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Copy the diagnostic state into the property structure
+ *
+ *-----------------------------------------------------------------*/
+static void OS_MutSemDiagGetInfo(uint32 local_id, OS_mut_sem_prop_t *mut_prop)
+{
+   OS_mutex_internal_record_t *mut = &OS_mutex_table[local_id];
+   OS_time_t now;
+
+   if (mut->nest_depth != 0)
+   {
+      mut_prop->owner = mut->owner;
+      if (OS_GetMonotonicTime_Impl(&now) == OS_SUCCESS)
+      {
+         mut_prop->current_hold_usec = OS_MutSemDiagElapsed(&mut->acquire_time, &now);
+      }
+   }
+
+   mut_prop->take_count = mut->take_count;
+   mut_prop->contention_count = mut->contention_count;
+   mut_prop->inversion_count = mut->inversion_count;
+   mut_prop->long_hold_count = mut->long_hold_count;
+   mut_prop->last_hold_usec = mut->last_hold_usec;
+   mut_prop->max_hold_usec = mut->max_hold_usec;
+   mut_prop->max_wait_usec = mut->max_wait_usec;
+} /* end OS_MutSemDiagGetInfo */
+
+#endif /* OS_MUTEX_DIAGNOSTICS */
+
+
+#ifdef OS_MUTEX_LOCKDEP
+
+#define OS_MUTEX_LOCKDEP_WORDS      ((OS_MAX_MUTEXES + 31) / 32)
+
+/*
+ * Locks currently held by one task, in acquisition order.
+ * Each entry is only ever touched by the task that owns it.
+ */
+typedef struct
+{
+   uint32 task_id;
+   uint32 depth;
+   uint32 held[OS_MUTEX_LOCKDEP_MAX_HELD];
+} OS_mutex_lockdep_task_t;
+
+/*
+ * Lock order graph.  Bit "b" of OS_mutex_lockdep_order[a] is set once mutex "b"
+ * has been taken while holding mutex "a".  Mutex IDs map to a bounded array
+ * index, so the index serves directly as the hash key for each graph node.
+ * The graph is only modified with the mutex object type locked.
+ */
+static uint32                   OS_mutex_lockdep_order     [OS_MAX_MUTEXES][OS_MUTEX_LOCKDEP_WORDS];
+static uint32                   OS_mutex_lockdep_reported  [OS_MAX_MUTEXES][OS_MUTEX_LOCKDEP_WORDS];
+static OS_mutex_lockdep_task_t  OS_mutex_lockdep_task      [OS_MAX_TASKS];
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemLockDepTestBit
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *
+ *-----------------------------------------------------------------*/
+static bool OS_MutSemLockDepTestBit(const uint32 *map, uint32 bit)
+{
+   return ((map[bit >> 5] >> (bit & 0x1F)) & 1) != 0;
+} /* end OS_MutSemLockDepTestBit */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemLockDepSetBit
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_MutSemLockDepSetBit(uint32 *map, uint32 bit)
+{
+   map[bit >> 5] |= (1U << (bit & 0x1F));
+} /* end OS_MutSemLockDepSetBit */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemLockDepReset
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Forget all ordering involving a mutex table entry, when
+ *           it is reused for a new mutex.  Mutex type must be locked.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_MutSemLockDepReset(uint32 local_id)
+{
+   uint32 i;
+   uint32 mask = ~(1U << (local_id & 0x1F));
+
+   for (i = 0; i < OS_MAX_MUTEXES; ++i)
+   {
+      OS_mutex_lockdep_order[i][local_id >> 5] &= mask;
+      OS_mutex_lockdep_reported[i][local_id >> 5] &= mask;
+   }
+   memset(OS_mutex_lockdep_order[local_id], 0, sizeof(OS_mutex_lockdep_order[local_id]));
+   memset(OS_mutex_lockdep_reported[local_id], 0, sizeof(OS_mutex_lockdep_reported[local_id]));
+} /* end OS_MutSemLockDepReset */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemLockDepGetTask
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Get the held-lock stack for the calling task, or NULL
+ *           if the caller is not an OSAL task.
+ *
+ *-----------------------------------------------------------------*/
+static OS_mutex_lockdep_task_t *OS_MutSemLockDepGetTask(void)
+{
+   OS_mutex_lockdep_task_t *task;
+   uint32 task_id;
+   uint32 local_id;
+
+   task_id = OS_TaskGetId_Impl();
+   if (task_id == 0 ||
+         OS_ObjectIdToArrayIndex(OS_OBJECT_TYPE_OS_TASK, task_id, &local_id) != OS_SUCCESS)
+   {
+      return NULL;
+   }
+
+   /* A new task in this slot starts with nothing held */
+   task = &OS_mutex_lockdep_task[local_id];
+   if (task->task_id != task_id)
+   {
+      task->task_id = task_id;
+      task->depth = 0;
+   }
+
+   return task;
+} /* end OS_MutSemLockDepGetTask */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemLockDepReachable
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Returns true if the order graph has a path from "from" to "to",
+ *           i.e. "to" has (directly or indirectly) been taken while
+ *           holding "from".  Mutex type must be locked.
+ *
+ *-----------------------------------------------------------------*/
+static bool OS_MutSemLockDepReachable(uint32 from, uint32 to)
+{
+   uint32 visited[OS_MUTEX_LOCKDEP_WORDS];
+   uint32 pending[OS_MAX_MUTEXES];
+   uint32 npending;
+   uint32 node;
+   uint32 next;
+
+   memset(visited, 0, sizeof(visited));
+   OS_MutSemLockDepSetBit(visited, from);
+   pending[0] = from;
+   npending = 1;
+
+   /* each node is pushed at most once, so "pending" cannot overflow */
+   while (npending > 0)
+   {
+      node = pending[--npending];
+      if (node == to)
+      {
+         return true;
+      }
+
+      for (next = 0; next < OS_MAX_MUTEXES; ++next)
+      {
+         if (OS_MutSemLockDepTestBit(OS_mutex_lockdep_order[node], next) &&
+               !OS_MutSemLockDepTestBit(visited, next))
+         {
+            OS_MutSemLockDepSetBit(visited, next);
+            pending[npending] = next;
+            ++npending;
+         }
+      }
+   }
+
+   return false;
+} /* end OS_MutSemLockDepReachable */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemLockDepCheck
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Validate taking a mutex against the locks already held by the
+ *           calling task.  Called before blocking so that an inversion is
+ *           reported even if this take then deadlocks.
+ *
+ *           The common case, where every held->new dependency has been
+ *           seen before, is a bit test per held lock and takes no lock.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_MutSemLockDepCheck(uint32 local_id)
+{
+   OS_mutex_lockdep_task_t *task;
+   uint32 i;
+   uint32 depth;
+   uint32 held;
+
+   task = OS_MutSemLockDepGetTask();
+   if (task == NULL)
+   {
+      return;
+   }
+
+   depth = task->depth;
+   if (depth > OS_MUTEX_LOCKDEP_MAX_HELD)
+   {
+      depth = OS_MUTEX_LOCKDEP_MAX_HELD;
+   }
+
+   /* A recursive take of a mutex this task already holds cannot block */
+   for (i = 0; i < depth; ++i)
+   {
+      if (task->held[i] == local_id)
+      {
+         return;
+      }
+   }
+
+   for (i = 0; i < depth; ++i)
+   {
+      held = task->held[i];
+      if (OS_MutSemLockDepTestBit(OS_mutex_lockdep_order[held], local_id))
+      {
+         continue;
+      }
+
+      OS_Lock_Global_Impl(LOCAL_OBJID_TYPE);
+
+      if (!OS_MutSemLockDepReachable(local_id, held))
+      {
+         OS_MutSemLockDepSetBit(OS_mutex_lockdep_order[held], local_id);
+      }
+      else if (!OS_MutSemLockDepTestBit(OS_mutex_lockdep_reported[held], local_id))
+      {
+         OS_MutSemLockDepSetBit(OS_mutex_lockdep_reported[held], local_id);
+         ++OS_mutex_table[local_id].lock_order_violations;
+         OS_printf("LOCKDEP: task 0x%lx taking mutex '%s' while holding '%s' inverts the established lock order\n",
+               (unsigned long)task->task_id, OS_mutex_table[local_id].obj_name, OS_mutex_table[held].obj_name);
+      }
+
+      OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+   }
+} /* end OS_MutSemLockDepCheck */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemLockDepAcquired
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Push a mutex onto the calling task's held-lock stack
+ *
+ *-----------------------------------------------------------------*/
+static void OS_MutSemLockDepAcquired(uint32 local_id)
+{
+   OS_mutex_lockdep_task_t *task;
+
+   task = OS_MutSemLockDepGetTask();
+   if (task == NULL)
+   {
+      return;
+   }
+
+   /* Beyond the stack limit the depth is still counted, so gives stay balanced */
+   if (task->depth < OS_MUTEX_LOCKDEP_MAX_HELD)
+   {
+      task->held[task->depth] = local_id;
+   }
+   ++task->depth;
+} /* end OS_MutSemLockDepAcquired */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_MutSemLockDepRelease
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Remove a mutex from the calling task's held-lock stack.
+ *           Locks do not have to be released in reverse order.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_MutSemLockDepRelease(uint32 local_id)
+{
+   OS_mutex_lockdep_task_t *task;
+   uint32 i;
+
+   task = OS_MutSemLockDepGetTask();
+   if (task == NULL || task->depth == 0)
+   {
+      return;
+   }
+
+   if (task->depth > OS_MUTEX_LOCKDEP_MAX_HELD)
+   {
+      --task->depth;
+      return;
+   }
+
+   i = task->depth;
+   while (i > 0)
+   {
+      --i;
+      if (task->held[i] == local_id)
+      {
+         --task->depth;
+         while (i < task->depth)
+         {
+            task->held[i] = task->held[i + 1];
+            ++i;
+         }
+         break;
+      }
+   }
+} /* end OS_MutSemLockDepRelease */
+
+#endif /* OS_MUTEX_LOCKDEP */
+
 /*----------------------------------------------------------------
  *
  * Function: OS_MutexAPI_Init
@@ -70,6 +561,11 @@ OS_apiname_internal_record_t    OS_mutex_table          [LOCAL_NUM_OBJECTS];
 int32 OS_MutexAPI_Init(void)
 {
    memset(OS_mutex_table, 0, sizeof(OS_mutex_table));
+#ifdef OS_MUTEX_LOCKDEP
+   memset(OS_mutex_lockdep_order, 0, sizeof(OS_mutex_lockdep_order));
+   memset(OS_mutex_lockdep_reported, 0, sizeof(OS_mutex_lockdep_reported));
+   memset(OS_mutex_lockdep_task, 0, sizeof(OS_mutex_lockdep_task));
+#endif
    return OS_SUCCESS;
 } /* end OS_MutexAPI_Init */
 
@@ -104,8 +600,12 @@ int32 OS_MutSemCreate (uint32 *sem_id, const char *sem_name, uint32 options)
    if(return_code == OS_SUCCESS)
    {
       /* Save all the data to our own internal table */
+      memset(&OS_mutex_table[local_id], 0, sizeof(OS_mutex_internal_record_t));
       strcpy(OS_mutex_table[local_id].obj_name, sem_name);
       record->name_entry = OS_mutex_table[local_id].obj_name;
+#ifdef OS_MUTEX_LOCKDEP
+      OS_MutSemLockDepReset(local_id);
+#endif
 
       /* Now call the OS-specific implementation.  This reads info from the table. */
       return_code = OS_MutSemCreate_Impl(local_id, options);
@@ -170,6 +670,12 @@ int32 OS_MutSemGive ( uint32 sem_id )
     return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, sem_id, &local_id, &record);
     if (return_code == OS_SUCCESS)
     {
+#ifdef OS_MUTEX_DIAGNOSTICS
+       OS_MutSemDiagGiving(local_id, OS_TaskGetId_Impl());
+#endif
+#ifdef OS_MUTEX_LOCKDEP
+       OS_MutSemLockDepRelease(local_id);
+#endif
        return_code = OS_MutSemGive_Impl (local_id);
     }
 
@@ -191,12 +697,46 @@ int32 OS_MutSemTake ( uint32 sem_id )
    OS_common_record_t *record;
    uint32 local_id;
    int32 return_code;
+#ifdef OS_MUTEX_DIAGNOSTICS
+   uint32 self_id;
+   uint32 prev_owner;
+   bool contended;
+   OS_time_t start_time;
+#endif
 
     /* Check Parameters */
     return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, sem_id, &local_id, &record);
     if (return_code == OS_SUCCESS)
     {
+#ifdef OS_MUTEX_DIAGNOSTICS
+       /*
+        * Sample the owner before blocking.  This read is not synchronized,
+        * but the result is only used for statistics.
+        */
+       self_id = OS_TaskGetId_Impl();
+       prev_owner = OS_mutex_table[local_id].owner;
+       contended = (OS_mutex_table[local_id].nest_depth != 0 && prev_owner != self_id);
+       if (OS_GetMonotonicTime_Impl(&start_time) != OS_SUCCESS)
+       {
+          memset(&start_time, 0, sizeof(start_time));
+       }
+#endif
+#ifdef OS_MUTEX_LOCKDEP
+       OS_MutSemLockDepCheck(local_id);
+#endif
        return_code = OS_MutSemTake_Impl (local_id);
+#ifdef OS_MUTEX_DIAGNOSTICS
+       if (return_code == OS_SUCCESS)
+       {
+          OS_MutSemDiagTaken(local_id, self_id, contended, prev_owner, &start_time);
+       }
+#endif
+#ifdef OS_MUTEX_LOCKDEP
+       if (return_code == OS_SUCCESS)
+       {
+          OS_MutSemLockDepAcquired(local_id);
+       }
+#endif
     }
 
     return return_code;
@@ -255,6 +795,13 @@ int32 OS_MutSemGetInfo (uint32 sem_id, OS_mut_sem_prop_t *mut_prop)
       strncpy(mut_prop->name, record->name_entry, OS_MAX_API_NAME - 1);
       mut_prop->creator =    record->creator;
 
+#ifdef OS_MUTEX_DIAGNOSTICS
+      OS_MutSemDiagGetInfo(local_id, mut_prop);
+#endif
+#ifdef OS_MUTEX_LOCKDEP
+      mut_prop->lock_order_violations = OS_mutex_table[local_id].lock_order_violations;
+#endif
+
       return_code = OS_MutSemGetInfo_Impl(local_id, mut_prop);
 
       OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
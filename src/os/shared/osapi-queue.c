@@ -57,6 +57,40 @@ enum
 OS_queue_internal_record_t    OS_queue_table          [LOCAL_NUM_OBJECTS];
 
 
+/****************************************************************************************
+                                  MESSAGE QUEUE HELPERS
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_QueueFiberGet
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Get a message from a fiber, letting the other fibers of
+ *           the task run while the queue is empty
+ *
+ *  returns: OS_QUEUE_TIMEOUT if the wait timed out
+ *
+ *-----------------------------------------------------------------*/
+static int32 OS_QueueFiberGet(uint32 local_id, void *data, uint32 size, uint32 *size_copied, OS_fiber_wait_t *wait)
+{
+   int32 return_code;
+
+   do
+   {
+      return_code = OS_QueueGet_Impl(local_id, data, size, size_copied, OS_CHECK);
+   }
+   while (return_code == OS_QUEUE_EMPTY && OS_FiberWaitRetry(wait));
+
+   if (return_code == OS_QUEUE_EMPTY)
+   {
+      return_code = OS_QUEUE_TIMEOUT;
+   }
+
+   return return_code;
+} /* end OS_QueueFiberGet */
+
+
 /****************************************************************************************
                                 MESSAGE QUEUE API
  ***************************************************************************************/
@@ -171,6 +205,7 @@ int32 OS_QueueGet (uint32 queue_id, void *data, uint32 size, uint32 *size_copied
    OS_common_record_t *record;
    uint32 local_id;
    int32 return_code;
+   OS_fiber_wait_t wait;
 
    /* Check Parameters */
    if (data == NULL || size_copied == NULL)
@@ -190,6 +225,10 @@ int32 OS_QueueGet (uint32 queue_id, void *data, uint32 size, uint32 *size_copied
              *size_copied = 0;
              return_code = OS_QUEUE_INVALID_SIZE;
          }
+         else if (timeout != OS_CHECK && OS_FiberWaitStart(&wait, (int64)timeout * 1000))
+         {
+            return_code = OS_QueueFiberGet(local_id, data, size, size_copied, &wait);
+         }
          else
          {
             return_code = OS_QueueGet_Impl (local_id, data, size, size_copied, timeout);
@@ -201,6 +240,54 @@ int32 OS_QueueGet (uint32 queue_id, void *data, uint32 size, uint32 *size_copied
 } /* end OS_QueueGet */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_QueueGetMicros
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_QueueGetMicros (uint32 queue_id, void *data, uint32 size, uint32 *size_copied, int32 timeout_usec)
+{
+   OS_common_record_t *record;
+   uint32 local_id;
+   int32 return_code;
+   OS_fiber_wait_t wait;
+
+   /* Check Parameters */
+   if (data == NULL || size_copied == NULL)
+   {
+      return_code = OS_INVALID_POINTER;
+   }
+   else
+   {
+      return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, queue_id, &local_id, &record);
+      if (return_code == OS_SUCCESS)
+      {
+         if (size < OS_queue_table[local_id].max_size)
+         {
+             /*
+             ** The buffer that the user is passing in is potentially too small
+             */
+             *size_copied = 0;
+             return_code = OS_QUEUE_INVALID_SIZE;
+         }
+         else if (timeout_usec != OS_CHECK && OS_FiberWaitStart(&wait, timeout_usec))
+         {
+            return_code = OS_QueueFiberGet(local_id, data, size, size_copied, &wait);
+         }
+         else
+         {
+            return_code = OS_QueueGetMicros_Impl (local_id, data, size, size_copied, timeout_usec);
+         }
+      }
+   }
+
+   return return_code;
+} /* end OS_QueueGetMicros */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_QueuePut
@@ -226,6 +313,12 @@ int32 OS_QueuePut (uint32 queue_id, const void *data, uint32 size, uint32 flags)
       if (return_code == OS_SUCCESS)
       {
          return_code = OS_QueuePut_Impl (local_id, data, size, flags);
+
+         /* wake any fibers waiting for a message */
+         if (return_code == OS_SUCCESS)
+         {
+            OS_FiberNotify();
+         }
       }
    }
 
@@ -268,6 +268,12 @@ int32 OS_SocketAccept(uint32 sock_id, uint32 *connsock_id, OS_SockAddr_t *Addr,
    {
       OS_SocketAddrInit_Impl(Addr, OS_stream_table[local_id].socket_domain);
 
+      /* a fiber waits for the connection while the other fibers of its task run */
+      if (timeout != OS_CHECK && OS_FiberWaitStream(local_id, OS_STREAM_STATE_READABLE, timeout))
+      {
+         timeout = OS_CHECK;
+      }
+
       /* The actual accept impl is done without global table lock, only refcount lock */
       return_code = OS_SocketAccept_Impl(local_id, conn_id, Addr, timeout);
 
@@ -385,6 +391,12 @@ int32 OS_SocketRecvFrom(uint32 sock_id, void *buffer, uint32 buflen, OS_SockAddr
       }
       else
       {
+         /* a fiber waits for the datagram while the other fibers of its task run */
+         if (timeout != OS_CHECK && OS_FiberWaitStream(local_id, OS_STREAM_STATE_READABLE, timeout))
+         {
+            timeout = OS_CHECK;
+         }
+
          return_code = OS_SocketRecvFrom_Impl (local_id, buffer, buflen, RemoteAddr, timeout);
       }
 
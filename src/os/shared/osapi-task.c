@@ -55,6 +55,136 @@ enum
 
 OS_task_internal_record_t    OS_task_table          [LOCAL_NUM_OBJECTS];
 
+/*
+ * Task-local storage keys.  Keys are handed out in order and never
+ * freed, so any key below the count is valid.
+ */
+static OS_TaskKeyDestructor_t OS_task_key_destructor [OS_MAX_TASK_KEYS];
+static uint32                 OS_task_key_count;
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskTimeToMicros
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Converts a monotonic time value to a 64-bit microsecond count
+ *           so release points can be compared and advanced without
+ *           having to carry between the seconds and microseconds fields.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_TaskTimeToMicros(const OS_time_t *time_struct)
+{
+   return ((uint64)time_struct->seconds * 1000000) + time_struct->microsecs;
+} /* end OS_TaskTimeToMicros */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskMicrosToTime
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Inverse of OS_TaskTimeToMicros()
+ *
+ *-----------------------------------------------------------------*/
+static void OS_TaskMicrosToTime(uint64 usecs, OS_time_t *time_struct)
+{
+   time_struct->seconds = (uint32)(usecs / 1000000);
+   time_struct->microsecs = (uint32)(usecs % 1000000);
+} /* end OS_TaskMicrosToTime */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskFillStats
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Fills the part of one statistics entry that is read from
+ *           the task table, and gets the OS thread ID from which the
+ *           rest is filled by OS_TaskGetThreadStats_Impl() afterwards.
+ *           The caller must hold the task table lock.
+ *
+ *-----------------------------------------------------------------*/
+static int32 OS_TaskFillStats(uint32 local_id, const OS_common_record_t *record, OS_task_stats_t *task_stats,
+        uint32 *os_thread_id)
+{
+   memset(task_stats, 0, sizeof(OS_task_stats_t));
+   *os_thread_id = 0;
+
+   task_stats->task_id = record->active_id;
+   if (record->name_entry != NULL)
+   {
+      strncpy(task_stats->name, record->name_entry, sizeof(task_stats->name)-1);
+      task_stats->name[sizeof(task_stats->name)-1] = 0;
+   }
+
+   return OS_TaskGetStats_Impl(local_id, task_stats, os_thread_id);
+} /* end OS_TaskFillStats */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskTakeLocalValues
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Moves the task-local values of an ending task into the
+ *           supplied array and clears them in the task record, so the
+ *           destructors can be called once the lock is released.
+ *           The caller must hold the task table lock.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_TaskTakeLocalValues(uint32 local_id, void **values)
+{
+   memcpy(values, OS_task_table[local_id].local_values, sizeof(OS_task_table[local_id].local_values));
+   memset(OS_task_table[local_id].local_values, 0, sizeof(OS_task_table[local_id].local_values));
+} /* end OS_TaskTakeLocalValues */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskReleaseLocalValues
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Calls the key destructors for values collected by
+ *           OS_TaskTakeLocalValues().  Must be called unlocked.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_TaskReleaseLocalValues(void **values)
+{
+   uint32 key;
+
+   for (key = 0; key < OS_task_key_count; ++key)
+   {
+      if (values[key] != NULL && OS_task_key_destructor[key] != NULL)
+      {
+         OS_task_key_destructor[key](values[key]);
+      }
+   }
+} /* end OS_TaskReleaseLocalValues */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskKeyLookupSelf
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Validates a task-local key and finds the task table entry
+ *           of the caller.  No lock is needed as only the task itself
+ *           accesses its own values while it is running.
+ *
+ *-----------------------------------------------------------------*/
+static int32 OS_TaskKeyLookupSelf(uint32 key, uint32 *local_id)
+{
+   uint32 task_id;
+
+   if (key >= OS_task_key_count)
+   {
+      return OS_ERR_INVALID_ID;
+   }
+
+   task_id = OS_TaskGetSelf_Impl(local_id);
+   if (task_id == 0 || OS_global_task_table[*local_id].active_id != task_id)
+   {
+      return OS_ERR_INVALID_ID;
+   }
+
+   return OS_SUCCESS;
+} /* end OS_TaskKeyLookupSelf */
 
 /*----------------------------------------------------------------
  *
@@ -161,6 +291,8 @@ void OS_TaskEntryPoint(uint32 task_id)
 int32 OS_TaskAPI_Init(void)
 {
    memset(OS_task_table, 0, sizeof(OS_task_table));
+   memset(OS_task_key_destructor, 0, sizeof(OS_task_key_destructor));
+   OS_task_key_count = 0;
    return OS_SUCCESS;
 } /* end OS_TaskAPI_Init */
 
@@ -176,6 +308,25 @@ int32 OS_TaskAPI_Init(void)
  *-----------------------------------------------------------------*/
 int32 OS_TaskCreate (uint32 *task_id, const char *task_name, osal_task_entry function_pointer,
                       uint32 *stack_pointer, uint32 stack_size, uint32 priority, uint32 flags)
+{
+   /* no placement restriction - the task may run on any CPU */
+   return OS_TaskCreateAffinity(task_id, task_name, function_pointer, stack_pointer,
+         stack_size, priority, flags, 0);
+} /* end OS_TaskCreate */
+
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskCreateAffinity
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskCreateAffinity (uint32 *task_id, const char *task_name, osal_task_entry function_pointer,
+                      uint32 *stack_pointer, uint32 stack_size, uint32 priority, uint32 flags,
+                      uint32 cpu_mask)
 {
    OS_common_record_t *record;
    int32             return_code;
@@ -213,6 +364,7 @@ int32 OS_TaskCreate (uint32 *task_id, const char *task_name, osal_task_entry fun
       OS_task_table[local_id].priority = priority;
       OS_task_table[local_id].entry_function_pointer = function_pointer;
       OS_task_table[local_id].stack_pointer = stack_pointer;
+      OS_task_table[local_id].cpu_mask = cpu_mask;
 
       /* Now call the OS-specific implementation.  This reads info from the task table. */
       return_code = OS_TaskCreate_Impl(local_id, flags);
@@ -224,7 +376,7 @@ int32 OS_TaskCreate (uint32 *task_id, const char *task_name, osal_task_entry fun
 
 
    return return_code;
-} /* end OS_TaskCreate */
+} /* end OS_TaskCreateAffinity */
 
 
                         
@@ -242,8 +394,10 @@ int32 OS_TaskDelete (uint32 task_id)
    int32             return_code;
    uint32            local_id;
    osal_task_entry   delete_hook;
+   void              *local_values[OS_MAX_TASK_KEYS];
 
    delete_hook = NULL;
+   memset(local_values, 0, sizeof(local_values));
    return_code = OS_ObjectIdGetById(OS_LOCK_MODE_EXCLUSIVE, LOCAL_OBJID_TYPE, task_id, &local_id, &record);
    if (return_code == OS_SUCCESS)
    {
@@ -257,6 +411,7 @@ int32 OS_TaskDelete (uint32 task_id)
       {
          /* Only need to clear the ID as zero is the "unused" flag */
          record->active_id = 0;
+         OS_TaskTakeLocalValues(local_id, local_values);
       }
       else
       {
@@ -274,6 +429,8 @@ int32 OS_TaskDelete (uint32 task_id)
       delete_hook();
    }
 
+   OS_TaskReleaseLocalValues(local_values);
+
    return return_code;
 } /* end OS_TaskDelete */
 
@@ -291,15 +448,20 @@ void OS_TaskExit()
    OS_common_record_t *record;
    uint32 task_id;
    uint32 local_id;
+   void   *local_values[OS_MAX_TASK_KEYS];
 
+   memset(local_values, 0, sizeof(local_values));
    task_id = OS_TaskGetId_Impl();
    if (OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL, LOCAL_OBJID_TYPE, task_id, &local_id, &record) == OS_SUCCESS)
    {
       /* Only need to clear the ID as zero is the "unused" flag */
       record->active_id = 0;
+      OS_TaskTakeLocalValues(local_id, local_values);
       OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
    }
 
+   OS_TaskReleaseLocalValues(local_values);
+
    /* call the implementation */
    OS_TaskExit_Impl();
 
@@ -317,11 +479,158 @@ void OS_TaskExit()
  *-----------------------------------------------------------------*/
 int32 OS_TaskDelay(uint32 millisecond)
 {
+   /* a fiber lets the other fibers of its task run instead */
+   if (OS_FiberSleep((uint64)millisecond * 1000))
+   {
+      return OS_SUCCESS;
+   }
+
    /* just call the implementation */
    return OS_TaskDelay_Impl(millisecond);
 } /* end OS_TaskDelay */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskDelayMicros
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskDelayMicros(uint32 microsecond)
+{
+   /* a fiber lets the other fibers of its task run instead */
+   if (OS_FiberSleep(microsecond))
+   {
+      return OS_SUCCESS;
+   }
+
+   /* just call the implementation */
+   return OS_TaskDelayMicros_Impl(microsecond);
+} /* end OS_TaskDelayMicros */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskSetPeriod
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskSetPeriod(uint32 period_usec)
+{
+   OS_common_record_t *record;
+   OS_time_t now;
+   int32 return_code;
+   uint32 local_id;
+   uint32 task_id;
+
+   task_id = OS_TaskGetId_Impl();
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL, LOCAL_OBJID_TYPE, task_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_GetMonotonicTime_Impl(&now);
+      if (return_code == OS_SUCCESS)
+      {
+         OS_TaskMicrosToTime(OS_TaskTimeToMicros(&now) + period_usec,
+               &OS_task_table[local_id].next_release);
+         OS_task_table[local_id].period_usec = period_usec;
+         OS_task_table[local_id].period_cycles = 0;
+         OS_task_table[local_id].period_overruns = 0;
+      }
+
+      OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+   }
+
+   return return_code;
+} /* end OS_TaskSetPeriod */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskWaitPeriod
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskWaitPeriod(uint32 *overruns)
+{
+   OS_common_record_t *record;
+   OS_time_t now;
+   OS_time_t wake_time;
+   uint64 release;
+   uint64 current;
+   uint32 missed;
+   uint32 local_id;
+   uint32 task_id;
+   int32 return_code;
+
+   missed = 0;
+   task_id = OS_TaskGetId_Impl();
+
+   /*
+    * Only the task itself advances its own schedule, but the global
+    * lock is held while doing so to keep OS_TaskGetInfo() consistent.
+    * It is always released before sleeping.
+    */
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL, LOCAL_OBJID_TYPE, task_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      if (OS_task_table[local_id].period_usec == 0)
+      {
+         return_code = OS_ERR_INCORRECT_OBJ_STATE;
+      }
+      else
+      {
+         return_code = OS_GetMonotonicTime_Impl(&now);
+      }
+
+      if (return_code == OS_SUCCESS)
+      {
+         wake_time = OS_task_table[local_id].next_release;
+         release = OS_TaskTimeToMicros(&wake_time);
+         current = OS_TaskTimeToMicros(&now);
+
+         if (current >= release)
+         {
+            /*
+             * Overrun - the release point has already passed.
+             * Skip to the first release point still in the future
+             * so the task remains phase aligned, and do not sleep.
+             */
+            missed = (uint32)((current - release) / OS_task_table[local_id].period_usec) + 1;
+            release += (uint64)missed * OS_task_table[local_id].period_usec;
+            OS_task_table[local_id].period_overruns += missed;
+         }
+         else
+         {
+            release += OS_task_table[local_id].period_usec;
+         }
+
+         OS_TaskMicrosToTime(release, &OS_task_table[local_id].next_release);
+         ++OS_task_table[local_id].period_cycles;
+      }
+
+      OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+   }
+
+   if (return_code == OS_SUCCESS && missed == 0)
+   {
+      return_code = OS_TaskDelayUntil_Impl(&wake_time);
+   }
+
+   if (overruns != NULL)
+   {
+      *overruns = missed;
+   }
+
+   return return_code;
+} /* end OS_TaskWaitPeriod */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_TaskSetPriority
@@ -362,6 +671,97 @@ int32 OS_TaskSetPriority (uint32 task_id, uint32 new_priority)
    return return_code;
 } /* end OS_TaskSetPriority */
 
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskSetAffinity
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskSetAffinity (uint32 task_id, uint32 cpu_mask)
+{
+   OS_common_record_t *record;
+   int32             return_code;
+   uint32            local_id;
+
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL, LOCAL_OBJID_TYPE, task_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_TaskSetAffinity_Impl(local_id, cpu_mask);
+
+      /* Only record the new mask if the OS accepted it */
+      if (return_code == OS_SUCCESS)
+      {
+         OS_task_table[local_id].cpu_mask = cpu_mask;
+      }
+
+      OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+   }
+
+   return return_code;
+} /* end OS_TaskSetAffinity */
+
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskSetDeadline
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskSetDeadline (uint32 task_id, uint32 runtime_usec, uint32 deadline_usec, uint32 period_usec)
+{
+   OS_common_record_t *record;
+   int32             return_code;
+   uint32            local_id;
+
+   if (runtime_usec == 0)
+   {
+      /* disabling - the other times are irrelevant */
+      deadline_usec = 0;
+      period_usec = 0;
+   }
+   else
+   {
+      /* A zero deadline or period defaults to the other one */
+      if (deadline_usec == 0)
+      {
+         deadline_usec = period_usec;
+      }
+      if (period_usec == 0)
+      {
+         period_usec = deadline_usec;
+      }
+
+      if (deadline_usec == 0 || runtime_usec > deadline_usec || deadline_usec > period_usec)
+      {
+         return OS_ERROR;
+      }
+   }
+
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL, LOCAL_OBJID_TYPE, task_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_TaskSetDeadline_Impl(local_id, runtime_usec, deadline_usec, period_usec);
+
+      /* Only record the reservation if the OS accepted it */
+      if (return_code == OS_SUCCESS)
+      {
+         OS_task_table[local_id].deadline_runtime_usec = runtime_usec;
+         OS_task_table[local_id].deadline_usec = deadline_usec;
+         OS_task_table[local_id].deadline_period_usec = period_usec;
+      }
+
+      OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+   }
+
+   return return_code;
+} /* end OS_TaskSetDeadline */
+
 
                         
 /*----------------------------------------------------------------
@@ -395,15 +795,19 @@ int32 OS_TaskRegister (void)
  *-----------------------------------------------------------------*/
 uint32 OS_TaskGetId (void)
 {
-   OS_common_record_t *record;
    uint32 local_id;
    uint32 task_id;
 
-   task_id = OS_TaskGetId_Impl();
+   /*
+    * This is called on every object creation to record the creator,
+    * so it uses the table index the implementation keeps alongside
+    * the ID rather than a full OS_ObjectIdGetById() lookup.
+    */
+   task_id = OS_TaskGetSelf_Impl(&local_id);
 
    /* Confirm the task master table entry matches the expected.
     * If not it means we have some stale/leftover value */
-   if (OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, task_id, &local_id, &record) != OS_SUCCESS)
+   if (task_id != 0 && OS_global_task_table[local_id].active_id != task_id)
    {
       task_id = 0;
    }
@@ -469,6 +873,13 @@ int32 OS_TaskGetInfo (uint32 task_id, OS_task_prop_t *task_prop)
       task_prop->creator =    record->creator;
       task_prop->stack_size = OS_task_table[local_id].stack_size;
       task_prop->priority =   OS_task_table[local_id].priority;
+      task_prop->cpu_mask =   OS_task_table[local_id].cpu_mask;
+      task_prop->period_usec = OS_task_table[local_id].period_usec;
+      task_prop->period_cycles = OS_task_table[local_id].period_cycles;
+      task_prop->period_overruns = OS_task_table[local_id].period_overruns;
+      task_prop->deadline_runtime_usec = OS_task_table[local_id].deadline_runtime_usec;
+      task_prop->deadline_usec = OS_task_table[local_id].deadline_usec;
+      task_prop->deadline_period_usec = OS_task_table[local_id].deadline_period_usec;
 
       return_code = OS_TaskGetInfo_Impl(local_id, task_prop);
 
@@ -480,6 +891,233 @@ int32 OS_TaskGetInfo (uint32 task_id, OS_task_prop_t *task_prop)
 } /* end OS_TaskGetInfo */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskGetStats
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskGetStats (uint32 task_id, OS_task_stats_t *task_stats)
+{
+   OS_common_record_t *record;
+   int32             return_code;
+   uint32            local_id;
+   uint32            os_thread_id;
+
+   /* Check parameters */
+   if (task_stats == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   memset(task_stats,0,sizeof(OS_task_stats_t));
+
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL,LOCAL_OBJID_TYPE, task_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_TaskFillStats(local_id, record, task_stats, &os_thread_id);
+
+      OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+
+      if (return_code == OS_SUCCESS && os_thread_id != 0)
+      {
+         OS_TaskGetThreadStats_Impl(os_thread_id, task_stats);
+      }
+   }
+
+   return return_code;
+
+} /* end OS_TaskGetStats */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskStatsSnapshot
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskStatsSnapshot (OS_task_stats_t *task_stats, uint32 max_entries, uint32 *num_entries)
+{
+   OS_common_record_t *record;
+   int32             return_code;
+   int32             stats_code;
+   uint32            local_id;
+   uint32            count;
+   uint32            i;
+   uint32            os_thread_ids[LOCAL_NUM_OBJECTS];
+
+   /* Check parameters */
+   if (task_stats == NULL || num_entries == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   return_code = OS_SUCCESS;
+   count = 0;
+
+   OS_Lock_Global_Impl(LOCAL_OBJID_TYPE);
+
+   for (local_id = 0; local_id < LOCAL_NUM_OBJECTS && count < max_entries; ++local_id)
+   {
+      record = &OS_global_task_table[local_id];
+      if (record->active_id != 0)
+      {
+         stats_code = OS_TaskFillStats(local_id, record, &task_stats[count], &os_thread_ids[count]);
+
+         /*
+          * A task that is in the middle of exiting may no longer be
+          * queryable.  It is still reported, with whatever the OS could
+          * provide.  Only a lack of OS support fails the whole snapshot.
+          */
+         if (stats_code == OS_ERR_NOT_IMPLEMENTED)
+         {
+            return_code = stats_code;
+            break;
+         }
+
+         ++count;
+      }
+   }
+
+   OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+
+   /*
+    * The remaining statistics may take a while to read, so this is done
+    * from the thread IDs collected above, without holding the lock.
+    */
+   for (i = 0; i < count; ++i)
+   {
+      if (os_thread_ids[i] != 0)
+      {
+         OS_TaskGetThreadStats_Impl(os_thread_ids[i], &task_stats[i]);
+      }
+   }
+
+   *num_entries = count;
+
+   return return_code;
+
+} /* end OS_TaskStatsSnapshot */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskGetStackPoolStats
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskGetStackPoolStats (OS_stack_pool_stats_t *stats)
+{
+   if (stats == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   memset(stats, 0, sizeof(*stats));
+
+   return OS_TaskGetStackPoolStats_Impl(stats);
+
+} /* end OS_TaskGetStackPoolStats */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskKeyCreate
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskKeyCreate (uint32 *key, OS_TaskKeyDestructor_t destructor)
+{
+   int32 return_code;
+
+   if (key == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   OS_Lock_Global_Impl(LOCAL_OBJID_TYPE);
+
+   if (OS_task_key_count >= OS_MAX_TASK_KEYS)
+   {
+      return_code = OS_ERR_NO_FREE_IDS;
+   }
+   else
+   {
+      OS_task_key_destructor[OS_task_key_count] = destructor;
+      *key = OS_task_key_count;
+      ++OS_task_key_count;
+      return_code = OS_SUCCESS;
+   }
+
+   OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+
+   return return_code;
+} /* end OS_TaskKeyCreate */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskKeySet
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskKeySet (uint32 key, void *value)
+{
+   int32  return_code;
+   uint32 local_id;
+
+   return_code = OS_TaskKeyLookupSelf(key, &local_id);
+   if (return_code == OS_SUCCESS)
+   {
+      OS_task_table[local_id].local_values[key] = value;
+   }
+
+   return return_code;
+} /* end OS_TaskKeySet */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskKeyGet
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskKeyGet (uint32 key, void **value)
+{
+   int32  return_code;
+   uint32 local_id;
+
+   if (value == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   return_code = OS_TaskKeyLookupSelf(key, &local_id);
+   if (return_code == OS_SUCCESS)
+   {
+      *value = OS_task_table[local_id].local_values[key];
+   }
+   else
+   {
+      *value = NULL;
+   }
+
+   return return_code;
+} /* end OS_TaskKeyGet */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_TaskInstallDeleteHandler
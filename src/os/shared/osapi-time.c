@@ -43,6 +43,11 @@
 #error "osconfig.h must define OS_MAX_TIMERS to a valid value"
 #endif
 
+/*
+ * Poll interval of OS_TimerDelete() while the dispatched callback of
+ * the timer is running on a worker pool.
+ */
+#define OS_TIMER_DISPATCH_POLL_MSEC     10
 
 
 OS_timecb_internal_record_t      OS_timecb_table             [OS_MAX_TIMERS];
@@ -88,8 +93,6 @@ static int32 OS_DoTimerAdd(uint32 *timer_id, const char *timer_name, uint32 time
     int32             return_code;
     uint32            local_id;
     uint32            timebase_local_id;
-    uint32            cb_list;
-    uint32            attach_id;
 
     /*
      ** Check Parameters
@@ -152,28 +155,10 @@ static int32 OS_DoTimerAdd(uint32 *timer_id, const char *timer_name, uint32 time
        local->callback_arg = callback_arg;
        local->timebase_ref = timebase_local_id;
        local->flags = flags;
-       local->prev_ref = local_id;
-       local->next_ref = local_id;
 
        /*
-        * Now we need to add it to the time base callback ring, so take the
-        * timebase-specific lock to prevent a tick from being processed at this moment.
+        * The timer is not put on the timing wheel of the time base until it is set.
         */
-       OS_TimeBaseLock_Impl(timebase_local_id);
-
-       cb_list = OS_timebase_table[timebase_local_id].first_cb;
-       OS_timebase_table[timebase_local_id].first_cb = record->active_id;
-
-       if (cb_list != 0)
-       {
-           OS_ObjectIdToArrayIndex(OS_OBJECT_TYPE_OS_TIMECB, cb_list, &attach_id);
-           local->next_ref = attach_id;
-           local->prev_ref = OS_timecb_table[attach_id].prev_ref;
-           OS_timecb_table[local->prev_ref].next_ref = local_id;
-           OS_timecb_table[local->next_ref].prev_ref = local_id;
-       }
-
-       OS_TimeBaseUnlock_Impl(timebase_local_id);
 
        /* Check result, finalize record, and unlock global table. */
        return_code = OS_ObjectIdFinalizeNew(return_code, record, timer_id);
@@ -295,6 +280,72 @@ int32 OS_TimerCreate(uint32 *timer_id, const char *timer_name, uint32 *accuracy,
 
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Timer_BaseTime
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Get the time that the start time of a timer on the given
+ *           time base is relative to.  Must be called with the time
+ *           base lock held.
+ *
+ *-----------------------------------------------------------------*/
+static uint64 OS_Timer_BaseTime(uint32 timebase_ref)
+{
+   uint64 base_time;
+
+   base_time = OS_timebase_table[timebase_ref].wheel_time;
+   if (OS_timebase_table[timebase_ref].tickless)
+   {
+       /*
+        * The wheel time of a tickless time base lags behind by the
+        * intervals skipped since the last tick, which the next tick
+        * will report all at once.
+        */
+       base_time += OS_TimeBaseSkippedTime_Impl(timebase_ref);
+   }
+
+   return base_time;
+} /* end OS_Timer_BaseTime */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Timer_Arm
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Set the expiry and interval of a timer and link it into the
+ *           wheel of its time base.  Must be called with the time base
+ *           lock held, followed by OS_Timer_ArmDone() before unlocking.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_Timer_Arm(uint32 local_id, uint64 expiry_time, uint64 interval_time)
+{
+   OS_timecb_internal_record_t *local;
+
+   local = &OS_timecb_table[local_id];
+   local->expiry_time = expiry_time;
+   local->interval_time = (int64)interval_time;
+
+   OS_TimerWheelArm(local->timebase_ref, local_id);
+} /* end OS_Timer_Arm */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Timer_ArmDone
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Reprogram a tickless time base for the timers armed on it.
+ *           Must be called with the time base lock held.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_Timer_ArmDone(uint32 timebase_ref)
+{
+   if (OS_timebase_table[timebase_ref].tickless)
+   {
+       OS_TimeBaseNextDue_Impl(timebase_ref, 0, OS_TimerWheelNextDue(timebase_ref));
+   }
+} /* end OS_Timer_ArmDone */
+
 /*----------------------------------------------------------------
  *
  * Function: OS_TimerSet
@@ -304,6 +355,24 @@ int32 OS_TimerCreate(uint32 *timer_id, const char *timer_name, uint32 *accuracy,
  *
  *-----------------------------------------------------------------*/
 int32 OS_TimerSet(uint32 timer_id, uint32 start_time, uint32 interval_time)
+{
+   if (start_time >= INT_MAX || interval_time >= INT_MAX)
+   {
+       return OS_TIMER_ERR_INVALID_ARGS;
+   }
+
+   return OS_TimerSetNs(timer_id, (uint64)start_time * 1000, (uint64)interval_time * 1000);
+} /* end OS_TimerSet */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerSetNs
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TimerSetNs(uint32 timer_id, uint64 start_time, uint64 interval_time)
 {
    OS_common_record_t *record;
    OS_timecb_internal_record_t *local;
@@ -313,7 +382,7 @@ int32 OS_TimerSet(uint32 timer_id, uint32 start_time, uint32 interval_time)
 
    dedicated_timebase_id = 0;
 
-   if (start_time >= INT_MAX || interval_time >= INT_MAX)
+   if (start_time >= OS_TIMEBASE_NS_LIMIT || interval_time >= OS_TIMEBASE_NS_LIMIT)
    {
        return OS_TIMER_ERR_INVALID_ARGS;
    }
@@ -346,8 +415,8 @@ int32 OS_TimerSet(uint32 timer_id, uint32 start_time, uint32 interval_time)
            dedicated_timebase_id = OS_global_timebase_table[local->timebase_ref].active_id;
        }
 
-       local->wait_time = (int32)start_time;
-       local->interval_time = (int32)interval_time;
+       OS_Timer_Arm(local_id, OS_Timer_BaseTime(local->timebase_ref) + start_time, interval_time);
+       OS_Timer_ArmDone(local->timebase_ref);
 
        OS_TimeBaseUnlock_Impl(local->timebase_ref);
 
@@ -370,10 +439,330 @@ int32 OS_TimerSet(uint32 timer_id, uint32 start_time, uint32 interval_time)
     */
    if (return_code == OS_SUCCESS && dedicated_timebase_id != 0)
    {
-       return_code = OS_TimeBaseSet(dedicated_timebase_id, start_time, interval_time);
+       return_code = OS_TimeBaseSetNs(dedicated_timebase_id, start_time, interval_time);
    }
    return return_code;
-} /* end OS_TimerSet */
+} /* end OS_TimerSetNs */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerSetBatchNs
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TimerSetBatchNs(const OS_timer_batch_t *batch, uint32 count, uint64 phase_step)
+{
+   OS_common_record_t *record;
+   OS_timecb_internal_record_t *local;
+   int32             return_code;
+   int32             status;
+   uint32            local_id;
+   uint32            timebase_ref;
+   uint32            dedicated_timebase_id;
+   uint64            base_time;
+   uint64            start_time;
+   uint32            i;
+   bool              locked;
+   bool              any_dedicated;
+
+   if (batch == NULL)
+   {
+       return OS_INVALID_POINTER;
+   }
+
+   if (count == 0 || phase_step >= OS_TIMEBASE_NS_LIMIT)
+   {
+       return OS_TIMER_ERR_INVALID_ARGS;
+   }
+
+   for (i = 0; i < count; ++i)
+   {
+       if (batch[i].start_time >= OS_TIMEBASE_NS_LIMIT || batch[i].interval_time >= OS_TIMEBASE_NS_LIMIT)
+       {
+           return OS_TIMER_ERR_INVALID_ARGS;
+       }
+
+       /* the phase offset must not take the start time over the limit either */
+       if (phase_step != 0 && i > (OS_TIMEBASE_NS_LIMIT - 1 - batch[i].start_time) / phase_step)
+       {
+           return OS_TIMER_ERR_INVALID_ARGS;
+       }
+
+       if (batch[i].start_time + (i * phase_step) == 0 && batch[i].interval_time == 0)
+       {
+           return OS_ERROR;
+       }
+   }
+
+   /*
+    * Check our context.  Not allowed to use the timer API from a timer callback.
+    * Just interested in the object type returned.
+    */
+   local_id = OS_TaskGetId_Impl() >> OS_OBJECT_TYPE_SHIFT;
+   if (local_id == OS_OBJECT_TYPE_OS_TIMEBASE)
+   {
+       return OS_ERR_INCORRECT_OBJ_STATE;
+   }
+
+   /*
+    * The timer table stays locked for the whole batch, so all the IDs
+    * can be checked up front, and either every timer is set or none is.
+    */
+   OS_Lock_Global_Impl(OS_OBJECT_TYPE_OS_TIMECB);
+
+   return_code = OS_SUCCESS;
+   for (i = 0; i < count && return_code == OS_SUCCESS; ++i)
+   {
+       return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, OS_OBJECT_TYPE_OS_TIMECB, batch[i].timer_id, &local_id, &record);
+   }
+
+   if (return_code == OS_SUCCESS)
+   {
+       /*
+        * Each time base is locked once for a run of timers on it.  All the
+        * start times of a run are relative to the same base time, so timers
+        * with the same start time expire on the same tick.
+        */
+       locked = false;
+       any_dedicated = false;
+       timebase_ref = 0;
+       base_time = 0;
+
+       for (i = 0; i < count; ++i)
+       {
+           OS_ObjectIdGetById(OS_LOCK_MODE_NONE, OS_OBJECT_TYPE_OS_TIMECB, batch[i].timer_id, &local_id, &record);
+           local = &OS_timecb_table[local_id];
+
+           if (!locked || local->timebase_ref != timebase_ref)
+           {
+               if (locked)
+               {
+                   OS_Timer_ArmDone(timebase_ref);
+                   OS_TimeBaseUnlock_Impl(timebase_ref);
+               }
+               timebase_ref = local->timebase_ref;
+               OS_TimeBaseLock_Impl(timebase_ref);
+               locked = true;
+               base_time = OS_Timer_BaseTime(timebase_ref);
+           }
+
+           if ((local->flags & TIMECB_FLAG_DEDICATED_TIMEBASE) != 0)
+           {
+               any_dedicated = true;
+           }
+
+           OS_Timer_Arm(local_id, base_time + batch[i].start_time + (i * phase_step), batch[i].interval_time);
+       }
+
+       OS_Timer_ArmDone(timebase_ref);
+       OS_TimeBaseUnlock_Impl(timebase_ref);
+   }
+
+   OS_Unlock_Global_Impl(OS_OBJECT_TYPE_OS_TIMECB);
+
+   if (return_code != OS_SUCCESS || !any_dedicated)
+   {
+       return return_code;
+   }
+
+   /*
+    * Timers created with OS_TimerCreate() each have a dedicated time base,
+    * which is set afterwards, one by one, as OS_TimerSetNs() does.
+    */
+   for (i = 0; i < count; ++i)
+   {
+       dedicated_timebase_id = 0;
+       start_time = batch[i].start_time + (i * phase_step);
+
+       status = OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL,OS_OBJECT_TYPE_OS_TIMECB, batch[i].timer_id, &local_id, &record);
+       if (status == OS_SUCCESS)
+       {
+           local = &OS_timecb_table[local_id];
+           if ((local->flags & TIMECB_FLAG_DEDICATED_TIMEBASE) != 0)
+           {
+               dedicated_timebase_id = OS_global_timebase_table[local->timebase_ref].active_id;
+           }
+
+           OS_Unlock_Global_Impl(OS_OBJECT_TYPE_OS_TIMECB);
+       }
+
+       if (status == OS_SUCCESS && dedicated_timebase_id != 0)
+       {
+           status = OS_TimeBaseSetNs(dedicated_timebase_id, start_time, batch[i].interval_time);
+       }
+
+       if (return_code == OS_SUCCESS)
+       {
+           return_code = status;
+       }
+   }
+
+   return return_code;
+} /* end OS_TimerSetBatchNs */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerSetDispatch
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TimerSetDispatch(uint32 timer_id, uint32 pool_id)
+{
+   OS_common_record_t *record;
+   OS_common_record_t *pool_record;
+   OS_timecb_internal_record_t *local;
+   int32             return_code;
+   uint32            local_id;
+   uint32            pool_local_id;
+
+   /*
+    * Check our context.  Not allowed to use the timer API from a timer callback.
+    * Just interested in the object type returned.
+    */
+   local_id = OS_TaskGetId_Impl() >> OS_OBJECT_TYPE_SHIFT;
+   if (local_id == OS_OBJECT_TYPE_OS_TIMEBASE)
+   {
+       return OS_ERR_INCORRECT_OBJ_STATE;
+   }
+
+   if (pool_id != 0)
+   {
+       return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, OS_OBJECT_TYPE_OS_WORKPOOL, pool_id, &pool_local_id, &pool_record);
+       if (return_code != OS_SUCCESS)
+       {
+           return return_code;
+       }
+   }
+
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL,OS_OBJECT_TYPE_OS_TIMECB, timer_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+       local = &OS_timecb_table[local_id];
+
+       OS_TimeBaseLock_Impl(local->timebase_ref);
+
+       local->dispatch_pool = pool_id;
+       if (pool_id != 0)
+       {
+           local->flags |= TIMECB_FLAG_DISPATCH;
+       }
+       else
+       {
+           local->flags &= ~TIMECB_FLAG_DISPATCH;
+       }
+
+       OS_TimeBaseUnlock_Impl(local->timebase_ref);
+
+       /* Unlock the global from OS_ObjectIdCheck() */
+       OS_Unlock_Global_Impl(OS_OBJECT_TYPE_OS_TIMECB);
+   }
+
+   return return_code;
+} /* end OS_TimerSetDispatch */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_Timer_DispatchJob
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Worker pool job that calls the callback of a timer
+ *           outside of the time base lock.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_Timer_DispatchJob(void *arg)
+{
+   OS_common_record_t *record;
+   OS_timecb_internal_record_t *local;
+   OS_ArgCallback_t  callback_ptr;
+   void              *callback_arg;
+   OS_U32ValueWrapper_t Conv;
+   uint32            local_id;
+   uint32            timebase_ref;
+   uint64            entry_usec;
+
+   Conv.opaque_arg = arg;
+
+   /* The timer may have been deleted since the job was submitted */
+   if (OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL,OS_OBJECT_TYPE_OS_TIMECB, Conv.value, &local_id, &record) != OS_SUCCESS)
+   {
+       return;
+   }
+
+   /*
+    * OS_TimerDelete() waits for the callback to return before it
+    * releases the timer, and with it the time base.
+    */
+   local = &OS_timecb_table[local_id];
+   local->dispatch_task = OS_TaskGetId_Impl();
+   callback_ptr = local->callback_ptr;
+   callback_arg = local->callback_arg;
+   timebase_ref = local->timebase_ref;
+
+   OS_Unlock_Global_Impl(OS_OBJECT_TYPE_OS_TIMECB);
+
+   entry_usec = OS_TimerLatencyNow();
+   (*callback_ptr)(Conv.value, callback_arg);
+
+   /* Unless the callback deleted the timer itself, the time base is still there */
+   OS_Lock_Global_Impl(OS_OBJECT_TYPE_OS_TIMECB);
+   if (record->active_id == Conv.value)
+   {
+       local->dispatch_task = 0;
+
+       OS_TimeBaseLock_Impl(timebase_ref);
+       OS_TimerLatencyRecord(timebase_ref, local_id, local->dispatch_nominal, entry_usec);
+       local->dispatch_busy = false;
+       OS_TimeBaseUnlock_Impl(timebase_ref);
+   }
+   OS_Unlock_Global_Impl(OS_OBJECT_TYPE_OS_TIMECB);
+} /* end OS_Timer_DispatchJob */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerDispatch
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_TimerDispatch(uint32 timer_id, uint64 nominal_usec)
+{
+   OS_timecb_internal_record_t *local;
+   OS_U32ValueWrapper_t Conv;
+
+   local = &OS_timecb_table[timer_id];
+
+   /*
+    * Only one callback of a timer is outstanding at a time, so an
+    * expiration while it is still pending would otherwise pile up.
+    */
+   if (local->dispatch_busy)
+   {
+       ++local->overruns;
+       return;
+   }
+
+   /* stays put until the job clears dispatch_busy */
+   local->dispatch_nominal = nominal_usec;
+
+   Conv.opaque_arg = NULL;
+   Conv.value = OS_global_timecb_table[timer_id].active_id;
+   if (OS_WorkSubmit(local->dispatch_pool, OS_Timer_DispatchJob, Conv.opaque_arg) == OS_SUCCESS)
+   {
+       local->dispatch_busy = true;
+   }
+   else
+   {
+       ++local->overruns;
+   }
+} /* end OS_TimerDispatch */
 
 
                         
@@ -407,7 +796,25 @@ int32 OS_TimerDelete(uint32 timer_id)
     }
 
 
-    return_code = OS_ObjectIdGetById(OS_LOCK_MODE_EXCLUSIVE, OS_OBJECT_TYPE_OS_TIMECB, timer_id, &local_id, &record);
+    /*
+     * A dispatched callback that is running must return first, unless the
+     * callback is deleting its own timer.  One that is still queued is
+     * skipped once the ID is cleared.
+     */
+    while (true)
+    {
+        return_code = OS_ObjectIdGetById(OS_LOCK_MODE_EXCLUSIVE, OS_OBJECT_TYPE_OS_TIMECB, timer_id, &local_id, &record);
+        if (return_code != OS_SUCCESS ||
+                OS_timecb_table[local_id].dispatch_task == 0 ||
+                OS_timecb_table[local_id].dispatch_task == OS_TaskGetId_Impl())
+        {
+            break;
+        }
+
+        OS_Unlock_Global_Impl(OS_OBJECT_TYPE_OS_TIMECB);
+        OS_TaskDelay_Impl(OS_TIMER_DISPATCH_POLL_MSEC);
+    }
+
     if (return_code == OS_SUCCESS)
     {
         local = &OS_timecb_table[local_id];
@@ -424,27 +831,9 @@ int32 OS_TimerDelete(uint32 timer_id)
         }
 
         /*
-         * Now we need to remove it from the time base callback ring
+         * Now we need to remove it from the timing wheel of the time base
          */
-        if (OS_timebase_table[local->timebase_ref].first_cb == timer_id)
-        {
-            if (local->next_ref != local_id)
-            {
-                OS_ObjectIdMap(OS_OBJECT_TYPE_OS_TIMEBASE, local->next_ref, &OS_timebase_table[local->timebase_ref].first_cb);
-            }
-            else
-            {
-                /*
-                 * consider the list empty
-                 */
-                OS_timebase_table[local->timebase_ref].first_cb = 0;
-            }
-        }
-
-        OS_timecb_table[local->prev_ref].next_ref = local->next_ref;
-        OS_timecb_table[local->next_ref].prev_ref = local->prev_ref;
-        local->next_ref = local_id;
-        local->prev_ref = local_id;
+        OS_TimerWheelDisarm(local->timebase_ref, local_id);
 
         /* Clear the ID to zero */
         record->active_id = 0;
@@ -546,8 +935,14 @@ int32 OS_TimerGetInfo (uint32 timer_id, OS_timer_prop_t *timer_prop)
     {
        strncpy(timer_prop->name, record->name_entry, OS_MAX_API_NAME - 1);
        timer_prop->creator =    record->creator;
-       timer_prop->interval_time =   (uint32)OS_timecb_table[local_id].interval_time;
+       timer_prop->interval_time =   (uint32)(OS_timecb_table[local_id].interval_time / 1000);
+       timer_prop->interval_ns =   (uint64)OS_timecb_table[local_id].interval_time;
        timer_prop->accuracy =   OS_timebase_table[OS_timecb_table[local_id].timebase_ref].accuracy_usec;
+       timer_prop->overruns =   OS_timecb_table[local_id].overruns;
+
+       OS_TimeBaseLock_Impl(OS_timecb_table[local_id].timebase_ref);
+       timer_prop->latency = OS_timecb_table[local_id].latency;
+       OS_TimeBaseUnlock_Impl(OS_timecb_table[local_id].timebase_ref);
 
        OS_Unlock_Global_Impl(OS_OBJECT_TYPE_OS_TIMECB);
     }
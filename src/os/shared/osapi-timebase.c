@@ -61,6 +61,435 @@ OS_timebase_internal_record_t    OS_timebase_table           [OS_MAX_TIMEBASES];
  */
 #define OS_TIMEBASE_SPIN_LIMIT        4
 
+/****************************************************************************************
+                                   TIMER WHEEL
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerWheelFirstSlot
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Returns the index of the lowest bit set in a non-zero
+ *           slot occupancy mask
+ *
+ *-----------------------------------------------------------------*/
+static uint32 OS_TimerWheelFirstSlot(uint64 occupied)
+{
+    uint32 slot;
+    uint32 width;
+
+    slot = 0;
+    for (width = OS_TIMER_WHEEL_SLOTS / 2; width > 0; width /= 2)
+    {
+        if ((occupied & (((uint64)1 << width) - 1)) == 0)
+        {
+            occupied >>= width;
+            slot += width;
+        }
+    }
+
+    return slot;
+} /* end OS_TimerWheelFirstSlot */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerWheelLink
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Add a timer to a bucket of the timing wheel
+ *
+ *-----------------------------------------------------------------*/
+static void OS_TimerWheelLink(OS_timebase_internal_record_t *timebase, uint32 bucket, uint32 timer_id)
+{
+    OS_timecb_internal_record_t *timecb;
+
+    timecb = &OS_timecb_table[timer_id];
+    timecb->wheel_bucket = bucket + 1;
+    timecb->wheel_prev = 0;
+    timecb->wheel_next = timebase->wheel_bucket[bucket];
+    if (timecb->wheel_next != 0)
+    {
+        OS_timecb_table[timecb->wheel_next - 1].wheel_prev = timer_id + 1;
+    }
+    timebase->wheel_bucket[bucket] = timer_id + 1;
+
+    if (bucket < OS_TIMER_WHEEL_OVERFLOW)
+    {
+        timebase->wheel_occupied[bucket / OS_TIMER_WHEEL_SLOTS] |=
+                (uint64)1 << (bucket % OS_TIMER_WHEEL_SLOTS);
+    }
+} /* end OS_TimerWheelLink */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerWheelTake
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Empty a bucket of the timing wheel, and return the local
+ *           id + 1 of the first of its timers, which remain linked
+ *           through wheel_next
+ *
+ *-----------------------------------------------------------------*/
+static uint32 OS_TimerWheelTake(OS_timebase_internal_record_t *timebase, uint32 bucket)
+{
+    uint32 head;
+
+    head = timebase->wheel_bucket[bucket];
+    timebase->wheel_bucket[bucket] = 0;
+    if (bucket < OS_TIMER_WHEEL_OVERFLOW)
+    {
+        timebase->wheel_occupied[bucket / OS_TIMER_WHEEL_SLOTS] &=
+                ~((uint64)1 << (bucket % OS_TIMER_WHEEL_SLOTS));
+    }
+
+    return head;
+} /* end OS_TimerWheelTake */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerWheelArm
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_TimerWheelArm(uint32 timebase_id, uint32 timer_id)
+{
+    OS_timebase_internal_record_t *timebase;
+    uint64 expiry;
+    uint64 diff;
+    uint32 level;
+    uint32 bucket;
+
+    OS_TimerWheelDisarm(timebase_id, timer_id);
+
+    timebase = &OS_timebase_table[timebase_id];
+    expiry = OS_timecb_table[timer_id].expiry_time;
+    if (expiry <= timebase->wheel_time)
+    {
+        bucket = OS_TIMER_WHEEL_EXPIRED;
+    }
+    else
+    {
+        diff = expiry ^ timebase->wheel_time;
+        level = 0;
+        while (level < OS_TIMER_WHEEL_LEVELS && (diff >> ((level + 1) * OS_TIMER_WHEEL_BITS)) != 0)
+        {
+            ++level;
+        }
+
+        if (level == OS_TIMER_WHEEL_LEVELS)
+        {
+            bucket = OS_TIMER_WHEEL_OVERFLOW;
+        }
+        else
+        {
+            bucket = (level * OS_TIMER_WHEEL_SLOTS) +
+                    (uint32)((expiry >> (level * OS_TIMER_WHEEL_BITS)) & (OS_TIMER_WHEEL_SLOTS - 1));
+        }
+    }
+
+    OS_TimerWheelLink(timebase, bucket, timer_id);
+} /* end OS_TimerWheelArm */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerWheelDisarm
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_TimerWheelDisarm(uint32 timebase_id, uint32 timer_id)
+{
+    OS_timebase_internal_record_t *timebase;
+    OS_timecb_internal_record_t *timecb;
+    uint32 bucket;
+
+    timecb = &OS_timecb_table[timer_id];
+    if (timecb->wheel_bucket == 0)
+    {
+        return;
+    }
+
+    timebase = &OS_timebase_table[timebase_id];
+    bucket = timecb->wheel_bucket - 1;
+    if (timecb->wheel_prev != 0)
+    {
+        OS_timecb_table[timecb->wheel_prev - 1].wheel_next = timecb->wheel_next;
+    }
+    else if (timecb->wheel_next != 0)
+    {
+        timebase->wheel_bucket[bucket] = timecb->wheel_next;
+    }
+    else
+    {
+        OS_TimerWheelTake(timebase, bucket);
+    }
+    if (timecb->wheel_next != 0)
+    {
+        OS_timecb_table[timecb->wheel_next - 1].wheel_prev = timecb->wheel_prev;
+    }
+
+    timecb->wheel_bucket = 0;
+    timecb->wheel_prev = 0;
+    timecb->wheel_next = 0;
+} /* end OS_TimerWheelDisarm */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerWheelNextSlot
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Finds the earliest occupied slot of the wheel, including
+ *           the overflow bucket, and the wheel time at which it starts.
+ *           Occupied slots are always ahead of the wheel time within
+ *           the span of their level.
+ *
+ *    Returns: The bucket of the slot, or OS_TIMER_WHEEL_BUCKETS if
+ *             no slot is occupied
+ *
+ *-----------------------------------------------------------------*/
+static uint32 OS_TimerWheelNextSlot(OS_timebase_internal_record_t *timebase, uint64 *next_time)
+{
+    uint32 level;
+    uint32 bucket;
+    uint64 level_start;
+    uint64 slot_time;
+
+    *next_time = 0;
+    bucket = OS_TIMER_WHEEL_BUCKETS;
+    for (level = 0; level < OS_TIMER_WHEEL_LEVELS; ++level)
+    {
+        if (timebase->wheel_occupied[level] != 0)
+        {
+            level_start = timebase->wheel_time &
+                    ~((((uint64)1) << ((level + 1) * OS_TIMER_WHEEL_BITS)) - 1);
+            slot_time = OS_TimerWheelFirstSlot(timebase->wheel_occupied[level]);
+            slot_time = level_start | (slot_time << (level * OS_TIMER_WHEEL_BITS));
+            if (bucket == OS_TIMER_WHEEL_BUCKETS || slot_time < *next_time)
+            {
+                *next_time = slot_time;
+                bucket = (level * OS_TIMER_WHEEL_SLOTS) +
+                        (uint32)((slot_time >> (level * OS_TIMER_WHEEL_BITS)) & (OS_TIMER_WHEEL_SLOTS - 1));
+            }
+        }
+    }
+    if (timebase->wheel_bucket[OS_TIMER_WHEEL_OVERFLOW] != 0)
+    {
+        slot_time = (timebase->wheel_time |
+                ((((uint64)1) << (OS_TIMER_WHEEL_LEVELS * OS_TIMER_WHEEL_BITS)) - 1)) + 1;
+        if (bucket == OS_TIMER_WHEEL_BUCKETS || slot_time < *next_time)
+        {
+            *next_time = slot_time;
+            bucket = OS_TIMER_WHEEL_OVERFLOW;
+        }
+    }
+
+    return bucket;
+} /* end OS_TimerWheelNextSlot */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerWheelAdvance
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Move the time of the wheel forward to new_time, and return
+ *           the local id + 1 of the first timer that is due by then.
+ *           The due timers are taken off the wheel, and are linked
+ *           through wheel_next.
+ *
+ *           Only the occupied slots between the old and new time are
+ *           visited.  Reaching the slot of a higher level moves its
+ *           timers down to the lower levels.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 OS_TimerWheelAdvance(uint32 timebase_id, uint64 new_time)
+{
+    OS_timebase_internal_record_t *timebase;
+    uint32 due_head;
+    uint32 due_tail;
+    uint32 link;
+    uint32 timer_id;
+    uint32 bucket;
+    uint64 next_time;
+
+    timebase = &OS_timebase_table[timebase_id];
+    due_head = OS_TimerWheelTake(timebase, OS_TIMER_WHEEL_EXPIRED);
+    due_tail = 0;
+    for (link = due_head; link != 0; link = OS_timecb_table[link - 1].wheel_next)
+    {
+        OS_timecb_table[link - 1].wheel_bucket = 0;
+        due_tail = link;
+    }
+
+    while (1)
+    {
+        bucket = OS_TimerWheelNextSlot(timebase, &next_time);
+        if (bucket == OS_TIMER_WHEEL_BUCKETS || next_time > new_time)
+        {
+            break;
+        }
+
+        /* Move to the slot, and re-file its timers relative to it */
+        timebase->wheel_time = next_time;
+        link = OS_TimerWheelTake(timebase, bucket);
+        while (link != 0)
+        {
+            timer_id = link - 1;
+            link = OS_timecb_table[timer_id].wheel_next;
+            OS_timecb_table[timer_id].wheel_bucket = 0;
+
+            if (OS_timecb_table[timer_id].expiry_time > next_time)
+            {
+                OS_TimerWheelArm(timebase_id, timer_id);
+            }
+            else
+            {
+                OS_timecb_table[timer_id].wheel_next = 0;
+                if (due_tail == 0)
+                {
+                    due_head = timer_id + 1;
+                }
+                else
+                {
+                    OS_timecb_table[due_tail - 1].wheel_next = timer_id + 1;
+                }
+                due_tail = timer_id + 1;
+            }
+        }
+    }
+
+    timebase->wheel_time = new_time;
+
+    return due_head;
+} /* end OS_TimerWheelAdvance */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerWheelNextDue
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint64 OS_TimerWheelNextDue(uint32 timebase_id)
+{
+    OS_timebase_internal_record_t *timebase;
+    uint64 next_time;
+
+    timebase = &OS_timebase_table[timebase_id];
+    if (timebase->wheel_bucket[OS_TIMER_WHEEL_EXPIRED] != 0)
+    {
+        return 0;
+    }
+
+    if (OS_TimerWheelNextSlot(timebase, &next_time) == OS_TIMER_WHEEL_BUCKETS)
+    {
+        return OS_TIMER_WHEEL_IDLE;
+    }
+
+    return (next_time - timebase->wheel_time);
+} /* end OS_TimerWheelNextDue */
+
+
+/****************************************************************************************
+                                  CALLBACK LATENCY
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerLatencyAdd
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Add the lateness of one callback to a set of statistics
+ *
+ *-----------------------------------------------------------------*/
+static void OS_TimerLatencyAdd(OS_timer_latency_t *latency, uint64 *total, uint32 late_usec)
+{
+    uint32 bucket;
+    uint32 scaled;
+
+    if (latency->count == 0 || late_usec < latency->min_usec)
+    {
+        latency->min_usec = late_usec;
+    }
+    if (late_usec > latency->max_usec)
+    {
+        latency->max_usec = late_usec;
+    }
+
+    ++latency->count;
+    *total += late_usec;
+    latency->mean_usec = (uint32)(*total / latency->count);
+
+    bucket = 0;
+    scaled = late_usec;
+    while (scaled >= 4 && bucket < (OS_TIMER_LATENCY_BUCKETS - 1))
+    {
+        scaled >>= 2;
+        ++bucket;
+    }
+    ++latency->histogram[bucket];
+} /* end OS_TimerLatencyAdd */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerLatencyNow
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint64 OS_TimerLatencyNow(void)
+{
+    OS_time_t now;
+
+    if (OS_GetMonotonicTime_Impl(&now) != OS_SUCCESS)
+    {
+        return 0;
+    }
+
+    return ((uint64)now.seconds * 1000000) + now.microsecs;
+} /* end OS_TimerLatencyNow */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimerLatencyRecord
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_TimerLatencyRecord(uint32 timebase_id, uint32 timer_id, uint64 nominal_usec, uint64 entry_usec)
+{
+    OS_timebase_internal_record_t *timebase;
+    OS_timecb_internal_record_t *timecb;
+    uint32 late_usec;
+
+    timebase = &OS_timebase_table[timebase_id];
+    timecb = &OS_timecb_table[timer_id];
+
+    /* the clock is only read to the microsecond, so a callback can appear early */
+    if (entry_usec <= nominal_usec)
+    {
+        late_usec = 0;
+    }
+    else if ((entry_usec - nominal_usec) > 0xFFFFFFFF)
+    {
+        late_usec = 0xFFFFFFFF;
+    }
+    else
+    {
+        late_usec = (uint32)(entry_usec - nominal_usec);
+    }
+
+    OS_TimerLatencyAdd(&timecb->latency, &timecb->latency_total, late_usec);
+    OS_TimerLatencyAdd(&timebase->latency, &timebase->latency_total, late_usec);
+} /* end OS_TimerLatencyRecord */
+
+
 /****************************************************************************************
                                    TimeBase API
  ***************************************************************************************/
@@ -167,23 +596,38 @@ int32 OS_TimeBaseCreate(uint32 *timer_id, const char *timebase_name, OS_TimerSyn
  *-----------------------------------------------------------------*/
 int32 OS_TimeBaseSet(uint32 timer_id, uint32 start_time, uint32 interval_time)
 {
-    OS_common_record_t *record;
-    int32             return_code;
-    uint32            local_id;
-
     /*
-     * Internally the implementation represents the interval as a
-     * signed 32-bit integer, but the parameter is unsigned because a negative interval
-     * does not make sense.
-     *
      * Note that the units are intentionally left unspecified.  The external sync period
      * could be measured in microseconds or hours -- it is whatever the application requires.
+     * Internally these are taken as microseconds.
      */
     if (interval_time >= 1000000000 || start_time >= 1000000000)
     {
         return OS_TIMER_ERR_INVALID_ARGS;
     }
 
+    return OS_TimeBaseSetNs(timer_id, (uint64)start_time * 1000, (uint64)interval_time * 1000);
+} /* end OS_TimeBaseSet */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBaseSetNs
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TimeBaseSetNs(uint32 timer_id, uint64 start_time, uint64 interval_time)
+{
+    OS_common_record_t *record;
+    int32             return_code;
+    uint32            local_id;
+
+    if (interval_time >= OS_TIMEBASE_NS_LIMIT || start_time >= OS_TIMEBASE_NS_LIMIT)
+    {
+        return OS_TIMER_ERR_INVALID_ARGS;
+    }
+
     /*
      * Check our context.  Not allowed to use the timer API from a timer callback.
      * Just interested in the object type returned.
@@ -215,7 +659,54 @@ int32 OS_TimeBaseSet(uint32 timer_id, uint32 start_time, uint32 interval_time)
     }
 
     return return_code;
-} /* end OS_TimeBaseSet */
+} /* end OS_TimeBaseSetNs */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBaseSetTickless
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TimeBaseSetTickless(uint32 timer_id, bool tickless)
+{
+    OS_common_record_t *record;
+    int32             return_code;
+    uint32            local_id;
+
+    /*
+     * Check our context.  Not allowed to use the timer API from a timer callback.
+     * Just interested in the object type returned.
+     */
+    local_id = OS_TaskGetId_Impl() >> OS_OBJECT_TYPE_SHIFT;
+    if (local_id == OS_OBJECT_TYPE_OS_TIMEBASE)
+    {
+        return OS_ERR_INCORRECT_OBJ_STATE;
+    }
+
+    return_code = OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL, OS_OBJECT_TYPE_OS_TIMEBASE, timer_id, &local_id, &record);
+    if (return_code == OS_SUCCESS)
+    {
+        OS_TimeBaseLock_Impl(local_id);
+
+        return_code = OS_TimeBaseSetTickless_Impl(local_id, tickless);
+        if (return_code == OS_SUCCESS)
+        {
+            OS_timebase_table[local_id].tickless = tickless;
+            if (tickless)
+            {
+                OS_TimeBaseNextDue_Impl(local_id, 0, OS_TimerWheelNextDue(local_id));
+            }
+        }
+
+        OS_TimeBaseUnlock_Impl(local_id);
+
+        OS_Unlock_Global_Impl(OS_OBJECT_TYPE_OS_TIMEBASE);
+    }
+
+    return return_code;
+} /* end OS_TimeBaseSetTickless */
 
                         
 /*----------------------------------------------------------------
@@ -333,9 +824,16 @@ int32 OS_TimeBaseGetInfo (uint32 timebase_id, OS_timebase_prop_t *timebase_prop)
     {
        strncpy(timebase_prop->name, record->name_entry, OS_MAX_API_NAME - 1);
        timebase_prop->creator =    record->creator;
-       timebase_prop->nominal_interval_time =   OS_timebase_table[local_id].nominal_interval_time;
-       timebase_prop->freerun_time =   OS_timebase_table[local_id].freerun_time;
+       timebase_prop->nominal_interval_time =   (uint32)(OS_timebase_table[local_id].nominal_interval_time / 1000);
        timebase_prop->accuracy =   OS_timebase_table[local_id].accuracy_usec;
+       timebase_prop->nominal_interval_ns =   OS_timebase_table[local_id].nominal_interval_time;
+
+       OS_TimeBaseLock_Impl(local_id);
+       timebase_prop->freerun_ns = OS_timebase_table[local_id].freerun_time;
+       timebase_prop->latency = OS_timebase_table[local_id].latency;
+       OS_TimeBaseUnlock_Impl(local_id);
+
+       timebase_prop->freerun_time = (uint32)(timebase_prop->freerun_ns / 1000);
 
        return_code = OS_TimeBaseGetInfo_Impl(local_id, timebase_prop);
 
@@ -355,20 +853,198 @@ int32 OS_TimeBaseGetInfo (uint32 timebase_id, OS_timebase_prop_t *timebase_prop)
  *
  *-----------------------------------------------------------------*/
 int32 OS_TimeBaseGetFreeRun     (uint32 timebase_id, uint32 *freerun_val)
+{
+    int32             return_code;
+    uint64            freerun_ns;
+
+    return_code = OS_TimeBaseGetFreeRunNs(timebase_id, &freerun_ns);
+    if (return_code == OS_SUCCESS)
+    {
+       /* wraps around like the counter of microseconds always has */
+       *freerun_val = (uint32)(freerun_ns / 1000);
+    }
+
+    return return_code;
+} /* end OS_TimeBaseGetFreeRun */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBaseGetFreeRunNs
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TimeBaseGetFreeRunNs   (uint32 timebase_id, uint64 *freerun_val)
 {
     OS_common_record_t *record;
+    volatile uint64   *freerun_time;
     int32             return_code;
     uint32            local_id;
 
     /* Check parameters */
+    if (freerun_val == NULL)
+    {
+       return OS_INVALID_POINTER;
+    }
+
     return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE,LOCAL_OBJID_TYPE, timebase_id, &local_id, &record);
     if (return_code == OS_SUCCESS)
     {
-       *freerun_val = OS_timebase_table[local_id].freerun_time;
+       /*
+        * This is often called from a timer callback, with the time base
+        * locked, so read the counter without the lock.  Read it until two
+        * reads agree, in case the CPU cannot read it in one access.
+        */
+       freerun_time = &OS_timebase_table[local_id].freerun_time;
+       do
+       {
+          *freerun_val = *freerun_time;
+       }
+       while (*freerun_val != *freerun_time);
     }
 
     return return_code;
-} /* end OS_TimeBaseGetFreeRun */
+} /* end OS_TimeBaseGetFreeRunNs */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBase_ProcessTick
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TimeBase_ProcessTick(uint32 timebase_id, uint32 local_id, uint64 tick_time)
+{
+    OS_timebase_internal_record_t *timebase;
+    OS_timecb_internal_record_t *timecb;
+    uint32 curr_cb_local_id;
+    uint32 curr_cb_public_id;
+    uint32 due_list;
+    uint32 tick_late;
+    uint64 prev_time;
+    uint64 overdue_time;
+    uint64 tick_usec;
+    uint64 nominal_usec;
+    uint64 entry_usec;
+    int64 wait_time;
+    int64 saved_wait_time;
+    bool tick_known;
+
+    timebase = &OS_timebase_table[local_id];
+
+    OS_TimeBaseLock_Impl(local_id);
+
+    if (timebase_id != OS_global_timebase_table[local_id].active_id)
+    {
+        OS_TimeBaseUnlock_Impl(local_id);
+        return OS_ERR_INVALID_ID;
+    }
+
+    /*
+     * The nominal time of the tick, from which the nominal expiry of each
+     * timer is found.  If the implementation does not know it, then the
+     * tick is taken as due when it was received.
+     */
+    tick_usec = OS_TimerLatencyNow();
+    tick_known = (OS_TimeBaseTickLateness_Impl(local_id, tick_time, &tick_late) == OS_SUCCESS);
+    if (tick_known && tick_late < tick_usec)
+    {
+        tick_usec -= tick_late;
+    }
+
+    timebase->freerun_time += tick_time;
+    prev_time = timebase->wheel_time;
+    due_list = OS_TimerWheelAdvance(local_id, prev_time + tick_time);
+    while (due_list != 0)
+    {
+        curr_cb_local_id = due_list - 1;
+        curr_cb_public_id = OS_global_timecb_table[curr_cb_local_id].active_id;
+        timecb = &OS_timecb_table[curr_cb_local_id];
+        due_list = timecb->wheel_next;
+        timecb->wheel_next = 0;
+
+        /*
+         * The time left until expiry as of the previous tick.  This is zero
+         * or negative if the timer was already due then, e.g. if it was set
+         * with a start time of zero.
+         */
+        wait_time = (int64)(timecb->expiry_time - prev_time);
+        saved_wait_time = wait_time;
+        wait_time -= (int64)tick_time;
+        while (wait_time <= 0)
+        {
+            /* how long before the end of the tick this expiry was due */
+            overdue_time = (uint64)(-wait_time);
+            wait_time += timecb->interval_time;
+
+            /*
+             * Only allow the "wait_time" underflow to go as far negative as one interval time
+             * This prevents a cb "interval_time" of less than the timebase interval_time from
+             * accumulating infinitely
+             */
+            if (wait_time < -timecb->interval_time)
+            {
+                ++timecb->backlog_resets;
+                wait_time = -timecb->interval_time;
+            }
+
+            /*
+             * Only give the callback if the wait_time actually transitioned from positive to negative.
+             * This allows one-shot operation where the API sets the "wait_time" positive but keeps
+             * the "interval_time" at zero.  With the interval_time at zero the timer is not
+             * put back on the wheel, so it does not expire again unless the API sets it again.
+             */
+            if (saved_wait_time > 0 && timecb->callback_ptr != NULL)
+            {
+                nominal_usec = tick_usec;
+                if (tick_known && (overdue_time / 1000) < nominal_usec)
+                {
+                    nominal_usec -= overdue_time / 1000;
+                }
+
+                if ((timecb->flags & TIMECB_FLAG_DISPATCH) != 0)
+                {
+                    OS_TimerDispatch(curr_cb_local_id, nominal_usec);
+                }
+                else
+                {
+                    entry_usec = OS_TimerLatencyNow();
+                    (*timecb->callback_ptr)(curr_cb_public_id, timecb->callback_arg);
+                    OS_TimerLatencyRecord(local_id, curr_cb_local_id, nominal_usec, entry_usec);
+                }
+            }
+
+            /*
+             * Do not repeat the loop unless interval_time is configured.
+             */
+            if (timecb->interval_time <= 0)
+            {
+                break;
+            }
+        }
+
+        if (timecb->interval_time > 0)
+        {
+            timecb->expiry_time = timebase->wheel_time + wait_time;
+            OS_TimerWheelArm(local_id, curr_cb_local_id);
+        }
+    }
+
+    if (timebase->tickless)
+    {
+        OS_TimeBaseNextDue_Impl(local_id, tick_time, OS_TimerWheelNextDue(local_id));
+    }
+    else
+    {
+        OS_TimeBaseNextDue_Impl(local_id, tick_time, OS_TIMER_WHEEL_IDLE);
+    }
+
+    OS_TimeBaseUnlock_Impl(local_id);
+
+    return OS_SUCCESS;
+} /* end OS_TimeBase_ProcessTick */
 
 /*----------------------------------------------------------------
  *
@@ -392,16 +1068,12 @@ int32 OS_TimeBaseGetFreeRun     (uint32 timebase_id, uint32 *freerun_val)
 void OS_TimeBase_CallbackThread(uint32 timebase_id)
 {
     OS_TimerSync_t syncfunc;
+    OS_TimeBaseWait_t waitfunc;
     OS_timebase_internal_record_t *timebase;
-    OS_timecb_internal_record_t *timecb;
     OS_common_record_t *record;
     uint32 local_id;
-    uint32 timer_id;
-    uint32 curr_cb_local_id;
-    uint32 curr_cb_public_id;
-    uint32 tick_time;
+    uint64 tick_time;
     uint32 spin_cycles;
-    int32 saved_wait_time;
 
     /*
      * Register this task as a time base handler.
@@ -420,6 +1092,7 @@ void OS_TimeBase_CallbackThread(uint32 timebase_id)
 
     timebase = &OS_timebase_table[local_id];
     syncfunc = timebase->external_sync;
+    waitfunc = timebase->simulated_wait;
     spin_cycles = 0;
 
     OS_Unlock_Global_Impl(OS_OBJECT_TYPE_OS_TIMEBASE);
@@ -428,9 +1101,18 @@ void OS_TimeBase_CallbackThread(uint32 timebase_id)
     {
         /*
          * Call the sync function - this will pend for some period of time
-         * and return the amount of elapsed time in units of "timebase ticks"
+         * and return the amount of elapsed time in units of "timebase ticks",
+         * which are taken as microseconds.  The wait function of a simulated
+         * time base returns nanoseconds directly.
          */
-        tick_time = (*syncfunc)(local_id);
+        if (waitfunc != NULL)
+        {
+            tick_time = (*waitfunc)(local_id);
+        }
+        else
+        {
+            tick_time = (uint64)(*syncfunc)(local_id) * 1000;
+        }
 
         /*
          * The returned tick_time should be nonzero.  If the sync function
@@ -472,69 +1154,14 @@ void OS_TimeBase_CallbackThread(uint32 timebase_id)
             }
         }
 
-        OS_TimeBaseLock_Impl(local_id);
-
         /*
          * After waiting, check that our ID still matches
          * If not then it means this time base got deleted....
          */
-        if (timebase_id != record->active_id)
+        if (OS_TimeBase_ProcessTick(timebase_id, local_id, tick_time) != OS_SUCCESS)
         {
-            OS_TimeBaseUnlock_Impl(local_id);
             break;
         }
-
-        timebase->freerun_time += tick_time;
-        if (OS_ObjectIdToArrayIndex(OS_OBJECT_TYPE_OS_TIMECB, timebase->first_cb, &timer_id) == 0)
-        {
-            curr_cb_local_id = timer_id;
-            do
-            {
-                curr_cb_public_id = OS_global_timecb_table[curr_cb_local_id].active_id;
-                timecb = &OS_timecb_table[curr_cb_local_id];
-                saved_wait_time = timecb->wait_time;
-                timecb->wait_time -= tick_time;
-                while (timecb->wait_time <= 0)
-                {
-                    timecb->wait_time += timecb->interval_time;
-
-                    /*
-                     * Only allow the "wait_time" underflow to go as far negative as one interval time
-                     * This prevents a cb "interval_time" of less than the timebase interval_time from
-                     * accumulating infinitely
-                     */
-                    if (timecb->wait_time < -timecb->interval_time)
-                    {
-                        ++timecb->backlog_resets;
-                        timecb->wait_time = -timecb->interval_time;
-                    }
-
-                    /*
-                     * Only give the callback if the wait_time actually transitioned from positive to negative.
-                     * This allows one-shot operation where the API sets the "wait_time" positive but keeps
-                     * the "interval_time" at zero.  With the interval_time at zero the wait time will never
-                     * go positive again unless the API sets it again.
-                     */
-                    if (saved_wait_time > 0 && timecb->callback_ptr != NULL)
-                    {
-                        (*timecb->callback_ptr)(curr_cb_public_id, timecb->callback_arg);
-                    }
-
-                    /*
-                     * Do not repeat the loop unless interval_time is configured.
-                     */
-                    if (timecb->interval_time <= 0)
-                    {
-                        break;
-                    }
-                }
-                curr_cb_local_id = timecb->next_ref;
-            }
-            while (curr_cb_local_id != timer_id);
-        }
-
-        OS_TimeBaseUnlock_Impl(local_id);
-
     }
 } /* end OS_TimeBase_CallbackThread */
 
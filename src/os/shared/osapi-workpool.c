@@ -0,0 +1,752 @@
+/*
+ *      Copyright (c) 2018, United States government as represented by the
+ *      administrator of the National Aeronautics Space Administration.
+ *      All rights reserved. This software was created at NASA Glenn
+ *      Research Center pursuant to government contracts.
+ *
+ *      This is governed by the NASA Open Source Agreement and may be used,
+ *      distributed and modified only according to the terms of that agreement.
+ */
+
+/**
+ * \file   osapi-workpool.c
+ *
+ * Purpose:
+ *         This file  contains some of the OS APIs abstraction layer code
+ *         that is shared/common across all OS-specific implementations.
+ *
+ *         A worker pool is a fixed set of OSAL tasks that execute short jobs.
+ *         Each worker owns a bounded queue of jobs.  The owner takes the
+ *         newest job from its own queue, and an idle worker steals the
+ *         oldest job from another worker's queue.  Each queue has its own
+ *         lock so that workers only contend when stealing.
+ *
+ *         A job is accounted against the queue it was taken from, so that
+ *         (submitted - completed) of a single queue is always the number
+ *         of jobs from that queue which are queued or still running.
+ *
+ */
+
+/****************************************************************************************
+                                    INCLUDE FILES
+ ***************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * User defined include files
+ */
+#include "common_types.h"
+#include "os-impl.h"
+
+
+/*
+ * Sanity checks on the user-supplied configuration
+ * The relevent OS_MAX limit should be defined and greater than zero
+ */
+#if !defined(OS_MAX_WORKPOOLS) || (OS_MAX_WORKPOOLS <= 0)
+#error "osconfig.h must define OS_MAX_WORKPOOLS to a valid value"
+#endif
+
+/*
+ * While deleting a pool, how often to re-check for workers that were
+ * deleted directly through OS_TaskDelete() and so will never report
+ * that they have exited.
+ */
+#define OS_WORKPOOL_EXIT_POLL_MSEC      100
+
+/*
+ * Longest pool name that leaves room for the ".N" suffix of the worker
+ * task names, which must stay unique between pools.
+ */
+#define OS_WORKPOOL_MAX_NAME_LEN        (OS_MAX_API_NAME - 4)
+
+/*
+ * Global data for the API
+ */
+enum
+{
+   LOCAL_NUM_OBJECTS = OS_MAX_WORKPOOLS,
+   LOCAL_OBJID_TYPE = OS_OBJECT_TYPE_OS_WORKPOOL
+};
+
+OS_workpool_internal_record_t   OS_workpool_table       [LOCAL_NUM_OBJECTS];
+
+
+/****************************************************************************************
+                                  WORKER POOL HELPERS
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolFindWorker
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Determine if the given task is a worker of the pool, and if
+ *           so output its worker index.
+ *
+ *-----------------------------------------------------------------*/
+static bool OS_WorkPoolFindWorker(uint32 local_id, uint32 task_id, uint32 *worker_idx)
+{
+   OS_workpool_internal_record_t *pool;
+   uint32 i;
+
+   pool = &OS_workpool_table[local_id];
+   for (i = 0; i < pool->num_workers; ++i)
+   {
+      if (pool->worker[i].task_id == task_id)
+      {
+         *worker_idx = i;
+         return true;
+      }
+   }
+
+   return false;
+} /* end OS_WorkPoolFindWorker */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolTakeJob
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Take the newest job from the worker's own queue, or failing
+ *           that steal the oldest job from the next non-empty queue.
+ *           Outputs the index of the queue the job came from.
+ *
+ *  returns: true if a job was taken, false if all queues were empty
+ *
+ *-----------------------------------------------------------------*/
+static bool OS_WorkPoolTakeJob(uint32 local_id, uint32 self, uint32 *src_idx, OS_workpool_job_t *job)
+{
+   OS_workpool_internal_record_t *pool;
+   OS_workpool_worker_t *queue;
+   uint32 n;
+   uint32 victim;
+   bool found;
+
+   pool = &OS_workpool_table[local_id];
+   queue = &pool->worker[self];
+
+   OS_WorkPoolLock_Impl(local_id, self);
+   found = (queue->tail != queue->head);
+   if (found)
+   {
+      --queue->tail;
+      *job = queue->job[queue->tail & (OS_WORKPOOL_QUEUE_DEPTH - 1)];
+   }
+   OS_WorkPoolUnlock_Impl(local_id, self);
+
+   if (found)
+   {
+      *src_idx = self;
+      return true;
+   }
+
+   for (n = 1; n < pool->num_workers; ++n)
+   {
+      victim = (self + n) % pool->num_workers;
+      queue = &pool->worker[victim];
+
+      OS_WorkPoolLock_Impl(local_id, victim);
+      found = (queue->tail != queue->head);
+      if (found)
+      {
+         *job = queue->job[queue->head & (OS_WORKPOOL_QUEUE_DEPTH - 1)];
+         ++queue->head;
+         ++queue->stolen;
+      }
+      OS_WorkPoolUnlock_Impl(local_id, victim);
+
+      if (found)
+      {
+         *src_idx = victim;
+         return true;
+      }
+   }
+
+   return false;
+} /* end OS_WorkPoolTakeJob */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolWorkerEntry
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Entry point of every worker task.
+ *
+ *           Workers are ordinary OSAL tasks, so by the time this runs the
+ *           task has been registered and may use the whole OSAL API.
+ *
+ *-----------------------------------------------------------------*/
+static void OS_WorkPoolWorkerEntry(void)
+{
+   OS_workpool_internal_record_t *pool;
+   OS_workpool_job_t job;
+   uint32 task_id;
+   uint32 local_id;
+   uint32 self = 0;
+   uint32 src_idx;
+   bool notify;
+
+   task_id = OS_TaskGetId_Impl();
+
+   /*
+    * The creating task holds the table lock until every worker has been
+    * started, so taking it here also waits for the pool to be finalized.
+    * If the pool creation failed the record is not active and the worker
+    * simply exits.
+    */
+   OS_Lock_Global_Impl(LOCAL_OBJID_TYPE);
+   for (local_id = 0; local_id < LOCAL_NUM_OBJECTS; ++local_id)
+   {
+      if (OS_global_workpool_table[local_id].active_id != 0 &&
+            OS_WorkPoolFindWorker(local_id, task_id, &self))
+      {
+         break;
+      }
+   }
+   OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+
+   if (local_id >= LOCAL_NUM_OBJECTS)
+   {
+      return;
+   }
+
+   pool = &OS_workpool_table[local_id];
+
+   while (OS_WorkPoolPend_Impl(local_id) == OS_SUCCESS)
+   {
+      /* shutdown is set before the wakeup tokens are posted */
+      if (pool->shutdown)
+      {
+         break;
+      }
+
+      if (!OS_WorkPoolTakeJob(local_id, self, &src_idx, &job))
+      {
+         /* another worker took the job this token was posted for */
+         continue;
+      }
+
+      (*job.func)(job.arg);
+
+      /*
+       * Reading idle_waiters under the same queue lock used by
+       * OS_WorkPoolWaitIdle() to read the counters means that either
+       * the waiter sees this completion, or this worker sees the waiter.
+       */
+      OS_WorkPoolLock_Impl(local_id, src_idx);
+      ++pool->worker[src_idx].completed;
+      notify = (pool->idle_waiters != 0);
+      OS_WorkPoolUnlock_Impl(local_id, src_idx);
+
+      if (notify)
+      {
+         OS_WorkPoolLock_Impl(local_id, OS_WORKPOOL_POOL_LOCK);
+         OS_WorkPoolIdleNotify_Impl(local_id);
+         OS_WorkPoolUnlock_Impl(local_id, OS_WORKPOOL_POOL_LOCK);
+      }
+   }
+
+   OS_WorkPoolLock_Impl(local_id, OS_WORKPOOL_POOL_LOCK);
+   pool->worker[self].exited = true;
+   OS_WorkPoolIdleNotify_Impl(local_id);
+   OS_WorkPoolUnlock_Impl(local_id, OS_WORKPOOL_POOL_LOCK);
+
+} /* end OS_WorkPoolWorkerEntry */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolStartWorkers
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Create the worker tasks of a new pool.
+ *           Called with the pool table locked.
+ *
+ *-----------------------------------------------------------------*/
+static int32 OS_WorkPoolStartWorkers(uint32 local_id, uint32 stack_size, uint32 priority, uint32 flags)
+{
+   OS_workpool_internal_record_t *pool;
+   char task_name[OS_MAX_API_NAME];
+   uint32 i;
+   int32 return_code;
+
+   pool = &OS_workpool_table[local_id];
+   return_code = OS_SUCCESS;
+
+   for (i = 0; i < pool->num_workers && i < OS_WORKPOOL_MAX_WORKERS; ++i)
+   {
+      /* the pool name is short enough for the ".N" suffix, see OS_WorkPoolCreate() */
+      snprintf(task_name, sizeof(task_name), "%.*s.%u",
+            (int)OS_WORKPOOL_MAX_NAME_LEN, pool->obj_name, (unsigned int)i);
+
+      return_code = OS_TaskCreate(&pool->worker[i].task_id, task_name, OS_WorkPoolWorkerEntry,
+            NULL, stack_size, priority, flags);
+      if (return_code != OS_SUCCESS)
+      {
+         /*
+          * Any workers already started will find the pool record inactive
+          * once the table is unlocked, and exit on their own.
+          */
+         pool->worker[i].task_id = 0;
+         break;
+      }
+   }
+
+   return return_code;
+} /* end OS_WorkPoolStartWorkers */
+
+
+/****************************************************************************************
+                                    WORKER POOL API
+ ***************************************************************************************/
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolAPI_Init
+ *
+ *  Purpose: Local helper routine, not part of OSAL API.
+ *           Init function for OS-independent layer
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolAPI_Init(void)
+{
+   memset(OS_workpool_table, 0, sizeof(OS_workpool_table));
+   return OS_SUCCESS;
+} /* end OS_WorkPoolAPI_Init */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolCreate
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolCreate (uint32 *pool_id, const char *pool_name, uint32 num_workers,
+                         uint32 stack_size, uint32 priority, uint32 flags)
+{
+   OS_common_record_t *record;
+   OS_workpool_internal_record_t *pool;
+   int32             return_code;
+   uint32            local_id;
+
+   /* Check for NULL pointers */
+   if (pool_id == NULL || pool_name == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   if (num_workers == 0 || num_workers > OS_WORKPOOL_MAX_WORKERS)
+   {
+      return OS_QUEUE_INVALID_SIZE;
+   }
+
+   /* the workers are named after the pool, with a ".N" suffix */
+   if ( strlen (pool_name) > OS_WORKPOOL_MAX_NAME_LEN )
+   {
+      return OS_ERR_NAME_TOO_LONG;
+   }
+
+   /* Note - the common ObjectIdAllocate routine will lock the object type and leave it locked. */
+   return_code = OS_ObjectIdAllocateNew(LOCAL_OBJID_TYPE, pool_name, &local_id, &record);
+   if(return_code == OS_SUCCESS)
+   {
+      /* Save all the data to our own internal table */
+      pool = &OS_workpool_table[local_id];
+      memset(pool, 0, sizeof(*pool));
+      strcpy(pool->obj_name, pool_name);
+      pool->num_workers = num_workers;
+      record->name_entry = pool->obj_name;
+
+      /* Now call the OS-specific implementation.  This reads info from the table. */
+      return_code = OS_WorkPoolCreate_Impl(local_id);
+      if (return_code == OS_SUCCESS)
+      {
+         return_code = OS_WorkPoolStartWorkers(local_id, stack_size, priority, flags);
+         if (return_code != OS_SUCCESS)
+         {
+            OS_WorkPoolDelete_Impl(local_id);
+         }
+      }
+
+      /* Check result, finalize record, and unlock global table. */
+      return_code = OS_ObjectIdFinalizeNew(return_code, record, pool_id);
+   }
+
+   return return_code;
+
+} /* end OS_WorkPoolCreate */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkSubmit
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkSubmit (uint32 pool_id, OS_WorkFunc_t func, void *arg)
+{
+   OS_common_record_t *record;
+   OS_workpool_internal_record_t *pool;
+   OS_workpool_worker_t *queue;
+   uint32 local_id;
+   uint32 idx;
+   uint32 n;
+   int32 return_code;
+
+   if (func == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_NONE, LOCAL_OBJID_TYPE, pool_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      pool = &OS_workpool_table[local_id];
+
+      if (pool->shutdown)
+      {
+         return OS_ERR_INCORRECT_OBJ_STATE;
+      }
+
+      /*
+       * A worker queues follow-on jobs to itself, as they most likely
+       * use the same data.  Other tasks spread jobs across the workers;
+       * next_worker is only a hint so it does not need to be locked.
+       */
+      if (!OS_WorkPoolFindWorker(local_id, OS_TaskGetId_Impl(), &idx))
+      {
+         idx = pool->next_worker % pool->num_workers;
+         pool->next_worker = idx + 1;
+      }
+
+      return_code = OS_QUEUE_FULL;
+      for (n = 0; n < pool->num_workers; ++n)
+      {
+         queue = &pool->worker[idx];
+
+         OS_WorkPoolLock_Impl(local_id, idx);
+         if ((queue->tail - queue->head) < OS_WORKPOOL_QUEUE_DEPTH)
+         {
+            queue->job[queue->tail & (OS_WORKPOOL_QUEUE_DEPTH - 1)].func = func;
+            queue->job[queue->tail & (OS_WORKPOOL_QUEUE_DEPTH - 1)].arg = arg;
+            ++queue->tail;
+            ++queue->submitted;
+            return_code = OS_SUCCESS;
+         }
+         OS_WorkPoolUnlock_Impl(local_id, idx);
+
+         if (return_code == OS_SUCCESS)
+         {
+            break;
+         }
+
+         idx = (idx + 1) % pool->num_workers;
+      }
+
+      if (return_code == OS_SUCCESS)
+      {
+         return_code = OS_WorkPoolPost_Impl(local_id);
+      }
+   }
+
+   return return_code;
+
+} /* end OS_WorkSubmit */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolWaitIdle
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolWaitIdle (uint32 pool_id, int32 msecs)
+{
+   OS_common_record_t *record;
+   OS_workpool_internal_record_t *pool;
+   OS_time_t deadline;
+   OS_time_t now;
+   uint32 local_id;
+   uint32 outstanding;
+   uint32 i;
+   int32 remaining;
+   int32 return_code;
+
+   /* The refcount keeps the pool from being deleted while waiting */
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_REFCOUNT, LOCAL_OBJID_TYPE, pool_id, &local_id, &record);
+   if (return_code != OS_SUCCESS)
+   {
+      return return_code;
+   }
+
+   pool = &OS_workpool_table[local_id];
+
+   /* a worker waiting for itself to become idle would never return */
+   if (OS_WorkPoolFindWorker(local_id, OS_TaskGetId_Impl(), &i))
+   {
+      OS_ObjectIdRefcountDecr(record);
+      return OS_ERR_INCORRECT_OBJ_STATE;
+   }
+
+   if (msecs > 0)
+   {
+      return_code = OS_GetMonotonicTime_Impl(&deadline);
+      deadline.seconds += msecs / 1000;
+      deadline.microsecs += (msecs % 1000) * 1000;
+      if (deadline.microsecs >= 1000000)
+      {
+         deadline.microsecs -= 1000000;
+         ++deadline.seconds;
+      }
+   }
+
+   OS_WorkPoolLock_Impl(local_id, OS_WORKPOOL_POOL_LOCK);
+   ++pool->idle_waiters;
+
+   while (return_code == OS_SUCCESS)
+   {
+      if (pool->shutdown)
+      {
+         return_code = OS_ERR_INCORRECT_OBJ_STATE;
+         break;
+      }
+
+      outstanding = 0;
+      for (i = 0; i < pool->num_workers; ++i)
+      {
+         OS_WorkPoolLock_Impl(local_id, i);
+         outstanding += pool->worker[i].submitted - pool->worker[i].completed;
+         OS_WorkPoolUnlock_Impl(local_id, i);
+      }
+
+      if (outstanding == 0)
+      {
+         break;
+      }
+
+      remaining = msecs;
+      if (msecs > 0)
+      {
+         return_code = OS_GetMonotonicTime_Impl(&now);
+         remaining = (int32)(deadline.seconds - now.seconds) * 1000 +
+               ((int32)deadline.microsecs - (int32)now.microsecs) / 1000;
+         if (remaining <= 0)
+         {
+            remaining = OS_CHECK;
+         }
+      }
+
+      if (remaining == OS_CHECK)
+      {
+         return_code = OS_ERROR_TIMEOUT;
+      }
+      else if (return_code == OS_SUCCESS)
+      {
+         return_code = OS_WorkPoolIdleWait_Impl(local_id, remaining);
+         if (return_code == OS_ERROR_TIMEOUT)
+         {
+            /* re-check the counters once more before reporting a timeout */
+            return_code = OS_SUCCESS;
+            msecs = OS_CHECK;
+         }
+      }
+   }
+
+   --pool->idle_waiters;
+   OS_WorkPoolUnlock_Impl(local_id, OS_WORKPOOL_POOL_LOCK);
+
+   OS_ObjectIdRefcountDecr(record);
+
+   return return_code;
+
+} /* end OS_WorkPoolWaitIdle */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolDelete
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolDelete (uint32 pool_id)
+{
+   OS_common_record_t *record;
+   OS_common_record_t *task_record;
+   OS_workpool_internal_record_t *pool;
+   uint32 local_id;
+   uint32 task_idx;
+   uint32 running;
+   uint32 i;
+   bool start_shutdown;
+   int32 return_code;
+
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL, LOCAL_OBJID_TYPE, pool_id, &local_id, &record);
+   if (return_code != OS_SUCCESS)
+   {
+      return return_code;
+   }
+
+   pool = &OS_workpool_table[local_id];
+   start_shutdown = false;
+
+   if (OS_WorkPoolFindWorker(local_id, OS_TaskGetId_Impl(), &i))
+   {
+      /* the calling worker could never be waited for */
+      return_code = OS_ERR_INCORRECT_OBJ_STATE;
+   }
+   else if (!pool->shutdown)
+   {
+      /* a previous delete attempt may have already stopped the workers */
+      pool->shutdown = true;
+      start_shutdown = true;
+   }
+
+   OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+
+   if (return_code != OS_SUCCESS)
+   {
+      return return_code;
+   }
+
+   if (start_shutdown)
+   {
+      for (i = 0; i < pool->num_workers; ++i)
+      {
+         OS_WorkPoolPost_Impl(local_id);
+      }
+   }
+
+   /*
+    * Wait for each worker to finish its current job and exit.  A worker
+    * task that no longer exists is not waited for.
+    */
+   OS_WorkPoolLock_Impl(local_id, OS_WORKPOOL_POOL_LOCK);
+   while (true)
+   {
+      running = 0;
+      for (i = 0; i < pool->num_workers; ++i)
+      {
+         if (!pool->worker[i].exited &&
+               OS_ObjectIdGetById(OS_LOCK_MODE_NONE, OS_OBJECT_TYPE_OS_TASK,
+                     pool->worker[i].task_id, &task_idx, &task_record) == OS_SUCCESS)
+         {
+            ++running;
+         }
+      }
+
+      if (running == 0)
+      {
+         break;
+      }
+
+      OS_WorkPoolIdleWait_Impl(local_id, OS_WORKPOOL_EXIT_POLL_MSEC);
+   }
+   OS_WorkPoolUnlock_Impl(local_id, OS_WORKPOOL_POOL_LOCK);
+
+   /* Any tasks in OS_WorkPoolWaitIdle() have been woken and will release the pool */
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_EXCLUSIVE, LOCAL_OBJID_TYPE, pool_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      return_code = OS_WorkPoolDelete_Impl(local_id);
+
+      /* Free the entry in the master table now while still locked */
+      if (return_code == OS_SUCCESS)
+      {
+         /* Only need to clear the ID as zero is the "unused" flag */
+         record->active_id = 0;
+      }
+
+      OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+   }
+
+   return return_code;
+
+} /* end OS_WorkPoolDelete */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolGetIdByName
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolGetIdByName (uint32 *pool_id, const char *pool_name)
+{
+   int32 return_code;
+
+   if (pool_id == NULL || pool_name == NULL)
+   {
+       return OS_INVALID_POINTER;
+   }
+
+   return_code = OS_ObjectIdFindByName(LOCAL_OBJID_TYPE, pool_name, pool_id);
+
+   return return_code;
+
+} /* end OS_WorkPoolGetIdByName */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolGetInfo
+ *
+ *  Purpose: Implemented per public OSAL API
+ *           See description in API and header file for detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolGetInfo (uint32 pool_id, OS_workpool_prop_t *pool_prop)
+{
+   OS_common_record_t *record;
+   OS_workpool_internal_record_t *pool;
+   OS_workpool_worker_t *queue;
+   int32             return_code;
+   uint32            local_id;
+   uint32            i;
+
+   /* Check parameters */
+   if (pool_prop == NULL)
+   {
+      return OS_INVALID_POINTER;
+   }
+
+   memset(pool_prop,0,sizeof(OS_workpool_prop_t));
+
+   return_code = OS_ObjectIdGetById(OS_LOCK_MODE_GLOBAL,LOCAL_OBJID_TYPE, pool_id, &local_id, &record);
+   if (return_code == OS_SUCCESS)
+   {
+      pool = &OS_workpool_table[local_id];
+
+      strncpy(pool_prop->name, record->name_entry, OS_MAX_API_NAME - 1);
+      pool_prop->creator =     record->creator;
+      pool_prop->num_workers = pool->num_workers;
+
+      for (i = 0; i < pool->num_workers; ++i)
+      {
+         queue = &pool->worker[i];
+
+         OS_WorkPoolLock_Impl(local_id, i);
+         pool_prop->jobs_submitted += queue->submitted;
+         pool_prop->jobs_completed += queue->completed;
+         pool_prop->jobs_stolen += queue->stolen;
+         pool_prop->jobs_pending += queue->tail - queue->head;
+         OS_WorkPoolUnlock_Impl(local_id, i);
+      }
+
+      OS_Unlock_Global_Impl(LOCAL_OBJID_TYPE);
+   }
+
+   return return_code;
+
+} /* end OS_WorkPoolGetInfo */
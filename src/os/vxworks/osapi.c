@@ -79,6 +79,13 @@
 #define OS_CONSOLE_TASK_PRIORITY        OS_UTILITYTASK_PRIORITY
 #define OS_CONSOLE_TASK_STACKSIZE       OS_UTILITYTASK_STACK_SIZE
 
+/*
+ * Timed waits on this platform are tick based; microsecond requests are
+ * rounded up to the next whole millisecond so a wait is never shorter
+ * than requested.
+ */
+#define OS_MICROS_TO_MILLIS(usec)   (((usec) + 999) / 1000)
+
 
 
 /****************************************************************************************
@@ -352,6 +359,23 @@ void OS_ApplicationShutdown_Impl()
 } /* end OS_ApplicationShutdown_Impl */
 
 
+/*----------------------------------------------------------------
+ *
+ * Function: OS_API_LockMemory_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_API_LockMemory_Impl(void)
+{
+    /*
+    ** Memory is not demand paged here, so it is always resident
+    */
+    return (OS_SUCCESS);
+} /* end OS_API_LockMemory_Impl */
+
+
 
 /*---------------------------------------------------------------------------------------
    Name: OS_VxWorksEntry
@@ -408,6 +432,12 @@ int32 OS_TaskCreate_Impl (uint32 task_id, uint32 flags)
 
     lrec = &OS_impl_task_table[task_id];
 
+    /* CPU affinity is not supported in this implementation */
+    if (OS_task_table[task_id].cpu_mask != 0)
+    {
+        return OS_ERR_NOT_IMPLEMENTED;
+    }
+
     /* Create VxWorks Task */
 
     /* see if the user wants floating point enabled. If
@@ -609,6 +639,60 @@ int32 OS_TaskDelay_Impl (uint32 milli_second)
 } /* end OS_TaskDelay_Impl */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskDelayMicros_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskDelayMicros_Impl (uint32 microsecond)
+{
+    return OS_TaskDelay_Impl(OS_MICROS_TO_MILLIS(microsecond));
+} /* end OS_TaskDelayMicros_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskDelayUntil_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskDelayUntil_Impl (const OS_time_t *wake_time)
+{
+    OS_time_t now;
+    uint64    wake_usec;
+    uint64    now_usec;
+    int32     status;
+
+    /*
+     * There is no absolute sleep here, so convert to a relative
+     * delay.  The tick rounding in OS_TaskDelayMicros_Impl means
+     * the task never wakes before the requested time.
+     */
+    status = OS_GetMonotonicTime_Impl(&now);
+    if (status == OS_SUCCESS)
+    {
+        wake_usec = ((uint64)wake_time->seconds * 1000000) + wake_time->microsecs;
+        now_usec = ((uint64)now.seconds * 1000000) + now.microsecs;
+        if (wake_usec > now_usec)
+        {
+            wake_usec -= now_usec;
+            if (wake_usec > 0xFFFFFFFF)
+            {
+                wake_usec = 0xFFFFFFFF;
+            }
+            status = OS_TaskDelayMicros_Impl((uint32)wake_usec);
+        }
+    }
+
+    return status;
+} /* end OS_TaskDelayUntil_Impl */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_TaskSetPriority_Impl
@@ -630,6 +714,46 @@ int32 OS_TaskSetPriority_Impl (uint32 task_id, uint32 new_priority)
 } /* end OS_TaskSetPriority_Impl */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskSetAffinity_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskSetAffinity_Impl (uint32 task_id, uint32 cpu_mask)
+{
+    /* CPU affinity is not supported in this implementation */
+    if (cpu_mask != 0)
+    {
+        return OS_ERR_NOT_IMPLEMENTED;
+    }
+
+    return OS_SUCCESS;
+} /* end OS_TaskSetAffinity_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskSetDeadline_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskSetDeadline_Impl (uint32 task_id, uint32 runtime_usec, uint32 deadline_usec, uint32 period_usec)
+{
+    /* Deadline scheduling is not supported in this implementation */
+    if (runtime_usec != 0)
+    {
+        return OS_ERR_NOT_IMPLEMENTED;
+    }
+
+    return OS_SUCCESS;
+} /* end OS_TaskSetDeadline_Impl */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_TaskMatch_Impl
@@ -698,6 +822,39 @@ uint32 OS_TaskGetId_Impl (void)
 } /* end OS_TaskGetId_Impl */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskGetSelf_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 OS_TaskGetSelf_Impl (uint32 *local_id)
+{
+    OS_impl_task_internal_record_t *lrec;
+    size_t index;
+    uint32 id;
+
+    /* The TCB extension already identifies the table entry directly */
+    id = 0;
+    lrec = (OS_impl_task_internal_record_t *)taskTcb(taskIdSelf());
+
+    if (lrec != NULL)
+    {
+        index = lrec - &OS_impl_task_table[0];
+        if (index < OS_MAX_TASKS)
+        {
+            id = OS_global_task_table[index].active_id;
+            *local_id = index;
+        }
+    }
+
+    return id;
+
+} /* end OS_TaskGetSelf_Impl */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_TaskGetInfo_Impl
@@ -727,6 +884,50 @@ int32 OS_TaskGetInfo_Impl (uint32 task_id, OS_task_prop_t *task_prop)
 
 } /* end OS_TaskGetInfo_Impl */
 
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskGetStats_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskGetStats_Impl (uint32 task_id, OS_task_stats_t *task_stats, uint32 *os_thread_id)
+{
+    /* Per-task statistics are not supported in this implementation */
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_TaskGetStats_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskGetThreadStats_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_TaskGetThreadStats_Impl (uint32 os_thread_id, OS_task_stats_t *task_stats)
+{
+    /* Never called, as OS_TaskGetStats_Impl() provides no thread ID */
+} /* end OS_TaskGetThreadStats_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TaskGetStackPoolStats_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TaskGetStackPoolStats_Impl (OS_stack_pool_stats_t *stats)
+{
+    /* Task stacks are not pooled in this implementation */
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_TaskGetStackPoolStats_Impl */
+
 
 /****************************************************************************************
                                 MESSAGE QUEUE API
@@ -860,6 +1061,33 @@ int32 OS_QueueGet_Impl (uint32 queue_id, void *data, uint32 size, uint32 *size_c
 } /* end OS_QueueGet_Impl */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_QueueGetMicros_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_QueueGetMicros_Impl (uint32 queue_id, void *data, uint32 size, uint32 *size_copied,
+                    int32 timeout_usec)
+{
+    int32 timeout;
+
+    if (timeout_usec > 0)
+    {
+        timeout = OS_MICROS_TO_MILLIS(timeout_usec);
+    }
+    else
+    {
+        /* OS_PEND and OS_CHECK pass through unchanged */
+        timeout = timeout_usec;
+    }
+
+    return OS_QueueGet_Impl(queue_id, data, size, size_copied, timeout);
+} /* end OS_QueueGetMicros_Impl */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_QueuePut_Impl
@@ -1104,6 +1332,20 @@ int32 OS_BinSemTimedWait_Impl (uint32 sem_id, uint32 msecs)
 } /* end OS_BinSemTimedWait_Impl */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BinSemTimedWaitMicros_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BinSemTimedWaitMicros_Impl (uint32 sem_id, uint32 usecs)
+{
+    return OS_BinSemTimedWait_Impl(sem_id, OS_MICROS_TO_MILLIS(usecs));
+} /* end OS_BinSemTimedWaitMicros_Impl */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_BinSemGetInfo_Impl
@@ -1232,6 +1474,20 @@ int32 OS_CountSemTimedWait_Impl (uint32 sem_id, uint32 msecs)
 } /* end OS_CountSemTimedWait_Impl */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CountSemTimedWaitMicros_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CountSemTimedWaitMicros_Impl (uint32 sem_id, uint32 usecs)
+{
+    return OS_CountSemTimedWait_Impl(sem_id, OS_MICROS_TO_MILLIS(usecs));
+} /* end OS_CountSemTimedWaitMicros_Impl */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_CountSemGetInfo_Impl
@@ -1359,6 +1615,430 @@ int32 OS_MutSemGetInfo_Impl (uint32 sem_id, OS_mut_sem_prop_t *mut_prop)
 
 } /* end OS_MutSemGetInfo_Impl */
 
+/****************************************************************************************
+                          CONDITION VARIABLE / BARRIER API
+ ***************************************************************************************/
+
+/*
+ * Condition variables and barriers are not yet implemented on this OS.
+ */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarCreate_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarCreate_Impl (uint32 var_id, uint32 options)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_CondVarCreate_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarDelete_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarDelete_Impl (uint32 var_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_CondVarDelete_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarLock_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarLock_Impl (uint32 var_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_CondVarLock_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarUnlock_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarUnlock_Impl (uint32 var_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_CondVarUnlock_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarSignal_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarSignal_Impl (uint32 var_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_CondVarSignal_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarBroadcast_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarBroadcast_Impl (uint32 var_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_CondVarBroadcast_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarWait_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarWait_Impl (uint32 var_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_CondVarWait_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarTimedWait_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarTimedWait_Impl (uint32 var_id, uint32 msecs)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_CondVarTimedWait_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_CondVarGetInfo_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_CondVarGetInfo_Impl (uint32 var_id, OS_condvar_prop_t *condvar_prop)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_CondVarGetInfo_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierCreate_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierCreate_Impl (uint32 barrier_id, uint32 options)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_BarrierCreate_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierDelete_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierDelete_Impl (uint32 barrier_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_BarrierDelete_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierWait_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierWait_Impl (uint32 barrier_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_BarrierWait_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_BarrierGetInfo_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_BarrierGetInfo_Impl (uint32 barrier_id, OS_barrier_prop_t *barrier_prop)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_BarrierGetInfo_Impl */
+
+
+/****************************************************************************************
+                                    WORKER POOL API
+ ***************************************************************************************/
+
+/*
+ * Worker pools are not yet implemented on this OS.
+ */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolCreate_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolCreate_Impl (uint32 pool_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_WorkPoolCreate_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolDelete_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolDelete_Impl (uint32 pool_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_WorkPoolDelete_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolLock_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolLock_Impl (uint32 pool_id, uint32 lock_idx)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_WorkPoolLock_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolUnlock_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolUnlock_Impl (uint32 pool_id, uint32 lock_idx)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_WorkPoolUnlock_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolPost_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolPost_Impl (uint32 pool_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_WorkPoolPost_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolPend_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolPend_Impl (uint32 pool_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_WorkPoolPend_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolIdleWait_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolIdleWait_Impl (uint32 pool_id, int32 msecs)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_WorkPoolIdleWait_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_WorkPoolIdleNotify_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_WorkPoolIdleNotify_Impl (uint32 pool_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_WorkPoolIdleNotify_Impl */
+
+
+/****************************************************************************************
+                                       FIBER API
+ ***************************************************************************************/
+
+/*
+ * Fibers are not yet implemented on this OS.
+ */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberCreate_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberCreate_Impl (uint32 fiber_id, uint32 flags)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_FiberCreate_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberDelete_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberDelete_Impl (uint32 fiber_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_FiberDelete_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberSwitchIn_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberSwitchIn_Impl (uint32 fiber_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_FiberSwitchIn_Impl */
+
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberSwitchOut_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberSwitchOut_Impl (uint32 fiber_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_FiberSwitchOut_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberTaskInit_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberTaskInit_Impl (uint32 task_id)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_FiberTaskInit_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberNotifyEnable_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_FiberNotifyEnable_Impl (uint32 task_id, bool enable)
+{
+} /* end OS_FiberNotifyEnable_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberNotify_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_FiberNotify_Impl (void)
+{
+} /* end OS_FiberNotify_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_FiberIdle_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_FiberIdle_Impl (uint32 task_id, OS_FdSet *ReadSet, OS_FdSet *WriteSet, int64 timeout_usec)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+} /* end OS_FiberIdle_Impl */
+
+
 /****************************************************************************************
                                     TICK API
 ****************************************************************************************/
@@ -1502,6 +2182,37 @@ int32 OS_HeapGetInfo_Impl       (OS_heap_prop_t *heap_prop)
 } /* end OS_HeapGetInfo_Impl */
 
                         
+/*----------------------------------------------------------------
+ *
+ * Function: OS_HeapLockdown_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_HeapLockdown_Impl(uint32 options)
+{
+    /*
+    ** Not implemented yet
+    */
+    return (OS_ERR_NOT_IMPLEMENTED);
+} /* end OS_HeapLockdown_Impl */
+
+                        
+/*----------------------------------------------------------------
+ *
+ * Function: OS_HeapGetLateAllocs_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_HeapGetLateAllocs_Impl(uint32 *count)
+{
+    return (OS_ERR_NOT_IMPLEMENTED);
+} /* end OS_HeapGetLateAllocs_Impl */
+
+                        
 /*----------------------------------------------------------------
  *
  * Function: OS_IntSetMask_Impl
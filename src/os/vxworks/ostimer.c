@@ -525,8 +525,10 @@ int32 OS_TimeBaseCreate_Impl(uint32 timer_id)
  *           See prototype in os-impl.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-int32 OS_TimeBaseSet_Impl(uint32 timer_id, int32 start_time, int32 interval_time)
+int32 OS_TimeBaseSet_Impl(uint32 timer_id, uint64 start_ns, uint64 interval_ns)
 {
+    int32 start_time;
+    int32 interval_time;
     OS_impl_timebase_internal_record_t *local;
     struct itimerspec timeout;
     int32 return_code;
@@ -534,6 +536,14 @@ int32 OS_TimeBaseSet_Impl(uint32 timer_id, int32 start_time, int32 interval_time
 
     local = &OS_impl_timebase_table[timer_id];
 
+    /* The kernel timer works in microseconds, so round up to the next one */
+    if (start_ns > ((uint64)0x7FFFFFFF * 1000) || interval_ns > ((uint64)0x7FFFFFFF * 1000))
+    {
+        return OS_TIMER_ERR_INVALID_ARGS;
+    }
+    start_time = (int32)((start_ns + 999) / 1000);
+    interval_time = (int32)((interval_ns + 999) / 1000);
+
     /* There is only something to do here if we are generating a simulated tick */
     if (local->assigned_signal <= 0)
     {
@@ -665,6 +675,60 @@ int32 OS_TimeBaseGetInfo_Impl (uint32 timer_id, OS_timebase_prop_t *timer_prop)
 
 } /* end OS_TimeBaseGetInfo_Impl */
 
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBaseSetTickless_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TimeBaseSetTickless_Impl (uint32 timer_id, bool tickless)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+
+} /* end OS_TimeBaseSetTickless_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBaseNextDue_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void OS_TimeBaseNextDue_Impl (uint32 timer_id, uint64 tick_time, uint64 wait_time)
+{
+} /* end OS_TimeBaseNextDue_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBaseTickLateness_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_TimeBaseTickLateness_Impl (uint32 timer_id, uint64 tick_time, uint32 *lateness_usec)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+
+} /* end OS_TimeBaseTickLateness_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_TimeBaseSkippedTime_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint64 OS_TimeBaseSkippedTime_Impl (uint32 timer_id)
+{
+    return 0;
+
+} /* end OS_TimeBaseSkippedTime_Impl */
+
 /****************************************************************************************
                   Other Time-Related API Implementation
 ****************************************************************************************/
@@ -672,3 +736,32 @@ int32 OS_TimeBaseGetInfo_Impl (uint32 timer_id, OS_timebase_prop_t *timer_prop)
 /* VxWorks implements POSIX-style clock_gettime and clock_settime calls */
 #include "../portable/os-impl-posix-gettime.c"
 
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTimeAdvance_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_VirtualTimeAdvance_Impl(uint64 nsecs)
+{
+    /* time always follows the kernel clock */
+    return OS_ERR_NOT_IMPLEMENTED;
+
+} /* end OS_VirtualTimeAdvance_Impl */
+
+/*----------------------------------------------------------------
+ *
+ * Function: OS_VirtualTimeSetAuto_Impl
+ *
+ *  Purpose: Implemented per internal OSAL API
+ *           See prototype in os-impl.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 OS_VirtualTimeSetAuto_Impl(bool auto_advance)
+{
+    return OS_ERR_NOT_IMPLEMENTED;
+
+} /* end OS_VirtualTimeSetAuto_Impl */
+
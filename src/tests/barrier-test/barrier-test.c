@@ -0,0 +1,262 @@
+/*
+** Barrier and Condition Variable Test
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void BarrierSetup(void);
+void BarrierCheck(void);
+void BarrierTeardown(void);
+
+#define TASK_STACK_SIZE  4096
+#define TASK_PRIORITY    100
+#define NUM_WORKERS      4
+#define NUM_CYCLES       1000
+
+uint32 worker_stack[NUM_WORKERS][TASK_STACK_SIZE];
+uint32 worker_id[NUM_WORKERS];
+volatile uint32 worker_cycles[NUM_WORKERS];
+uint32 worker_failures[NUM_WORKERS];
+
+uint32 barrier_id;
+uint32 condvar_id;
+uint32 workers_done;
+
+uint32 waiter_stack[TASK_STACK_SIZE];
+uint32 waiter_id;
+volatile uint32 waiter_state;
+
+/*
+ * Each worker does NUM_CYCLES rendezvous at the barrier.  After passing
+ * the barrier, every other worker must have completed at least as many
+ * cycles as this one, otherwise the barrier released early.
+ *
+ * When finished, each worker reports in via the condition variable.
+ */
+void worker_task(void)
+{
+    uint32 self;
+    uint32 i;
+    uint32 j;
+    int32  status;
+
+    OS_TaskRegister();
+
+    /* figure out which worker this is */
+    self = NUM_WORKERS;
+    while (self >= NUM_WORKERS)
+    {
+        for (self = 0; self < NUM_WORKERS; ++self)
+        {
+            if (worker_id[self] == OS_TaskGetId())
+            {
+                break;
+            }
+        }
+
+        if (self >= NUM_WORKERS)
+        {
+            /* worker_id may not be written yet; try again */
+            OS_TaskDelay(1);
+        }
+    }
+
+    for (i = 0; i < NUM_CYCLES; ++i)
+    {
+        ++worker_cycles[self];
+
+        status = OS_BarrierWait(barrier_id);
+        if (status != OS_SUCCESS)
+        {
+            ++worker_failures[self];
+            break;
+        }
+
+        for (j = 0; j < NUM_WORKERS; ++j)
+        {
+            if (worker_cycles[j] < worker_cycles[self])
+            {
+                ++worker_failures[self];
+            }
+        }
+    }
+
+    if (OS_CondVarLock(condvar_id) != OS_SUCCESS)
+    {
+        ++worker_failures[self];
+    }
+    ++workers_done;
+    OS_CondVarBroadcast(condvar_id);
+    OS_CondVarUnlock(condvar_id);
+
+    OS_TaskExit();
+}
+
+/*
+ * Waits on the condition variable once, so that its deletion can be
+ * checked while a task is waiting on it.
+ */
+void waiter_task(void)
+{
+    OS_TaskRegister();
+
+    OS_CondVarLock(condvar_id);
+    waiter_state = 1;
+    OS_CondVarTimedWait(condvar_id, 1000);
+    OS_CondVarUnlock(condvar_id);
+    waiter_state = 2;
+
+    OS_TaskExit();
+}
+
+/*
+** Main function
+*/
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(BarrierCheck, BarrierSetup, BarrierTeardown, "BarrierTest");
+}
+
+void BarrierSetup(void)
+{
+    int32 status;
+    uint32 i;
+    char name[OS_MAX_API_NAME];
+    OS_barrier_prop_t barrier_prop;
+
+    /* Note that UT assert is not multi-thread safe,
+     * so each thread must use a separate error counter
+     * and then we will assert that these remain zero
+     */
+    memset(worker_id, 0, sizeof(worker_id));
+    memset((void*)worker_cycles, 0, sizeof(worker_cycles));
+    memset(worker_failures, 0, sizeof(worker_failures));
+    workers_done = 0;
+
+    status = OS_BarrierCreate(&barrier_id, "Barrier", 0, 0);
+    UtAssert_True(status == OS_INVALID_SEM_VALUE, "Barrier create count=0 Rc=%d", (int)status);
+
+    status = OS_BarrierCreate(&barrier_id, "Barrier", NUM_WORKERS, 0);
+    UtAssert_True(status == OS_SUCCESS, "Barrier create Id=%u Rc=%d", (unsigned int)barrier_id, (int)status);
+
+    status = OS_BarrierGetInfo(barrier_id, &barrier_prop);
+    UtAssert_True(status == OS_SUCCESS, "Barrier GetInfo Rc=%d", (int)status);
+    UtAssert_True(barrier_prop.count == NUM_WORKERS, "Barrier count=%u", (unsigned int)barrier_prop.count);
+    UtAssert_True(barrier_prop.waiting == 0, "Barrier waiting=%u", (unsigned int)barrier_prop.waiting);
+
+    status = OS_CondVarCreate(&condvar_id, "CondVar", 0);
+    UtAssert_True(status == OS_SUCCESS, "CondVar create Id=%u Rc=%d", (unsigned int)condvar_id, (int)status);
+
+    /*
+    ** Create the tasks
+    */
+    for (i = 0; i < NUM_WORKERS; ++i)
+    {
+        snprintf(name, sizeof(name), "Worker %u", (unsigned int)i);
+        status = OS_TaskCreate(&worker_id[i], name, worker_task, worker_stack[i],
+                TASK_STACK_SIZE, TASK_PRIORITY, 0);
+        UtAssert_True(status == OS_SUCCESS, "%s create Id=%u Rc=%d", name,
+                (unsigned int)worker_id[i], (int)status);
+    }
+}
+
+void BarrierCheck(void)
+{
+    int32 status;
+    uint32 i;
+    uint32 timeouts;
+
+    /*
+     * Wait for all workers to report in, but do not wait forever
+     * in case something is broken.
+     */
+    timeouts = 0;
+    status = OS_CondVarLock(condvar_id);
+    UtAssert_True(status == OS_SUCCESS, "CondVar lock Rc=%d", (int)status);
+    while (workers_done < NUM_WORKERS && timeouts < 10)
+    {
+        status = OS_CondVarTimedWait(condvar_id, 1000);
+        if (status == OS_SEM_TIMEOUT)
+        {
+            ++timeouts;
+        }
+        else
+        {
+            UtAssert_True(status == OS_SUCCESS, "CondVar wait Rc=%d", (int)status);
+        }
+    }
+    status = OS_CondVarUnlock(condvar_id);
+    UtAssert_True(status == OS_SUCCESS, "CondVar unlock Rc=%d", (int)status);
+
+    UtAssert_True(workers_done == NUM_WORKERS, "Workers done = %u", (unsigned int)workers_done);
+
+    for (i = 0; i < NUM_WORKERS; ++i)
+    {
+        UtAssert_True(worker_cycles[i] == NUM_CYCLES, "Worker %u cycles = %u",
+                (unsigned int)i, (unsigned int)worker_cycles[i]);
+        UtAssert_True(worker_failures[i] == 0, "Worker %u failures = %u",
+                (unsigned int)i, (unsigned int)worker_failures[i]);
+    }
+
+    /* Nobody is waiting now, so a timed wait should time out */
+    OS_CondVarLock(condvar_id);
+    status = OS_CondVarTimedWait(condvar_id, 10);
+    OS_CondVarUnlock(condvar_id);
+    UtAssert_True(status == OS_SEM_TIMEOUT, "CondVar idle wait Rc=%d", (int)status);
+
+    /* A condition variable with a waiting task cannot be deleted */
+    waiter_state = 0;
+    status = OS_TaskCreate(&waiter_id, "Waiter", waiter_task, waiter_stack,
+            TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "Waiter create Id=%u Rc=%d", (unsigned int)waiter_id, (int)status);
+    for (i = 0; i < 100 && waiter_state == 0; ++i)
+    {
+        OS_TaskDelay(10);
+    }
+
+    /* the mutex is only free again once the waiter is waiting */
+    OS_CondVarLock(condvar_id);
+    OS_CondVarUnlock(condvar_id);
+    status = OS_CondVarDelete(condvar_id);
+    UtAssert_True(status == OS_ERR_OBJECT_IN_USE, "CondVar delete while waiting Rc=%d", (int)status);
+
+    for (i = 0; i < 200 && waiter_state != 2; ++i)
+    {
+        OS_TaskDelay(10);
+    }
+    UtAssert_True(waiter_state == 2, "Waiter state = %u", (unsigned int)waiter_state);
+
+    /* Nor one whose mutex is held, which the delete must not wait for */
+    OS_CondVarLock(condvar_id);
+    status = OS_CondVarDelete(condvar_id);
+    OS_CondVarUnlock(condvar_id);
+    UtAssert_True(status == OS_ERR_OBJECT_IN_USE, "CondVar delete while locked Rc=%d", (int)status);
+}
+
+void BarrierTeardown(void)
+{
+    int32 status;
+
+    /* Allow the workers to finish exiting */
+    OS_TaskDelay(100);
+
+    status = OS_BarrierDelete(barrier_id);
+    UtAssert_True(status == OS_SUCCESS, "Barrier delete Rc=%d", (int)status);
+
+    status = OS_CondVarDelete(condvar_id);
+    UtAssert_True(status == OS_SUCCESS, "CondVar delete Rc=%d", (int)status);
+}
@@ -0,0 +1,208 @@
+/*
+** Deadline task test
+**
+** Runs two tasks under deadline scheduling: a periodic worker that uses
+** well under its runtime budget each period, and a "hog" that never
+** blocks and so exceeds its budget every period.  The worker must not
+** report budget overruns, while the hog must report them and must be
+** throttled enough that the rest of the system keeps running.
+**
+** Deadline scheduling needs OS support and privilege, and the OS may
+** refuse a reservation if it cannot guarantee it.  Where it is not
+** available the tasks keep their fixed priority; the fallback is checked
+** and the deadline results are reported as not applicable.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void DeadlineSetup(void);
+void DeadlineCheck(void);
+void DeadlineTeardown(void);
+
+#define TASK_STACK_SIZE  4096
+#define TASK_PRIORITY    100
+#define PERIOD_USEC      10000
+#define WORKER_BUDGET    3000
+#define WORKER_SPIN      500
+#define HOG_BUDGET       1000
+#define RUN_MSEC         300
+
+uint32 worker_stack[TASK_STACK_SIZE];
+uint32 hog_stack[TASK_STACK_SIZE];
+uint32 worker_id;
+uint32 hog_id;
+int32  worker_status;
+int32  hog_status;
+volatile uint32 worker_cycles;
+volatile uint32 hog_loops;
+volatile bool   tasks_stop;
+
+/*
+ * Busy wait for the given number of microseconds of wall clock time
+ */
+static void spin_usec(uint32 usec)
+{
+    OS_time_t start;
+    OS_time_t now;
+    uint32 elapsed;
+
+    OS_GetLocalTime(&start);
+    do
+    {
+        OS_GetLocalTime(&now);
+        elapsed = (now.seconds - start.seconds) * 1000000 + now.microsecs - start.microsecs;
+    }
+    while (elapsed < usec);
+}
+
+void worker_task(void)
+{
+    OS_TaskSetPeriod(PERIOD_USEC);
+
+    while (!tasks_stop)
+    {
+        spin_usec(WORKER_SPIN);
+        ++worker_cycles;
+        OS_TaskWaitPeriod(NULL);
+    }
+
+    OS_TaskExit();
+}
+
+void hog_task(void)
+{
+    /* With deadline scheduling the OS stops this task once its budget is used */
+    while (!tasks_stop)
+    {
+        ++hog_loops;
+    }
+
+    OS_TaskExit();
+}
+
+/*
+** Main function
+*/
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(DeadlineCheck, DeadlineSetup, DeadlineTeardown, "DeadlineTaskTest");
+}
+
+void DeadlineSetup(void)
+{
+    int32 status;
+
+    worker_cycles = 0;
+    hog_loops = 0;
+    tasks_stop = false;
+
+    status = OS_TaskCreate(&worker_id, "DlWorker", worker_task, worker_stack,
+            TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "Worker create Id=%u Rc=%d", (unsigned int)worker_id, (int)status);
+
+    /* The reservation may be requested before the task has started running */
+    worker_status = OS_TaskSetDeadline(worker_id, WORKER_BUDGET, 0, PERIOD_USEC);
+    UtAssert_True(worker_status == OS_SUCCESS || worker_status == OS_ERR_NOT_IMPLEMENTED ||
+            worker_status == OS_ERROR, "Worker SetDeadline Rc=%d", (int)worker_status);
+
+    /*
+     * The hog is stopped straight away if it cannot be throttled, as
+     * otherwise it would keep any lower priority task from running
+     */
+    status = OS_TaskCreate(&hog_id, "DlHog", hog_task, hog_stack,
+            TASK_STACK_SIZE, OS_MAX_TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "Hog create Id=%u Rc=%d", (unsigned int)hog_id, (int)status);
+
+    hog_status = OS_TaskSetDeadline(hog_id, HOG_BUDGET, PERIOD_USEC, PERIOD_USEC);
+    UtAssert_True(hog_status == OS_SUCCESS || hog_status == OS_ERR_NOT_IMPLEMENTED ||
+            hog_status == OS_ERROR, "Hog SetDeadline Rc=%d", (int)hog_status);
+    if (hog_status != OS_SUCCESS)
+    {
+        tasks_stop = true;
+    }
+}
+
+void DeadlineCheck(void)
+{
+    int32 status;
+    uint32 start_cycles;
+    OS_task_prop_t worker_prop;
+    OS_task_prop_t hog_prop;
+
+    /* Inconsistent reservations are refused */
+    status = OS_TaskSetDeadline(worker_id, PERIOD_USEC * 2, 0, PERIOD_USEC);
+    UtAssert_True(status == OS_ERROR, "SetDeadline(runtime > period) Rc=%d", (int)status);
+    status = OS_TaskSetDeadline(0, WORKER_BUDGET, 0, PERIOD_USEC);
+    UtAssert_True(status == OS_ERR_INVALID_ID, "SetDeadline(bad id) Rc=%d", (int)status);
+
+    start_cycles = worker_cycles;
+    OS_TaskDelay(RUN_MSEC);
+
+    /* Whatever the scheduling, the worker keeps to its period */
+    UtAssert_True(worker_cycles - start_cycles >= (RUN_MSEC * 1000 / PERIOD_USEC) / 2,
+            "Worker cycles in %u ms=%u", (unsigned int)RUN_MSEC, (unsigned int)(worker_cycles - start_cycles));
+
+    status = OS_TaskGetInfo(worker_id, &worker_prop);
+    UtAssert_True(status == OS_SUCCESS, "Worker GetInfo Rc=%d", (int)status);
+    status = OS_TaskGetInfo(hog_id, &hog_prop);
+    UtAssert_True(status == OS_SUCCESS, "Hog GetInfo Rc=%d", (int)status);
+
+    OS_printf("Worker: runtime=%u deadline=%u period=%u usec, budget overruns=%u\n",
+            (unsigned int)worker_prop.deadline_runtime_usec, (unsigned int)worker_prop.deadline_usec,
+            (unsigned int)worker_prop.deadline_period_usec, (unsigned int)worker_prop.budget_overruns);
+    OS_printf("Hog: runtime=%u deadline=%u period=%u usec, budget overruns=%u\n",
+            (unsigned int)hog_prop.deadline_runtime_usec, (unsigned int)hog_prop.deadline_usec,
+            (unsigned int)hog_prop.deadline_period_usec, (unsigned int)hog_prop.budget_overruns);
+
+    /* A reservation requested before the task started may also have been refused since */
+    if (worker_status != OS_SUCCESS || hog_status != OS_SUCCESS ||
+            worker_prop.deadline_runtime_usec == 0 || hog_prop.deadline_runtime_usec == 0)
+    {
+        UtAssert_Type(NA, true, "Deadline scheduling not available");
+        return;
+    }
+
+    UtAssert_True(worker_prop.deadline_runtime_usec == WORKER_BUDGET &&
+            worker_prop.deadline_usec == PERIOD_USEC && worker_prop.deadline_period_usec == PERIOD_USEC,
+            "Worker reservation reported");
+    UtAssert_True(worker_prop.budget_overruns == 0, "Worker budget overruns=%u",
+            (unsigned int)worker_prop.budget_overruns);
+    UtAssert_True(hog_prop.budget_overruns > 0, "Hog budget overruns=%u",
+            (unsigned int)hog_prop.budget_overruns);
+
+    /* Returning to fixed priority scheduling */
+    status = OS_TaskSetDeadline(worker_id, 0, 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "Worker SetDeadline(0) Rc=%d", (int)status);
+    status = OS_TaskGetInfo(worker_id, &worker_prop);
+    UtAssert_True(status == OS_SUCCESS && worker_prop.deadline_runtime_usec == 0,
+            "Worker reservation cleared Rc=%d", (int)status);
+
+    start_cycles = worker_cycles;
+    OS_TaskDelay(50);
+    UtAssert_True(worker_cycles > start_cycles, "Worker cycles after clearing=%u",
+            (unsigned int)(worker_cycles - start_cycles));
+}
+
+void DeadlineTeardown(void)
+{
+    /* End the reservations before the tasks and the process exit */
+    OS_TaskSetDeadline(worker_id, 0, 0, 0);
+    OS_TaskSetDeadline(hog_id, 0, 0, 0);
+
+    tasks_stop = true;
+    OS_TaskDelay(50);
+}
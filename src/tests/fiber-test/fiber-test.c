@@ -0,0 +1,503 @@
+/*
+** Fiber Test
+**
+** Runs fibers on an OSAL task and verifies that:
+**
+**  - every fiber runs to completion and yields in round-robin order
+**  - OS_TaskDelay() from a fiber sleeps without holding up the other fibers
+**  - fibers of the same task can wait for each other on a binary
+**    semaphore and on a queue
+**  - a fiber waiting on a semaphore wakes when another task gives it
+**
+** It then compares a context switch between two fibers against two tasks
+** handing a binary semaphore back and forth.  The benchmark figures are
+** reported for information only, since they depend entirely on the host.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void FiberSetup(void);
+void FiberCheck(void);
+void FiberTeardown(void);
+
+#define TASK_STACK_SIZE  16384
+#define TASK_PRIORITY    100
+
+#if (OS_MAX_FIBERS < 64)
+#define NUM_FIBERS       OS_MAX_FIBERS
+#else
+#define NUM_FIBERS       64
+#endif
+#define YIELD_ROUNDS     10
+
+#define NUM_SLEEPERS     8
+#define SLEEP_MSEC       20
+
+#define NUM_MESSAGES     100
+
+#define GIVE_DELAY_MSEC  50
+#define GIVE_WAIT_MSEC   5000
+
+#define BENCH_ROUNDS     20000
+
+uint32 host_task_id;
+uint32 done_sem_id;
+uint32 fiber_sem_id;
+uint32 fiber_queue_id;
+uint32 ping_sem_id;
+uint32 give_sem_id;
+uint32 pong_sem_id;
+
+/*
+ * Results recorded by the fibers, checked by the test once they are done
+ */
+uint32 order_log[NUM_FIBERS * YIELD_ROUNDS];
+uint32 order_count;
+uint32 order_errors;
+uint32 fibers_ended;
+
+int32  sleep_elapsed[NUM_SLEEPERS];
+uint32 sleepers_done;
+uint32 sleeper_yields;
+
+uint32 messages_received;
+uint32 messages_in_order;
+uint32 sem_takes;
+
+int32  give_status;
+int32  give_elapsed;
+
+uint32 fiber_id_errors;
+int32  host_status;
+
+uint32 bench_count;
+OS_time_t bench_start;
+OS_time_t bench_end;
+
+static int32 ElapsedMicros(const OS_time_t *start, const OS_time_t *end)
+{
+    return (int32)(((int32)end->seconds - (int32)start->seconds) * 1000000 +
+            ((int32)end->microsecs - (int32)start->microsecs));
+}
+
+static void ReportSwitches(const char *name, uint32 switches, const OS_time_t *start, const OS_time_t *end)
+{
+    int32 elapsed = ElapsedMicros(start, end);
+
+    if (elapsed <= 0)
+    {
+        elapsed = 1;
+    }
+
+    OS_printf("%s: %u switches in %ld usec = %lu nsec/switch\n", name,
+            (unsigned int)switches, (long)elapsed,
+            (unsigned long)(((uint64)elapsed * 1000) / (switches ? switches : 1)));
+}
+
+/*
+ * Round-robin fibers: each pass over the ready fibers runs them in creation order
+ */
+static void OrderFiber(void *arg)
+{
+    uint32 i;
+
+    for (i = 0; i < YIELD_ROUNDS; ++i)
+    {
+        if (order_count < NUM_FIBERS * YIELD_ROUNDS)
+        {
+            order_log[order_count] = (uint32)(unsigned long)arg;
+            ++order_count;
+        }
+        if (OS_FiberYield() != OS_SUCCESS)
+        {
+            ++order_errors;
+        }
+    }
+
+    ++fibers_ended;
+}
+
+/*
+ * Sleeps while the yielding fiber keeps running
+ */
+static void SleepFiber(void *arg)
+{
+    OS_time_t start;
+    OS_time_t end;
+
+    OS_GetLocalTime(&start);
+    OS_TaskDelay(SLEEP_MSEC);
+    OS_GetLocalTime(&end);
+
+    sleep_elapsed[(unsigned long)arg] = ElapsedMicros(&start, &end);
+    ++sleepers_done;
+}
+
+static void YieldUntilSleepersDone(void *arg)
+{
+    while (sleepers_done < NUM_SLEEPERS)
+    {
+        ++sleeper_yields;
+        OS_FiberYield();
+    }
+}
+
+/*
+ * Semaphore and queue waits between fibers of the same task
+ */
+static void ConsumerFiber(void *arg)
+{
+    uint32 msg;
+    uint32 size;
+    uint32 i;
+
+    for (i = 0; i < NUM_MESSAGES; ++i)
+    {
+        if (OS_QueueGet(fiber_queue_id, &msg, sizeof(msg), &size, 1000) != OS_SUCCESS)
+        {
+            break;
+        }
+        ++messages_received;
+        if (msg == i)
+        {
+            ++messages_in_order;
+        }
+
+        /* let the producer continue */
+        OS_BinSemGive(fiber_sem_id);
+    }
+}
+
+static void ProducerFiber(void *arg)
+{
+    uint32 i;
+
+    for (i = 0; i < NUM_MESSAGES; ++i)
+    {
+        if (OS_QueuePut(fiber_queue_id, &i, sizeof(i), 0) != OS_SUCCESS)
+        {
+            break;
+        }
+
+        /* wait for the consumer */
+        if (OS_BinSemTimedWait(fiber_sem_id, 1000) != OS_SUCCESS)
+        {
+            break;
+        }
+        ++sem_takes;
+    }
+}
+
+/*
+ * Semaphore wait between a fiber and another task
+ */
+static void GiveWaitFiber(void *arg)
+{
+    OS_time_t start;
+    OS_time_t end;
+
+    OS_GetLocalTime(&start);
+    give_status = OS_BinSemTimedWait(give_sem_id, GIVE_WAIT_MSEC);
+    OS_GetLocalTime(&end);
+
+    give_elapsed = ElapsedMicros(&start, &end);
+}
+
+void GiverTask(void)
+{
+    OS_TaskRegister();
+
+    OS_TaskDelay(GIVE_DELAY_MSEC);
+    OS_BinSemGive(give_sem_id);
+}
+
+static void FiberIdCheck(void *arg)
+{
+    uint32 *expected = arg;
+    uint32 found_id;
+
+    if (OS_FiberGetId() != *expected ||
+            OS_FiberGetIdByName(&found_id, "IdCheck") != OS_SUCCESS ||
+            found_id != *expected)
+    {
+        ++fiber_id_errors;
+    }
+}
+
+/*
+ * Benchmark: two fibers that yield to each other
+ */
+static void BenchFiber(void *arg)
+{
+    uint32 i;
+
+    for (i = 0; i < BENCH_ROUNDS; ++i)
+    {
+        OS_FiberYield();
+        ++bench_count;
+    }
+}
+
+/*
+ * Runs all of the fibers of the test, one group at a time
+ */
+void FiberHostTask(void)
+{
+    char name[OS_MAX_API_NAME];
+    uint32 fiber_id;
+    uint32 id_check_id;
+    uint32 giver_task_id;
+    uint32 i;
+    int32 status;
+
+    OS_TaskRegister();
+
+    status = OS_SUCCESS;
+    for (i = 0; i < NUM_FIBERS && status == OS_SUCCESS; ++i)
+    {
+        snprintf(name, sizeof(name), "Order%u", (unsigned int)i);
+        status = OS_FiberCreate(&fiber_id, name, OrderFiber, (void*)(unsigned long)i, 0, 0);
+    }
+    if (status == OS_SUCCESS)
+    {
+        status = OS_FiberRun();
+    }
+
+    for (i = 0; i < NUM_SLEEPERS && status == OS_SUCCESS; ++i)
+    {
+        snprintf(name, sizeof(name), "Sleep%u", (unsigned int)i);
+        status = OS_FiberCreate(&fiber_id, name, SleepFiber, (void*)(unsigned long)i, 0, 0);
+    }
+    if (status == OS_SUCCESS)
+    {
+        status = OS_FiberCreate(&fiber_id, "Yielder", YieldUntilSleepersDone, NULL, 0, 0);
+    }
+    if (status == OS_SUCCESS)
+    {
+        status = OS_FiberRun();
+    }
+
+    if (status == OS_SUCCESS)
+    {
+        status = OS_FiberCreate(&fiber_id, "Consumer", ConsumerFiber, NULL, 0, 0);
+    }
+    if (status == OS_SUCCESS)
+    {
+        status = OS_FiberCreate(&fiber_id, "Producer", ProducerFiber, NULL, 0, 0);
+    }
+    if (status == OS_SUCCESS)
+    {
+        status = OS_FiberCreate(&id_check_id, "IdCheck", FiberIdCheck, &id_check_id, 0, 0);
+    }
+    if (status == OS_SUCCESS)
+    {
+        status = OS_FiberRun();
+    }
+
+    if (status == OS_SUCCESS)
+    {
+        status = OS_FiberCreate(&fiber_id, "GiveWait", GiveWaitFiber, NULL, 0, 0);
+    }
+    if (status == OS_SUCCESS)
+    {
+        status = OS_TaskCreate(&giver_task_id, "Giver", GiverTask, NULL, TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    }
+    if (status == OS_SUCCESS)
+    {
+        status = OS_FiberRun();
+    }
+
+    if (status == OS_SUCCESS)
+    {
+        status = OS_FiberCreate(&fiber_id, "BenchA", BenchFiber, NULL, 0, 0);
+    }
+    if (status == OS_SUCCESS)
+    {
+        status = OS_FiberCreate(&fiber_id, "BenchB", BenchFiber, NULL, 0, 0);
+    }
+    if (status == OS_SUCCESS)
+    {
+        OS_GetLocalTime(&bench_start);
+        status = OS_FiberRun();
+        OS_GetLocalTime(&bench_end);
+    }
+
+    host_status = status;
+    OS_BinSemGive(done_sem_id);
+}
+
+/*
+ * Benchmark: two tasks that hand a binary semaphore back and forth
+ */
+void PongTask(void)
+{
+    uint32 i;
+
+    OS_TaskRegister();
+
+    for (i = 0; i < BENCH_ROUNDS; ++i)
+    {
+        if (OS_BinSemTake(ping_sem_id) != OS_SUCCESS)
+        {
+            break;
+        }
+        OS_BinSemGive(pong_sem_id);
+    }
+}
+
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(FiberCheck, FiberSetup, FiberTeardown, "FiberTest");
+}
+
+void FiberSetup(void)
+{
+    int32 status;
+
+    status = OS_BinSemCreate(&done_sem_id, "Done", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "BinSem create Rc=%d", (int)status);
+
+    status = OS_BinSemCreate(&fiber_sem_id, "FiberSem", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "BinSem create Rc=%d", (int)status);
+
+    status = OS_QueueCreate(&fiber_queue_id, "FiberQueue", 4, sizeof(uint32), 0);
+    UtAssert_True(status == OS_SUCCESS, "Queue create Rc=%d", (int)status);
+
+    status = OS_BinSemCreate(&ping_sem_id, "Ping", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "BinSem create Rc=%d", (int)status);
+
+    status = OS_BinSemCreate(&pong_sem_id, "Pong", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "BinSem create Rc=%d", (int)status);
+
+    status = OS_BinSemCreate(&give_sem_id, "GiveSem", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "BinSem create Rc=%d", (int)status);
+}
+
+void FiberCheck(void)
+{
+    OS_fiber_prop_t prop;
+    OS_time_t start;
+    OS_time_t end;
+    uint32 fiber_id;
+    uint32 pong_task_id;
+    uint32 errors;
+    uint32 i;
+    int32 status;
+
+    status = OS_FiberCreate(&fiber_id, "Bad", NULL, NULL, 0, 0);
+    UtAssert_True(status == OS_INVALID_POINTER, "FiberCreate NULL Rc=%d", (int)status);
+
+    status = OS_FiberYield();
+    UtAssert_True(status == OS_ERR_INCORRECT_OBJ_STATE, "FiberYield outside fiber Rc=%d", (int)status);
+
+    status = OS_TaskCreate(&host_task_id, "FiberHost", FiberHostTask, NULL, TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "Task create Rc=%d", (int)status);
+
+    status = OS_BinSemTimedWait(done_sem_id, 30000);
+    UtAssert_True(status == OS_SUCCESS, "Fibers done Rc=%d", (int)status);
+    UtAssert_True(host_status == OS_SUCCESS, "Fiber host Rc=%d", (int)host_status);
+
+    /*
+     * Round-robin order
+     */
+    UtAssert_True(fibers_ended == NUM_FIBERS, "Fibers ended = %u", (unsigned int)fibers_ended);
+    UtAssert_True(order_errors == 0, "Yield errors = %u", (unsigned int)order_errors);
+    UtAssert_True(order_count == NUM_FIBERS * YIELD_ROUNDS, "Fiber runs = %u", (unsigned int)order_count);
+    errors = 0;
+    for (i = 0; i < order_count; ++i)
+    {
+        if (order_log[i] != (i % NUM_FIBERS))
+        {
+            ++errors;
+        }
+    }
+    UtAssert_True(errors == 0, "Runs out of order = %u", (unsigned int)errors);
+
+    /*
+     * Sleeping fibers
+     */
+    UtAssert_True(sleepers_done == NUM_SLEEPERS, "Sleepers done = %u", (unsigned int)sleepers_done);
+    errors = 0;
+    for (i = 0; i < NUM_SLEEPERS; ++i)
+    {
+        if (sleep_elapsed[i] < (SLEEP_MSEC - 1) * 1000)
+        {
+            ++errors;
+        }
+    }
+    UtAssert_True(errors == 0, "Sleepers woken early = %u", (unsigned int)errors);
+    UtAssert_True(sleeper_yields > NUM_SLEEPERS, "Yields while sleeping = %u", (unsigned int)sleeper_yields);
+
+    /*
+     * Waits between fibers
+     */
+    UtAssert_True(messages_received == NUM_MESSAGES, "Messages received = %u", (unsigned int)messages_received);
+    UtAssert_True(messages_in_order == NUM_MESSAGES, "Messages in order = %u", (unsigned int)messages_in_order);
+    UtAssert_True(sem_takes == NUM_MESSAGES, "Semaphore takes = %u", (unsigned int)sem_takes);
+    UtAssert_True(fiber_id_errors == 0, "Fiber ID errors = %u", (unsigned int)fiber_id_errors);
+
+    /* the give wakes the fiber, well before its timeout */
+    UtAssert_True(give_status == OS_SUCCESS, "Wait for other task Rc=%d", (int)give_status);
+    UtAssert_True(give_elapsed >= (GIVE_DELAY_MSEC - 1) * 1000 && give_elapsed < GIVE_WAIT_MSEC * 500,
+            "Wait for other task = %ld usec", (long)give_elapsed);
+
+    /* fibers are deleted once they return */
+    status = OS_FiberGetIdByName(&fiber_id, "Producer");
+    UtAssert_True(status == OS_ERR_NAME_NOT_FOUND, "Ended fiber lookup Rc=%d", (int)status);
+    status = OS_FiberGetInfo(fiber_id, &prop);
+    UtAssert_True(status != OS_SUCCESS, "Ended fiber info Rc=%d", (int)status);
+
+    /*
+     * Fiber switches: each of the fibers yields BENCH_ROUNDS times
+     */
+    UtAssert_True(bench_count == 2 * BENCH_ROUNDS, "Fiber benchmark rounds = %u", (unsigned int)bench_count);
+    ReportSwitches("Fiber yield", 2 * BENCH_ROUNDS, &bench_start, &bench_end);
+
+    /*
+     * Task switches: each round is one switch to the pong task and one back
+     */
+    status = OS_TaskCreate(&pong_task_id, "Pong", PongTask, NULL, TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "Task create Rc=%d", (int)status);
+
+    errors = 0;
+    OS_GetLocalTime(&start);
+    for (i = 0; i < BENCH_ROUNDS; ++i)
+    {
+        OS_BinSemGive(ping_sem_id);
+        if (OS_BinSemTimedWait(pong_sem_id, 1000) != OS_SUCCESS)
+        {
+            ++errors;
+            break;
+        }
+    }
+    OS_GetLocalTime(&end);
+    UtAssert_True(errors == 0, "BinSem ping-pong errors = %u", (unsigned int)errors);
+    ReportSwitches("BinSem ping-pong", 2 * i, &start, &end);
+}
+
+void FiberTeardown(void)
+{
+    /* Allow the tasks to finish exiting */
+    OS_TaskDelay(100);
+
+    OS_BinSemDelete(done_sem_id);
+    OS_BinSemDelete(fiber_sem_id);
+    OS_QueueDelete(fiber_queue_id);
+    OS_BinSemDelete(ping_sem_id);
+    OS_BinSemDelete(pong_sem_id);
+    OS_BinSemDelete(give_sem_id);
+}
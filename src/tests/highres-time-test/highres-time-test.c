@@ -0,0 +1,137 @@
+/*
+** High resolution time test
+**
+** Reads the monotonic time and the high resolution ticks back to back and
+** across a task delay, and verifies that both only move forward, agree
+** with each other and with the length of the delay, and that the tick
+** conversions are consistent.  The cost of a tick reading is reported for
+** information only, since it depends entirely on the host.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void HighResSetup(void);
+void HighResCheck(void);
+void HighResTeardown(void);
+
+#define NUM_READINGS     100000
+#define DELAY_MSEC       100
+
+/*
+ * The monotonic time is read between two tick readings and truncated to
+ * whole microseconds.  The task may also be preempted between readings,
+ * so allow a generous difference between the intervals they measure.
+ */
+#define MEASURE_TOLERANCE_NSEC  1000000
+
+static uint64 TimeToNs(const OS_time_t *time_struct)
+{
+    return ((uint64)time_struct->seconds * 1000000000) + ((uint64)time_struct->microsecs * 1000);
+}
+
+/*
+** Main function
+*/
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(HighResCheck, HighResSetup, HighResTeardown, "HighResTimeTest");
+}
+
+void HighResSetup(void)
+{
+}
+
+void HighResCheck(void)
+{
+    OS_time_t mono_start;
+    OS_time_t mono_end;
+    OS_time_t mono_prev;
+    uint64 ticks_start;
+    uint64 ticks_end;
+    uint64 ticks_prev;
+    uint64 ticks;
+    uint64 ns;
+    uint64 elapsed_ns;
+    uint32 backwards;
+    uint32 i;
+    int32 status;
+
+    /* neither clock may ever go backwards */
+    backwards = 0;
+    OS_GetMonotonicTime(&mono_prev);
+    for (i = 0; i < 1000; ++i)
+    {
+        OS_GetMonotonicTime(&mono_end);
+        if (TimeToNs(&mono_end) < TimeToNs(&mono_prev))
+        {
+            ++backwards;
+        }
+        mono_prev = mono_end;
+    }
+    UtAssert_True(backwards == 0, "Monotonic time went backwards %u times", (unsigned int)backwards);
+
+    backwards = 0;
+    status = OS_GetHighResTicks(&ticks_start);
+    UtAssert_True(status == OS_SUCCESS, "GetHighResTicks Rc=%d", (int)status);
+    ticks_prev = ticks_start;
+    for (i = 0; i < NUM_READINGS; ++i)
+    {
+        OS_GetHighResTicks(&ticks);
+        if (ticks < ticks_prev)
+        {
+            ++backwards;
+        }
+        ticks_prev = ticks;
+    }
+    UtAssert_True(backwards == 0, "High resolution ticks went backwards %u times", (unsigned int)backwards);
+
+    status = OS_HighResTicksToNs(ticks_prev - ticks_start, &elapsed_ns);
+    UtAssert_True(status == OS_SUCCESS, "HighResTicksToNs Rc=%d", (int)status);
+    OS_printf("OS_GetHighResTicks cost %lu nsec per call\n", (unsigned long)(elapsed_ns / NUM_READINGS));
+
+    /* across a delay both clocks measure the same interval, of at least the delay */
+    OS_GetHighResTicks(&ticks_start);
+    OS_GetMonotonicTime(&mono_start);
+    status = OS_TaskDelay(DELAY_MSEC);
+    UtAssert_True(status == OS_SUCCESS, "TaskDelay Rc=%d", (int)status);
+    OS_GetMonotonicTime(&mono_end);
+    OS_GetHighResTicks(&ticks_end);
+
+    OS_HighResTicksToNs(ticks_end - ticks_start, &elapsed_ns);
+    UtAssert_True(elapsed_ns >= (uint64)DELAY_MSEC * 1000000, "Ticks across %u ms delay = %lu nsec",
+            (unsigned int)DELAY_MSEC, (unsigned long)elapsed_ns);
+
+    ns = TimeToNs(&mono_end) - TimeToNs(&mono_start);
+    UtAssert_True(ns <= elapsed_ns + MEASURE_TOLERANCE_NSEC && ns + MEASURE_TOLERANCE_NSEC >= elapsed_ns,
+            "Monotonic time across %u ms delay = %lu nsec", (unsigned int)DELAY_MSEC, (unsigned long)ns);
+
+    /* a second converted to ticks and back is still a second */
+    status = OS_NsToHighResTicks(1000000000, &ticks);
+    UtAssert_True(status == OS_SUCCESS, "NsToHighResTicks Rc=%d", (int)status);
+    status = OS_HighResTicksToNs(ticks, &ns);
+    UtAssert_True(status == OS_SUCCESS && ns <= 1000000000 && ns > 999999000,
+            "1 s = %lu ticks = %lu nsec", (unsigned long)ticks, (unsigned long)ns);
+
+    status = OS_NsToHighResTicks(0xFFFFFFFFFFFFFFFFULL, &ticks);
+    UtAssert_True(status == OS_TIMER_ERR_INVALID_ARGS, "NsToHighResTicks(too large) Rc=%d", (int)status);
+}
+
+void HighResTeardown(void)
+{
+    /* Allow the console output to drain */
+    OS_TaskDelay(100);
+}
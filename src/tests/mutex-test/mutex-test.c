@@ -269,9 +269,25 @@ void MutexSetup(void)
 
 void MutexCheck(void)
 {
+#ifdef OS_MUTEX_DIAGNOSTICS
+    OS_mut_sem_prop_t mut_prop;
+    int32 status;
+#endif
+
     /* None of the tasks should have any failures in their own counters */
     UtAssert_True(task_1_failures == 0, "Task 1 failures = %u",(unsigned int)task_1_failures);
     UtAssert_True(task_2_failures == 0, "Task 2 failures = %u",(unsigned int)task_2_failures);
     UtAssert_True(task_3_failures == 0, "Task 3 failures = %u",(unsigned int)task_3_failures);
+
+#ifdef OS_MUTEX_DIAGNOSTICS
+    /* Every increment of the counter was done under the mutex, nested takes count once */
+    status = OS_MutSemGetInfo(mut_sem_id, &mut_prop);
+    UtAssert_True(status == OS_SUCCESS, "OS_MutSemGetInfo Rc=%d", (int)status);
+    UtAssert_True(mut_prop.take_count > 100, "take_count = %u", (unsigned int)mut_prop.take_count);
+    OS_printf("MutSem1: takes=%u contended=%u inversions=%u long holds=%u max hold=%u usec max wait=%u usec\n",
+          (unsigned int)mut_prop.take_count, (unsigned int)mut_prop.contention_count,
+          (unsigned int)mut_prop.inversion_count, (unsigned int)mut_prop.long_hold_count,
+          (unsigned int)mut_prop.max_hold_usec, (unsigned int)mut_prop.max_wait_usec);
+#endif
 }
 
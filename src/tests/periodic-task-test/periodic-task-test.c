@@ -0,0 +1,165 @@
+/*
+** Periodic task test
+**
+** Runs a task on a fixed period using OS_TaskSetPeriod()/OS_TaskWaitPeriod()
+** and checks that the release points do not drift, even though each
+** cycle does some work of its own, and that a deliberate overrun is
+** reported and the schedule stays phase aligned afterwards.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void PeriodicSetup(void);
+void PeriodicCheck(void);
+void PeriodicTeardown(void);
+
+#define TASK_STACK_SIZE   4096
+#define TASK_PRIORITY     50
+#define PERIOD_USEC       10000
+#define NUM_CYCLES        50
+#define OVERRUN_CYCLE     25
+#define WORK_MSEC         3
+
+uint32 periodic_stack[TASK_STACK_SIZE];
+uint32 periodic_id;
+uint32 done_sem_id;
+
+OS_time_t start_time;
+OS_time_t end_time;
+uint32 total_overruns;
+uint32 overrun_reports;
+uint32 wait_failures;
+int32 unset_wait_status;
+
+void periodic_task(void)
+{
+    uint32 i;
+    uint32 overruns;
+
+    OS_TaskRegister();
+
+    /* No period has been set yet, so this must not block */
+    unset_wait_status = OS_TaskWaitPeriod(&overruns);
+
+    OS_GetLocalTime(&start_time);
+    if (OS_TaskSetPeriod(PERIOD_USEC) != OS_SUCCESS)
+    {
+        ++wait_failures;
+    }
+
+    for (i = 0; i < NUM_CYCLES; ++i)
+    {
+        /*
+         * Simulated work each cycle - with a relative OS_TaskDelay()
+         * this would accumulate as drift.  One cycle runs well past
+         * its deadline to force an overrun.
+         */
+        if (i == OVERRUN_CYCLE)
+        {
+            OS_TaskDelay((PERIOD_USEC * 2) / 1000 + WORK_MSEC);
+        }
+        else
+        {
+            OS_TaskDelay(WORK_MSEC);
+        }
+
+        if (OS_TaskWaitPeriod(&overruns) != OS_SUCCESS)
+        {
+            ++wait_failures;
+        }
+        if (overruns != 0)
+        {
+            total_overruns += overruns;
+            ++overrun_reports;
+        }
+    }
+
+    OS_GetLocalTime(&end_time);
+    OS_BinSemGive(done_sem_id);
+
+    OS_TaskExit();
+}
+
+/*
+** Main function
+*/
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(PeriodicCheck, PeriodicSetup, PeriodicTeardown, "PeriodicTaskTest");
+}
+
+void PeriodicSetup(void)
+{
+    int32 status;
+
+    total_overruns = 0;
+    overrun_reports = 0;
+    wait_failures = 0;
+    unset_wait_status = OS_SUCCESS;
+
+    status = OS_BinSemCreate(&done_sem_id, "PeriodicDone", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "BinSem create Id=%u Rc=%d", (unsigned int)done_sem_id, (int)status);
+
+    status = OS_TaskCreate(&periodic_id, "Periodic", periodic_task, periodic_stack,
+            TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "Task create Id=%u Rc=%d", (unsigned int)periodic_id, (int)status);
+}
+
+void PeriodicCheck(void)
+{
+    int32 status;
+    int32 elapsed_usec;
+    int32 expected_usec;
+    OS_task_prop_t task_prop;
+
+    status = OS_BinSemTimedWait(done_sem_id, (NUM_CYCLES * PERIOD_USEC) / 1000 + 5000);
+    UtAssert_True(status == OS_SUCCESS, "Periodic task completion Rc=%d", (int)status);
+
+    status = OS_TaskGetInfo(periodic_id, &task_prop);
+    if (status == OS_SUCCESS)
+    {
+        UtAssert_True(task_prop.period_usec == PERIOD_USEC, "period_usec=%u",
+                (unsigned int)task_prop.period_usec);
+        UtAssert_True(task_prop.period_overruns == total_overruns, "period_overruns=%u",
+                (unsigned int)task_prop.period_overruns);
+    }
+
+    UtAssert_True(unset_wait_status == OS_ERR_INCORRECT_OBJ_STATE, "Wait without period Rc=%d",
+            (int)unset_wait_status);
+    UtAssert_True(wait_failures == 0, "Wait failures=%u", (unsigned int)wait_failures);
+    UtAssert_True(overrun_reports >= 1 && total_overruns >= 2, "Overrun reports=%u total=%u",
+            (unsigned int)overrun_reports, (unsigned int)total_overruns);
+
+    /*
+     * Every cycle (including the skipped ones) is exactly one period,
+     * so the total should be the cycle count plus skipped release points,
+     * with at most one period of slack rather than per-cycle drift.
+     */
+    elapsed_usec = ((int32)end_time.seconds - (int32)start_time.seconds) * 1000000 +
+            ((int32)end_time.microsecs - (int32)start_time.microsecs);
+    expected_usec = (NUM_CYCLES + total_overruns - overrun_reports) * PERIOD_USEC;
+    OS_printf("Periodic: elapsed=%ld usec expected=%ld usec overruns=%u\n",
+            (long)elapsed_usec, (long)expected_usec, (unsigned int)total_overruns);
+    UtAssert_True(elapsed_usec >= expected_usec - PERIOD_USEC && elapsed_usec <= expected_usec + PERIOD_USEC,
+            "Elapsed %ld usec within one period of %ld usec", (long)elapsed_usec, (long)expected_usec);
+}
+
+void PeriodicTeardown(void)
+{
+    OS_TaskDelay(10);
+    OS_BinSemDelete(done_sem_id);
+}
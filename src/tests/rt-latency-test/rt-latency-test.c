@@ -0,0 +1,220 @@
+/*
+** Real-time latency test
+**
+** A cyclictest-style benchmark: a high priority task wakes on a fixed
+** period and records how late each wake-up is relative to its ideal
+** release time.  Each cycle also uses a different page of a large stack
+** buffer, as a task with a deep call chain would, so any page not yet
+** faulted in shows up as a latency outlier in the first cycles.
+**
+** OSAL is initialized with memory locking and stack prefaulting, and the
+** heap is locked down before the measurement starts; the measurement loop
+** must not allocate.  Memory locking needs privilege (CAP_IPC_LOCK or a
+** sufficient RLIMIT_MEMLOCK) - the result is reported either way.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void LatencySetup(void);
+void LatencyCheck(void);
+void LatencyTeardown(void);
+
+#define RT_OPTIONS       (OS_RT_LOCK_MEMORY | OS_RT_PREFAULT_STACKS | OS_RT_COUNT_ALLOCATIONS)
+#define TASK_STACK_SIZE  (128 * 1024)
+#define TASK_PRIORITY    10
+#define PERIOD_USEC      1000
+#define NUM_CYCLES       2000
+#define WARMUP_CYCLES    32
+#define SCRATCH_PAGES    24
+#define SCRATCH_PAGE     4096
+
+uint32 latency_stack[TASK_STACK_SIZE / sizeof(uint32)];
+uint32 latency_id;
+uint32 done_sem_id;
+
+int32  lat_min;
+int32  lat_max;
+int32  lat_warmup_max;
+int64  lat_sum;
+uint32 wait_failures;
+uint32 loop_allocations;
+int32  lockdown_status;
+
+static int32 TimeDiffMicros(const OS_time_t *later, const OS_time_t *earlier)
+{
+    return ((int32)later->seconds - (int32)earlier->seconds) * 1000000 +
+            ((int32)later->microsecs - (int32)earlier->microsecs);
+}
+
+/*
+ * Write to one page of a stack buffer, walking a different page each cycle
+ */
+static void __attribute__((noinline)) stack_work(uint32 cycle)
+{
+    uint8 scratch[SCRATCH_PAGES * SCRATCH_PAGE];
+    volatile uint8 *page;
+
+    page = &scratch[(cycle % SCRATCH_PAGES) * SCRATCH_PAGE];
+    *page = (uint8)cycle;
+}
+
+void latency_task(void)
+{
+    OS_realtime_prop_t rt_before;
+    OS_realtime_prop_t rt_after;
+    OS_time_t start;
+    OS_time_t now;
+    uint32 overruns;
+    uint32 release;
+    uint32 i;
+    int32 lat;
+
+    OS_TaskRegister();
+
+    OS_API_GetRealtimeInfo(&rt_before);
+    OS_GetLocalTime(&start);
+    OS_TaskSetPeriod(PERIOD_USEC);
+
+    release = 1;
+    for (i = 1; i <= NUM_CYCLES; ++i)
+    {
+        overruns = 0;
+        if (OS_TaskWaitPeriod(&overruns) != OS_SUCCESS)
+        {
+            ++wait_failures;
+        }
+        OS_GetLocalTime(&now);
+
+        /*
+         * Lateness against the ideal release point of this cycle.  After
+         * an overrun the call returns at once for the missed release
+         * point, and the schedule then skips ahead past the others.
+         */
+        lat = TimeDiffMicros(&now, &start) - (int32)(release * PERIOD_USEC);
+        release += (overruns != 0) ? overruns : 1;
+        if (i <= WARMUP_CYCLES && lat > lat_warmup_max)
+        {
+            lat_warmup_max = lat;
+        }
+        if (lat < lat_min)
+        {
+            lat_min = lat;
+        }
+        if (lat > lat_max)
+        {
+            lat_max = lat;
+        }
+        lat_sum += lat;
+
+        stack_work(i);
+    }
+
+    OS_API_GetRealtimeInfo(&rt_after);
+    loop_allocations = rt_after.late_allocations - rt_before.late_allocations;
+
+    OS_BinSemGive(done_sem_id);
+
+    OS_TaskExit();
+}
+
+/*
+** Main function
+*/
+void OS_Application_Startup(void)
+{
+    if (OS_API_InitRealtime(RT_OPTIONS) != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_InitRealtime() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(LatencyCheck, LatencySetup, LatencyTeardown, "RtLatencyTest");
+}
+
+void LatencySetup(void)
+{
+    int32 status;
+
+    lat_min = 0x7FFFFFFF;
+    lat_max = -0x7FFFFFFF;
+    lat_warmup_max = -0x7FFFFFFF;
+    lat_sum = 0;
+    wait_failures = 0;
+    loop_allocations = 0;
+
+    status = OS_BinSemCreate(&done_sem_id, "LatencyDone", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "BinSem create Id=%u Rc=%d", (unsigned int)done_sem_id, (int)status);
+
+    /* This is the end of initialization - nothing below should allocate */
+    lockdown_status = OS_HeapLockdown();
+
+    status = OS_TaskCreate(&latency_id, "Latency", latency_task, latency_stack,
+            TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "Task create Id=%u Rc=%d", (unsigned int)latency_id, (int)status);
+}
+
+void LatencyCheck(void)
+{
+    int32 status;
+    OS_realtime_prop_t rt_prop;
+    void * volatile block;
+    uint32 allocations;
+
+    status = OS_BinSemTimedWait(done_sem_id, (NUM_CYCLES * PERIOD_USEC) / 1000 + 5000);
+    UtAssert_True(status == OS_SUCCESS, "Latency task completion Rc=%d", (int)status);
+    UtAssert_True(wait_failures == 0, "Wait failures=%u", (unsigned int)wait_failures);
+
+    status = OS_API_GetRealtimeInfo(&rt_prop);
+    UtAssert_True(status == OS_SUCCESS, "OS_API_GetRealtimeInfo() Rc=%d", (int)status);
+    UtAssert_True(rt_prop.options == RT_OPTIONS, "Options=0x%x", (unsigned int)rt_prop.options);
+
+    OS_printf("Memory locked: %s\n", rt_prop.memory_locked ? "yes" : "no (insufficient privilege?)");
+    OS_printf("Latency over %u cycles of %u usec: min=%ld avg=%ld max=%ld usec\n",
+            (unsigned int)NUM_CYCLES, (unsigned int)PERIOD_USEC, (long)lat_min,
+            (long)(lat_sum / NUM_CYCLES), (long)lat_max);
+    OS_printf("Max latency in first %u cycles (first stack touch): %ld usec\n",
+            (unsigned int)WARMUP_CYCLES, (long)lat_warmup_max);
+
+    if (lockdown_status == OS_ERR_NOT_IMPLEMENTED)
+    {
+        UtAssert_Type(NA, true, "Heap allocation tracking not implemented");
+        return;
+    }
+
+    UtAssert_True(lockdown_status == OS_SUCCESS, "OS_HeapLockdown() Rc=%d", (int)lockdown_status);
+    UtAssert_True(rt_prop.heap_locked_down, "Heap locked down");
+    UtAssert_True(loop_allocations == 0, "Allocations in measurement loop=%u",
+            (unsigned int)loop_allocations);
+
+    /* a deliberate allocation must be counted */
+    allocations = rt_prop.late_allocations;
+    block = malloc(64);
+    free(block);
+    OS_API_GetRealtimeInfo(&rt_prop);
+    UtAssert_True(rt_prop.late_allocations > allocations, "Late allocations %u -> %u",
+            (unsigned int)allocations, (unsigned int)rt_prop.late_allocations);
+
+    /* and so must an aligned one */
+    allocations = rt_prop.late_allocations;
+    status = posix_memalign((void**)&block, 64, 64);
+    UtAssert_True(status == 0, "posix_memalign() Rc=%d", (int)status);
+    free(block);
+    OS_API_GetRealtimeInfo(&rt_prop);
+    UtAssert_True(rt_prop.late_allocations > allocations, "Late aligned allocations %u -> %u",
+            (unsigned int)allocations, (unsigned int)rt_prop.late_allocations);
+}
+
+void LatencyTeardown(void)
+{
+    OS_TaskDelay(10);
+    OS_BinSemDelete(done_sem_id);
+}
@@ -0,0 +1,144 @@
+/*
+** Task stack pool test
+**
+** Repeatedly creates short-lived helper tasks of the same stack size,
+** some ending with OS_TaskExit() and some removed with OS_TaskDelete(),
+** and checks that later tasks run on recycled stacks rather than new
+** ones.  The average time to create a task is reported.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void StackPoolSetup(void);
+void StackPoolCheck(void);
+void StackPoolTeardown(void);
+
+#define TASK_STACK_SIZE  32768
+#define TASK_PRIORITY    100
+#define NUM_CYCLES       50
+
+uint32 helper_stack[TASK_STACK_SIZE / sizeof(uint32)];
+uint32 helper_id;
+uint32 helper_sem;
+
+void exiting_task(void)
+{
+    OS_TaskRegister();
+    OS_BinSemGive(helper_sem);
+    OS_TaskExit();
+}
+
+void blocking_task(void)
+{
+    OS_TaskRegister();
+    OS_BinSemGive(helper_sem);
+    while (1)
+    {
+        OS_TaskDelay(1000);
+    }
+}
+
+/*
+** Main function
+*/
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(StackPoolCheck, StackPoolSetup, StackPoolTeardown, "StackPoolTest");
+}
+
+void StackPoolSetup(void)
+{
+    int32 status;
+
+    status = OS_BinSemCreate(&helper_sem, "HelperSem", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "BinSem create Id=%u Rc=%d", (unsigned int)helper_sem, (int)status);
+}
+
+void StackPoolCheck(void)
+{
+    int32 status;
+    uint32 i;
+    uint32 failures;
+    uint32 create_usec;
+    OS_time_t start;
+    OS_time_t end;
+    OS_stack_pool_stats_t before;
+    OS_stack_pool_stats_t after;
+
+    status = OS_TaskGetStackPoolStats(&before);
+    if (status == OS_ERR_NOT_IMPLEMENTED)
+    {
+        UtAssert_Type(NA, true, "Task stack pool not implemented");
+        return;
+    }
+    UtAssert_True(status == OS_SUCCESS, "OS_TaskGetStackPoolStats() Rc=%d", (int)status);
+
+    failures = 0;
+    create_usec = 0;
+    for (i = 0; i < NUM_CYCLES; ++i)
+    {
+        OS_GetLocalTime(&start);
+        status = OS_TaskCreate(&helper_id, "Helper", (i & 1) ? blocking_task : exiting_task,
+                helper_stack, TASK_STACK_SIZE, TASK_PRIORITY, 0);
+        OS_GetLocalTime(&end);
+        create_usec += (end.seconds - start.seconds) * 1000000 + end.microsecs - start.microsecs;
+
+        if (status != OS_SUCCESS || OS_BinSemTimedWait(helper_sem, 1000) != OS_SUCCESS)
+        {
+            ++failures;
+            continue;
+        }
+
+        if (i & 1)
+        {
+            OS_TaskDelete(helper_id);
+        }
+
+        /* let the thread finish terminating so its stack can be reclaimed */
+        OS_TaskDelay(5);
+    }
+
+    status = OS_TaskGetStackPoolStats(&after);
+    UtAssert_True(status == OS_SUCCESS, "OS_TaskGetStackPoolStats() Rc=%d", (int)status);
+
+    OS_printf("Stack pool: hits=%u misses=%u bypassed=%u in_use=%u free=%u bytes=%u\n",
+            (unsigned int)after.hits, (unsigned int)after.misses, (unsigned int)after.bypassed,
+            (unsigned int)after.stacks_in_use, (unsigned int)after.stacks_free,
+            (unsigned int)after.pool_bytes);
+    OS_printf("Average task create time: %u usec\n", (unsigned int)(create_usec / NUM_CYCLES));
+
+    UtAssert_True(failures == 0, "Helper task failures=%u", (unsigned int)failures);
+
+    /* stack sizes, and so the pool, are only applied when task priorities are */
+    if (after.hits == before.hits && after.misses == before.misses && after.bypassed == before.bypassed)
+    {
+        UtAssert_Type(NA, true, "Task stacks not pooled without task priorities");
+        return;
+    }
+
+    UtAssert_True(after.hits - before.hits >= NUM_CYCLES / 2, "Recycled stacks=%u of %u",
+            (unsigned int)(after.hits - before.hits), (unsigned int)NUM_CYCLES);
+    UtAssert_True(after.misses - before.misses <= NUM_CYCLES / 2, "New stacks=%u of %u",
+            (unsigned int)(after.misses - before.misses), (unsigned int)NUM_CYCLES);
+    UtAssert_True(after.stacks_in_use == 0, "Stacks still in use=%u", (unsigned int)after.stacks_in_use);
+}
+
+void StackPoolTeardown(void)
+{
+    OS_TaskDelay(10);
+    OS_BinSemDelete(helper_sem);
+}
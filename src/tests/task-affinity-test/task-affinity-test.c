@@ -0,0 +1,106 @@
+/*
+** Task CPU affinity test
+**
+** Creates a task restricted to a set of CPUs, then changes and clears
+** the restriction at run time, checking that OS_TaskGetInfo() reports
+** the mask in effect.  The test host may have any number of CPUs, so
+** only masks that include at least one CPU in the range 0-31 are used.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void AffinitySetup(void);
+void AffinityCheck(void);
+void AffinityTeardown(void);
+
+#define TASK_STACK_SIZE  4096
+#define TASK_PRIORITY    100
+#define ALL_CPUS_MASK    0xFFFFFFFF
+
+uint32 affinity_stack[TASK_STACK_SIZE];
+uint32 affinity_task_id;
+volatile uint32 affinity_task_loops;
+volatile bool affinity_task_stop;
+
+void affinity_task(void)
+{
+    OS_TaskRegister();
+
+    /* keep running (and possibly migrating) while the masks are changed */
+    while (!affinity_task_stop)
+    {
+        ++affinity_task_loops;
+        OS_TaskDelay(1);
+    }
+
+    OS_TaskExit();
+}
+
+/*
+** Main function
+*/
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(AffinityCheck, AffinitySetup, AffinityTeardown, "TaskAffinityTest");
+}
+
+void AffinitySetup(void)
+{
+    int32 status;
+
+    affinity_task_loops = 0;
+    affinity_task_stop = false;
+
+    status = OS_TaskCreateAffinity(&affinity_task_id, "Affinity", affinity_task, affinity_stack,
+            TASK_STACK_SIZE, TASK_PRIORITY, 0, ALL_CPUS_MASK);
+    UtAssert_True(status == OS_SUCCESS, "Task create Id=%u Rc=%d", (unsigned int)affinity_task_id, (int)status);
+}
+
+void AffinityCheck(void)
+{
+    int32 status;
+    OS_task_prop_t task_prop;
+
+    status = OS_TaskGetInfo(affinity_task_id, &task_prop);
+    UtAssert_True(status == OS_SUCCESS, "Task GetInfo Rc=%d", (int)status);
+    UtAssert_True(task_prop.cpu_mask == ALL_CPUS_MASK, "Initial cpu_mask=%lx", (unsigned long)task_prop.cpu_mask);
+
+    /* Removing the restriction is always possible */
+    status = OS_TaskSetAffinity(affinity_task_id, 0);
+    UtAssert_True(status == OS_SUCCESS, "SetAffinity(0) Rc=%d", (int)status);
+
+    status = OS_TaskGetInfo(affinity_task_id, &task_prop);
+    UtAssert_True(status == OS_SUCCESS && task_prop.cpu_mask == 0, "Cleared cpu_mask=%lx Rc=%d",
+            (unsigned long)task_prop.cpu_mask, (int)status);
+
+    status = OS_TaskSetAffinity(affinity_task_id, ALL_CPUS_MASK);
+    UtAssert_True(status == OS_SUCCESS, "SetAffinity(all) Rc=%d", (int)status);
+
+    /* Make sure the task is still being scheduled */
+    affinity_task_loops = 0;
+    OS_TaskDelay(50);
+    UtAssert_True(affinity_task_loops > 0, "Task loops after SetAffinity=%u", (unsigned int)affinity_task_loops);
+
+    status = OS_TaskSetAffinity(0, ALL_CPUS_MASK);
+    UtAssert_True(status == OS_ERR_INVALID_ID, "SetAffinity(bad id) Rc=%d", (int)status);
+}
+
+void AffinityTeardown(void)
+{
+    affinity_task_stop = true;
+    OS_TaskDelay(20);
+}
@@ -0,0 +1,208 @@
+/*
+** Task-local storage test
+**
+** Several tasks store their own value under the same key and check that
+** they only ever see their own.  One task exits and another is deleted,
+** and the key destructor must be called once for each of them.  The cost
+** of a lookup is compared with the OS_ConvertToArrayIndex(OS_TaskGetId())
+** idiom that applications would otherwise use.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void LocalSetup(void);
+void LocalCheck(void);
+void LocalTeardown(void);
+
+#define TASK_STACK_SIZE  4096
+#define TASK_PRIORITY    100
+#define NUM_TASKS        3
+#define NUM_LOOKUPS      1000000
+
+typedef struct
+{
+    uint32 task_id;
+    uint32 mismatches;
+    uint32 released;
+    volatile bool ready;
+    volatile bool stop;
+} task_state_t;
+
+uint32 local_stack[NUM_TASKS][TASK_STACK_SIZE];
+task_state_t task_state[NUM_TASKS];
+uint32 state_key;
+uint32 task_start_sem;
+
+static uint32 TimeDiffMicros(const OS_time_t *later, const OS_time_t *earlier)
+{
+    return ((later->seconds - earlier->seconds) * 1000000) + later->microsecs - earlier->microsecs;
+}
+
+void state_destructor(void *value)
+{
+    ++((task_state_t *)value)->released;
+}
+
+void local_task(void)
+{
+    uint32 task_id;
+    uint32 i;
+    void *value;
+
+    OS_TaskRegister();
+    task_id = OS_TaskGetId();
+
+    /* find this task's own state */
+    OS_BinSemTake(task_start_sem);
+    for (i = 0; i < NUM_TASKS; ++i)
+    {
+        if (task_state[i].task_id == task_id)
+        {
+            break;
+        }
+    }
+    OS_BinSemGive(task_start_sem);
+
+    if (i < NUM_TASKS)
+    {
+        OS_TaskKeySet(state_key, &task_state[i]);
+        task_state[i].ready = true;
+
+        while (!task_state[i].stop)
+        {
+            if (OS_TaskKeyGet(state_key, &value) != OS_SUCCESS || value != &task_state[i])
+            {
+                ++task_state[i].mismatches;
+            }
+            OS_TaskDelay(1);
+        }
+    }
+
+    OS_TaskExit();
+}
+
+/*
+** Main function
+*/
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(LocalCheck, LocalSetup, LocalTeardown, "TaskLocalTest");
+}
+
+void LocalSetup(void)
+{
+    int32 status;
+    uint32 i;
+    char name[OS_MAX_API_NAME];
+
+    memset(task_state, 0, sizeof(task_state));
+
+    status = OS_TaskKeyCreate(&state_key, state_destructor);
+    UtAssert_True(status == OS_SUCCESS, "Key create Key=%u Rc=%d", (unsigned int)state_key, (int)status);
+
+    status = OS_BinSemCreate(&task_start_sem, "StartSem", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "BinSem create Rc=%d", (int)status);
+
+    /* hold the tasks until all IDs are recorded */
+    for (i = 0; i < NUM_TASKS; ++i)
+    {
+        snprintf(name, sizeof(name), "Local%u", (unsigned int)i);
+        status = OS_TaskCreate(&task_state[i].task_id, name, local_task, local_stack[i],
+                TASK_STACK_SIZE, TASK_PRIORITY, 0);
+        UtAssert_True(status == OS_SUCCESS, "Task create Id=%u Rc=%d",
+                (unsigned int)task_state[i].task_id, (int)status);
+    }
+    OS_BinSemGive(task_start_sem);
+}
+
+void LocalCheck(void)
+{
+    int32 status;
+    uint32 i;
+    uint32 count;
+    uint32 index;
+    void *value;
+    OS_time_t start;
+    OS_time_t end;
+
+    for (count = 0; count < 100; ++count)
+    {
+        for (i = 0; i < NUM_TASKS && task_state[i].ready; ++i);
+        if (i == NUM_TASKS)
+        {
+            break;
+        }
+        OS_TaskDelay(10);
+    }
+    UtAssert_True(count < 100, "All tasks stored their value");
+
+    /* let them read back for a while */
+    OS_TaskDelay(100);
+
+    /* the main context is not an OSAL task */
+    status = OS_TaskKeyGet(state_key, &value);
+    UtAssert_True(status == OS_ERR_INVALID_ID, "KeyGet from non-task Rc=%d", (int)status);
+
+    /* end one task by exit, one by delete */
+    task_state[0].stop = true;
+    OS_TaskDelay(50);
+    status = OS_TaskDelete(task_state[1].task_id);
+    UtAssert_True(status == OS_SUCCESS, "Task delete Rc=%d", (int)status);
+
+    for (i = 0; i < NUM_TASKS; ++i)
+    {
+        UtAssert_True(task_state[i].mismatches == 0, "Task %u mismatches=%u",
+                (unsigned int)i, (unsigned int)task_state[i].mismatches);
+    }
+    UtAssert_True(task_state[0].released == 1, "Exited task value released %u time(s)",
+            (unsigned int)task_state[0].released);
+    UtAssert_True(task_state[1].released == 1, "Deleted task value released %u time(s)",
+            (unsigned int)task_state[1].released);
+    UtAssert_True(task_state[2].released == 0, "Running task value released %u time(s)",
+            (unsigned int)task_state[2].released);
+
+    status = OS_TaskKeySet(0xFFFF, NULL);
+    UtAssert_True(status == OS_ERR_INVALID_ID, "KeySet(bad key) Rc=%d", (int)status);
+
+    /*
+     * Compare lookup cost.  Both calls fail here as the main context is
+     * not an OSAL task, but they still do the same work to find out.
+     */
+    OS_GetLocalTime(&start);
+    for (count = 0; count < NUM_LOOKUPS; ++count)
+    {
+        OS_TaskKeyGet(state_key, &value);
+    }
+    OS_GetLocalTime(&end);
+    OS_printf("OS_TaskKeyGet: %lu nsec per lookup\n",
+            (unsigned long)((TimeDiffMicros(&end, &start) * 1000ULL) / NUM_LOOKUPS));
+
+    OS_GetLocalTime(&start);
+    for (count = 0; count < NUM_LOOKUPS; ++count)
+    {
+        OS_ConvertToArrayIndex(OS_TaskGetId(), &index);
+    }
+    OS_GetLocalTime(&end);
+    OS_printf("OS_ConvertToArrayIndex(OS_TaskGetId()): %lu nsec per lookup\n",
+            (unsigned long)((TimeDiffMicros(&end, &start) * 1000ULL) / NUM_LOOKUPS));
+}
+
+void LocalTeardown(void)
+{
+    task_state[2].stop = true;
+    OS_TaskDelay(50);
+}
@@ -0,0 +1,254 @@
+/*
+** Task runtime statistics test
+**
+** Runs one task that mostly computes and one that mostly sleeps, then
+** takes two OS_TaskStatsSnapshot() samples and checks that the CPU time
+** and context switch counts reflect what each task was doing.  The
+** per-task CPU utilization over the interval is printed the way a
+** monitoring task would compute it.  It also checks that each task
+** reports the thread ID that OS level tools know it by, and on Linux
+** that the thread carries the OSAL task name.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void StatsSetup(void);
+void StatsCheck(void);
+void StatsTeardown(void);
+
+#define TASK_STACK_SIZE  4096
+#define TASK_PRIORITY    100
+#define BUSY_SPIN_USEC   2000
+#define SAMPLE_MSEC      500
+
+uint32 busy_stack[TASK_STACK_SIZE];
+uint32 busy_task_id;
+uint32 sleepy_stack[TASK_STACK_SIZE];
+uint32 sleepy_task_id;
+volatile bool stats_task_stop;
+
+OS_task_stats_t first_sample[OS_MAX_TASKS];
+OS_task_stats_t second_sample[OS_MAX_TASKS];
+
+/*
+ * Read the name of a thread as the kernel reports it, or set an empty
+ * string if it cannot be read
+ */
+static void ReadThreadName(uint32 os_thread_id, char *name, size_t name_size)
+{
+    name[0] = 0;
+#ifdef __linux__
+    {
+        char path[64];
+        FILE *fp;
+
+        snprintf(path, sizeof(path), "/proc/self/task/%lu/comm", (unsigned long)os_thread_id);
+        fp = fopen(path, "r");
+        if (fp != NULL)
+        {
+            if (fgets(name, name_size, fp) == NULL)
+            {
+                name[0] = 0;
+            }
+            name[strcspn(name, "\n")] = 0;
+            fclose(fp);
+        }
+    }
+#endif
+}
+
+static uint32 TimeDiffMicros(const OS_time_t *later, const OS_time_t *earlier)
+{
+    return ((later->seconds - earlier->seconds) * 1000000) + later->microsecs - earlier->microsecs;
+}
+
+static const OS_task_stats_t *FindTask(const OS_task_stats_t *sample, uint32 count, uint32 task_id)
+{
+    uint32 i;
+
+    for (i = 0; i < count; ++i)
+    {
+        if (sample[i].task_id == task_id)
+        {
+            return &sample[i];
+        }
+    }
+
+    return NULL;
+}
+
+void busy_task(void)
+{
+    OS_time_t start;
+    OS_time_t now;
+
+    OS_TaskRegister();
+
+    /* compute for a while, then give the CPU up briefly so others still run */
+    while (!stats_task_stop)
+    {
+        OS_GetLocalTime(&start);
+        do
+        {
+            OS_GetLocalTime(&now);
+        }
+        while (TimeDiffMicros(&now, &start) < BUSY_SPIN_USEC);
+        OS_TaskDelay(1);
+    }
+
+    OS_TaskExit();
+}
+
+void sleepy_task(void)
+{
+    OS_TaskRegister();
+
+    while (!stats_task_stop)
+    {
+        OS_TaskDelay(1);
+    }
+
+    OS_TaskExit();
+}
+
+/*
+** Main function
+*/
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(StatsCheck, StatsSetup, StatsTeardown, "TaskStatsTest");
+}
+
+void StatsSetup(void)
+{
+    int32 status;
+
+    stats_task_stop = false;
+
+    status = OS_TaskCreate(&busy_task_id, "Busy", busy_task, busy_stack,
+            TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "Task create Id=%u Rc=%d", (unsigned int)busy_task_id, (int)status);
+
+    status = OS_TaskCreate(&sleepy_task_id, "Sleepy", sleepy_task, sleepy_stack,
+            TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "Task create Id=%u Rc=%d", (unsigned int)sleepy_task_id, (int)status);
+
+    /* let both tasks get going */
+    OS_TaskDelay(50);
+}
+
+void StatsCheck(void)
+{
+    int32 status;
+    uint32 first_count;
+    uint32 second_count;
+    uint32 wall_usec;
+    uint32 cpu_usec;
+    uint32 i;
+    OS_time_t first_time;
+    OS_time_t second_time;
+    OS_task_stats_t task_stats;
+    const OS_task_stats_t *busy[2];
+    const OS_task_stats_t *sleepy[2];
+    const OS_task_stats_t *prev;
+    OS_task_prop_t busy_prop;
+    OS_task_prop_t sleepy_prop;
+    char thread_name[32];
+
+    status = OS_TaskStatsSnapshot(first_sample, OS_MAX_TASKS, &first_count);
+    if (status == OS_ERR_NOT_IMPLEMENTED)
+    {
+        UtAssert_Type(NA, true, "Task statistics not implemented");
+        return;
+    }
+    OS_GetLocalTime(&first_time);
+    UtAssert_True(status == OS_SUCCESS, "First snapshot Rc=%d", (int)status);
+
+    OS_TaskDelay(SAMPLE_MSEC);
+
+    status = OS_TaskStatsSnapshot(second_sample, OS_MAX_TASKS, &second_count);
+    OS_GetLocalTime(&second_time);
+    UtAssert_True(status == OS_SUCCESS, "Second snapshot Rc=%d", (int)status);
+
+    wall_usec = TimeDiffMicros(&second_time, &first_time);
+    for (i = 0; i < second_count; ++i)
+    {
+        prev = FindTask(first_sample, first_count, second_sample[i].task_id);
+        if (prev != NULL && wall_usec > 0)
+        {
+            cpu_usec = TimeDiffMicros(&second_sample[i].cpu_time, &prev->cpu_time);
+            OS_printf("%-20s cpu=%3lu%% vol=%lu invol=%lu last_cpu=%lu\n", second_sample[i].name,
+                    (unsigned long)((cpu_usec * 100ULL) / wall_usec),
+                    (unsigned long)(second_sample[i].voluntary_switches - prev->voluntary_switches),
+                    (unsigned long)(second_sample[i].involuntary_switches - prev->involuntary_switches),
+                    (unsigned long)second_sample[i].last_cpu);
+        }
+    }
+
+    busy[0] = FindTask(first_sample, first_count, busy_task_id);
+    busy[1] = FindTask(second_sample, second_count, busy_task_id);
+    sleepy[0] = FindTask(first_sample, first_count, sleepy_task_id);
+    sleepy[1] = FindTask(second_sample, second_count, sleepy_task_id);
+    UtAssert_True(busy[0] != NULL && busy[1] != NULL, "Busy task in both snapshots");
+    UtAssert_True(sleepy[0] != NULL && sleepy[1] != NULL, "Sleepy task in both snapshots");
+
+    if (busy[0] != NULL && busy[1] != NULL && sleepy[0] != NULL && sleepy[1] != NULL)
+    {
+        UtAssert_True(strcmp(busy[1]->name, "Busy") == 0, "Busy task name=%s", busy[1]->name);
+        UtAssert_True(TimeDiffMicros(&busy[1]->cpu_time, &busy[0]->cpu_time) >
+                TimeDiffMicros(&sleepy[1]->cpu_time, &sleepy[0]->cpu_time),
+                "Busy task used more CPU than sleepy task");
+        UtAssert_True(sleepy[1]->voluntary_switches > sleepy[0]->voluntary_switches,
+                "Sleepy task voluntary switches %lu -> %lu",
+                (unsigned long)sleepy[0]->voluntary_switches, (unsigned long)sleepy[1]->voluntary_switches);
+    }
+
+    status = OS_TaskGetStats(busy_task_id, &task_stats);
+    UtAssert_True(status == OS_SUCCESS && task_stats.task_id == busy_task_id,
+            "GetStats Rc=%d task_id=%lx", (int)status, (unsigned long)task_stats.task_id);
+
+    status = OS_TaskGetStats(0, &task_stats);
+    UtAssert_True(status == OS_ERR_INVALID_ID, "GetStats(bad id) Rc=%d", (int)status);
+
+    status = OS_TaskGetInfo(busy_task_id, &busy_prop);
+    UtAssert_True(status == OS_SUCCESS, "Busy GetInfo Rc=%d", (int)status);
+    status = OS_TaskGetInfo(sleepy_task_id, &sleepy_prop);
+    UtAssert_True(status == OS_SUCCESS, "Sleepy GetInfo Rc=%d", (int)status);
+    OS_printf("Busy task %lx is OS thread %lu, Sleepy task %lx is OS thread %lu\n",
+            (unsigned long)busy_task_id, (unsigned long)busy_prop.os_thread_id,
+            (unsigned long)sleepy_task_id, (unsigned long)sleepy_prop.os_thread_id);
+
+    if (busy_prop.os_thread_id == 0)
+    {
+        UtAssert_Type(NA, true, "OS thread IDs not implemented");
+        return;
+    }
+
+    UtAssert_True(busy_prop.os_thread_id != sleepy_prop.os_thread_id, "Tasks have distinct OS thread IDs");
+
+    ReadThreadName(busy_prop.os_thread_id, thread_name, sizeof(thread_name));
+    if (thread_name[0] != 0)
+    {
+        UtAssert_True(strcmp(thread_name, "Busy") == 0, "OS thread name=%s", thread_name);
+    }
+}
+
+void StatsTeardown(void)
+{
+    stats_task_stop = true;
+    OS_TaskDelay(20);
+}
@@ -0,0 +1,176 @@
+/*
+** Tickless Timer Test
+**
+** Runs timers on a simulated time base with a short interval that only
+** ticks when one of its timers is due, and verifies that:
+**
+**  - periodic timers are still called back on every one of their intervals
+**  - a timer set while the time base is skipping intervals expires after
+**    its start time, measured from when it was set
+**  - the free running counter still accounts for the skipped intervals
+**  - the time base goes back to ticking on every interval when asked to
+**  - a time base with an external sync function rejects tickless operation
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void TicklessSetup(void);
+void TicklessCheck(void);
+void TicklessTeardown(void);
+
+/* time base tick, in microseconds */
+#define TICK_USEC        1000
+
+#define PERIODIC_USEC    100000
+#define ONESHOT_USEC     35000
+
+uint32 timebase_id;
+uint32 sync_timebase_id;
+uint32 periodic_id;
+uint32 oneshot_id;
+
+volatile uint32 periodic_calls;
+volatile uint32 oneshot_calls;
+OS_time_t oneshot_time;
+
+static uint32 TicklessSync(uint32 local_id)
+{
+    OS_TaskDelay(1);
+    return TICK_USEC;
+}
+
+static void PeriodicCallback(uint32 timer_id, void *arg)
+{
+    ++periodic_calls;
+}
+
+static void OneshotCallback(uint32 timer_id, void *arg)
+{
+    OS_GetLocalTime(&oneshot_time);
+    ++oneshot_calls;
+}
+
+static int32 ElapsedMicros(const OS_time_t *start, const OS_time_t *end)
+{
+    return (int32)(((int32)end->seconds - (int32)start->seconds) * 1000000 +
+            ((int32)end->microsecs - (int32)start->microsecs));
+}
+
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(TicklessCheck, TicklessSetup, TicklessTeardown, "TicklessTimerTest");
+}
+
+void TicklessSetup(void)
+{
+    int32 status;
+
+    periodic_calls = 0;
+    oneshot_calls = 0;
+
+    status = OS_TimeBaseCreate(&timebase_id, "TicklessTB", NULL);
+    UtAssert_True(status == OS_SUCCESS, "TimeBase create Id=%u Rc=%d",
+            (unsigned int)timebase_id, (int)status);
+
+    status = OS_TimeBaseSet(timebase_id, TICK_USEC, TICK_USEC);
+    UtAssert_True(status == OS_SUCCESS, "TimeBase set Rc=%d", (int)status);
+
+    status = OS_TimerAdd(&periodic_id, "Periodic", timebase_id, PeriodicCallback, NULL);
+    UtAssert_True(status == OS_SUCCESS, "Periodic timer add Rc=%d", (int)status);
+
+    status = OS_TimerAdd(&oneshot_id, "Oneshot", timebase_id, OneshotCallback, NULL);
+    UtAssert_True(status == OS_SUCCESS, "Oneshot timer add Rc=%d", (int)status);
+
+    status = OS_TimeBaseCreate(&sync_timebase_id, "SyncTB", TicklessSync);
+    UtAssert_True(status == OS_SUCCESS, "Sync TimeBase create Rc=%d", (int)status);
+}
+
+void TicklessCheck(void)
+{
+    OS_time_t set_time;
+    uint32 start_freerun;
+    uint32 end_freerun;
+    uint32 calls;
+    int32 elapsed;
+    int32 status;
+
+    status = OS_TimeBaseSetTickless(sync_timebase_id, true);
+    UtAssert_True(status == OS_ERR_NOT_IMPLEMENTED, "External sync SetTickless Rc=%d", (int)status);
+
+    status = OS_TimeBaseSetTickless(timebase_id, true);
+    UtAssert_True(status == OS_SUCCESS, "SetTickless(true) Rc=%d", (int)status);
+
+    OS_TimeBaseGetFreeRun(timebase_id, &start_freerun);
+
+    status = OS_TimerSet(periodic_id, PERIODIC_USEC, PERIODIC_USEC);
+    UtAssert_True(status == OS_SUCCESS, "Periodic timer set Rc=%d", (int)status);
+
+    /*
+     * Set the one-shot timer halfway between two periodic callbacks,
+     * while the time base is skipping intervals
+     */
+    OS_TaskDelay((PERIODIC_USEC * 3) / 2000);
+    OS_GetLocalTime(&set_time);
+    status = OS_TimerSet(oneshot_id, ONESHOT_USEC, 0);
+    UtAssert_True(status == OS_SUCCESS, "Oneshot timer set Rc=%d", (int)status);
+
+    OS_TaskDelay((PERIODIC_USEC * 17) / 2000);
+    OS_TimeBaseGetFreeRun(timebase_id, &end_freerun);
+
+    calls = periodic_calls;
+    UtAssert_True(calls >= 9 && calls <= 11, "Tickless periodic callbacks = %u", (unsigned int)calls);
+    UtAssert_True(oneshot_calls == 1, "Tickless oneshot callbacks = %u", (unsigned int)oneshot_calls);
+
+    elapsed = ElapsedMicros(&set_time, &oneshot_time);
+    UtAssert_True(elapsed >= (ONESHOT_USEC - TICK_USEC) && elapsed <= (ONESHOT_USEC + 10000),
+            "Tickless oneshot expired after %ld usec", (long)elapsed);
+
+    /* the counter only moves on a tick, which is at most one period ago */
+    elapsed = (int32)(end_freerun - start_freerun);
+    UtAssert_True(elapsed >= (10 * PERIODIC_USEC) - PERIODIC_USEC && elapsed <= (10 * PERIODIC_USEC) + 10000,
+            "Tickless free run advanced %ld usec", (long)elapsed);
+
+    /*
+     * Back to a tick on every interval
+     */
+    status = OS_TimeBaseSetTickless(timebase_id, false);
+    UtAssert_True(status == OS_SUCCESS, "SetTickless(false) Rc=%d", (int)status);
+
+    /* the first tick catches up with the intervals skipped before it */
+    OS_TaskDelay(10);
+    OS_TimeBaseGetFreeRun(timebase_id, &start_freerun);
+    OS_TaskDelay((PERIODIC_USEC * 3) / 1000);
+    OS_TimeBaseGetFreeRun(timebase_id, &end_freerun);
+
+    calls = periodic_calls - calls;
+    UtAssert_True(calls >= 2 && calls <= 4, "Ticking periodic callbacks = %u", (unsigned int)calls);
+
+    elapsed = (int32)(end_freerun - start_freerun);
+    UtAssert_True(elapsed >= (3 * PERIODIC_USEC) - 20000 && elapsed <= (3 * PERIODIC_USEC) + 20000,
+            "Ticking free run advanced %ld usec", (long)elapsed);
+}
+
+void TicklessTeardown(void)
+{
+    OS_TimerDelete(periodic_id);
+    OS_TimerDelete(oneshot_id);
+    OS_TimeBaseDelete(timebase_id);
+    OS_TimeBaseDelete(sync_timebase_id);
+
+    /* Allow the console output to drain */
+    OS_TaskDelay(100);
+}
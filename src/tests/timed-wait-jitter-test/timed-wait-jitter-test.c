@@ -0,0 +1,209 @@
+/*
+** Microsecond timed-wait jitter test
+**
+** Requests short (sub-millisecond) timeouts from each of the microsecond
+** timed-wait APIs and measures how late the caller actually wakes up.
+** The min/max/mean lateness for each API is reported for information;
+** only functional correctness is asserted, since the achievable jitter
+** depends entirely on the host.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void JitterSetup(void);
+void JitterCheck(void);
+void JitterTeardown(void);
+
+#define NUM_SAMPLES      200
+#define MIN_REQUEST_USEC 100
+#define MAX_REQUEST_USEC 500
+
+/*
+ * Both timestamps are truncated to whole microseconds, so allow one
+ * microsecond of measurement error before calling a wakeup "early".
+ */
+#define MEASURE_TOLERANCE_USEC  1
+
+typedef enum
+{
+    JITTER_TASKDELAY,
+    JITTER_BINSEM,
+    JITTER_COUNTSEM,
+    JITTER_QUEUE,
+    JITTER_MAX
+} JitterApi_t;
+
+typedef struct
+{
+    const char *name;
+    uint32 samples;
+    uint32 early;
+    uint32 bad_status;
+    int32  min_late;
+    int32  max_late;
+    int64  sum_late;
+} JitterStats_t;
+
+JitterStats_t jitter_stats[JITTER_MAX];
+
+uint32 bin_sem_id;
+uint32 count_sem_id;
+uint32 queue_id;
+
+static int32 ElapsedMicros(const OS_time_t *start, const OS_time_t *end)
+{
+    return (int32)(((int32)end->seconds - (int32)start->seconds) * 1000000 +
+            ((int32)end->microsecs - (int32)start->microsecs));
+}
+
+static void RecordSample(JitterApi_t api, uint32 request, int32 status, int32 expected,
+        const OS_time_t *start, const OS_time_t *end)
+{
+    JitterStats_t *stats = &jitter_stats[api];
+    int32 late;
+
+    late = ElapsedMicros(start, end) - (int32)request;
+
+    if (status != expected)
+    {
+        ++stats->bad_status;
+    }
+    if (late < -MEASURE_TOLERANCE_USEC)
+    {
+        ++stats->early;
+    }
+
+    if (stats->samples == 0 || late < stats->min_late)
+    {
+        stats->min_late = late;
+    }
+    if (stats->samples == 0 || late > stats->max_late)
+    {
+        stats->max_late = late;
+    }
+    stats->sum_late += late;
+    ++stats->samples;
+}
+
+/*
+** Main function
+*/
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(JitterCheck, JitterSetup, JitterTeardown, "TimedWaitJitterTest");
+}
+
+void JitterSetup(void)
+{
+    int32 status;
+
+    memset(jitter_stats, 0, sizeof(jitter_stats));
+    jitter_stats[JITTER_TASKDELAY].name = "OS_TaskDelayMicros";
+    jitter_stats[JITTER_BINSEM].name = "OS_BinSemTimedWaitMicros";
+    jitter_stats[JITTER_COUNTSEM].name = "OS_CountSemTimedWaitMicros";
+    jitter_stats[JITTER_QUEUE].name = "OS_QueueGetMicros";
+
+    status = OS_BinSemCreate(&bin_sem_id, "JitterBinSem", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "BinSem create Id=%u Rc=%d", (unsigned int)bin_sem_id, (int)status);
+
+    status = OS_CountSemCreate(&count_sem_id, "JitterCountSem", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "CountSem create Id=%u Rc=%d", (unsigned int)count_sem_id, (int)status);
+
+    status = OS_QueueCreate(&queue_id, "JitterQueue", 4, sizeof(uint32), 0);
+    UtAssert_True(status == OS_SUCCESS, "Queue create Id=%u Rc=%d", (unsigned int)queue_id, (int)status);
+}
+
+void JitterCheck(void)
+{
+    OS_time_t start;
+    OS_time_t end;
+    uint32 i;
+    uint32 request;
+    uint32 data;
+    uint32 size_copied;
+    int32 status;
+    JitterStats_t *stats;
+
+    for (i = 0; i < NUM_SAMPLES; ++i)
+    {
+        /* sweep the request across the range of interest */
+        request = MIN_REQUEST_USEC + ((i * 37) % (MAX_REQUEST_USEC - MIN_REQUEST_USEC + 1));
+
+        OS_GetLocalTime(&start);
+        status = OS_TaskDelayMicros(request);
+        OS_GetLocalTime(&end);
+        RecordSample(JITTER_TASKDELAY, request, status, OS_SUCCESS, &start, &end);
+
+        OS_GetLocalTime(&start);
+        status = OS_BinSemTimedWaitMicros(bin_sem_id, request);
+        OS_GetLocalTime(&end);
+        RecordSample(JITTER_BINSEM, request, status, OS_SEM_TIMEOUT, &start, &end);
+
+        OS_GetLocalTime(&start);
+        status = OS_CountSemTimedWaitMicros(count_sem_id, request);
+        OS_GetLocalTime(&end);
+        RecordSample(JITTER_COUNTSEM, request, status, OS_SEM_TIMEOUT, &start, &end);
+
+        OS_GetLocalTime(&start);
+        status = OS_QueueGetMicros(queue_id, &data, sizeof(data), &size_copied, (int32)request);
+        OS_GetLocalTime(&end);
+        RecordSample(JITTER_QUEUE, request, status, OS_QUEUE_TIMEOUT, &start, &end);
+    }
+
+    for (i = 0; i < JITTER_MAX; ++i)
+    {
+        stats = &jitter_stats[i];
+
+        OS_printf("%-28s samples=%u late(usec) min=%ld max=%ld mean=%ld\n", stats->name,
+                (unsigned int)stats->samples, (long)stats->min_late, (long)stats->max_late,
+                (long)(stats->sum_late / (int64)stats->samples));
+
+        UtAssert_True(stats->samples == NUM_SAMPLES, "%s samples=%u", stats->name,
+                (unsigned int)stats->samples);
+        UtAssert_True(stats->bad_status == 0, "%s unexpected status count=%u", stats->name,
+                (unsigned int)stats->bad_status);
+        UtAssert_True(stats->early == 0, "%s early wakeup count=%u", stats->name,
+                (unsigned int)stats->early);
+    }
+
+    /* A posted semaphore or queued message must be returned without waiting */
+    OS_BinSemGive(bin_sem_id);
+    status = OS_BinSemTimedWaitMicros(bin_sem_id, MAX_REQUEST_USEC);
+    UtAssert_True(status == OS_SUCCESS, "BinSem posted wait Rc=%d", (int)status);
+
+    OS_CountSemGive(count_sem_id);
+    status = OS_CountSemTimedWaitMicros(count_sem_id, MAX_REQUEST_USEC);
+    UtAssert_True(status == OS_SUCCESS, "CountSem posted wait Rc=%d", (int)status);
+
+    data = 0x5A5A;
+    OS_QueuePut(queue_id, &data, sizeof(data), 0);
+    data = 0;
+    status = OS_QueueGetMicros(queue_id, &data, sizeof(data), &size_copied, MAX_REQUEST_USEC);
+    UtAssert_True(status == OS_SUCCESS, "Queue posted get Rc=%d", (int)status);
+    UtAssert_True(data == 0x5A5A && size_copied == sizeof(data), "Queue data=%x size=%u",
+            (unsigned int)data, (unsigned int)size_copied);
+
+    status = OS_QueueGetMicros(queue_id, &data, sizeof(data), &size_copied, OS_CHECK);
+    UtAssert_True(status == OS_QUEUE_EMPTY, "Queue check Rc=%d", (int)status);
+}
+
+void JitterTeardown(void)
+{
+    OS_BinSemDelete(bin_sem_id);
+    OS_CountSemDelete(count_sem_id);
+    OS_QueueDelete(queue_id);
+}
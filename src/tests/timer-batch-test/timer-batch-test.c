@@ -0,0 +1,319 @@
+/*
+** Timer Batch Test
+**
+** Sets a group of timers on one time base with OS_TimerSetBatchNs() and
+** verifies that:
+**
+**  - without a phase step, timers with the same start time all expire on
+**    the same tick
+**  - with a phase step of one tick, each timer expires one tick after the
+**    previous one, so their expirations are spread over the interval
+**  - a batch with an invalid ID is refused as a whole
+**
+** It also compares the cost of setting the timers one at a time and as a
+** batch.  The figures are reported for information only, since they depend
+** entirely on the host.
+**
+** The time base is driven by an external sync function which returns
+** immediately, so the ticks run as fast as the time base can process them.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void TimerBatchSetup(void);
+void TimerBatchCheck(void);
+void TimerBatchTeardown(void);
+
+#if (OS_MAX_TIMERS < 500)
+#define NUM_TIMERS       OS_MAX_TIMERS
+#else
+#define NUM_TIMERS       500
+#endif
+
+/* time base tick, in microseconds */
+#define TICK_USEC        1000
+#define TICK_NSEC        ((uint64)TICK_USEC * 1000)
+
+#define START_TICKS      10
+
+/* long enough for the last of the spread timers to expire, but not the first one again */
+#define RUN_TICKS        (START_TICKS + NUM_TIMERS - 1)
+
+#define BENCH_ROUNDS     20
+
+/* far enough in the future to never expire during the benchmark */
+#define FAR_FUTURE_NSEC  (1000000ULL * 1000000000)
+
+uint32 timebase_id;
+uint32 done_sem_id;
+uint32 timer_ids[NUM_TIMERS];
+OS_timer_batch_t batch[NUM_TIMERS];
+volatile uint32 timer_calls[NUM_TIMERS];
+volatile uint32 first_tick[NUM_TIMERS];
+
+volatile uint32 ticks_remaining;
+volatile uint32 ticks_done;
+volatile uint32 run_active;
+
+/*
+ * Time base sync function: hands out ticks while a run is in progress,
+ * and otherwise idles until the next run is started.
+ */
+static uint32 TimerBatchSync(uint32 local_id)
+{
+    if (ticks_remaining == 0)
+    {
+        if (run_active)
+        {
+            run_active = 0;
+            OS_BinSemGive(done_sem_id);
+        }
+
+        while (ticks_remaining == 0)
+        {
+            OS_TaskDelay(1);
+        }
+    }
+
+    --ticks_remaining;
+    ++ticks_done;
+    return TICK_USEC;
+}
+
+static void TimerBatchCallback(uint32 timer_id, void *arg)
+{
+    unsigned long i = (unsigned long)arg;
+
+    if (timer_calls[i] == 0)
+    {
+        first_tick[i] = ticks_done;
+    }
+    ++timer_calls[i];
+}
+
+static int32 ElapsedMicros(const OS_time_t *start, const OS_time_t *end)
+{
+    return (int32)(((int32)end->seconds - (int32)start->seconds) * 1000000 +
+            ((int32)end->microsecs - (int32)start->microsecs));
+}
+
+static void ReportCost(const char *name, uint32 count, const OS_time_t *start, const OS_time_t *end)
+{
+    int32 elapsed = ElapsedMicros(start, end);
+
+    OS_printf("%s: %u in %ld usec = %lu nsec each\n", name,
+            (unsigned int)count, (long)elapsed,
+            (unsigned long)(((uint64)elapsed * 1000) / count));
+}
+
+/*
+ * Run the time base for the given number of ticks and wait until all
+ * of the resulting callbacks have been made
+ */
+static int32 RunTicks(uint32 ticks)
+{
+    run_active = 1;
+    ticks_remaining = ticks;
+    return OS_BinSemTimedWait(done_sem_id, 60000);
+}
+
+static void ClearCalls(void)
+{
+    memset((void*)timer_calls, 0, sizeof(timer_calls));
+    memset((void*)first_tick, 0, sizeof(first_tick));
+}
+
+static void FillBatch(uint64 start_time, uint64 interval_time)
+{
+    uint32 i;
+
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        batch[i].timer_id = timer_ids[i];
+        batch[i].start_time = start_time;
+        batch[i].interval_time = interval_time;
+    }
+}
+
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(TimerBatchCheck, TimerBatchSetup, TimerBatchTeardown, "TimerBatchTest");
+}
+
+void TimerBatchSetup(void)
+{
+    char name[OS_MAX_API_NAME];
+    int32 status;
+    uint32 failures;
+    uint32 i;
+
+    ClearCalls();
+    ticks_remaining = 0;
+    ticks_done = 0;
+    run_active = 0;
+
+    status = OS_BinSemCreate(&done_sem_id, "Done", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "BinSem create Rc=%d", (int)status);
+
+    status = OS_TimeBaseCreate(&timebase_id, "BatchTB", TimerBatchSync);
+    UtAssert_True(status == OS_SUCCESS, "TimeBase create Id=%u Rc=%d",
+            (unsigned int)timebase_id, (int)status);
+
+    failures = 0;
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        snprintf(name, sizeof(name), "tmr%u", (unsigned int)i);
+        if (OS_TimerAdd(&timer_ids[i], name, timebase_id, TimerBatchCallback, (void*)(unsigned long)i) != OS_SUCCESS)
+        {
+            ++failures;
+        }
+    }
+    UtAssert_True(failures == 0, "TimerAdd failures = %u of %u",
+            (unsigned int)failures, (unsigned int)NUM_TIMERS);
+}
+
+void TimerBatchCheck(void)
+{
+    OS_time_t start;
+    OS_time_t end;
+    uint32 i;
+    uint32 round;
+    uint32 wrong_count;
+    uint32 saved_id;
+    int32 status;
+
+    /*
+     * Grouped: every timer expires on the same tick
+     */
+    ClearCalls();
+    FillBatch(START_TICKS * TICK_NSEC, NUM_TIMERS * TICK_NSEC);
+    status = OS_TimerSetBatchNs(batch, NUM_TIMERS, 0);
+    UtAssert_True(status == OS_SUCCESS, "TimerSetBatchNs grouped Rc=%d", (int)status);
+
+    status = RunTicks(RUN_TICKS);
+    UtAssert_True(status == OS_SUCCESS, "Run %u ticks Rc=%d", (unsigned int)RUN_TICKS, (int)status);
+
+    wrong_count = 0;
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        if (timer_calls[i] != 1 || first_tick[i] != first_tick[0])
+        {
+            ++wrong_count;
+        }
+    }
+    UtAssert_True(wrong_count == 0, "Grouped timers off the common tick = %u", (unsigned int)wrong_count);
+
+    /*
+     * Spread: one expiry per tick, in the order of the batch
+     */
+    ClearCalls();
+    FillBatch(START_TICKS * TICK_NSEC, NUM_TIMERS * TICK_NSEC);
+    status = OS_TimerSetBatchNs(batch, NUM_TIMERS, TICK_NSEC);
+    UtAssert_True(status == OS_SUCCESS, "TimerSetBatchNs spread Rc=%d", (int)status);
+
+    status = RunTicks(RUN_TICKS);
+    UtAssert_True(status == OS_SUCCESS, "Run %u ticks Rc=%d", (unsigned int)RUN_TICKS, (int)status);
+
+    wrong_count = 0;
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        if (timer_calls[i] != 1 || first_tick[i] != first_tick[0] + i)
+        {
+            if (wrong_count < 5)
+            {
+                OS_printf("Timer %u: %u calls, first on tick %u, expected %u\n", (unsigned int)i,
+                        (unsigned int)timer_calls[i], (unsigned int)first_tick[i],
+                        (unsigned int)(first_tick[0] + i));
+            }
+            ++wrong_count;
+        }
+    }
+    UtAssert_True(wrong_count == 0, "Spread timers off their tick = %u", (unsigned int)wrong_count);
+
+    /*
+     * An invalid ID anywhere in the batch leaves every timer unset
+     */
+    FillBatch(FAR_FUTURE_NSEC, 0);
+    status = OS_TimerSetBatchNs(batch, NUM_TIMERS, 0);
+    UtAssert_True(status == OS_SUCCESS, "TimerSetBatchNs far future Rc=%d", (int)status);
+
+    ClearCalls();
+    FillBatch(START_TICKS * TICK_NSEC, 0);
+    saved_id = batch[NUM_TIMERS - 1].timer_id;
+    batch[NUM_TIMERS - 1].timer_id = 0;
+    status = OS_TimerSetBatchNs(batch, NUM_TIMERS, 0);
+    UtAssert_True(status == OS_ERR_INVALID_ID, "TimerSetBatchNs invalid ID Rc=%d", (int)status);
+    batch[NUM_TIMERS - 1].timer_id = saved_id;
+
+    status = RunTicks(RUN_TICKS);
+    UtAssert_True(status == OS_SUCCESS, "Run %u ticks Rc=%d", (unsigned int)RUN_TICKS, (int)status);
+
+    wrong_count = 0;
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        if (timer_calls[i] != 0)
+        {
+            ++wrong_count;
+        }
+    }
+    UtAssert_True(wrong_count == 0, "Timers set by a refused batch = %u", (unsigned int)wrong_count);
+
+    /*
+     * Cost of setting all the timers, one at a time and as a batch
+     */
+    OS_GetLocalTime(&start);
+    for (round = 0; round < BENCH_ROUNDS; ++round)
+    {
+        for (i = 0; i < NUM_TIMERS; ++i)
+        {
+            OS_TimerSetNs(timer_ids[i], FAR_FUTURE_NSEC, 0);
+        }
+    }
+    OS_GetLocalTime(&end);
+    ReportCost("TimerSetNs", BENCH_ROUNDS * NUM_TIMERS, &start, &end);
+
+    FillBatch(FAR_FUTURE_NSEC, 0);
+    OS_GetLocalTime(&start);
+    for (round = 0; round < BENCH_ROUNDS; ++round)
+    {
+        OS_TimerSetBatchNs(batch, NUM_TIMERS, 0);
+    }
+    OS_GetLocalTime(&end);
+    ReportCost("TimerSetBatchNs", BENCH_ROUNDS * NUM_TIMERS, &start, &end);
+}
+
+void TimerBatchTeardown(void)
+{
+    uint32 failures;
+    uint32 i;
+
+    failures = 0;
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        if (OS_TimerDelete(timer_ids[i]) != OS_SUCCESS)
+        {
+            ++failures;
+        }
+    }
+    UtAssert_True(failures == 0, "TimerDelete failures = %u", (unsigned int)failures);
+
+    OS_TimeBaseDelete(timebase_id);
+    OS_BinSemDelete(done_sem_id);
+
+    /* Allow the console output to drain */
+    OS_TaskDelay(100);
+}
@@ -0,0 +1,236 @@
+/*
+** Timer Dispatch Test
+**
+** Runs a timer with a callback that takes longer than its period on a
+** worker pool, next to a timer with a short callback on the same time
+** base, and verifies that:
+**
+**  - the short callback is still called on every period, since the slow
+**    callback no longer runs on the time base task
+**  - every expiration of the slow timer is either called back or counted
+**    as an overrun
+**  - a dispatched callback may use the timer API
+**
+** It then deletes a dispatched timer while its callback is queued, which
+** must skip the callback, and while it is running, which must wait for
+** the callback to return.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void TimerDispatchSetup(void);
+void TimerDispatchCheck(void);
+void TimerDispatchTeardown(void);
+void TimerDispatchDeleteCheck(void);
+
+/* time base tick, in microseconds */
+#define TICK_USEC        1000
+
+#define PERIOD_USEC      10000
+#define SLOW_MSEC        25
+#define RUN_MSEC         500
+
+/* time the worker is kept busy by another job, and the deleted callback takes */
+#define BLOCK_MSEC       100
+#define DELETE_MSEC      50
+
+uint32 timebase_id;
+uint32 pool_id;
+uint32 fast_id;
+uint32 slow_id;
+
+volatile uint32 fast_calls;
+volatile uint32 slow_calls;
+volatile uint32 slow_info_failures;
+volatile uint32 delete_entered;
+volatile uint32 delete_calls;
+
+static void FastCallback(uint32 timer_id, void *arg)
+{
+    ++fast_calls;
+}
+
+static void SlowCallback(uint32 timer_id, void *arg)
+{
+    OS_timer_prop_t timer_prop;
+
+    if (OS_TimerGetInfo(timer_id, &timer_prop) != OS_SUCCESS)
+    {
+        ++slow_info_failures;
+    }
+
+    OS_TaskDelay(SLOW_MSEC);
+    ++slow_calls;
+}
+
+static void DeleteCallback(uint32 timer_id, void *arg)
+{
+    ++delete_entered;
+    OS_TaskDelay(DELETE_MSEC);
+    ++delete_calls;
+}
+
+static void BlockJob(void *arg)
+{
+    OS_TaskDelay(BLOCK_MSEC);
+}
+
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(TimerDispatchCheck, TimerDispatchSetup, TimerDispatchTeardown, "TimerDispatchTest");
+    UtTest_Add(TimerDispatchDeleteCheck, NULL, NULL, "TimerDispatchDeleteTest");
+}
+
+void TimerDispatchSetup(void)
+{
+    int32 status;
+
+    fast_calls = 0;
+    slow_calls = 0;
+    slow_info_failures = 0;
+
+    status = OS_WorkPoolCreate(&pool_id, "Dispatch", 1, 16384, 100, 0);
+    UtAssert_True(status == OS_SUCCESS, "WorkPool create Rc=%d", (int)status);
+
+    status = OS_TimeBaseCreate(&timebase_id, "DispatchTB", NULL);
+    UtAssert_True(status == OS_SUCCESS, "TimeBase create Rc=%d", (int)status);
+
+    status = OS_TimeBaseSet(timebase_id, TICK_USEC, TICK_USEC);
+    UtAssert_True(status == OS_SUCCESS, "TimeBase set Rc=%d", (int)status);
+
+    status = OS_TimerAdd(&fast_id, "Fast", timebase_id, FastCallback, NULL);
+    UtAssert_True(status == OS_SUCCESS, "Fast timer add Rc=%d", (int)status);
+
+    status = OS_TimerAdd(&slow_id, "Slow", timebase_id, SlowCallback, NULL);
+    UtAssert_True(status == OS_SUCCESS, "Slow timer add Rc=%d", (int)status);
+}
+
+void TimerDispatchCheck(void)
+{
+    OS_timer_prop_t timer_prop;
+    uint32 expirations;
+    int32 status;
+
+    status = OS_TimerSetDispatch(slow_id, fast_id);
+    UtAssert_True(status == OS_ERR_INVALID_ID, "SetDispatch to a timer Rc=%d", (int)status);
+
+    status = OS_TimerSetDispatch(slow_id, pool_id);
+    UtAssert_True(status == OS_SUCCESS, "SetDispatch Rc=%d", (int)status);
+
+    status = OS_TimerSet(fast_id, PERIOD_USEC, PERIOD_USEC);
+    UtAssert_True(status == OS_SUCCESS, "Fast timer set Rc=%d", (int)status);
+
+    status = OS_TimerSet(slow_id, PERIOD_USEC, PERIOD_USEC);
+    UtAssert_True(status == OS_SUCCESS, "Slow timer set Rc=%d", (int)status);
+
+    OS_TaskDelay(RUN_MSEC);
+
+    /* stop both timers, then let the last dispatched callback finish */
+    OS_TimerSet(fast_id, 0x7FFF0000, 0);
+    OS_TimerSet(slow_id, 0x7FFF0000, 0);
+    status = OS_WorkPoolWaitIdle(pool_id, 1000);
+    UtAssert_True(status == OS_SUCCESS, "WorkPool wait idle Rc=%d", (int)status);
+
+    status = OS_TimerGetInfo(slow_id, &timer_prop);
+    UtAssert_True(status == OS_SUCCESS, "Slow timer get info Rc=%d", (int)status);
+
+    expirations = (RUN_MSEC * 1000) / PERIOD_USEC;
+    UtAssert_True(fast_calls >= expirations - 5 && fast_calls <= expirations + 1,
+            "Fast callbacks = %u, expected %u", (unsigned int)fast_calls, (unsigned int)expirations);
+
+    UtAssert_True(slow_calls >= expirations / 5 && slow_calls <= expirations / 2,
+            "Slow callbacks = %u", (unsigned int)slow_calls);
+
+    UtAssert_True(timer_prop.overruns > 0, "Slow timer overruns = %u", (unsigned int)timer_prop.overruns);
+
+    UtAssert_True(slow_calls + timer_prop.overruns >= expirations - 5 &&
+            slow_calls + timer_prop.overruns <= expirations + 1,
+            "Slow expirations = %u, expected %u", (unsigned int)(slow_calls + timer_prop.overruns),
+            (unsigned int)expirations);
+
+    UtAssert_True(slow_info_failures == 0, "Timer API failures from dispatched callback = %u",
+            (unsigned int)slow_info_failures);
+}
+
+void TimerDispatchTeardown(void)
+{
+    OS_TimerDelete(fast_id);
+    OS_TimerDelete(slow_id);
+    OS_TimeBaseDelete(timebase_id);
+    OS_WorkPoolDelete(pool_id);
+
+    /* Allow the console output to drain */
+    OS_TaskDelay(100);
+}
+
+void TimerDispatchDeleteCheck(void)
+{
+    uint32 timer_id;
+    uint32 attempts;
+    int32 status;
+
+    delete_entered = 0;
+    delete_calls = 0;
+
+    status = OS_WorkPoolCreate(&pool_id, "DispatchDel", 1, 16384, 100, 0);
+    UtAssert_True(status == OS_SUCCESS, "WorkPool create Rc=%d", (int)status);
+
+    status = OS_TimeBaseCreate(&timebase_id, "DispatchDelTB", NULL);
+    UtAssert_True(status == OS_SUCCESS, "TimeBase create Rc=%d", (int)status);
+
+    status = OS_TimeBaseSet(timebase_id, TICK_USEC, TICK_USEC);
+    UtAssert_True(status == OS_SUCCESS, "TimeBase set Rc=%d", (int)status);
+
+    /* the callback is queued behind a job that keeps the only worker busy */
+    status = OS_TimerAdd(&timer_id, "Queued", timebase_id, DeleteCallback, NULL);
+    UtAssert_True(status == OS_SUCCESS, "Queued timer add Rc=%d", (int)status);
+    OS_TimerSetDispatch(timer_id, pool_id);
+
+    status = OS_WorkSubmit(pool_id, BlockJob, NULL);
+    UtAssert_True(status == OS_SUCCESS, "WorkSubmit Rc=%d", (int)status);
+
+    OS_TimerSet(timer_id, PERIOD_USEC, 0);
+    OS_TaskDelay(2 * PERIOD_USEC / 1000);
+
+    status = OS_TimerDelete(timer_id);
+    UtAssert_True(status == OS_SUCCESS, "Queued timer delete Rc=%d", (int)status);
+
+    status = OS_WorkPoolWaitIdle(pool_id, 1000);
+    UtAssert_True(status == OS_SUCCESS, "WorkPool wait idle Rc=%d", (int)status);
+    UtAssert_True(delete_entered == 0, "Callbacks after delete = %u", (unsigned int)delete_entered);
+
+    /* the callback is running when the timer is deleted */
+    status = OS_TimerAdd(&timer_id, "Running", timebase_id, DeleteCallback, NULL);
+    UtAssert_True(status == OS_SUCCESS, "Running timer add Rc=%d", (int)status);
+    OS_TimerSetDispatch(timer_id, pool_id);
+    OS_TimerSet(timer_id, PERIOD_USEC, 0);
+
+    attempts = 0;
+    while (delete_entered == 0 && attempts < 100)
+    {
+        OS_TaskDelay(1);
+        ++attempts;
+    }
+    UtAssert_True(delete_entered == 1, "Callback entered = %u", (unsigned int)delete_entered);
+
+    status = OS_TimerDelete(timer_id);
+    UtAssert_True(status == OS_SUCCESS, "Running timer delete Rc=%d", (int)status);
+    UtAssert_True(delete_calls == 1, "Callbacks returned before delete = %u", (unsigned int)delete_calls);
+
+    OS_TimeBaseDelete(timebase_id);
+    OS_WorkPoolDelete(pool_id);
+}
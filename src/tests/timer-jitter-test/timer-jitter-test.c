@@ -0,0 +1,223 @@
+/*
+** timer-jitter-test.c
+**
+** This program is an OSAL sample that measures the jitter of the OSAL timers.
+** It runs the timers of the timer test on a shared time base for a while,
+** then reports how late their callbacks were, per timer and for the time base.
+**
+*/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+
+#define NUMBER_OF_TIMERS 4
+
+#define TASK_1_ID         1
+#define TASK_1_STACK_SIZE 4096
+#define TASK_1_PRIORITY   101
+
+/* time base tick, in microseconds */
+#define TICK_USEC         1000
+
+/* run time of the measurement, in seconds */
+#define TEST_SECONDS      5
+
+void TimerJitterSetup(void);
+void TimerJitterTask(void);
+void TimerJitterCheck(void);
+
+uint32           TimerStart[NUMBER_OF_TIMERS] = {1000, 2000, 5000, 20000 };
+uint32           TimerInterval[NUMBER_OF_TIMERS] = {1000, 2500, 10000, 50000 };
+
+uint32 TimerJitterTaskStack[TASK_1_STACK_SIZE];
+int32 timer_counter[NUMBER_OF_TIMERS];
+
+OS_timer_prop_t    TimerProp[NUMBER_OF_TIMERS];
+OS_timebase_prop_t TimeBaseProp;
+
+/*
+** Test timer function.
+** The lateness is measured by OSAL on entry, so this only counts the calls.
+*/
+void test_func(uint32 timer_id, void *arg)
+{
+   ++timer_counter[(cpuaddr)arg];
+}
+
+/*
+** Print the lateness statistics of a timer or time base
+*/
+void PrintLatency(const char *name, const OS_timer_latency_t *latency)
+{
+   uint32 i;
+   uint32 limit;
+
+   UtPrintf("%-10s count=%lu min=%lu max=%lu mean=%lu usec\n", name,
+           (unsigned long)latency->count, (unsigned long)latency->min_usec,
+           (unsigned long)latency->max_usec, (unsigned long)latency->mean_usec);
+
+   limit = 4;
+   for ( i = 0; i < OS_TIMER_LATENCY_BUCKETS; i++ )
+   {
+      if (latency->histogram[i] != 0)
+      {
+         if (i < (OS_TIMER_LATENCY_BUCKETS - 1))
+         {
+            UtPrintf("%-10s   < %7lu usec: %lu\n", "", (unsigned long)limit, (unsigned long)latency->histogram[i]);
+         }
+         else
+         {
+            UtPrintf("%-10s  >= %7lu usec: %lu\n", "", (unsigned long)(limit / 4), (unsigned long)latency->histogram[i]);
+         }
+      }
+      limit *= 4;
+   }
+}
+
+
+/* ********************** MAIN **************************** */
+
+void OS_Application_Startup(void)
+{
+
+  if (OS_API_Init() != OS_SUCCESS)
+  {
+      UtAssert_Abort("OS_API_Init() failed");
+  }
+
+  /*
+   * Register the timer test setup and check routines in UT assert
+   */
+  UtTest_Add(TimerJitterCheck, TimerJitterSetup, NULL, "TimerJitterTest");
+}
+
+void TimerJitterSetup(void)
+{
+    int32  status;
+    uint32 TimerJitterTaskId;
+
+    /*
+     * Timers do NOT work in the "main" thread, so create a task to handle them.
+     */
+    status = OS_TaskCreate( &TimerJitterTaskId, "Task 1", TimerJitterTask, TimerJitterTaskStack, TASK_1_STACK_SIZE, TASK_1_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "Timer Jitter Task Created RC=%d", (int)status);
+
+    /*
+     * Invoke OS_IdleLoop() so that the task/timers can run
+     *
+     * OS_IdleLoop() will return once TimerJitterTask calls OS_ApplicationShutdown,
+     * so "TimerJitterCheck" will NOT execute until the measurement is done.
+     */
+    OS_IdleLoop();
+}
+
+void TimerJitterTask(void)
+{
+   int              i = 0;
+   int32            TimerStatus[NUMBER_OF_TIMERS];
+   uint32           TimerID[NUMBER_OF_TIMERS];
+   char             TimerName[NUMBER_OF_TIMERS][20] = {"TIMER1","TIMER2","TIMER3","TIMER4"};
+   uint32           TimeBaseID;
+   int32            status;
+
+   status = OS_TimeBaseCreate(&TimeBaseID, "JitterTB", NULL);
+   UtAssert_True(status == OS_SUCCESS, "TimeBase Created RC=%d ID=%d", (int)status, (int)TimeBaseID);
+
+   status = OS_TimeBaseSet(TimeBaseID, TICK_USEC, TICK_USEC);
+   UtAssert_True(status == OS_SUCCESS, "TimeBase Set RC=%d", (int)status);
+
+   for ( i = 0; i < NUMBER_OF_TIMERS; i++ )
+   {
+      TimerStatus[i] = OS_TimerAdd(&TimerID[i], TimerName[i], TimeBaseID, test_func, (void*)(cpuaddr)i);
+      UtAssert_True(TimerStatus[i] == OS_SUCCESS, "Timer %d Created RC=%d ID=%d", i, (int)TimerStatus[i], (int)TimerID[i]);
+   }
+
+   for ( i = 0; i < NUMBER_OF_TIMERS; i++ )
+   {
+      TimerStatus[i]  =  OS_TimerSet(TimerID[i], TimerStart[i], TimerInterval[i]);
+   }
+
+   for ( i = 0; i < NUMBER_OF_TIMERS; i++ )
+   {
+       UtAssert_True(TimerStatus[i] == OS_SUCCESS, "Timer %d programmed RC=%d", i, (int)TimerStatus[i]);
+   }
+
+   UtPrintf("Measuring for %d seconds.\n", TEST_SECONDS);
+   for (i = 0 ; i < TEST_SECONDS; i++ )
+   {
+      OS_TaskDelay(1000);
+   }
+
+   /*
+    * Read the timers before the time base, so that the time base
+    * has accounted for at least all the callbacks they report.
+    */
+   for ( i = 0; i < NUMBER_OF_TIMERS; i++ )
+   {
+      TimerStatus[i] = OS_TimerGetInfo(TimerID[i], &TimerProp[i]);
+      UtAssert_True(TimerStatus[i] == OS_SUCCESS, "Timer %d info RC=%d", i, (int)TimerStatus[i]);
+   }
+
+   status = OS_TimeBaseGetInfo(TimeBaseID, &TimeBaseProp);
+   UtAssert_True(status == OS_SUCCESS, "TimeBase info RC=%d", (int)status);
+
+   for ( i = 0; i < NUMBER_OF_TIMERS; i++ )
+   {
+       TimerStatus[i] =  OS_TimerDelete(TimerID[i]);
+       UtAssert_True(TimerStatus[i] == OS_SUCCESS, "Timer %d delete RC=%d. Count total = %d",
+               i, (int)TimerStatus[i], (int)timer_counter[i]);
+   }
+
+   OS_TimeBaseDelete(TimeBaseID);
+
+   OS_ApplicationShutdown(true);
+   OS_TaskExit();
+}
+
+void TimerJitterCheck(void)
+{
+   uint32           expected;
+   uint32           total;
+   uint32           sum;
+   uint32           i;
+   uint32           j;
+
+   total = 0;
+   for ( i = 0; i < NUMBER_OF_TIMERS; i++ )
+   {
+      PrintLatency(TimerProp[i].name, &TimerProp[i].latency);
+
+      /*
+       * Every callback is measured.  How many there are depends on the
+       * load of the test system, as a late tick drops the backlog of the
+       * short intervals, so the expected count is only reported.
+       */
+      expected = 1 + ((TEST_SECONDS * 1000000) - TimerStart[i]) / TimerInterval[i];
+      UtAssert_True(TimerProp[i].latency.count > 0, "Timer %d measured %lu of %lu",
+              (int)i, (unsigned long)TimerProp[i].latency.count, (unsigned long)expected);
+      UtAssert_True(TimerProp[i].latency.count <= timer_counter[i], "Timer %d measured no more than called", (int)i);
+
+      sum = 0;
+      for ( j = 0; j < OS_TIMER_LATENCY_BUCKETS; j++ )
+      {
+         sum += TimerProp[i].latency.histogram[j];
+      }
+      UtAssert_True(sum == TimerProp[i].latency.count, "Timer %d histogram total %lu == %lu",
+              (int)i, (unsigned long)sum, (unsigned long)TimerProp[i].latency.count);
+      UtAssert_True(TimerProp[i].latency.min_usec <= TimerProp[i].latency.mean_usec &&
+              TimerProp[i].latency.mean_usec <= TimerProp[i].latency.max_usec,
+              "Timer %d min <= mean <= max", (int)i);
+
+      total += TimerProp[i].latency.count;
+   }
+
+   PrintLatency(TimeBaseProp.name, &TimeBaseProp.latency);
+   UtAssert_True(TimeBaseProp.latency.count >= total, "TimeBase measured %lu >= %lu",
+           (unsigned long)TimeBaseProp.latency.count, (unsigned long)total);
+}
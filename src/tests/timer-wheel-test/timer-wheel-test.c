@@ -0,0 +1,319 @@
+/*
+** Timer Wheel Test
+**
+** Arms up to 10000 timers on a single time base, as many as OS_MAX_TIMERS
+** allows, and verifies that each one is called back the expected number of
+** times, then measures:
+**
+**  - the cost of a time base tick with many timers armed but not due,
+**    compared to a tick with no timers armed at all
+**  - the cost of setting and deleting each timer
+**
+** The time base is driven by an external sync function which returns
+** immediately, so the ticks run as fast as the time base can process them.
+** The benchmark figures are reported for information only, since they
+** depend entirely on the host.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void TimerWheelSetup(void);
+void TimerWheelCheck(void);
+void TimerWheelTeardown(void);
+
+#if (OS_MAX_TIMERS < 10000)
+#define NUM_TIMERS       OS_MAX_TIMERS
+#else
+#define NUM_TIMERS       10000
+#endif
+
+/* time base tick, in microseconds */
+#define TICK_USEC        1000
+
+#define CHECK_TICKS      2000
+#define BENCH_TICKS      20000
+
+/* far enough in the future to never expire during the benchmark */
+#define FAR_FUTURE_USEC  0x7FFF0000
+
+/* not a whole number of microseconds, nor of ticks */
+#define ODD_INTERVAL_NSEC  1000333
+
+uint32 timebase_id;
+uint32 done_sem_id;
+uint32 timer_ids[NUM_TIMERS];
+uint32 timer_start[NUM_TIMERS];
+uint32 timer_interval[NUM_TIMERS];
+volatile uint32 timer_calls[NUM_TIMERS];
+
+volatile uint32 ticks_remaining;
+volatile uint32 run_active;
+
+/*
+ * Time base sync function: hands out ticks while a run is in progress,
+ * and otherwise idles until the next run is started.
+ */
+static uint32 TimerWheelSync(uint32 local_id)
+{
+    if (ticks_remaining == 0)
+    {
+        if (run_active)
+        {
+            run_active = 0;
+            OS_BinSemGive(done_sem_id);
+        }
+
+        while (ticks_remaining == 0)
+        {
+            OS_TaskDelay(1);
+        }
+    }
+
+    --ticks_remaining;
+    return TICK_USEC;
+}
+
+static void TimerWheelCallback(uint32 timer_id, void *arg)
+{
+    ++timer_calls[(unsigned long)arg];
+}
+
+static int32 ElapsedMicros(const OS_time_t *start, const OS_time_t *end)
+{
+    return (int32)(((int32)end->seconds - (int32)start->seconds) * 1000000 +
+            ((int32)end->microsecs - (int32)start->microsecs));
+}
+
+static void ReportCost(const char *name, uint32 count, const OS_time_t *start, const OS_time_t *end)
+{
+    int32 elapsed = ElapsedMicros(start, end);
+
+    if (count == 0)
+    {
+        count = 1;
+    }
+
+    OS_printf("%s: %u in %ld usec = %lu nsec each\n", name,
+            (unsigned int)count, (long)elapsed,
+            (unsigned long)(((uint64)elapsed * 1000) / count));
+}
+
+/*
+ * Run the time base for the given number of ticks and wait until all
+ * of the resulting callbacks have been made
+ */
+static int32 RunTicks(uint32 ticks, OS_time_t *start, OS_time_t *end)
+{
+    int32 status;
+
+    OS_GetLocalTime(start);
+    run_active = 1;
+    ticks_remaining = ticks;
+    status = OS_BinSemTimedWait(done_sem_id, 60000);
+    OS_GetLocalTime(end);
+
+    return status;
+}
+
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(TimerWheelCheck, TimerWheelSetup, TimerWheelTeardown, "TimerWheelTest");
+}
+
+void TimerWheelSetup(void)
+{
+    char name[OS_MAX_API_NAME];
+    int32 status;
+    uint32 failures;
+    uint32 i;
+
+    memset((void*)timer_calls, 0, sizeof(timer_calls));
+    ticks_remaining = 0;
+    run_active = 0;
+
+    status = OS_BinSemCreate(&done_sem_id, "Done", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "BinSem create Rc=%d", (int)status);
+
+    status = OS_TimeBaseCreate(&timebase_id, "WheelTB", TimerWheelSync);
+    UtAssert_True(status == OS_SUCCESS, "TimeBase create Id=%u Rc=%d",
+            (unsigned int)timebase_id, (int)status);
+
+    failures = 0;
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        snprintf(name, sizeof(name), "tmr%u", (unsigned int)i);
+        if (OS_TimerAdd(&timer_ids[i], name, timebase_id, TimerWheelCallback, (void*)(unsigned long)i) != OS_SUCCESS)
+        {
+            ++failures;
+        }
+    }
+    UtAssert_True(failures == 0, "TimerAdd failures = %u of %u",
+            (unsigned int)failures, (unsigned int)NUM_TIMERS);
+}
+
+void TimerWheelCheck(void)
+{
+    OS_time_t start;
+    OS_time_t end;
+    uint32 i;
+    uint32 failures;
+    uint32 wrong_count;
+    uint32 expected;
+    uint64 freerun_start;
+    uint64 freerun_end;
+    int32 status;
+
+    /*
+     * Tick cost with no timers armed, before any of them are set
+     */
+    status = RunTicks(BENCH_TICKS, &start, &end);
+    UtAssert_True(status == OS_SUCCESS, "Run idle ticks Rc=%d", (int)status);
+    ReportCost("Tick, no timers armed", BENCH_TICKS, &start, &end);
+
+    /*
+     * Callback counts: starting times are spread over every level of the
+     * wheel, including some beyond the end of the run, and every tenth
+     * timer is a one-shot.
+     */
+    failures = 0;
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        timer_start[i] = (((i * 7919) % 3000) + 1) * TICK_USEC;
+        if ((i % 10) == 0)
+        {
+            timer_interval[i] = 0;
+        }
+        else
+        {
+            timer_interval[i] = ((i % 50) + 1) * TICK_USEC;
+        }
+
+        if (OS_TimerSet(timer_ids[i], timer_start[i], timer_interval[i]) != OS_SUCCESS)
+        {
+            ++failures;
+        }
+    }
+    UtAssert_True(failures == 0, "TimerSet failures = %u", (unsigned int)failures);
+
+    status = RunTicks(CHECK_TICKS, &start, &end);
+    UtAssert_True(status == OS_SUCCESS, "Run %u ticks Rc=%d", (unsigned int)CHECK_TICKS, (int)status);
+
+    wrong_count = 0;
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        if (timer_start[i] > (CHECK_TICKS * TICK_USEC))
+        {
+            expected = 0;
+        }
+        else if (timer_interval[i] == 0)
+        {
+            expected = 1;
+        }
+        else
+        {
+            expected = (((CHECK_TICKS * TICK_USEC) - timer_start[i]) / timer_interval[i]) + 1;
+        }
+
+        if (timer_calls[i] != expected)
+        {
+            if (wrong_count < 5)
+            {
+                OS_printf("Timer %u: %u calls, expected %u\n", (unsigned int)i,
+                        (unsigned int)timer_calls[i], (unsigned int)expected);
+            }
+            ++wrong_count;
+        }
+    }
+    UtAssert_True(wrong_count == 0, "Timers with wrong callback count = %u", (unsigned int)wrong_count);
+
+    /*
+     * Tick cost with every timer armed but not due, and the cost of setting
+     * them, which also takes each periodic timer off its current slot
+     */
+    OS_GetLocalTime(&start);
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        OS_TimerSet(timer_ids[i], FAR_FUTURE_USEC - (i * TICK_USEC), 0);
+    }
+    OS_GetLocalTime(&end);
+    ReportCost("TimerSet", NUM_TIMERS, &start, &end);
+
+    memset((void*)timer_calls, 0, sizeof(timer_calls));
+    status = RunTicks(BENCH_TICKS, &start, &end);
+    UtAssert_True(status == OS_SUCCESS, "Run loaded ticks Rc=%d", (int)status);
+    ReportCost("Tick, all timers armed", BENCH_TICKS, &start, &end);
+
+    wrong_count = 0;
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        if (timer_calls[i] != 0)
+        {
+            ++wrong_count;
+        }
+    }
+    UtAssert_True(wrong_count == 0, "Timers called early = %u", (unsigned int)wrong_count);
+
+    /*
+     * Nanosecond times: an interval that is not a whole number of
+     * microseconds must not be rounded, and a start time beyond what
+     * fits in 32 bits of microseconds is accepted and never reached.
+     */
+    status = OS_TimerSetNs(timer_ids[0], ODD_INTERVAL_NSEC, ODD_INTERVAL_NSEC);
+    UtAssert_True(status == OS_SUCCESS, "TimerSetNs Rc=%d", (int)status);
+    status = OS_TimerSetNs(timer_ids[1], 5000ULL * 1000000000, 0);
+    UtAssert_True(status == OS_SUCCESS, "TimerSetNs far future Rc=%d", (int)status);
+
+    memset((void*)timer_calls, 0, sizeof(timer_calls));
+    OS_TimeBaseGetFreeRunNs(timebase_id, &freerun_start);
+    status = RunTicks(CHECK_TICKS, &start, &end);
+    UtAssert_True(status == OS_SUCCESS, "Run %u ticks Rc=%d", (unsigned int)CHECK_TICKS, (int)status);
+    OS_TimeBaseGetFreeRunNs(timebase_id, &freerun_end);
+
+    expected = ((uint64)CHECK_TICKS * TICK_USEC * 1000) / ODD_INTERVAL_NSEC;
+    UtAssert_True(timer_calls[0] == expected, "Odd interval calls = %u, expected %u",
+            (unsigned int)timer_calls[0], (unsigned int)expected);
+    UtAssert_True(timer_calls[1] == 0, "Far future calls = %u", (unsigned int)timer_calls[1]);
+    UtAssert_True((freerun_end - freerun_start) == ((uint64)CHECK_TICKS * TICK_USEC * 1000),
+            "Free run advanced %llu nsec", (unsigned long long)(freerun_end - freerun_start));
+}
+
+void TimerWheelTeardown(void)
+{
+    OS_time_t start;
+    OS_time_t end;
+    uint32 failures;
+    uint32 i;
+
+    failures = 0;
+    OS_GetLocalTime(&start);
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        if (OS_TimerDelete(timer_ids[i]) != OS_SUCCESS)
+        {
+            ++failures;
+        }
+    }
+    OS_GetLocalTime(&end);
+    ReportCost("TimerDelete", NUM_TIMERS, &start, &end);
+    UtAssert_True(failures == 0, "TimerDelete failures = %u", (unsigned int)failures);
+
+    OS_TimeBaseDelete(timebase_id);
+    OS_BinSemDelete(done_sem_id);
+
+    /* Allow the console output to drain */
+    OS_TaskDelay(100);
+}
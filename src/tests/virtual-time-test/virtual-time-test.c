@@ -0,0 +1,166 @@
+/*
+** Virtual Time Test
+**
+** Steps the virtual clock through an hour of simulated time with a timer
+** and a task delay running, and verifies that:
+**
+**  - the clock does not move while automatic advance is turned off
+**  - every timer callback and task wakeup in the hour happens, in the
+**    time it takes to process them rather than an hour
+**  - the local time moves by exactly the interval the clock advanced
+**  - the clock advances by itself again once automatic advance is back on
+**
+** This only has an effect if OSAL is built in virtual time mode.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void VirtualTimeSetup(void);
+void VirtualTimeCheck(void);
+void VirtualTimeTeardown(void);
+
+#define TASK_STACK_SIZE  4096
+#define TASK_PRIORITY    100
+
+#define TIMER_USEC       100000
+#define SLEEPER_MSEC     1000
+#define ADVANCE_SECONDS  3600
+
+/* half a timer interval more, so the last callback is not due at the very end */
+#define ADVANCE_USEC     ((uint64)ADVANCE_SECONDS * 1000000 + TIMER_USEC / 2)
+
+uint32 sleeper_stack[TASK_STACK_SIZE];
+uint32 sleeper_id;
+uint32 timer_id;
+
+volatile uint32 sleeper_wakeups;
+volatile uint32 timer_calls;
+
+void sleeper_task(void)
+{
+    while (1)
+    {
+        OS_TaskDelay(SLEEPER_MSEC);
+        ++sleeper_wakeups;
+    }
+}
+
+static void TimerCallback(uint32 timer_id)
+{
+    ++timer_calls;
+}
+
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(VirtualTimeCheck, VirtualTimeSetup, VirtualTimeTeardown, "VirtualTimeTest");
+}
+
+void VirtualTimeSetup(void)
+{
+    uint32 accuracy;
+    int32 status;
+
+    sleeper_wakeups = 0;
+    timer_calls = 0;
+
+    status = OS_TimerCreate(&timer_id, "VirtualTimer", &accuracy, TimerCallback);
+    UtAssert_True(status == OS_SUCCESS, "Timer create Id=%u Rc=%d", (unsigned int)timer_id, (int)status);
+
+    status = OS_TaskCreate(&sleeper_id, "Sleeper", sleeper_task, sleeper_stack,
+            TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "Sleeper create Id=%u Rc=%d", (unsigned int)sleeper_id, (int)status);
+}
+
+void VirtualTimeCheck(void)
+{
+    OS_time_t start_time;
+    OS_time_t end_time;
+    uint64 elapsed;
+    uint32 start_wakeups;
+    uint32 start_calls;
+    uint32 count;
+    int32 status;
+
+    status = OS_VirtualTimeSetAuto(false);
+    if (status == OS_ERR_NOT_IMPLEMENTED)
+    {
+        status = OS_VirtualTimeAdvance(1000);
+        UtAssert_True(status == OS_ERR_NOT_IMPLEMENTED, "Advance without virtual time Rc=%d", (int)status);
+        UtAssert_Type(NA, true, "Virtual time not available");
+        return;
+    }
+    UtAssert_True(status == OS_SUCCESS, "SetAuto(false) Rc=%d", (int)status);
+
+    status = OS_TimerSet(timer_id, TIMER_USEC, TIMER_USEC);
+    UtAssert_True(status == OS_SUCCESS, "Timer set Rc=%d", (int)status);
+
+    /* with the clock stopped no time passes, whatever the tasks do */
+    OS_GetLocalTime(&start_time);
+    status = OS_VirtualTimeAdvance(0);
+    UtAssert_True(status == OS_SUCCESS, "Advance(0) Rc=%d", (int)status);
+    OS_GetLocalTime(&end_time);
+    UtAssert_True(start_time.seconds == end_time.seconds && start_time.microsecs == end_time.microsecs,
+            "Stopped clock at %lu.%06lu, then %lu.%06lu", (unsigned long)start_time.seconds,
+            (unsigned long)start_time.microsecs, (unsigned long)end_time.seconds,
+            (unsigned long)end_time.microsecs);
+
+    start_wakeups = sleeper_wakeups;
+    start_calls = timer_calls;
+
+    status = OS_VirtualTimeAdvance(ADVANCE_USEC * 1000);
+    UtAssert_True(status == OS_SUCCESS, "Advance(%u s) Rc=%d", (unsigned int)ADVANCE_SECONDS, (int)status);
+
+    OS_GetLocalTime(&end_time);
+    elapsed = ((uint64)end_time.seconds * 1000000 + end_time.microsecs) -
+            ((uint64)start_time.seconds * 1000000 + start_time.microsecs);
+    UtAssert_True(elapsed == ADVANCE_USEC, "Local time advanced %lu usec",
+            (unsigned long)elapsed);
+
+    count = timer_calls - start_calls;
+    UtAssert_True(count == ((uint64)ADVANCE_SECONDS * 1000000) / TIMER_USEC,
+            "Timer callbacks in %u s = %u", (unsigned int)ADVANCE_SECONDS, (unsigned int)count);
+
+    /* the delays are not in phase with the advance, and each starts a little after the previous one ended */
+    count = sleeper_wakeups - start_wakeups;
+    UtAssert_True(count >= (ADVANCE_SECONDS * 1000) / SLEEPER_MSEC - 1 && count <= (ADVANCE_SECONDS * 1000) / SLEEPER_MSEC + 1,
+            "Sleeper wakeups in %u s = %u", (unsigned int)ADVANCE_SECONDS, (unsigned int)count);
+
+    /*
+     * Back to advancing automatically, a delay passes as soon as
+     * every task waits
+     */
+    status = OS_VirtualTimeSetAuto(true);
+    UtAssert_True(status == OS_SUCCESS, "SetAuto(true) Rc=%d", (int)status);
+
+    start_wakeups = sleeper_wakeups;
+    OS_TaskDelay(10 * SLEEPER_MSEC);
+    count = sleeper_wakeups - start_wakeups;
+    UtAssert_True(count >= 9 && count <= 11, "Sleeper wakeups in %u ms = %u",
+            (unsigned int)(10 * SLEEPER_MSEC), (unsigned int)count);
+
+    status = OS_VirtualTimeAdvance(0xFFFFFFFFFFFFFFFFULL);
+    UtAssert_True(status == OS_TIMER_ERR_INVALID_ARGS, "Advance(too far) Rc=%d", (int)status);
+}
+
+void VirtualTimeTeardown(void)
+{
+    OS_TimerDelete(timer_id);
+    OS_TaskDelete(sleeper_id);
+
+    /* Allow the console output to drain */
+    OS_TaskDelay(100);
+}
@@ -0,0 +1,461 @@
+/*
+** Worker Pool Test
+**
+** Verifies that every job submitted to a worker pool runs exactly once,
+** including jobs submitted from inside other jobs, and then compares the
+** pool against creating a task per job:
+**
+**  - throughput: jobs completed per second for a batch of short jobs
+**  - latency: time from submitting a single job until it starts running
+**
+** The benchmark figures are reported for information only, since they
+** depend entirely on the host.
+**
+** Pools whose names share a long prefix must still get distinct workers.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "common_types.h"
+
+#include "osapi.h"
+#include "utassert.h"
+#include "uttest.h"
+#include "utbsp.h"
+
+void WorkPoolSetup(void);
+void WorkPoolCheck(void);
+void WorkPoolTeardown(void);
+void WorkPoolNameCheck(void);
+
+#define TASK_STACK_SIZE  16384
+#define TASK_PRIORITY    100
+#define NUM_POOL_WORKERS 4
+
+#define NUM_JOBS         1000
+#define NUM_CHILD_JOBS   32
+
+/*
+ * The pool queues hold a limited number of jobs, and task-per-job is
+ * limited by OS_MAX_TASKS, so both benchmarks run in batches.
+ */
+#define BENCH_JOBS       2048
+#define POOL_BATCH       128
+#define TASK_BATCH       16
+#define LATENCY_SAMPLES  200
+
+#define CHECKSUM_BYTES   1024
+
+uint32 pool_id;
+uint32 done_sem_id;
+
+volatile uint32 job_runs[NUM_JOBS];
+volatile uint32 child_runs;
+
+uint8  checksum_data[CHECKSUM_BYTES];
+volatile uint32 checksum_result;
+
+OS_time_t job_start_time;
+
+/*
+ * A representative short job: checksum a small buffer
+ */
+static void ChecksumJob(void *arg)
+{
+    uint32 sum;
+    uint32 i;
+
+    sum = 0;
+    for (i = 0; i < CHECKSUM_BYTES; ++i)
+    {
+        sum = (sum << 1) + (sum >> 31) + checksum_data[i];
+    }
+
+    checksum_result = sum;
+}
+
+static void CountedJob(void *arg)
+{
+    ++job_runs[(unsigned long)arg];
+}
+
+static void ChildJob(void *arg)
+{
+    OS_CountSemGive(done_sem_id);
+}
+
+/*
+ * Submitted from a worker, so the children are queued to that worker
+ * and the other workers have to steal them
+ */
+static void ParentJob(void *arg)
+{
+    uint32 i;
+
+    for (i = 0; i < NUM_CHILD_JOBS; ++i)
+    {
+        if (OS_WorkSubmit(pool_id, ChildJob, NULL) != OS_SUCCESS)
+        {
+            break;
+        }
+    }
+}
+
+static void LatencyJob(void *arg)
+{
+    OS_GetLocalTime(&job_start_time);
+}
+
+/*
+ * Task-per-job equivalents of the jobs above
+ */
+void ChecksumTask(void)
+{
+    OS_TaskRegister();
+    ChecksumJob(NULL);
+    OS_CountSemGive(done_sem_id);
+}
+
+void LatencyTask(void)
+{
+    OS_TaskRegister();
+    LatencyJob(NULL);
+    OS_CountSemGive(done_sem_id);
+}
+
+static int32 ElapsedMicros(const OS_time_t *start, const OS_time_t *end)
+{
+    return (int32)(((int32)end->seconds - (int32)start->seconds) * 1000000 +
+            ((int32)end->microsecs - (int32)start->microsecs));
+}
+
+static void ReportRate(const char *name, uint32 jobs, uint32 failures, const OS_time_t *start, const OS_time_t *end)
+{
+    int32 elapsed = ElapsedMicros(start, end);
+
+    if (elapsed <= 0)
+    {
+        elapsed = 1;
+    }
+
+    OS_printf("%s: %u jobs in %ld usec = %lu jobs/sec, %u failures\n", name,
+            (unsigned int)jobs, (long)elapsed,
+            (unsigned long)(((uint64)jobs * 1000000) / (uint32)elapsed),
+            (unsigned int)failures);
+}
+
+static void ReportLatency(const char *name, uint32 samples, int32 min_usec, int32 max_usec, int64 sum_usec)
+{
+    if (samples == 0)
+    {
+        samples = 1;
+    }
+
+    OS_printf("%s: submit-to-start latency min=%ld max=%ld mean=%ld usec\n", name,
+            (long)min_usec, (long)max_usec, (long)(sum_usec / samples));
+}
+
+/*
+ * Create a task to run a single job, retrying if the previous
+ * batch of tasks has not finished exiting yet
+ */
+static int32 StartJobTask(osal_task_entry entry)
+{
+    static uint32 task_serial = 0;
+    char name[OS_MAX_API_NAME];
+    uint32 task_id;
+    uint32 retries;
+    int32 status;
+
+    retries = 0;
+    do
+    {
+        snprintf(name, sizeof(name), "job%u", (unsigned int)(task_serial % 1000));
+        ++task_serial;
+
+        status = OS_TaskCreate(&task_id, name, entry, NULL, TASK_STACK_SIZE, TASK_PRIORITY, 0);
+        if (status == OS_ERR_NO_FREE_IDS || status == OS_ERR_NAME_TAKEN)
+        {
+            OS_TaskDelay(1);
+        }
+        ++retries;
+    }
+    while ((status == OS_ERR_NO_FREE_IDS || status == OS_ERR_NAME_TAKEN) && retries < 100);
+
+    return status;
+}
+
+void OS_Application_Startup(void)
+{
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        UtAssert_Abort("OS_API_Init() failed");
+    }
+
+    /*
+     * Register the test setup and check routines in UT assert
+     */
+    UtTest_Add(WorkPoolCheck, WorkPoolSetup, WorkPoolTeardown, "WorkPoolTest");
+    UtTest_Add(WorkPoolNameCheck, NULL, NULL, "WorkPoolNameTest");
+}
+
+void WorkPoolSetup(void)
+{
+    int32 status;
+    uint32 i;
+
+    memset((void*)job_runs, 0, sizeof(job_runs));
+    child_runs = 0;
+
+    for (i = 0; i < CHECKSUM_BYTES; ++i)
+    {
+        checksum_data[i] = (uint8)(i * 7);
+    }
+
+    status = OS_CountSemCreate(&done_sem_id, "Done", 0, 0);
+    UtAssert_True(status == OS_SUCCESS, "CountSem create Rc=%d", (int)status);
+
+    status = OS_WorkPoolCreate(&pool_id, "Pool", NUM_POOL_WORKERS, TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "WorkPool create Id=%u Rc=%d",
+            (unsigned int)pool_id, (int)status);
+}
+
+void WorkPoolCheck(void)
+{
+    OS_workpool_prop_t prop;
+    OS_time_t start;
+    OS_time_t end;
+    uint32 found_id;
+    uint32 i;
+    uint32 j;
+    uint32 failures;
+    uint32 started;
+    uint32 wrong_count;
+    int32 status;
+    int32 latency;
+    int32 min_latency;
+    int32 max_latency;
+    int64 sum_latency;
+
+    status = OS_WorkPoolGetIdByName(&found_id, "Pool");
+    UtAssert_True(status == OS_SUCCESS && found_id == pool_id, "GetIdByName Id=%u Rc=%d",
+            (unsigned int)found_id, (int)status);
+
+    status = OS_WorkSubmit(pool_id, NULL, NULL);
+    UtAssert_True(status == OS_INVALID_POINTER, "Submit NULL Rc=%d", (int)status);
+
+    /*
+     * Every job runs exactly once
+     */
+    failures = 0;
+    for (i = 0; i < NUM_JOBS; ++i)
+    {
+        status = OS_WorkSubmit(pool_id, CountedJob, (void*)(unsigned long)i);
+        if (status == OS_QUEUE_FULL)
+        {
+            OS_WorkPoolWaitIdle(pool_id, OS_PEND);
+            status = OS_WorkSubmit(pool_id, CountedJob, (void*)(unsigned long)i);
+        }
+        if (status != OS_SUCCESS)
+        {
+            ++failures;
+        }
+    }
+
+    status = OS_WorkPoolWaitIdle(pool_id, 10000);
+    UtAssert_True(status == OS_SUCCESS, "WaitIdle Rc=%d", (int)status);
+    UtAssert_True(failures == 0, "Submit failures = %u", (unsigned int)failures);
+
+    wrong_count = 0;
+    for (i = 0; i < NUM_JOBS; ++i)
+    {
+        if (job_runs[i] != 1)
+        {
+            ++wrong_count;
+        }
+    }
+    UtAssert_True(wrong_count == 0, "Jobs not run exactly once = %u", (unsigned int)wrong_count);
+
+    /*
+     * Jobs submitted from a worker
+     */
+    status = OS_WorkSubmit(pool_id, ParentJob, NULL);
+    UtAssert_True(status == OS_SUCCESS, "Submit parent Rc=%d", (int)status);
+    for (i = 0; i < NUM_CHILD_JOBS; ++i)
+    {
+        status = OS_CountSemTimedWait(done_sem_id, 1000);
+        if (status != OS_SUCCESS)
+        {
+            break;
+        }
+        ++child_runs;
+    }
+    UtAssert_True(child_runs == NUM_CHILD_JOBS, "Child jobs run = %u", (unsigned int)child_runs);
+
+    /* the last child may still be finishing after giving the semaphore */
+    status = OS_WorkPoolWaitIdle(pool_id, 1000);
+    UtAssert_True(status == OS_SUCCESS, "WaitIdle Rc=%d", (int)status);
+
+    status = OS_WorkPoolWaitIdle(pool_id, OS_CHECK);
+    UtAssert_True(status == OS_SUCCESS, "WaitIdle check Rc=%d", (int)status);
+
+    status = OS_WorkPoolGetInfo(pool_id, &prop);
+    UtAssert_True(status == OS_SUCCESS, "GetInfo Rc=%d", (int)status);
+    UtAssert_True(prop.num_workers == NUM_POOL_WORKERS, "num_workers = %u", (unsigned int)prop.num_workers);
+    UtAssert_True(prop.jobs_submitted == NUM_JOBS + 1 + NUM_CHILD_JOBS, "jobs_submitted = %u",
+            (unsigned int)prop.jobs_submitted);
+    UtAssert_True(prop.jobs_completed == prop.jobs_submitted, "jobs_completed = %u",
+            (unsigned int)prop.jobs_completed);
+    UtAssert_True(prop.jobs_pending == 0, "jobs_pending = %u", (unsigned int)prop.jobs_pending);
+    OS_printf("Pool stats: %u submitted, %u completed, %u stolen\n",
+            (unsigned int)prop.jobs_submitted, (unsigned int)prop.jobs_completed,
+            (unsigned int)prop.jobs_stolen);
+
+    /*
+     * Throughput: worker pool
+     */
+    failures = 0;
+    OS_GetLocalTime(&start);
+    for (i = 0; i < BENCH_JOBS; i += POOL_BATCH)
+    {
+        for (j = 0; j < POOL_BATCH; ++j)
+        {
+            if (OS_WorkSubmit(pool_id, ChecksumJob, NULL) != OS_SUCCESS)
+            {
+                ++failures;
+            }
+        }
+        OS_WorkPoolWaitIdle(pool_id, OS_PEND);
+    }
+    OS_GetLocalTime(&end);
+    ReportRate("Worker pool throughput", BENCH_JOBS, failures, &start, &end);
+    UtAssert_True(failures == 0, "Pool benchmark failures = %u", (unsigned int)failures);
+
+    /*
+     * Throughput: a task per job
+     */
+    failures = 0;
+    OS_GetLocalTime(&start);
+    for (i = 0; i < BENCH_JOBS; i += TASK_BATCH)
+    {
+        started = 0;
+        for (j = 0; j < TASK_BATCH; ++j)
+        {
+            if (StartJobTask(ChecksumTask) == OS_SUCCESS)
+            {
+                ++started;
+            }
+            else
+            {
+                ++failures;
+            }
+        }
+        for (j = 0; j < started; ++j)
+        {
+            OS_CountSemTimedWait(done_sem_id, 1000);
+        }
+    }
+    OS_GetLocalTime(&end);
+    ReportRate("Task-per-job throughput", BENCH_JOBS, failures, &start, &end);
+
+    /*
+     * Latency: worker pool
+     */
+    min_latency = 0x7FFFFFFF;
+    max_latency = 0;
+    sum_latency = 0;
+    for (i = 0; i < LATENCY_SAMPLES; ++i)
+    {
+        OS_GetLocalTime(&start);
+        OS_WorkSubmit(pool_id, LatencyJob, NULL);
+        OS_WorkPoolWaitIdle(pool_id, OS_PEND);
+
+        latency = ElapsedMicros(&start, &job_start_time);
+        if (latency < min_latency)
+        {
+            min_latency = latency;
+        }
+        if (latency > max_latency)
+        {
+            max_latency = latency;
+        }
+        sum_latency += latency;
+    }
+    ReportLatency("Worker pool", LATENCY_SAMPLES, min_latency, max_latency, sum_latency);
+
+    /*
+     * Latency: a task per job
+     */
+    min_latency = 0x7FFFFFFF;
+    max_latency = 0;
+    sum_latency = 0;
+    for (i = 0; i < LATENCY_SAMPLES; ++i)
+    {
+        OS_GetLocalTime(&start);
+        if (StartJobTask(LatencyTask) != OS_SUCCESS ||
+                OS_CountSemTimedWait(done_sem_id, 1000) != OS_SUCCESS)
+        {
+            break;
+        }
+
+        latency = ElapsedMicros(&start, &job_start_time);
+        if (latency < min_latency)
+        {
+            min_latency = latency;
+        }
+        if (latency > max_latency)
+        {
+            max_latency = latency;
+        }
+        sum_latency += latency;
+    }
+    ReportLatency("Task-per-job", i, min_latency, max_latency, sum_latency);
+    UtAssert_True(i == LATENCY_SAMPLES, "Task-per-job latency samples = %u", (unsigned int)i);
+}
+
+void WorkPoolTeardown(void)
+{
+    int32 status;
+
+    status = OS_WorkPoolDelete(pool_id);
+    UtAssert_True(status == OS_SUCCESS, "WorkPool delete Rc=%d", (int)status);
+
+    status = OS_WorkSubmit(pool_id, ChecksumJob, NULL);
+    UtAssert_True(status == OS_ERR_INVALID_ID, "Submit after delete Rc=%d", (int)status);
+
+    /* Allow the job tasks to finish exiting */
+    OS_TaskDelay(100);
+
+    OS_CountSemDelete(done_sem_id);
+}
+
+void WorkPoolNameCheck(void)
+{
+    char name[OS_MAX_API_NAME + 1];
+    uint32 first_id;
+    uint32 second_id;
+    uint32 other_id;
+    int32 status;
+
+    /* the longest names allowed, differing only in the last character */
+    memset(name, 'P', sizeof(name));
+    name[OS_MAX_API_NAME - 4] = 0;
+
+    name[OS_MAX_API_NAME - 5] = 'A';
+    status = OS_WorkPoolCreate(&first_id, name, 2, TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "WorkPool create %s Rc=%d", name, (int)status);
+
+    name[OS_MAX_API_NAME - 5] = 'B';
+    status = OS_WorkPoolCreate(&second_id, name, 2, TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_SUCCESS, "WorkPool create %s Rc=%d", name, (int)status);
+
+    /* one character more would give workers the same names as the last pool */
+    name[OS_MAX_API_NAME - 4] = 'C';
+    name[OS_MAX_API_NAME - 3] = 0;
+    status = OS_WorkPoolCreate(&other_id, name, 2, TASK_STACK_SIZE, TASK_PRIORITY, 0);
+    UtAssert_True(status == OS_ERR_NAME_TOO_LONG, "WorkPool create %s Rc=%d", name, (int)status);
+
+    status = OS_WorkPoolDelete(first_id);
+    UtAssert_True(status == OS_SUCCESS, "WorkPool delete Rc=%d", (int)status);
+    status = OS_WorkPoolDelete(second_id);
+    UtAssert_True(status == OS_SUCCESS, "WorkPool delete Rc=%d", (int)status);
+}
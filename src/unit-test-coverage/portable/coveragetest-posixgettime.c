@@ -45,6 +45,21 @@ void Test_OS_GetLocalTime_Impl(void)
     OSAPI_TEST_FUNCTION_RC(OS_GetLocalTime_Impl(&timeval), OS_ERROR);
 }
 
+void Test_OS_GetMonotonicTime_Impl(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_GetMonotonicTime_Impl(OS_time_t *time_struct)
+     */
+    OS_time_t timeval;
+    timeval.seconds = 1;
+    timeval.microsecs = 1;
+    OSAPI_TEST_FUNCTION_RC(OS_GetMonotonicTime_Impl(&timeval), OS_SUCCESS);
+
+    UT_SetForceFail(UT_KEY(OCS_clock_gettime), -1);
+    OSAPI_TEST_FUNCTION_RC(OS_GetMonotonicTime_Impl(&timeval), OS_ERROR);
+}
+
 void Test_OS_SetLocalTime_Impl(void)
 {
     /*
@@ -95,6 +110,7 @@ void Osapi_TearDown(void)
 void OS_Application_Startup(void)
 {
     ADD_TEST(OS_GetLocalTime_Impl);
+    ADD_TEST(OS_GetMonotonicTime_Impl);
     ADD_TEST(OS_SetLocalTime_Impl);
 }
 
@@ -62,6 +62,7 @@
 #define SIGBUS                       OCS_SIGBUS
 #define SIGFPE                       OCS_SIGFPE
 #define SIGILL                       OCS_SIGILL
+#define SIGXCPU                      OCS_SIGXCPU
 #define SIGRTMIN                     OCS_SIGRTMIN
 #define SIGRTMAX                     OCS_SIGRTMAX
 
@@ -69,6 +70,9 @@
 #define SCHED_FIFO                   OCS_SCHED_FIFO
 #define SCHED_RR                     OCS_SCHED_RR
 
+/* syscall identifiers */
+#define SYS_gettid                   OCS_SYS_gettid
+
 /* errno identifiers */
 #define EINTR                        OCS_EINTR
 #define EAGAIN                       OCS_EAGAIN
@@ -100,6 +104,8 @@
 #define sig_atomic_t                OCS_sig_atomic_t
 #define ssize_t                     OCS_ssize_t
 #define time_t                      OCS_time_t
+#define clockid_t                   OCS_clockid_t
+#define pid_t                       OCS_pid_t
 
 /*
  * NOTE: The OCS_ structs that are not typedefs must be #defined, because the
@@ -154,6 +160,7 @@
 #define listen                          OCS_listen
 #define lseek                           OCS_lseek
 #define memcpy                          OCS_memcpy
+#define memmove                         OCS_memmove
 #define memset                          OCS_memset
 #define mkdir                           OCS_mkdir
 #define mq_close                        OCS_mq_close
@@ -184,6 +191,7 @@
 #define pthread_detach                  OCS_pthread_detach
 #define pthread_equal                   OCS_pthread_equal
 #define pthread_exit                    OCS_pthread_exit
+#define pthread_getcpuclockid           OCS_pthread_getcpuclockid
 #define pthread_getschedparam           OCS_pthread_getschedparam
 #define pthread_getspecific             OCS_pthread_getspecific
 #define pthread_key_create              OCS_pthread_key_create
@@ -194,8 +202,10 @@
 #define pthread_mutex_destroy           OCS_pthread_mutex_destroy
 #define pthread_mutex_init              OCS_pthread_mutex_init
 #define pthread_mutex_lock              OCS_pthread_mutex_lock
+#define pthread_mutex_trylock           OCS_pthread_mutex_trylock
 #define pthread_mutex_unlock            OCS_pthread_mutex_unlock
 #define pthread_self                    OCS_pthread_self
+#define pthread_setname_np              OCS_pthread_setname_np
 #define pthread_setschedparam           OCS_pthread_setschedparam
 #define pthread_setschedprio            OCS_pthread_setschedprio
 #define pthread_setspecific             OCS_pthread_setspecific
@@ -233,6 +243,7 @@
 #define statvfs                         OCS_statvfs
 #define stdout                          OCS_stdout
 #define strcmp                          OCS_strcmp
+#define strchr                          OCS_strchr
 #define strcpy                          OCS_strcpy
 #define strerror                        OCS_strerror
 #define strlen                          OCS_strlen
@@ -240,6 +251,7 @@
 #define strncpy                         OCS_strncpy
 #define strrchr                         OCS_strrchr
 #define strtoul                         OCS_strtoul
+#define syscall                         OCS_syscall
 #define sysconf                         OCS_sysconf
 #define system                          OCS_system
 #define timer_create                    OCS_timer_create
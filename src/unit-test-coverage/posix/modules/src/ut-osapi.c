@@ -18,6 +18,8 @@ OS_common_record_t * const OS_global_queue_table   = OS_stub_queue_table;
 OS_queue_internal_record_t OS_queue_table[OS_MAX_QUEUES];
 OS_task_internal_record_t OS_task_table[OS_MAX_TASKS];
 OS_console_internal_record_t OS_console_table[OS_MAX_CONSOLES];
+OS_barrier_internal_record_t OS_barrier_table[OS_MAX_BARRIERS];
+OS_workpool_internal_record_t OS_workpool_table[OS_MAX_WORKPOOLS];
 
 OS_SharedGlobalVars_t OS_SharedGlobalVars =
       {
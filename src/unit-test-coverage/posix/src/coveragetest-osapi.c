@@ -98,7 +98,7 @@ void Test_OS_Posix_InternalTaskCreate_Impl(void)
 {
     /*
      * Test Case For:
-     * int32 OS_Posix_InternalTaskCreate_Impl(pthread_t *pthr, uint32 priority, size_t stacksz, PthreadFuncPtr_t entry, void *entry_arg)
+     * int32 OS_Posix_InternalTaskCreate_Impl(pthread_t *pthr, uint32 priority, size_t stacksz, uint32 cpu_mask, PthreadFuncPtr_t entry, void *entry_arg)
      */
 }
 
@@ -9,3 +9,36 @@ UT_DEFAULT_STUB(OS_Posix_StreamAPI_Impl_Init, (void))
 UT_DEFAULT_STUB(OS_Posix_DirAPI_Impl_Init, (void))
 UT_DEFAULT_STUB(OS_Posix_FileSysAPI_Impl_Init, (void))
 
+void OS_Posix_PrefaultStack(void)
+{
+    UT_DEFAULT_IMPL(OS_Posix_PrefaultStack);
+}
+
+UT_DEFAULT_STUB(OS_Posix_StackPoolThreadCreate, (pthread_t *pthr, pthread_attr_t *attr, size_t stacksz, PthreadFuncPtr_t entry, void *entry_arg))
+
+void OS_Posix_StackPoolRelease(pthread_t thr)
+{
+    UT_DEFAULT_IMPL(OS_Posix_StackPoolRelease);
+}
+
+UT_DEFAULT_STUB(OS_Posix_TaskDeadlineSet, (uint32 local_id, uint32 runtime_usec, uint32 deadline_usec, uint32 period_usec, int fixed_priority))
+
+void OS_Posix_TaskDeadlineAttach(uint32 local_id, pid_t kernel_tid)
+{
+    UT_DEFAULT_IMPL(OS_Posix_TaskDeadlineAttach);
+}
+
+void OS_Posix_TaskDeadlineDetach(uint32 local_id, pid_t kernel_tid)
+{
+    UT_DEFAULT_IMPL(OS_Posix_TaskDeadlineDetach);
+}
+
+void OS_Posix_TaskDeadlineSync(uint32 local_id)
+{
+    UT_DEFAULT_IMPL(OS_Posix_TaskDeadlineSync);
+}
+
+void OS_Posix_TaskDeadlineGetInfo(uint32 local_id, OS_task_prop_t *task_prop)
+{
+    UT_DEFAULT_IMPL(OS_Posix_TaskDeadlineGetInfo);
+}
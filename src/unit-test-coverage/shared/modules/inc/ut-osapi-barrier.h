@@ -0,0 +1,24 @@
+/* OSAL coverage stub replacement for file mode bits
+ * this file is shared by several UT replacement headers */
+#ifndef _OSAL_UT_OSAPI_BARRIER_H_
+#define _OSAL_UT_OSAPI_BARRIER_H_
+
+#include <common_types.h>
+
+/*****************************************************
+ *
+ * UT FUNCTION PROTOTYPES
+ *
+ * These are functions that need to be invoked by UT
+ * but are not exposed directly through the implementation API.
+ *
+ *****************************************************/
+
+/**
+ * Purges all state tables and resets back to initial conditions
+ * Helps avoid cross-test dependencies
+ */
+void Osapi_Internal_ResetState(void);
+
+#endif /* _OSAL_UT_OSAPI_BARRIER_H_ */
+
@@ -0,0 +1,35 @@
+/* OSAL coverage stub replacement for file mode bits
+ * this file is shared by several UT replacement headers */
+#ifndef _OSAL_UT_OSAPI_FIBER_H_
+#define _OSAL_UT_OSAPI_FIBER_H_
+
+#include <common_types.h>
+
+/*****************************************************
+ *
+ * UT FUNCTION PROTOTYPES
+ *
+ * These are functions that need to be invoked by UT
+ * but are not exposed directly through the implementation API.
+ *
+ *****************************************************/
+
+/**
+ * Purges all state tables and resets back to initial conditions
+ * Helps avoid cross-test dependencies
+ */
+void Osapi_Internal_ResetState(void);
+
+/**
+ * Get the number of fibers in existence, which is a static
+ */
+uint32 Osapi_Get_FiberCount(void);
+
+/**
+ * Get the local id of the fiber that the given task is running,
+ * or OS_MAX_FIBERS if none
+ */
+uint32 Osapi_Get_CurrentFiber(uint32 task_idx);
+
+#endif /* _OSAL_UT_OSAPI_FIBER_H_ */
+
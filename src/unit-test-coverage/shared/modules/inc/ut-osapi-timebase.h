@@ -20,6 +20,11 @@
  */
 void Osapi_Internal_ResetState(void);
 
+/**
+ * Wrapper around the OS_TimerWheelAdvance call so the test code can invoke it
+ * (it is defined as static)
+ */
+uint32 Osapi_Call_TimerWheelAdvance(uint32 timebase_id, uint64 new_time);
 
 #endif /* _OSAL_UT_OSAPI_TIMEBASE_H_ */
 
@@ -0,0 +1,30 @@
+/* OSAL coverage stub replacement for file mode bits
+ * this file is shared by several UT replacement headers */
+#ifndef _OSAL_UT_OSAPI_WORKPOOL_H_
+#define _OSAL_UT_OSAPI_WORKPOOL_H_
+
+#include <common_types.h>
+
+/*****************************************************
+ *
+ * UT FUNCTION PROTOTYPES
+ *
+ * These are functions that need to be invoked by UT
+ * but are not exposed directly through the implementation API.
+ *
+ *****************************************************/
+
+/**
+ * Purges all state tables and resets back to initial conditions
+ * Helps avoid cross-test dependencies
+ */
+void Osapi_Internal_ResetState(void);
+
+/**
+ * Wrapper around the OS_WorkPoolWorkerEntry call so the test code can invoke it
+ * (it is defined as static)
+ */
+void Osapi_Call_WorkPoolWorkerEntry(void);
+
+#endif /* _OSAL_UT_OSAPI_WORKPOOL_H_ */
+
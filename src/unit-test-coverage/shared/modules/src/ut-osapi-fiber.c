@@ -0,0 +1,29 @@
+/* pull in the OSAL configuration */
+#include "stub-map-to-real.h"
+#include "osconfig.h"
+#include "ut-osapi-fiber.h"
+
+/*
+ * Now include all extra logic required to stub-out subsequent calls to
+ * library functions and replace with our own
+ */
+#include "osapi-fiber.c"
+
+/* Stub objects to satisfy linking requirements -
+ */
+OS_common_record_t OS_stub_task_table[OS_MAX_TASKS];
+OS_common_record_t * const OS_global_task_table   = OS_stub_task_table;
+
+uint32 Osapi_Get_FiberCount(void)
+{
+    return OS_fiber_count;
+}
+
+uint32 Osapi_Get_CurrentFiber(uint32 task_idx)
+{
+    if (OS_fiber_sched_table[task_idx].current == 0)
+    {
+        return OS_MAX_FIBERS;
+    }
+    return OS_fiber_sched_table[task_idx].current - 1;
+}
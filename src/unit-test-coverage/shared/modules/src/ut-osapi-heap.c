@@ -9,3 +9,8 @@
  */
 #include "osapi-heap.c"
 
+
+OS_SharedGlobalVars_t OS_SharedGlobalVars =
+      {
+            .Initialized = false
+      };
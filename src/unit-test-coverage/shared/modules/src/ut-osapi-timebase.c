@@ -25,3 +25,7 @@ OS_SharedGlobalVars_t OS_SharedGlobalVars =
             .Initialized = false
       };
 
+uint32 Osapi_Call_TimerWheelAdvance(uint32 timebase_id, uint64 new_time)
+{
+    return OS_TimerWheelAdvance(timebase_id, new_time);
+}
@@ -0,0 +1,20 @@
+/* pull in the OSAL configuration */
+#include "stub-map-to-real.h"
+#include "osconfig.h"
+#include "ut-osapi-workpool.h"
+
+/*
+ * Now include all extra logic required to stub-out subsequent calls to
+ * library functions and replace with our own
+ */
+#include "osapi-workpool.c"
+
+/* Stub objects to satisfy linking requirements -
+ */
+OS_common_record_t OS_stub_workpool_table[OS_MAX_WORKPOOLS];
+OS_common_record_t * const OS_global_workpool_table   = OS_stub_workpool_table;
+
+void Osapi_Call_WorkPoolWorkerEntry(void)
+{
+    OS_WorkPoolWorkerEntry();
+}
@@ -0,0 +1,179 @@
+/*
+ * Filename: coveragetest-barrier.c
+ *
+ * Purpose: This file contains unit test cases for items in the "osapi-barrier" file
+ *
+ * Notes:
+ *
+ */
+
+
+/*
+ * Includes
+ */
+
+#include "os-shared-coveragetest.h"
+#include "ut-osapi-barrier.h"
+
+#include <overrides/string.h>
+
+/*
+**********************************************************************************
+**          PUBLIC API FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_OS_BarrierAPI_Init(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_BarrierAPI_Init(void)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = OS_BarrierAPI_Init();
+
+    UtAssert_True(actual == expected, "OS_BarrierAPI_Init() (%ld) == OS_SUCCESS", (long)actual);
+}
+
+
+void Test_OS_BarrierCreate(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_BarrierCreate (uint32 *barrier_id, const char *barrier_name, uint32 count, uint32 options)
+     */
+    int32 expected = OS_SUCCESS;
+    uint32 objid = 0xFFFFFFFF;
+    int32 actual = OS_BarrierCreate(&objid, "UT", 2, 0);
+
+    UtAssert_True(actual == expected, "OS_BarrierCreate() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(objid != 0, "objid (%lu) != 0", (unsigned long)objid);
+
+    OSAPI_TEST_FUNCTION_RC(OS_BarrierCreate(NULL, NULL, 2, 0), OS_INVALID_POINTER);
+    OSAPI_TEST_FUNCTION_RC(OS_BarrierCreate(&objid, "UT", 0, 0), OS_INVALID_SEM_VALUE);
+    UT_SetForceFail(UT_KEY(OCS_strlen), 10 + OS_MAX_API_NAME);
+    OSAPI_TEST_FUNCTION_RC(OS_BarrierCreate(&objid, "UT", 2, 0), OS_ERR_NAME_TOO_LONG);
+}
+
+void Test_OS_BarrierDelete(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_BarrierDelete (uint32 barrier_id)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+
+    actual = OS_BarrierDelete(1);
+
+    UtAssert_True(actual == expected, "OS_BarrierDelete() (%ld) == OS_SUCCESS", (long)actual);
+}
+
+void Test_OS_BarrierWait(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_BarrierWait (uint32 barrier_id)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+
+    actual = OS_BarrierWait(1);
+
+    UtAssert_True(actual == expected, "OS_BarrierWait() (%ld) == OS_SUCCESS", (long)actual);
+}
+
+void Test_OS_BarrierGetIdByName(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_BarrierGetIdByName (uint32 *barrier_id, const char *barrier_name)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+    uint32 objid = 0;
+
+    UT_SetForceFail(UT_KEY(OS_ObjectIdFindByName), OS_SUCCESS);
+    actual = OS_BarrierGetIdByName(&objid, "UT");
+    UtAssert_True(actual == expected, "OS_BarrierGetIdByName() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(objid != 0, "OS_BarrierGetIdByName() objid (%lu) != 0", (unsigned long)objid);
+    UT_ClearForceFail(UT_KEY(OS_ObjectIdFindByName));
+
+    expected = OS_ERR_NAME_NOT_FOUND;
+    actual = OS_BarrierGetIdByName(&objid, "NF");
+    UtAssert_True(actual == expected, "OS_BarrierGetIdByName() (%ld) == %ld",
+            (long)actual, (long)expected);
+
+    OSAPI_TEST_FUNCTION_RC(OS_BarrierGetIdByName(NULL, NULL), OS_INVALID_POINTER);
+
+}
+
+void Test_OS_BarrierGetInfo(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_BarrierGetInfo (uint32 barrier_id, OS_barrier_prop_t *barrier_prop)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+    OS_barrier_prop_t prop;
+    uint32 local_index = 1;
+    OS_common_record_t utrec;
+    OS_common_record_t *rptr = &utrec;
+
+    memset(&utrec, 0, sizeof(utrec));
+    utrec.creator = 111;
+    utrec.name_entry = "ABC";
+    OS_barrier_table[1].count = 3;
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &rptr, sizeof(rptr), false);
+    actual = OS_BarrierGetInfo(1, &prop);
+
+    UtAssert_True(actual == expected, "OS_BarrierGetInfo() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(prop.creator == 111, "prop.creator (%lu) == 111",
+            (unsigned long)prop.creator);
+    UtAssert_True(strcmp(prop.name, "ABC") == 0, "prop.name (%s) == ABC",
+            prop.name);
+    UtAssert_True(prop.count == 3, "prop.count (%lu) == 3",
+            (unsigned long)prop.count);
+
+    OSAPI_TEST_FUNCTION_RC(OS_BarrierGetInfo(0, NULL), OS_INVALID_POINTER);
+
+}
+
+
+/* Osapi_Task_Setup
+ *
+ * Purpose:
+ *   Called by the unit test tool to set up the app prior to each test
+ */
+void Osapi_Task_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Osapi_TearDown
+ *
+ * Purpose:
+ *   Called by the unit test tool to tear down the app after each test
+ */
+void Osapi_TearDown(void)
+{
+
+}
+
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void OS_Application_Startup(void)
+{
+    ADD_TEST(OS_BarrierAPI_Init);
+    ADD_TEST(OS_BarrierCreate);
+    ADD_TEST(OS_BarrierDelete);
+    ADD_TEST(OS_BarrierWait);
+    ADD_TEST(OS_BarrierGetIdByName);
+    ADD_TEST(OS_BarrierGetInfo);
+}
+
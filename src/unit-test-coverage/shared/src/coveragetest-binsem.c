@@ -96,6 +96,14 @@ void Test_OS_BinSemTake(void)
     actual = OS_BinSemTake(1);
 
     UtAssert_True(actual == expected, "OS_BinSemTake() (%ld) == OS_SUCCESS", (long)actual);
+
+    /* from a fiber, the semaphore is polled and the fiber retries once */
+    UT_SetForceFail(UT_KEY(OS_FiberWaitStart), true);
+    UT_SetForceFail(UT_KEY(OS_FiberWaitRetry), true);
+    UT_SetDeferredRetcode(UT_KEY(OS_BinSemTimedWaitMicros_Impl), 1, OS_SEM_TIMEOUT);
+    OSAPI_TEST_FUNCTION_RC(OS_BinSemTake(1), OS_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_FiberWaitRetry)) == 1, "OS_FiberWaitRetry() called once");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_BinSemTake_Impl)) == 1, "OS_BinSemTake_Impl() not called from fiber");
 }
 
 void Test_OS_BinSemFlush(void)
@@ -124,6 +132,24 @@ void Test_OS_BinSemTimedWait(void)
     actual = OS_BinSemTimedWait(1,1);
 
     UtAssert_True(actual == expected, "OS_BinSemTimedWait() (%ld) == OS_SUCCESS", (long)actual);
+
+    /* from a fiber, the wait ends when the retry reports the timeout */
+    UT_SetForceFail(UT_KEY(OS_FiberWaitStart), true);
+    UT_SetForceFail(UT_KEY(OS_BinSemTimedWaitMicros_Impl), OS_SEM_TIMEOUT);
+    OSAPI_TEST_FUNCTION_RC(OS_BinSemTimedWait(1,1), OS_SEM_TIMEOUT);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_BinSemTimedWait_Impl)) == 1, "OS_BinSemTimedWait_Impl() not called from fiber");
+}
+
+void Test_OS_BinSemTimedWaitMicros(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_BinSemTimedWaitMicros ( uint32 sem_id, uint32 usecs )
+     */
+    OSAPI_TEST_FUNCTION_RC(OS_BinSemTimedWaitMicros(1,250), OS_SUCCESS);
+
+    UT_SetForceFail(UT_KEY(OS_BinSemTimedWaitMicros_Impl), OS_SEM_TIMEOUT);
+    OSAPI_TEST_FUNCTION_RC(OS_BinSemTimedWaitMicros(1,250), OS_SEM_TIMEOUT);
 }
 
 
@@ -216,6 +242,7 @@ void OS_Application_Startup(void)
     ADD_TEST(OS_BinSemTake);
     ADD_TEST(OS_BinSemFlush);
     ADD_TEST(OS_BinSemTimedWait);
+    ADD_TEST(OS_BinSemTimedWaitMicros);
     ADD_TEST(OS_BinSemGetIdByName);
     ADD_TEST(OS_BinSemGetInfo);
 }
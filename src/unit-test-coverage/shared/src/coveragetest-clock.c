@@ -33,6 +33,122 @@ void Test_OS_GetLocalTime(void)
 
 }
 
+void Test_OS_GetMonotonicTime(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_GetMonotonicTime(OS_time_t *time_struct)
+     */
+    OS_time_t time_struct;
+    int32 expected = OS_SUCCESS;
+    int32 actual   = OS_GetMonotonicTime(&time_struct);
+
+    UtAssert_True(actual == expected, "OS_GetMonotonicTime() (%ld) == OS_SUCCESS", (long)actual);
+
+    expected = OS_INVALID_POINTER;
+    actual   = OS_GetMonotonicTime(NULL);
+    UtAssert_True(actual == expected, "OS_GetMonotonicTime() (%ld) == OS_INVALID_POINTER", (long)actual);
+}
+
+void Test_OS_GetHighResTicks(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_GetHighResTicks(uint64 *ticks)
+     */
+    uint64 ticks = 0;
+    uint64 value = 12345;
+    int32 expected = OS_SUCCESS;
+    int32 actual;
+
+    UT_SetDataBuffer(UT_KEY(OS_GetHighResTicks_Impl), &value, sizeof(value), false);
+    actual = OS_GetHighResTicks(&ticks);
+    UtAssert_True(actual == expected, "OS_GetHighResTicks() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(ticks == 12345, "ticks (%lu) == 12345", (unsigned long)ticks);
+
+    expected = OS_INVALID_POINTER;
+    actual   = OS_GetHighResTicks(NULL);
+    UtAssert_True(actual == expected, "OS_GetHighResTicks() (%ld) == OS_INVALID_POINTER", (long)actual);
+}
+
+void Test_OS_HighResTicksToNs(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_HighResTicksToNs(uint64 ticks, uint64 *ns)
+     */
+    uint64 ns = 0;
+    uint64 rate = 3000000000ULL;
+    int32 expected = OS_SUCCESS;
+    int32 actual   = OS_HighResTicksToNs(1500000000, &ns);
+
+    /* the default rate counts in nanoseconds */
+    UtAssert_True(actual == expected, "OS_HighResTicksToNs() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(ns == 1500000000, "ns (%lu) == 1500000000", (unsigned long)ns);
+
+    UT_SetDataBuffer(UT_KEY(OS_GetHighResTickRate_Impl), &rate, sizeof(rate), false);
+    actual = OS_HighResTicksToNs(4500000001ULL, &ns);
+    UtAssert_True(actual == expected, "OS_HighResTicksToNs() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(ns == 1500000000, "ns (%lu) == 1500000000", (unsigned long)ns);
+
+    expected = OS_TIMER_ERR_INVALID_ARGS;
+    actual   = OS_HighResTicksToNs(0xFFFFFFFFFFFFFFFFULL, &ns);
+    UtAssert_True(actual == expected, "OS_HighResTicksToNs() (%ld) == OS_TIMER_ERR_INVALID_ARGS", (long)actual);
+
+    rate = 0;
+    UT_SetDataBuffer(UT_KEY(OS_GetHighResTickRate_Impl), &rate, sizeof(rate), false);
+    expected = OS_ERROR;
+    actual   = OS_HighResTicksToNs(1000, &ns);
+    UtAssert_True(actual == expected, "OS_HighResTicksToNs() (%ld) == OS_ERROR", (long)actual);
+
+    UT_SetForceFail(UT_KEY(OS_GetHighResTickRate_Impl), OS_ERR_NOT_IMPLEMENTED);
+    expected = OS_ERR_NOT_IMPLEMENTED;
+    actual   = OS_HighResTicksToNs(1000, &ns);
+    UtAssert_True(actual == expected, "OS_HighResTicksToNs() (%ld) == OS_ERR_NOT_IMPLEMENTED", (long)actual);
+
+    expected = OS_INVALID_POINTER;
+    actual   = OS_HighResTicksToNs(1000, NULL);
+    UtAssert_True(actual == expected, "OS_HighResTicksToNs() (%ld) == OS_INVALID_POINTER", (long)actual);
+}
+
+void Test_OS_NsToHighResTicks(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_NsToHighResTicks(uint64 ns, uint64 *ticks)
+     */
+    uint64 ticks = 0;
+    uint64 rate = 3000000000ULL;
+    int32 expected = OS_SUCCESS;
+    int32 actual;
+
+    UT_SetDataBuffer(UT_KEY(OS_GetHighResTickRate_Impl), &rate, sizeof(rate), false);
+    actual = OS_NsToHighResTicks(1500000000, &ticks);
+    UtAssert_True(actual == expected, "OS_NsToHighResTicks() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(ticks == 4500000000ULL, "ticks (%lu) == 4500000000", (unsigned long)ticks);
+
+    /* a rate above the limit is refused */
+    rate = 20000000000ULL;
+    UT_SetDataBuffer(UT_KEY(OS_GetHighResTickRate_Impl), &rate, sizeof(rate), false);
+    expected = OS_ERROR;
+    actual   = OS_NsToHighResTicks(1000, &ticks);
+    UtAssert_True(actual == expected, "OS_NsToHighResTicks() (%ld) == OS_ERROR", (long)actual);
+    UT_ResetState(UT_KEY(OS_GetHighResTickRate_Impl));
+
+    expected = OS_TIMER_ERR_INVALID_ARGS;
+    actual   = OS_NsToHighResTicks(0xFFFFFFFFFFFFFFFFULL, &ticks);
+    UtAssert_True(actual == expected, "OS_NsToHighResTicks() (%ld) == OS_TIMER_ERR_INVALID_ARGS", (long)actual);
+
+    UT_SetForceFail(UT_KEY(OS_GetHighResTickRate_Impl), OS_ERR_NOT_IMPLEMENTED);
+    expected = OS_ERR_NOT_IMPLEMENTED;
+    actual   = OS_NsToHighResTicks(1000, &ticks);
+    UtAssert_True(actual == expected, "OS_NsToHighResTicks() (%ld) == OS_ERR_NOT_IMPLEMENTED", (long)actual);
+
+    expected = OS_INVALID_POINTER;
+    actual   = OS_NsToHighResTicks(1000, NULL);
+    UtAssert_True(actual == expected, "OS_NsToHighResTicks() (%ld) == OS_INVALID_POINTER", (long)actual);
+}
+
 void Test_OS_SetLocalTime(void)
 {
     /*
@@ -50,6 +166,39 @@ void Test_OS_SetLocalTime(void)
     UtAssert_True(actual == expected, "OS_SetLocalTime() (%ld) == OS_INVALID_POINTER", (long)actual);
 }
 
+void Test_OS_VirtualTimeAdvance(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_VirtualTimeAdvance(uint64 nsecs)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual   = OS_VirtualTimeAdvance(1000000000);
+
+    UtAssert_True(actual == expected, "OS_VirtualTimeAdvance() (%ld) == OS_SUCCESS", (long)actual);
+
+    expected = OS_TIMER_ERR_INVALID_ARGS;
+    actual   = OS_VirtualTimeAdvance(0xFFFFFFFFFFFFFFFFULL);
+    UtAssert_True(actual == expected, "OS_VirtualTimeAdvance() (%ld) == OS_TIMER_ERR_INVALID_ARGS", (long)actual);
+
+    UT_SetForceFail(UT_KEY(OS_VirtualTimeAdvance_Impl), OS_ERR_NOT_IMPLEMENTED);
+    expected = OS_ERR_NOT_IMPLEMENTED;
+    actual   = OS_VirtualTimeAdvance(1000);
+    UtAssert_True(actual == expected, "OS_VirtualTimeAdvance() (%ld) == OS_ERR_NOT_IMPLEMENTED", (long)actual);
+}
+
+void Test_OS_VirtualTimeSetAuto(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_VirtualTimeSetAuto(bool auto_advance)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual   = OS_VirtualTimeSetAuto(false);
+
+    UtAssert_True(actual == expected, "OS_VirtualTimeSetAuto() (%ld) == OS_SUCCESS", (long)actual);
+}
+
 /* Osapi_Task_Setup
  *
  * Purpose:
@@ -77,7 +226,13 @@ void Osapi_TearDown(void)
 void OS_Application_Startup(void)
 {
     ADD_TEST(OS_GetLocalTime);
+    ADD_TEST(OS_GetMonotonicTime);
+    ADD_TEST(OS_GetHighResTicks);
+    ADD_TEST(OS_HighResTicksToNs);
+    ADD_TEST(OS_NsToHighResTicks);
     ADD_TEST(OS_SetLocalTime);
+    ADD_TEST(OS_VirtualTimeAdvance);
+    ADD_TEST(OS_VirtualTimeSetAuto);
 }
 
 
@@ -108,6 +108,69 @@ void Test_OS_API_Init(void)
 
 }
 
+void Test_OS_API_InitRealtime(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_API_InitRealtime(uint32 rt_options)
+     */
+    UT_SetHookFunction(UT_KEY(OS_TimeBaseAPI_Init), TimeBaseInitGlobal, NULL);
+    Test_MicroSecPerTick = 1000;
+    Test_TicksPerSecond = 1000;
+
+    OS_SharedGlobalVars.Initialized = false;
+    OSAPI_TEST_FUNCTION_RC(OS_API_InitRealtime(OS_RT_LOCK_MEMORY | OS_RT_PREFAULT_STACKS), OS_SUCCESS);
+    UtAssert_True(OS_SharedGlobalVars.MemoryLocked, "Memory locked");
+    UtAssert_True(OS_SharedGlobalVars.RealtimeOptions == (OS_RT_LOCK_MEMORY | OS_RT_PREFAULT_STACKS),
+            "RealtimeOptions (%lu) set", (unsigned long)OS_SharedGlobalVars.RealtimeOptions);
+
+    /* failure to lock memory is not fatal */
+    OS_SharedGlobalVars.Initialized = false;
+    UT_SetForceFail(UT_KEY(OS_API_LockMemory_Impl), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_API_InitRealtime(OS_RT_LOCK_MEMORY), OS_SUCCESS);
+    UtAssert_True(!OS_SharedGlobalVars.MemoryLocked, "Memory not locked");
+
+    /* without the option, memory is not locked */
+    OS_SharedGlobalVars.Initialized = false;
+    UT_ResetState(UT_KEY(OS_API_LockMemory_Impl));
+    OSAPI_TEST_FUNCTION_RC(OS_API_InitRealtime(0), OS_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_API_LockMemory_Impl)) == 0, "OS_API_LockMemory_Impl() not called");
+}
+
+void Test_OS_API_GetRealtimeInfo(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_API_GetRealtimeInfo(OS_realtime_prop_t *rt_prop)
+     */
+    OS_realtime_prop_t rt_prop;
+
+    OSAPI_TEST_FUNCTION_RC(OS_API_GetRealtimeInfo(NULL), OS_INVALID_POINTER);
+
+    OS_SharedGlobalVars.RealtimeOptions = OS_RT_COUNT_ALLOCATIONS;
+    OS_SharedGlobalVars.MemoryLocked = true;
+    OS_SharedGlobalVars.HeapLockedDown = false;
+    OSAPI_TEST_FUNCTION_RC(OS_API_GetRealtimeInfo(&rt_prop), OS_SUCCESS);
+    UtAssert_True(rt_prop.options == OS_RT_COUNT_ALLOCATIONS, "options (%lu) == OS_RT_COUNT_ALLOCATIONS",
+            (unsigned long)rt_prop.options);
+    UtAssert_True(rt_prop.memory_locked, "memory_locked");
+    UtAssert_True(!rt_prop.heap_locked_down, "!heap_locked_down");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_HeapGetLateAllocs_Impl)) == 0, "OS_HeapGetLateAllocs_Impl() not called");
+
+    OS_SharedGlobalVars.HeapLockedDown = true;
+    OSAPI_TEST_FUNCTION_RC(OS_API_GetRealtimeInfo(&rt_prop), OS_SUCCESS);
+    UtAssert_True(rt_prop.heap_locked_down, "heap_locked_down");
+
+    UT_SetForceFail(UT_KEY(OS_HeapGetLateAllocs_Impl), OS_ERR_NOT_IMPLEMENTED);
+    OSAPI_TEST_FUNCTION_RC(OS_API_GetRealtimeInfo(&rt_prop), OS_SUCCESS);
+    UtAssert_True(rt_prop.late_allocations == 0, "late_allocations (%lu) == 0",
+            (unsigned long)rt_prop.late_allocations);
+
+    OS_SharedGlobalVars.RealtimeOptions = 0;
+    OS_SharedGlobalVars.MemoryLocked = false;
+    OS_SharedGlobalVars.HeapLockedDown = false;
+}
+
 void Test_OS_ApplicationExit(void)
 {
     /*
@@ -155,6 +218,15 @@ void Test_OS_CleanUpObject(void)
         case OS_OBJECT_TYPE_OS_MUTEX:
             delhandler = UT_KEY(OS_MutSemDelete);
             break;
+        case OS_OBJECT_TYPE_OS_CONDVAR:
+            delhandler = UT_KEY(OS_CondVarDelete);
+            break;
+        case OS_OBJECT_TYPE_OS_BARRIER:
+            delhandler = UT_KEY(OS_BarrierDelete);
+            break;
+        case OS_OBJECT_TYPE_OS_WORKPOOL:
+            delhandler = UT_KEY(OS_WorkPoolDelete);
+            break;
         case OS_OBJECT_TYPE_OS_MODULE:
             delhandler = UT_KEY(OS_ModuleUnload);
             break;
@@ -279,6 +351,8 @@ void Osapi_TearDown(void)
 void OS_Application_Startup(void)
 {
     ADD_TEST(OS_API_Init);
+    ADD_TEST(OS_API_InitRealtime);
+    ADD_TEST(OS_API_GetRealtimeInfo);
     ADD_TEST(OS_DeleteAllObjects);
     ADD_TEST(OS_CleanUpObject);
     ADD_TEST(OS_IdleLoopAndShutdown);
@@ -0,0 +1,250 @@
+/*
+ * Filename: coveragetest-condvar.c
+ *
+ * Purpose: This file contains unit test cases for items in the "osapi-condvar" file
+ *
+ * Notes:
+ *
+ */
+
+
+/*
+ * Includes
+ */
+
+#include "os-shared-coveragetest.h"
+#include "ut-osapi-condvar.h"
+
+#include <overrides/string.h>
+
+/*
+**********************************************************************************
+**          PUBLIC API FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_OS_CondVarAPI_Init(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_CondVarAPI_Init(void)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = OS_CondVarAPI_Init();
+
+    UtAssert_True(actual == expected, "OS_CondVarAPI_Init() (%ld) == OS_SUCCESS", (long)actual);
+}
+
+
+void Test_OS_CondVarCreate(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_CondVarCreate (uint32 *var_id, const char *var_name, uint32 options)
+     */
+    int32 expected = OS_SUCCESS;
+    uint32 objid = 0xFFFFFFFF;
+    int32 actual = OS_CondVarCreate(&objid, "UT", 0);
+
+    UtAssert_True(actual == expected, "OS_CondVarCreate() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(objid != 0, "objid (%lu) != 0", (unsigned long)objid);
+
+    OSAPI_TEST_FUNCTION_RC(OS_CondVarCreate(NULL, NULL, 0), OS_INVALID_POINTER);
+    UT_SetForceFail(UT_KEY(OCS_strlen), 10 + OS_MAX_API_NAME);
+    OSAPI_TEST_FUNCTION_RC(OS_CondVarCreate(&objid, "UT", 0), OS_ERR_NAME_TOO_LONG);
+}
+
+void Test_OS_CondVarDelete(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_CondVarDelete (uint32 var_id)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+
+    actual = OS_CondVarDelete(1);
+
+    UtAssert_True(actual == expected, "OS_CondVarDelete() (%ld) == OS_SUCCESS", (long)actual);
+}
+
+void Test_OS_CondVarLock(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_CondVarLock (uint32 var_id)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+
+    actual = OS_CondVarLock(1);
+
+    UtAssert_True(actual == expected, "OS_CondVarLock() (%ld) == OS_SUCCESS", (long)actual);
+}
+
+void Test_OS_CondVarUnlock(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_CondVarUnlock (uint32 var_id)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+
+    actual = OS_CondVarUnlock(1);
+
+    UtAssert_True(actual == expected, "OS_CondVarUnlock() (%ld) == OS_SUCCESS", (long)actual);
+}
+
+void Test_OS_CondVarSignal(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_CondVarSignal (uint32 var_id)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+
+    actual = OS_CondVarSignal(1);
+
+    UtAssert_True(actual == expected, "OS_CondVarSignal() (%ld) == OS_SUCCESS", (long)actual);
+}
+
+void Test_OS_CondVarBroadcast(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_CondVarBroadcast (uint32 var_id)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+
+    actual = OS_CondVarBroadcast(1);
+
+    UtAssert_True(actual == expected, "OS_CondVarBroadcast() (%ld) == OS_SUCCESS", (long)actual);
+}
+
+void Test_OS_CondVarWait(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_CondVarWait (uint32 var_id)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+
+    actual = OS_CondVarWait(1);
+
+    UtAssert_True(actual == expected, "OS_CondVarWait() (%ld) == OS_SUCCESS", (long)actual);
+}
+
+void Test_OS_CondVarTimedWait(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_CondVarTimedWait (uint32 var_id, uint32 msecs)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+
+    actual = OS_CondVarTimedWait(1, 1);
+
+    UtAssert_True(actual == expected, "OS_CondVarTimedWait() (%ld) == OS_SUCCESS", (long)actual);
+}
+
+void Test_OS_CondVarGetIdByName(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_CondVarGetIdByName (uint32 *var_id, const char *var_name)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+    uint32 objid = 0;
+
+    UT_SetForceFail(UT_KEY(OS_ObjectIdFindByName), OS_SUCCESS);
+    actual = OS_CondVarGetIdByName(&objid, "UT");
+    UtAssert_True(actual == expected, "OS_CondVarGetIdByName() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(objid != 0, "OS_CondVarGetIdByName() objid (%lu) != 0", (unsigned long)objid);
+    UT_ClearForceFail(UT_KEY(OS_ObjectIdFindByName));
+
+    expected = OS_ERR_NAME_NOT_FOUND;
+    actual = OS_CondVarGetIdByName(&objid, "NF");
+    UtAssert_True(actual == expected, "OS_CondVarGetIdByName() (%ld) == %ld",
+            (long)actual, (long)expected);
+
+    OSAPI_TEST_FUNCTION_RC(OS_CondVarGetIdByName(NULL, NULL), OS_INVALID_POINTER);
+
+}
+
+void Test_OS_CondVarGetInfo(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_CondVarGetInfo (uint32 var_id, OS_condvar_prop_t *condvar_prop)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+    OS_condvar_prop_t prop;
+    uint32 local_index = 1;
+    OS_common_record_t utrec;
+    OS_common_record_t *rptr = &utrec;
+
+    memset(&utrec, 0, sizeof(utrec));
+    utrec.creator = 111;
+    utrec.name_entry = "ABC";
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &rptr, sizeof(rptr), false);
+    actual = OS_CondVarGetInfo(1, &prop);
+
+    UtAssert_True(actual == expected, "OS_CondVarGetInfo() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(prop.creator == 111, "prop.creator (%lu) == 111",
+            (unsigned long)prop.creator);
+    UtAssert_True(strcmp(prop.name, "ABC") == 0, "prop.name (%s) == ABC",
+            prop.name);
+
+    OSAPI_TEST_FUNCTION_RC(OS_CondVarGetInfo(0, NULL), OS_INVALID_POINTER);
+
+}
+
+
+/* Osapi_Task_Setup
+ *
+ * Purpose:
+ *   Called by the unit test tool to set up the app prior to each test
+ */
+void Osapi_Task_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Osapi_TearDown
+ *
+ * Purpose:
+ *   Called by the unit test tool to tear down the app after each test
+ */
+void Osapi_TearDown(void)
+{
+
+}
+
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void OS_Application_Startup(void)
+{
+    ADD_TEST(OS_CondVarAPI_Init);
+    ADD_TEST(OS_CondVarCreate);
+    ADD_TEST(OS_CondVarDelete);
+    ADD_TEST(OS_CondVarLock);
+    ADD_TEST(OS_CondVarUnlock);
+    ADD_TEST(OS_CondVarSignal);
+    ADD_TEST(OS_CondVarBroadcast);
+    ADD_TEST(OS_CondVarWait);
+    ADD_TEST(OS_CondVarTimedWait);
+    ADD_TEST(OS_CondVarGetIdByName);
+    ADD_TEST(OS_CondVarGetInfo);
+}
+
@@ -96,6 +96,14 @@ void Test_OS_CountSemTake(void)
     actual = OS_CountSemTake(1);
 
     UtAssert_True(actual == expected, "OS_CountSemTake() (%ld) == OS_SUCCESS", (long)actual);
+
+    /* from a fiber, the semaphore is polled and the fiber retries once */
+    UT_SetForceFail(UT_KEY(OS_FiberWaitStart), true);
+    UT_SetForceFail(UT_KEY(OS_FiberWaitRetry), true);
+    UT_SetDeferredRetcode(UT_KEY(OS_CountSemTimedWaitMicros_Impl), 1, OS_SEM_TIMEOUT);
+    OSAPI_TEST_FUNCTION_RC(OS_CountSemTake(1), OS_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_FiberWaitRetry)) == 1, "OS_FiberWaitRetry() called once");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_CountSemTake_Impl)) == 1, "OS_CountSemTake_Impl() not called from fiber");
 }
 
 void Test_OS_CountSemTimedWait(void)
@@ -110,6 +118,24 @@ void Test_OS_CountSemTimedWait(void)
     actual = OS_CountSemTimedWait(1,1);
 
     UtAssert_True(actual == expected, "OS_CountSemTimedWait() (%ld) == OS_SUCCESS", (long)actual);
+
+    /* from a fiber, the wait ends when the retry reports the timeout */
+    UT_SetForceFail(UT_KEY(OS_FiberWaitStart), true);
+    UT_SetForceFail(UT_KEY(OS_CountSemTimedWaitMicros_Impl), OS_SEM_TIMEOUT);
+    OSAPI_TEST_FUNCTION_RC(OS_CountSemTimedWait(1,1), OS_SEM_TIMEOUT);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_CountSemTimedWait_Impl)) == 1, "OS_CountSemTimedWait_Impl() not called from fiber");
+}
+
+void Test_OS_CountSemTimedWaitMicros(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_CountSemTimedWaitMicros ( uint32 sem_id, uint32 usecs )
+     */
+    OSAPI_TEST_FUNCTION_RC(OS_CountSemTimedWaitMicros(1,250), OS_SUCCESS);
+
+    UT_SetForceFail(UT_KEY(OS_CountSemTimedWaitMicros_Impl), OS_SEM_TIMEOUT);
+    OSAPI_TEST_FUNCTION_RC(OS_CountSemTimedWaitMicros(1,250), OS_SEM_TIMEOUT);
 }
 
 
@@ -202,6 +228,7 @@ void OS_Application_Startup(void)
     ADD_TEST(OS_CountSemGive);
     ADD_TEST(OS_CountSemTake);
     ADD_TEST(OS_CountSemTimedWait);
+    ADD_TEST(OS_CountSemTimedWaitMicros);
     ADD_TEST(OS_CountSemGetIdByName);
     ADD_TEST(OS_CountSemGetInfo);
 }
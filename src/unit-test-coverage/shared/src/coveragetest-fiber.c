@@ -0,0 +1,449 @@
+/*
+ * Filename: coveragetest-fiber.c
+ *
+ * Purpose: This file contains unit test cases for items in the "osapi-fiber" file
+ *
+ * Notes:
+ *
+ */
+
+
+/*
+ * Includes
+ */
+
+#include "os-shared-coveragetest.h"
+#include "ut-osapi-fiber.h"
+
+#include <overrides/string.h>
+
+/*
+ * Steps that the fibers run each time they are switched in
+ */
+typedef enum
+{
+    UT_FIBER_STEP_YIELD,
+    UT_FIBER_STEP_SLEEP_ZERO,
+    UT_FIBER_STEP_SLEEP,
+    UT_FIBER_STEP_POLL,
+    UT_FIBER_STEP_POLL_EXPIRED,
+    UT_FIBER_STEP_STREAM,
+    UT_FIBER_STEP_STREAM_TIMED,
+    UT_FIBER_STEP_END
+} UT_FiberStep_t;
+
+#define UT_FIBER_MAX_STEPS      6
+#define UT_FIBER_TIME_ENTRIES   2000
+
+static const UT_FiberStep_t UT_FiberScript[4][UT_FIBER_MAX_STEPS] =
+{
+        { UT_FIBER_STEP_END },
+        { UT_FIBER_STEP_YIELD, UT_FIBER_STEP_SLEEP_ZERO, UT_FIBER_STEP_POLL, UT_FIBER_STEP_POLL, UT_FIBER_STEP_END },
+        { UT_FIBER_STEP_STREAM, UT_FIBER_STEP_POLL_EXPIRED, UT_FIBER_STEP_END },
+        { UT_FIBER_STEP_SLEEP, UT_FIBER_STEP_STREAM_TIMED, UT_FIBER_STEP_STREAM, UT_FIBER_STEP_END }
+};
+
+static uint32 UT_FiberStepCount[4];
+static uint32 UT_FiberEntryCount;
+static uint32 UT_FiberIdSeen;
+static OS_fiber_wait_t UT_FiberWait[4];
+static OS_time_t UT_FiberTime[UT_FIBER_TIME_ENTRIES];
+
+/*
+**********************************************************************************
+**          HOOK/CALLBACK FUNCTIONS
+**********************************************************************************
+*/
+
+static void UT_FiberEntry(void *arg)
+{
+    ++(*((uint32*)arg));
+}
+
+/* runs the next step of the script of the fiber being switched in */
+static int32 UT_FiberSwitchInHook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    uint32 local_id;
+    UT_FiberStep_t step;
+
+    local_id = Osapi_Get_CurrentFiber(0);
+    if (local_id >= 4 || UT_FiberStepCount[local_id] >= UT_FIBER_MAX_STEPS)
+    {
+        return StubRetcode;
+    }
+
+    step = UT_FiberScript[local_id][UT_FiberStepCount[local_id]];
+    ++UT_FiberStepCount[local_id];
+
+    switch(step)
+    {
+    case UT_FIBER_STEP_YIELD:
+        UT_FiberIdSeen = OS_FiberGetId();
+        OS_FiberYield();
+        break;
+    case UT_FIBER_STEP_SLEEP_ZERO:
+        OS_FiberSleep(0);
+        break;
+    case UT_FIBER_STEP_SLEEP:
+        OS_FiberSleep(20000);
+        break;
+    case UT_FIBER_STEP_POLL:
+        if (UT_FiberStepCount[local_id] == 3)
+        {
+            OS_FiberWaitStart(&UT_FiberWait[local_id], 1500);
+        }
+        if (!OS_FiberWaitRetry(&UT_FiberWait[local_id]))
+        {
+            OS_FiberSleep(0);
+        }
+        break;
+    case UT_FIBER_STEP_POLL_EXPIRED:
+        OS_FiberWaitStart(&UT_FiberWait[local_id], 0);
+        if (!OS_FiberWaitRetry(&UT_FiberWait[local_id]))
+        {
+            OS_FiberSleep(0);
+        }
+        break;
+    case UT_FIBER_STEP_STREAM:
+        OS_FiberWaitStream(local_id, OS_STREAM_STATE_READABLE, OS_PEND);
+        break;
+    case UT_FIBER_STEP_STREAM_TIMED:
+        OS_FiberWaitStream(local_id, OS_STREAM_STATE_WRITABLE, 10);
+        break;
+    case UT_FIBER_STEP_END:
+    default:
+        OS_FiberEntryPoint(local_id);
+        break;
+    }
+
+    return StubRetcode;
+}
+
+/*
+ * Feed the fiber scheduler a clock that advances 1ms per reading
+ */
+static void UT_SetupFiberTime(void)
+{
+    uint32 i;
+
+    for (i = 0; i < UT_FIBER_TIME_ENTRIES; ++i)
+    {
+        UT_FiberTime[i].seconds = 100 + (i / 1000);
+        UT_FiberTime[i].microsecs = (i % 1000) * 1000;
+    }
+    UT_SetDataBuffer(UT_KEY(OS_GetMonotonicTime_Impl), UT_FiberTime, sizeof(UT_FiberTime), false);
+}
+
+/*
+**********************************************************************************
+**          PUBLIC API FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_OS_FiberAPI_Init(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_FiberAPI_Init(void)
+     */
+    OSAPI_TEST_FUNCTION_RC(OS_FiberAPI_Init(), OS_SUCCESS);
+    UtAssert_True(Osapi_Get_FiberCount() == 0, "fiber count == 0");
+}
+
+void Test_OS_FiberCreate(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_FiberCreate (uint32 *fiber_id, const char *fiber_name, OS_FiberFunc_t entry,
+     *                       void *arg, uint32 stack_size, uint32 flags)
+     */
+    uint32 objid = 0xFFFFFFFF;
+    char name[OS_MAX_API_NAME];
+    uint32 i;
+
+    OS_FiberAPI_Init();
+    OSAPI_TEST_FUNCTION_RC(OS_FiberCreate(&objid, "UT", UT_FiberEntry, NULL, 0, 0), OS_SUCCESS);
+    UtAssert_True(objid == 1, "objid (%lx) == 1", (unsigned long)objid);
+    UtAssert_True(OS_fiber_table[1].stack_size == OS_FIBER_DEFAULT_STACK_SIZE, "stack_size (%lu) == default",
+            (unsigned long)OS_fiber_table[1].stack_size);
+    UtAssert_True(Osapi_Get_FiberCount() == 1, "fiber count == 1");
+
+    /* failure of the implementation does not count the fiber */
+    UT_SetForceFail(UT_KEY(OS_FiberCreate_Impl), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberCreate(&objid, "UT2", UT_FiberEntry, NULL, 4096, 0), OS_ERROR);
+    UT_ClearForceFail(UT_KEY(OS_FiberCreate_Impl));
+    UtAssert_True(objid == 0, "objid (%lx) == 0", (unsigned long)objid);
+    UtAssert_True(Osapi_Get_FiberCount() == 1, "fiber count == 1");
+
+    UT_SetForceFail(UT_KEY(OS_FiberTaskInit_Impl), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberCreate(&objid, "UT2", UT_FiberEntry, NULL, 0, 0), OS_ERROR);
+    UT_ClearForceFail(UT_KEY(OS_FiberTaskInit_Impl));
+
+    OSAPI_TEST_FUNCTION_RC(OS_FiberCreate(&objid, "UT", UT_FiberEntry, NULL, 0, 0), OS_ERR_NAME_TAKEN);
+
+    /* the failed create used serial 2, the table wraps around to the free entries */
+    for (i = 1; i < OS_MAX_FIBERS; ++i)
+    {
+        name[0] = 'F';
+        name[1] = 'A' + i;
+        name[2] = 0;
+        OSAPI_TEST_FUNCTION_RC(OS_FiberCreate(&objid, name, UT_FiberEntry, NULL, 0, 0), OS_SUCCESS);
+    }
+    UtAssert_True(Osapi_Get_FiberCount() == OS_MAX_FIBERS, "fiber count == OS_MAX_FIBERS");
+    OSAPI_TEST_FUNCTION_RC(OS_FiberCreate(&objid, "UTX", UT_FiberEntry, NULL, 0, 0), OS_ERR_NO_FREE_IDS);
+
+    OSAPI_TEST_FUNCTION_RC(OS_FiberCreate(NULL, "UT", UT_FiberEntry, NULL, 0, 0), OS_INVALID_POINTER);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberCreate(&objid, NULL, UT_FiberEntry, NULL, 0, 0), OS_INVALID_POINTER);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberCreate(&objid, "UT", NULL, NULL, 0, 0), OS_INVALID_POINTER);
+    UT_SetForceFail(UT_KEY(OCS_strlen), 10 + OS_MAX_API_NAME);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberCreate(&objid, "UT", UT_FiberEntry, NULL, 0, 0), OS_ERR_NAME_TOO_LONG);
+    UT_ClearForceFail(UT_KEY(OCS_strlen));
+
+    /* the caller must be an OSAL task */
+    UT_SetForceFail(UT_KEY(OS_ObjectIdToArrayIndex), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberCreate(&objid, "UT", UT_FiberEntry, NULL, 0, 0), OS_ERR_INCORRECT_OBJ_STATE);
+}
+
+void Test_OS_FiberRun(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_FiberRun (void)
+     */
+    uint32 objid;
+    uint32 i;
+    char name[] = "UT0";
+
+    OS_FiberAPI_Init();
+    memset(UT_FiberStepCount, 0, sizeof(UT_FiberStepCount));
+    UT_FiberEntryCount = 0;
+    UT_FiberIdSeen = 0;
+    UT_SetupFiberTime();
+
+    /* creates local ids 1, 2 and 3 */
+    for (i = 1; i <= 3; ++i)
+    {
+        name[2] = '0' + i;
+        OSAPI_TEST_FUNCTION_RC(OS_FiberCreate(&objid, name, UT_FiberEntry, &UT_FiberEntryCount, 0, 0), OS_SUCCESS);
+    }
+    OS_fiber_table[1].active_id = 0x12345;
+
+    /* the first select fails, so fiber 2 waits until the next one */
+    UT_SetDeferredRetcode(UT_KEY(OS_SelectMultiple_Impl), 1, OS_ERROR);
+    UT_SetHookFunction(UT_KEY(OS_FiberSwitchIn_Impl), UT_FiberSwitchInHook, NULL);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberRun(), OS_SUCCESS);
+    UT_SetHookFunction(UT_KEY(OS_FiberSwitchIn_Impl), NULL, NULL);
+
+    UtAssert_True(UT_FiberEntryCount == 3, "UT_FiberEntryCount (%lu) == 3", (unsigned long)UT_FiberEntryCount);
+    UtAssert_True(UT_FiberIdSeen == 0x12345, "OS_FiberGetId() (%lx) == 0x12345", (unsigned long)UT_FiberIdSeen);
+    UtAssert_True(UT_FiberStepCount[1] == 5, "fiber 1 steps (%lu) == 5", (unsigned long)UT_FiberStepCount[1]);
+    UtAssert_True(UT_FiberStepCount[2] >= 3, "fiber 2 steps (%lu) >= 3", (unsigned long)UT_FiberStepCount[2]);
+    UtAssert_True(UT_FiberStepCount[3] == 4, "fiber 3 steps (%lu) == 4", (unsigned long)UT_FiberStepCount[3]);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_FiberDelete_Impl)) == 3, "OS_FiberDelete_Impl() called 3 times");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_FiberIdle_Impl)) > 0, "task idled while fiber slept");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_FiberNotifyEnable_Impl)) == 2, "notification enabled and disabled");
+    UtAssert_True(Osapi_Get_FiberCount() == 0, "fiber count == 0");
+    UtAssert_True(OS_fiber_table[1].switches == 5, "fiber 1 switches (%lu) == 5",
+            (unsigned long)OS_fiber_table[1].switches);
+
+    /* nothing to run */
+    OSAPI_TEST_FUNCTION_RC(OS_FiberRun(), OS_SUCCESS);
+
+    /* the caller must be an OSAL task */
+    UT_SetForceFail(UT_KEY(OS_ObjectIdToArrayIndex), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberRun(), OS_ERR_INCORRECT_OBJ_STATE);
+}
+
+void Test_OS_FiberYield(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_FiberYield (void)
+     * uint32 OS_FiberGetId (void)
+     */
+    uint32 objid;
+    OS_fiber_wait_t wait;
+
+    OS_FiberAPI_Init();
+
+    /* not called from a fiber */
+    OSAPI_TEST_FUNCTION_RC(OS_FiberYield(), OS_ERR_INCORRECT_OBJ_STATE);
+    UtAssert_True(OS_FiberGetId() == 0, "OS_FiberGetId() == 0");
+
+    OS_FiberCreate(&objid, "UT", UT_FiberEntry, NULL, 0, 0);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberYield(), OS_ERR_INCORRECT_OBJ_STATE);
+    UtAssert_True(!OS_FiberWaitStart(&wait, 0), "OS_FiberWaitStart() == false");
+    UtAssert_True(!OS_FiberSleep(0), "OS_FiberSleep() == false");
+    UtAssert_True(!OS_FiberWaitStream(1, OS_STREAM_STATE_READABLE, 0), "OS_FiberWaitStream() == false");
+
+    /* a task that is not an OSAL task has no fibers */
+    UT_SetForceFail(UT_KEY(OS_ObjectIdToArrayIndex), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberYield(), OS_ERR_INCORRECT_OBJ_STATE);
+}
+
+void Test_OS_FiberDelete(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_FiberDelete (uint32 fiber_id)
+     */
+    uint32 objid;
+
+    OS_FiberAPI_Init();
+
+    /* fibers 1 and 2 belong to the calling task, which is task id 0 */
+    OS_FiberCreate(&objid, "UT1", UT_FiberEntry, NULL, 0, 0);
+    OS_FiberCreate(&objid, "UT2", UT_FiberEntry, NULL, 0, 0);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberDelete(2), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberDelete(1), OS_SUCCESS);
+    UtAssert_True(Osapi_Get_FiberCount() == 0, "fiber count == 0");
+
+    /* fiber of another task which still exists */
+    OS_FiberCreate(&objid, "UT", UT_FiberEntry, NULL, 0, 0);
+    OS_fiber_table[3].host_task_id = 5;
+    OS_global_task_table[5].active_id = 5;
+    OSAPI_TEST_FUNCTION_RC(OS_FiberDelete(3), OS_ERR_INCORRECT_OBJ_STATE);
+
+    /* once the task is gone, anyone may delete the fiber */
+    OS_global_task_table[5].active_id = 0;
+    OSAPI_TEST_FUNCTION_RC(OS_FiberDelete(3), OS_SUCCESS);
+
+    /* the host task has never scheduled the fiber */
+    OS_FiberCreate(&objid, "UT", UT_FiberEntry, NULL, 0, 0);
+    OS_fiber_table[4].host_task_id = 6;
+    OS_global_task_table[6].active_id = 6;
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 6);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberDelete(4), OS_SUCCESS);
+    UT_ClearForceFail(UT_KEY(OS_TaskGetId_Impl));
+    OS_global_task_table[6].active_id = 0;
+
+    OS_FiberCreate(&objid, "UT", UT_FiberEntry, NULL, 0, 0);
+    UT_SetForceFail(UT_KEY(OS_FiberDelete_Impl), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberDelete(5), OS_ERROR);
+    UT_ClearForceFail(UT_KEY(OS_FiberDelete_Impl));
+    UtAssert_True(Osapi_Get_FiberCount() == 1, "fiber count == 1");
+
+    /* the fibers left over when all objects are deleted */
+    OS_FiberDeleteAll();
+    UtAssert_True(Osapi_Get_FiberCount() == 0, "fiber count == 0");
+
+    OSAPI_TEST_FUNCTION_RC(OS_FiberDelete(1), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberDelete(0), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberDelete(0xFFFFFFFF), OS_ERR_INVALID_ID);
+}
+
+void Test_OS_FiberGetIdByName(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_FiberGetIdByName (uint32 *fiber_id, const char *fiber_name)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+    uint32 objid = 0;
+
+    OS_FiberAPI_Init();
+    OS_FiberCreate(&objid, "OTHER", UT_FiberEntry, NULL, 0, 0);
+    OS_FiberCreate(&objid, "UT", UT_FiberEntry, NULL, 0, 0);
+    objid = 0;
+    actual = OS_FiberGetIdByName(&objid, "UT");
+    UtAssert_True(actual == expected, "OS_FiberGetIdByName() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(objid == 2, "objid (%lu) == 2", (unsigned long)objid);
+
+    expected = OS_ERR_NAME_NOT_FOUND;
+    actual = OS_FiberGetIdByName(&objid, "NF");
+    UtAssert_True(actual == expected, "OS_FiberGetIdByName() (%ld) == %ld",
+            (long)actual, (long)expected);
+
+    OSAPI_TEST_FUNCTION_RC(OS_FiberGetIdByName(NULL, NULL), OS_INVALID_POINTER);
+}
+
+void Test_OS_FiberGetInfo(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_FiberGetInfo (uint32 fiber_id, OS_fiber_prop_t *fiber_prop)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+    OS_fiber_prop_t prop;
+    uint32 objid;
+
+    OS_FiberAPI_Init();
+    OS_FiberCreate(&objid, "ABC", UT_FiberEntry, NULL, 4096, 0);
+    OS_fiber_table[1].creator = 111;
+    OS_fiber_table[1].host_task_id = 222;
+    OS_fiber_table[1].switches = 33;
+    actual = OS_FiberGetInfo(objid, &prop);
+
+    UtAssert_True(actual == expected, "OS_FiberGetInfo() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(prop.creator == 111, "prop.creator (%lu) == 111",
+            (unsigned long)prop.creator);
+    UtAssert_True(strcmp(prop.name, "ABC") == 0, "prop.name (%s) == ABC",
+            prop.name);
+    UtAssert_True(prop.host_task_id == 222, "prop.host_task_id (%lu) == 222",
+            (unsigned long)prop.host_task_id);
+    UtAssert_True(prop.stack_size == 4096, "prop.stack_size (%lu) == 4096",
+            (unsigned long)prop.stack_size);
+    UtAssert_True(prop.switches == 33, "prop.switches (%lu) == 33",
+            (unsigned long)prop.switches);
+
+    OSAPI_TEST_FUNCTION_RC(OS_FiberGetInfo(0, NULL), OS_INVALID_POINTER);
+    OSAPI_TEST_FUNCTION_RC(OS_FiberGetInfo(objid + 1, &prop), OS_ERR_INVALID_ID);
+}
+
+void Test_OS_FiberNotify(void)
+{
+    /*
+     * Test Case For:
+     * void OS_FiberNotify(void)
+     */
+    uint32 objid;
+
+    /* nothing to notify while there are no fibers */
+    OS_FiberAPI_Init();
+    OS_FiberNotify();
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_FiberNotify_Impl)) == 0, "OS_FiberNotify_Impl() not called");
+
+    OS_FiberCreate(&objid, "UT", UT_FiberEntry, NULL, 0, 0);
+    OS_FiberNotify();
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_FiberNotify_Impl)) == 1, "OS_FiberNotify_Impl() called");
+}
+
+
+/* Osapi_Task_Setup
+ *
+ * Purpose:
+ *   Called by the unit test tool to set up the app prior to each test
+ */
+void Osapi_Task_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Osapi_TearDown
+ *
+ * Purpose:
+ *   Called by the unit test tool to tear down the app after each test
+ */
+void Osapi_TearDown(void)
+{
+
+}
+
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void OS_Application_Startup(void)
+{
+    ADD_TEST(OS_FiberAPI_Init);
+    ADD_TEST(OS_FiberCreate);
+    ADD_TEST(OS_FiberRun);
+    ADD_TEST(OS_FiberYield);
+    ADD_TEST(OS_FiberDelete);
+    ADD_TEST(OS_FiberGetIdByName);
+    ADD_TEST(OS_FiberGetInfo);
+    ADD_TEST(OS_FiberNotify);
+}
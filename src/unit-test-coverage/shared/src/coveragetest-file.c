@@ -118,6 +118,14 @@ void Test_OS_TimedRead(void)
     actual = OS_TimedRead(1, NULL, sizeof(Buf), 10);
     UtAssert_True(actual == expected, "OS_TimedRead() (%ld) == %ld",
             (long)actual, (long)expected);
+
+    /* a fiber waits for the file through the fiber scheduler */
+    UT_SetForceFail(UT_KEY(OS_FiberWaitStream), true);
+    expected = sizeof(Buf);
+    actual = OS_TimedRead(1, (void*)Buf, sizeof(Buf), 10);
+    UtAssert_True(actual == expected, "OS_TimedRead() (%ld) == %ld",
+            (long)actual, (long)expected);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_FiberWaitStream)) == 2, "OS_FiberWaitStream() called twice");
 }
 
 
@@ -143,6 +151,14 @@ void Test_OS_TimedWrite(void)
     actual = OS_TimedWrite(1, NULL, sizeof(Buf), 10);
     UtAssert_True(actual == expected, "OS_TimedWrite() (%ld) == %ld",
             (long)actual, (long)expected);
+
+    /* a fiber waits for the file through the fiber scheduler */
+    UT_SetForceFail(UT_KEY(OS_FiberWaitStream), true);
+    expected = sizeof(Buf);
+    actual = OS_TimedWrite(1, Buf, sizeof(Buf), 10);
+    UtAssert_True(actual == expected, "OS_TimedWrite() (%ld) == %ld",
+            (long)actual, (long)expected);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_FiberWaitStream)) == 2, "OS_FiberWaitStream() called twice");
 }
 
 
@@ -34,6 +34,23 @@ void Test_OS_HeapGetInfo(void)
     UtAssert_True(actual == expected, "OS_HeapGetInfo() (%ld) == OS_INVALID_POINTER", (long)actual);
 
 }
+
+void Test_OS_HeapLockdown(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_HeapLockdown(void)
+     */
+    OS_SharedGlobalVars.HeapLockedDown = false;
+    UT_SetForceFail(UT_KEY(OS_HeapLockdown_Impl), OS_ERR_NOT_IMPLEMENTED);
+    OSAPI_TEST_FUNCTION_RC(OS_HeapLockdown(), OS_ERR_NOT_IMPLEMENTED);
+    UtAssert_True(!OS_SharedGlobalVars.HeapLockedDown, "Heap not locked down");
+    UT_ClearForceFail(UT_KEY(OS_HeapLockdown_Impl));
+
+    OSAPI_TEST_FUNCTION_RC(OS_HeapLockdown(), OS_SUCCESS);
+    UtAssert_True(OS_SharedGlobalVars.HeapLockedDown, "Heap locked down");
+    OS_SharedGlobalVars.HeapLockedDown = false;
+}
 /* Osapi_Task_Setup
  *
  * Purpose:
@@ -61,6 +78,7 @@ void Osapi_TearDown(void)
 void OS_Application_Startup(void)
 {
     ADD_TEST(OS_HeapGetInfo);
+    ADD_TEST(OS_HeapLockdown);
 }
 
 
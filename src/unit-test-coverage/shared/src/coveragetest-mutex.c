@@ -152,6 +152,210 @@ void Test_OS_MutSemGetInfo(void)
 
 }
 
+#ifdef OS_MUTEX_DIAGNOSTICS
+/* simulates the previous owner releasing the mutex while the caller is blocked */
+static int32 UT_MutexReleaseHook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    OS_mutex_table[1].owner = 0;
+    OS_mutex_table[1].nest_depth = 0;
+    return StubRetcode;
+}
+
+void Test_OS_MutSemDiagnostics(void)
+{
+    /*
+     * Test Case For:
+     * Lock diagnostics within OS_MutSemTake/OS_MutSemGive/OS_MutSemGetInfo
+     */
+    OS_mut_sem_prop_t prop;
+    OS_task_prop_t task_prop[2];
+    OS_time_t timeval[2];
+    uint32 local_index = 1;
+    OS_common_record_t utrec;
+    OS_common_record_t *rptr = &utrec;
+
+    memset(&OS_mutex_table[1], 0, sizeof(OS_mutex_table[1]));
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 0x10001);
+
+    /* uncontended take, then a nested take which must not be counted */
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(1), OS_SUCCESS);
+    UtAssert_True(OS_mutex_table[1].nest_depth == 2, "nest_depth (%lu) == 2",
+            (unsigned long)OS_mutex_table[1].nest_depth);
+    UtAssert_True(OS_mutex_table[1].take_count == 1, "take_count (%lu) == 1",
+            (unsigned long)OS_mutex_table[1].take_count);
+
+    /* give from another task is ignored */
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 0x10002);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(1), OS_SUCCESS);
+    UtAssert_True(OS_mutex_table[1].nest_depth == 2, "nest_depth (%lu) == 2",
+            (unsigned long)OS_mutex_table[1].nest_depth);
+
+    /* release after 2.5ms counts as a long hold */
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 0x10001);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(1), OS_SUCCESS);
+    timeval[0].seconds = 0;
+    timeval[0].microsecs = 2500;
+    UT_SetDataBuffer(UT_KEY(OS_GetMonotonicTime_Impl), timeval, sizeof(timeval[0]), false);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(1), OS_SUCCESS);
+    UtAssert_True(OS_mutex_table[1].nest_depth == 0, "nest_depth (%lu) == 0",
+            (unsigned long)OS_mutex_table[1].nest_depth);
+    UtAssert_True(OS_mutex_table[1].max_hold_usec == 2500, "max_hold_usec (%lu) == 2500",
+            (unsigned long)OS_mutex_table[1].max_hold_usec);
+    UtAssert_True(OS_mutex_table[1].long_hold_count == 1, "long_hold_count (%lu) == 1",
+            (unsigned long)OS_mutex_table[1].long_hold_count);
+    UT_ResetState(UT_KEY(OS_GetMonotonicTime_Impl));
+
+    /*
+     * Higher priority task blocked 2 seconds behind a lower priority owner
+     */
+    OS_mutex_table[1].owner = 0x10003;
+    OS_mutex_table[1].nest_depth = 1;
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 0x10001);
+    timeval[0].seconds = 10;
+    timeval[0].microsecs = 500000;
+    timeval[1].seconds = 12;
+    timeval[1].microsecs = 400000;
+    UT_SetDataBuffer(UT_KEY(OS_GetMonotonicTime_Impl), timeval, sizeof(timeval), false);
+    memset(task_prop, 0, sizeof(task_prop));
+    task_prop[0].priority = 10;
+    task_prop[1].priority = 200;
+    UT_SetDataBuffer(UT_KEY(OS_TaskGetInfo), task_prop, sizeof(task_prop), false);
+    UT_SetHookFunction(UT_KEY(OS_MutSemTake_Impl), UT_MutexReleaseHook, NULL);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(1), OS_SUCCESS);
+    UT_SetHookFunction(UT_KEY(OS_MutSemTake_Impl), NULL, NULL);
+    UtAssert_True(OS_mutex_table[1].contention_count == 1, "contention_count (%lu) == 1",
+            (unsigned long)OS_mutex_table[1].contention_count);
+    UtAssert_True(OS_mutex_table[1].inversion_count == 1, "inversion_count (%lu) == 1",
+            (unsigned long)OS_mutex_table[1].inversion_count);
+    UtAssert_True(OS_mutex_table[1].max_wait_usec == 1900000, "max_wait_usec (%lu) == 1900000",
+            (unsigned long)OS_mutex_table[1].max_wait_usec);
+    UT_ResetState(UT_KEY(OS_GetMonotonicTime_Impl));
+    UtAssert_True(OS_mutex_table[1].owner == 0x10001, "owner (%lx) == 0x10001",
+            (unsigned long)OS_mutex_table[1].owner);
+
+    /* GetInfo reports the statistics and the current owner */
+    memset(&utrec, 0, sizeof(utrec));
+    utrec.name_entry = "ABC";
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &rptr, sizeof(rptr), false);
+    memset(&prop, 0, sizeof(prop));
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGetInfo(1, &prop), OS_SUCCESS);
+    UtAssert_True(prop.owner == 0x10001, "prop.owner (%lx) == 0x10001", (unsigned long)prop.owner);
+    UtAssert_True(prop.take_count == 2, "prop.take_count (%lu) == 2", (unsigned long)prop.take_count);
+    UtAssert_True(prop.inversion_count == 1, "prop.inversion_count (%lu) == 1",
+            (unsigned long)prop.inversion_count);
+
+    /* clock failures must not break the lock itself */
+    UT_SetForceFail(UT_KEY(OS_GetMonotonicTime_Impl), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(1), OS_SUCCESS);
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &rptr, sizeof(rptr), false);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGetInfo(1, &prop), OS_SUCCESS);
+}
+#endif
+
+#ifdef OS_MUTEX_LOCKDEP
+void Test_OS_MutSemLockDep(void)
+{
+    /*
+     * Test Case For:
+     * Lock order validation within OS_MutSemTake/OS_MutSemGive
+     */
+    OS_mut_sem_prop_t prop;
+    uint32 local_index = 2;
+    uint32 i;
+    OS_common_record_t utrec;
+    OS_common_record_t *rptr = &utrec;
+
+    OS_MutexAPI_Init();
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 0x10001);
+
+    /* establish the order 1 -> 2 */
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(2), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(2), OS_SUCCESS);
+
+    /* same order again, and a recursive take, are fine */
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(2), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(2), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(1), OS_SUCCESS);
+    UtAssert_True(OS_mutex_table[2].lock_order_violations == 0, "lock_order_violations (%lu) == 0",
+            (unsigned long)OS_mutex_table[2].lock_order_violations);
+
+    /* indirect inversion: 2 -> 3 then 3 -> 1 closes the cycle 1 -> 2 -> 3 -> 1 */
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(2), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(3), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(3), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(2), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(3), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(3), OS_SUCCESS);
+    UtAssert_True(OS_mutex_table[1].lock_order_violations == 1, "lock_order_violations (%lu) == 1",
+            (unsigned long)OS_mutex_table[1].lock_order_violations);
+
+    /* direct inversion 2 -> 1 is reported once, however often it happens */
+    for (i = 0; i < 2; ++i)
+    {
+        OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(2), OS_SUCCESS);
+        OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(1), OS_SUCCESS);
+        OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(2), OS_SUCCESS);
+        OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(1), OS_SUCCESS);
+    }
+    UtAssert_True(OS_mutex_table[1].lock_order_violations == 2, "lock_order_violations (%lu) == 2",
+            (unsigned long)OS_mutex_table[1].lock_order_violations);
+
+    memset(&utrec, 0, sizeof(utrec));
+    utrec.name_entry = "ABC";
+    local_index = 1;
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &rptr, sizeof(rptr), false);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGetInfo(1, &prop), OS_SUCCESS);
+    UtAssert_True(prop.lock_order_violations == 2, "prop.lock_order_violations (%lu) == 2",
+            (unsigned long)prop.lock_order_violations);
+
+    /* nesting deeper than the tracked limit stays balanced */
+    for (i = 0; i <= OS_MUTEX_LOCKDEP_MAX_HELD; ++i)
+    {
+        OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(4 + (i % 2)), OS_SUCCESS);
+    }
+    for (i = 0; i <= OS_MUTEX_LOCKDEP_MAX_HELD; ++i)
+    {
+        OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(4 + (i % 2)), OS_SUCCESS);
+    }
+
+    /* give of a mutex that is not held, and calls from outside any task, are ignored */
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(3), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(3), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(4), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(3), OS_SUCCESS);
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 0);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(2), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(2), OS_SUCCESS);
+
+    /* re-creating a mutex forgets its ordering */
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 0x10001);
+    local_index = 1;
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdAllocateNew), &local_index, sizeof(local_index), false);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemCreate(&i, "UT", 0), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(2), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemTake(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(1), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_MutSemGive(2), OS_SUCCESS);
+    UtAssert_True(OS_mutex_table[1].lock_order_violations == 0, "lock_order_violations (%lu) == 0",
+            (unsigned long)OS_mutex_table[1].lock_order_violations);
+}
+#endif
+
 
 
 /* Osapi_Task_Setup
@@ -188,6 +392,12 @@ void OS_Application_Startup(void)
     ADD_TEST(OS_MutSemTake);
     ADD_TEST(OS_MutSemGetIdByName);
     ADD_TEST(OS_MutSemGetInfo);
+#ifdef OS_MUTEX_DIAGNOSTICS
+    ADD_TEST(OS_MutSemDiagnostics);
+#endif
+#ifdef OS_MUTEX_LOCKDEP
+    ADD_TEST(OS_MutSemLockDep);
+#endif
 }
 
 
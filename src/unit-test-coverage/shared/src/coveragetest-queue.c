@@ -89,6 +89,17 @@ void Test_OS_QueueGet(void)
 
     UtAssert_True(actual == expected, "OS_QueueGet() (%ld) == OS_SUCCESS", (long)actual);
 
+    /* from a fiber, the queue is polled until the retry reports the timeout */
+    UT_SetForceFail(UT_KEY(OS_FiberWaitStart), true);
+    UT_SetDeferredRetcode(UT_KEY(OS_FiberWaitRetry), 1, true);
+    UT_SetForceFail(UT_KEY(OS_QueueGet_Impl), OS_QUEUE_EMPTY);
+    expected = OS_QUEUE_TIMEOUT;
+    actual = OS_QueueGet(1, Buf, sizeof(Buf), &actual_size, 10);
+    UtAssert_True(actual == expected, "OS_QueueGet() (%ld) == OS_QUEUE_TIMEOUT", (long)actual);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_QueueGet_Impl)) == 3, "OS_QueueGet_Impl() polled twice");
+    UT_ClearForceFail(UT_KEY(OS_QueueGet_Impl));
+    UT_ClearForceFail(UT_KEY(OS_FiberWaitStart));
+
     /* test error cases */
     expected = OS_INVALID_POINTER;
     actual = OS_QueueGet(1, NULL, sizeof(Buf), &actual_size, 0);
@@ -100,6 +111,36 @@ void Test_OS_QueueGet(void)
     UtAssert_True(actual == expected, "OS_QueueGet() (%ld) == OS_QUEUE_INVALID_SIZE", (long)actual);
 }
 
+void Test_OS_QueueGetMicros(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_QueueGetMicros (uint32 queue_id, void *data, uint32 size, uint32 *size_copied, int32 timeout_usec)
+     */
+    uint32 actual_size;
+    char Buf[4];
+
+    OS_queue_table[1].max_size = sizeof(Buf);
+    OSAPI_TEST_FUNCTION_RC(OS_QueueGetMicros(1, Buf, sizeof(Buf), &actual_size, 250), OS_SUCCESS);
+
+    UT_SetForceFail(UT_KEY(OS_QueueGetMicros_Impl), OS_QUEUE_TIMEOUT);
+    OSAPI_TEST_FUNCTION_RC(OS_QueueGetMicros(1, Buf, sizeof(Buf), &actual_size, 250), OS_QUEUE_TIMEOUT);
+    UT_ClearForceFail(UT_KEY(OS_QueueGetMicros_Impl));
+
+    UT_SetForceFail(UT_KEY(OS_FiberWaitStart), true);
+    OSAPI_TEST_FUNCTION_RC(OS_QueueGetMicros(1, Buf, sizeof(Buf), &actual_size, 250), OS_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_QueueGetMicros_Impl)) == 2, "OS_QueueGetMicros_Impl() not called from fiber");
+    UT_ClearForceFail(UT_KEY(OS_FiberWaitStart));
+
+    /* test error cases */
+    OSAPI_TEST_FUNCTION_RC(OS_QueueGetMicros(1, NULL, sizeof(Buf), &actual_size, 250), OS_INVALID_POINTER);
+    OSAPI_TEST_FUNCTION_RC(OS_QueueGetMicros(1, Buf, sizeof(Buf), NULL, 250), OS_INVALID_POINTER);
+
+    OS_queue_table[1].max_size = sizeof(Buf) + 10;
+    OSAPI_TEST_FUNCTION_RC(OS_QueueGetMicros(1, Buf, sizeof(Buf), &actual_size, 250), OS_QUEUE_INVALID_SIZE);
+    UtAssert_True(actual_size == 0, "OS_QueueGetMicros() size_copied (%lu) == 0", (unsigned long)actual_size);
+}
+
 
 void Test_OS_QueuePut(void)
 {
@@ -213,6 +254,7 @@ void OS_Application_Startup(void)
     ADD_TEST(OS_QueueCreate);
     ADD_TEST(OS_QueueDelete);
     ADD_TEST(OS_QueueGet);
+    ADD_TEST(OS_QueueGetMicros);
     ADD_TEST(OS_QueuePut);
     ADD_TEST(OS_QueueGetIdByName);
     ADD_TEST(OS_QueueGetInfo);
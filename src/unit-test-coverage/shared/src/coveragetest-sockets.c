@@ -174,6 +174,16 @@ void Test_OS_SocketAccept(void)
     actual = OS_SocketAccept(1, &connsock_id, &Addr, 0);
     UtAssert_True(actual == expected, "OS_SocketAccept() already bound (%ld) == OS_ERR_INCORRECT_OBJ_STATE", (long)actual);
 
+    /*
+     * A fiber waits for the connection through the fiber scheduler
+     */
+    OS_stream_table[1].stream_state = OS_STREAM_STATE_BOUND;
+    UT_SetForceFail(UT_KEY(OS_FiberWaitStream), true);
+    expected = OS_SUCCESS;
+    actual = OS_SocketAccept(1, &connsock_id, &Addr, 100);
+    UtAssert_True(actual == expected, "OS_SocketAccept() from fiber (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_FiberWaitStream)) == 1, "OS_FiberWaitStream() called");
+
     /*
      * Underlying implementation failure test
      */
@@ -282,6 +292,16 @@ void Test_OS_SocketRecvFrom(void)
     expected = OS_ERR_INCORRECT_OBJ_STATE;
     actual = OS_SocketRecvFrom(1, &Buf, 1, &Addr, 0);
     UtAssert_True(actual == expected, "OS_SocketRecvFrom() non-bound (%ld) == OS_ERR_INCORRECT_OBJ_STATE", (long)actual);
+
+    /*
+     * A fiber waits for the data through the fiber scheduler
+     */
+    OS_stream_table[1].stream_state = OS_STREAM_STATE_BOUND;
+    UT_SetForceFail(UT_KEY(OS_FiberWaitStream), true);
+    expected = OS_SUCCESS;
+    actual = OS_SocketRecvFrom(1, &Buf, 1, &Addr, 100);
+    UtAssert_True(actual == expected, "OS_SocketRecvFrom() from fiber (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_FiberWaitStream)) == 1, "OS_FiberWaitStream() called");
 }
 
 /*****************************************************************************
@@ -24,6 +24,13 @@ static void UT_TestHook(void)
     ++UT_TestHook_Count;
 }
 
+static uint32 UT_TestDestructor_Count = 0;
+
+static void UT_TestDestructor(void *value)
+{
+    ++UT_TestDestructor_Count;
+}
+
 /*
 **********************************************************************************
 **          INTERNAL API TEST CASES
@@ -112,6 +119,28 @@ void Test_OS_TaskCreate(void)
     OSAPI_TEST_FUNCTION_RC(OS_TaskCreate(&objid, "UT", UT_TestHook, NULL, 0, 0,0), OS_ERR_NAME_TOO_LONG);
 }
 
+void Test_OS_TaskCreateAffinity(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TaskCreateAffinity (uint32 *task_id, const char *task_name, osal_task_entry function_pointer,
+     *                uint32 *stack_pointer, uint32 stack_size, uint32 priority, uint32 flags, uint32 cpu_mask)
+     */
+    uint32 objid = 0xFFFFFFFF;
+    uint32 local_index = 1;
+
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdAllocateNew), &local_index, sizeof(local_index), false);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskCreateAffinity(&objid, "UT", UT_TestHook, NULL, 0, 0, 0, 0x5), OS_SUCCESS);
+    UtAssert_True(objid != 0, "objid (%lu) != 0", (unsigned long)objid);
+    UtAssert_True(OS_task_table[1].cpu_mask == 0x5, "OS_task_table[1].cpu_mask (%lx) == 0x5",
+            (unsigned long)OS_task_table[1].cpu_mask);
+
+    UT_SetForceFail(UT_KEY(OS_TaskCreate_Impl), OS_ERR_NOT_IMPLEMENTED);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskCreateAffinity(&objid, "UT", UT_TestHook, NULL, 0, 0, 0, 0x5), OS_ERR_NOT_IMPLEMENTED);
+
+    memset(&OS_task_table[1], 0, sizeof(OS_task_table[1]));
+}
+
 void Test_OS_TaskDelete(void)
 {
     /*
@@ -168,6 +197,112 @@ void Test_OS_TaskDelay(void)
     int32 actual = OS_TaskDelay(1);
 
     UtAssert_True(actual == expected, "OS_TaskDelay() (%ld) == OS_SUCCESS", (long)actual);
+
+    /* a fiber sleeps without blocking its task */
+    UT_SetForceFail(UT_KEY(OS_FiberSleep), true);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskDelay(1), OS_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TaskDelay_Impl)) == 1, "OS_TaskDelay_Impl() not called from fiber");
+}
+void Test_OS_TaskDelayMicros(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TaskDelayMicros(uint32 microsecond)
+     */
+    OSAPI_TEST_FUNCTION_RC(OS_TaskDelayMicros(250), OS_SUCCESS);
+
+    UT_SetForceFail(UT_KEY(OS_TaskDelayMicros_Impl), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskDelayMicros(250), OS_ERROR);
+
+    UT_SetForceFail(UT_KEY(OS_FiberSleep), true);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskDelayMicros(250), OS_SUCCESS);
+}
+void Test_OS_TaskSetPeriod(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TaskSetPeriod(uint32 period_usec)
+     */
+    OS_time_t now;
+
+    now.seconds = 10;
+    now.microsecs = 999000;
+    UT_SetDataBuffer(UT_KEY(OS_GetMonotonicTime_Impl), &now, sizeof(now), false);
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 1);
+    OS_task_table[1].period_cycles = 5;
+    OS_task_table[1].period_overruns = 5;
+
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetPeriod(2000), OS_SUCCESS);
+    UtAssert_True(OS_task_table[1].period_usec == 2000, "period_usec (%lu) == 2000",
+            (unsigned long)OS_task_table[1].period_usec);
+    UtAssert_True(OS_task_table[1].next_release.seconds == 11 &&
+            OS_task_table[1].next_release.microsecs == 1000, "next_release (%lu.%06lu) == 11.001000",
+            (unsigned long)OS_task_table[1].next_release.seconds,
+            (unsigned long)OS_task_table[1].next_release.microsecs);
+    UtAssert_True(OS_task_table[1].period_cycles == 0, "period_cycles reset");
+    UtAssert_True(OS_task_table[1].period_overruns == 0, "period_overruns reset");
+
+    UT_SetForceFail(UT_KEY(OS_GetMonotonicTime_Impl), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetPeriod(2000), OS_ERROR);
+
+    memset(&OS_task_table[1], 0, sizeof(OS_task_table[1]));
+}
+void Test_OS_TaskWaitPeriod(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TaskWaitPeriod(uint32 *overruns)
+     */
+    OS_time_t now;
+    uint32 overruns;
+
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 1);
+    memset(&OS_task_table[1], 0, sizeof(OS_task_table[1]));
+
+    /* Not periodic */
+    overruns = 99;
+    OSAPI_TEST_FUNCTION_RC(OS_TaskWaitPeriod(&overruns), OS_ERR_INCORRECT_OBJ_STATE);
+    UtAssert_True(overruns == 0, "overruns (%lu) == 0", (unsigned long)overruns);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TaskDelayUntil_Impl)) == 0, "OS_TaskDelayUntil_Impl not called");
+
+    /* On time: sleeps until the release point, which then advances one period */
+    OS_task_table[1].period_usec = 1000;
+    OS_task_table[1].next_release.seconds = 5;
+    OS_task_table[1].next_release.microsecs = 999500;
+    now.seconds = 5;
+    now.microsecs = 999000;
+    UT_SetDataBuffer(UT_KEY(OS_GetMonotonicTime_Impl), &now, sizeof(now), false);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskWaitPeriod(&overruns), OS_SUCCESS);
+    UtAssert_True(overruns == 0, "overruns (%lu) == 0", (unsigned long)overruns);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TaskDelayUntil_Impl)) == 1, "OS_TaskDelayUntil_Impl called");
+    UtAssert_True(OS_task_table[1].next_release.seconds == 6 &&
+            OS_task_table[1].next_release.microsecs == 500, "next_release (%lu.%06lu) == 6.000500",
+            (unsigned long)OS_task_table[1].next_release.seconds,
+            (unsigned long)OS_task_table[1].next_release.microsecs);
+    UtAssert_True(OS_task_table[1].period_cycles == 1, "period_cycles (%lu) == 1",
+            (unsigned long)OS_task_table[1].period_cycles);
+
+    /* Overrun by 2.5 periods: three release points missed, no sleep, stays phase aligned */
+    now.seconds = 6;
+    now.microsecs = 3000;
+    UT_SetDataBuffer(UT_KEY(OS_GetMonotonicTime_Impl), &now, sizeof(now), false);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskWaitPeriod(&overruns), OS_SUCCESS);
+    UtAssert_True(overruns == 3, "overruns (%lu) == 3", (unsigned long)overruns);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TaskDelayUntil_Impl)) == 1, "OS_TaskDelayUntil_Impl not called again");
+    UtAssert_True(OS_task_table[1].next_release.seconds == 6 &&
+            OS_task_table[1].next_release.microsecs == 3500, "next_release (%lu.%06lu) == 6.003500",
+            (unsigned long)OS_task_table[1].next_release.seconds,
+            (unsigned long)OS_task_table[1].next_release.microsecs);
+    UtAssert_True(OS_task_table[1].period_overruns == 3, "period_overruns (%lu) == 3",
+            (unsigned long)OS_task_table[1].period_overruns);
+
+    /* NULL overruns pointer is allowed */
+    OSAPI_TEST_FUNCTION_RC(OS_TaskWaitPeriod(NULL), OS_SUCCESS);
+
+    UT_SetForceFail(UT_KEY(OS_GetMonotonicTime_Impl), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskWaitPeriod(&overruns), OS_ERROR);
+
+    memset(&OS_task_table[1], 0, sizeof(OS_task_table[1]));
 }
 void Test_OS_TaskSetPriority(void)
 {
@@ -182,6 +317,75 @@ void Test_OS_TaskSetPriority(void)
 
     OSAPI_TEST_FUNCTION_RC(OS_TaskSetPriority(1, 10 + OS_MAX_TASK_PRIORITY), OS_ERR_INVALID_PRIORITY);
 }
+void Test_OS_TaskSetAffinity(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TaskSetAffinity (uint32 task_id, uint32 cpu_mask)
+     */
+    OS_task_table[1].cpu_mask = 0;
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetAffinity(1, 0x3), OS_SUCCESS);
+    UtAssert_True(OS_task_table[1].cpu_mask == 0x3, "OS_task_table[1].cpu_mask (%lx) == 0x3",
+            (unsigned long)OS_task_table[1].cpu_mask);
+
+    /* A mask rejected by the OS is not recorded */
+    UT_SetForceFail(UT_KEY(OS_TaskSetAffinity_Impl), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetAffinity(1, 0x4), OS_ERROR);
+    UtAssert_True(OS_task_table[1].cpu_mask == 0x3, "OS_task_table[1].cpu_mask (%lx) == 0x3",
+            (unsigned long)OS_task_table[1].cpu_mask);
+    UT_ClearForceFail(UT_KEY(OS_TaskSetAffinity_Impl));
+
+    UT_SetForceFail(UT_KEY(OS_ObjectIdGetById), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetAffinity(1, 0x4), OS_ERR_INVALID_ID);
+
+    OS_task_table[1].cpu_mask = 0;
+}
+void Test_OS_TaskSetDeadline(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TaskSetDeadline (uint32 task_id, uint32 runtime_usec, uint32 deadline_usec, uint32 period_usec)
+     */
+
+    /* A zero deadline defaults to the period */
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetDeadline(1, 100, 0, 1000), OS_SUCCESS);
+    UtAssert_True(OS_task_table[1].deadline_runtime_usec == 100 &&
+            OS_task_table[1].deadline_usec == 1000 &&
+            OS_task_table[1].deadline_period_usec == 1000,
+            "OS_task_table[1] deadline (%lu/%lu/%lu) == 100/1000/1000",
+            (unsigned long)OS_task_table[1].deadline_runtime_usec,
+            (unsigned long)OS_task_table[1].deadline_usec,
+            (unsigned long)OS_task_table[1].deadline_period_usec);
+
+    /* A zero period defaults to the deadline */
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetDeadline(1, 100, 500, 0), OS_SUCCESS);
+    UtAssert_True(OS_task_table[1].deadline_period_usec == 500,
+            "OS_task_table[1].deadline_period_usec (%lu) == 500",
+            (unsigned long)OS_task_table[1].deadline_period_usec);
+
+    /* Inconsistent times */
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetDeadline(1, 100, 0, 0), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetDeadline(1, 600, 500, 1000), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetDeadline(1, 100, 1000, 500), OS_ERROR);
+
+    /* A reservation rejected by the OS is not recorded */
+    UT_SetForceFail(UT_KEY(OS_TaskSetDeadline_Impl), OS_ERR_NOT_IMPLEMENTED);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetDeadline(1, 200, 1000, 1000), OS_ERR_NOT_IMPLEMENTED);
+    UtAssert_True(OS_task_table[1].deadline_runtime_usec == 100,
+            "OS_task_table[1].deadline_runtime_usec (%lu) == 100",
+            (unsigned long)OS_task_table[1].deadline_runtime_usec);
+    UT_ClearForceFail(UT_KEY(OS_TaskSetDeadline_Impl));
+
+    /* A zero runtime disables, ignoring the other times */
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetDeadline(1, 0, 1, 0), OS_SUCCESS);
+    UtAssert_True(OS_task_table[1].deadline_runtime_usec == 0 &&
+            OS_task_table[1].deadline_usec == 0 &&
+            OS_task_table[1].deadline_period_usec == 0,
+            "OS_task_table[1] deadline cleared");
+
+    UT_SetForceFail(UT_KEY(OS_ObjectIdGetById), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskSetDeadline(1, 100, 1000, 1000), OS_ERR_INVALID_ID);
+}
 void Test_OS_TaskRegister(void)
 {
     /*
@@ -199,11 +403,23 @@ void Test_OS_TaskGetId(void)
      * Test Case For:
      * uint32 OS_TaskGetId (void)
      */
-    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 5555);
-    OSAPI_TEST_FUNCTION_RC(OS_TaskGetId(), 5555);
+    uint32 local_index = 1;
+
+    OS_global_task_table[1].active_id = 0x10001;
+    UT_SetForceFail(UT_KEY(OS_TaskGetSelf_Impl), 0x10001);
+    UT_SetDataBuffer(UT_KEY(OS_TaskGetSelf_Impl), &local_index, sizeof(local_index), false);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskGetId(), 0x10001);
+
+    /* The table entry was reused by a different task */
+    OS_global_task_table[1].active_id = 0x10002;
+    UT_SetDataBuffer(UT_KEY(OS_TaskGetSelf_Impl), &local_index, sizeof(local_index), false);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskGetId(), 0);
 
-    UT_SetForceFail(UT_KEY(OS_ObjectIdGetById), OS_ERROR);
+    /* Not called from an OSAL task */
+    UT_SetForceFail(UT_KEY(OS_TaskGetSelf_Impl), 0);
     OSAPI_TEST_FUNCTION_RC(OS_TaskGetId(), 0);
+
+    OS_global_task_table[1].active_id = 0;
 }
 
 void Test_OS_TaskGetIdByName(void)
@@ -248,6 +464,11 @@ void Test_OS_TaskGetInfo(void)
     utrec.name_entry = "ABC";
     OS_task_table[1].stack_size = 222;
     OS_task_table[1].priority = 333;
+    OS_task_table[1].cpu_mask = 0x77;
+    OS_task_table[1].period_usec = 444;
+    OS_task_table[1].period_cycles = 555;
+    OS_task_table[1].period_overruns = 666;
+    OS_task_table[1].deadline_runtime_usec = 777;
     UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
     UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &rptr, sizeof(rptr), false);
     actual = OS_TaskGetInfo(1, &task_prop);
@@ -261,13 +482,202 @@ void Test_OS_TaskGetInfo(void)
             (unsigned long)task_prop.stack_size);
     UtAssert_True(task_prop.priority == 333, "task_prop.priority (%lu) == 333",
             (unsigned long)task_prop.priority);
-
-    OS_task_table[1].stack_size = 0;
-    OS_task_table[1].priority = 0;
+    UtAssert_True(task_prop.cpu_mask == 0x77, "task_prop.cpu_mask (%lx) == 0x77",
+            (unsigned long)task_prop.cpu_mask);
+    UtAssert_True(task_prop.period_usec == 444, "task_prop.period_usec (%lu) == 444",
+            (unsigned long)task_prop.period_usec);
+    UtAssert_True(task_prop.period_cycles == 555, "task_prop.period_cycles (%lu) == 555",
+            (unsigned long)task_prop.period_cycles);
+    UtAssert_True(task_prop.period_overruns == 666, "task_prop.period_overruns (%lu) == 666",
+            (unsigned long)task_prop.period_overruns);
+    UtAssert_True(task_prop.deadline_runtime_usec == 777, "task_prop.deadline_runtime_usec (%lu) == 777",
+            (unsigned long)task_prop.deadline_runtime_usec);
+
+    memset(&OS_task_table[1], 0, sizeof(OS_task_table[1]));
 
     OSAPI_TEST_FUNCTION_RC(OS_TaskGetInfo(0, NULL), OS_INVALID_POINTER);
 }
 
+void Test_OS_TaskGetStats(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TaskGetStats (uint32 task_id, OS_task_stats_t *task_stats)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+    OS_task_stats_t task_stats;
+    uint32 local_index = 1;
+    uint32 os_thread_id = 1234;
+    OS_common_record_t utrec;
+    OS_common_record_t *rptr = &utrec;
+
+    memset(&utrec, 0, sizeof(utrec));
+    utrec.active_id = 0x10001;
+    utrec.name_entry = "ABC";
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &rptr, sizeof(rptr), false);
+    actual = OS_TaskGetStats(1, &task_stats);
+
+    UtAssert_True(actual == expected, "OS_TaskGetStats() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(task_stats.task_id == 0x10001, "task_stats.task_id (%lx) == 0x10001",
+            (unsigned long)task_stats.task_id);
+    UtAssert_True(strcmp(task_stats.name, "ABC") == 0, "task_stats.name (%s) == ABC",
+            task_stats.name);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TaskGetStats_Impl)) == 1, "OS_TaskGetStats_Impl() called");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TaskGetThreadStats_Impl)) == 0, "OS_TaskGetThreadStats_Impl() not called");
+
+    /* With a thread ID, the thread statistics are read as well */
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &rptr, sizeof(rptr), false);
+    UT_SetDataBuffer(UT_KEY(OS_TaskGetStats_Impl), &os_thread_id, sizeof(os_thread_id), false);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskGetStats(1, &task_stats), OS_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TaskGetThreadStats_Impl)) == 1, "OS_TaskGetThreadStats_Impl() called");
+
+    UT_SetForceFail(UT_KEY(OS_TaskGetStats_Impl), OS_ERR_NOT_IMPLEMENTED);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskGetStats(1, &task_stats), OS_ERR_NOT_IMPLEMENTED);
+    UT_ClearForceFail(UT_KEY(OS_TaskGetStats_Impl));
+
+    UT_SetForceFail(UT_KEY(OS_ObjectIdGetById), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskGetStats(1, &task_stats), OS_ERR_INVALID_ID);
+
+    OSAPI_TEST_FUNCTION_RC(OS_TaskGetStats(0, NULL), OS_INVALID_POINTER);
+}
+
+void Test_OS_TaskStatsSnapshot(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TaskStatsSnapshot (OS_task_stats_t *task_stats, uint32 max_entries, uint32 *num_entries)
+     */
+    OS_task_stats_t task_stats[3];
+    uint32 num_entries;
+    uint32 os_thread_id = 1234;
+
+    memset(OS_global_task_table, 0, sizeof(OS_common_record_t) * OS_MAX_TASKS);
+    OS_global_task_table[1].active_id = 0x10001;
+    OS_global_task_table[1].name_entry = "ABC";
+    OS_global_task_table[2].active_id = 0x10002;
+    OS_global_task_table[4].active_id = 0x10004;
+
+    /* Every active task is reported, in table order */
+    OSAPI_TEST_FUNCTION_RC(OS_TaskStatsSnapshot(task_stats, 3, &num_entries), OS_SUCCESS);
+    UtAssert_True(num_entries == 3, "num_entries (%lu) == 3", (unsigned long)num_entries);
+    UtAssert_True(task_stats[0].task_id == 0x10001, "task_stats[0].task_id (%lx) == 0x10001",
+            (unsigned long)task_stats[0].task_id);
+    UtAssert_True(strcmp(task_stats[0].name, "ABC") == 0, "task_stats[0].name (%s) == ABC",
+            task_stats[0].name);
+    UtAssert_True(task_stats[2].task_id == 0x10004, "task_stats[2].task_id (%lx) == 0x10004",
+            (unsigned long)task_stats[2].task_id);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TaskGetThreadStats_Impl)) == 0, "OS_TaskGetThreadStats_Impl() not called");
+
+    /* Thread statistics are only read for tasks with a thread ID */
+    UT_SetDataBuffer(UT_KEY(OS_TaskGetStats_Impl), &os_thread_id, sizeof(os_thread_id), false);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskStatsSnapshot(task_stats, 3, &num_entries), OS_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TaskGetThreadStats_Impl)) == 1, "OS_TaskGetThreadStats_Impl() called");
+
+    /* Output is limited to the size of the buffer */
+    OSAPI_TEST_FUNCTION_RC(OS_TaskStatsSnapshot(task_stats, 2, &num_entries), OS_SUCCESS);
+    UtAssert_True(num_entries == 2, "num_entries (%lu) == 2", (unsigned long)num_entries);
+
+    /* A task that cannot be queried is still reported */
+    UT_SetDeferredRetcode(UT_KEY(OS_TaskGetStats_Impl), 1, OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskStatsSnapshot(task_stats, 3, &num_entries), OS_SUCCESS);
+    UtAssert_True(num_entries == 3, "num_entries (%lu) == 3", (unsigned long)num_entries);
+
+    /* No OS support fails the whole snapshot */
+    UT_SetForceFail(UT_KEY(OS_TaskGetStats_Impl), OS_ERR_NOT_IMPLEMENTED);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskStatsSnapshot(task_stats, 3, &num_entries), OS_ERR_NOT_IMPLEMENTED);
+    UtAssert_True(num_entries == 0, "num_entries (%lu) == 0", (unsigned long)num_entries);
+
+    OSAPI_TEST_FUNCTION_RC(OS_TaskStatsSnapshot(NULL, 3, &num_entries), OS_INVALID_POINTER);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskStatsSnapshot(task_stats, 3, NULL), OS_INVALID_POINTER);
+
+    memset(OS_global_task_table, 0, sizeof(OS_common_record_t) * OS_MAX_TASKS);
+}
+
+void Test_OS_TaskGetStackPoolStats(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TaskGetStackPoolStats (OS_stack_pool_stats_t *stats)
+     */
+    OS_stack_pool_stats_t stats;
+
+    OSAPI_TEST_FUNCTION_RC(OS_TaskGetStackPoolStats(NULL), OS_INVALID_POINTER);
+
+    memset(&stats, 0xFF, sizeof(stats));
+    OSAPI_TEST_FUNCTION_RC(OS_TaskGetStackPoolStats(&stats), OS_SUCCESS);
+    UtAssert_True(stats.hits == 0 && stats.misses == 0, "Stats cleared before OS_TaskGetStackPoolStats_Impl()");
+
+    UT_SetForceFail(UT_KEY(OS_TaskGetStackPoolStats_Impl), OS_ERR_NOT_IMPLEMENTED);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskGetStackPoolStats(&stats), OS_ERR_NOT_IMPLEMENTED);
+}
+
+void Test_OS_TaskLocalStorage(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TaskKeyCreate (uint32 *key, OS_TaskKeyDestructor_t destructor)
+     * int32 OS_TaskKeySet (uint32 key, void *value)
+     * int32 OS_TaskKeyGet (uint32 key, void **value)
+     */
+    uint32 key[OS_MAX_TASK_KEYS];
+    uint32 extra_key;
+    uint32 local_index = 1;
+    uint32 i;
+    void *value;
+    int32 marker;
+
+    OS_TaskAPI_Init();
+
+    OSAPI_TEST_FUNCTION_RC(OS_TaskKeyCreate(NULL, NULL), OS_INVALID_POINTER);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskKeyCreate(&key[0], UT_TestDestructor), OS_SUCCESS);
+    for (i = 1; i < OS_MAX_TASK_KEYS; ++i)
+    {
+        OSAPI_TEST_FUNCTION_RC(OS_TaskKeyCreate(&key[i], NULL), OS_SUCCESS);
+    }
+    OSAPI_TEST_FUNCTION_RC(OS_TaskKeyCreate(&extra_key, NULL), OS_ERR_NO_FREE_IDS);
+    UtAssert_True(key[1] != key[0], "keys (%lu, %lu) differ", (unsigned long)key[0], (unsigned long)key[1]);
+
+    /* Not called from an OSAL task */
+    OSAPI_TEST_FUNCTION_RC(OS_TaskKeySet(key[0], &marker), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskKeyGet(key[0], &value), OS_ERR_INVALID_ID);
+    UtAssert_True(value == NULL, "value (%p) == NULL", value);
+
+    /* Called from task 0x10001 at index 1 */
+    OS_global_task_table[1].active_id = 0x10001;
+    UT_SetForceFail(UT_KEY(OS_TaskGetSelf_Impl), 0x10001);
+    UT_SetDataBuffer(UT_KEY(OS_TaskGetSelf_Impl), &local_index, sizeof(local_index), false);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskKeySet(key[0], &marker), OS_SUCCESS);
+    UT_SetDataBuffer(UT_KEY(OS_TaskGetSelf_Impl), &local_index, sizeof(local_index), false);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskKeyGet(key[0], &value), OS_SUCCESS);
+    UtAssert_True(value == &marker, "value (%p) == %p", value, (void*)&marker);
+    UT_SetDataBuffer(UT_KEY(OS_TaskGetSelf_Impl), &local_index, sizeof(local_index), false);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskKeySet(key[1], &marker), OS_SUCCESS);
+
+    OSAPI_TEST_FUNCTION_RC(OS_TaskKeySet(OS_MAX_TASK_KEYS, &marker), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_TaskKeyGet(key[0], NULL), OS_INVALID_POINTER);
+
+    /* Deleting the task releases the value with a destructor, and only that one */
+    UT_TestDestructor_Count = 0;
+    OSAPI_TEST_FUNCTION_RC(OS_TaskDelete(1), OS_SUCCESS);
+    UtAssert_True(UT_TestDestructor_Count == 1, "UT_TestDestructor_Count (%lu) == 1",
+            (unsigned long)UT_TestDestructor_Count);
+    UtAssert_True(OS_task_table[1].local_values[key[0]] == NULL, "value cleared after delete");
+
+    /* Exiting does the same */
+    OS_task_table[1].local_values[key[0]] = &marker;
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 1);
+    OS_TaskExit();
+    UtAssert_True(UT_TestDestructor_Count == 2, "UT_TestDestructor_Count (%lu) == 2",
+            (unsigned long)UT_TestDestructor_Count);
+    UtAssert_True(OS_task_table[1].local_values[key[0]] == NULL, "value cleared after exit");
+
+    OS_global_task_table[1].active_id = 0;
+    OS_TaskAPI_Init();
+}
+
 void Test_OS_TaskInstallDeleteHandler(void)
 {
     /*
@@ -317,14 +727,24 @@ void OS_Application_Startup(void)
     ADD_TEST(OS_TaskAPI_Init);
     ADD_TEST(OS_TaskEntryPoint);
     ADD_TEST(OS_TaskCreate);
+    ADD_TEST(OS_TaskCreateAffinity);
     ADD_TEST(OS_TaskDelete);
     ADD_TEST(OS_TaskExit);
     ADD_TEST(OS_TaskDelay);
+    ADD_TEST(OS_TaskDelayMicros);
+    ADD_TEST(OS_TaskSetPeriod);
+    ADD_TEST(OS_TaskWaitPeriod);
     ADD_TEST(OS_TaskSetPriority);
+    ADD_TEST(OS_TaskSetAffinity);
+    ADD_TEST(OS_TaskSetDeadline);
     ADD_TEST(OS_TaskRegister);
     ADD_TEST(OS_TaskGetId);
     ADD_TEST(OS_TaskGetIdByName);
     ADD_TEST(OS_TaskGetInfo);
+    ADD_TEST(OS_TaskGetStats);
+    ADD_TEST(OS_TaskStatsSnapshot);
+    ADD_TEST(OS_TaskGetStackPoolStats);
+    ADD_TEST(OS_TaskLocalStorage);
     ADD_TEST(OS_TaskInstallDeleteHandler);
 }
 
@@ -29,6 +29,28 @@ void UT_TimerArgCallback(uint32 object_id, void *arg)
     ++UT_TimerArgCount;
 }
 
+void UT_TimerDeleteCallback(uint32 object_id, void *arg)
+{
+    ++UT_TimerArgCount;
+    OS_global_timecb_table[1].active_id = 0;
+}
+
+static int32 UT_CallbackReturnHook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    OS_timecb_table[1].dispatch_task = 0;
+    return StubRetcode;
+}
+
+static OS_WorkFunc_t UT_WorkFunc;
+static void *UT_WorkArg;
+
+static int32 UT_WorkSubmitHook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    UT_WorkFunc = *((const OS_WorkFunc_t *)Context->ArgPtr[0]);
+    UT_WorkArg = (void *)Context->ArgPtr[1];
+    return StubRetcode;
+}
+
 /*
 **********************************************************************************
 **          PUBLIC API FUNCTIONS
@@ -161,8 +183,25 @@ void Test_OS_TimerSet(void)
     UtAssert_True(actual == expected, "OS_TimerSet() (%ld) == OS_ERROR", (long)actual);
 
     expected = OS_SUCCESS;
-    actual = OS_TimerSet(1, 0, 1);
+    OS_timecb_table[1].timebase_ref = 0;
+    OS_timebase_table[0].wheel_time = 5000;
+    actual = OS_TimerSet(1, 100, 1);
     UtAssert_True(actual == expected, "OS_TimerSet() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(OS_timecb_table[1].expiry_time == 105000, "expiry_time (%lu) == 105000",
+            (unsigned long)OS_timecb_table[1].expiry_time);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimerWheelArm)) == 1, "OS_TimerSet() armed the timer");
+
+    /* on a tickless time base the skipped intervals count too */
+    OS_timebase_table[0].tickless = true;
+    UT_SetForceFail(UT_KEY(OS_TimeBaseSkippedTime_Impl), 3000);
+    actual = OS_TimerSet(1, 100, 1);
+    UtAssert_True(actual == expected, "OS_TimerSet() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(OS_timecb_table[1].expiry_time == 108000, "expiry_time (%lu) == 108000",
+            (unsigned long)OS_timecb_table[1].expiry_time);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimeBaseNextDue_Impl)) == 1, "OS_TimerSet() reprogrammed the time base");
+    UT_ClearForceFail(UT_KEY(OS_TimeBaseSkippedTime_Impl));
+    OS_timebase_table[0].tickless = false;
+    OS_timebase_table[0].wheel_time = 0;
 
     OS_timecb_table[2].timebase_ref = 0;
     OS_timecb_table[2].flags = TIMECB_FLAG_DEDICATED_TIMEBASE;
@@ -182,6 +221,259 @@ void Test_OS_TimerSet(void)
     UT_ClearForceFail(UT_KEY(OS_TaskGetId_Impl));
 }
 
+void Test_OS_TimerSetNs(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TimerSetNs(uint32 timer_id, uint64 start_time, uint64 interval_time)
+     */
+    int32 expected = OS_ERROR;
+    int32 actual = OS_TimerSetNs(1, 0, 0);
+    UtAssert_True(actual == expected, "OS_TimerSetNs() (%ld) == OS_ERROR", (long)actual);
+
+    /* sub-microsecond times are kept as they are */
+    expected = OS_SUCCESS;
+    memset(OS_timecb_table, 0, sizeof(OS_timecb_table));
+    OS_timecb_table[1].timebase_ref = 0;
+    OS_timebase_table[0].wheel_time = 5000;
+    actual = OS_TimerSetNs(1, 150, 250);
+    UtAssert_True(actual == expected, "OS_TimerSetNs() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(OS_timecb_table[1].expiry_time == 5150, "expiry_time (%lu) == 5150",
+            (unsigned long)OS_timecb_table[1].expiry_time);
+    UtAssert_True(OS_timecb_table[1].interval_time == 250, "interval_time (%ld) == 250",
+            (long)OS_timecb_table[1].interval_time);
+    OS_timebase_table[0].wheel_time = 0;
+
+    /* a dedicated time base is set in nanoseconds too */
+    OS_timecb_table[2].timebase_ref = 0;
+    OS_timecb_table[2].flags = TIMECB_FLAG_DEDICATED_TIMEBASE;
+    OS_global_timebase_table[0].active_id = 2;
+    actual = OS_TimerSetNs(2, 0, 1ULL << 40);
+    UtAssert_True(actual == expected, "OS_TimerSetNs() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimeBaseSetNs)) == 1, "OS_TimeBaseSetNs() called");
+    memset(OS_timecb_table, 0, sizeof(OS_timecb_table));
+
+    expected = OS_TIMER_ERR_INVALID_ARGS;
+    actual = OS_TimerSetNs(1, OS_TIMEBASE_NS_LIMIT, 1);
+    UtAssert_True(actual == expected, "OS_TimerSetNs() (%ld) == OS_TIMER_ERR_INVALID_ARGS", (long)actual);
+}
+
+
+void Test_OS_TimerSetBatchNs(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TimerSetBatchNs(const OS_timer_batch_t *batch, uint32 count, uint64 phase_step)
+     */
+    OS_timer_batch_t batch[3];
+    int32 expected;
+    int32 actual;
+
+    memset(batch, 0, sizeof(batch));
+    memset(OS_timecb_table, 0, sizeof(OS_timecb_table));
+    batch[0].timer_id = 1;
+    batch[1].timer_id = 2;
+    batch[2].timer_id = 3;
+    batch[0].start_time = 100;
+    batch[1].start_time = 100;
+    batch[2].start_time = 100;
+    batch[0].interval_time = 10;
+    batch[1].interval_time = 10;
+    batch[2].interval_time = 10;
+
+    /* timers 1 and 2 share a time base, timer 3 is on a tickless one */
+    OS_timecb_table[1].timebase_ref = 0;
+    OS_timecb_table[2].timebase_ref = 0;
+    OS_timecb_table[3].timebase_ref = 1;
+    OS_timebase_table[0].wheel_time = 5000;
+    OS_timebase_table[1].wheel_time = 7000;
+    OS_timebase_table[1].tickless = true;
+    UT_SetForceFail(UT_KEY(OS_TimeBaseSkippedTime_Impl), 3000);
+
+    expected = OS_SUCCESS;
+    actual = OS_TimerSetBatchNs(batch, 3, 50);
+    UtAssert_True(actual == expected, "OS_TimerSetBatchNs() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(OS_timecb_table[1].expiry_time == 5100, "expiry_time (%lu) == 5100",
+            (unsigned long)OS_timecb_table[1].expiry_time);
+    UtAssert_True(OS_timecb_table[2].expiry_time == 5150, "expiry_time (%lu) == 5150",
+            (unsigned long)OS_timecb_table[2].expiry_time);
+    UtAssert_True(OS_timecb_table[3].expiry_time == 10200, "expiry_time (%lu) == 10200",
+            (unsigned long)OS_timecb_table[3].expiry_time);
+    UtAssert_True(OS_timecb_table[3].interval_time == 10, "interval_time (%ld) == 10",
+            (long)OS_timecb_table[3].interval_time);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimerWheelArm)) == 3, "OS_TimerSetBatchNs() armed 3 timers");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimeBaseLock_Impl)) == 2, "OS_TimerSetBatchNs() locked 2 time bases");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimeBaseNextDue_Impl)) == 1, "OS_TimerSetBatchNs() reprogrammed the time base");
+    UT_ClearForceFail(UT_KEY(OS_TimeBaseSkippedTime_Impl));
+    OS_timebase_table[1].tickless = false;
+    OS_timebase_table[1].wheel_time = 0;
+    OS_timebase_table[0].wheel_time = 0;
+
+    /* an invalid ID leaves every timer alone */
+    UT_ResetState(UT_KEY(OS_TimerWheelArm));
+    UT_SetDeferredRetcode(UT_KEY(OS_ObjectIdGetById), 3, OS_ERR_INVALID_ID);
+    expected = OS_ERR_INVALID_ID;
+    actual = OS_TimerSetBatchNs(batch, 3, 0);
+    UtAssert_True(actual == expected, "OS_TimerSetBatchNs() (%ld) == OS_ERR_INVALID_ID", (long)actual);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimerWheelArm)) == 0, "OS_TimerSetBatchNs() armed no timer");
+
+    /* a dedicated time base is set afterwards */
+    OS_timecb_table[2].flags = TIMECB_FLAG_DEDICATED_TIMEBASE;
+    OS_global_timebase_table[0].active_id = 2;
+    expected = OS_SUCCESS;
+    actual = OS_TimerSetBatchNs(batch, 3, 0);
+    UtAssert_True(actual == expected, "OS_TimerSetBatchNs() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimeBaseSetNs)) == 1, "OS_TimeBaseSetNs() called");
+
+    UT_SetForceFail(UT_KEY(OS_TimeBaseSetNs), OS_ERROR);
+    expected = OS_ERROR;
+    actual = OS_TimerSetBatchNs(batch, 3, 0);
+    UtAssert_True(actual == expected, "OS_TimerSetBatchNs() (%ld) == OS_ERROR", (long)actual);
+    UT_ClearForceFail(UT_KEY(OS_TimeBaseSetNs));
+    memset(OS_timecb_table, 0, sizeof(OS_timecb_table));
+    OS_global_timebase_table[0].active_id = 0;
+
+    /* test error paths */
+    expected = OS_INVALID_POINTER;
+    actual = OS_TimerSetBatchNs(NULL, 3, 0);
+    UtAssert_True(actual == expected, "OS_TimerSetBatchNs() (%ld) == OS_INVALID_POINTER", (long)actual);
+
+    expected = OS_TIMER_ERR_INVALID_ARGS;
+    actual = OS_TimerSetBatchNs(batch, 0, 0);
+    UtAssert_True(actual == expected, "OS_TimerSetBatchNs() (%ld) == OS_TIMER_ERR_INVALID_ARGS", (long)actual);
+    actual = OS_TimerSetBatchNs(batch, 3, OS_TIMEBASE_NS_LIMIT);
+    UtAssert_True(actual == expected, "OS_TimerSetBatchNs() (%ld) == OS_TIMER_ERR_INVALID_ARGS", (long)actual);
+
+    /* the phase offset of the last entry takes it over the limit */
+    batch[2].start_time = OS_TIMEBASE_NS_LIMIT - 10;
+    actual = OS_TimerSetBatchNs(batch, 3, 5);
+    UtAssert_True(actual == expected, "OS_TimerSetBatchNs() (%ld) == OS_TIMER_ERR_INVALID_ARGS", (long)actual);
+    batch[2].start_time = OS_TIMEBASE_NS_LIMIT;
+    actual = OS_TimerSetBatchNs(batch, 3, 0);
+    UtAssert_True(actual == expected, "OS_TimerSetBatchNs() (%ld) == OS_TIMER_ERR_INVALID_ARGS", (long)actual);
+    batch[2].start_time = 100;
+
+    /* a zero start and interval is only valid with a phase offset */
+    batch[1].start_time = 0;
+    batch[1].interval_time = 0;
+    expected = OS_ERROR;
+    actual = OS_TimerSetBatchNs(batch, 2, 0);
+    UtAssert_True(actual == expected, "OS_TimerSetBatchNs() (%ld) == OS_ERROR", (long)actual);
+    expected = OS_SUCCESS;
+    actual = OS_TimerSetBatchNs(batch, 2, 10);
+    UtAssert_True(actual == expected, "OS_TimerSetBatchNs() (%ld) == OS_SUCCESS", (long)actual);
+    batch[1].start_time = 100;
+    batch[1].interval_time = 10;
+
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 1 | (OS_OBJECT_TYPE_OS_TIMEBASE << OS_OBJECT_TYPE_SHIFT));
+    expected = OS_ERR_INCORRECT_OBJ_STATE;
+    actual = OS_TimerSetBatchNs(batch, 3, 0);
+    UtAssert_True(actual == expected, "OS_TimerSetBatchNs() (%ld) == OS_ERR_INCORRECT_OBJ_STATE", (long)actual);
+    UT_ClearForceFail(UT_KEY(OS_TaskGetId_Impl));
+}
+
+void Test_OS_TimerSetDispatch(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TimerSetDispatch(uint32 timer_id, uint32 pool_id)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual;
+
+    memset(OS_timecb_table, 0, sizeof(OS_timecb_table));
+    actual = OS_TimerSetDispatch(1, 3);
+    UtAssert_True(actual == expected, "OS_TimerSetDispatch() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True((OS_timecb_table[1].flags & TIMECB_FLAG_DISPATCH) != 0, "dispatch flag set");
+    UtAssert_True(OS_timecb_table[1].dispatch_pool == 3, "dispatch_pool (%lu) == 3",
+            (unsigned long)OS_timecb_table[1].dispatch_pool);
+
+    actual = OS_TimerSetDispatch(1, 0);
+    UtAssert_True(actual == expected, "OS_TimerSetDispatch() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True((OS_timecb_table[1].flags & TIMECB_FLAG_DISPATCH) == 0, "dispatch flag cleared");
+
+    /* test error paths */
+    UT_SetForceFail(UT_KEY(OS_ObjectIdGetById), OS_ERR_INVALID_ID);
+    expected = OS_ERR_INVALID_ID;
+    actual = OS_TimerSetDispatch(1, 3);
+    UtAssert_True(actual == expected, "OS_TimerSetDispatch() (%ld) == OS_ERR_INVALID_ID", (long)actual);
+    UT_ClearForceFail(UT_KEY(OS_ObjectIdGetById));
+
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 1 | (OS_OBJECT_TYPE_OS_TIMEBASE << OS_OBJECT_TYPE_SHIFT));
+    expected = OS_ERR_INCORRECT_OBJ_STATE;
+    actual = OS_TimerSetDispatch(1, 3);
+    UtAssert_True(actual == expected, "OS_TimerSetDispatch() (%ld) == OS_ERR_INCORRECT_OBJ_STATE", (long)actual);
+    UT_ClearForceFail(UT_KEY(OS_TaskGetId_Impl));
+}
+
+void Test_OS_TimerDispatch(void)
+{
+    /*
+     * Test Case For:
+     * void OS_TimerDispatch(uint32 timer_id, uint64 nominal_usec)
+     * static void OS_Timer_DispatchJob(void *arg)
+     */
+    OS_common_record_t *rptr = &OS_global_timecb_table[1];
+    uint32 local_index = 1;
+
+    memset(OS_timecb_table, 0, sizeof(OS_timecb_table));
+    OS_global_timecb_table[1].active_id = 1;
+    OS_timecb_table[1].dispatch_pool = 3;
+    OS_timecb_table[1].callback_ptr = UT_TimerArgCallback;
+    UT_TimerArgCount = 0;
+    UT_WorkFunc = NULL;
+    UT_SetHookFunction(UT_KEY(OS_WorkSubmit), UT_WorkSubmitHook, NULL);
+
+    OS_TimerDispatch(1, 1000);
+    UtAssert_True(OS_timecb_table[1].dispatch_busy, "callback submitted");
+    UtAssert_True(OS_timecb_table[1].dispatch_nominal == 1000, "nominal expiry kept for the job");
+    UtAssert_True(UT_WorkFunc != NULL, "job function captured");
+
+    /* expiring again while the callback is pending is an overrun */
+    OS_TimerDispatch(1, 1000);
+    UtAssert_True(OS_timecb_table[1].overruns == 1, "overruns (%lu) == 1",
+            (unsigned long)OS_timecb_table[1].overruns);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_WorkSubmit)) == 1, "OS_WorkSubmit() called once");
+
+    UT_WorkFunc(UT_WorkArg);
+    UtAssert_True(UT_TimerArgCount == 1, "UT_TimerArgCount (%lu) == 1", (unsigned long)UT_TimerArgCount);
+    UtAssert_True(!OS_timecb_table[1].dispatch_busy, "callback finished");
+    UtAssert_True(OS_timecb_table[1].dispatch_task == 0, "no callback running");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimerLatencyRecord)) == 1, "lateness recorded");
+
+    /* a callback deleting its own timer leaves the released record alone */
+    OS_timecb_table[1].callback_ptr = UT_TimerDeleteCallback;
+    OS_timecb_table[1].dispatch_busy = true;
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 5);
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &rptr, sizeof(rptr), false);
+    UT_WorkFunc(UT_WorkArg);
+    UtAssert_True(UT_TimerArgCount == 2, "UT_TimerArgCount (%lu) == 2", (unsigned long)UT_TimerArgCount);
+    UtAssert_True(OS_timecb_table[1].dispatch_task == 5, "dispatch_task (%lu) == 5",
+            (unsigned long)OS_timecb_table[1].dispatch_task);
+    UtAssert_True(OS_timecb_table[1].dispatch_busy, "released record not updated");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimerLatencyRecord)) == 1, "lateness not recorded");
+    UT_ClearForceFail(UT_KEY(OS_TaskGetId_Impl));
+    OS_timecb_table[1].callback_ptr = UT_TimerArgCallback;
+    OS_timecb_table[1].dispatch_busy = false;
+    OS_global_timecb_table[1].active_id = 1;
+
+    /* a job for a deleted timer is skipped */
+    UT_SetForceFail(UT_KEY(OS_ObjectIdGetById), OS_ERR_INVALID_ID);
+    UT_WorkFunc(UT_WorkArg);
+    UtAssert_True(UT_TimerArgCount == 2, "UT_TimerArgCount (%lu) == 2", (unsigned long)UT_TimerArgCount);
+    UT_ClearForceFail(UT_KEY(OS_ObjectIdGetById));
+
+    /* a job that cannot be submitted is an overrun */
+    UT_SetForceFail(UT_KEY(OS_WorkSubmit), OS_QUEUE_FULL);
+    OS_TimerDispatch(1, 1000);
+    UtAssert_True(!OS_timecb_table[1].dispatch_busy, "callback not submitted");
+    UtAssert_True(OS_timecb_table[1].overruns == 2, "overruns (%lu) == 2",
+            (unsigned long)OS_timecb_table[1].overruns);
+
+    memset(OS_timecb_table, 0, sizeof(OS_timecb_table));
+    OS_global_timecb_table[1].active_id = 0;
+}
 
 void Test_OS_TimerDelete(void)
 {
@@ -194,17 +486,24 @@ void Test_OS_TimerDelete(void)
 
     UtAssert_True(actual == expected, "OS_TimerDelete() (%ld) == OS_SUCCESS", (long)actual);
 
-    OS_timecb_table[1].timebase_ref = 0;
-    OS_timecb_table[2].timebase_ref = 0;
-    OS_timecb_table[2].next_ref = 1;
-    OS_timecb_table[1].next_ref = 1;
-    OS_timebase_table[0].first_cb = 2;
-    actual = OS_TimerDelete(2);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimerWheelDisarm)) == 1, "OS_TimerDelete() disarmed the timer");
+
+    /* a running dispatched callback must return first */
+    OS_timecb_table[1].dispatch_task = 5;
+    UT_SetHookFunction(UT_KEY(OS_TaskDelay_Impl), UT_CallbackReturnHook, NULL);
+    actual = OS_TimerDelete(1);
     UtAssert_True(actual == expected, "OS_TimerDelete() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TaskDelay_Impl)) == 1, "OS_TimerDelete() waited for the callback");
+    UT_SetHookFunction(UT_KEY(OS_TaskDelay_Impl), NULL, NULL);
 
-    OS_timebase_table[0].first_cb = 1;
+    /* unless the callback is deleting its own timer */
+    OS_timecb_table[1].dispatch_task = 5;
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 5);
     actual = OS_TimerDelete(1);
     UtAssert_True(actual == expected, "OS_TimerDelete() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TaskDelay_Impl)) == 1, "OS_TimerDelete() did not wait for itself");
+    UT_ClearForceFail(UT_KEY(OS_TaskGetId_Impl));
+    OS_timecb_table[1].dispatch_task = 0;
 
     /* verify deletion of the dedicated timebase objects
      * these are implicitly created as part of timer creation for API compatibility */
@@ -279,9 +578,11 @@ void Test_OS_TimerGetInfo(void)
     memset(&utrec, 0, sizeof(utrec));
     utrec.creator = 111;
     utrec.name_entry = "ABC";
-    OS_timecb_table[1].interval_time = 2222;
+    OS_timecb_table[1].interval_time = 2222000;
     OS_timecb_table[1].timebase_ref = 0;
     OS_timebase_table[0].accuracy_usec = 3333;
+    OS_timecb_table[1].overruns = 4444;
+    OS_timecb_table[1].latency.count = 5555;
     UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
     UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &rptr, sizeof(rptr), false);
     actual = OS_TimerGetInfo(1, &timer_prop);
@@ -292,9 +593,18 @@ void Test_OS_TimerGetInfo(void)
     UtAssert_True(timer_prop.interval_time == 2222,
             "timer_prop.interval_time (%lu) == 2222",
             (unsigned long)timer_prop.interval_time);
+    UtAssert_True(timer_prop.interval_ns == 2222000,
+            "timer_prop.interval_ns (%lu) == 2222000",
+            (unsigned long)timer_prop.interval_ns);
     UtAssert_True(timer_prop.accuracy == 3333,
             "timer_prop.accuracy (%lu) == 3333",
             (unsigned long)timer_prop.accuracy);
+    UtAssert_True(timer_prop.overruns == 4444,
+            "timer_prop.overruns (%lu) == 4444",
+            (unsigned long)timer_prop.overruns);
+    UtAssert_True(timer_prop.latency.count == 5555,
+            "timer_prop.latency.count (%lu) == 5555",
+            (unsigned long)timer_prop.latency.count);
 
     expected = OS_INVALID_POINTER;
     actual = OS_TimerGetInfo(1, NULL);
@@ -339,6 +649,10 @@ void OS_Application_Startup(void)
     ADD_TEST(OS_TimerAdd);
     ADD_TEST(OS_TimerCreate);
     ADD_TEST(OS_TimerSet);
+    ADD_TEST(OS_TimerSetNs);
+    ADD_TEST(OS_TimerSetBatchNs);
+    ADD_TEST(OS_TimerSetDispatch);
+    ADD_TEST(OS_TimerDispatch);
     ADD_TEST(OS_TimerDelete);
     ADD_TEST(OS_TimerGetIdByName);
     ADD_TEST(OS_TimerGetInfo);
@@ -119,6 +119,67 @@ void Test_OS_TimeBaseSet(void)
 
 }
 
+void Test_OS_TimeBaseSetNs(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TimeBaseSetNs(uint32 timer_id, uint64 start_time, uint64 interval_time)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = OS_TimeBaseSetNs(1, 500, 250);
+
+    UtAssert_True(actual == expected, "OS_TimeBaseSetNs() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(OS_timebase_table[1].nominal_start_time == 500, "nominal_start_time (%lu) == 500",
+            (unsigned long)OS_timebase_table[1].nominal_start_time);
+    UtAssert_True(OS_timebase_table[1].nominal_interval_time == 250, "nominal_interval_time (%lu) == 250",
+            (unsigned long)OS_timebase_table[1].nominal_interval_time);
+
+    /* intervals well beyond what fits in 32 bits of microseconds are fine */
+    actual = OS_TimeBaseSetNs(1, 1ULL << 50, 1ULL << 50);
+    UtAssert_True(actual == expected, "OS_TimeBaseSetNs() (%ld) == OS_SUCCESS", (long)actual);
+
+    /* test error paths: overflow on input */
+    expected = OS_TIMER_ERR_INVALID_ARGS;
+    actual = OS_TimeBaseSetNs(1, OS_TIMEBASE_NS_LIMIT, 1000);
+    UtAssert_True(actual == expected, "OS_TimeBaseSetNs() (%ld) == OS_TIMER_ERR_INVALID_ARGS", (long)actual);
+    actual = OS_TimeBaseSetNs(1, 1000, OS_TIMEBASE_NS_LIMIT);
+    UtAssert_True(actual == expected, "OS_TimeBaseSetNs() (%ld) == OS_TIMER_ERR_INVALID_ARGS", (long)actual);
+}
+
+void Test_OS_TimeBaseSetTickless(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TimeBaseSetTickless(uint32 timebase_id, bool tickless)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual;
+
+    memset(&OS_timebase_table[1], 0, sizeof(OS_timebase_table[1]));
+    actual = OS_TimeBaseSetTickless(1, true);
+    UtAssert_True(actual == expected, "OS_TimeBaseSetTickless() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(OS_timebase_table[1].tickless, "tickless set");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimeBaseNextDue_Impl)) == 1, "OS_TimeBaseNextDue_Impl() called");
+
+    actual = OS_TimeBaseSetTickless(1, false);
+    UtAssert_True(actual == expected, "OS_TimeBaseSetTickless() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(!OS_timebase_table[1].tickless, "tickless cleared");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimeBaseNextDue_Impl)) == 1, "OS_TimeBaseNextDue_Impl() not called");
+
+    /* test error paths */
+    UT_SetForceFail(UT_KEY(OS_TimeBaseSetTickless_Impl), OS_ERR_NOT_IMPLEMENTED);
+    expected = OS_ERR_NOT_IMPLEMENTED;
+    actual = OS_TimeBaseSetTickless(1, true);
+    UtAssert_True(actual == expected, "OS_TimeBaseSetTickless() (%ld) == OS_ERR_NOT_IMPLEMENTED", (long)actual);
+    UtAssert_True(!OS_timebase_table[1].tickless, "tickless not set");
+
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 1 | (OS_OBJECT_TYPE_OS_TIMEBASE << OS_OBJECT_TYPE_SHIFT));
+    expected = OS_ERR_INCORRECT_OBJ_STATE;
+    actual = OS_TimeBaseSetTickless(1, true);
+    UtAssert_True(actual == expected, "OS_TimeBaseSetTickless() (%ld) == OS_ERR_INCORRECT_OBJ_STATE", (long)actual);
+
+}
+
 void Test_OS_TimeBaseDelete(void)
 {
     /*
@@ -186,9 +247,10 @@ void Test_OS_TimeBaseGetInfo(void)
     memset(&utrec, 0, sizeof(utrec));
     utrec.creator = 1111;
     utrec.name_entry = "ABC";
-    OS_timebase_table[1].nominal_interval_time = 2222;
-    OS_timebase_table[1].freerun_time = 3333;
+    OS_timebase_table[1].nominal_interval_time = 2222000;
+    OS_timebase_table[1].freerun_time = 3333000;
     OS_timebase_table[1].accuracy_usec = 4444;
+    OS_timebase_table[1].latency.count = 5555;
     UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
     UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &rptr, sizeof(rptr), false);
     actual = OS_TimeBaseGetInfo(1, &timebase_prop);
@@ -205,9 +267,18 @@ void Test_OS_TimeBaseGetInfo(void)
     UtAssert_True(timebase_prop.freerun_time == 3333,
             "timebase_prop.freerun_time (%lu) == 3333",
             (unsigned long)timebase_prop.freerun_time);
+    UtAssert_True(timebase_prop.nominal_interval_ns == 2222000,
+            "timebase_prop.nominal_interval_ns (%lu) == 2222000",
+            (unsigned long)timebase_prop.nominal_interval_ns);
+    UtAssert_True(timebase_prop.freerun_ns == 3333000,
+            "timebase_prop.freerun_ns (%lu) == 3333000",
+            (unsigned long)timebase_prop.freerun_ns);
     UtAssert_True(timebase_prop.accuracy == 4444,
             "timebase_prop.accuracy (%lu) == 4444",
             (unsigned long)timebase_prop.accuracy);
+    UtAssert_True(timebase_prop.latency.count == 5555,
+            "timebase_prop.latency.count (%lu) == 5555",
+            (unsigned long)timebase_prop.latency.count);
 
     /* test error paths */
     expected = OS_INVALID_POINTER;
@@ -234,22 +305,47 @@ void Test_OS_TimeBaseGetFreeRun(void)
     UtAssert_True(actual == expected, "OS_TimeBaseGetFreeRun() (%ld) == OS_SUCCESS", (long)actual);
 }
 
+void Test_OS_TimeBaseGetFreeRunNs(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_TimeBaseGetFreeRunNs   (uint32 timebase_id, uint64 *freerun_val)
+     */
+    int32 expected = OS_SUCCESS;
+    uint64 freerun = 0;
+    int32 actual;
+
+    OS_timebase_table[1].freerun_time = 0x123456789ULL;
+    actual = OS_TimeBaseGetFreeRunNs(1, &freerun);
+    UtAssert_True(actual == expected, "OS_TimeBaseGetFreeRunNs() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(freerun == 0x123456789ULL, "freerun (%llx) == 0x123456789",
+            (unsigned long long)freerun);
+
+    expected = OS_INVALID_POINTER;
+    actual = OS_TimeBaseGetFreeRunNs(1, NULL);
+    UtAssert_True(actual == expected, "OS_TimeBaseGetFreeRunNs() (%ld) == OS_INVALID_POINTER", (long)actual);
+}
+
 void Test_OS_TimeBase_CallbackThread(void)
 {
     /*
      * Test Case For:
      * void OS_TimeBase_CallbackThread(uint32 timebase_id)
      */
-    OS_common_record_t fake_record;
-    OS_common_record_t *recptr = &fake_record;
+    OS_common_record_t *recptr = &OS_global_timebase_table[2];
+    OS_time_t mono_time;
+    uint32 tick_late;
     uint32 idbuf;
 
-    memset(&fake_record, 0, sizeof(fake_record));
-    fake_record.active_id = 2;
+    memset(recptr, 0, sizeof(*recptr));
+    recptr->active_id = 2;
 
+    memset(&OS_timebase_table[2], 0, sizeof(OS_timebase_table[2]));
+    memset(OS_timecb_table, 0, sizeof(OS_timecb_table));
     OS_timebase_table[2].external_sync = UT_TimerSync;
-    OS_timecb_table[0].wait_time = 2000;
+    OS_timecb_table[0].expiry_time = 2000;
     OS_timecb_table[0].callback_ptr = UT_TimeCB;
+    OS_TimerWheelArm(2, 0);
     TimerSyncCount = 0;
     TimerSyncRetVal = 0;
     TimeCB = 0;
@@ -264,21 +360,224 @@ void Test_OS_TimeBase_CallbackThread(void)
     UT_ResetState(UT_KEY(OS_TimeBaseLock_Impl));
     TimerSyncCount = 0;
     TimerSyncRetVal = 1000;
-    fake_record.active_id = 2;
+    recptr->active_id = 2;
     idbuf = 2;
     UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById),&idbuf, sizeof(idbuf), false);
     UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById),&recptr, sizeof(recptr), false);
     UT_SetHookFunction(UT_KEY(OS_TimeBaseLock_Impl), ClearObjectsHook, recptr);
     OS_TimeBase_CallbackThread(2);
 
-    /* Check that the TimeCB function was called */
-    UtAssert_True(TimeCB > 0, "TimeCB (%lu) > 0", (unsigned long)TimeCB);
+    /* Check that the TimeCB function was called, once since the timer is a one-shot */
+    UtAssert_True(TimeCB == 1, "TimeCB (%lu) == 1", (unsigned long)TimeCB);
+    UtAssert_True(OS_timecb_table[0].wheel_bucket == 0, "one-shot timer disarmed");
+    UtAssert_True(OS_timecb_table[0].latency.count == 1, "latency.count (%lu) == 1",
+            (unsigned long)OS_timecb_table[0].latency.count);
+
+    /*
+     * A periodic timer with an interval shorter than the tick is called back
+     * several times per tick, until it is limited by the backlog reset
+     */
+    UT_ResetState(UT_KEY(OS_TimeBaseLock_Impl));
+    TimerSyncCount = 0;
+    TimeCB = 0;
+    recptr->active_id = 2;
+    OS_timecb_table[0].expiry_time = OS_timebase_table[2].wheel_time + 1;
+    OS_timecb_table[0].interval_time = 300000;
+    OS_TimerWheelArm(2, 0);
+    idbuf = 2;
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById),&idbuf, sizeof(idbuf), false);
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById),&recptr, sizeof(recptr), false);
+    UT_SetHookFunction(UT_KEY(OS_TimeBaseLock_Impl), ClearObjectsHook, recptr);
+    OS_TimeBase_CallbackThread(2);
+
+    UtAssert_True(TimeCB >= 30, "TimeCB (%lu) >= 30", (unsigned long)TimeCB);
+    UtAssert_True(OS_timecb_table[0].backlog_resets > 0, "backlog_resets (%lu) > 0",
+            (unsigned long)OS_timecb_table[0].backlog_resets);
+    UtAssert_True(OS_timecb_table[0].wheel_bucket != 0, "periodic timer still armed");
+
+    /* a dispatched timer hands its expirations to the worker pool instead */
+    UT_ResetState(UT_KEY(OS_TimeBaseLock_Impl));
+    recptr->active_id = 2;
+    TimeCB = 0;
+    OS_timecb_table[0].flags = TIMECB_FLAG_DISPATCH;
+    UtAssert_True(OS_TimeBase_ProcessTick(2, 2, 1000000) == OS_SUCCESS, "OS_TimeBase_ProcessTick() dispatch");
+    UtAssert_True(TimeCB == 0, "TimeCB (%lu) == 0", (unsigned long)TimeCB);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimerDispatch)) > 0, "OS_TimerDispatch() called");
+    OS_timecb_table[0].flags = 0;
+
+    /*
+     * When the nominal time of the tick is known, the lateness includes
+     * the time since then and how long before the tick the timer expired
+     */
+    UT_ResetState(UT_KEY(OS_TimeBaseLock_Impl));
+    recptr->active_id = 2;
+    memset(&OS_timecb_table[0].latency, 0, sizeof(OS_timecb_table[0].latency));
+    OS_TimerWheelDisarm(2, 0);
+    OS_timecb_table[0].expiry_time = OS_timebase_table[2].wheel_time + 400000;
+    OS_timecb_table[0].interval_time = 0;
+    OS_TimerWheelArm(2, 0);
+    mono_time.seconds = 10;
+    mono_time.microsecs = 0;
+    tick_late = 50;
+    UT_SetDataBuffer(UT_KEY(OS_TimeBaseTickLateness_Impl), &tick_late, sizeof(tick_late), false);
+    UT_SetDataBuffer(UT_KEY(OS_GetMonotonicTime_Impl), &mono_time, sizeof(mono_time), false);
+    UT_SetDataBuffer(UT_KEY(OS_GetMonotonicTime_Impl), &mono_time, sizeof(mono_time), false);
+    UtAssert_True(OS_TimeBase_ProcessTick(2, 2, 1000000) == OS_SUCCESS, "OS_TimeBase_ProcessTick() nominal tick");
+    UtAssert_True(OS_timecb_table[0].latency.max_usec == 650, "latency.max_usec (%lu) == 650",
+            (unsigned long)OS_timecb_table[0].latency.max_usec);
+    UT_ResetState(UT_KEY(OS_GetMonotonicTime_Impl));
+    OS_timecb_table[0].interval_time = 300000;
+
+    /* a tickless time base is programmed for the next timer after each tick */
+    UT_ResetState(UT_KEY(OS_TimeBaseLock_Impl));
+    UT_ResetState(UT_KEY(OS_TimeBaseNextDue_Impl));
+    recptr->active_id = 2;
+    OS_timebase_table[2].tickless = true;
+    OS_TimerWheelDisarm(2, 0);
+    OS_timecb_table[0].expiry_time = OS_timebase_table[2].wheel_time + 5000000;
+    OS_TimerWheelArm(2, 0);
+    UtAssert_True(OS_TimeBase_ProcessTick(2, 2, 1000000) == OS_SUCCESS, "OS_TimeBase_ProcessTick() tickless");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TimeBaseNextDue_Impl)) == 1, "OS_TimeBaseNextDue_Impl() called");
+    UtAssert_True(OS_TimerWheelNextDue(2) > 0 && OS_TimerWheelNextDue(2) <= 4000000,
+            "OS_TimerWheelNextDue() (%lu) <= 4000000",
+            (unsigned long)OS_TimerWheelNextDue(2));
+    OS_timebase_table[2].tickless = false;
 
 
     UT_SetForceFail(UT_KEY(OS_ObjectIdGetById), OS_ERROR);
     OS_TimeBase_CallbackThread(2);
 }
 
+void Test_OS_TimerWheel(void)
+{
+    /*
+     * Test Case For:
+     * void OS_TimerWheelArm(uint32 timebase_id, uint32 timer_id)
+     * void OS_TimerWheelDisarm(uint32 timebase_id, uint32 timer_id)
+     * static uint32 OS_TimerWheelAdvance(uint32 timebase_id, uint64 new_time)
+     */
+    OS_timebase_internal_record_t *timebase = &OS_timebase_table[1];
+    uint32 due;
+    uint32 i;
+
+    memset(timebase, 0, sizeof(*timebase));
+    memset(OS_timecb_table, 0, sizeof(OS_timecb_table));
+    timebase->wheel_time = 1000;
+
+    OS_timecb_table[0].expiry_time = 1000;                  /* already due */
+    OS_timecb_table[1].expiry_time = 1010;                  /* level 0 */
+    OS_timecb_table[2].expiry_time = 1010;
+    OS_timecb_table[3].expiry_time = 1010;
+    OS_timecb_table[4].expiry_time = 6000;                  /* level 2 */
+    OS_timecb_table[5].expiry_time = 1000 + 300000;         /* level 3 */
+    OS_timecb_table[6].expiry_time = 1000 + (1ULL << 40);   /* beyond the top level */
+    for (i = 0; i <= 6; ++i)
+    {
+        OS_TimerWheelArm(1, i);
+    }
+
+    UtAssert_True(OS_timecb_table[0].wheel_bucket == OS_TIMER_WHEEL_EXPIRED + 1, "timer 0 in expired bucket");
+    UtAssert_True(OS_timecb_table[1].wheel_bucket == (1010 % OS_TIMER_WHEEL_SLOTS) + 1, "timer 1 in level 0");
+    UtAssert_True(OS_timecb_table[4].wheel_bucket == (2 * OS_TIMER_WHEEL_SLOTS) + 1 + 1, "timer 4 in level 2");
+    UtAssert_True(OS_timecb_table[5].wheel_bucket > 3 * OS_TIMER_WHEEL_SLOTS, "timer 5 in level 3");
+    UtAssert_True(OS_timecb_table[6].wheel_bucket == OS_TIMER_WHEEL_OVERFLOW + 1, "timer 6 in overflow bucket");
+
+    /* take timers off the middle, head and tail of a slot, and put one back */
+    OS_TimerWheelDisarm(1, 2);
+    OS_TimerWheelDisarm(1, 3);
+    OS_TimerWheelDisarm(1, 1);
+    OS_TimerWheelDisarm(1, 1);
+    UtAssert_True(timebase->wheel_occupied[0] == 0, "level 0 empty");
+    OS_TimerWheelArm(1, 2);
+    OS_TimerWheelArm(1, 1);
+    OS_TimerWheelArm(1, 2);
+    UtAssert_True(timebase->wheel_occupied[0] != 0, "level 0 occupied");
+
+    UtAssert_True(OS_TimerWheelNextDue(1) == 0, "OS_TimerWheelNextDue() with timer already due");
+
+    due = Osapi_Call_TimerWheelAdvance(1, 1009);
+    UtAssert_True(due == 1, "due (%lu) == timer 0", (unsigned long)due);
+    UtAssert_True(OS_timecb_table[0].wheel_next == 0, "only timer 0 due");
+
+    UtAssert_True(OS_TimerWheelNextDue(1) == 1, "OS_TimerWheelNextDue() (%lu) == 1",
+            (unsigned long)OS_TimerWheelNextDue(1));
+
+    due = Osapi_Call_TimerWheelAdvance(1, 1010);
+    UtAssert_True(due == 3, "due (%lu) == timer 2", (unsigned long)due);
+    UtAssert_True(OS_timecb_table[2].wheel_next == 2, "then timer 1");
+    UtAssert_True(OS_timecb_table[1].wheel_next == 0, "only timers 2 and 1 due");
+
+    /* timer 4 moves down from level 2 on the way */
+    due = Osapi_Call_TimerWheelAdvance(1, 5999);
+    UtAssert_True(due == 0, "nothing due (%lu)", (unsigned long)due);
+    UtAssert_True(OS_timecb_table[4].wheel_bucket != 0 && OS_timecb_table[4].wheel_bucket <= OS_TIMER_WHEEL_SLOTS,
+            "timer 4 moved to level 0 (%lu)", (unsigned long)OS_timecb_table[4].wheel_bucket);
+    due = Osapi_Call_TimerWheelAdvance(1, 6000);
+    UtAssert_True(due == 5, "due (%lu) == timer 4", (unsigned long)due);
+
+    /* timers 5 and 6 in a single step */
+    due = Osapi_Call_TimerWheelAdvance(1, 2000 + (1ULL << 40));
+    UtAssert_True(due == 6, "due (%lu) == timer 5", (unsigned long)due);
+    UtAssert_True(OS_timecb_table[5].wheel_next == 7, "then timer 6");
+    UtAssert_True(timebase->wheel_time == 2000 + (1ULL << 40), "wheel_time advanced");
+    UtAssert_True(timebase->wheel_bucket[OS_TIMER_WHEEL_OVERFLOW] == 0, "overflow bucket empty");
+    UtAssert_True(OS_TimerWheelNextDue(1) == OS_TIMER_WHEEL_IDLE, "OS_TimerWheelNextDue() with no timer armed");
+
+    /* a timer beyond the top level is due no later than the end of it */
+    OS_timecb_table[6].expiry_time = timebase->wheel_time + (1ULL << 40);
+    OS_TimerWheelArm(1, 6);
+    UtAssert_True(OS_TimerWheelNextDue(1) > 0 && OS_TimerWheelNextDue(1) <= (1ULL << 40),
+            "OS_TimerWheelNextDue() (%llu) limited", (unsigned long long)OS_TimerWheelNextDue(1));
+    OS_TimerWheelDisarm(1, 6);
+}
+
+void Test_OS_TimerLatency(void)
+{
+    /*
+     * Test Case For:
+     * uint64 OS_TimerLatencyNow(void)
+     * void OS_TimerLatencyRecord(uint32 timebase_id, uint32 timer_id, uint64 nominal_usec, uint64 entry_usec)
+     */
+    OS_timer_latency_t *latency = &OS_timecb_table[1].latency;
+    OS_time_t mono_time;
+    uint64 now;
+
+    mono_time.seconds = 2;
+    mono_time.microsecs = 5;
+    UT_SetDataBuffer(UT_KEY(OS_GetMonotonicTime_Impl), &mono_time, sizeof(mono_time), false);
+    now = OS_TimerLatencyNow();
+    UtAssert_True(now == 2000005, "OS_TimerLatencyNow() (%lu) == 2000005", (unsigned long)now);
+
+    UT_SetForceFail(UT_KEY(OS_GetMonotonicTime_Impl), OS_ERROR);
+    now = OS_TimerLatencyNow();
+    UtAssert_True(now == 0, "OS_TimerLatencyNow() (%lu) == 0", (unsigned long)now);
+    UT_ClearForceFail(UT_KEY(OS_GetMonotonicTime_Impl));
+
+    memset(&OS_timebase_table[2], 0, sizeof(OS_timebase_table[2]));
+    memset(OS_timecb_table, 0, sizeof(OS_timecb_table));
+
+    OS_TimerLatencyRecord(2, 1, 1000, 1005);
+    OS_TimerLatencyRecord(2, 1, 1000, 999);
+    OS_TimerLatencyRecord(2, 1, 1000, 1000 + 1000);
+    OS_TimerLatencyRecord(2, 1, 1000, 1000 + 0x100000000ULL);
+
+    UtAssert_True(latency->count == 4, "latency.count (%lu) == 4", (unsigned long)latency->count);
+    UtAssert_True(latency->min_usec == 0, "latency.min_usec (%lu) == 0", (unsigned long)latency->min_usec);
+    UtAssert_True(latency->max_usec == 0xFFFFFFFF, "latency.max_usec (%lu) == 0xFFFFFFFF",
+            (unsigned long)latency->max_usec);
+    UtAssert_True(latency->mean_usec == (uint32)((5ULL + 1000 + 0xFFFFFFFF) / 4), "latency.mean_usec (%lu)",
+            (unsigned long)latency->mean_usec);
+    UtAssert_True(latency->histogram[0] == 1, "early callback in bucket 0");
+    UtAssert_True(latency->histogram[1] == 1, "5 usec in bucket 1");
+    UtAssert_True(latency->histogram[4] == 1, "1000 usec in bucket 4");
+    UtAssert_True(latency->histogram[OS_TIMER_LATENCY_BUCKETS - 1] == 1, "limit in last bucket");
+    UtAssert_True(OS_timebase_table[2].latency.count == 4, "time base latency.count (%lu) == 4",
+            (unsigned long)OS_timebase_table[2].latency.count);
+
+    memset(&OS_timebase_table[2], 0, sizeof(OS_timebase_table[2]));
+    memset(OS_timecb_table, 0, sizeof(OS_timecb_table));
+}
+
 void Test_OS_Tick2Micros(void)
 {
     /*
@@ -335,11 +634,16 @@ void OS_Application_Startup(void)
     ADD_TEST(OS_TimeBaseAPI_Init);
     ADD_TEST(OS_TimeBaseCreate);
     ADD_TEST(OS_TimeBaseSet);
+    ADD_TEST(OS_TimeBaseSetNs);
+    ADD_TEST(OS_TimeBaseSetTickless);
     ADD_TEST(OS_TimeBaseDelete);
     ADD_TEST(OS_TimeBaseGetIdByName);
     ADD_TEST(OS_TimeBaseGetInfo);
     ADD_TEST(OS_TimeBaseGetFreeRun);
+    ADD_TEST(OS_TimeBaseGetFreeRunNs);
     ADD_TEST(OS_TimeBase_CallbackThread);
+    ADD_TEST(OS_TimerWheel);
+    ADD_TEST(OS_TimerLatency);
     ADD_TEST(OS_Tick2Micros);
     ADD_TEST(OS_Milli2Ticks);
 }
@@ -0,0 +1,414 @@
+/*
+ * Filename: coveragetest-workpool.c
+ *
+ * Purpose: This file contains unit test cases for items in the "osapi-workpool" file
+ *
+ * Notes:
+ *
+ */
+
+
+/*
+ * Includes
+ */
+
+#include "os-shared-coveragetest.h"
+#include "ut-osapi-workpool.h"
+
+#include <overrides/string.h>
+
+static uint32 UT_JobRunCount;
+
+/*
+**********************************************************************************
+**          HOOK/CALLBACK FUNCTIONS
+**********************************************************************************
+*/
+
+static void UT_TestJob(void *arg)
+{
+    ++(*((uint32*)arg));
+}
+
+/* simulates the outstanding jobs completing while the caller waits */
+static int32 UT_IdleWaitCompleteHook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    OS_workpool_table[1].worker[0].completed = OS_workpool_table[1].worker[0].submitted;
+    return StubRetcode;
+}
+
+/* simulates the workers exiting while the pool is being deleted */
+static int32 UT_IdleWaitExitHook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    OS_workpool_table[1].worker[0].exited = true;
+    OS_workpool_table[1].worker[1].exited = true;
+    return StubRetcode;
+}
+
+/*
+ * Set up pool local ID 1 with two workers, task IDs 100 and 101
+ */
+static void UT_SetupPool(void)
+{
+    memset(&OS_workpool_table[1], 0, sizeof(OS_workpool_table[1]));
+    OS_workpool_table[1].num_workers = 2;
+    OS_workpool_table[1].worker[0].task_id = 100;
+    OS_workpool_table[1].worker[1].task_id = 101;
+}
+
+static void UT_QueueJob(uint32 worker)
+{
+    OS_workpool_worker_t *queue = &OS_workpool_table[1].worker[worker];
+
+    queue->job[queue->tail & (OS_WORKPOOL_QUEUE_DEPTH - 1)].func = UT_TestJob;
+    queue->job[queue->tail & (OS_WORKPOOL_QUEUE_DEPTH - 1)].arg = &UT_JobRunCount;
+    ++queue->tail;
+    ++queue->submitted;
+}
+
+/*
+**********************************************************************************
+**          PUBLIC API FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_OS_WorkPoolAPI_Init(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_WorkPoolAPI_Init(void)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = OS_WorkPoolAPI_Init();
+
+    UtAssert_True(actual == expected, "OS_WorkPoolAPI_Init() (%ld) == OS_SUCCESS", (long)actual);
+}
+
+
+void Test_OS_WorkPoolCreate(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_WorkPoolCreate (uint32 *pool_id, const char *pool_name, uint32 num_workers,
+     *                          uint32 stack_size, uint32 priority, uint32 flags)
+     */
+    int32 expected = OS_SUCCESS;
+    uint32 objid = 0xFFFFFFFF;
+    uint32 local_id = 1;
+    int32 actual;
+
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdAllocateNew), &local_id, sizeof(local_id), false);
+    actual = OS_WorkPoolCreate(&objid, "UT", 2, 4096, 100, 0);
+
+    UtAssert_True(actual == expected, "OS_WorkPoolCreate() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(objid != 0, "objid (%lu) != 0", (unsigned long)objid);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_TaskCreate)) == 2, "OS_TaskCreate() called for each worker");
+    UtAssert_True(OS_workpool_table[1].num_workers == 2, "num_workers (%lu) == 2",
+            (unsigned long)OS_workpool_table[1].num_workers);
+    UtAssert_True(OS_workpool_table[1].worker[1].task_id != 0, "worker task_id (%lu) != 0",
+            (unsigned long)OS_workpool_table[1].worker[1].task_id);
+
+    /* failure to start a worker releases the OS resources */
+    UT_SetDeferredRetcode(UT_KEY(OS_TaskCreate), 2, OS_ERR_NO_FREE_IDS);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolCreate(&objid, "UT", 2, 4096, 100, 0), OS_ERR_NO_FREE_IDS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_WorkPoolDelete_Impl)) == 1, "OS_WorkPoolDelete_Impl() called");
+
+    UT_SetForceFail(UT_KEY(OS_WorkPoolCreate_Impl), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolCreate(&objid, "UT", 2, 4096, 100, 0), OS_ERROR);
+    UT_ClearForceFail(UT_KEY(OS_WorkPoolCreate_Impl));
+
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolCreate(NULL, NULL, 2, 4096, 100, 0), OS_INVALID_POINTER);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolCreate(&objid, "UT", 0, 4096, 100, 0), OS_QUEUE_INVALID_SIZE);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolCreate(&objid, "UT", OS_WORKPOOL_MAX_WORKERS + 1, 4096, 100, 0),
+            OS_QUEUE_INVALID_SIZE);
+    UT_SetForceFail(UT_KEY(OCS_strlen), 10 + OS_MAX_API_NAME);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolCreate(&objid, "UT", 2, 4096, 100, 0), OS_ERR_NAME_TOO_LONG);
+
+    /* the name must leave room for the worker suffix */
+    UT_SetForceFail(UT_KEY(OCS_strlen), OS_MAX_API_NAME - 3);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolCreate(&objid, "UT", 2, 4096, 100, 0), OS_ERR_NAME_TOO_LONG);
+    UT_ClearForceFail(UT_KEY(OCS_strlen));
+}
+
+void Test_OS_WorkSubmit(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_WorkSubmit (uint32 pool_id, OS_WorkFunc_t func, void *arg)
+     */
+    UT_SetupPool();
+
+    /* a non-worker task spreads jobs across the workers */
+    OSAPI_TEST_FUNCTION_RC(OS_WorkSubmit(1, UT_TestJob, &UT_JobRunCount), OS_SUCCESS);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkSubmit(1, UT_TestJob, &UT_JobRunCount), OS_SUCCESS);
+    UtAssert_True(OS_workpool_table[1].worker[0].tail == 1, "worker 0 queued (%lu) == 1",
+            (unsigned long)OS_workpool_table[1].worker[0].tail);
+    UtAssert_True(OS_workpool_table[1].worker[1].tail == 1, "worker 1 queued (%lu) == 1",
+            (unsigned long)OS_workpool_table[1].worker[1].tail);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_WorkPoolPost_Impl)) == 2, "OS_WorkPoolPost_Impl() called per job");
+
+    /* a worker queues to itself */
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 101);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkSubmit(1, UT_TestJob, &UT_JobRunCount), OS_SUCCESS);
+    UtAssert_True(OS_workpool_table[1].worker[1].tail == 2, "worker 1 queued (%lu) == 2",
+            (unsigned long)OS_workpool_table[1].worker[1].tail);
+
+    /* a full queue overflows to the next worker */
+    OS_workpool_table[1].worker[1].head = 2 - OS_WORKPOOL_QUEUE_DEPTH;
+    OSAPI_TEST_FUNCTION_RC(OS_WorkSubmit(1, UT_TestJob, &UT_JobRunCount), OS_SUCCESS);
+    UtAssert_True(OS_workpool_table[1].worker[0].tail == 2, "worker 0 queued (%lu) == 2",
+            (unsigned long)OS_workpool_table[1].worker[0].tail);
+
+    OS_workpool_table[1].worker[0].head = 2 - OS_WORKPOOL_QUEUE_DEPTH;
+    OSAPI_TEST_FUNCTION_RC(OS_WorkSubmit(1, UT_TestJob, &UT_JobRunCount), OS_QUEUE_FULL);
+
+    OS_workpool_table[1].shutdown = true;
+    OSAPI_TEST_FUNCTION_RC(OS_WorkSubmit(1, UT_TestJob, &UT_JobRunCount), OS_ERR_INCORRECT_OBJ_STATE);
+
+    OSAPI_TEST_FUNCTION_RC(OS_WorkSubmit(1, NULL, NULL), OS_INVALID_POINTER);
+
+    UT_SetForceFail(UT_KEY(OS_ObjectIdGetById), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkSubmit(1, UT_TestJob, &UT_JobRunCount), OS_ERR_INVALID_ID);
+}
+
+void Test_OS_WorkPoolWorkerEntry(void)
+{
+    /*
+     * Test Case For:
+     * static void OS_WorkPoolWorkerEntry(void)
+     */
+    UT_SetupPool();
+    OS_global_workpool_table[1].active_id = 1;
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 100);
+
+    /*
+     * One job on its own queue and one to steal, then a token with
+     * no job left to take, then the pend fails and the worker exits.
+     */
+    UT_QueueJob(0);
+    UT_QueueJob(1);
+    OS_workpool_table[1].idle_waiters = 1;
+    UT_JobRunCount = 0;
+    UT_SetDeferredRetcode(UT_KEY(OS_WorkPoolPend_Impl), 4, OS_SEM_FAILURE);
+    Osapi_Call_WorkPoolWorkerEntry();
+
+    UtAssert_True(UT_JobRunCount == 2, "Jobs run (%lu) == 2", (unsigned long)UT_JobRunCount);
+    UtAssert_True(OS_workpool_table[1].worker[0].completed == 1, "worker 0 completed (%lu) == 1",
+            (unsigned long)OS_workpool_table[1].worker[0].completed);
+    UtAssert_True(OS_workpool_table[1].worker[1].completed == 1, "worker 1 completed (%lu) == 1",
+            (unsigned long)OS_workpool_table[1].worker[1].completed);
+    UtAssert_True(OS_workpool_table[1].worker[1].stolen == 1, "worker 1 stolen (%lu) == 1",
+            (unsigned long)OS_workpool_table[1].worker[1].stolen);
+    UtAssert_True(OS_workpool_table[1].worker[0].exited, "worker 0 exited");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_WorkPoolIdleNotify_Impl)) == 3, "OS_WorkPoolIdleNotify_Impl() count (%lu) == 3",
+            (unsigned long)UT_GetStubCount(UT_KEY(OS_WorkPoolIdleNotify_Impl)));
+
+    /* shutdown stops the worker without taking queued jobs */
+    UT_SetupPool();
+    UT_QueueJob(0);
+    OS_workpool_table[1].shutdown = true;
+    UT_JobRunCount = 0;
+    Osapi_Call_WorkPoolWorkerEntry();
+    UtAssert_True(UT_JobRunCount == 0, "Jobs run (%lu) == 0", (unsigned long)UT_JobRunCount);
+    UtAssert_True(OS_workpool_table[1].worker[0].exited, "worker 0 exited");
+
+    /* a worker of a pool that failed to be created exits immediately */
+    UT_ResetState(UT_KEY(OS_WorkPoolPend_Impl));
+    OS_global_workpool_table[1].active_id = 0;
+    Osapi_Call_WorkPoolWorkerEntry();
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_WorkPoolPend_Impl)) == 0, "OS_WorkPoolPend_Impl() not called");
+}
+
+void Test_OS_WorkPoolWaitIdle(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_WorkPoolWaitIdle (uint32 pool_id, int32 msecs)
+     */
+    OS_time_t later[2];
+
+    UT_SetupPool();
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolWaitIdle(1, OS_PEND), OS_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_ObjectIdRefcountDecr)) == 1, "OS_ObjectIdRefcountDecr() called");
+
+    UT_QueueJob(0);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolWaitIdle(1, OS_CHECK), OS_ERROR_TIMEOUT);
+
+    /* timeout reported by the implementation is re-checked before returning */
+    UT_SetDeferredRetcode(UT_KEY(OS_WorkPoolIdleWait_Impl), 1, OS_ERROR_TIMEOUT);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolWaitIdle(1, 100), OS_ERROR_TIMEOUT);
+
+    /* deadline already passed */
+    memset(later, 0, sizeof(later));
+    later[1].seconds = 2;
+    UT_SetDataBuffer(UT_KEY(OS_GetMonotonicTime_Impl), later, sizeof(later), false);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolWaitIdle(1, 1500), OS_ERROR_TIMEOUT);
+    UT_ResetState(UT_KEY(OS_GetMonotonicTime_Impl));
+
+    UT_SetForceFail(UT_KEY(OS_GetMonotonicTime_Impl), OS_ERROR);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolWaitIdle(1, 100), OS_ERROR);
+    UT_ClearForceFail(UT_KEY(OS_GetMonotonicTime_Impl));
+
+    UT_SetHookFunction(UT_KEY(OS_WorkPoolIdleWait_Impl), UT_IdleWaitCompleteHook, NULL);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolWaitIdle(1, OS_PEND), OS_SUCCESS);
+    UT_SetHookFunction(UT_KEY(OS_WorkPoolIdleWait_Impl), NULL, NULL);
+
+    OS_workpool_table[1].shutdown = true;
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolWaitIdle(1, OS_PEND), OS_ERR_INCORRECT_OBJ_STATE);
+    UtAssert_True(OS_workpool_table[1].idle_waiters == 0, "idle_waiters (%lu) == 0",
+            (unsigned long)OS_workpool_table[1].idle_waiters);
+
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 100);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolWaitIdle(1, OS_PEND), OS_ERR_INCORRECT_OBJ_STATE);
+    UT_ClearForceFail(UT_KEY(OS_TaskGetId_Impl));
+
+    UT_SetForceFail(UT_KEY(OS_ObjectIdGetById), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolWaitIdle(1, OS_PEND), OS_ERR_INVALID_ID);
+}
+
+void Test_OS_WorkPoolDelete(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_WorkPoolDelete (uint32 pool_id)
+     */
+    UT_SetupPool();
+    UT_SetHookFunction(UT_KEY(OS_WorkPoolIdleWait_Impl), UT_IdleWaitExitHook, NULL);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolDelete(1), OS_SUCCESS);
+    UtAssert_True(OS_workpool_table[1].shutdown, "shutdown set");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_WorkPoolPost_Impl)) == 2, "OS_WorkPoolPost_Impl() called per worker");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_WorkPoolIdleWait_Impl)) == 1, "OS_WorkPoolIdleWait_Impl() called");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_WorkPoolDelete_Impl)) == 1, "OS_WorkPoolDelete_Impl() called");
+
+    /* retrying a delete does not wake the workers again, and deleted worker tasks are not waited for */
+    UT_ResetState(0);
+    UT_SetupPool();
+    OS_workpool_table[1].shutdown = true;
+    OS_workpool_table[1].worker[0].exited = true;
+    UT_SetDeferredRetcode(UT_KEY(OS_ObjectIdGetById), 2, OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolDelete(1), OS_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_WorkPoolPost_Impl)) == 0, "OS_WorkPoolPost_Impl() not called");
+
+    UT_SetForceFail(UT_KEY(OS_WorkPoolDelete_Impl), OS_ERROR);
+    OS_workpool_table[1].worker[1].exited = true;
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolDelete(1), OS_ERROR);
+    UT_ClearForceFail(UT_KEY(OS_WorkPoolDelete_Impl));
+
+    UT_SetForceFail(UT_KEY(OS_TaskGetId_Impl), 101);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolDelete(1), OS_ERR_INCORRECT_OBJ_STATE);
+    UT_ClearForceFail(UT_KEY(OS_TaskGetId_Impl));
+
+    UT_SetForceFail(UT_KEY(OS_ObjectIdGetById), OS_ERR_INVALID_ID);
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolDelete(1), OS_ERR_INVALID_ID);
+}
+
+void Test_OS_WorkPoolGetIdByName(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_WorkPoolGetIdByName (uint32 *pool_id, const char *pool_name)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+    uint32 objid = 0;
+
+    UT_SetForceFail(UT_KEY(OS_ObjectIdFindByName), OS_SUCCESS);
+    actual = OS_WorkPoolGetIdByName(&objid, "UT");
+    UtAssert_True(actual == expected, "OS_WorkPoolGetIdByName() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(objid != 0, "OS_WorkPoolGetIdByName() objid (%lu) != 0", (unsigned long)objid);
+    UT_ClearForceFail(UT_KEY(OS_ObjectIdFindByName));
+
+    expected = OS_ERR_NAME_NOT_FOUND;
+    actual = OS_WorkPoolGetIdByName(&objid, "NF");
+    UtAssert_True(actual == expected, "OS_WorkPoolGetIdByName() (%ld) == %ld",
+            (long)actual, (long)expected);
+
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolGetIdByName(NULL, NULL), OS_INVALID_POINTER);
+
+}
+
+void Test_OS_WorkPoolGetInfo(void)
+{
+    /*
+     * Test Case For:
+     * int32 OS_WorkPoolGetInfo (uint32 pool_id, OS_workpool_prop_t *pool_prop)
+     */
+    int32 expected = OS_SUCCESS;
+    int32 actual = ~OS_SUCCESS;
+    OS_workpool_prop_t prop;
+    uint32 local_index = 1;
+    OS_common_record_t utrec;
+    OS_common_record_t *rptr = &utrec;
+
+    memset(&utrec, 0, sizeof(utrec));
+    utrec.creator = 111;
+    utrec.name_entry = "ABC";
+    UT_SetupPool();
+    UT_QueueJob(0);
+    UT_QueueJob(0);
+    UT_QueueJob(1);
+    OS_workpool_table[1].worker[0].head = 1;
+    OS_workpool_table[1].worker[0].completed = 1;
+    OS_workpool_table[1].worker[1].stolen = 1;
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &local_index, sizeof(local_index), false);
+    UT_SetDataBuffer(UT_KEY(OS_ObjectIdGetById), &rptr, sizeof(rptr), false);
+    actual = OS_WorkPoolGetInfo(1, &prop);
+
+    UtAssert_True(actual == expected, "OS_WorkPoolGetInfo() (%ld) == OS_SUCCESS", (long)actual);
+    UtAssert_True(prop.creator == 111, "prop.creator (%lu) == 111",
+            (unsigned long)prop.creator);
+    UtAssert_True(strcmp(prop.name, "ABC") == 0, "prop.name (%s) == ABC",
+            prop.name);
+    UtAssert_True(prop.num_workers == 2, "prop.num_workers (%lu) == 2",
+            (unsigned long)prop.num_workers);
+    UtAssert_True(prop.jobs_submitted == 3, "prop.jobs_submitted (%lu) == 3",
+            (unsigned long)prop.jobs_submitted);
+    UtAssert_True(prop.jobs_completed == 1, "prop.jobs_completed (%lu) == 1",
+            (unsigned long)prop.jobs_completed);
+    UtAssert_True(prop.jobs_stolen == 1, "prop.jobs_stolen (%lu) == 1",
+            (unsigned long)prop.jobs_stolen);
+    UtAssert_True(prop.jobs_pending == 2, "prop.jobs_pending (%lu) == 2",
+            (unsigned long)prop.jobs_pending);
+
+    OSAPI_TEST_FUNCTION_RC(OS_WorkPoolGetInfo(0, NULL), OS_INVALID_POINTER);
+
+}
+
+
+/* Osapi_Task_Setup
+ *
+ * Purpose:
+ *   Called by the unit test tool to set up the app prior to each test
+ */
+void Osapi_Task_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Osapi_TearDown
+ *
+ * Purpose:
+ *   Called by the unit test tool to tear down the app after each test
+ */
+void Osapi_TearDown(void)
+{
+
+}
+
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void OS_Application_Startup(void)
+{
+    ADD_TEST(OS_WorkPoolAPI_Init);
+    ADD_TEST(OS_WorkPoolCreate);
+    ADD_TEST(OS_WorkSubmit);
+    ADD_TEST(OS_WorkPoolWorkerEntry);
+    ADD_TEST(OS_WorkPoolWaitIdle);
+    ADD_TEST(OS_WorkPoolDelete);
+    ADD_TEST(OS_WorkPoolGetIdByName);
+    ADD_TEST(OS_WorkPoolGetInfo);
+}
+
@@ -2,6 +2,8 @@
 #ifndef _OSAL_STUB_PTHREAD_H_
 #define _OSAL_STUB_PTHREAD_H_
 
+#include <overrides/time.h>
+
 /* ----------------------------------------- */
 /* constants normally defined in pthread.h */
 /* ----------------------------------------- */
@@ -49,6 +51,7 @@ extern int OCS_pthread_create (OCS_pthread_t * newthread, const OCS_pthread_attr
 extern int OCS_pthread_detach (OCS_pthread_t th);
 extern int OCS_pthread_equal (OCS_pthread_t thread1, OCS_pthread_t thread2);
 extern void OCS_pthread_exit (void * retval);
+extern int OCS_pthread_getcpuclockid (OCS_pthread_t thread_id, OCS_clockid_t * clock_id);
 extern int OCS_pthread_getschedparam (OCS_pthread_t target_thread, int * policy, struct OCS_sched_param * param);
 extern void *OCS_pthread_getspecific (OCS_pthread_key_t key);
 extern int OCS_pthread_key_create (OCS_pthread_key_t * key, void (* destr_function) (void *));
@@ -59,8 +62,10 @@ extern int OCS_pthread_mutexattr_settype (OCS_pthread_mutexattr_t * attr, int ki
 extern int OCS_pthread_mutex_destroy (OCS_pthread_mutex_t * mutex);
 extern int OCS_pthread_mutex_init (OCS_pthread_mutex_t * mutex, const OCS_pthread_mutexattr_t * mutexattr);
 extern int OCS_pthread_mutex_lock (OCS_pthread_mutex_t * mutex);
+extern int OCS_pthread_mutex_trylock (OCS_pthread_mutex_t * mutex);
 extern int OCS_pthread_mutex_unlock (OCS_pthread_mutex_t * mutex);
 extern OCS_pthread_t OCS_pthread_self (void);
+extern int OCS_pthread_setname_np (OCS_pthread_t target_thread, const char * name);
 extern int OCS_pthread_setschedparam (OCS_pthread_t target_thread, int policy, const struct OCS_sched_param * param);
 extern int OCS_pthread_setschedprio (OCS_pthread_t target_thread, int prio);
 extern int OCS_pthread_setspecific (OCS_pthread_key_t key, const void * pointer);
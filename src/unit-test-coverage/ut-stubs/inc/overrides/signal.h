@@ -14,6 +14,7 @@
 #define OCS_SIGBUS                       0x1105
 #define OCS_SIGFPE                       0x1106
 #define OCS_SIGILL                       0x1107
+#define OCS_SIGXCPU                      0x1108
 #define OCS_SIGRTMIN                     0x1110
 #define OCS_SIGRTMAX                     0x1120
 
@@ -16,6 +16,7 @@ typedef unsigned long   OCS_size_t;
 /* ----------------------------------------- */
 
 extern void *OCS_memcpy (void * dest, const void * src, OCS_size_t n);
+extern void *OCS_memmove (void * dest, const void * src, OCS_size_t n);
 extern void *OCS_memset (void * s, int c, OCS_size_t n);
 extern int OCS_strcmp (const char * s1, const char * s2);
 extern char *OCS_strcpy (char * dest, const char * src);
@@ -0,0 +1,22 @@
+/* OSAL coverage stub replacement for sys/syscall.h */
+#ifndef _OSAL_STUB_SYS_SYSCALL_H_
+#define _OSAL_STUB_SYS_SYSCALL_H_
+
+/* ----------------------------------------- */
+/* constants normally defined in sys/syscall.h */
+/* ----------------------------------------- */
+
+#define OCS_SYS_gettid      0x1D01
+
+/* ----------------------------------------- */
+/* types normally defined in sys/syscall.h */
+/* ----------------------------------------- */
+
+/* ----------------------------------------- */
+/* prototypes normally declared in sys/syscall.h */
+/* ----------------------------------------- */
+
+
+
+#endif /* _OSAL_STUB_SYS_SYSCALL_H_ */
+
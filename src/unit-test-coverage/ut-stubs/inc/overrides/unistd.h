@@ -36,6 +36,7 @@ extern OCS_off_t OCS_lseek (int fd, OCS_off_t offset, int whence);
 extern OCS_ssize_t OCS_read (int fd, void * buf, OCS_size_t nbytes);
 extern int OCS_rmdir (const char * path);
 extern long int OCS_sysconf (int name);
+extern long int OCS_syscall (long int sysno, ...);
 extern OCS_ssize_t OCS_write (int fd, const void * buf, OCS_size_t n);
 
 
@@ -44,6 +44,25 @@ void *OCS_memcpy (void * dest, const void * src, OCS_size_t n)
     return Result;
 }
 
+void *OCS_memmove (void * dest, const void * src, OCS_size_t n)
+{
+    int32 Status;
+    void *Result;
+
+    Status = UT_DEFAULT_IMPL(OCS_memmove);
+
+    if (Status == 0)
+    {
+        Result = memmove(dest, src, n);
+    }
+    else
+    {
+        Result = NULL;
+    }
+
+    return Result;
+}
+
 char *OCS_strchr(const char *s, int c)
 {
     int32 Status;
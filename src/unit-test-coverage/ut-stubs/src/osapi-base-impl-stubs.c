@@ -32,6 +32,8 @@ void  OS_ApplicationShutdown_Impl    (void)
     UT_DEFAULT_IMPL(OS_ApplicationShutdown_Impl);
 }
 
+UT_DEFAULT_STUB(OS_API_LockMemory_Impl, (void))
+
 /*
 ** Function prototypes for routines implemented in OS-specific layers
 */
@@ -57,12 +59,45 @@ void OS_TaskExit_Impl               (void)
 }
 
 UT_DEFAULT_STUB(OS_TaskDelay_Impl,(uint32 millisecond))
+UT_DEFAULT_STUB(OS_TaskDelayMicros_Impl,(uint32 microsecond))
+UT_DEFAULT_STUB(OS_TaskDelayUntil_Impl,(const OS_time_t *wake_time))
 UT_DEFAULT_STUB(OS_TaskSetPriority_Impl,(uint32 task_id, uint32 new_priority))
+UT_DEFAULT_STUB(OS_TaskSetAffinity_Impl,(uint32 task_id, uint32 cpu_mask))
+UT_DEFAULT_STUB(OS_TaskSetDeadline_Impl,(uint32 task_id, uint32 runtime_usec, uint32 deadline_usec, uint32 period_usec))
 uint32 OS_TaskGetId_Impl            (void)
 {
     return UT_DEFAULT_IMPL(OS_TaskGetId_Impl);
 }
+uint32 OS_TaskGetSelf_Impl           (uint32 *local_id)
+{
+    uint32 task_id;
+
+    task_id = UT_DEFAULT_IMPL(OS_TaskGetSelf_Impl);
+    if (UT_Stub_CopyToLocal(UT_KEY(OS_TaskGetSelf_Impl), local_id, sizeof(*local_id)) < sizeof(*local_id))
+    {
+        *local_id = 0;
+    }
+
+    return task_id;
+}
 UT_DEFAULT_STUB(OS_TaskGetInfo_Impl,(uint32 task_id, OS_task_prop_t *task_prop))
+int32 OS_TaskGetStats_Impl            (uint32 task_id, OS_task_stats_t *task_stats, uint32 *os_thread_id)
+{
+    int32 Status;
+
+    Status = UT_DEFAULT_IMPL(OS_TaskGetStats_Impl);
+    if (Status == OS_SUCCESS)
+    {
+        UT_Stub_CopyToLocal(UT_KEY(OS_TaskGetStats_Impl), os_thread_id, sizeof(*os_thread_id));
+    }
+
+    return Status;
+}
+void OS_TaskGetThreadStats_Impl      (uint32 os_thread_id, OS_task_stats_t *task_stats)
+{
+    UT_DEFAULT_IMPL(OS_TaskGetThreadStats_Impl);
+}
+UT_DEFAULT_STUB(OS_TaskGetStackPoolStats_Impl,(OS_stack_pool_stats_t *stats))
 UT_DEFAULT_STUB(OS_TaskRegister_Impl,(uint32 global_task_id))
 
 /*
@@ -75,6 +110,7 @@ UT_DEFAULT_STUB(OS_TaskRegister_Impl,(uint32 global_task_id))
 UT_DEFAULT_STUB(OS_QueueCreate_Impl,(uint32 queue_id, uint32 flags))
 UT_DEFAULT_STUB(OS_QueueDelete_Impl,(uint32 queue_id))
 UT_DEFAULT_STUB(OS_QueueGet_Impl,(uint32 queue_id, void *data, uint32 size, uint32 *size_copied, int32 timeout))
+UT_DEFAULT_STUB(OS_QueueGetMicros_Impl,(uint32 queue_id, void *data, uint32 size, uint32 *size_copied, int32 timeout_usec))
 UT_DEFAULT_STUB(OS_QueuePut_Impl,(uint32 queue_id, const void *data, uint32 size, uint32 flags))
 UT_DEFAULT_STUB(OS_QueueGetInfo_Impl,(uint32 queue_id, OS_queue_prop_t *queue_prop))
 
@@ -87,6 +123,7 @@ UT_DEFAULT_STUB(OS_BinSemFlush_Impl,(uint32 sem_id))
 UT_DEFAULT_STUB(OS_BinSemGive_Impl,(uint32 sem_id))
 UT_DEFAULT_STUB(OS_BinSemTake_Impl,(uint32 sem_id))
 UT_DEFAULT_STUB(OS_BinSemTimedWait_Impl,(uint32 sem_id, uint32 msecs))
+UT_DEFAULT_STUB(OS_BinSemTimedWaitMicros_Impl,(uint32 sem_id, uint32 usecs))
 UT_DEFAULT_STUB(OS_BinSemDelete_Impl,(uint32 sem_id))
 UT_DEFAULT_STUB(OS_BinSemGetInfo_Impl,(uint32 sem_id, OS_bin_sem_prop_t *bin_prop))
 
@@ -94,6 +131,7 @@ UT_DEFAULT_STUB(OS_CountSemCreate_Impl,(uint32 sem_id, uint32 sem_initial_value,
 UT_DEFAULT_STUB(OS_CountSemGive_Impl,(uint32 sem_id))
 UT_DEFAULT_STUB(OS_CountSemTake_Impl,(uint32 sem_id))
 UT_DEFAULT_STUB(OS_CountSemTimedWait_Impl,(uint32 sem_id, uint32 msecs))
+UT_DEFAULT_STUB(OS_CountSemTimedWaitMicros_Impl,(uint32 sem_id, uint32 usecs))
 UT_DEFAULT_STUB(OS_CountSemDelete_Impl,(uint32 sem_id))
 UT_DEFAULT_STUB(OS_CountSemGetInfo_Impl,(uint32 sem_id, OS_count_sem_prop_t *count_prop))
 
@@ -107,6 +145,63 @@ UT_DEFAULT_STUB(OS_MutSemTake_Impl,(uint32 sem_id))
 UT_DEFAULT_STUB(OS_MutSemDelete_Impl,(uint32 sem_id))
 UT_DEFAULT_STUB(OS_MutSemGetInfo_Impl,(uint32 sem_id, OS_mut_sem_prop_t *mut_prop))
 
+/*
+** Condition variable API
+*/
+
+UT_DEFAULT_STUB(OS_CondVarCreate_Impl,(uint32 var_id, uint32 options))
+UT_DEFAULT_STUB(OS_CondVarDelete_Impl,(uint32 var_id))
+UT_DEFAULT_STUB(OS_CondVarLock_Impl,(uint32 var_id))
+UT_DEFAULT_STUB(OS_CondVarUnlock_Impl,(uint32 var_id))
+UT_DEFAULT_STUB(OS_CondVarSignal_Impl,(uint32 var_id))
+UT_DEFAULT_STUB(OS_CondVarBroadcast_Impl,(uint32 var_id))
+UT_DEFAULT_STUB(OS_CondVarWait_Impl,(uint32 var_id))
+UT_DEFAULT_STUB(OS_CondVarTimedWait_Impl,(uint32 var_id, uint32 msecs))
+UT_DEFAULT_STUB(OS_CondVarGetInfo_Impl,(uint32 var_id, OS_condvar_prop_t *condvar_prop))
+
+/*
+** Barrier API
+*/
+
+UT_DEFAULT_STUB(OS_BarrierCreate_Impl,(uint32 barrier_id, uint32 options))
+UT_DEFAULT_STUB(OS_BarrierDelete_Impl,(uint32 barrier_id))
+UT_DEFAULT_STUB(OS_BarrierWait_Impl,(uint32 barrier_id))
+UT_DEFAULT_STUB(OS_BarrierGetInfo_Impl,(uint32 barrier_id, OS_barrier_prop_t *barrier_prop))
+
+/*
+** Worker Pool API
+*/
+
+UT_DEFAULT_STUB(OS_WorkPoolCreate_Impl,(uint32 pool_id))
+UT_DEFAULT_STUB(OS_WorkPoolDelete_Impl,(uint32 pool_id))
+UT_DEFAULT_STUB(OS_WorkPoolLock_Impl,(uint32 pool_id, uint32 lock_idx))
+UT_DEFAULT_STUB(OS_WorkPoolUnlock_Impl,(uint32 pool_id, uint32 lock_idx))
+UT_DEFAULT_STUB(OS_WorkPoolPost_Impl,(uint32 pool_id))
+UT_DEFAULT_STUB(OS_WorkPoolPend_Impl,(uint32 pool_id))
+UT_DEFAULT_STUB(OS_WorkPoolIdleWait_Impl,(uint32 pool_id, int32 msecs))
+UT_DEFAULT_STUB(OS_WorkPoolIdleNotify_Impl,(uint32 pool_id))
+
+/*
+** Fiber API
+*/
+
+UT_DEFAULT_STUB(OS_FiberCreate_Impl,(uint32 fiber_id, uint32 flags))
+UT_DEFAULT_STUB(OS_FiberDelete_Impl,(uint32 fiber_id))
+UT_DEFAULT_STUB(OS_FiberSwitchIn_Impl,(uint32 fiber_id))
+UT_DEFAULT_STUB(OS_FiberSwitchOut_Impl,(uint32 fiber_id))
+UT_DEFAULT_STUB(OS_FiberTaskInit_Impl,(uint32 task_id))
+UT_DEFAULT_STUB(OS_FiberIdle_Impl,(uint32 task_id, OS_FdSet *ReadSet, OS_FdSet *WriteSet, int64 timeout_usec))
+
+void OS_FiberNotifyEnable_Impl(uint32 task_id, bool enable)
+{
+    UT_DEFAULT_IMPL(OS_FiberNotifyEnable_Impl);
+}
+
+void OS_FiberNotify_Impl(void)
+{
+    UT_DEFAULT_IMPL(OS_FiberNotify_Impl);
+}
+
 /*
 ** Console output API (printf)
 */
@@ -159,6 +254,8 @@ UT_DEFAULT_STUB(OS_IntGetMask_Impl,( uint32 * MaskSettingPtr ))
  * Heap API low-level handler
  */
 UT_DEFAULT_STUB(OS_HeapGetInfo_Impl,(OS_heap_prop_t *heap_prop))
+UT_DEFAULT_STUB(OS_HeapLockdown_Impl,(uint32 options))
+UT_DEFAULT_STUB(OS_HeapGetLateAllocs_Impl,(uint32 *count))
 
 /*
  * FPU API low-level handlers
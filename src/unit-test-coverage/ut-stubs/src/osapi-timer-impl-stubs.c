@@ -17,7 +17,7 @@
 ** OS Time/Tick related API
 */
 UT_DEFAULT_STUB(OS_TimeBaseCreate_Impl,(uint32 timer_id))
-UT_DEFAULT_STUB(OS_TimeBaseSet_Impl,(uint32 timer_id, int32 start_time, int32 interval_time))
+UT_DEFAULT_STUB(OS_TimeBaseSet_Impl,(uint32 timer_id, uint64 start_time, uint64 interval_time))
 UT_DEFAULT_STUB(OS_TimeBaseDelete_Impl,(uint32 timer_id))
 void  OS_TimeBaseLock_Impl          (uint32 timebase_id)
 {
@@ -30,12 +30,80 @@ void  OS_TimeBaseUnlock_Impl        (uint32 timebase_id)
 }
 
 UT_DEFAULT_STUB(OS_TimeBaseGetInfo_Impl,(uint32 timer_id, OS_timebase_prop_t *timer_prop))
+UT_DEFAULT_STUB(OS_TimeBaseSetTickless_Impl,(uint32 timer_id, bool tickless))
+void  OS_TimeBaseNextDue_Impl       (uint32 timer_id, uint64 tick_time, uint64 wait_time)
+{
+    UT_DEFAULT_IMPL(OS_TimeBaseNextDue_Impl);
+}
+
+int32 OS_TimeBaseTickLateness_Impl  (uint32 timer_id, uint64 tick_time, uint32 *lateness_usec)
+{
+    int32 Status;
+
+    Status = UT_DEFAULT_IMPL(OS_TimeBaseTickLateness_Impl);
+    if (Status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_TimeBaseTickLateness_Impl), lateness_usec, sizeof(*lateness_usec)) < sizeof(*lateness_usec))
+    {
+        *lateness_usec = 0;
+    }
+
+    return Status;
+}
+
+uint64 OS_TimeBaseSkippedTime_Impl  (uint32 timer_id)
+{
+    return UT_DEFAULT_IMPL(OS_TimeBaseSkippedTime_Impl);
+}
 
 UT_DEFAULT_STUB(OS_TimeBaseRegister_Impl,(uint32 timebase_id))
 /*
  * Clock API low-level handlers
  */
 UT_DEFAULT_STUB(OS_GetLocalTime_Impl,(OS_time_t *time_struct))
+int32 OS_GetMonotonicTime_Impl(OS_time_t *time_struct)
+{
+    int32 Status;
+
+    Status = UT_DEFAULT_IMPL(OS_GetMonotonicTime_Impl);
+
+    if (Status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_GetMonotonicTime_Impl), time_struct, sizeof(*time_struct)) < sizeof(*time_struct))
+    {
+        memset(time_struct, 0, sizeof(*time_struct));
+    }
+
+    return Status;
+}
+int32 OS_GetHighResTicks_Impl(uint64 *ticks)
+{
+    int32 Status;
+
+    Status = UT_DEFAULT_IMPL(OS_GetHighResTicks_Impl);
+
+    if (Status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_GetHighResTicks_Impl), ticks, sizeof(*ticks)) < sizeof(*ticks))
+    {
+        *ticks = 0;
+    }
+
+    return Status;
+}
+int32 OS_GetHighResTickRate_Impl(uint64 *ticks_per_sec)
+{
+    int32 Status;
+
+    Status = UT_DEFAULT_IMPL(OS_GetHighResTickRate_Impl);
+
+    if (Status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_GetHighResTickRate_Impl), ticks_per_sec, sizeof(*ticks_per_sec)) < sizeof(*ticks_per_sec))
+    {
+        *ticks_per_sec = 1000000000;
+    }
+
+    return Status;
+}
 UT_DEFAULT_STUB(OS_SetLocalTime_Impl,(const OS_time_t *time_struct))
+UT_DEFAULT_STUB(OS_VirtualTimeAdvance_Impl,(uint64 nsecs))
+UT_DEFAULT_STUB(OS_VirtualTimeSetAuto_Impl,(bool auto_advance))
 
 
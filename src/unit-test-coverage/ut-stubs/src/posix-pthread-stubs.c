@@ -167,6 +167,15 @@ void OCS_pthread_exit (void * retval)
     UT_DEFAULT_IMPL(OCS_pthread_exit);
 }
 
+int OCS_pthread_getcpuclockid (OCS_pthread_t thread_id, OCS_clockid_t * clock_id)
+{
+    int32 Status;
+
+    Status = UT_DEFAULT_IMPL(OCS_pthread_getcpuclockid);
+
+    return Status;
+}
+
 int OCS_pthread_getschedparam (OCS_pthread_t target_thread, int * policy, struct OCS_sched_param * param)
 {
     int32 Status;
@@ -265,6 +274,15 @@ int OCS_pthread_mutex_lock (OCS_pthread_mutex_t * mutex)
     return Status;
 }
 
+int OCS_pthread_mutex_trylock (OCS_pthread_mutex_t * mutex)
+{
+    int32 Status;
+
+    Status = UT_DEFAULT_IMPL(OCS_pthread_mutex_trylock);
+
+    return Status;
+}
+
 int OCS_pthread_mutex_unlock (OCS_pthread_mutex_t * mutex)
 {
     int32 Status;
@@ -283,6 +301,15 @@ OCS_pthread_t OCS_pthread_self (void)
     return Status;
 }
 
+int OCS_pthread_setname_np (OCS_pthread_t target_thread, const char * name)
+{
+    int32 Status;
+
+    Status = UT_DEFAULT_IMPL(OCS_pthread_setname_np);
+
+    return Status;
+}
+
 int OCS_pthread_setschedparam (OCS_pthread_t target_thread, int policy, const struct OCS_sched_param * param)
 {
     int32 Status;
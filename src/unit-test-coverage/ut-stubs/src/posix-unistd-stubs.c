@@ -75,6 +75,16 @@ OCS_pid_t OCS_getpid (void)
 }
 
 
+long int OCS_syscall (long int sysno, ...)
+{
+    int32 Status;
+
+    Status = UT_DEFAULT_IMPL(OCS_syscall);
+
+    return Status;
+}
+
+
 OCS_off_t OCS_lseek (int fd, OCS_off_t offset, int whence)
 {
     int32 Status;
@@ -171,10 +171,13 @@ void Test_OS_VxWorks_SigWait(void)
 void Test_OS_TimeBaseSet_Impl(void)
 {
     /* Test Case For:
-     * int32 OS_TimeBaseSet_Impl(uint32 timer_id, int32 start_time, int32 interval_time)
+     * int32 OS_TimeBaseSet_Impl(uint32 timer_id, uint64 start_ns, uint64 interval_ns)
      */
     OSAPI_TEST_FUNCTION_RC(OS_TimeBaseSet_Impl(0,1,1), OS_ERR_NOT_IMPLEMENTED);
 
+    /* beyond what the kernel timer can take in microseconds */
+    OSAPI_TEST_FUNCTION_RC(OS_TimeBaseSet_Impl(0,1ULL << 50,1), OS_TIMER_ERR_INVALID_ARGS);
+
     Osapi_Internal_Setup(0, OCS_SIGRTMIN, false);
     OSAPI_TEST_FUNCTION_RC(OS_TimeBaseSet_Impl(0,1,1), OS_SUCCESS);
 
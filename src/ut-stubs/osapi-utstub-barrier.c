@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2004-2018, United States government as represented by the
+ *  administrator of the National Aeronautics Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ *
+ *  This is governed by the NASA Open Source Agreement and may be used,
+ *  distributed and modified only according to the terms of that agreement.
+ */
+
+/**
+ * \file osapi-utstub-barrier.c
+ *
+ * Stub implementations for the functions defined in the OSAL API
+ *
+ * The stub implementation can be used for unit testing applications built
+ * on top of OSAL.  The stubs do not do any real function, but allow
+ * the return code to be crafted such that error paths in the application
+ * can be executed.
+ */
+
+#include "utstub-helpers.h"
+
+
+UT_DEFAULT_STUB(OS_BarrierAPI_Init,(void))
+
+/*****************************************************************************
+ *
+ * Stub function for OS_BarrierCreate()
+ *
+ *****************************************************************************/
+int32 OS_BarrierCreate(uint32 *barrier_id, const char *barrier_name, uint32 count, uint32 options)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_BarrierCreate);
+
+    if (status == OS_SUCCESS)
+    {
+        *barrier_id = UT_AllocStubObjId(UT_OBJTYPE_BARRIER);
+    }
+    else
+    {
+        *barrier_id = 0xDEADBEEFU;
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_BarrierDelete()
+ *
+ *****************************************************************************/
+int32 OS_BarrierDelete(uint32 barrier_id)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_BarrierDelete);
+
+    if (status == OS_SUCCESS)
+    {
+        UT_DeleteStubObjId(UT_OBJTYPE_BARRIER, barrier_id);
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_BarrierWait()
+ *
+ *****************************************************************************/
+int32 OS_BarrierWait(uint32 barrier_id)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_BarrierWait);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_BarrierGetIdByName()
+ *
+ *****************************************************************************/
+int32 OS_BarrierGetIdByName(uint32 *barrier_id, const char *barrier_name)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_BarrierGetIdByName);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_BarrierGetIdByName), barrier_id, sizeof(*barrier_id)) < sizeof(*barrier_id))
+    {
+        *barrier_id =  1;
+        UT_FIXUP_ID(*barrier_id, UT_OBJTYPE_BARRIER);
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_BarrierGetInfo()
+ *
+ *****************************************************************************/
+int32 OS_BarrierGetInfo(uint32 barrier_id, OS_barrier_prop_t *barrier_prop)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_BarrierGetInfo);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_BarrierGetInfo), barrier_prop, sizeof(*barrier_prop)) < sizeof(*barrier_prop))
+    {
+        strncpy(barrier_prop->name, "Name", OS_MAX_API_NAME - 1);
+        barrier_prop->name[OS_MAX_API_NAME - 1] = '\0';
+        barrier_prop->creator =  1;
+        UT_FIXUP_ID(barrier_prop->creator, UT_OBJTYPE_TASK);
+        barrier_prop->count = 1;
+    }
+
+    return status;
+}
@@ -244,6 +244,20 @@ int32 OS_BinSemTimedWait(uint32 sem_id, uint32 msecs)
     return status;
 }
 
+/*****************************************************************************
+ *
+ * Stub function for OS_BinSemTimedWaitMicros()
+ *
+ *****************************************************************************/
+int32 OS_BinSemTimedWaitMicros(uint32 sem_id, uint32 usecs)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_BinSemTimedWaitMicros);
+
+    return status;
+}
+
 /*****************************************************************************
  *
  * Stub function for OS_BinSemGetIdByName()
@@ -50,6 +50,99 @@ int32 OS_GetLocalTime(OS_time_t *time_struct)
 
 }/* end OS_GetLocalTime */
 
+/*****************************************************************************
+ *
+ * Stub function for OS_GetMonotonicTime()
+ *
+ *****************************************************************************/
+int32 OS_GetMonotonicTime(OS_time_t *time_struct)
+{
+    int32 status;
+    uint32 count;
+
+    UT_Stub_RegisterContext(UT_KEY(OS_GetMonotonicTime), time_struct);
+    status = UT_DEFAULT_IMPL(OS_GetMonotonicTime);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_GetMonotonicTime), time_struct, sizeof(*time_struct)) < sizeof(*time_struct))
+    {
+        count = UT_GetStubCount(UT_KEY(OS_GetMonotonicTime));
+        time_struct->microsecs = 10000 * (count % 100);
+        time_struct->seconds = 1 + (count / 100);
+    }
+
+    return status;
+
+} /*end OS_GetMonotonicTime */
+
+/*****************************************************************************
+ *
+ * Stub function for OS_GetHighResTicks()
+ *
+ *****************************************************************************/
+int32 OS_GetHighResTicks(uint64 *ticks)
+{
+    int32 status;
+
+    UT_Stub_RegisterContext(UT_KEY(OS_GetHighResTicks), ticks);
+    status = UT_DEFAULT_IMPL(OS_GetHighResTicks);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_GetHighResTicks), ticks, sizeof(*ticks)) < sizeof(*ticks))
+    {
+        *ticks = 1000 * (uint64)UT_GetStubCount(UT_KEY(OS_GetHighResTicks));
+    }
+
+    return status;
+
+} /*end OS_GetHighResTicks */
+
+/*****************************************************************************
+ *
+ * Stub function for OS_HighResTicksToNs()
+ *
+ *****************************************************************************/
+int32 OS_HighResTicksToNs(uint64 ticks, uint64 *ns)
+{
+    int32 status;
+
+    UT_Stub_RegisterContext(UT_KEY(OS_HighResTicksToNs), &ticks);
+    UT_Stub_RegisterContext(UT_KEY(OS_HighResTicksToNs), ns);
+    status = UT_DEFAULT_IMPL(OS_HighResTicksToNs);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_HighResTicksToNs), ns, sizeof(*ns)) < sizeof(*ns))
+    {
+        *ns = ticks;
+    }
+
+    return status;
+
+} /*end OS_HighResTicksToNs */
+
+/*****************************************************************************
+ *
+ * Stub function for OS_NsToHighResTicks()
+ *
+ *****************************************************************************/
+int32 OS_NsToHighResTicks(uint64 ns, uint64 *ticks)
+{
+    int32 status;
+
+    UT_Stub_RegisterContext(UT_KEY(OS_NsToHighResTicks), &ns);
+    UT_Stub_RegisterContext(UT_KEY(OS_NsToHighResTicks), ticks);
+    status = UT_DEFAULT_IMPL(OS_NsToHighResTicks);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_NsToHighResTicks), ticks, sizeof(*ticks)) < sizeof(*ticks))
+    {
+        *ticks = ns;
+    }
+
+    return status;
+
+} /*end OS_NsToHighResTicks */
+
 /*****************************************************************************
  *
  * Stub function for OS_SetLocalTime()
@@ -66,3 +159,35 @@ int32 OS_SetLocalTime(OS_time_t *time_struct)
 
 } /*end OS_SetLocalTime */
 
+/*****************************************************************************
+ *
+ * Stub function for OS_VirtualTimeAdvance()
+ *
+ *****************************************************************************/
+int32 OS_VirtualTimeAdvance(uint64 nsecs)
+{
+    int32 status;
+
+    UT_Stub_RegisterContext(UT_KEY(OS_VirtualTimeAdvance), &nsecs);
+    status = UT_DEFAULT_IMPL(OS_VirtualTimeAdvance);
+
+    return status;
+
+} /*end OS_VirtualTimeAdvance */
+
+/*****************************************************************************
+ *
+ * Stub function for OS_VirtualTimeSetAuto()
+ *
+ *****************************************************************************/
+int32 OS_VirtualTimeSetAuto(bool auto_advance)
+{
+    int32 status;
+
+    UT_Stub_RegisterContext(UT_KEY(OS_VirtualTimeSetAuto), &auto_advance);
+    status = UT_DEFAULT_IMPL(OS_VirtualTimeSetAuto);
+
+    return status;
+
+} /*end OS_VirtualTimeSetAuto */
+
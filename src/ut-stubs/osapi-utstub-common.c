@@ -39,6 +39,44 @@ int32 OS_API_Init(void)
     return status;
 }
 
+/*****************************************************************************
+ *
+ * Stub function for OS_API_InitRealtime()
+ *
+ *****************************************************************************/
+int32 OS_API_InitRealtime(uint32 rt_options)
+{
+    int32 status;
+
+    UT_Stub_RegisterContext(UT_KEY(OS_API_InitRealtime), &rt_options);
+
+    status = UT_DEFAULT_IMPL(OS_API_InitRealtime);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_API_GetRealtimeInfo()
+ *
+ *****************************************************************************/
+int32 OS_API_GetRealtimeInfo(OS_realtime_prop_t *rt_prop)
+{
+    int32 status;
+
+    UT_Stub_RegisterContext(UT_KEY(OS_API_GetRealtimeInfo), rt_prop);
+
+    status = UT_DEFAULT_IMPL(OS_API_GetRealtimeInfo);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_API_GetRealtimeInfo), rt_prop, sizeof(*rt_prop)) < sizeof(*rt_prop))
+    {
+        memset(rt_prop, 0, sizeof(*rt_prop));
+    }
+
+    return status;
+}
+
 
 /*****************************************************************************
  *
@@ -0,0 +1,195 @@
+/*
+ *  Copyright (c) 2004-2018, United States government as represented by the
+ *  administrator of the National Aeronautics Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ *
+ *  This is governed by the NASA Open Source Agreement and may be used,
+ *  distributed and modified only according to the terms of that agreement.
+ */
+
+/**
+ * \file osapi-utstub-condvar.c
+ *
+ * Stub implementations for the functions defined in the OSAL API
+ *
+ * The stub implementation can be used for unit testing applications built
+ * on top of OSAL.  The stubs do not do any real function, but allow
+ * the return code to be crafted such that error paths in the application
+ * can be executed.
+ */
+
+#include "utstub-helpers.h"
+
+
+UT_DEFAULT_STUB(OS_CondVarAPI_Init,(void))
+
+/*****************************************************************************
+ *
+ * Stub function for OS_CondVarCreate()
+ *
+ *****************************************************************************/
+int32 OS_CondVarCreate(uint32 *var_id, const char *var_name, uint32 options)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_CondVarCreate);
+
+    if (status == OS_SUCCESS)
+    {
+        *var_id = UT_AllocStubObjId(UT_OBJTYPE_CONDVAR);
+    }
+    else
+    {
+        *var_id = 0xDEADBEEFU;
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_CondVarDelete()
+ *
+ *****************************************************************************/
+int32 OS_CondVarDelete(uint32 var_id)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_CondVarDelete);
+
+    if (status == OS_SUCCESS)
+    {
+        UT_DeleteStubObjId(UT_OBJTYPE_CONDVAR, var_id);
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_CondVarLock()
+ *
+ *****************************************************************************/
+int32 OS_CondVarLock(uint32 var_id)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_CondVarLock);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_CondVarUnlock()
+ *
+ *****************************************************************************/
+int32 OS_CondVarUnlock(uint32 var_id)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_CondVarUnlock);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_CondVarSignal()
+ *
+ *****************************************************************************/
+int32 OS_CondVarSignal(uint32 var_id)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_CondVarSignal);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_CondVarBroadcast()
+ *
+ *****************************************************************************/
+int32 OS_CondVarBroadcast(uint32 var_id)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_CondVarBroadcast);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_CondVarWait()
+ *
+ *****************************************************************************/
+int32 OS_CondVarWait(uint32 var_id)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_CondVarWait);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_CondVarTimedWait()
+ *
+ *****************************************************************************/
+int32 OS_CondVarTimedWait(uint32 var_id, uint32 msecs)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_CondVarTimedWait);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_CondVarGetIdByName()
+ *
+ *****************************************************************************/
+int32 OS_CondVarGetIdByName(uint32 *var_id, const char *var_name)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_CondVarGetIdByName);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_CondVarGetIdByName), var_id, sizeof(*var_id)) < sizeof(*var_id))
+    {
+        *var_id =  1;
+        UT_FIXUP_ID(*var_id, UT_OBJTYPE_CONDVAR);
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_CondVarGetInfo()
+ *
+ *****************************************************************************/
+int32 OS_CondVarGetInfo(uint32 var_id, OS_condvar_prop_t *condvar_prop)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_CondVarGetInfo);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_CondVarGetInfo), condvar_prop, sizeof(*condvar_prop)) < sizeof(*condvar_prop))
+    {
+        strncpy(condvar_prop->name, "Name", OS_MAX_API_NAME - 1);
+        condvar_prop->name[OS_MAX_API_NAME - 1] = '\0';
+        condvar_prop->creator =  1;
+        UT_FIXUP_ID(condvar_prop->creator, UT_OBJTYPE_TASK);
+    }
+
+    return status;
+}
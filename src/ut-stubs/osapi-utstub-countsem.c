@@ -128,6 +128,20 @@ int32 OS_CountSemTimedWait ( uint32 sem_id, uint32 msecs )
     return status;
 }
 
+/*****************************************************************************
+ *
+ * Stub for OS_CountSemTimedWaitMicros() function
+ *
+ *****************************************************************************/
+int32 OS_CountSemTimedWaitMicros ( uint32 sem_id, uint32 usecs )
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_CountSemTimedWaitMicros);
+
+    return status;
+}
+
 /*****************************************************************************
  *
  * Stub for OS_CountSemGetIdByName() function
@@ -0,0 +1,220 @@
+/*
+ *  Copyright (c) 2004-2018, United States government as represented by the
+ *  administrator of the National Aeronautics Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ *
+ *  This is governed by the NASA Open Source Agreement and may be used,
+ *  distributed and modified only according to the terms of that agreement.
+ */
+
+/**
+ * \file osapi-utstub-fiber.c
+ *
+ * Stub implementations for the functions defined in the OSAL API
+ *
+ * The stub implementation can be used for unit testing applications built
+ * on top of OSAL.  The stubs do not do any real function, but allow
+ * the return code to be crafted such that error paths in the application
+ * can be executed.
+ */
+
+#include "utstub-helpers.h"
+#include "os-impl.h"
+
+
+UT_DEFAULT_STUB(OS_FiberAPI_Init,(void))
+UT_DEFAULT_STUB(OS_FiberRun,(void))
+UT_DEFAULT_STUB(OS_FiberYield,(void))
+
+/*****************************************************************************
+ *
+ * Stub function for OS_FiberCreate()
+ *
+ *****************************************************************************/
+int32 OS_FiberCreate(uint32 *fiber_id, const char *fiber_name, OS_FiberFunc_t entry,
+                     void *arg, uint32 stack_size, uint32 flags)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_FiberCreate);
+
+    if (status == OS_SUCCESS)
+    {
+        *fiber_id = UT_AllocStubObjId(UT_OBJTYPE_FIBER);
+    }
+    else
+    {
+        *fiber_id = 0xDEADBEEFU;
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_FiberDelete()
+ *
+ *****************************************************************************/
+int32 OS_FiberDelete(uint32 fiber_id)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_FiberDelete);
+
+    if (status == OS_SUCCESS)
+    {
+        UT_DeleteStubObjId(UT_OBJTYPE_FIBER, fiber_id);
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_FiberGetId()
+ *
+ *****************************************************************************/
+uint32 OS_FiberGetId(void)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_FiberGetId);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_FiberGetIdByName()
+ *
+ *****************************************************************************/
+int32 OS_FiberGetIdByName(uint32 *fiber_id, const char *fiber_name)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_FiberGetIdByName);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_FiberGetIdByName), fiber_id, sizeof(*fiber_id)) < sizeof(*fiber_id))
+    {
+        *fiber_id =  1;
+        UT_FIXUP_ID(*fiber_id, UT_OBJTYPE_FIBER);
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_FiberDeleteAll()
+ *
+ *****************************************************************************/
+void OS_FiberDeleteAll(void)
+{
+    UT_DEFAULT_IMPL(OS_FiberDeleteAll);
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_FiberGetInfo()
+ *
+ *****************************************************************************/
+int32 OS_FiberGetInfo(uint32 fiber_id, OS_fiber_prop_t *fiber_prop)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_FiberGetInfo);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_FiberGetInfo), fiber_prop, sizeof(*fiber_prop)) < sizeof(*fiber_prop))
+    {
+        strncpy(fiber_prop->name, "Name", OS_MAX_API_NAME - 1);
+        fiber_prop->name[OS_MAX_API_NAME - 1] = '\0';
+        fiber_prop->creator =  1;
+        UT_FIXUP_ID(fiber_prop->creator, UT_OBJTYPE_TASK);
+        fiber_prop->host_task_id =  1;
+        UT_FIXUP_ID(fiber_prop->host_task_id, UT_OBJTYPE_TASK);
+    }
+
+    return status;
+}
+
+/*
+ * The fiber wait hooks are only called from within OSAL, the stubs
+ * support coverage testing of the blocking calls that use them.
+ */
+
+/*****************************************************************************
+ *
+ * Stub function for OS_FiberWaitStart()
+ *
+ * Returns false (not called from a fiber) unless a nonzero return code is set
+ *
+ *****************************************************************************/
+bool OS_FiberWaitStart(OS_fiber_wait_t *wait, int64 timeout_usec)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_FiberWaitStart);
+
+    return (status != 0);
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_FiberWaitRetry()
+ *
+ * Returns false (timed out) unless a nonzero return code is set
+ *
+ *****************************************************************************/
+bool OS_FiberWaitRetry(OS_fiber_wait_t *wait)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_FiberWaitRetry);
+
+    return (status != 0);
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_FiberSleep()
+ *
+ * Returns false (not called from a fiber) unless a nonzero return code is set
+ *
+ *****************************************************************************/
+bool OS_FiberSleep(uint64 usec)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_FiberSleep);
+
+    return (status != 0);
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_FiberWaitStream()
+ *
+ * Returns false (not called from a fiber) unless a nonzero return code is set
+ *
+ *****************************************************************************/
+bool OS_FiberWaitStream(uint32 stream_id, uint32 events, int32 msecs)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_FiberWaitStream);
+
+    return (status != 0);
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_FiberNotify()
+ *
+ *****************************************************************************/
+void OS_FiberNotify(void)
+{
+    UT_DEFAULT_IMPL(OS_FiberNotify);
+}
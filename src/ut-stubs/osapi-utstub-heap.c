@@ -48,4 +48,17 @@ int32 OS_HeapGetInfo(OS_heap_prop_t *heap_prop)
     return status;
 }
 
+/*****************************************************************************
+ *
+ * Stub function for OS_HeapLockdown()
+ *
+ *****************************************************************************/
+int32 OS_HeapLockdown(void)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_HeapLockdown);
+
+    return status;
+}
 
@@ -158,6 +158,36 @@ int32 OS_QueueGet(uint32 queue_id,
     return status;
 }
 
+/*****************************************************************************
+ *
+ * Stub function for OS_QueueGetMicros()
+ *
+ * Queue data is taken from the same buffer as OS_QueueGet(), so
+ * tests may use either call against the same setup.
+ *
+ *****************************************************************************/
+int32 OS_QueueGetMicros(uint32 queue_id,
+                  void *data,
+                  uint32 size,
+                  uint32 *size_copied,
+                  int32 timeout_usec)
+{
+    int32   status = OS_SUCCESS;
+
+    status = UT_DEFAULT_IMPL(OS_QueueGetMicros);
+
+    if (status == OS_SUCCESS)
+    {
+        *size_copied = UT_Stub_CopyToLocal((UT_EntryKey_t)&OS_QueueGet + queue_id, data, size);
+        if (*size_copied == 0)
+        {
+            status = OS_QUEUE_EMPTY;
+        }
+    }
+
+    return status;
+}
+
 /*****************************************************************************/
 /**
 ** \brief OS_QueuePut stub function
@@ -69,6 +69,36 @@ int32 OS_TaskCreate(uint32 *task_id, const char *task_name,
     return status;
 }
 
+/*****************************************************************************
+ *
+ * Stub function for OS_TaskCreateAffinity()
+ *
+ *****************************************************************************/
+int32 OS_TaskCreateAffinity(uint32 *task_id, const char *task_name,
+                    osal_task_entry function_pointer,
+                    uint32 *stack_pointer,
+                    uint32 stack_size, uint32 priority,
+                    uint32 flags, uint32 cpu_mask)
+{
+    int32 status = OS_SUCCESS;
+
+    UT_Stub_RegisterContext(UT_KEY(OS_TaskCreateAffinity), &function_pointer);
+    UT_Stub_RegisterContext(UT_KEY(OS_TaskCreateAffinity), stack_pointer);
+
+    status = UT_DEFAULT_IMPL(OS_TaskCreateAffinity);
+
+    if (status == OS_SUCCESS)
+    {
+        *task_id = UT_AllocStubObjId(UT_OBJTYPE_TASK);
+    }
+    else
+    {
+        *task_id = 0xDEADBEEFU;
+    }
+
+    return status;
+}
+
 /*****************************************************************************/
 /**
 ** \brief OS_TaskDelete stub function
@@ -147,6 +177,54 @@ int32 OS_TaskDelay(uint32 millisecond)
     return status;
 }
 
+/*****************************************************************************
+ *
+ * Stub function for OS_TaskDelayMicros()
+ *
+ *****************************************************************************/
+int32 OS_TaskDelayMicros(uint32 microsecond)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TaskDelayMicros);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_TaskSetPeriod()
+ *
+ *****************************************************************************/
+int32 OS_TaskSetPeriod(uint32 period_usec)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TaskSetPeriod);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_TaskWaitPeriod()
+ *
+ *****************************************************************************/
+int32 OS_TaskWaitPeriod(uint32 *overruns)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TaskWaitPeriod);
+
+    if (overruns != NULL &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_TaskWaitPeriod), overruns, sizeof(*overruns)) < sizeof(*overruns))
+    {
+        *overruns = 0;
+    }
+
+    return status;
+}
+
 /*****************************************************************************
  *
  * Stub function for OS_TaskSetPriority()
@@ -161,6 +239,34 @@ int32 OS_TaskSetPriority (uint32 task_id, uint32 new_priority)
     return status;
 }
 
+/*****************************************************************************
+ *
+ * Stub function for OS_TaskSetAffinity()
+ *
+ *****************************************************************************/
+int32 OS_TaskSetAffinity (uint32 task_id, uint32 cpu_mask)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TaskSetAffinity);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_TaskSetDeadline()
+ *
+ *****************************************************************************/
+int32 OS_TaskSetDeadline (uint32 task_id, uint32 runtime_usec, uint32 deadline_usec, uint32 period_usec)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TaskSetDeadline);
+
+    return status;
+}
+
 /*****************************************************************************/
 /**
 ** \brief OS_TaskRegister stub function
@@ -260,7 +366,7 @@ int32 OS_TaskGetInfo(uint32 task_id, OS_task_prop_t *task_prop)
     status = UT_DEFAULT_IMPL(OS_TaskGetInfo);
 
     if (status == OS_SUCCESS &&
-            UT_Stub_CopyToLocal(UT_KEY(OS_MutSemGetInfo), task_prop, sizeof(*task_prop)) < sizeof(*task_prop))
+            UT_Stub_CopyToLocal(UT_KEY(OS_TaskGetInfo), task_prop, sizeof(*task_prop)) < sizeof(*task_prop))
     {
         task_prop->creator = 1;
         UT_FIXUP_ID(task_prop->creator, UT_OBJTYPE_TASK);
@@ -275,6 +381,126 @@ int32 OS_TaskGetInfo(uint32 task_id, OS_task_prop_t *task_prop)
 }
 
 
+/*****************************************************************************
+ *
+ * Stub function for OS_TaskGetStats()
+ *
+ *****************************************************************************/
+int32 OS_TaskGetStats(uint32 task_id, OS_task_stats_t *task_stats)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TaskGetStats);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_TaskGetStats), task_stats, sizeof(*task_stats)) < sizeof(*task_stats))
+    {
+        memset(task_stats, 0, sizeof(*task_stats));
+        task_stats->task_id = task_id;
+        strncpy(task_stats->name, "UnitTest", OS_MAX_API_NAME - 1);
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_TaskStatsSnapshot()
+ *
+ *****************************************************************************/
+int32 OS_TaskStatsSnapshot(OS_task_stats_t *task_stats, uint32 max_entries, uint32 *num_entries)
+{
+    int32 status;
+    uint32 count;
+
+    status = UT_DEFAULT_IMPL(OS_TaskStatsSnapshot);
+
+    count = 0;
+    if (status == OS_SUCCESS && max_entries > 0)
+    {
+        count = UT_Stub_CopyToLocal(UT_KEY(OS_TaskStatsSnapshot), task_stats,
+                max_entries * sizeof(*task_stats)) / sizeof(*task_stats);
+    }
+
+    *num_entries = count;
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_TaskGetStackPoolStats()
+ *
+ *****************************************************************************/
+int32 OS_TaskGetStackPoolStats(OS_stack_pool_stats_t *stats)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TaskGetStackPoolStats);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_TaskGetStackPoolStats), stats, sizeof(*stats)) < sizeof(*stats))
+    {
+        memset(stats, 0, sizeof(*stats));
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_TaskKeyCreate()
+ *
+ *****************************************************************************/
+int32 OS_TaskKeyCreate(uint32 *key, OS_TaskKeyDestructor_t destructor)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TaskKeyCreate);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_TaskKeyCreate), key, sizeof(*key)) < sizeof(*key))
+    {
+        *key = 0;
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_TaskKeySet()
+ *
+ *****************************************************************************/
+int32 OS_TaskKeySet(uint32 key, void *value)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TaskKeySet);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_TaskKeyGet()
+ *
+ *****************************************************************************/
+int32 OS_TaskKeyGet(uint32 key, void **value)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TaskKeyGet);
+
+    if (status != OS_SUCCESS ||
+            UT_Stub_CopyToLocal(UT_KEY(OS_TaskKeyGet), value, sizeof(*value)) < sizeof(*value))
+    {
+        *value = NULL;
+    }
+
+    return status;
+}
+
 /*****************************************************************************
  *
  * Stub function for OS_TaskInstallDeleteHandler()
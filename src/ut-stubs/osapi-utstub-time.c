@@ -86,6 +86,58 @@ int32 OS_TimerSet(uint32 timer_id, uint32 start_time, uint32 interval_time)
     return status;
 }
 
+/*****************************************************************************
+ *
+ * Stub function for OS_TimerSetNs()
+ *
+ *****************************************************************************/
+int32 OS_TimerSetNs(uint32 timer_id, uint64 start_time, uint64 interval_time)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TimerSetNs);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_TimerSetBatchNs()
+ *
+ *****************************************************************************/
+int32 OS_TimerSetBatchNs(const OS_timer_batch_t *batch, uint32 count, uint64 phase_step)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TimerSetBatchNs);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_TimerSetDispatch()
+ *
+ *****************************************************************************/
+int32 OS_TimerSetDispatch(uint32 timer_id, uint32 pool_id)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TimerSetDispatch);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_TimerDispatch()
+ *
+ *****************************************************************************/
+void OS_TimerDispatch(uint32 timer_id, uint64 nominal_usec)
+{
+    UT_DEFAULT_IMPL(OS_TimerDispatch);
+}
+
 
 /*****************************************************************************/
 /**
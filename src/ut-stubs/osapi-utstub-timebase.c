@@ -65,6 +65,34 @@ int32 OS_TimeBaseSet(uint32 timebase_id, uint32 start_time, uint32 interval_time
     return status;
 }
 
+/*****************************************************************************
+ *
+ * Stub for OS_TimeBaseSetNs() function
+ *
+ *****************************************************************************/
+int32 OS_TimeBaseSetNs(uint32 timebase_id, uint64 start_time, uint64 interval_time)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TimeBaseSetNs);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub for OS_TimeBaseSetTickless() function
+ *
+ *****************************************************************************/
+int32 OS_TimeBaseSetTickless(uint32 timebase_id, bool tickless)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TimeBaseSetTickless);
+
+    return status;
+}
+
 
 /*****************************************************************************
  *
@@ -167,6 +195,41 @@ int32 OS_TimeBaseGetFreeRun     (uint32 timebase_id, uint32 *freerun_val)
 
 }
 
+/*****************************************************************************
+ *
+ * Stub for OS_TimeBaseGetFreeRunNs() function
+ *
+ *****************************************************************************/
+int32 OS_TimeBaseGetFreeRunNs   (uint32 timebase_id, uint64 *freerun_val)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TimeBaseGetFreeRunNs);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_TimeBaseGetFreeRunNs), freerun_val, sizeof(*freerun_val)) < sizeof(*freerun_val))
+    {
+        int32 tempcount;
+        int32 temprc;
+
+        /*
+         * Use the call count such that the value increases with each successive call.
+         * If that doesn't work then just return a constant nonzero value.
+         */
+        if (UT_GetStubRetcodeAndCount(UT_KEY(OS_TimeBaseGetFreeRunNs), &temprc, &tempcount))
+        {
+            *freerun_val = tempcount;
+        }
+        else
+        {
+            *freerun_val = 1;
+        }
+    }
+
+    return status;
+
+}
+
 /*****************************************************************************
  *
  * Stub for OS_TimeBase_CallbackThread() function
@@ -177,6 +240,71 @@ void OS_TimeBase_CallbackThread(uint32 timebase_id)
     UT_DEFAULT_IMPL(OS_TimeBase_CallbackThread);
 }
 
+/*****************************************************************************
+ *
+ * Stub for OS_TimeBase_ProcessTick() function
+ *
+ *****************************************************************************/
+int32 OS_TimeBase_ProcessTick(uint32 timebase_id, uint32 local_id, uint64 tick_time)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_TimeBase_ProcessTick);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub for OS_TimerWheelArm() function
+ *
+ *****************************************************************************/
+void OS_TimerWheelArm(uint32 timebase_id, uint32 timer_id)
+{
+    UT_DEFAULT_IMPL(OS_TimerWheelArm);
+}
+
+/*****************************************************************************
+ *
+ * Stub for OS_TimerWheelDisarm() function
+ *
+ *****************************************************************************/
+void OS_TimerWheelDisarm(uint32 timebase_id, uint32 timer_id)
+{
+    UT_DEFAULT_IMPL(OS_TimerWheelDisarm);
+}
+
+/*****************************************************************************
+ *
+ * Stub for OS_TimerWheelNextDue() function
+ *
+ *****************************************************************************/
+uint64 OS_TimerWheelNextDue(uint32 timebase_id)
+{
+    /* the default of -1 converts to the idle marker */
+    return (uint64)(int64)UT_DEFAULT_IMPL_RC(OS_TimerWheelNextDue, -1);
+}
+
+/*****************************************************************************
+ *
+ * Stub for OS_TimerLatencyNow() function
+ *
+ *****************************************************************************/
+uint64 OS_TimerLatencyNow(void)
+{
+    return UT_DEFAULT_IMPL(OS_TimerLatencyNow);
+}
+
+/*****************************************************************************
+ *
+ * Stub for OS_TimerLatencyRecord() function
+ *
+ *****************************************************************************/
+void OS_TimerLatencyRecord(uint32 timebase_id, uint32 timer_id, uint64 nominal_usec, uint64 entry_usec)
+{
+    UT_DEFAULT_IMPL(OS_TimerLatencyRecord);
+}
+
 /*****************************************************************************
  *
  * Stub for OS_Tick2Micros() function
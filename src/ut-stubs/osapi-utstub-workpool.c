@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2004-2018, United States government as represented by the
+ *  administrator of the National Aeronautics Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ *
+ *  This is governed by the NASA Open Source Agreement and may be used,
+ *  distributed and modified only according to the terms of that agreement.
+ */
+
+/**
+ * \file osapi-utstub-workpool.c
+ *
+ * Stub implementations for the functions defined in the OSAL API
+ *
+ * The stub implementation can be used for unit testing applications built
+ * on top of OSAL.  The stubs do not do any real function, but allow
+ * the return code to be crafted such that error paths in the application
+ * can be executed.
+ */
+
+#include "utstub-helpers.h"
+
+
+UT_DEFAULT_STUB(OS_WorkPoolAPI_Init,(void))
+
+/*****************************************************************************
+ *
+ * Stub function for OS_WorkPoolCreate()
+ *
+ *****************************************************************************/
+int32 OS_WorkPoolCreate(uint32 *pool_id, const char *pool_name, uint32 num_workers,
+                        uint32 stack_size, uint32 priority, uint32 flags)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_WorkPoolCreate);
+
+    if (status == OS_SUCCESS)
+    {
+        *pool_id = UT_AllocStubObjId(UT_OBJTYPE_WORKPOOL);
+    }
+    else
+    {
+        *pool_id = 0xDEADBEEFU;
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_WorkPoolDelete()
+ *
+ *****************************************************************************/
+int32 OS_WorkPoolDelete(uint32 pool_id)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_WorkPoolDelete);
+
+    if (status == OS_SUCCESS)
+    {
+        UT_DeleteStubObjId(UT_OBJTYPE_WORKPOOL, pool_id);
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_WorkSubmit()
+ *
+ *****************************************************************************/
+int32 OS_WorkSubmit(uint32 pool_id, OS_WorkFunc_t func, void *arg)
+{
+    int32 status;
+
+    UT_Stub_RegisterContext(UT_KEY(OS_WorkSubmit), &func);
+    UT_Stub_RegisterContext(UT_KEY(OS_WorkSubmit), arg);
+
+    status = UT_DEFAULT_IMPL(OS_WorkSubmit);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_WorkPoolWaitIdle()
+ *
+ *****************************************************************************/
+int32 OS_WorkPoolWaitIdle(uint32 pool_id, int32 msecs)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_WorkPoolWaitIdle);
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_WorkPoolGetIdByName()
+ *
+ *****************************************************************************/
+int32 OS_WorkPoolGetIdByName(uint32 *pool_id, const char *pool_name)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_WorkPoolGetIdByName);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_WorkPoolGetIdByName), pool_id, sizeof(*pool_id)) < sizeof(*pool_id))
+    {
+        *pool_id =  1;
+        UT_FIXUP_ID(*pool_id, UT_OBJTYPE_WORKPOOL);
+    }
+
+    return status;
+}
+
+/*****************************************************************************
+ *
+ * Stub function for OS_WorkPoolGetInfo()
+ *
+ *****************************************************************************/
+int32 OS_WorkPoolGetInfo(uint32 pool_id, OS_workpool_prop_t *pool_prop)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(OS_WorkPoolGetInfo);
+
+    if (status == OS_SUCCESS &&
+            UT_Stub_CopyToLocal(UT_KEY(OS_WorkPoolGetInfo), pool_prop, sizeof(*pool_prop)) < sizeof(*pool_prop))
+    {
+        strncpy(pool_prop->name, "Name", OS_MAX_API_NAME - 1);
+        pool_prop->name[OS_MAX_API_NAME - 1] = '\0';
+        pool_prop->creator =  1;
+        UT_FIXUP_ID(pool_prop->creator, UT_OBJTYPE_TASK);
+        pool_prop->num_workers = 1;
+    }
+
+    return status;
+}
@@ -37,7 +37,11 @@ const uint32 UT_MAXOBJS[UT_OBJTYPE_MAX] =
         [UT_OBJTYPE_FILESTREAM] = OS_MAX_NUM_OPEN_FILES,
         [UT_OBJTYPE_TIMEBASE] = OS_MAX_TIMEBASES,
         [UT_OBJTYPE_FILESYS] = NUM_TABLE_ENTRIES,
-        [UT_OBJTYPE_DIR] = OS_MAX_NUM_OPEN_DIRS
+        [UT_OBJTYPE_DIR] = OS_MAX_NUM_OPEN_DIRS,
+        [UT_OBJTYPE_CONDVAR] = OS_MAX_CONDVARS,
+        [UT_OBJTYPE_BARRIER] = OS_MAX_BARRIERS,
+        [UT_OBJTYPE_WORKPOOL] = OS_MAX_WORKPOOLS,
+        [UT_OBJTYPE_FIBER] = OS_MAX_FIBERS
 };
 
 
@@ -56,6 +56,10 @@ typedef enum
     UT_OBJTYPE_TIMEBASE,
     UT_OBJTYPE_DIR,
     UT_OBJTYPE_FILESYS,
+    UT_OBJTYPE_CONDVAR,
+    UT_OBJTYPE_BARRIER,
+    UT_OBJTYPE_WORKPOOL,
+    UT_OBJTYPE_FIBER,
     UT_OBJTYPE_MAX
 } UT_ObjType_t;
 